@@ -0,0 +1,149 @@
+/*
+ * FreeRTOS V202011.00
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*-----------------------------------------------------------
+ * Configuration shared by the host tests and benchmarks.
+ *
+ * It follows the configuration of the STM32 projects, but every definition
+ * can be overridden from the Makefile so each test can enable the kernel
+ * options it exercises.
+ *----------------------------------------------------------*/
+
+#include <assert.h>
+
+#ifndef configUSE_PREEMPTION
+	#define configUSE_PREEMPTION			1
+#endif
+#ifndef configUSE_IDLE_HOOK
+	/* The idle hook of every test advances the simulated tick. */
+	#define configUSE_IDLE_HOOK				1
+#endif
+#ifndef configUSE_TICK_HOOK
+	#define configUSE_TICK_HOOK				0
+#endif
+#define configCPU_CLOCK_HZ					( 16000000UL )
+#define configTICK_RATE_HZ					( ( TickType_t ) 1000 )
+#ifndef configMAX_PRIORITIES
+	#define configMAX_PRIORITIES			( 8 )
+#endif
+#define configMINIMAL_STACK_SIZE			( ( unsigned short ) 130 )
+#ifndef configTOTAL_HEAP_SIZE
+	#define configTOTAL_HEAP_SIZE			( ( size_t ) ( 512 * 1024 ) )
+#endif
+#define configMAX_TASK_NAME_LEN				( 10 )
+#define configUSE_TRACE_FACILITY			1
+#define configUSE_16_BIT_TICKS				0
+#define configIDLE_SHOULD_YIELD				1
+#define configUSE_MUTEXES					1
+#define configQUEUE_REGISTRY_SIZE			8
+#define configCHECK_FOR_STACK_OVERFLOW		0
+#define configUSE_RECURSIVE_MUTEXES			1
+#ifndef configUSE_MALLOC_FAILED_HOOK
+	#define configUSE_MALLOC_FAILED_HOOK	0
+#endif
+#define configUSE_APPLICATION_TASK_TAG		0
+#define configUSE_COUNTING_SEMAPHORES		1
+#define configGENERATE_RUN_TIME_STATS		0
+#define configUSE_QUEUE_SETS				1
+#define configUSE_TASK_NOTIFICATIONS		1
+#ifndef configSUPPORT_STATIC_ALLOCATION
+	#define configSUPPORT_STATIC_ALLOCATION	0
+#endif
+
+/* Co-routine definitions. */
+#define configUSE_CO_ROUTINES				0
+#define configMAX_CO_ROUTINE_PRIORITIES		( 2 )
+
+/* Software timer definitions. */
+#ifndef configUSE_TIMERS
+	#define configUSE_TIMERS				1
+#endif
+#ifndef configTIMER_TASK_PRIORITY
+	#define configTIMER_TASK_PRIORITY		( 2 )
+#endif
+#ifndef configTIMER_QUEUE_LENGTH
+	#define configTIMER_QUEUE_LENGTH		10
+#endif
+#define configTIMER_TASK_STACK_DEPTH		( configMINIMAL_STACK_SIZE * 2 )
+
+/* Set the following definitions to 1 to include the API function, or zero
+to exclude the API function. */
+#define INCLUDE_vTaskPrioritySet			1
+#define INCLUDE_uxTaskPriorityGet			1
+#define INCLUDE_vTaskDelete					1
+#define INCLUDE_vTaskCleanUpResources		1
+#define INCLUDE_vTaskSuspend				1
+#define INCLUDE_vTaskDelayUntil				1
+#define INCLUDE_vTaskDelay					1
+#define INCLUDE_xTaskGetIdleTaskHandle		1
+#define INCLUDE_xTaskGetSchedulerState		1
+#define INCLUDE_xTaskGetCurrentTaskHandle	1
+#define INCLUDE_xTimerPendFunctionCall		1
+#define INCLUDE_xEventGroupSetBitFromISR	1
+
+/* The tests rely on assert() so must not be built with NDEBUG.  A test that
+checks an assertion fails, and needs to carry on afterwards, defines
+configTEST_ASSERT_HOOK to 1 and implements vTestAssertFailed(). */
+#if( defined( configTEST_ASSERT_HOOK ) && ( configTEST_ASSERT_HOOK == 1 ) )
+	extern void vTestAssertFailed( const char *pcFile, int iLine );
+	#define configASSERT( x ) if( ( x ) == 0 ) vTestAssertFailed( __FILE__, __LINE__ )
+#else
+	#define configASSERT( x ) assert( x )
+#endif
+
+/* A test that needs to act at the point a timer expires, for example to
+simulate an interrupt arriving while the expiry is processed, defines
+configTEST_TRACE_TIMER_EXPIRED to 1 and implements vTestTraceTimerExpired(). */
+#if( defined( configTEST_TRACE_TIMER_EXPIRED ) && ( configTEST_TRACE_TIMER_EXPIRED == 1 ) )
+	extern void vTestTraceTimerExpired( void *pvTimer );
+	#define traceTIMER_EXPIRED( pxTimer ) vTestTraceTimerExpired( pxTimer )
+#endif
+
+/* High resolution timers run on a 32-bit counter simulated by the port, which
+only advances when a test calls vPortAdvanceHRTimer().  The counter starts at
+configHR_TIMER_INITIAL_COUNT, so a test can start it just before it
+overflows. */
+#if( defined( configUSE_HR_TIMERS ) && ( configUSE_HR_TIMERS == 1 ) )
+	#ifndef configHR_TIMER_INITIAL_COUNT
+		#define configHR_TIMER_INITIAL_COUNT	0UL
+	#endif
+	extern void vPortConfigureHRTimer( uint32_t ulInitialCount );
+	extern uint32_t ulPortGetHRTimerCount( void );
+	extern void vPortSetHRTimerCompare( uint32_t ulCompareValue );
+	extern void vPortDisableHRTimerCompare( void );
+	#define portCONFIGURE_HR_TIMER()					vPortConfigureHRTimer( configHR_TIMER_INITIAL_COUNT )
+	#define portGET_HR_TIMER_COUNT()					ulPortGetHRTimerCount()
+	#define portSET_HR_TIMER_COMPARE( ulCompareValue )	vPortSetHRTimerCompare( ulCompareValue )
+	#define portDISABLE_HR_TIMER_COMPARE()				vPortDisableHRTimerCompare()
+#endif
+
+#endif /* FREERTOS_CONFIG_H */
+
@@ -0,0 +1,217 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * Measures how long a high priority task that needs two mutexes in turn is
+ * blocked by two lower priority tasks that each hold one of them.  The low
+ * priority holders are released at random offsets in each period, so the
+ * middle one often preempts the lowest one while it holds its mutex.  With
+ * priority inheritance the high priority task can then be blocked once on
+ * each mutex.  With ceiling mutexes the lowest holder runs at the ceiling, so
+ * the middle one cannot start its critical section until the first one has
+ * finished, and the high priority task is blocked at most once.  The Makefile
+ * builds it with configUSE_CEILING_MUTEXES set to 1, and with the default of
+ * 0, which uses priority inheritance mutexes.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#define benchPERIODS			( 500 )
+#define benchPERIOD_TICKS		( ( TickType_t ) 20 )
+
+/* The ticks of work done while holding a mutex. */
+#define benchLOW_WORK_TICKS		( 4 )
+#define benchHIGH_WORK_TICKS	( 1 )
+
+#define benchLOW_PRIORITY		( 1 )
+#define benchMIDDLE_PRIORITY	( 2 )
+#define benchHIGH_PRIORITY		( 3 )
+#define benchCEILING_PRIORITY	( benchHIGH_PRIORITY + 1 )
+
+static SemaphoreHandle_t xMutexA, xMutexB;
+static TaskHandle_t xControl, xLow, xMiddle, xHigh;
+static volatile TickType_t xReleaseTick, xResponseTicks;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+static uint32_t ulState = 0xc0ffee11UL;
+
+	/* xorshift32. */
+	ulState ^= ulState << 13;
+	ulState ^= ulState >> 17;
+	ulState ^= ulState << 5;
+	return ulState;
+}
+/*-----------------------------------------------------------*/
+
+/* Run for xTicks ticks, as if executing code, so time passes while the
+calling task runs. */
+static void prvWork( TickType_t xTicks )
+{
+	while( xTicks > ( TickType_t ) 0 )
+	{
+		vPortSimulateTick();
+		xTicks--;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static SemaphoreHandle_t prvCreateMutex( void )
+{
+	#if ( configUSE_CEILING_MUTEXES == 1 )
+	{
+		return xSemaphoreCreateCeilingMutex( benchCEILING_PRIORITY );
+	}
+	#else
+	{
+		return xSemaphoreCreateMutex();
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+/* The response time is measured from the release of the task, as it can be
+kept from running by a holder at the ceiling as well as blocked on a mutex. */
+static void prvHighTask( void *pvParameters )
+{
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+		configASSERT( xSemaphoreTake( xMutexA, portMAX_DELAY ) == pdPASS );
+		prvWork( benchHIGH_WORK_TICKS );
+		configASSERT( xSemaphoreGive( xMutexA ) == pdPASS );
+
+		configASSERT( xSemaphoreTake( xMutexB, portMAX_DELAY ) == pdPASS );
+		prvWork( benchHIGH_WORK_TICKS );
+		configASSERT( xSemaphoreGive( xMutexB ) == pdPASS );
+
+		xResponseTicks = xTaskGetTickCount() - xReleaseTick;
+		xTaskNotifyGive( xControl );
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* The low priority task holds A, the middle priority task holds B. */
+static void prvHolderTask( void *pvParameters )
+{
+SemaphoreHandle_t *pxMutex = ( SemaphoreHandle_t * ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		configASSERT( xSemaphoreTake( *pxMutex, portMAX_DELAY ) == pdPASS );
+		prvWork( benchLOW_WORK_TICKS );
+		configASSERT( xSemaphoreGive( *pxMutex ) == pdPASS );
+		xTaskNotifyGive( xControl );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+UBaseType_t uxPeriod;
+TickType_t xLastWake, xBlocked, xTotal = 0, xMax = 0;
+uint32_t ulSwitches;
+
+	xLastWake = xTaskGetTickCount();
+	ulSwitches = ulPortGetContextSwitchCount();
+
+	for( uxPeriod = 0; uxPeriod < benchPERIODS; uxPeriod++ )
+	{
+		/* Release the holders, then the high priority task, at random
+		offsets, and wait for all three to finish. */
+		xTaskNotifyGive( xLow );
+		vTaskDelay( ( TickType_t ) ( prvRand() % 4 ) );
+		xTaskNotifyGive( xMiddle );
+		vTaskDelay( ( TickType_t ) ( prvRand() % 6 ) );
+		xReleaseTick = xTaskGetTickCount();
+		xTaskNotifyGive( xHigh );
+
+		( void ) ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+		( void ) ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+		( void ) ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+
+		xBlocked = xResponseTicks - ( 2 * benchHIGH_WORK_TICKS );
+		xTotal += xBlocked;
+
+		if( xBlocked > xMax )
+		{
+			xMax = xBlocked;
+		}
+
+		configASSERT( uxTaskPriorityGet( xLow ) == benchLOW_PRIORITY );
+		configASSERT( uxTaskPriorityGet( xMiddle ) == benchMIDDLE_PRIORITY );
+
+		vTaskDelayUntil( &xLastWake, benchPERIOD_TICKS );
+	}
+
+	ulSwitches = ulPortGetContextSwitchCount() - ulSwitches;
+
+	printf( "%s: blocked %lu ticks worst case, %lu.%02lu mean, %lu.%02lu context switches per period, over %u periods\n",
+		( configUSE_CEILING_MUTEXES == 1 ) ? "ceiling" : "inheritance", ( unsigned long ) xMax,
+		( unsigned long ) ( xTotal / benchPERIODS ), ( unsigned long ) ( ( ( xTotal % benchPERIODS ) * 100 ) / benchPERIODS ),
+		( unsigned long ) ( ulSwitches / benchPERIODS ), ( unsigned long ) ( ( ( ulSwitches % benchPERIODS ) * 100 ) / benchPERIODS ),
+		( unsigned ) benchPERIODS );
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xMutexA = prvCreateMutex();
+	xMutexB = prvCreateMutex();
+	configASSERT( xMutexA && xMutexB );
+
+	xTaskCreate( prvHolderTask, "Low", configMINIMAL_STACK_SIZE, &xMutexA, benchLOW_PRIORITY, &xLow );
+	xTaskCreate( prvHolderTask, "Middle", configMINIMAL_STACK_SIZE, &xMutexB, benchMIDDLE_PRIORITY, &xMiddle );
+	xTaskCreate( prvHighTask, "High", configMINIMAL_STACK_SIZE, NULL, benchHIGH_PRIORITY, &xHigh );
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, &xControl );
+	configASSERT( xLow && xMiddle && xHigh && xControl );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,117 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Measures the cost of xEventGroupSetBits() against the number of tasks
+ * blocked on the event group, when none of them waits for the bit being set.
+ * The Makefile builds it with configUSE_EVENT_GROUP_BIT_INDEXED_WAITERS set to
+ * 1, and with the default of 0, where every set visits every blocked task.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "event_groups.h"
+
+#define benchITERATIONS		( 100000UL )
+#define benchMAX_WAITERS	( 128 )
+
+/* The bit that is set, which no task waits for. */
+#define benchSET_BIT		( ( EventBits_t ) 0x01 )
+
+static EventGroupHandle_t xEventGroup;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+/* Wait, forever, for one of the bits other than benchSET_BIT. */
+static void prvWaiterTask( void *pvParameters )
+{
+const EventBits_t uxBit = ( EventBits_t ) 1 << ( 1 + ( ( UBaseType_t ) pvParameters % 23 ) );
+
+	( void ) xEventGroupWaitBits( xEventGroup, uxBit, pdFALSE, pdFALSE, portMAX_DELAY );
+	configASSERT( pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+static const UBaseType_t uxSizes[] = { 0, 8, 32, 64, benchMAX_WAITERS };
+UBaseType_t uxWaiters = 0, uxSize;
+uint32_t ulIteration;
+uint64_t ullStart, ullNs;
+
+	printf( "bit indexed waiters %d\n", configUSE_EVENT_GROUP_BIT_INDEXED_WAITERS );
+	printf( "%8s %12s\n", "waiters", "ns per set" );
+
+	for( uxSize = 0; uxSize < ( sizeof( uxSizes ) / sizeof( uxSizes[ 0 ] ) ); uxSize++ )
+	{
+		while( uxWaiters < uxSizes[ uxSize ] )
+		{
+			configASSERT( xTaskCreate( prvWaiterTask, "Waiter", configMINIMAL_STACK_SIZE, ( void * ) uxWaiters, 1, NULL ) == pdPASS );
+			uxWaiters++;
+		}
+
+		/* Let the new waiters block on the event group. */
+		vTaskDelay( 1 );
+
+		ullStart = ullPortGetTimeNs();
+
+		for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+		{
+			( void ) xEventGroupSetBits( xEventGroup, benchSET_BIT );
+			( void ) xEventGroupClearBits( xEventGroup, benchSET_BIT );
+		}
+
+		ullNs = ullPortGetTimeNs() - ullStart;
+		printf( "%8lu %12lu\n", ( unsigned long ) uxWaiters, ( unsigned long ) ( ullNs / benchITERATIONS ) );
+	}
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xEventGroup = xEventGroupCreate();
+	configASSERT( xEventGroup );
+
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,145 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Measures how long xEventGroupSetBitsFromISR() keeps interrupts masked, with
+ * configUSE_DIRECT_EVENT_GROUP_SET_FROM_ISR set to 1, as the number of tasks
+ * waiting for the bit being set grows.  The Makefile builds it twice: with
+ * the default configEVENT_GROUP_SET_BITS_FROM_ISR_BUDGET, and with a budget
+ * so large every set is performed within the interrupt, as it was before the
+ * budget existed.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "event_groups.h"
+
+#define benchITERATIONS		( 1000 )
+#define benchMAX_WAITERS	( 256 )
+
+#define benchBIT_0			( ( EventBits_t ) 0x01 )
+
+static EventGroupHandle_t xEventGroup;
+static volatile uint32_t ulWakes;
+static uint64_t ullMaskedNs;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaiterTask( void *pvParameters )
+{
+	for( ;; )
+	{
+		( void ) xEventGroupWaitBits( xEventGroup, benchBIT_0, pdTRUE, pdTRUE, portMAX_DELAY );
+		ulWakes++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSetBitsFromISR( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+uint64_t ullStart;
+
+	/* The simulated interrupt runs with interrupts masked throughout, so the
+	time taken by the call is the time they are masked. */
+	ullStart = ullPortGetTimeNs();
+	configASSERT( xEventGroupSetBitsFromISR( xEventGroup, benchBIT_0, &xHigherPriorityTaskWoken ) == pdPASS );
+	ullMaskedNs = ullPortGetTimeNs() - ullStart;
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+UBaseType_t uxWaiters = 0, uxTarget;
+uint32_t ulIteration;
+uint64_t ullTotalNs, ullMaxNs;
+
+	printf( "budget %lu\n", ( unsigned long ) configEVENT_GROUP_SET_BITS_FROM_ISR_BUDGET );
+	printf( "%8s %12s %12s\n", "waiters", "mean ns", "max ns" );
+
+	for( uxTarget = 1; uxTarget <= benchMAX_WAITERS; uxTarget *= 4 )
+	{
+		while( uxWaiters < uxTarget )
+		{
+			configASSERT( xTaskCreate( prvWaiterTask, "Waiter", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+			uxWaiters++;
+		}
+
+		/* Let the new waiters block on the event group. */
+		vTaskDelay( 1 );
+		ulWakes = 0;
+		ullTotalNs = 0;
+		ullMaxNs = 0;
+
+		for( ulIteration = 0; ulIteration < benchITERATIONS; ulIteration++ )
+		{
+			vPortSimulateInterrupt( prvSetBitsFromISR );
+			ullTotalNs += ullMaskedNs;
+
+			if( ullMaskedNs > ullMaxNs )
+			{
+				ullMaxNs = ullMaskedNs;
+			}
+
+			/* Let the timer task, if used, and the waiters run, so every
+			waiter is blocked again before the next iteration. */
+			vTaskDelay( 1 );
+		}
+
+		configASSERT( ulWakes == ( uint32_t ) ( uxWaiters * benchITERATIONS ) );
+		printf( "%8lu %12lu %12lu\n", ( unsigned long ) uxWaiters, ( unsigned long ) ( ullTotalNs / benchITERATIONS ), ( unsigned long ) ullMaxNs );
+	}
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xEventGroup = xEventGroupCreate();
+	configASSERT( xEventGroup );
+
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,241 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Measures the time taken by pvPortMalloc() and vPortFree() on random traces
+ * of allocations and frees in a 75 KB heap.  The Makefile builds it with
+ * configUSE_TLSF_HEAP set to 1 and, as bench_heap_tlsf_heap4, with heap_4.c.
+ *
+ * Each call is timed on its own, less the time taken to read the clock, and
+ * the mean and 99.9th percentile are reported.  An allocation that fails is
+ * timed like any other, then a random block is freed instead.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define benchOPERATIONS		( 400000UL )
+#define benchMAX_LIVE		( 1500 )
+
+/* Call times are counted in 1 ns buckets up to this many ns, and in the last
+bucket beyond it. */
+#define benchBUCKETS		( 20000 )
+
+typedef struct
+{
+	const char *pcName;
+	UBaseType_t uxMaxLive;
+	size_t xSmallMin, xSmallMax;
+	uint32_t ulLargePerThousand;
+	size_t xLargeSize;
+} Trace_t;
+
+typedef struct
+{
+	uint64_t ullTotal;
+	uint32_t ulCalls;
+	uint32_t ulBuckets[ benchBUCKETS ];
+} Timings_t;
+
+static void *pvLive[ benchMAX_LIVE ];
+static Timings_t xMallocTimings, xFreeTimings;
+static uint64_t ullClockOverhead;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+static uint32_t ulState = 0x4ea95eedUL;
+
+	/* xorshift32. */
+	ulState ^= ulState << 13;
+	ulState ^= ulState >> 17;
+	ulState ^= ulState << 5;
+	return ulState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecord( Timings_t *pxTimings, uint64_t ullStart, uint64_t ullEnd )
+{
+uint64_t ullTime = ullEnd - ullStart;
+
+	ullTime = ( ullTime > ullClockOverhead ) ? ( ullTime - ullClockOverhead ) : 0;
+	pxTimings->ullTotal += ullTime;
+	pxTimings->ulCalls++;
+	pxTimings->ulBuckets[ ( ullTime < benchBUCKETS ) ? ullTime : ( benchBUCKETS - 1 ) ]++;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvPercentile999( const Timings_t *pxTimings )
+{
+uint32_t ulBucket, ulCount = 0, ulLimit = pxTimings->ulCalls - ( pxTimings->ulCalls / 1000 );
+
+	for( ulBucket = 0; ulBucket < ( benchBUCKETS - 1 ); ulBucket++ )
+	{
+		ulCount += pxTimings->ulBuckets[ ulBucket ];
+
+		if( ulCount >= ulLimit )
+		{
+			break;
+		}
+	}
+
+	return ulBucket;
+}
+/*-----------------------------------------------------------*/
+
+static void prvFreeRandom( UBaseType_t *puxLive )
+{
+UBaseType_t uxIndex = ( UBaseType_t ) ( prvRand() % *puxLive );
+uint64_t ullStart;
+
+	ullStart = ullPortGetTimeNs();
+	vPortFree( pvLive[ uxIndex ] );
+	prvRecord( &xFreeTimings, ullStart, ullPortGetTimeNs() );
+
+	( *puxLive )--;
+	pvLive[ uxIndex ] = pvLive[ *puxLive ];
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunTrace( const Trace_t *pxTrace )
+{
+UBaseType_t uxLive = 0;
+uint32_t ul, ulFailures = 0;
+uint64_t ullStart;
+size_t xSize;
+void *pvBlock;
+
+	memset( &xMallocTimings, 0, sizeof( xMallocTimings ) );
+	memset( &xFreeTimings, 0, sizeof( xFreeTimings ) );
+
+	for( ul = 0; ul < benchOPERATIONS; ul++ )
+	{
+		if( ( uxLive < pxTrace->uxMaxLive ) && ( ( uxLive == 0 ) || ( ( prvRand() % 2 ) == 0 ) ) )
+		{
+			if( ( prvRand() % 1000 ) < pxTrace->ulLargePerThousand )
+			{
+				xSize = pxTrace->xLargeSize;
+			}
+			else
+			{
+				xSize = pxTrace->xSmallMin + ( prvRand() % ( pxTrace->xSmallMax - pxTrace->xSmallMin + 1 ) );
+			}
+
+			ullStart = ullPortGetTimeNs();
+			pvBlock = pvPortMalloc( xSize );
+			prvRecord( &xMallocTimings, ullStart, ullPortGetTimeNs() );
+
+			if( pvBlock != NULL )
+			{
+				pvLive[ uxLive ] = pvBlock;
+				uxLive++;
+			}
+			else
+			{
+				ulFailures++;
+				prvFreeRandom( &uxLive );
+			}
+		}
+		else
+		{
+			prvFreeRandom( &uxLive );
+		}
+	}
+
+	while( uxLive > 0 )
+	{
+		prvFreeRandom( &uxLive );
+	}
+
+	printf( "%-26s  %6lu  %6lu  %6lu  %6lu  %8lu\n", pxTrace->pcName,
+		( unsigned long ) ( xMallocTimings.ullTotal / xMallocTimings.ulCalls ), ( unsigned long ) prvPercentile999( &xMallocTimings ),
+		( unsigned long ) ( xFreeTimings.ullTotal / xFreeTimings.ulCalls ), ( unsigned long ) prvPercentile999( &xFreeTimings ),
+		( unsigned long ) ulFailures );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+static const Trace_t xTraces[] =
+{
+	{ "8..255 bytes (400)",			400,	8,	255,	0,	0 },
+	{ "90% small, 10% 4K (400)",	400,	8,	255,	100,	4096 },
+	{ "98% small, 2% 9K (1500)",	1500,	8,	64,		20,		9216 },
+	{ "fixed 8 bytes (50)",			50,		8,	8,		0,		0 }
+};
+const size_t xFreeBefore = xPortGetFreeHeapSize();
+UBaseType_t ux;
+uint64_t ullStart, ullMin = ~0ULL;
+
+	/* The least time taken to read the clock twice. */
+	for( ux = 0; ux < 1000; ux++ )
+	{
+		ullStart = ullPortGetTimeNs();
+		ullStart = ullPortGetTimeNs() - ullStart;
+
+		if( ullStart < ullMin )
+		{
+			ullMin = ullStart;
+		}
+	}
+
+	ullClockOverhead = ullMin;
+
+	printf( "%s, %lu operations per trace, ns per call\n", ( configUSE_TLSF_HEAP == 1 ) ? "heap_tlsf" : "heap_4", ( unsigned long ) benchOPERATIONS );
+	printf( "trace (live blocks)         malloc   p99.9    free   p99.9  failures\n" );
+
+	for( ux = 0; ux < ( sizeof( xTraces ) / sizeof( xTraces[ 0 ] ) ); ux++ )
+	{
+		prvRunTrace( &( xTraces[ ux ] ) );
+		configASSERT( xPortGetFreeHeapSize() == xFreeBefore );
+	}
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,190 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Measures the overhead of the heap tracker.  Each round allocates four blocks
+ * then frees them, and the time per pvPortMalloc() and vPortFree() pair is
+ * reported, best of five runs.  The Makefile builds it with
+ * configUSE_HEAP_TRACKER set to 1 and, as bench_heap_tracker_off, without the
+ * tracker, and the same two again with heap_tlsf.c as bench_heap_tracker_tlsf
+ * and bench_heap_tracker_tlsf_off.
+ *
+ * With the tracker, the time taken by the reports is also measured with half
+ * of the default table of 128 entries in use.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if( configUSE_HEAP_TRACKER == 1 )
+	#include "heap_tracker.h"
+#endif
+
+#define benchROUNDS			( 200000UL )
+#define benchRUNS			( 5 )
+#define benchBLOCKS			( 4 )
+#define benchREPORTS		( 10000UL )
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+/* Returns the least time per malloc and free pair over benchRUNS runs. */
+static uint64_t prvTimePairs( size_t xSize )
+{
+void *pvBlocks[ benchBLOCKS ];
+uint64_t ullStart, ullTime, ullBest = ~0ULL;
+uint32_t ulRun, ulRound, ul;
+
+	for( ulRun = 0; ulRun < benchRUNS; ulRun++ )
+	{
+		ullStart = ullPortGetTimeNs();
+
+		for( ulRound = 0; ulRound < benchROUNDS; ulRound++ )
+		{
+			for( ul = 0; ul < benchBLOCKS; ul++ )
+			{
+				pvBlocks[ ul ] = pvPortMalloc( xSize );
+			}
+
+			for( ul = 0; ul < benchBLOCKS; ul++ )
+			{
+				vPortFree( pvBlocks[ ul ] );
+			}
+		}
+
+		ullTime = ( ullPortGetTimeNs() - ullStart ) / ( benchROUNDS * benchBLOCKS );
+
+		if( ullTime < ullBest )
+		{
+			ullBest = ullTime;
+		}
+	}
+
+	return ullBest;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_TRACKER == 1 )
+
+	static void prvTimeReports( void )
+	{
+	static HeapTrackerAllocation_t xLeaks[ 8 ];
+	static HeapTrackerCallSite_t xSites[ 5 ];
+	static uint32_t ulNotATask;
+	void *pvBlocks[ configHEAP_TRACKER_TABLE_SIZE / 2 ];
+	HeapTrackerStats_t xStats;
+	uint64_t ullStart, ullLeaks, ullDeleted, ullTop;
+	uint32_t ul;
+
+		/* Fill half of the table, counting the blocks the kernel holds. */
+		vHeapTrackerGetStats( &xStats );
+
+		for( ul = xStats.uxTrackedBlocks; ul < ( configHEAP_TRACKER_TABLE_SIZE / 2 ); ul++ )
+		{
+			pvBlocks[ ul ] = pvPortMalloc( 16 + ( ul % 8 ) * 16 );
+		}
+
+		ullStart = ullPortGetTimeNs();
+
+		for( ul = 0; ul < benchREPORTS; ul++ )
+		{
+			( void ) uxHeapTrackerGetLeaks( xLeaks, 8 );
+		}
+
+		ullLeaks = ( ullPortGetTimeNs() - ullStart ) / benchREPORTS;
+
+		/* Scan the table as when a task is deleted, for a handle that owns no
+		block so nothing is marked. */
+		ullStart = ullPortGetTimeNs();
+
+		for( ul = 0; ul < benchREPORTS; ul++ )
+		{
+			vHeapTrackerTaskDeleted( ( TaskHandle_t ) &ulNotATask );
+		}
+
+		ullDeleted = ( ullPortGetTimeNs() - ullStart ) / benchREPORTS;
+		ullStart = ullPortGetTimeNs();
+
+		for( ul = 0; ul < benchREPORTS; ul++ )
+		{
+			( void ) uxHeapTrackerGetTopCallSites( xSites, 5 );
+		}
+
+		ullTop = ( ullPortGetTimeNs() - ullStart ) / benchREPORTS;
+
+		for( ul = xStats.uxTrackedBlocks; ul < ( configHEAP_TRACKER_TABLE_SIZE / 2 ); ul++ )
+		{
+			vPortFree( pvBlocks[ ul ] );
+		}
+
+		printf( "%u of %u entries in use: leak scan %lu ns, task delete scan %lu ns, top 5 call sites %lu ns\n",
+			( unsigned ) ( configHEAP_TRACKER_TABLE_SIZE / 2 ), ( unsigned ) configHEAP_TRACKER_TABLE_SIZE,
+			( unsigned long ) ullLeaks, ( unsigned long ) ullDeleted, ( unsigned long ) ullTop );
+	}
+
+#endif /* configUSE_HEAP_TRACKER */
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+uint64_t ull32, ull200;
+
+	ull32 = prvTimePairs( 32 );
+	ull200 = prvTimePairs( 200 );
+
+	printf( "%s, tracker %s: malloc+free pair %lu ns for 32 bytes, %lu ns for 200 bytes\n",
+		( configUSE_TLSF_HEAP == 1 ) ? "heap_tlsf" : "heap_4", ( configUSE_HEAP_TRACKER == 1 ) ? "on" : "off",
+		( unsigned long ) ull32, ( unsigned long ) ull200 );
+
+	#if( configUSE_HEAP_TRACKER == 1 )
+	{
+		prvTimeReports();
+	}
+	#endif
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
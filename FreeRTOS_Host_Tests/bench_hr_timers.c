@@ -0,0 +1,180 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * Measures the cost of starting a high resolution timer and of each expiry
+ * against the number of active timers, from 1 to 1000, on the counter
+ * simulated by the host port.
+ *
+ * The start cost is the time xHRTimerStartAt() takes to restart a random
+ * active timer, none of which expire while it is measured.  The expiry cost is
+ * the time per callback of timers that restart themselves from their callback
+ * a random period after their expiry count, less the time the counter takes to
+ * advance the same distance with no timer active.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "hr_timers.h"
+
+#define benchMAX_TIMERS		( 1000 )
+#define benchSTARTS			( 200000UL )
+#define benchSTEPS			( 200000UL )
+#define benchSTEP			( 100UL )
+
+static HRTimerHandle_t xTimers[ benchMAX_TIMERS ];
+static uint32_t ulPeriods[ benchMAX_TIMERS ];
+static uint32_t ulCallbacks;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+static uint32_t ulState = 0x2468ace1UL;
+
+	/* xorshift32. */
+	ulState ^= ulState << 13;
+	ulState ^= ulState >> 17;
+	ulState ^= ulState << 5;
+	return ulState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( HRTimerHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken )
+{
+	ulCallbacks++;
+	( void ) xHRTimerStartAtFromISR( xTimer, ulHRTimerGetExpiryCount( xTimer ) + ulPeriods[ ( uintptr_t ) pvHRTimerGetTimerID( xTimer ) ] );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStopTimers( UBaseType_t uxTimers )
+{
+UBaseType_t ux;
+
+	for( ux = 0; ux < uxTimers; ux++ )
+	{
+		( void ) xHRTimerStop( xTimers[ ux ] );
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* Returns the time taken for the counter to advance benchSTEPS steps. */
+static uint64_t prvTimeSteps( void )
+{
+uint64_t ullStart = ullPortGetTimeNs();
+uint32_t ul;
+
+	for( ul = 0; ul < benchSTEPS; ul++ )
+	{
+		vPortAdvanceHRTimer( benchSTEP );
+	}
+
+	return ullPortGetTimeNs() - ullStart;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+static const UBaseType_t uxCounts[] = { 1, 10, 100, 1000 };
+UBaseType_t uxCount, uxTimers, ux;
+uint64_t ullStart, ullStartCost, ullIdleSteps, ullExpiry;
+uint32_t ul, ulPeriod;
+
+	ullIdleSteps = prvTimeSteps();
+
+	printf( "active timers  start ns  expiry ns\n" );
+
+	for( uxCount = 0; uxCount < ( sizeof( uxCounts ) / sizeof( uxCounts[ 0 ] ) ); uxCount++ )
+	{
+		uxTimers = uxCounts[ uxCount ];
+
+		/* Restart random timers a long way ahead, so none expire while they
+		are measured. */
+		for( ux = 0; ux < uxTimers; ux++ )
+		{
+			( void ) xHRTimerStart( xTimers[ ux ], 1000000UL + ( prvRand() % 1000000UL ) );
+		}
+
+		ullStart = ullPortGetTimeNs();
+
+		for( ul = 0; ul < benchSTARTS; ul++ )
+		{
+			( void ) xHRTimerStart( xTimers[ prvRand() % uxTimers ], 1000000UL + ( prvRand() % 1000000UL ) );
+		}
+
+		ullStartCost = ( ullPortGetTimeNs() - ullStart ) / benchSTARTS;
+		prvStopTimers( uxTimers );
+
+		/* Expire the timers with periods chosen so about one expires each
+		step, whatever the number of timers. */
+		for( ux = 0; ux < uxTimers; ux++ )
+		{
+			ulPeriod = ( uint32_t ) uxTimers * benchSTEP;
+			ulPeriods[ ux ] = ulPeriod + ( prvRand() % ulPeriod );
+			( void ) xHRTimerStart( xTimers[ ux ], ulPeriods[ ux ] );
+		}
+
+		ulCallbacks = 0;
+		ullExpiry = prvTimeSteps();
+		ullExpiry = ( ullExpiry > ullIdleSteps ) ? ( ( ullExpiry - ullIdleSteps ) / ulCallbacks ) : 0;
+		prvStopTimers( uxTimers );
+
+		printf( "%13u  %8lu  %9lu\n", ( unsigned ) uxTimers, ( unsigned long ) ullStartCost, ( unsigned long ) ullExpiry );
+	}
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+UBaseType_t ux;
+
+	for( ux = 0; ux < benchMAX_TIMERS; ux++ )
+	{
+		xTimers[ ux ] = xHRTimerCreate( prvTimerCallback, ( void * ) ( uintptr_t ) ux );
+		configASSERT( xTimers[ ux ] );
+	}
+
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
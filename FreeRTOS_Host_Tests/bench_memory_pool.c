@@ -0,0 +1,269 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * Measures the time taken to allocate and free fixed size blocks from a
+ * memory pool, and the same blocks from heap_4.c with pvPortMalloc() and
+ * vPortFree(), on the same random trace of allocations and frees.
+ *
+ * The trace is run with the rest of the heap unused, then again after the
+ * heap has been fragmented by freeing every other one of a run of blocks of
+ * random sizes, which lengthens the free list heap_4.c searches but does not
+ * affect the pool.  Each call is timed on its own, less the time taken to
+ * read the clock, and the mean and 99.9th percentile are reported.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "memory_pool.h"
+
+#define benchOPERATIONS		( 400000UL )
+#define benchBLOCK_SIZE		( ( size_t ) 32 )
+#define benchMAX_LIVE		( 64 )
+#define benchFRAGMENTS		( 2000 )
+
+/* Call times are counted in 1 ns buckets up to this many ns, and in the last
+bucket beyond it. */
+#define benchBUCKETS		( 20000 )
+
+typedef struct
+{
+	uint64_t ullTotal;
+	uint32_t ulCalls;
+	uint32_t ulBuckets[ benchBUCKETS ];
+} Timings_t;
+
+static void *pvLive[ benchMAX_LIVE ];
+static void *pvFragments[ benchFRAGMENTS ];
+static Timings_t xAllocTimings, xFreeTimings;
+static uint64_t ullClockOverhead;
+static MemoryPoolHandle_t xPool = NULL;
+static uint32_t ulRandState = 0x9e3779b9UL;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+	/* xorshift32. */
+	ulRandState ^= ulRandState << 13;
+	ulRandState ^= ulRandState >> 17;
+	ulRandState ^= ulRandState << 5;
+	return ulRandState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRecord( Timings_t *pxTimings, uint64_t ullStart, uint64_t ullEnd )
+{
+uint64_t ullTime = ullEnd - ullStart;
+
+	ullTime = ( ullTime > ullClockOverhead ) ? ( ullTime - ullClockOverhead ) : 0;
+	pxTimings->ullTotal += ullTime;
+	pxTimings->ulCalls++;
+	pxTimings->ulBuckets[ ( ullTime < benchBUCKETS ) ? ullTime : ( benchBUCKETS - 1 ) ]++;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvPercentile999( const Timings_t *pxTimings )
+{
+uint32_t ulBucket, ulCount = 0, ulLimit = pxTimings->ulCalls - ( pxTimings->ulCalls / 1000 );
+
+	for( ulBucket = 0; ulBucket < ( benchBUCKETS - 1 ); ulBucket++ )
+	{
+		ulCount += pxTimings->ulBuckets[ ulBucket ];
+
+		if( ulCount >= ulLimit )
+		{
+			break;
+		}
+	}
+
+	return ulBucket;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvAllocate( BaseType_t xUsePool )
+{
+	return ( xUsePool != pdFALSE ) ? pvMemoryPoolAlloc( xPool, 0 ) : pvPortMalloc( benchBLOCK_SIZE );
+}
+/*-----------------------------------------------------------*/
+
+static void prvFree( BaseType_t xUsePool, void *pvBlock )
+{
+	if( xUsePool != pdFALSE )
+	{
+		vMemoryPoolFree( xPool, pvBlock );
+	}
+	else
+	{
+		vPortFree( pvBlock );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvFreeRandom( BaseType_t xUsePool, UBaseType_t *puxLive )
+{
+UBaseType_t uxIndex = ( UBaseType_t ) ( prvRand() % *puxLive );
+uint64_t ullStart;
+
+	ullStart = ullPortGetTimeNs();
+	prvFree( xUsePool, pvLive[ uxIndex ] );
+	prvRecord( &xFreeTimings, ullStart, ullPortGetTimeNs() );
+
+	( *puxLive )--;
+	pvLive[ uxIndex ] = pvLive[ *puxLive ];
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunTrace( const char *pcName, BaseType_t xUsePool )
+{
+UBaseType_t uxLive = 0;
+uint32_t ul;
+uint64_t ullStart;
+void *pvBlock;
+
+	memset( &xAllocTimings, 0, sizeof( xAllocTimings ) );
+	memset( &xFreeTimings, 0, sizeof( xFreeTimings ) );
+
+	for( ul = 0; ul < benchOPERATIONS; ul++ )
+	{
+		if( ( uxLive < benchMAX_LIVE ) && ( ( uxLive == 0 ) || ( ( prvRand() % 2 ) == 0 ) ) )
+		{
+			ullStart = ullPortGetTimeNs();
+			pvBlock = prvAllocate( xUsePool );
+			prvRecord( &xAllocTimings, ullStart, ullPortGetTimeNs() );
+
+			configASSERT( pvBlock );
+			pvLive[ uxLive ] = pvBlock;
+			uxLive++;
+		}
+		else
+		{
+			prvFreeRandom( xUsePool, &uxLive );
+		}
+	}
+
+	while( uxLive > 0 )
+	{
+		prvFreeRandom( xUsePool, &uxLive );
+	}
+
+	printf( "%-28s  %6lu  %6lu  %6lu  %6lu\n", pcName,
+		( unsigned long ) ( xAllocTimings.ullTotal / xAllocTimings.ulCalls ), ( unsigned long ) prvPercentile999( &xAllocTimings ),
+		( unsigned long ) ( xFreeTimings.ullTotal / xFreeTimings.ulCalls ), ( unsigned long ) prvPercentile999( &xFreeTimings ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunBoth( const char *pcHeap )
+{
+char cName[ 40 ];
+const uint32_t ulSeed = ulRandState;
+
+	/* Both allocators see the same trace. */
+	snprintf( cName, sizeof( cName ), "pool, %s", pcHeap );
+	prvRunTrace( cName, pdTRUE );
+	ulRandState = ulSeed;
+	snprintf( cName, sizeof( cName ), "heap_4, %s", pcHeap );
+	prvRunTrace( cName, pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+const size_t xFreeBefore = xPortGetFreeHeapSize();
+UBaseType_t ux;
+uint64_t ullStart, ullMin = ~0ULL;
+
+	/* The least time taken to read the clock twice. */
+	for( ux = 0; ux < 1000; ux++ )
+	{
+		ullStart = ullPortGetTimeNs();
+		ullStart = ullPortGetTimeNs() - ullStart;
+
+		if( ullStart < ullMin )
+		{
+			ullMin = ullStart;
+		}
+	}
+
+	ullClockOverhead = ullMin;
+
+	xPool = xMemoryPoolCreate( benchBLOCK_SIZE, benchMAX_LIVE );
+	configASSERT( xPool );
+
+	printf( "%lu operations of %lu byte blocks, up to %lu live, ns per call\n", ( unsigned long ) benchOPERATIONS, ( unsigned long ) benchBLOCK_SIZE, ( unsigned long ) benchMAX_LIVE );
+	printf( "allocator, heap                alloc   p99.9    free   p99.9\n" );
+
+	prvRunBoth( "unused heap" );
+
+	/* Leave every other one of a run of blocks allocated, so the free list
+	holds a free block between each pair. */
+	for( ux = 0; ux < benchFRAGMENTS; ux++ )
+	{
+		pvFragments[ ux ] = pvPortMalloc( 8 + ( prvRand() % 120 ) );
+		configASSERT( pvFragments[ ux ] );
+	}
+
+	for( ux = 0; ux < benchFRAGMENTS; ux += 2 )
+	{
+		vPortFree( pvFragments[ ux ] );
+	}
+
+	prvRunBoth( "fragmented heap" );
+
+	for( ux = 1; ux < benchFRAGMENTS; ux += 2 )
+	{
+		vPortFree( pvFragments[ ux ] );
+	}
+
+	vMemoryPoolDelete( xPool );
+	configASSERT( xPortGetFreeHeapSize() == xFreeBefore );
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
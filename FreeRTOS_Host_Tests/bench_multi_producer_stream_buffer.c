@@ -0,0 +1,195 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Measures the time taken to pass messages from 1 to 8 producer tasks to one
+ * reader task through a message buffer created with
+ * xMessageBufferCreateMultiProducer(), and through a single writer message
+ * buffer with writes serialised by a mutex.  The producers are preempted at
+ * random, and every message is checked by the reader.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "message_buffer.h"
+
+#define benchMESSAGES		( 200000UL )
+#define benchMAX_PRODUCERS	( 8 )
+#define benchMESSAGE_BYTES	( 16 )
+#define benchBUFFER_SIZE	( 256 )
+
+/* One in this many critical section exits is followed by a switch to another
+producer. */
+#define benchPREEMPT_ONE_IN	( 8 )
+
+static MessageBufferHandle_t xMessageBuffer;
+static SemaphoreHandle_t xMutex;
+static TaskHandle_t xControl;
+static volatile uint32_t ulMessagesPerProducer;
+static UBaseType_t uxProducers;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+/* Each message holds the producer number, the message number, and a payload
+derived from both.  The mutex is only used if xMutex is not NULL. */
+static void prvProducerTask( void *pvParameters )
+{
+uint32_t ulProducer = ( uint32_t ) ( uintptr_t ) pvParameters;
+uint32_t ulMessage[ benchMESSAGE_BYTES / sizeof( uint32_t ) ];
+uint32_t ul;
+
+	for( ul = 0; ul < ulMessagesPerProducer; ul++ )
+	{
+		ulMessage[ 0 ] = ulProducer;
+		ulMessage[ 1 ] = ul;
+		ulMessage[ 2 ] = ulProducer ^ ul;
+		ulMessage[ 3 ] = ~ul;
+
+		if( xMutex != NULL )
+		{
+			configASSERT( xSemaphoreTake( xMutex, portMAX_DELAY ) == pdPASS );
+			configASSERT( xMessageBufferSend( xMessageBuffer, ulMessage, sizeof( ulMessage ), portMAX_DELAY ) == sizeof( ulMessage ) );
+			configASSERT( xSemaphoreGive( xMutex ) == pdPASS );
+		}
+		else
+		{
+			configASSERT( xMessageBufferSend( xMessageBuffer, ulMessage, sizeof( ulMessage ), portMAX_DELAY ) == sizeof( ulMessage ) );
+		}
+	}
+
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReaderTask( void *pvParameters )
+{
+uint32_t ulMessage[ benchMESSAGE_BYTES / sizeof( uint32_t ) ];
+uint32_t ulNext[ benchMAX_PRODUCERS ] = { 0 };
+uint32_t ul;
+
+	for( ul = 0; ul < ( ulMessagesPerProducer * uxProducers ); ul++ )
+	{
+		configASSERT( xMessageBufferReceive( xMessageBuffer, ulMessage, sizeof( ulMessage ), portMAX_DELAY ) == sizeof( ulMessage ) );
+		configASSERT( ulMessage[ 0 ] < uxProducers );
+		configASSERT( ulMessage[ 1 ] == ulNext[ ulMessage[ 0 ] ] );
+		configASSERT( ( ulMessage[ 2 ] == ( ulMessage[ 0 ] ^ ulMessage[ 1 ] ) ) && ( ulMessage[ 3 ] == ~ulMessage[ 1 ] ) );
+		ulNext[ ulMessage[ 0 ] ]++;
+	}
+
+	xTaskNotifyGive( xControl );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+/* Returns the mean time per message in nanoseconds. */
+static uint64_t prvRun( BaseType_t xMultiProducer )
+{
+UBaseType_t ux;
+uint64_t ullStart, ullEnd;
+
+	if( xMultiProducer != pdFALSE )
+	{
+		xMessageBuffer = xMessageBufferCreateMultiProducer( benchBUFFER_SIZE );
+		xMutex = NULL;
+	}
+	else
+	{
+		xMessageBuffer = xMessageBufferCreate( benchBUFFER_SIZE );
+		xMutex = xSemaphoreCreateMutex();
+		configASSERT( xMutex );
+	}
+
+	configASSERT( xMessageBuffer );
+	ulMessagesPerProducer = benchMESSAGES / uxProducers;
+
+	ullStart = ullPortGetTimeNs();
+
+	for( ux = 0; ux < uxProducers; ux++ )
+	{
+		configASSERT( xTaskCreate( prvProducerTask, "Producer", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) ux, 1, NULL ) == pdPASS );
+	}
+
+	configASSERT( xTaskCreate( prvReaderTask, "Reader", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+	ullEnd = ullPortGetTimeNs();
+
+	/* Let the idle task free the deleted tasks. */
+	vTaskDelay( 1 );
+	vMessageBufferDelete( xMessageBuffer );
+
+	if( xMutex != NULL )
+	{
+		vSemaphoreDelete( xMutex );
+	}
+
+	return ( ullEnd - ullStart ) / ( ulMessagesPerProducer * uxProducers );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+uint64_t ullMultiProducer, ullMutex;
+
+	vPortSetRandomPreemption( benchPREEMPT_ONE_IN, 1 );
+
+	printf( "producers  multi-producer ns/msg  mutex ns/msg\n" );
+
+	for( uxProducers = 1; uxProducers <= benchMAX_PRODUCERS; uxProducers++ )
+	{
+		ullMultiProducer = prvRun( pdTRUE );
+		ullMutex = prvRun( pdFALSE );
+		printf( "%9u  %21lu  %12lu\n", ( unsigned ) uxProducers, ( unsigned long ) ullMultiProducer, ( unsigned long ) ullMutex );
+	}
+
+	vPortSetRandomPreemption( 0, 0 );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, &xControl );
+	configASSERT( xControl );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,207 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Measures how long a high priority task is blocked on a mutex at the head of
+ * a chain of three blocked mutex holders while a CPU bound task runs at a
+ * priority between theirs and its own.  The Makefile builds it with
+ * configMAX_PRIORITY_INHERITANCE_DEPTH set to 3, and with the default of 1,
+ * which only raises the direct holder of the mutex.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#define benchCYCLES			( 30 )
+
+/* The ticks of work done by the end of the chain once it is released. */
+#define benchWORK_TICKS		( 2 )
+
+#define benchHIGH_PRIORITY	( 5 )
+#define benchHOG_PRIORITY	( 4 )
+
+static SemaphoreHandle_t xMutexA, xMutexB, xMutexC;
+static TaskHandle_t xControl, xHigh, xHog, xM, xK, xL;
+static volatile TickType_t xHogTicks, xBlockedTicks;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+/* Run for xTicks ticks, as if executing code, so time passes while the
+calling task runs. */
+static void prvWork( TickType_t xTicks )
+{
+	while( xTicks > ( TickType_t ) 0 )
+	{
+		vPortSimulateTick();
+		xTicks--;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvHighTask( void *pvParameters )
+{
+TickType_t xStart;
+
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		xStart = xTaskGetTickCount();
+		configASSERT( xSemaphoreTake( xMutexA, portMAX_DELAY ) == pdPASS );
+		xBlockedTicks = xTaskGetTickCount() - xStart;
+		configASSERT( xSemaphoreGive( xMutexA ) == pdPASS );
+		xTaskNotifyGive( xControl );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvHogTask( void *pvParameters )
+{
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		prvWork( xHogTicks );
+		xTaskNotifyGive( xControl );
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* M holds A and waits for B, K holds B and waits for C. */
+static void prvHolderTask( void *pvParameters )
+{
+SemaphoreHandle_t *pxMutexes = ( SemaphoreHandle_t * ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		configASSERT( xSemaphoreTake( pxMutexes[ 0 ], 0 ) == pdPASS );
+		configASSERT( xSemaphoreTake( pxMutexes[ 1 ], portMAX_DELAY ) == pdPASS );
+		configASSERT( xSemaphoreGive( pxMutexes[ 1 ] ) == pdPASS );
+		configASSERT( xSemaphoreGive( pxMutexes[ 0 ] ) == pdPASS );
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* L, the end of the chain, holds C until it is released, then works for a
+while before giving it. */
+static void prvEndTask( void *pvParameters )
+{
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		configASSERT( xSemaphoreTake( xMutexC, 0 ) == pdPASS );
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		prvWork( benchWORK_TICKS );
+		configASSERT( xSemaphoreGive( xMutexC ) == pdPASS );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+UBaseType_t uxCycle;
+TickType_t xTotal = 0, xMax = 0;
+
+	for( uxCycle = 0; uxCycle < benchCYCLES; uxCycle++ )
+	{
+		/* Build the chain. */
+		xTaskNotifyGive( xL );
+		vTaskDelay( 1 );
+		xTaskNotifyGive( xK );
+		vTaskDelay( 1 );
+		xTaskNotifyGive( xM );
+		vTaskDelay( 1 );
+
+		/* Start the hog for a varying time, release the end of the chain,
+		then have the high priority task block on the head of the chain.
+		Wait for both the hog and the high priority task to finish. */
+		xHogTicks = ( TickType_t ) ( 4 + ( uxCycle % 13 ) );
+		xTaskNotifyGive( xHog );
+		xTaskNotifyGive( xL );
+		xTaskNotifyGive( xHigh );
+		( void ) ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+		( void ) ulTaskNotifyTake( pdFALSE, portMAX_DELAY );
+
+		xTotal += xBlockedTicks;
+
+		if( xBlockedTicks > xMax )
+		{
+			xMax = xBlockedTicks;
+		}
+
+		configASSERT( uxTaskPriorityGet( xM ) == 3 );
+		configASSERT( uxTaskPriorityGet( xK ) == 2 );
+		configASSERT( uxTaskPriorityGet( xL ) == 1 );
+	}
+
+	printf( "depth %u: blocked %lu ticks worst case, %lu.%02lu mean, over %u cycles\n",
+		( unsigned ) configMAX_PRIORITY_INHERITANCE_DEPTH, ( unsigned long ) xMax,
+		( unsigned long ) ( xTotal / benchCYCLES ), ( unsigned long ) ( ( ( xTotal % benchCYCLES ) * 100 ) / benchCYCLES ),
+		( unsigned ) benchCYCLES );
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+static SemaphoreHandle_t xMutexesOfM[ 2 ], xMutexesOfK[ 2 ];
+
+	xMutexA = xSemaphoreCreateMutex();
+	xMutexB = xSemaphoreCreateMutex();
+	xMutexC = xSemaphoreCreateMutex();
+	configASSERT( xMutexA && xMutexB && xMutexC );
+
+	xMutexesOfM[ 0 ] = xMutexA;
+	xMutexesOfM[ 1 ] = xMutexB;
+	xMutexesOfK[ 0 ] = xMutexB;
+	xMutexesOfK[ 1 ] = xMutexC;
+
+	xTaskCreate( prvEndTask, "L", configMINIMAL_STACK_SIZE, NULL, 1, &xL );
+	xTaskCreate( prvHolderTask, "K", configMINIMAL_STACK_SIZE, xMutexesOfK, 2, &xK );
+	xTaskCreate( prvHolderTask, "M", configMINIMAL_STACK_SIZE, xMutexesOfM, 3, &xM );
+	xTaskCreate( prvHogTask, "Hog", configMINIMAL_STACK_SIZE, NULL, benchHOG_PRIORITY, &xHog );
+	xTaskCreate( prvHighTask, "High", configMINIMAL_STACK_SIZE, NULL, benchHIGH_PRIORITY, &xHigh );
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, &xControl );
+	configASSERT( xL && xK && xM && xHog && xHigh && xControl );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
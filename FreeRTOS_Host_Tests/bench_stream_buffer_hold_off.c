@@ -0,0 +1,176 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * Measures how often a reader is unblocked, and how long each byte waits in
+ * the buffer, when single bytes are written to a stream buffer at an uneven
+ * rate.  A trigger level of one unblocks the reader for every byte.  A higher
+ * trigger level unblocks it less often, but bytes that arrive slowly wait
+ * until enough have followed them.  Adding a trigger hold-off bounds that
+ * wait while keeping most of the reduction in wakes.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+
+/* A multiple of the largest trigger level, so every byte is received. */
+#define benchBYTES			( 4096 )
+#define benchBUFFER_SIZE	( 64 )
+
+typedef struct
+{
+	size_t xTriggerLevel;
+	TickType_t xHoldOffTicks;
+} Setting_t;
+
+static StreamBufferHandle_t xStreamBuffer;
+static TaskHandle_t xControl, xReader;
+
+/* The tick each byte was written on, and the reader's results. */
+static TickType_t xWriteTick[ benchBYTES ];
+static volatile uint32_t ulWakes;
+static volatile TickType_t xTotalLatency, xMaxLatency;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+static uint32_t ulState = 0x5eed0ffUL;
+
+	/* xorshift32. */
+	ulState ^= ulState << 13;
+	ulState ^= ulState >> 17;
+	ulState ^= ulState << 5;
+	return ulState;
+}
+/*-----------------------------------------------------------*/
+
+/* Each time it is notified, receives benchBYTES bytes from xStreamBuffer,
+recording how long each byte waited. */
+static void prvReaderTask( void *pvParameters )
+{
+uint8_t ucReceived[ benchBUFFER_SIZE ];
+size_t xBytes, xReceived;
+TickType_t xLatency;
+
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		ulWakes = 0;
+		xTotalLatency = 0;
+		xMaxLatency = 0;
+
+		for( xBytes = 0; xBytes < benchBYTES; )
+		{
+			xReceived = xStreamBufferReceive( xStreamBuffer, ucReceived, sizeof( ucReceived ), portMAX_DELAY );
+			configASSERT( xReceived > ( size_t ) 0 );
+			ulWakes++;
+
+			while( xReceived > ( size_t ) 0 )
+			{
+				xLatency = xTaskGetTickCount() - xWriteTick[ xBytes ];
+				xTotalLatency += xLatency;
+
+				if( xLatency > xMaxLatency )
+				{
+					xMaxLatency = xLatency;
+				}
+
+				xBytes++;
+				xReceived--;
+			}
+		}
+
+		xTaskNotifyGive( xControl );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+static const Setting_t xSettings[] = { { 1, 0 }, { 16, 0 }, { 16, 2 }, { 16, 4 }, { 16, 8 } };
+static const uint8_t ucByte = 0;
+size_t xSetting, xByte;
+
+	xTaskCreate( prvReaderTask, "Reader", configMINIMAL_STACK_SIZE, NULL, 2, &xReader );
+	configASSERT( xReader );
+
+	printf( "%u bytes written one at a time, 1 or 8 ticks apart\n", ( unsigned ) benchBYTES );
+	printf( "trigger  hold-off  wakes per 100 bytes  mean ticks  max ticks\n" );
+
+	for( xSetting = 0; xSetting < ( sizeof( xSettings ) / sizeof( xSettings[ 0 ] ) ); xSetting++ )
+	{
+		xStreamBuffer = xStreamBufferCreate( benchBUFFER_SIZE, xSettings[ xSetting ].xTriggerLevel );
+		configASSERT( xStreamBuffer );
+		configASSERT( xStreamBufferSetTriggerHoldOff( xStreamBuffer, xSettings[ xSetting ].xHoldOffTicks ) == pdPASS );
+		/* Let the reader block on the empty buffer first. */
+		xTaskNotifyGive( xReader );
+		vTaskDelay( 1 );
+
+		/* Mostly one byte a tick, with gaps in which data arrives slowly. */
+		for( xByte = 0; xByte < benchBYTES; xByte++ )
+		{
+			xWriteTick[ xByte ] = xTaskGetTickCount();
+			configASSERT( xStreamBufferSend( xStreamBuffer, &ucByte, sizeof( ucByte ), 0 ) == sizeof( ucByte ) );
+			vTaskDelay( ( ( prvRand() % 4 ) == 0 ) ? ( TickType_t ) 8 : ( TickType_t ) 1 );
+		}
+
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+		printf( "%7lu  %8lu  %19lu  %7lu.%02lu  %9lu\n",
+			( unsigned long ) xSettings[ xSetting ].xTriggerLevel, ( unsigned long ) xSettings[ xSetting ].xHoldOffTicks,
+			( unsigned long ) ( ( ulWakes * 100UL ) / benchBYTES ), ( unsigned long ) ( xTotalLatency / benchBYTES ),
+			( unsigned long ) ( ( ( xTotalLatency % benchBYTES ) * 100 ) / benchBYTES ), ( unsigned long ) xMaxLatency );
+
+		vStreamBufferDelete( xStreamBuffer );
+	}
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, &xControl );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
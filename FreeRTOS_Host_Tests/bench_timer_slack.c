@@ -0,0 +1,134 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Counts the wake ups of the timer service task needed by 120 auto-reload
+ * timers with unrelated periods of 20 to 1000 ticks, with each timer given a
+ * slack of 0% to 50% of its period.  The Makefile builds it with the sorted
+ * lists and, as bench_timer_slack_wheel, with configUSE_TIMER_WHEEL set to 1.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#define benchTIMERS			( 120 )
+#define benchTICKS			( 100000UL )
+
+static TimerHandle_t xTimers[ benchTIMERS ];
+static TickType_t xPeriods[ benchTIMERS ];
+static uint32_t ulCallbacks;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+static uint32_t ulState = 0x600df00dUL;
+
+	/* xorshift32. */
+	ulState ^= ulState << 13;
+	ulState ^= ulState >> 17;
+	ulState ^= ulState << 5;
+	return ulState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+	ulCallbacks++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+static const uint32_t ulSlackPercents[] = { 0, 5, 10, 25, 50 };
+TimerWakeStats_t xBefore, xAfter;
+UBaseType_t uxSlack, ux;
+
+	printf( "%s, %u timers, %lu ticks\n", ( configUSE_TIMER_WHEEL == 1 ) ? "timing wheel" : "sorted lists", ( unsigned ) benchTIMERS, ( unsigned long ) benchTICKS );
+	printf( "slack  callbacks  wake ups  expiry times  wake ups saved\n" );
+
+	for( uxSlack = 0; uxSlack < ( sizeof( ulSlackPercents ) / sizeof( ulSlackPercents[ 0 ] ) ); uxSlack++ )
+	{
+		/* Start one timer each tick so they are out of phase.  The expiry
+		times are then the same for every slack. */
+		for( ux = 0; ux < benchTIMERS; ux++ )
+		{
+			vTimerSetSlack( xTimers[ ux ], ( xPeriods[ ux ] * ulSlackPercents[ uxSlack ] ) / 100 );
+			configASSERT( xTimerChangePeriod( xTimers[ ux ], xPeriods[ ux ], portMAX_DELAY ) == pdPASS );
+			vTaskDelay( 1 );
+		}
+
+		ulCallbacks = 0;
+		vTimerGetWakeStats( &xBefore );
+		vTaskDelay( benchTICKS );
+		vTimerGetWakeStats( &xAfter );
+
+		for( ux = 0; ux < benchTIMERS; ux++ )
+		{
+			configASSERT( xTimerStop( xTimers[ ux ], portMAX_DELAY ) == pdPASS );
+		}
+
+		vTaskDelay( 1 );
+
+		printf( "%4lu%%  %9lu  %8lu  %12lu  %14lu\n", ( unsigned long ) ulSlackPercents[ uxSlack ], ( unsigned long ) ulCallbacks,
+			( unsigned long ) ( xAfter.ulWakeUps - xBefore.ulWakeUps ), ( unsigned long ) ( xAfter.ulExpiryTimes - xBefore.ulExpiryTimes ),
+			( unsigned long ) ( xAfter.ulWakeUpsSaved - xBefore.ulWakeUpsSaved ) );
+	}
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+UBaseType_t ux;
+
+	for( ux = 0; ux < benchTIMERS; ux++ )
+	{
+		xPeriods[ ux ] = ( TickType_t ) ( 20 + ( prvRand() % 981 ) );
+		xTimers[ ux ] = xTimerCreate( "Timer", xPeriods[ ux ], pdTRUE, NULL, prvTimerCallback );
+		configASSERT( xTimers[ ux ] );
+	}
+
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,198 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Measures the cost of software timer commands and expiries against the
+ * number of active timers, from 10 to 10000.  The Makefile builds it with
+ * configUSE_TIMER_WHEEL set to 1, and with the default of 0, where active
+ * timers are held in sorted lists.
+ *
+ * The reset cost is the time from sending xTimerReset() to a random active
+ * timer to the timer service task having processed it, including the round
+ * trip through the timer command queue.  The expiry cost is the time per
+ * callback of auto-reload timers expiring every few ticks, less the time the
+ * same ticks take with no timer active.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#define benchMAX_TIMERS		( 10000 )
+#define benchRESETS			( 20000UL )
+#define benchTICKS			( 2000UL )
+
+static TimerHandle_t xTimers[ benchMAX_TIMERS ];
+static TaskHandle_t xControl;
+static volatile uint32_t ulCallbacks;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+static uint32_t ulState = 0x13579bdfUL;
+
+	/* xorshift32. */
+	ulState ^= ulState << 13;
+	ulState ^= ulState >> 17;
+	ulState ^= ulState << 5;
+	return ulState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+	ulCallbacks++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvNotifyControl( void *pvParameter1, uint32_t ulParameter2 )
+{
+	xTaskNotifyGive( xControl );
+}
+/*-----------------------------------------------------------*/
+
+/* Wait until the timer service task has processed every command sent so far. */
+static void prvWaitForTimerServiceTask( void )
+{
+	configASSERT( xTimerPendFunctionCall( prvNotifyControl, NULL, 0, portMAX_DELAY ) == pdPASS );
+	( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+}
+/*-----------------------------------------------------------*/
+
+/* Start the first uxTimers timers, with periods from xPeriod to twice xPeriod,
+in a random order so the sorted lists are not built in order. */
+static void prvStartTimers( UBaseType_t uxTimers, TickType_t xPeriod )
+{
+UBaseType_t ux;
+
+	for( ux = 0; ux < uxTimers; ux++ )
+	{
+		configASSERT( xTimerChangePeriod( xTimers[ ux ], xPeriod + ( TickType_t ) ( prvRand() % xPeriod ), portMAX_DELAY ) == pdPASS );
+	}
+
+	prvWaitForTimerServiceTask();
+}
+/*-----------------------------------------------------------*/
+
+static void prvStopTimers( UBaseType_t uxTimers )
+{
+UBaseType_t ux;
+
+	for( ux = 0; ux < uxTimers; ux++ )
+	{
+		configASSERT( xTimerStop( xTimers[ ux ], portMAX_DELAY ) == pdPASS );
+	}
+
+	prvWaitForTimerServiceTask();
+}
+/*-----------------------------------------------------------*/
+
+/* Returns the time taken for xTicks ticks to pass. */
+static uint64_t prvTimeTicks( TickType_t xTicks )
+{
+uint64_t ullStart = ullPortGetTimeNs();
+
+	vTaskDelay( xTicks );
+	return ullPortGetTimeNs() - ullStart;
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+static const UBaseType_t uxCounts[] = { 10, 100, 1000, 10000 };
+UBaseType_t uxCount, uxTimers;
+uint64_t ullStart, ullReset, ullIdleTicks, ullExpiry;
+uint32_t ul;
+
+	ullIdleTicks = prvTimeTicks( benchTICKS );
+
+	printf( "%s\n", ( configUSE_TIMER_WHEEL == 1 ) ? "timing wheel" : "sorted lists" );
+	printf( "active timers  reset ns  expiry ns\n" );
+
+	for( uxCount = 0; uxCount < ( sizeof( uxCounts ) / sizeof( uxCounts[ 0 ] ) ); uxCount++ )
+	{
+		uxTimers = uxCounts[ uxCount ];
+
+		/* Reset random timers whose periods are long enough that none expire
+		while they are measured. */
+		prvStartTimers( uxTimers, 100000 );
+		ullStart = ullPortGetTimeNs();
+
+		for( ul = 0; ul < benchRESETS; ul++ )
+		{
+			configASSERT( xTimerReset( xTimers[ prvRand() % uxTimers ], portMAX_DELAY ) == pdPASS );
+		}
+
+		prvWaitForTimerServiceTask();
+		ullReset = ( ullPortGetTimeNs() - ullStart ) / benchRESETS;
+		prvStopTimers( uxTimers );
+
+		/* Expire the timers with periods chosen so about ten expire each
+		tick, whatever the number of timers. */
+		prvStartTimers( uxTimers, ( uxTimers >= 15 ) ? ( TickType_t ) ( uxTimers / 15 ) : 1 );
+		ulCallbacks = 0;
+		ullExpiry = prvTimeTicks( benchTICKS );
+		ullExpiry = ( ullExpiry > ullIdleTicks ) ? ( ( ullExpiry - ullIdleTicks ) / ulCallbacks ) : 0;
+		prvStopTimers( uxTimers );
+
+		printf( "%13u  %8lu  %9lu\n", ( unsigned ) uxTimers, ( unsigned long ) ullReset, ( unsigned long ) ullExpiry );
+	}
+
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+UBaseType_t ux;
+
+	for( ux = 0; ux < benchMAX_TIMERS; ux++ )
+	{
+		xTimers[ ux ] = xTimerCreate( "Timer", 1, pdTRUE, NULL, prvTimerCallback );
+		configASSERT( xTimers[ ux ] );
+	}
+
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, &xControl );
+	configASSERT( xControl );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
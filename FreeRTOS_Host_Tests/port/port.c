@@ -0,0 +1,392 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for the host simulation
+ * used by the tests and benchmarks in FreeRTOS_Host_Tests.
+ *----------------------------------------------------------*/
+
+#define _XOPEN_SOURCE 700
+
+#include <ucontext.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "hr_timers.h"
+
+/* The host stack given to each task.  Host library calls, printf() in
+particular, need far more stack than the tests ask for, so the stack allocated
+by the kernel only holds a pointer to the task's HostTask_t. */
+#define portHOST_STACK_SIZE		( 128 * 1024 )
+
+typedef struct HostTask
+{
+	ucontext_t xContext;
+	TaskFunction_t pxCode;
+	void *pvParameters;
+} HostTask_t;
+
+/* The first member of the TCB points to the top of the task's stack. */
+extern void * volatile pxCurrentTCB;
+#define prvHOST_TASK( pvTCB )	( ( HostTask_t * ) ( ( *( StackType_t ** ) ( pvTCB ) )[ 0 ] ) )
+
+static ucontext_t xSchedulerContext;
+static volatile UBaseType_t uxInterruptMaskNesting = 0;
+static volatile BaseType_t xInsideInterrupt = pdFALSE;
+static volatile BaseType_t xPortYieldPending = pdFALSE;
+static uint32_t ulPreemptOneIn = 0, ulRandomState = 1;
+static uint32_t ulContextSwitches = 0;
+
+#if( configUSE_HR_TIMERS == 1 )
+	/* The simulated high resolution timer counter and its compare channel.  A
+	match while interrupts are masked is held pending until they are
+	unmasked. */
+	static uint32_t ulHRTimerCount = 0, ulHRTimerCompare = 0, ulHRTimerCountsPerRead = 0;
+	static BaseType_t xHRTimerCompareEnabled = pdFALSE, xHRTimerComparePending = pdFALSE;
+
+	static uint32_t prvAdvanceHRTimerCount( uint32_t ulCounts );
+	static void prvRunPendingHRTimerInterrupt( void );
+#endif
+
+/*-----------------------------------------------------------*/
+
+static void prvTaskEntry( void )
+{
+HostTask_t *pxHostTask = prvHOST_TASK( pxCurrentTCB );
+
+	pxHostTask->pxCode( pxHostTask->pvParameters );
+
+	/* As on the target, a task must not return from its implementing
+	function. */
+	fprintf( stderr, "A task returned from its implementing function.\n" );
+	abort();
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchContext( void )
+{
+void *pvPreviousTCB = pxCurrentTCB;
+
+	xPortYieldPending = pdFALSE;
+	vTaskSwitchContext();
+
+	if( pxCurrentTCB != pvPreviousTCB )
+	{
+		ulContextSwitches++;
+		swapcontext( &( prvHOST_TASK( pvPreviousTCB )->xContext ), &( prvHOST_TASK( pxCurrentTCB )->xContext ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvYieldIfPending( void )
+{
+	#if( configUSE_HR_TIMERS == 1 )
+	{
+		prvRunPendingHRTimerInterrupt();
+	}
+	#endif
+
+	if( ( xPortYieldPending != pdFALSE ) && ( uxInterruptMaskNesting == 0 ) && ( xInsideInterrupt == pdFALSE ) )
+	{
+		prvSwitchContext();
+	}
+}
+/*-----------------------------------------------------------*/
+
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+HostTask_t *pxHostTask = calloc( 1, sizeof( HostTask_t ) );
+
+	configASSERT( pxHostTask );
+	getcontext( &( pxHostTask->xContext ) );
+	pxHostTask->xContext.uc_stack.ss_size = portHOST_STACK_SIZE;
+	pxHostTask->xContext.uc_stack.ss_sp = malloc( portHOST_STACK_SIZE );
+	pxHostTask->xContext.uc_link = NULL;
+	configASSERT( pxHostTask->xContext.uc_stack.ss_sp );
+	pxHostTask->pxCode = pxCode;
+	pxHostTask->pvParameters = pvParameters;
+	makecontext( &( pxHostTask->xContext ), prvTaskEntry, 0 );
+
+	pxTopOfStack--;
+	*pxTopOfStack = ( StackType_t ) pxHostTask;
+
+	return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+void vPortCleanUpTCB( void *pvTCB )
+{
+HostTask_t *pxHostTask = prvHOST_TASK( pvTCB );
+
+	/* The task is never the one running when its TCB is deleted. */
+	free( pxHostTask->xContext.uc_stack.ss_sp );
+	free( pxHostTask );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+	uxInterruptMaskNesting = 0;
+	swapcontext( &xSchedulerContext, &( prvHOST_TASK( pxCurrentTCB )->xContext ) );
+
+	/* Only reached when a task calls vTaskEndScheduler(). */
+	uxInterruptMaskNesting = 0;
+	xInsideInterrupt = pdFALSE;
+	xPortYieldPending = pdFALSE;
+
+	return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+	setcontext( &xSchedulerContext );
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+	xPortYieldPending = pdTRUE;
+	prvYieldIfPending();
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	uxInterruptMaskNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	configASSERT( uxInterruptMaskNesting > 0 );
+	uxInterruptMaskNesting--;
+
+	if( ( uxInterruptMaskNesting == 0 ) && ( xInsideInterrupt == pdFALSE ) && ( ulPreemptOneIn != 0 ) )
+	{
+		/* xorshift32. */
+		ulRandomState ^= ulRandomState << 13;
+		ulRandomState ^= ulRandomState >> 17;
+		ulRandomState ^= ulRandomState << 5;
+
+		if( ( ulRandomState % ulPreemptOneIn ) == 0 )
+		{
+			xPortYieldPending = pdTRUE;
+		}
+	}
+
+	prvYieldIfPending();
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortSetInterruptMask( void )
+{
+UBaseType_t uxSavedInterruptStatus = uxInterruptMaskNesting;
+
+	uxInterruptMaskNesting = uxSavedInterruptStatus + 1;
+	return uxSavedInterruptStatus;
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( UBaseType_t uxSavedInterruptStatus )
+{
+	uxInterruptMaskNesting = uxSavedInterruptStatus;
+	prvYieldIfPending();
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortIsInsideInterrupt( void )
+{
+	return xInsideInterrupt;
+}
+/*-----------------------------------------------------------*/
+
+void vPortSimulateInterrupt( BaseType_t ( *pxHandler )( void ) )
+{
+UBaseType_t uxSavedInterruptStatus;
+BaseType_t xWasInsideInterrupt = xInsideInterrupt;
+
+	uxSavedInterruptStatus = uxPortSetInterruptMask();
+	xInsideInterrupt = pdTRUE;
+	{
+		if( pxHandler() != pdFALSE )
+		{
+			xPortYieldPending = pdTRUE;
+		}
+	}
+	xInsideInterrupt = xWasInsideInterrupt;
+	vPortClearInterruptMask( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTickInterrupt( void )
+{
+	return xTaskIncrementTick();
+}
+/*-----------------------------------------------------------*/
+
+void vPortSimulateTick( void )
+{
+	vPortSimulateInterrupt( prvTickInterrupt );
+}
+/*-----------------------------------------------------------*/
+
+void vPortSetRandomPreemption( uint32_t ulOneIn, uint32_t ulSeed )
+{
+	ulPreemptOneIn = ulOneIn;
+	ulRandomState = ( ulSeed != 0 ) ? ulSeed : 1;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulPortGetContextSwitchCount( void )
+{
+	return ulContextSwitches;
+}
+/*-----------------------------------------------------------*/
+
+uint64_t ullPortGetTimeNs( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HR_TIMERS == 1 )
+
+	void vPortConfigureHRTimer( uint32_t ulInitialCount )
+	{
+		ulHRTimerCount = ulInitialCount;
+		xHRTimerCompareEnabled = pdFALSE;
+		xHRTimerComparePending = pdFALSE;
+	}
+	/*-----------------------------------------------------------*/
+
+	uint32_t ulPortGetHRTimerCount( void )
+	{
+	uint32_t ulCount = ulHRTimerCount, ulCounts = ulHRTimerCountsPerRead;
+
+		while( ulCounts > 0 )
+		{
+			ulCounts = prvAdvanceHRTimerCount( ulCounts );
+		}
+
+		/* A match caused by the read interrupts the task straight away if
+		interrupts are unmasked. */
+		prvRunPendingHRTimerInterrupt();
+
+		return ulCount;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortSetHRTimerCompare( uint32_t ulCompareValue )
+	{
+		/* As on the target, a match against the previous compare value is
+		cleared. */
+		ulHRTimerCompare = ulCompareValue;
+		xHRTimerCompareEnabled = pdTRUE;
+		xHRTimerComparePending = pdFALSE;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortDisableHRTimerCompare( void )
+	{
+		xHRTimerCompareEnabled = pdFALSE;
+		xHRTimerComparePending = pdFALSE;
+	}
+	/*-----------------------------------------------------------*/
+
+	static uint32_t prvAdvanceHRTimerCount( uint32_t ulCounts )
+	{
+	uint32_t ulToCompare = ulHRTimerCompare - ulHRTimerCount;
+	uint32_t ulRemaining = 0;
+
+		/* The match only occurs when the counter becomes equal to the compare
+		value, so a compare value equal to the counter already is not reached
+		again until the counter wraps.  Stop at the match so the caller can run
+		the interrupt, and return the counts still to advance. */
+		if( ( xHRTimerCompareEnabled != pdFALSE ) && ( ulToCompare != 0 ) && ( ulToCompare <= ulCounts ) )
+		{
+			ulHRTimerCount = ulHRTimerCompare;
+			xHRTimerComparePending = pdTRUE;
+			ulRemaining = ulCounts - ulToCompare;
+		}
+		else
+		{
+			ulHRTimerCount += ulCounts;
+		}
+
+		return ulRemaining;
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvHRTimerCompareInterrupt( void )
+	{
+		return xHRTimerProcessCompareInterrupt();
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvRunPendingHRTimerInterrupt( void )
+	{
+		if( ( xHRTimerComparePending != pdFALSE ) && ( uxInterruptMaskNesting == 0 ) && ( xInsideInterrupt == pdFALSE ) )
+		{
+			xHRTimerComparePending = pdFALSE;
+			vPortSimulateInterrupt( prvHRTimerCompareInterrupt );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortAdvanceHRTimer( uint32_t ulCounts )
+	{
+		configASSERT( xInsideInterrupt == pdFALSE );
+
+		/* The interrupt can change the compare value, and can switch to a task
+		that advances the counter itself, so the counter is advanced one match
+		at a time. */
+		prvRunPendingHRTimerInterrupt();
+
+		while( ulCounts > 0 )
+		{
+			ulCounts = prvAdvanceHRTimerCount( ulCounts );
+			prvRunPendingHRTimerInterrupt();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortSetHRTimerCountsPerRead( uint32_t ulCounts )
+	{
+		ulHRTimerCountsPerRead = ulCounts;
+	}
+
+#endif /* configUSE_HR_TIMERS */
+/*-----------------------------------------------------------*/
+
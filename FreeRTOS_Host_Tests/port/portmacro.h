@@ -0,0 +1,170 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*-----------------------------------------------------------
+ * Port specific definitions for the host simulation used by the tests and
+ * benchmarks in FreeRTOS_Host_Tests.
+ *
+ * Each task runs on its own ucontext stack within a single host thread, so
+ * exactly one task runs at a time, as on the target.  Time only advances when
+ * vPortSimulateTick() is called, and interrupts are simulated by calling their
+ * handlers through vPortSimulateInterrupt(), so every run is repeatable.
+ *-----------------------------------------------------------
+ */
+
+/* Type definitions. */
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		long
+#define portSHORT		short
+#define portSTACK_TYPE	uintptr_t
+#define portBASE_TYPE	long
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#if( configUSE_16_BIT_TICKS == 1 )
+	typedef uint16_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffff
+#else
+	typedef uint32_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+
+	/* Only one task runs at a time and the tick is only simulated between
+	instructions, so reads of the tick count do not need to be guarded. */
+	#define portTICK_TYPE_IS_ATOMIC 1
+#endif
+/*-----------------------------------------------------------*/
+
+/* Architecture specifics. */
+#define portSTACK_GROWTH			( -1 )
+#define portTICK_PERIOD_MS			( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT			8
+#define portPOINTER_SIZE_TYPE		uintptr_t
+/*-----------------------------------------------------------*/
+
+/* Scheduler utilities.  A yield requested while interrupts are masked is held
+pending until they are unmasked, as a PendSV would be on the target. */
+extern void vPortYield( void );
+#define portYIELD()									vPortYield()
+#define portEND_SWITCHING_ISR( xSwitchRequired )	{ if( ( xSwitchRequired ) != pdFALSE ) { portYIELD(); } }
+#define portYIELD_FROM_ISR( x )						portEND_SWITCHING_ISR( x )
+/*-----------------------------------------------------------*/
+
+/* Critical section management.  There is a single level of interrupt masking,
+as if every simulated interrupt ran at configMAX_SYSCALL_INTERRUPT_PRIORITY. */
+extern void vPortEnterCritical( void );
+extern void vPortExitCritical( void );
+extern UBaseType_t uxPortSetInterruptMask( void );
+extern void vPortClearInterruptMask( UBaseType_t uxSavedInterruptStatus );
+#define portSET_INTERRUPT_MASK_FROM_ISR()		uxPortSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)	vPortClearInterruptMask( x )
+#define portDISABLE_INTERRUPTS()				( void ) uxPortSetInterruptMask()
+#define portENABLE_INTERRUPTS()					vPortClearInterruptMask( 0 )
+#define portENTER_CRITICAL()					vPortEnterCritical()
+#define portEXIT_CRITICAL()						vPortExitCritical()
+/*-----------------------------------------------------------*/
+
+/* Task function macros as described on the FreeRTOS.org WEB site. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+/*-----------------------------------------------------------*/
+
+#define portNOP()
+#define portINLINE	__inline
+
+#ifndef portFORCE_INLINE
+	#define portFORCE_INLINE inline __attribute__(( always_inline))
+#endif
+
+extern BaseType_t xPortIsInsideInterrupt( void );
+
+/* Frees the host stack given to a task when the task is deleted. */
+extern void vPortCleanUpTCB( void *pvTCB );
+#define portCLEAN_UP_TCB( pxTCB )	vPortCleanUpTCB( pxTCB )
+/*-----------------------------------------------------------*/
+
+/* Simulation control, used by the tests.
+
+vPortSimulateTick() - Run the tick interrupt once, advancing the tick count.
+Usually called from the idle hook, so time only passes when no task can run.
+
+vPortSimulateInterrupt() - Run pxHandler as an interrupt.  The handler returns
+pdTRUE if it unblocked a task that should run on exit from the interrupt.
+
+vPortSetRandomPreemption() - When ulOneIn is not zero, each exit from a task
+level critical section is followed, on average once in ulOneIn exits, by a
+context switch to another ready task of the same priority, as if a tick
+interrupt had arrived during the critical section.  Used to stress code that
+assumes nothing about when it can be preempted.
+
+ullPortGetTimeNs() - The host's monotonic clock in nanoseconds, used for
+timing by the benchmarks.
+
+ulPortGetContextSwitchCount() - The number of times a different task has been
+switched in since the scheduler started.
+
+vPortAdvanceHRTimer() - Advance the high resolution timer counter by ulCounts.
+As on the target, the compare interrupt runs each time the counter becomes
+equal to the compare value, so it runs at the exact count it was set for.  Must
+be called from a task.  If the task has interrupts masked then the interrupt
+runs when they are unmasked, as if the task had masked them while the counter
+advanced.
+
+vPortSetHRTimerCountsPerRead() - When ulCounts is not zero, the high resolution
+timer counter also advances by ulCounts each time it is read, as if time passed
+while the kernel ran, so it can pass the compare value while interrupts are
+masked.  The interrupt then runs when they are unmasked.
+
+The high resolution timer functions are only available when configUSE_HR_TIMERS
+is 1. */
+void vPortSimulateTick( void );
+void vPortSimulateInterrupt( BaseType_t ( *pxHandler )( void ) );
+void vPortSetRandomPreemption( uint32_t ulOneIn, uint32_t ulSeed );
+uint64_t ullPortGetTimeNs( void );
+uint32_t ulPortGetContextSwitchCount( void );
+void vPortAdvanceHRTimer( uint32_t ulCounts );
+void vPortSetHRTimerCountsPerRead( uint32_t ulCounts );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
+
@@ -0,0 +1,323 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * Tests that the arena bound to a task is released with the task.
+ *
+ * A task that deletes itself has its arena released by the idle task, a task
+ * that is deleted by another task while it is blocked has its arena released
+ * by vTaskDelete(), and a statically allocated arena bound with
+ * vTaskSetArena() is left for the application to reuse rather than freed.  An
+ * arena the task unbinds before it is deleted survives it.  After each case
+ * the free heap must return to what it was before the task was created.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "arena.h"
+
+#define testALLOCATIONS			( 24 )
+#define testSTATIC_ARENA_SIZE	( ( size_t ) 200 )
+
+typedef enum
+{
+	eSelfDelete,		/* Allocates with pvTaskArenaAlloc(), then deletes itself. */
+	eBlockForever,		/* Allocates from the arena bound to it, then blocks until deleted. */
+	eUnbindArena		/* Allocates from the arena bound to it, unbinds it, then blocks until deleted. */
+} WorkerAction_t;
+
+static TaskHandle_t xControlTask = NULL;
+
+/* What the last worker task saw of its arena. */
+static ArenaHandle_t xWorkerArena = NULL;
+static ArenaStats_t xWorkerStats;
+
+static uint8_t ucStaticArenaStorage[ testSTATIC_ARENA_SIZE ] __attribute__( ( aligned( portBYTE_ALIGNMENT ) ) );
+static StaticArena_t xStaticArena;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize )
+{
+static StaticTask_t xIdleTaskTCB;
+static StackType_t uxIdleTaskStack[ configMINIMAL_STACK_SIZE ];
+
+	*ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+	*ppxIdleTaskStackBuffer = uxIdleTaskStack;
+	*pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize )
+{
+static StaticTask_t xTimerTaskTCB;
+static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
+
+	*ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+	*ppxTimerTaskStackBuffer = uxTimerTaskStack;
+	*pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+static uint32_t ulState = 0x0a7e4a11UL;
+
+	/* xorshift32. */
+	ulState ^= ulState << 13;
+	ulState ^= ulState >> 17;
+	ulState ^= ulState << 5;
+	return ulState;
+}
+/*-----------------------------------------------------------*/
+
+/* Allocates and fills blocks of random sizes, from the task's own arena or,
+if there is none, from one pvTaskArenaAlloc() creates, until testALLOCATIONS
+blocks have been allocated or an allocation fails. */
+static void prvAllocate( void )
+{
+UBaseType_t ux;
+size_t xSize;
+void *pvBlock;
+
+	for( ux = 0; ux < testALLOCATIONS; ux++ )
+	{
+		xSize = 1 + ( prvRand() % 48 );
+		pvBlock = pvTaskArenaAlloc( xSize );
+
+		if( pvBlock == NULL )
+		{
+			break;
+		}
+
+		configASSERT( ( ( ( size_t ) pvBlock ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+		memset( pvBlock, 0xa5, xSize );
+	}
+
+	xWorkerArena = xTaskGetArena( NULL );
+	configASSERT( xWorkerArena );
+	vArenaGetStats( xWorkerArena, &xWorkerStats );
+}
+/*-----------------------------------------------------------*/
+
+static void prvWorkerTask( void *pvParameters )
+{
+WorkerAction_t eAction = ( WorkerAction_t ) ( size_t ) pvParameters;
+
+	prvAllocate();
+
+	if( eAction == eUnbindArena )
+	{
+		vTaskSetArena( NULL, NULL );
+		configASSERT( xTaskGetArena( NULL ) == NULL );
+	}
+
+	xTaskNotifyGive( xControlTask );
+
+	if( eAction == eSelfDelete )
+	{
+		vTaskDelete( NULL );
+	}
+
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* Creates a worker at a lower priority than the control task, binds xArena
+to it if xArena is not NULL, and waits until it has allocated. */
+static TaskHandle_t prvRunWorker( WorkerAction_t eAction, ArenaHandle_t xArena )
+{
+TaskHandle_t xWorker;
+
+	xWorkerArena = NULL;
+	configASSERT( xTaskCreate( prvWorkerTask, "Worker", configMINIMAL_STACK_SIZE, ( void * ) ( size_t ) eAction, tskIDLE_PRIORITY + 1, &xWorker ) == pdPASS );
+
+	if( xArena != NULL )
+	{
+		vTaskSetArena( xWorker, xArena );
+		configASSERT( xTaskGetArena( xWorker ) == xArena );
+	}
+
+	( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	configASSERT( xWorkerStats.ulAllocations > 0 );
+
+	return xWorker;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestSelfDelete( void )
+{
+const size_t xFreeBefore = xPortGetFreeHeapSize();
+
+	/* The task creates its arena on its first allocation, and grows it. */
+	( void ) prvRunWorker( eSelfDelete, NULL );
+	configASSERT( xWorkerStats.ulAllocations == testALLOCATIONS );
+	configASSERT( xWorkerStats.uxChunks > 0 );
+
+	/* The task deletes itself once the control task blocks, so its arena is
+	still held until the idle task has run. */
+	configASSERT( xPortGetFreeHeapSize() < xFreeBefore );
+	vTaskDelay( 2 );
+	configASSERT( xPortGetFreeHeapSize() == xFreeBefore );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestDeletedWhileBlocked( void )
+{
+const size_t xFreeBefore = xPortGetFreeHeapSize();
+ArenaHandle_t xArena;
+TaskHandle_t xWorker;
+
+	/* An arena created by another task and bound to the worker is released by
+	vTaskDelete() itself, as the worker is not running. */
+	xArena = xArenaCreate( 64, 32 );
+	configASSERT( xArena );
+	xWorker = prvRunWorker( eBlockForever, xArena );
+	configASSERT( xWorkerArena == xArena );
+	configASSERT( xWorkerStats.uxChunks > 0 );
+
+	/* Let the worker reach its ulTaskNotifyTake(). */
+	vTaskDelay( 1 );
+	configASSERT( eTaskGetState( xWorker ) == eBlocked );
+
+	vTaskDelete( xWorker );
+	configASSERT( xPortGetFreeHeapSize() == xFreeBefore );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestStaticArena( void )
+{
+const size_t xFreeBefore = xPortGetFreeHeapSize();
+ArenaHandle_t xArena;
+ArenaStats_t xStats;
+TaskHandle_t xWorker;
+UBaseType_t uxRound;
+
+	xArena = xArenaCreateStatic( sizeof( ucStaticArenaStorage ), ucStaticArenaStorage, &xStaticArena );
+	configASSERT( xArena == ( ArenaHandle_t ) &xStaticArena );
+
+	for( uxRound = 0; uxRound < 2; uxRound++ )
+	{
+		/* The statically allocated arena does not grow, so the worker's
+		allocations fail once it is full, and using it takes nothing from the
+		heap. */
+		memset( ucStaticArenaStorage, 0, sizeof( ucStaticArenaStorage ) );
+		xWorker = prvRunWorker( ( uxRound == 0 ) ? eSelfDelete : eBlockForever, xArena );
+		configASSERT( xWorkerArena == xArena );
+		configASSERT( xWorkerStats.uxChunks == 0 );
+		configASSERT( xWorkerStats.ulFailedAllocations == ( uint32_t ) ( uxRound + 1 ) );
+		configASSERT( xWorkerStats.xBytesAllocated <= sizeof( ucStaticArenaStorage ) );
+
+		if( uxRound == 0 )
+		{
+			vTaskDelay( 2 );
+		}
+		else
+		{
+			vTaskDelete( xWorker );
+		}
+
+		/* Deleting the task released its TCB and stack but did not pass the
+		arena to vPortFree(), so the arena is intact and can be bound to the
+		next task once it has been reset. */
+		configASSERT( xPortGetFreeHeapSize() == xFreeBefore );
+		vArenaGetStats( xArena, &xStats );
+		configASSERT( xStats.xBytesAllocated == xWorkerStats.xBytesAllocated );
+		configASSERT( xStats.ulAllocations == xWorkerStats.ulAllocations );
+		configASSERT( ucStaticArenaStorage[ 0 ] == 0xa5 );
+		vArenaReset( xArena );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestUnbind( void )
+{
+const size_t xFreeBefore = xPortGetFreeHeapSize();
+ArenaHandle_t xArena;
+ArenaStats_t xStats;
+TaskHandle_t xWorker;
+
+	/* An arena the task unbinds before it is deleted is not released with the
+	task, and is deleted by the application instead. */
+	xWorker = prvRunWorker( eUnbindArena, NULL );
+	xArena = xWorkerArena;
+	vTaskDelete( xWorker );
+
+	vArenaGetStats( xArena, &xStats );
+	configASSERT( xStats.ulAllocations == testALLOCATIONS );
+	configASSERT( xPortGetFreeHeapSize() < xFreeBefore );
+
+	vArenaDelete( xArena );
+	configASSERT( xPortGetFreeHeapSize() == xFreeBefore );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+const size_t xFreeBefore = xPortGetFreeHeapSize();
+UBaseType_t uxRound;
+
+	for( uxRound = 0; uxRound < 8; uxRound++ )
+	{
+		prvTestSelfDelete();
+		prvTestDeletedWhileBlocked();
+		prvTestStaticArena();
+		prvTestUnbind();
+		printf( "round %u: ok\n", ( unsigned ) uxRound );
+	}
+
+	configASSERT( xPortGetFreeHeapSize() == xFreeBefore );
+
+	printf( "PASS\n" );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, &xControlTask );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
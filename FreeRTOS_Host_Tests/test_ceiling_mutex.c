@@ -0,0 +1,275 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * Tests ceiling mutexes, alone and nested with priority inheritance mutexes.
+ * A low priority task takes the mutexes in turn while a high priority task
+ * blocks on them and a middle priority task becomes ready.  The holder must
+ * run at the ceiling from the moment it takes a ceiling mutex, inherit the
+ * priority of a task that blocks on any mutex it holds, keep its raised
+ * priority until it has given back every mutex, and then return to its base
+ * priority.  A task that times out waiting must leave the holder at the
+ * ceiling, and the middle priority task must not run while the holder is at
+ * the ceiling.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#define testLOW_PRIORITY		( 1 )
+#define testMIDDLE_PRIORITY		( 3 )
+#define testCEILING_PRIORITY	( 4 )
+#define testHIGH_PRIORITY		( 5 )
+#define testHIGH_BLOCK_TIME		( ( TickType_t ) 5 )
+
+/* Commands given to the high priority task by notification value. */
+#define testTAKE_INHERITANCE	( 1 )
+#define testTAKE_CEILING		( 2 )
+
+static SemaphoreHandle_t xCeiling, xInheritance, xRecursiveCeiling;
+static TaskHandle_t xControl, xLow, xMiddle, xHigh;
+
+/* Set by the high and middle priority tasks when they have run. */
+static volatile BaseType_t xHighDone = pdFALSE, xMiddleRan = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static void prvHighTask( void *pvParameters )
+{
+uint32_t ulCommand;
+
+	for( ;; )
+	{
+		( void ) xTaskNotifyWait( 0, 0xffffffffUL, &ulCommand, portMAX_DELAY );
+
+		if( ulCommand == testTAKE_INHERITANCE )
+		{
+			configASSERT( xSemaphoreTake( xInheritance, portMAX_DELAY ) == pdPASS );
+			configASSERT( uxTaskPriorityGet( NULL ) == testHIGH_PRIORITY );
+			configASSERT( xSemaphoreGive( xInheritance ) == pdPASS );
+		}
+		else
+		{
+			/* The high priority task is above the ceiling, so must never
+			get the ceiling mutex. */
+			configASSERT( xSemaphoreTake( xCeiling, testHIGH_BLOCK_TIME ) == pdFAIL );
+		}
+
+		xHighDone = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvMiddleTask( void *pvParameters )
+{
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		xMiddleRan = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* Makes the high priority task block on a mutex the calling task holds. */
+static void prvHighBlocks( uint32_t ulCommand )
+{
+	xHighDone = pdFALSE;
+	( void ) xTaskNotify( xHigh, ulCommand, eSetValueWithOverwrite );
+	configASSERT( xHighDone == pdFALSE );
+	configASSERT( eTaskGetState( xHigh ) == eBlocked );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestCeilingThenInheritance( void )
+{
+	configASSERT( xSemaphoreTake( xCeiling, 0 ) == pdPASS );
+	configASSERT( uxTaskPriorityGet( NULL ) == testCEILING_PRIORITY );
+	configASSERT( xSemaphoreTake( xInheritance, 0 ) == pdPASS );
+	configASSERT( uxTaskPriorityGet( NULL ) == testCEILING_PRIORITY );
+
+	prvHighBlocks( testTAKE_INHERITANCE );
+	configASSERT( uxTaskPriorityGet( NULL ) == testHIGH_PRIORITY );
+
+	/* The ceiling mutex is still held, so the raised priority is kept. */
+	configASSERT( xSemaphoreGive( xInheritance ) == pdPASS );
+	configASSERT( uxTaskPriorityGet( NULL ) == testHIGH_PRIORITY );
+	configASSERT( xHighDone == pdFALSE );
+
+	configASSERT( xSemaphoreGive( xCeiling ) == pdPASS );
+	configASSERT( uxTaskPriorityGet( NULL ) == testLOW_PRIORITY );
+	configASSERT( xHighDone != pdFALSE );
+
+	printf( "ceiling then inheritance: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestInheritanceThenCeiling( void )
+{
+	configASSERT( xSemaphoreTake( xInheritance, 0 ) == pdPASS );
+	prvHighBlocks( testTAKE_INHERITANCE );
+	configASSERT( uxTaskPriorityGet( NULL ) == testHIGH_PRIORITY );
+
+	/* Already above the ceiling, so taking the ceiling mutex does not lower
+	the priority, and nor does giving it back. */
+	configASSERT( xSemaphoreTake( xCeiling, 0 ) == pdPASS );
+	configASSERT( uxTaskPriorityGet( NULL ) == testHIGH_PRIORITY );
+	configASSERT( xSemaphoreGive( xCeiling ) == pdPASS );
+	configASSERT( uxTaskPriorityGet( NULL ) == testHIGH_PRIORITY );
+
+	configASSERT( xSemaphoreGive( xInheritance ) == pdPASS );
+	configASSERT( uxTaskPriorityGet( NULL ) == testLOW_PRIORITY );
+	configASSERT( xHighDone != pdFALSE );
+
+	printf( "inheritance then ceiling: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestTimeoutOnCeiling( void )
+{
+	configASSERT( xSemaphoreTake( xCeiling, 0 ) == pdPASS );
+	prvHighBlocks( testTAKE_CEILING );
+	configASSERT( uxTaskPriorityGet( NULL ) == testHIGH_PRIORITY );
+
+	/* When the high priority task times out the holder drops back to the
+	ceiling, not to its base priority. */
+	vTaskDelay( testHIGH_BLOCK_TIME * 2 );
+	configASSERT( xHighDone != pdFALSE );
+	configASSERT( uxTaskPriorityGet( NULL ) == testCEILING_PRIORITY );
+
+	configASSERT( xSemaphoreGive( xCeiling ) == pdPASS );
+	configASSERT( uxTaskPriorityGet( NULL ) == testLOW_PRIORITY );
+
+	printf( "timeout on ceiling: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestRecursiveCeiling( void )
+{
+	configASSERT( xSemaphoreTakeRecursive( xRecursiveCeiling, 0 ) == pdPASS );
+	configASSERT( xSemaphoreTakeRecursive( xRecursiveCeiling, 0 ) == pdPASS );
+	configASSERT( uxTaskPriorityGet( NULL ) == testCEILING_PRIORITY );
+	configASSERT( xSemaphoreGiveRecursive( xRecursiveCeiling ) == pdPASS );
+	configASSERT( uxTaskPriorityGet( NULL ) == testCEILING_PRIORITY );
+	configASSERT( xSemaphoreGiveRecursive( xRecursiveCeiling ) == pdPASS );
+	configASSERT( uxTaskPriorityGet( NULL ) == testLOW_PRIORITY );
+
+	printf( "recursive ceiling: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestPrioritySetWhileHeld( void )
+{
+	configASSERT( xSemaphoreTake( xCeiling, 0 ) == pdPASS );
+
+	/* Changing the base priority of the holder below the ceiling leaves it at
+	the ceiling, and it returns to the new base priority. */
+	vTaskPrioritySet( NULL, testLOW_PRIORITY + 1 );
+	configASSERT( uxTaskPriorityGet( NULL ) == testCEILING_PRIORITY );
+	configASSERT( xSemaphoreGive( xCeiling ) == pdPASS );
+	configASSERT( uxTaskPriorityGet( NULL ) == testLOW_PRIORITY + 1 );
+
+	vTaskPrioritySet( NULL, testLOW_PRIORITY );
+
+	printf( "priority set while held: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestNoPreemptionAtCeiling( void )
+{
+uint32_t ulSwitches;
+
+	configASSERT( xSemaphoreTake( xCeiling, 0 ) == pdPASS );
+
+	/* The middle priority task is above the holder's base priority but below
+	the ceiling, so does not run until the mutex is given back. */
+	xMiddleRan = pdFALSE;
+	ulSwitches = ulPortGetContextSwitchCount();
+	xTaskNotifyGive( xMiddle );
+	configASSERT( xMiddleRan == pdFALSE );
+	configASSERT( ulPortGetContextSwitchCount() == ulSwitches );
+
+	configASSERT( xSemaphoreGive( xCeiling ) == pdPASS );
+	configASSERT( xMiddleRan != pdFALSE );
+
+	printf( "no preemption at the ceiling: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvLowTask( void *pvParameters )
+{
+	prvTestCeilingThenInheritance();
+	prvTestInheritanceThenCeiling();
+	prvTestTimeoutOnCeiling();
+	prvTestRecursiveCeiling();
+	prvTestPrioritySetWhileHeld();
+	prvTestNoPreemptionAtCeiling();
+
+	xTaskNotifyGive( xControl );
+	vTaskSuspend( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+	xCeiling = xSemaphoreCreateCeilingMutex( testCEILING_PRIORITY );
+	xRecursiveCeiling = xSemaphoreCreateRecursiveCeilingMutex( testCEILING_PRIORITY );
+	xInheritance = xSemaphoreCreateMutex();
+	configASSERT( xCeiling && xRecursiveCeiling && xInheritance );
+
+	xTaskCreate( prvHighTask, "High", configMINIMAL_STACK_SIZE, NULL, testHIGH_PRIORITY, &xHigh );
+	xTaskCreate( prvMiddleTask, "Middle", configMINIMAL_STACK_SIZE, NULL, testMIDDLE_PRIORITY, &xMiddle );
+	xTaskCreate( prvLowTask, "Low", configMINIMAL_STACK_SIZE, NULL, testLOW_PRIORITY, &xLow );
+	configASSERT( xHigh && xMiddle && xLow );
+
+	( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+	printf( "PASS\n" );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, &xControl );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
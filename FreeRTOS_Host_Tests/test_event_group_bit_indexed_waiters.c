@@ -0,0 +1,223 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Tests event groups with configUSE_EVENT_GROUP_BIT_INDEXED_WAITERS set to 1,
+ * where each blocked task is held in the list of one of the bits it waits for.
+ * Each kind of wait must still be met, and only met, when its bits are set.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "event_groups.h"
+
+#define testWAITERS			( 3 )
+
+#define testBIT( x )		( ( EventBits_t ) 1 << ( x ) )
+
+/* The wait a waiter task performs each time it is notified. */
+typedef struct
+{
+	EventGroupHandle_t xEventGroup;
+	EventBits_t uxBitsToWaitFor;
+	EventBits_t uxBitsToSet;		/* Non-zero to call xEventGroupSync(). */
+	BaseType_t xClearOnExit;
+	BaseType_t xWaitForAllBits;
+	TickType_t xTicksToWait;
+	volatile EventBits_t uxResult;
+	volatile uint32_t ulReturns;
+	TaskHandle_t xTask;
+} Waiter_t;
+
+static Waiter_t xWaiters[ testWAITERS ];
+static EventGroupHandle_t xEventGroup;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaiterTask( void *pvParameters )
+{
+Waiter_t *pxWaiter = ( Waiter_t * ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+		if( pxWaiter->uxBitsToSet != ( EventBits_t ) 0 )
+		{
+			pxWaiter->uxResult = xEventGroupSync( pxWaiter->xEventGroup, pxWaiter->uxBitsToSet, pxWaiter->uxBitsToWaitFor, pxWaiter->xTicksToWait );
+		}
+		else
+		{
+			pxWaiter->uxResult = xEventGroupWaitBits( pxWaiter->xEventGroup, pxWaiter->uxBitsToWaitFor, pxWaiter->xClearOnExit, pxWaiter->xWaitForAllBits, pxWaiter->xTicksToWait );
+		}
+
+		pxWaiter->ulReturns++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* Start waiter uxWaiter waiting, and let it block. */
+static void prvWait( UBaseType_t uxWaiter, EventBits_t uxBitsToWaitFor, BaseType_t xClearOnExit, BaseType_t xWaitForAllBits, TickType_t xTicksToWait )
+{
+Waiter_t *pxWaiter = &( xWaiters[ uxWaiter ] );
+
+	pxWaiter->xEventGroup = xEventGroup;
+	pxWaiter->uxBitsToWaitFor = uxBitsToWaitFor;
+	pxWaiter->uxBitsToSet = 0;
+	pxWaiter->xClearOnExit = xClearOnExit;
+	pxWaiter->xWaitForAllBits = xWaitForAllBits;
+	pxWaiter->xTicksToWait = xTicksToWait;
+	xTaskNotifyGive( pxWaiter->xTask );
+	vTaskDelay( 1 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSync( UBaseType_t uxWaiter, EventBits_t uxBitsToSet, EventBits_t uxBitsToWaitFor )
+{
+Waiter_t *pxWaiter = &( xWaiters[ uxWaiter ] );
+
+	pxWaiter->xEventGroup = xEventGroup;
+	pxWaiter->uxBitsToWaitFor = uxBitsToWaitFor;
+	pxWaiter->uxBitsToSet = uxBitsToSet;
+	pxWaiter->xTicksToWait = portMAX_DELAY;
+	xTaskNotifyGive( pxWaiter->xTask );
+	vTaskDelay( 1 );
+}
+/*-----------------------------------------------------------*/
+
+/* Set uxBits, let any unblocked waiter run, then check which waiters have
+returned since they were last started. */
+static void prvSetAndCheck( EventBits_t uxBits, uint32_t ulReturns0, uint32_t ulReturns1, uint32_t ulReturns2 )
+{
+	( void ) xEventGroupSetBits( xEventGroup, uxBits );
+	vTaskDelay( 1 );
+	configASSERT( xWaiters[ 0 ].ulReturns == ulReturns0 );
+	configASSERT( xWaiters[ 1 ].ulReturns == ulReturns1 );
+	configASSERT( xWaiters[ 2 ].ulReturns == ulReturns2 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+	/* Single bits.  Setting one bit only unblocks the task waiting for it. */
+	prvWait( 0, testBIT( 0 ), pdTRUE, pdFALSE, portMAX_DELAY );
+	prvWait( 1, testBIT( 1 ), pdFALSE, pdFALSE, portMAX_DELAY );
+	prvSetAndCheck( testBIT( 1 ), 0, 1, 0 );
+	configASSERT( xWaiters[ 1 ].uxResult == testBIT( 1 ) );
+	prvSetAndCheck( testBIT( 0 ), 1, 1, 0 );
+	configASSERT( xWaiters[ 0 ].uxResult == ( testBIT( 0 ) | testBIT( 1 ) ) );
+	configASSERT( xEventGroupGetBits( xEventGroup ) == testBIT( 1 ) );
+	printf( "single bit: ok\n" );
+
+	/* All of several bits.  The task is moved to the list of another bit each
+	time the bit it is indexed by is set, whatever order they are set in. */
+	( void ) xEventGroupClearBits( xEventGroup, testBIT( 1 ) );
+	prvWait( 2, testBIT( 2 ) | testBIT( 3 ) | testBIT( 4 ), pdTRUE, pdTRUE, portMAX_DELAY );
+	prvSetAndCheck( testBIT( 2 ), 1, 1, 0 );
+	prvSetAndCheck( testBIT( 4 ), 1, 1, 0 );
+	prvSetAndCheck( testBIT( 5 ), 1, 1, 0 );
+	prvSetAndCheck( testBIT( 3 ), 1, 1, 1 );
+	configASSERT( xWaiters[ 2 ].uxResult == ( testBIT( 2 ) | testBIT( 3 ) | testBIT( 4 ) | testBIT( 5 ) ) );
+	configASSERT( xEventGroupGetBits( xEventGroup ) == testBIT( 5 ) );
+	printf( "all bits: ok\n" );
+
+	/* Any of several bits, alongside a task waiting for one of the same
+	bits, both clearing on exit. */
+	( void ) xEventGroupClearBits( xEventGroup, testBIT( 5 ) );
+	prvWait( 0, testBIT( 6 ) | testBIT( 7 ), pdTRUE, pdFALSE, portMAX_DELAY );
+	prvWait( 1, testBIT( 7 ), pdTRUE, pdFALSE, portMAX_DELAY );
+	prvSetAndCheck( testBIT( 7 ), 2, 2, 1 );
+	configASSERT( xWaiters[ 0 ].uxResult == testBIT( 7 ) );
+	configASSERT( xWaiters[ 1 ].uxResult == testBIT( 7 ) );
+	configASSERT( xEventGroupGetBits( xEventGroup ) == 0 );
+	printf( "any bit: ok\n" );
+
+	/* A task that times out leaves the list it was indexed by. */
+	prvWait( 0, testBIT( 8 ) | testBIT( 9 ), pdFALSE, pdTRUE, 3 );
+	prvSetAndCheck( testBIT( 8 ), 2, 2, 1 );
+	vTaskDelay( 3 );
+	configASSERT( xWaiters[ 0 ].ulReturns == 3 );
+	configASSERT( xWaiters[ 0 ].uxResult == testBIT( 8 ) );
+	prvSetAndCheck( testBIT( 9 ), 3, 2, 1 );
+	( void ) xEventGroupClearBits( xEventGroup, testBIT( 8 ) | testBIT( 9 ) );
+	printf( "timeout: ok\n" );
+
+	/* A rendezvous of three tasks. */
+	prvSync( 0, testBIT( 10 ), testBIT( 10 ) | testBIT( 11 ) | testBIT( 12 ) );
+	prvSync( 1, testBIT( 11 ), testBIT( 10 ) | testBIT( 11 ) | testBIT( 12 ) );
+	configASSERT( ( xWaiters[ 0 ].ulReturns == 3 ) && ( xWaiters[ 1 ].ulReturns == 2 ) );
+	prvSync( 2, testBIT( 12 ), testBIT( 10 ) | testBIT( 11 ) | testBIT( 12 ) );
+	configASSERT( ( xWaiters[ 0 ].ulReturns == 4 ) && ( xWaiters[ 1 ].ulReturns == 3 ) && ( xWaiters[ 2 ].ulReturns == 2 ) );
+	configASSERT( xWaiters[ 0 ].uxResult == ( testBIT( 10 ) | testBIT( 11 ) | testBIT( 12 ) ) );
+	configASSERT( xEventGroupGetBits( xEventGroup ) == 0 );
+	printf( "sync: ok\n" );
+
+	/* Deleting the event group unblocks the tasks in every list. */
+	prvWait( 0, testBIT( 13 ), pdFALSE, pdFALSE, portMAX_DELAY );
+	prvWait( 1, testBIT( 14 ) | testBIT( 15 ), pdFALSE, pdTRUE, portMAX_DELAY );
+	prvWait( 2, testBIT( 16 ) | testBIT( 17 ), pdFALSE, pdFALSE, portMAX_DELAY );
+	vEventGroupDelete( xEventGroup );
+	vTaskDelay( 1 );
+	configASSERT( ( xWaiters[ 0 ].ulReturns == 5 ) && ( xWaiters[ 1 ].ulReturns == 4 ) && ( xWaiters[ 2 ].ulReturns == 3 ) );
+	configASSERT( ( xWaiters[ 0 ].uxResult == 0 ) && ( xWaiters[ 1 ].uxResult == 0 ) && ( xWaiters[ 2 ].uxResult == 0 ) );
+	printf( "delete: ok\n" );
+
+	printf( "PASS\n" );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+UBaseType_t ux;
+
+	xEventGroup = xEventGroupCreate();
+	configASSERT( xEventGroup );
+
+	for( ux = 0; ux < testWAITERS; ux++ )
+	{
+		xTaskCreate( prvWaiterTask, "Waiter", configMINIMAL_STACK_SIZE, &( xWaiters[ ux ] ), 1, &( xWaiters[ ux ].xTask ) );
+		configASSERT( xWaiters[ ux ].xTask );
+	}
+
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,224 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Tests xEventGroupSetBitsFromISR() with configUSE_DIRECT_EVENT_GROUP_SET_FROM_ISR
+ * set to 1.  The bits must only be set within the interrupt when that means
+ * visiting no more than configEVENT_GROUP_SET_BITS_FROM_ISR_BUDGET waiting
+ * tasks, the scheduler is not suspended, and no earlier call is still waiting
+ * for the timer task.  Otherwise they are set by the timer task, in order.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "event_groups.h"
+
+#define testWAITERS			( configEVENT_GROUP_SET_BITS_FROM_ISR_BUDGET + 1 )
+
+#define testBIT_0			( ( EventBits_t ) 0x01 )
+#define testBIT_1			( ( EventBits_t ) 0x02 )
+#define testBIT_2			( ( EventBits_t ) 0x04 )
+
+static EventGroupHandle_t xEventGroup;
+static TaskHandle_t xWaiters[ testWAITERS ];
+static volatile uint32_t ulWakes[ testWAITERS ];
+static EventBits_t uxBitsToSetFromISR;
+static BaseType_t xSetFromISRResult;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaiterTask( void *pvParameters )
+{
+const UBaseType_t uxWaiter = ( UBaseType_t ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) xEventGroupWaitBits( xEventGroup, testBIT_0, pdFALSE, pdTRUE, portMAX_DELAY );
+		ulWakes[ uxWaiter ]++;
+		vTaskSuspend( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvPendedFunction( void *pvParameter1, uint32_t ulParameter2 )
+{
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSetBitsFromISR( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	xSetFromISRResult = xEventGroupSetBitsFromISR( xEventGroup, uxBitsToSetFromISR, &xHigherPriorityTaskWoken );
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetBits( EventBits_t uxBitsToSet, BaseType_t xExpectedResult )
+{
+	uxBitsToSetFromISR = uxBitsToSet;
+	vPortSimulateInterrupt( prvSetBitsFromISR );
+	configASSERT( xSetFromISRResult == xExpectedResult );
+}
+/*-----------------------------------------------------------*/
+
+/* Resume the first uxWaiters waiters and let them block on the event group. */
+static void prvStartWaiting( UBaseType_t uxWaiters )
+{
+UBaseType_t ux;
+
+	( void ) xEventGroupClearBits( xEventGroup, testBIT_0 | testBIT_1 | testBIT_2 );
+
+	for( ux = 0; ux < uxWaiters; ux++ )
+	{
+		vTaskResume( xWaiters[ ux ] );
+	}
+
+	vTaskDelay( 1 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckWakes( uint32_t ulExpected, UBaseType_t uxWaiters )
+{
+UBaseType_t ux;
+
+	for( ux = 0; ux < uxWaiters; ux++ )
+	{
+		configASSERT( ulWakes[ ux ] == ulExpected );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+UBaseType_t ux;
+
+	/* The waiters start suspended, so start them all. */
+	prvStartWaiting( testWAITERS );
+
+	/* More tasks are waiting than the budget allows the interrupt to visit, so
+	nothing changes until the timer task runs. */
+	prvSetBits( testBIT_0, pdPASS );
+	configASSERT( xEventGroupGetBits( xEventGroup ) == 0 );
+	vTaskDelay( 1 );
+	configASSERT( xEventGroupGetBits( xEventGroup ) == testBIT_0 );
+	prvCheckWakes( 1, testWAITERS );
+	printf( "more waiters than the budget: ok\n" );
+
+	/* Within the budget the bits are set, and the waiters unblocked, within
+	the interrupt - even with the timer task unable to run. */
+	prvStartWaiting( configEVENT_GROUP_SET_BITS_FROM_ISR_BUDGET );
+	vTaskSuspend( xTimerGetTimerDaemonTaskHandle() );
+	prvSetBits( testBIT_0, pdPASS );
+	configASSERT( xEventGroupGetBits( xEventGroup ) == testBIT_0 );
+	vTaskDelay( 1 );
+	prvCheckWakes( 2, configEVENT_GROUP_SET_BITS_FROM_ISR_BUDGET );
+	configASSERT( ulWakes[ testWAITERS - 1 ] == 1 );
+	vTaskResume( xTimerGetTimerDaemonTaskHandle() );
+	printf( "waiters within the budget: ok\n" );
+
+	/* The interrupt cannot access the event group while the scheduler is
+	suspended, as a task might be part way through doing so. */
+	prvStartWaiting( configEVENT_GROUP_SET_BITS_FROM_ISR_BUDGET );
+	vTaskSuspendAll();
+	{
+		prvSetBits( testBIT_0, pdPASS );
+		configASSERT( xEventGroupGetBits( xEventGroup ) == 0 );
+	}
+	( void ) xTaskResumeAll();
+	vTaskDelay( 1 );
+	configASSERT( xEventGroupGetBits( xEventGroup ) == testBIT_0 );
+	prvCheckWakes( 3, configEVENT_GROUP_SET_BITS_FROM_ISR_BUDGET );
+	printf( "scheduler suspended: ok\n" );
+
+	/* Bits that could be set directly are still left to the timer task while
+	bits set by an earlier call are, so they are set in order. */
+	prvStartWaiting( testWAITERS );
+	prvSetBits( testBIT_0, pdPASS );
+	prvSetBits( testBIT_1, pdPASS );
+	configASSERT( xEventGroupGetBits( xEventGroup ) == 0 );
+	vTaskDelay( 1 );
+	configASSERT( xEventGroupGetBits( xEventGroup ) == ( testBIT_0 | testBIT_1 ) );
+	prvSetBits( testBIT_2, pdPASS );
+	configASSERT( xEventGroupGetBits( xEventGroup ) == ( testBIT_0 | testBIT_1 | testBIT_2 ) );
+	printf( "order kept: ok\n" );
+
+	/* The call fails, and changes nothing, if the timer command queue is full
+	when the bits have to be left to the timer task. */
+	prvStartWaiting( testWAITERS );
+
+	for( ux = 0; ux < configTIMER_QUEUE_LENGTH; ux++ )
+	{
+		configASSERT( xTimerPendFunctionCall( prvPendedFunction, NULL, 0, 0 ) == pdPASS );
+	}
+
+	prvSetBits( testBIT_0, pdFAIL );
+	vTaskDelay( 1 );
+	configASSERT( xEventGroupGetBits( xEventGroup ) == 0 );
+	prvSetBits( testBIT_0, pdPASS );
+	vTaskDelay( 1 );
+	prvCheckWakes( 5, configEVENT_GROUP_SET_BITS_FROM_ISR_BUDGET );
+	configASSERT( ulWakes[ testWAITERS - 1 ] == 3 );
+	printf( "timer command queue full: ok\n" );
+
+	printf( "PASS\n" );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+UBaseType_t ux;
+
+	xEventGroup = xEventGroupCreate();
+	configASSERT( xEventGroup );
+
+	for( ux = 0; ux < testWAITERS; ux++ )
+	{
+		xTaskCreate( prvWaiterTask, "Waiter", configMINIMAL_STACK_SIZE, ( void * ) ux, 1, &( xWaiters[ ux ] ) );
+		configASSERT( xWaiters[ ux ] );
+		vTaskSuspend( xWaiters[ ux ] );
+	}
+
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,284 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Tests vPortGetHeapStats() for heap_4.c.  Free blocks of known sizes are made
+ * and the count, size classes, smallest block and totals are checked against
+ * them.  Then another task of the same priority repeatedly frees, and later
+ * reallocates, every other block of a run while the statistics are gathered
+ * with random preemption.  The walk of the free blocks is split into parts,
+ * so each snapshot must still describe the heap either before or after a
+ * change, never a mix of the two.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Blocks of testSMALL_SIZE bytes become 48 byte blocks, in size class 1, and
+blocks of testLARGE_SIZE bytes become 80 byte blocks, in size class 2. */
+#define testSMALL_SIZE			( ( size_t ) 32 )
+#define testLARGE_SIZE			( ( size_t ) 64 )
+#define testSMALL_CLASS			( 1 )
+#define testLARGE_CLASS			( 2 )
+
+/* The number of blocks of each kind freed.  Enough that the walk of the free
+blocks is split into several parts. */
+#define testHOLES				( 40 )
+#define testBLOCKS				( testHOLES * 4 )
+#define testSNAPSHOTS			( 3000 )
+
+static void *pvBlocks[ testBLOCKS ];
+static volatile BaseType_t xDone = pdFALSE;
+static volatile BaseType_t xLargeHolesFree = pdFALSE;
+static uint32_t ulToggles = 0;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckConsistent( const HeapStats_t *pxStats )
+{
+UBaseType_t uxClass;
+size_t xTotal = 0;
+
+	for( uxClass = 0; uxClass < portHEAP_STATS_SIZE_CLASSES; uxClass++ )
+	{
+		xTotal += pxStats->xFreeBlocksBySize[ uxClass ];
+	}
+
+	configASSERT( xTotal == pxStats->xNumberOfFreeBlocks );
+	configASSERT( pxStats->xSizeOfSmallestFreeBlockInBytes <= pxStats->xSizeOfLargestFreeBlockInBytes );
+	configASSERT( pxStats->xMinimumEverFreeBytesRemaining <= pxStats->xAvailableHeapSpaceInBytes );
+}
+/*-----------------------------------------------------------*/
+
+static void prvAllocateBlocks( void )
+{
+UBaseType_t ux;
+
+	/* Every fourth block, starting at 0, is small, and every fourth block,
+	starting at 2, is large.  The odd blocks are small and stay allocated, so
+	no two of the freed blocks are ever adjacent. */
+	for( ux = 0; ux < testBLOCKS; ux++ )
+	{
+		pvBlocks[ ux ] = pvPortMalloc( ( ( ux % 4 ) == 2 ) ? testLARGE_SIZE : testSMALL_SIZE );
+		configASSERT( pvBlocks[ ux ] );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvFreeBlocks( UBaseType_t uxFirst, UBaseType_t uxStep )
+{
+UBaseType_t ux;
+
+	for( ux = uxFirst; ux < testBLOCKS; ux += uxStep )
+	{
+		vPortFree( pvBlocks[ ux ] );
+		pvBlocks[ ux ] = NULL;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestKnownBlocks( void )
+{
+HeapStats_t xBefore, xStats;
+UBaseType_t uxClass;
+
+	vPortGetHeapStats( &xBefore );
+	prvCheckConsistent( &xBefore );
+	configASSERT( xBefore.xAvailableHeapSpaceInBytes == xPortGetFreeHeapSize() );
+	configASSERT( xBefore.xMinimumEverFreeBytesRemaining == xPortGetMinimumEverFreeHeapSize() );
+
+	/* The blocks are taken from the end of the one large free block, which
+	stays in the last size class. */
+	prvAllocateBlocks();
+	vPortGetHeapStats( &xStats );
+	prvCheckConsistent( &xStats );
+	configASSERT( xStats.xNumberOfFreeBlocks == xBefore.xNumberOfFreeBlocks );
+	configASSERT( xStats.xNumberOfSuccessfulAllocations == xBefore.xNumberOfSuccessfulAllocations + testBLOCKS );
+	configASSERT( xStats.xAvailableHeapSpaceInBytes == xBefore.xAvailableHeapSpaceInBytes - ( testBLOCKS / 4 ) * ( 3 * 48 + 80 ) );
+	configASSERT( xStats.xAvailableHeapSpaceInBytes == xPortGetFreeHeapSize() );
+
+	/* Free the small blocks that are not adjacent to each other. */
+	prvFreeBlocks( 0, 4 );
+	vPortGetHeapStats( &xStats );
+	prvCheckConsistent( &xStats );
+	configASSERT( xStats.xNumberOfFreeBlocks == xBefore.xNumberOfFreeBlocks + testHOLES );
+	configASSERT( xStats.xNumberOfSuccessfulFrees == xBefore.xNumberOfSuccessfulFrees + testHOLES );
+	configASSERT( xStats.xSizeOfSmallestFreeBlockInBytes == 48 );
+	configASSERT( xStats.xSizeOfLargestFreeBlockInBytes == xBefore.xSizeOfLargestFreeBlockInBytes - ( testBLOCKS / 4 ) * ( 3 * 48 + 80 ) );
+
+	for( uxClass = 0; uxClass < portHEAP_STATS_SIZE_CLASSES; uxClass++ )
+	{
+		configASSERT( xStats.xFreeBlocksBySize[ uxClass ] == xBefore.xFreeBlocksBySize[ uxClass ] + ( ( uxClass == testSMALL_CLASS ) ? testHOLES : 0 ) );
+	}
+
+	/* Then the large ones. */
+	prvFreeBlocks( 2, 4 );
+	vPortGetHeapStats( &xStats );
+	prvCheckConsistent( &xStats );
+	configASSERT( xStats.xNumberOfFreeBlocks == xBefore.xNumberOfFreeBlocks + ( 2 * testHOLES ) );
+	configASSERT( xStats.xFreeBlocksBySize[ testSMALL_CLASS ] == xBefore.xFreeBlocksBySize[ testSMALL_CLASS ] + testHOLES );
+	configASSERT( xStats.xFreeBlocksBySize[ testLARGE_CLASS ] == xBefore.xFreeBlocksBySize[ testLARGE_CLASS ] + testHOLES );
+	configASSERT( xStats.xAvailableHeapSpaceInBytes == xPortGetFreeHeapSize() );
+
+	/* The rest, after which the free space is as it was.  With
+	configHEAP_USE_CRITICAL_SECTIONS the freed blocks are held in the small
+	block lists rather than being merged, so each is still counted as a free
+	block of its own. */
+	prvFreeBlocks( 1, 2 );
+	vPortGetHeapStats( &xStats );
+	prvCheckConsistent( &xStats );
+	configASSERT( xStats.xAvailableHeapSpaceInBytes == xBefore.xAvailableHeapSpaceInBytes );
+	configASSERT( xStats.xNumberOfSuccessfulFrees == xBefore.xNumberOfSuccessfulFrees + testBLOCKS );
+
+	#if( configHEAP_USE_CRITICAL_SECTIONS == 0 )
+	{
+		configASSERT( xStats.xNumberOfFreeBlocks == xBefore.xNumberOfFreeBlocks );
+		configASSERT( xStats.xSizeOfLargestFreeBlockInBytes == xBefore.xSizeOfLargestFreeBlockInBytes );
+	}
+	#else
+	{
+		configASSERT( xStats.xNumberOfFreeBlocks == xBefore.xNumberOfFreeBlocks + testBLOCKS );
+	}
+	#endif
+
+	printf( "known free blocks: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvToggleTask( void *pvParameters )
+{
+UBaseType_t ux;
+
+	/* Free all the large blocks, or allocate them all again, with the
+	scheduler suspended, so the statistics can only be gathered before or
+	after each change.  The small blocks between them are smaller than a
+	large block, so each allocation reuses the lowest of the freed large
+	blocks. */
+	while( xDone == pdFALSE )
+	{
+		vTaskSuspendAll();
+		{
+			if( xLargeHolesFree == pdFALSE )
+			{
+				prvFreeBlocks( 2, 4 );
+				xLargeHolesFree = pdTRUE;
+			}
+			else
+			{
+				for( ux = 2; ux < testBLOCKS; ux += 4 )
+				{
+					pvBlocks[ ux ] = pvPortMalloc( testLARGE_SIZE );
+					configASSERT( pvBlocks[ ux ] );
+				}
+
+				xLargeHolesFree = pdFALSE;
+			}
+
+			ulToggles++;
+		}
+		( void ) xTaskResumeAll();
+
+		taskYIELD();
+	}
+
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestSnapshots( void )
+{
+HeapStats_t xBase, xStats;
+UBaseType_t ux;
+uint32_t ulBefore = 0, ulAfter = 0;
+
+	prvAllocateBlocks();
+	prvFreeBlocks( 0, 4 );
+	vPortGetHeapStats( &xBase );
+
+	xTaskCreate( prvToggleTask, "Toggle", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+	vPortSetRandomPreemption( 3, 0x4ea95747UL );
+
+	for( ux = 0; ux < testSNAPSHOTS; ux++ )
+	{
+		vPortGetHeapStats( &xStats );
+		prvCheckConsistent( &xStats );
+
+		if( xStats.xNumberOfFreeBlocks == xBase.xNumberOfFreeBlocks )
+		{
+			configASSERT( xStats.xFreeBlocksBySize[ testLARGE_CLASS ] == xBase.xFreeBlocksBySize[ testLARGE_CLASS ] );
+			ulBefore++;
+		}
+		else
+		{
+			/* Any other count is a walk that saw some of the large blocks
+			free and some allocated. */
+			configASSERT( xStats.xNumberOfFreeBlocks == xBase.xNumberOfFreeBlocks + testHOLES );
+			configASSERT( xStats.xFreeBlocksBySize[ testLARGE_CLASS ] == xBase.xFreeBlocksBySize[ testLARGE_CLASS ] + testHOLES );
+			ulAfter++;
+		}
+
+		taskYIELD();
+	}
+
+	vPortSetRandomPreemption( 0, 0 );
+	xDone = pdTRUE;
+	vTaskDelay( 1 );
+
+	configASSERT( ( ulBefore > 0 ) && ( ulAfter > 0 ) );
+	printf( "snapshots: %u before, %u after, %u changes: ok\n", ( unsigned ) ulBefore, ( unsigned ) ulAfter, ( unsigned ) ulToggles );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+	prvTestKnownBlocks();
+	prvTestSnapshots();
+
+	printf( "PASS\n" );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
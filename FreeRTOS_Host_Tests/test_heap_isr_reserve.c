@@ -0,0 +1,186 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Tests the blocks heap_4.c reserves for interrupts when
+ * configHEAP_USE_CRITICAL_SECTIONS is 1.
+ *
+ * Once xPortReserveSmallBlocks() has succeeded, interrupts must be able to
+ * allocate the reserved number of blocks however much of the heap tasks have
+ * allocated, including after pvPortMalloc() has failed, and again after the
+ * interrupts have freed the blocks they allocated.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define testRESERVED_SIZE		( ( size_t ) 24 )
+#define testRESERVED_COUNT		( ( UBaseType_t ) 4 )
+#define testMAX_TASK_BLOCKS		( 4096 )
+
+static void *pvTaskBlocks[ testMAX_TASK_BLOCKS ];
+static UBaseType_t uxTaskBlocks = 0;
+static void *pvISRBlocks[ testRESERVED_COUNT ];
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvAllocateFromISR( void )
+{
+UBaseType_t ux;
+
+	for( ux = 0; ux < testRESERVED_COUNT; ux++ )
+	{
+		pvISRBlocks[ ux ] = pvPortMallocFromISR( testRESERVED_SIZE );
+	}
+
+	return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvFreeFromISR( void )
+{
+UBaseType_t ux;
+
+	for( ux = 0; ux < testRESERVED_COUNT; ux++ )
+	{
+		vPortFreeFromISR( pvISRBlocks[ ux ] );
+		pvISRBlocks[ ux ] = NULL;
+	}
+
+	return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+/* Allocate from a task until the heap is exhausted, using the reserved size
+last, so every way a task could take a block has been tried. */
+static void prvExhaustHeap( void )
+{
+static const size_t xSizes[] = { 200, 64, 40, testRESERVED_SIZE, 8 };
+size_t xSize;
+void *pvBlock;
+
+	for( xSize = 0; xSize < ( sizeof( xSizes ) / sizeof( xSizes[ 0 ] ) ); xSize++ )
+	{
+		for( ;; )
+		{
+			pvBlock = pvPortMalloc( xSizes[ xSize ] );
+
+			if( pvBlock == NULL )
+			{
+				break;
+			}
+
+			configASSERT( uxTaskBlocks < testMAX_TASK_BLOCKS );
+			pvTaskBlocks[ uxTaskBlocks++ ] = pvBlock;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvFreeTaskBlocks( UBaseType_t uxStride )
+{
+UBaseType_t ux;
+
+	/* Free some of the blocks, small ones among them, so the small block
+	lists hold blocks tasks can reuse. */
+	for( ux = 0; ux < uxTaskBlocks; ux += uxStride )
+	{
+		vPortFree( pvTaskBlocks[ ux ] );
+		pvTaskBlocks[ ux ] = pvTaskBlocks[ --uxTaskBlocks ];
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckISRAllocations( void )
+{
+UBaseType_t ux;
+
+	vPortSimulateInterrupt( prvAllocateFromISR );
+
+	for( ux = 0; ux < testRESERVED_COUNT; ux++ )
+	{
+		configASSERT( pvISRBlocks[ ux ] != NULL );
+	}
+
+	vPortSimulateInterrupt( prvFreeFromISR );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+UBaseType_t uxRound;
+
+	configASSERT( xPortReserveSmallBlocks( testRESERVED_SIZE, testRESERVED_COUNT ) == pdPASS );
+
+	for( uxRound = 0; uxRound < 8; uxRound++ )
+	{
+		/* The reserve survives tasks exhausting the heap, including the small
+		blocks being released for merging when an allocation fails. */
+		prvExhaustHeap();
+		configASSERT( pvPortMalloc( testRESERVED_SIZE ) == NULL );
+		prvCheckISRAllocations();
+
+		/* The blocks the interrupt freed went back to the reserve, not to
+		tasks. */
+		configASSERT( pvPortMalloc( testRESERVED_SIZE ) == NULL );
+		prvCheckISRAllocations();
+
+		/* Blocks freed by tasks refill the reserve while an interrupt holds
+		reserved blocks. */
+		vPortSimulateInterrupt( prvAllocateFromISR );
+		prvFreeTaskBlocks( 3 );
+		vPortSimulateInterrupt( prvFreeFromISR );
+		prvCheckISRAllocations();
+
+		prvFreeTaskBlocks( 1 + ( uxRound % 3 ) );
+		printf( "round %u: ok\n", ( unsigned ) uxRound );
+	}
+
+	printf( "PASS\n" );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,337 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * Tests where heap_regions.c places blocks.
+ *
+ * Three regions are defined: fast memory that DMA cannot reach, fast memory
+ * that it can, and bulk memory that it can.  A block is allocated from the
+ * first region, in the order the regions were defined, that has all the
+ * requested tags.  Once those are full it falls back to the other regions in
+ * the same order, except that a block requested with portHEAP_REGION_DMA is
+ * never placed in a region without it.  Throughout, the statistics of the
+ * regions must add up to those of the whole heap.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define testREGIONS				( 3 )
+#define testMAX_BLOCKS			( 4096 )
+
+/* The regions, in the order they are defined. */
+#define testREGION_FAST			( 0 )
+#define testREGION_FAST_DMA		( 1 )
+#define testREGION_BULK_DMA		( 2 )
+
+static uint8_t ucFastMemory[ 16 * 1024 ] __attribute__( ( aligned( portBYTE_ALIGNMENT ) ) );
+static uint8_t ucFastDMAMemory[ 8 * 1024 ] __attribute__( ( aligned( portBYTE_ALIGNMENT ) ) );
+static uint8_t ucBulkDMAMemory[ 32 * 1024 ] __attribute__( ( aligned( portBYTE_ALIGNMENT ) ) );
+
+static const HeapRegion_t xHeapRegions[ testREGIONS + 1 ] =
+{
+	{ ucFastMemory,		sizeof( ucFastMemory ),		portHEAP_REGION_FAST },
+	{ ucFastDMAMemory,	sizeof( ucFastDMAMemory ),	portHEAP_REGION_FAST | portHEAP_REGION_DMA },
+	{ ucBulkDMAMemory,	sizeof( ucBulkDMAMemory ),	portHEAP_REGION_BULK | portHEAP_REGION_DMA },
+	{ NULL, 0, 0 }
+};
+
+/* The blocks the test has allocated. */
+static void *pvBlocks[ testMAX_BLOCKS ];
+static UBaseType_t uxBlocks = 0;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvRegionOf( const void *pv )
+{
+BaseType_t xRegion;
+const uint8_t *puc = ( const uint8_t * ) pv;
+
+	for( xRegion = 0; xRegion < testREGIONS; xRegion++ )
+	{
+		if( ( puc >= xHeapRegions[ xRegion ].pucStartAddress ) && ( puc < ( xHeapRegions[ xRegion ].pucStartAddress + xHeapRegions[ xRegion ].xSizeInBytes ) ) )
+		{
+			return xRegion;
+		}
+	}
+
+	return -1;
+}
+/*-----------------------------------------------------------*/
+
+/* Allocates a block with the given tags, keeps it to be freed later, and
+returns the region it came from, or -1 if the allocation failed. */
+static BaseType_t prvAllocate( size_t xSize, UBaseType_t uxTags )
+{
+void *pvBlock;
+
+	pvBlock = pvPortMallocTagged( xSize, uxTags );
+
+	if( pvBlock == NULL )
+	{
+		return -1;
+	}
+
+	configASSERT( uxBlocks < testMAX_BLOCKS );
+	pvBlocks[ uxBlocks++ ] = pvBlock;
+
+	return prvRegionOf( pvBlock );
+}
+/*-----------------------------------------------------------*/
+
+static void prvFreeAll( void )
+{
+	while( uxBlocks > 0 )
+	{
+		vPortFree( pvBlocks[ --uxBlocks ] );
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* Allocates blocks with the given tags, large ones first, until a block is
+placed outside xRegion or an allocation fails, so xRegion has no free block
+left.  Returns the region of the last block, or -1 if it could not be
+allocated. */
+static BaseType_t prvFillRegion( BaseType_t xRegion, UBaseType_t uxTags )
+{
+static const size_t xSizes[] = { 512, 64, 1 };
+HeapStats_t xStats;
+BaseType_t xPlacedIn = xRegion;
+UBaseType_t uxSize;
+
+	for( uxSize = 0; uxSize < ( sizeof( xSizes ) / sizeof( xSizes[ 0 ] ) ); uxSize++ )
+	{
+		do
+		{
+			xPlacedIn = prvAllocate( xSizes[ uxSize ], uxTags );
+		} while( xPlacedIn == xRegion );
+
+		if( uxSize < ( ( sizeof( xSizes ) / sizeof( xSizes[ 0 ] ) ) - 1 ) )
+		{
+			/* Give the block back, so a smaller one can take what is left of
+			the region first. */
+			if( xPlacedIn >= 0 )
+			{
+				vPortFree( pvBlocks[ --uxBlocks ] );
+			}
+		}
+	}
+
+	vPortGetHeapRegionStats( ( UBaseType_t ) xRegion, &xStats );
+	configASSERT( xStats.xNumberOfFreeBlocks == 0 );
+	configASSERT( xStats.xAvailableHeapSpaceInBytes == 0 );
+
+	return xPlacedIn;
+}
+/*-----------------------------------------------------------*/
+
+/* The statistics of the regions add up to the statistics of the heap. */
+static void prvCheckStats( void )
+{
+HeapStats_t xHeap, xRegion, xSum = { 0 };
+size_t xSmallest = 0;
+UBaseType_t ux, uxClass;
+
+	vPortGetHeapStats( &xHeap );
+
+	for( ux = 0; ux < testREGIONS; ux++ )
+	{
+		vPortGetHeapRegionStats( ux, &xRegion );
+
+		xSum.xAvailableHeapSpaceInBytes += xRegion.xAvailableHeapSpaceInBytes;
+		xSum.xNumberOfFreeBlocks += xRegion.xNumberOfFreeBlocks;
+		xSum.xNumberOfSuccessfulAllocations += xRegion.xNumberOfSuccessfulAllocations;
+		xSum.xNumberOfSuccessfulFrees += xRegion.xNumberOfSuccessfulFrees;
+		xSum.xMinimumEverFreeBytesRemaining += xRegion.xMinimumEverFreeBytesRemaining;
+
+		for( uxClass = 0; uxClass < portHEAP_STATS_SIZE_CLASSES; uxClass++ )
+		{
+			xSum.xFreeBlocksBySize[ uxClass ] += xRegion.xFreeBlocksBySize[ uxClass ];
+		}
+
+		if( xRegion.xSizeOfLargestFreeBlockInBytes > xSum.xSizeOfLargestFreeBlockInBytes )
+		{
+			xSum.xSizeOfLargestFreeBlockInBytes = xRegion.xSizeOfLargestFreeBlockInBytes;
+		}
+
+		if( ( xRegion.xNumberOfFreeBlocks > 0 ) && ( ( xSmallest == 0 ) || ( xRegion.xSizeOfSmallestFreeBlockInBytes < xSmallest ) ) )
+		{
+			xSmallest = xRegion.xSizeOfSmallestFreeBlockInBytes;
+		}
+
+		/* A region never had less free than it has now. */
+		configASSERT( xRegion.xMinimumEverFreeBytesRemaining <= xRegion.xAvailableHeapSpaceInBytes );
+	}
+
+	configASSERT( xHeap.xAvailableHeapSpaceInBytes == xSum.xAvailableHeapSpaceInBytes );
+	configASSERT( xHeap.xAvailableHeapSpaceInBytes == xPortGetFreeHeapSize() );
+	configASSERT( xHeap.xNumberOfFreeBlocks == xSum.xNumberOfFreeBlocks );
+	configASSERT( xHeap.xNumberOfSuccessfulAllocations == xSum.xNumberOfSuccessfulAllocations );
+	configASSERT( xHeap.xNumberOfSuccessfulFrees == xSum.xNumberOfSuccessfulFrees );
+	configASSERT( xHeap.xSizeOfLargestFreeBlockInBytes == xSum.xSizeOfLargestFreeBlockInBytes );
+	configASSERT( xHeap.xSizeOfSmallestFreeBlockInBytes == xSmallest );
+
+	for( uxClass = 0; uxClass < portHEAP_STATS_SIZE_CLASSES; uxClass++ )
+	{
+		configASSERT( xHeap.xFreeBlocksBySize[ uxClass ] == xSum.xFreeBlocksBySize[ uxClass ] );
+	}
+
+	/* The regions reach their minimums at different times, so the minimum of
+	the whole heap is at least the sum of theirs. */
+	configASSERT( xHeap.xMinimumEverFreeBytesRemaining >= xSum.xMinimumEverFreeBytesRemaining );
+	configASSERT( xHeap.xMinimumEverFreeBytesRemaining == xPortGetMinimumEverFreeHeapSize() );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestPlacement( void )
+{
+	/* Each request goes to the first region with all its tags. */
+	configASSERT( prvAllocate( 64, 0 ) == testREGION_FAST );
+	configASSERT( prvAllocate( 64, portHEAP_REGION_FAST ) == testREGION_FAST );
+	configASSERT( prvAllocate( 64, portHEAP_REGION_DMA ) == testREGION_FAST_DMA );
+	configASSERT( prvAllocate( 64, portHEAP_REGION_FAST | portHEAP_REGION_DMA ) == testREGION_FAST_DMA );
+	configASSERT( prvAllocate( 64, portHEAP_REGION_BULK ) == testREGION_BULK_DMA );
+	configASSERT( prvAllocate( 64, portHEAP_REGION_BULK | portHEAP_REGION_DMA ) == testREGION_BULK_DMA );
+
+	/* No region has all of these tags, so the request falls back to the
+	first region that has the DMA tag. */
+	configASSERT( prvAllocate( 64, portHEAP_REGION_FAST | portHEAP_REGION_BULK | portHEAP_REGION_DMA ) == testREGION_FAST_DMA );
+
+	/* pvPortMalloc() requests no tags. */
+	pvBlocks[ uxBlocks ] = pvPortMalloc( 64 );
+	configASSERT( prvRegionOf( pvBlocks[ uxBlocks ] ) == testREGION_FAST );
+	uxBlocks++;
+
+	prvCheckStats();
+	prvFreeAll();
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestFallbackOrder( void )
+{
+	/* Fast memory is taken from both fast regions, in the order they were
+	defined, before falling back to the bulk region. */
+	configASSERT( prvFillRegion( testREGION_FAST, portHEAP_REGION_FAST ) == testREGION_FAST_DMA );
+	configASSERT( prvFillRegion( testREGION_FAST_DMA, portHEAP_REGION_FAST ) == testREGION_BULK_DMA );
+	prvCheckStats();
+
+	/* With every region full, nothing can be allocated. */
+	configASSERT( prvFillRegion( testREGION_BULK_DMA, portHEAP_REGION_BULK ) == -1 );
+	configASSERT( prvAllocate( 1, 0 ) == -1 );
+	prvCheckStats();
+	prvFreeAll();
+
+	/* Bulk memory falls back to the first region defined, not to the other
+	region that, like the bulk region, has the DMA tag. */
+	configASSERT( prvFillRegion( testREGION_BULK_DMA, portHEAP_REGION_BULK ) == testREGION_FAST );
+	prvCheckStats();
+	prvFreeAll();
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestDMANeverFallsBack( void )
+{
+HeapStats_t xStats;
+UBaseType_t ux;
+
+	/* Memory for DMA fills the first region that has the DMA tag, then the
+	other, and then cannot be allocated, although the region without the
+	tag still has space. */
+	configASSERT( prvFillRegion( testREGION_FAST_DMA, portHEAP_REGION_DMA ) == testREGION_BULK_DMA );
+	configASSERT( prvFillRegion( testREGION_BULK_DMA, portHEAP_REGION_DMA ) == -1 );
+
+	vPortGetHeapRegionStats( testREGION_FAST, &xStats );
+	configASSERT( xStats.xSizeOfLargestFreeBlockInBytes > 1024 );
+
+	configASSERT( prvAllocate( 64, portHEAP_REGION_DMA ) == -1 );
+	configASSERT( prvAllocate( 64, portHEAP_REGION_FAST | portHEAP_REGION_DMA ) == -1 );
+	configASSERT( prvAllocate( 64, portHEAP_REGION_BULK | portHEAP_REGION_DMA ) == -1 );
+	configASSERT( prvAllocate( 64, portHEAP_REGION_FAST ) == testREGION_FAST );
+	prvCheckStats();
+
+	/* Fast memory for DMA drops the fast tag, but not the DMA tag, when
+	space is freed in the bulk region. */
+	for( ux = 0; ux < uxBlocks; )
+	{
+		if( prvRegionOf( pvBlocks[ ux ] ) == testREGION_BULK_DMA )
+		{
+			vPortFree( pvBlocks[ ux ] );
+			pvBlocks[ ux ] = pvBlocks[ --uxBlocks ];
+		}
+		else
+		{
+			ux++;
+		}
+	}
+
+	configASSERT( prvAllocate( 64, portHEAP_REGION_FAST | portHEAP_REGION_DMA ) == testREGION_BULK_DMA );
+	prvCheckStats();
+	prvFreeAll();
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+const size_t xFreeBefore = xPortGetFreeHeapSize();
+UBaseType_t uxRound;
+
+	for( uxRound = 0; uxRound < 4; uxRound++ )
+	{
+		prvTestPlacement();
+		prvTestFallbackOrder();
+		prvTestDMANeverFallsBack();
+		prvCheckStats();
+		configASSERT( xPortGetFreeHeapSize() == xFreeBefore );
+		printf( "round %u: ok\n", ( unsigned ) uxRound );
+	}
+
+	printf( "PASS\n" );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	vPortDefineHeapRegions( xHeapRegions );
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
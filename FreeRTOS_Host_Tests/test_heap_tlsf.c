@@ -0,0 +1,240 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Tests heap_tlsf.c with a random trace of allocations and frees.  Every block
+ * must be aligned, must not overlap any other block, and must be accounted
+ * for in the free heap size and the heap statistics.  Once every block is
+ * freed, the heap must have merged back into a single free block, which can
+ * be allocated whole.  The Makefile builds it with the heap protected by
+ * suspending the scheduler and, as test_heap_tlsf_critical, by critical
+ * sections.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define testOPERATIONS		( 200000UL )
+#define testMAX_LIVE		( 300 )
+
+/* How often, in operations, the heap statistics are checked. */
+#define testCHECK_INTERVAL	( 997UL )
+
+/* The structure heap_tlsf.c places at the start of each block. */
+#define testBLOCK_OVERHEAD	( 2 * sizeof( size_t ) )
+
+typedef struct
+{
+	uint8_t *pucBlock;
+	size_t xSize;
+	uint8_t ucPattern;
+} LiveBlock_t;
+
+static LiveBlock_t xLive[ testMAX_LIVE ];
+static UBaseType_t uxLive = 0;
+
+/* The blocks allocated by the kernel before the test started. */
+static size_t xKernelBlocks;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+static uint32_t ulState = 0x7e57ab1eUL;
+
+	/* xorshift32. */
+	ulState ^= ulState << 13;
+	ulState ^= ulState >> 17;
+	ulState ^= ulState << 5;
+	return ulState;
+}
+/*-----------------------------------------------------------*/
+
+/* Mostly small blocks, with some large enough to fragment the heap. */
+static size_t prvRandomSize( void )
+{
+	if( ( prvRand() % 20 ) == 0 )
+	{
+		return ( size_t ) ( 1000 + ( prvRand() % 3000 ) );
+	}
+	else
+	{
+		return ( size_t ) ( 1 + ( prvRand() % 300 ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvAllocate( void )
+{
+BaseType_t xReturn = pdFALSE;
+LiveBlock_t *pxBlock = &( xLive[ uxLive ] );
+size_t xFreeBefore = xPortGetFreeHeapSize(), x;
+
+	pxBlock->xSize = prvRandomSize();
+	pxBlock->pucBlock = ( uint8_t * ) pvPortMalloc( pxBlock->xSize );
+
+	if( pxBlock->pucBlock != NULL )
+	{
+		configASSERT( ( ( ( uintptr_t ) pxBlock->pucBlock ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+		configASSERT( ( xFreeBefore - xPortGetFreeHeapSize() ) >= ( pxBlock->xSize + testBLOCK_OVERHEAD ) );
+
+		/* Fill the block so an overlap with another block is seen when
+		either is freed. */
+		pxBlock->ucPattern = ( uint8_t ) prvRand();
+
+		for( x = 0; x < pxBlock->xSize; x++ )
+		{
+			pxBlock->pucBlock[ x ] = ( uint8_t ) ( pxBlock->ucPattern + x );
+		}
+
+		uxLive++;
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		configASSERT( xPortGetFreeHeapSize() == xFreeBefore );
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvFree( UBaseType_t uxIndex )
+{
+LiveBlock_t *pxBlock = &( xLive[ uxIndex ] );
+size_t x;
+
+	for( x = 0; x < pxBlock->xSize; x++ )
+	{
+		configASSERT( pxBlock->pucBlock[ x ] == ( uint8_t ) ( pxBlock->ucPattern + x ) );
+	}
+
+	vPortFree( pxBlock->pucBlock );
+	uxLive--;
+	*pxBlock = xLive[ uxLive ];
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckStats( void )
+{
+HeapStats_t xStats;
+size_t xBlocks = 0;
+UBaseType_t ux;
+
+	vPortGetHeapStats( &xStats );
+	configASSERT( xStats.xAvailableHeapSpaceInBytes == xPortGetFreeHeapSize() );
+	configASSERT( ( xStats.xNumberOfSuccessfulAllocations - xStats.xNumberOfSuccessfulFrees ) == ( xKernelBlocks + uxLive ) );
+	configASSERT( xStats.xMinimumEverFreeBytesRemaining <= xStats.xAvailableHeapSpaceInBytes );
+
+	for( ux = 0; ux < portHEAP_STATS_SIZE_CLASSES; ux++ )
+	{
+		xBlocks += xStats.xFreeBlocksBySize[ ux ];
+	}
+
+	configASSERT( xBlocks == xStats.xNumberOfFreeBlocks );
+	configASSERT( ( xStats.xNumberOfFreeBlocks == 0 ) || ( xStats.xSizeOfSmallestFreeBlockInBytes <= xStats.xSizeOfLargestFreeBlockInBytes ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+const size_t xInitialFree = xPortGetFreeHeapSize();
+uint32_t ul, ulFailures = 0;
+HeapStats_t xStats;
+void *pvBlock;
+
+	vPortGetHeapStats( &xStats );
+	xKernelBlocks = xStats.xNumberOfSuccessfulAllocations - xStats.xNumberOfSuccessfulFrees;
+
+	for( ul = 1; ul <= testOPERATIONS; ul++ )
+	{
+		if( ( uxLive < testMAX_LIVE ) && ( ( uxLive == 0 ) || ( ( prvRand() % 2 ) == 0 ) ) )
+		{
+			if( prvAllocate() == pdFALSE )
+			{
+				ulFailures++;
+			}
+		}
+		else
+		{
+			prvFree( ( UBaseType_t ) ( prvRand() % uxLive ) );
+		}
+
+		if( ( ul % testCHECK_INTERVAL ) == 0 )
+		{
+			prvCheckStats();
+		}
+	}
+
+	configASSERT( ulFailures > 0 );
+	printf( "%lu operations, %lu failed allocations: ok\n", ( unsigned long ) testOPERATIONS, ( unsigned long ) ulFailures );
+
+	/* Every block merges back into one. */
+	while( uxLive > 0 )
+	{
+		prvFree( uxLive - 1 );
+	}
+
+	prvCheckStats();
+	vPortGetHeapStats( &xStats );
+	configASSERT( xPortGetFreeHeapSize() == xInitialFree );
+	configASSERT( xStats.xNumberOfFreeBlocks == 1 );
+	configASSERT( xStats.xSizeOfLargestFreeBlockInBytes == xInitialFree );
+
+	/* A request for the whole of the free block succeeds, even though no size
+	class is guaranteed to hold a block that large. */
+	pvBlock = pvPortMalloc( xInitialFree - testBLOCK_OVERHEAD );
+	configASSERT( pvBlock != NULL );
+	configASSERT( xPortGetFreeHeapSize() == 0 );
+	vPortFree( pvBlock );
+	configASSERT( xPortGetFreeHeapSize() == xInitialFree );
+	printf( "merged: ok\n" );
+
+	printf( "PASS\n" );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,350 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Tests the heap tracker.  The blocks a deleted task still owns must be
+ * reported as leaks, with the call sites that allocated them, while a block
+ * handed on to another task, and the deleted task's own TCB and stack, must
+ * not be.  The top call sites must be in order of live bytes, a long random
+ * trace must keep the tracker's totals consistent as the side table fills
+ * and entries move, and blocks allocated from an interrupt must have no
+ * owner.  The Makefile builds it with heap_4.c and the default table of 128
+ * entries, so the table overflows, and as test_heap_tracker_tlsf with
+ * heap_tlsf.c, critical sections and a table of 4096 entries.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "heap_tracker.h"
+
+#define testOPERATIONS		( 100000UL )
+#define testMAX_LIVE		( 300 )
+
+/* The test calls pvPortMalloc() from three functions, which must not be
+inlined, and must not return straight from pvPortMalloc(), so that every call
+from one function has the same call site. */
+#define testNOINLINE		__attribute__( ( noinline ) )
+
+typedef struct
+{
+	void *pvBlock;
+	size_t xTrackedSize;	/* The size recorded by the tracker, or 0 if the block was not tracked. */
+} LiveBlock_t;
+
+static LiveBlock_t xLive[ testMAX_LIVE ];
+static TaskHandle_t xControl;
+static void *pvLeakA, *pvLeakB, *pvHanded;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+static uint32_t ulState = 0x1eaf1eafUL;
+
+	/* xorshift32. */
+	ulState ^= ulState << 13;
+	ulState ^= ulState >> 17;
+	ulState ^= ulState << 5;
+	return ulState;
+}
+/*-----------------------------------------------------------*/
+
+static testNOINLINE void *prvAllocateFromSiteA( size_t xSize )
+{
+void *pvBlock = pvPortMalloc( xSize );
+
+	configASSERT( pvBlock != NULL );
+	return pvBlock;
+}
+/*-----------------------------------------------------------*/
+
+static testNOINLINE void *prvAllocateFromSiteB( size_t xSize )
+{
+void *pvBlock = pvPortMalloc( xSize );
+
+	configASSERT( pvBlock != NULL );
+	return pvBlock;
+}
+/*-----------------------------------------------------------*/
+
+static testNOINLINE void *prvAllocateFromSiteC( size_t xSize )
+{
+void *pvBlock = pvPortMalloc( xSize );
+
+	configASSERT( pvBlock != NULL );
+	return pvBlock;
+}
+/*-----------------------------------------------------------*/
+
+/* Allocates two blocks it never frees, hands a third to the control task,
+then deletes itself. */
+static void prvLeakingTask( void *pvParameters )
+{
+	pvLeakA = prvAllocateFromSiteA( 48 );
+	pvLeakB = prvAllocateFromSiteB( 64 );
+	pvHanded = prvAllocateFromSiteA( 32 );
+	vHeapTrackerSetOwner( pvHanded, xControl );
+
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvFindAllocation( void *pvAddress, HeapTrackerAllocation_t *pxAllocation )
+{
+static HeapTrackerAllocation_t xAllocations[ configHEAP_TRACKER_TABLE_SIZE ];
+UBaseType_t uxCount, ux;
+
+	uxCount = uxHeapTrackerGetAllocations( xAllocations, configHEAP_TRACKER_TABLE_SIZE );
+
+	for( ux = 0; ux < uxCount; ux++ )
+	{
+		if( xAllocations[ ux ].pvAddress == pvAddress )
+		{
+			*pxAllocation = xAllocations[ ux ];
+			return pdTRUE;
+		}
+	}
+
+	return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestLeaks( void )
+{
+HeapTrackerAllocation_t xLeaks[ 4 ], xHandedAllocation;
+HeapTrackerStats_t xStats;
+UBaseType_t uxCount;
+
+	configASSERT( xTaskCreate( prvLeakingTask, "Leaker", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+
+	/* Let the task run and delete itself, and the idle task free it. */
+	vTaskDelay( 2 );
+
+	uxCount = uxHeapTrackerGetLeaks( xLeaks, 4 );
+	configASSERT( uxCount == 2 );
+	configASSERT( ( ( xLeaks[ 0 ].pvAddress == pvLeakA ) && ( xLeaks[ 1 ].pvAddress == pvLeakB ) ) ||
+				  ( ( xLeaks[ 0 ].pvAddress == pvLeakB ) && ( xLeaks[ 1 ].pvAddress == pvLeakA ) ) );
+	configASSERT( ( xLeaks[ 0 ].xOwnerDeleted == pdTRUE ) && ( xLeaks[ 1 ].xOwnerDeleted == pdTRUE ) );
+	configASSERT( xLeaks[ 0 ].pvCaller != xLeaks[ 1 ].pvCaller );
+
+	/* The handed block is owned by this task, and was allocated from the
+	same call site as the first leak. */
+	configASSERT( prvFindAllocation( pvHanded, &xHandedAllocation ) == pdTRUE );
+	configASSERT( ( xHandedAllocation.xOwner == xControl ) && ( xHandedAllocation.xOwnerDeleted == pdFALSE ) );
+	configASSERT( xHandedAllocation.pvCaller == ( ( xLeaks[ 0 ].pvAddress == pvLeakA ) ? xLeaks[ 0 ].pvCaller : xLeaks[ 1 ].pvCaller ) );
+
+	vHeapTrackerGetStats( &xStats );
+	configASSERT( xStats.uxSuspectedLeaks == 2 );
+	configASSERT( xStats.xSuspectedLeakBytes == ( xLeaks[ 0 ].xSize + xLeaks[ 1 ].xSize ) );
+
+	/* Freeing a leak, late, removes it from the report. */
+	vPortFree( pvLeakA );
+	configASSERT( uxHeapTrackerGetLeaks( xLeaks, 4 ) == 1 );
+	configASSERT( xLeaks[ 0 ].pvAddress == pvLeakB );
+	vPortFree( pvLeakB );
+	vPortFree( pvHanded );
+	configASSERT( uxHeapTrackerGetLeaks( xLeaks, 4 ) == 0 );
+
+	printf( "leaks: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestTopCallSites( void )
+{
+HeapTrackerCallSite_t xSites[ 2 ];
+void *pvBlocks[ 9 ];
+UBaseType_t ux;
+
+	/* Site B holds one block of 20000 bytes, site A three of 5000 and site C
+	five of 100, all more than any call site in the kernel. */
+	pvBlocks[ 0 ] = prvAllocateFromSiteB( 20000 );
+
+	for( ux = 1; ux < 4; ux++ )
+	{
+		pvBlocks[ ux ] = prvAllocateFromSiteA( 5000 );
+	}
+
+	for( ux = 4; ux < 9; ux++ )
+	{
+		pvBlocks[ ux ] = prvAllocateFromSiteC( 100 );
+	}
+
+	configASSERT( uxHeapTrackerGetTopCallSites( xSites, 2 ) == 2 );
+	configASSERT( ( xSites[ 0 ].uxLiveBlocks == 1 ) && ( xSites[ 0 ].xLiveBytes >= 20000 ) );
+	configASSERT( ( xSites[ 1 ].uxLiveBlocks == 3 ) && ( xSites[ 1 ].xLiveBytes >= 15000 ) );
+	configASSERT( xSites[ 1 ].xPeakLiveBytes == xSites[ 1 ].xLiveBytes );
+
+	for( ux = 0; ux < 9; ux++ )
+	{
+		vPortFree( pvBlocks[ ux ] );
+	}
+
+	configASSERT( uxHeapTrackerGetTopCallSites( xSites, 2 ) == 2 );
+	configASSERT( ( xSites[ 0 ].uxLiveBlocks == 0 ) || ( xSites[ 0 ].xLiveBytes < 15000 ) );
+
+	printf( "top call sites: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+/* Every allocation and free changes the tracker's totals by the size it
+recorded for the block, or not at all if the block could not be tracked. */
+static void prvTestRandomTrace( void )
+{
+HeapTrackerStats_t xBefore, xAfter;
+UBaseType_t uxLive = 0, uxIndex;
+uint32_t ul, ulUntracked = 0;
+
+	for( ul = 0; ul < testOPERATIONS; ul++ )
+	{
+		vHeapTrackerGetStats( &xBefore );
+
+		if( ( uxLive < testMAX_LIVE ) && ( ( uxLive == 0 ) || ( ( prvRand() % 2 ) == 0 ) ) )
+		{
+			xLive[ uxLive ].pvBlock = prvAllocateFromSiteC( ( size_t ) ( 1 + ( prvRand() % 200 ) ) );
+			vHeapTrackerGetStats( &xAfter );
+
+			if( xAfter.uxTrackedBlocks == ( xBefore.uxTrackedBlocks + 1 ) )
+			{
+				configASSERT( xAfter.ulUntrackedAllocations == xBefore.ulUntrackedAllocations );
+				xLive[ uxLive ].xTrackedSize = xAfter.xTrackedBytes - xBefore.xTrackedBytes;
+				configASSERT( xLive[ uxLive ].xTrackedSize > 0 );
+			}
+			else
+			{
+				configASSERT( xAfter.uxTrackedBlocks == xBefore.uxTrackedBlocks );
+				configASSERT( xAfter.ulUntrackedAllocations == ( xBefore.ulUntrackedAllocations + 1 ) );
+				xLive[ uxLive ].xTrackedSize = 0;
+				ulUntracked++;
+			}
+
+			uxLive++;
+		}
+		else
+		{
+			uxIndex = ( UBaseType_t ) ( prvRand() % uxLive );
+			vPortFree( xLive[ uxIndex ].pvBlock );
+			vHeapTrackerGetStats( &xAfter );
+
+			if( xLive[ uxIndex ].xTrackedSize != 0 )
+			{
+				configASSERT( xAfter.uxTrackedBlocks == ( xBefore.uxTrackedBlocks - 1 ) );
+				configASSERT( xAfter.xTrackedBytes == ( xBefore.xTrackedBytes - xLive[ uxIndex ].xTrackedSize ) );
+			}
+			else
+			{
+				configASSERT( ( xAfter.uxTrackedBlocks == xBefore.uxTrackedBlocks ) && ( xAfter.xTrackedBytes == xBefore.xTrackedBytes ) );
+			}
+
+			uxLive--;
+			xLive[ uxIndex ] = xLive[ uxLive ];
+		}
+	}
+
+	while( uxLive > 0 )
+	{
+		uxLive--;
+		vPortFree( xLive[ uxLive ].pvBlock );
+	}
+
+	configASSERT( ( ulUntracked > 0 ) == ( configHEAP_TRACKER_TABLE_SIZE < ( 2 * testMAX_LIVE ) ) );
+	printf( "%lu operations, %lu untracked allocations: ok\n", ( unsigned long ) testOPERATIONS, ( unsigned long ) ulUntracked );
+}
+/*-----------------------------------------------------------*/
+
+#if( configHEAP_USE_CRITICAL_SECTIONS == 1 )
+
+	static void *pvFromISR;
+
+	static BaseType_t prvAllocateFromISR( void )
+	{
+		pvFromISR = pvPortMallocFromISR( 24 );
+		return pdFALSE;
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvFreeFromISR( void )
+	{
+		vPortFreeFromISR( pvFromISR );
+		return pdFALSE;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvTestFromISR( void )
+	{
+	HeapTrackerAllocation_t xAllocation;
+
+		vPortSimulateInterrupt( prvAllocateFromISR );
+		configASSERT( pvFromISR != NULL );
+		configASSERT( prvFindAllocation( pvFromISR, &xAllocation ) == pdTRUE );
+		configASSERT( xAllocation.xOwner == NULL );
+		vPortSimulateInterrupt( prvFreeFromISR );
+		configASSERT( prvFindAllocation( pvFromISR, &xAllocation ) == pdFALSE );
+
+		printf( "from interrupt: ok\n" );
+	}
+
+#endif /* configHEAP_USE_CRITICAL_SECTIONS */
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+	prvTestLeaks();
+	prvTestTopCallSites();
+	prvTestRandomTrace();
+
+	#if( configHEAP_USE_CRITICAL_SECTIONS == 1 )
+	{
+		prvTestFromISR();
+	}
+	#endif
+
+	printf( "PASS\n" );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, &xControl );
+	configASSERT( xControl );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,505 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * Tests the high resolution timers on the counter simulated by the host port.
+ * Timers are started, restarted and stopped at random while the counter
+ * advances in random steps, from just before it overflows through several
+ * overflows.  Every timer must expire exactly once per start, never before its
+ * expiry count, and exactly at its expiry count unless the compare value was
+ * written less than configHR_TIMER_MIN_COMPARE_DELTA counts before it.  The
+ * same is repeated with the counter also advancing each time it is read, so it
+ * passes compare values while interrupts are masked, where every timer must
+ * still expire soon after its expiry count.  Timers that expire either side of
+ * an overflow that happens while interrupts are masked must expire in order
+ * once they are unmasked, as must timers started just after an overflow with
+ * expiry counts from before it.  A
+ * periodic timer restarted from its own callback must not drift, and
+ * vHRTimerDelay() must block for exactly the requested number of counts even
+ * when other notifications arrive while it waits.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "hr_timers.h"
+
+#define testTIMERS			( 8 )
+#define testSTEPS			( 100000UL )
+#define testPERIOD			( 1000UL )
+#define testDELAYS			( 2000UL )
+
+/* How late a timer may expire when the counter advances each time it is
+read. */
+#define testMAX_LATENESS	( 64UL )
+
+/* Timer 0 restarts itself testPERIOD counts after each expiry count. */
+#define testPERIODIC_TIMER	( 0 )
+
+/* The state of a timer in the model. */
+typedef struct
+{
+	HRTimerHandle_t xTimer;
+	uint32_t ulExpiry;
+	uint32_t ulStart;
+	BaseType_t xActive;
+	uint32_t ulExpiries;
+} ModelTimer_t;
+
+static ModelTimer_t xModel[ testTIMERS ];
+
+/* The counter value when the compare value was last written, by starting or
+stopping a timer or by the compare interrupt.  The interrupt writes it after
+running every callback that is due, so its write is only recorded once a later
+interrupt runs or a task writes it. */
+static uint32_t ulLastCompareWrite = 0, ulInterruptCount = 0;
+static BaseType_t xInterruptWritePending = pdFALSE;
+
+/* Expiries that ran exactly at their expiry count, and those that ran late
+because the compare value was written too close to it. */
+static uint32_t ulExactExpiries = 0, ulLateExpiries = 0;
+
+/* How late an expiry may be, or zero if it must be exact. */
+static uint32_t ulMaxLateness = 0;
+
+/* The order in which timers expired, and the counter value when they did, while
+xLogExpiries is pdTRUE. */
+#define testLOG_LENGTH		( 8 )
+static BaseType_t xLogExpiries = pdFALSE;
+static UBaseType_t uxExpiryLog[ testLOG_LENGTH ], uxExpiryLogLength = 0;
+static uint32_t ulExpiryLogCount[ testLOG_LENGTH ];
+
+static TaskHandle_t xDelayTask = NULL;
+static volatile uint32_t ulDelaysDone = 0;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+static uint32_t ulState = 0x5eed1e55UL;
+
+	/* xorshift32. */
+	ulState ^= ulState << 13;
+	ulState ^= ulState >> 17;
+	ulState ^= ulState << 5;
+	return ulState;
+}
+/*-----------------------------------------------------------*/
+
+/* Checks an expiry that ran at ulNow.  The compare value is kept at least
+configHR_TIMER_MIN_COMPARE_DELTA counts ahead of the counter, so an expiry
+count closer than that to the last write of the compare value, or before the
+timer was started, can run that many counts late.  If the counter advances
+while interrupts are masked then it is not known exactly when the compare value
+was written, so the expiry need only be within ulMaxLateness counts. */
+static void prvCheckExpiry( uint32_t ulExpiry, uint32_t ulStart, uint32_t ulNow )
+{
+uint32_t ulEarliest;
+
+	if( ( xInterruptWritePending != pdFALSE ) && ( ulInterruptCount != ulNow ) )
+	{
+		ulLastCompareWrite = ulInterruptCount;
+	}
+
+	configASSERT( ( int32_t ) ( ulNow - ulExpiry ) >= 0 );
+	ulEarliest = ( ( int32_t ) ( ulExpiry - ulStart ) > 0 ) ? ulExpiry : ulStart;
+
+	if( ulMaxLateness != 0 )
+	{
+		configASSERT( ( ulNow - ulEarliest ) <= ulMaxLateness );
+	}
+	else if( ( int32_t ) ( ulExpiry - ulLastCompareWrite ) >= ( int32_t ) configHR_TIMER_MIN_COMPARE_DELTA )
+	{
+		configASSERT( ulNow == ulExpiry );
+		ulExactExpiries++;
+	}
+	else
+	{
+		configASSERT( ( ulNow - ulEarliest ) <= ( uint32_t ) configHR_TIMER_MIN_COMPARE_DELTA );
+		ulLateExpiries++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( HRTimerHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken )
+{
+ModelTimer_t *pxModel = &( xModel[ ( uintptr_t ) pvHRTimerGetTimerID( xTimer ) ] );
+uint32_t ulNow = ulHRTimerGetCount();
+
+	configASSERT( pxModel->xActive != pdFALSE );
+	configASSERT( ulHRTimerGetExpiryCount( xTimer ) == pxModel->ulExpiry );
+	configASSERT( xHRTimerIsTimerActive( xTimer ) == pdFALSE );
+	prvCheckExpiry( pxModel->ulExpiry, pxModel->ulStart, ulNow );
+	pxModel->ulExpiries++;
+
+	if( ( xLogExpiries != pdFALSE ) && ( uxExpiryLogLength < testLOG_LENGTH ) )
+	{
+		uxExpiryLog[ uxExpiryLogLength ] = ( UBaseType_t ) ( pxModel - xModel );
+		ulExpiryLogCount[ uxExpiryLogLength ] = ulNow;
+		uxExpiryLogLength++;
+	}
+
+	if( pxModel == &( xModel[ testPERIODIC_TIMER ] ) )
+	{
+		/* The next expiry count is relative to this one, not to when the
+		callback ran, so the timer does not drift. */
+		pxModel->ulExpiry += testPERIOD;
+		pxModel->ulStart = ulNow;
+		configASSERT( xHRTimerStartAtFromISR( xTimer, pxModel->ulExpiry ) == pdPASS );
+	}
+	else
+	{
+		pxModel->xActive = pdFALSE;
+	}
+
+	xInterruptWritePending = pdTRUE;
+	ulInterruptCount = ulNow;
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartTimer( UBaseType_t uxTimer, uint32_t ulExpiry )
+{
+ModelTimer_t *pxModel = &( xModel[ uxTimer ] );
+
+	pxModel->ulExpiry = ulExpiry;
+	pxModel->ulStart = ulHRTimerGetCount();
+	pxModel->xActive = pdTRUE;
+	ulLastCompareWrite = pxModel->ulStart;
+	xInterruptWritePending = pdFALSE;
+	configASSERT( xHRTimerStartAt( pxModel->xTimer, ulExpiry ) == pdPASS );
+
+	/* The timer can already have expired if the counter advanced when it was
+	read. */
+	configASSERT( xHRTimerIsTimerActive( pxModel->xTimer ) == pxModel->xActive );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStopTimer( UBaseType_t uxTimer )
+{
+ModelTimer_t *pxModel = &( xModel[ uxTimer ] );
+
+	ulLastCompareWrite = ulHRTimerGetCount();
+	xInterruptWritePending = pdFALSE;
+	configASSERT( xHRTimerStop( pxModel->xTimer ) == ( ( pxModel->xActive != pdFALSE ) ? pdPASS : pdFAIL ) );
+	pxModel->xActive = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+/* The counter advances in random steps, with an occasional large one so it
+overflows several times, while timers are started at random expiry counts,
+some of which have already passed. */
+static void prvTestRandomTimers( uint32_t ulCounts )
+{
+uint32_t ulStep, ulOffset, ulNow, ulPrevious, ulFirstExpiry, ulWraps = 0, ulPeriodicExpiries, ul;
+UBaseType_t ux;
+
+	ulMaxLateness = ( ulCounts != 0 ) ? testMAX_LATENESS : 0;
+	vPortSetHRTimerCountsPerRead( ulCounts );
+	ulExactExpiries = 0;
+	ulLateExpiries = 0;
+
+	for( ux = 0; ux < testTIMERS; ux++ )
+	{
+		xModel[ ux ].ulExpiries = 0;
+	}
+
+	prvStartTimer( testPERIODIC_TIMER, ulHRTimerGetCount() + testPERIOD );
+	ulFirstExpiry = xModel[ testPERIODIC_TIMER ].ulExpiry;
+	ulPrevious = ulHRTimerGetCount();
+
+	for( ul = 0; ul < testSTEPS; ul++ )
+	{
+		ux = 1 + ( prvRand() % ( testTIMERS - 1 ) );
+
+		switch( prvRand() % 8 )
+		{
+			case 0:
+			case 1:
+			case 2:
+				/* Mostly near expiry counts, some that have already passed and
+				some far ahead. */
+				ulOffset = prvRand();
+
+				if( ( ulOffset % 8 ) == 0 )
+				{
+					ulOffset = ( uint32_t ) -( int32_t ) ( ( ulOffset >> 8 ) % 100 );
+				}
+				else if( ( ulOffset % 16 ) == 1 )
+				{
+					ulOffset = ( ulOffset >> 8 ) % 0x40000000UL;
+				}
+				else
+				{
+					ulOffset = ( ulOffset >> 8 ) % 20000;
+				}
+
+				prvStartTimer( ux, ulHRTimerGetCount() + ulOffset );
+				break;
+
+			case 3:
+				prvStopTimer( ux );
+				break;
+
+			case 4:
+				configASSERT( xHRTimerIsTimerActive( xModel[ ux ].xTimer ) == xModel[ ux ].xActive );
+				break;
+
+			default:
+				break;
+		}
+
+		if( ( prvRand() % 128 ) == 0 )
+		{
+			ulStep = prvRand() % 0x1000000UL;
+		}
+		else
+		{
+			ulStep = 1 + ( prvRand() % 4096 );
+		}
+
+		vPortAdvanceHRTimer( ulStep );
+
+		ulNow = ulHRTimerGetCount();
+		configASSERT( ( ulNow - ulPrevious ) >= ulStep );
+
+		if( ulNow < ulPrevious )
+		{
+			ulWraps++;
+		}
+
+		ulPrevious = ulNow;
+	}
+
+	/* Every timer still active expires once the counter has advanced past
+	the furthest expiry count. */
+	ulPeriodicExpiries = xModel[ testPERIODIC_TIMER ].ulExpiries;
+	prvStopTimer( testPERIODIC_TIMER );
+	vPortAdvanceHRTimer( 0x40000000UL + 200UL );
+
+	for( ux = 0; ux < testTIMERS; ux++ )
+	{
+		configASSERT( xModel[ ux ].xActive == pdFALSE );
+		configASSERT( xHRTimerIsTimerActive( xModel[ ux ].xTimer ) == pdFALSE );
+	}
+
+	/* The periodic timer expired once per period, so did not drift. */
+	configASSERT( xModel[ testPERIODIC_TIMER ].ulExpiries == ulPeriodicExpiries );
+	configASSERT( ( uint32_t ) ( xModel[ testPERIODIC_TIMER ].ulExpiry - ulFirstExpiry ) == ( uint32_t ) ( ulPeriodicExpiries * testPERIOD ) );
+	configASSERT( ulWraps >= 1 );
+
+	if( ulCounts == 0 )
+	{
+		configASSERT( ulLateExpiries > 0 );
+		printf( "%lu exact expiries, %lu late expiries, %lu overflows: ok\n", ( unsigned long ) ulExactExpiries,
+			( unsigned long ) ulLateExpiries, ( unsigned long ) ulWraps );
+	}
+	else
+	{
+		printf( "%lu periodic expiries, %lu counts per read, %lu overflows: ok\n", ( unsigned long ) ulPeriodicExpiries,
+			( unsigned long ) ulCounts, ( unsigned long ) ulWraps );
+	}
+
+	vPortSetHRTimerCountsPerRead( 0 );
+	ulMaxLateness = 0;
+}
+/*-----------------------------------------------------------*/
+
+/* Timer 1 expires before the counter overflows, while interrupts are masked.
+Still with interrupts masked, timer 2 is started to expire after the overflow,
+timer 3 to expire at an expiry count before the overflow that has passed, and
+timer 4 at the current count.  Starting the timers writes the compare value,
+which clears the match, so timers 1, 3 and 4 must all expire, in that order,
+configHR_TIMER_MIN_COMPARE_DELTA counts after the compare value was written,
+and timer 2 exactly at its expiry count. */
+static void prvTestOverflowWhileMasked( void )
+{
+	vPortAdvanceHRTimer( 0xffffff00UL - ulHRTimerGetCount() );
+	ulMaxLateness = 0x100UL;
+	xLogExpiries = pdTRUE;
+	uxExpiryLogLength = 0;
+
+	prvStartTimer( 1, 0xffffff80UL );
+
+	taskENTER_CRITICAL();
+	{
+		vPortAdvanceHRTimer( 0x100UL );
+		configASSERT( ulHRTimerGetCount() == 0UL );
+		prvStartTimer( 2, 0x10UL );
+		prvStartTimer( 3, 0xfffffff0UL );
+		prvStartTimer( 4, 0UL );
+		configASSERT( uxExpiryLogLength == 0 );
+	}
+	taskEXIT_CRITICAL();
+
+	vPortAdvanceHRTimer( 0x20UL );
+	configASSERT( uxExpiryLogLength == 4 );
+	configASSERT( ( uxExpiryLog[ 0 ] == 1 ) && ( uxExpiryLog[ 1 ] == 3 ) && ( uxExpiryLog[ 2 ] == 4 ) && ( uxExpiryLog[ 3 ] == 2 ) );
+	configASSERT( ( ulExpiryLogCount[ 0 ] == ( uint32_t ) configHR_TIMER_MIN_COMPARE_DELTA ) && ( ulExpiryLogCount[ 1 ] == ( uint32_t ) configHR_TIMER_MIN_COMPARE_DELTA ) );
+	configASSERT( ( ulExpiryLogCount[ 2 ] == ( uint32_t ) configHR_TIMER_MIN_COMPARE_DELTA ) && ( ulExpiryLogCount[ 3 ] == 0x10UL ) );
+
+	xLogExpiries = pdFALSE;
+	ulMaxLateness = 0;
+
+	printf( "overflow while masked: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+/* Just after the counter overflows, timer 1 is started with an expiry count
+from before the overflow that has passed, as happens when a periodic timer is
+restarted late, timer 2 with an expiry count from after the overflow that has
+passed, and timer 3 with one still to come.  Timers 1 and 2 must expire, in
+that order, configHR_TIMER_MIN_COMPARE_DELTA counts later, and timer 3 exactly
+at its expiry count, and the timers must report the expiry counts they were
+started with. */
+static void prvTestPassedBeforeOverflow( void )
+{
+	vPortAdvanceHRTimer( 0x10UL - ulHRTimerGetCount() );
+	configASSERT( ulHRTimerGetCount() == 0x10UL );
+	xLogExpiries = pdTRUE;
+	uxExpiryLogLength = 0;
+
+	prvStartTimer( 1, 0xfffffff0UL );
+	prvStartTimer( 2, 0x8UL );
+	prvStartTimer( 3, 0x30UL );
+	configASSERT( ulHRTimerGetExpiryCount( xModel[ 1 ].xTimer ) == 0xfffffff0UL );
+
+	vPortAdvanceHRTimer( 100UL );
+	configASSERT( uxExpiryLogLength == 3 );
+	configASSERT( ( uxExpiryLog[ 0 ] == 1 ) && ( uxExpiryLog[ 1 ] == 2 ) && ( uxExpiryLog[ 2 ] == 3 ) );
+	configASSERT( ( ulExpiryLogCount[ 0 ] == 0x10UL + ( uint32_t ) configHR_TIMER_MIN_COMPARE_DELTA ) && ( ulExpiryLogCount[ 1 ] == 0x10UL + ( uint32_t ) configHR_TIMER_MIN_COMPARE_DELTA ) );
+	configASSERT( ulExpiryLogCount[ 2 ] == 0x30UL );
+	configASSERT( ulHRTimerGetExpiryCount( xModel[ 1 ].xTimer ) == 0xfffffff0UL );
+
+	xLogExpiries = pdFALSE;
+
+	printf( "passed before overflow: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvDelayTask( void *pvParameters )
+{
+uint32_t ulCounts, ulStart, ulNow;
+
+	for( ;; )
+	{
+		if( ulDelaysDone < testDELAYS )
+		{
+			ulCounts = prvRand() % ( ( ( ulDelaysDone % 4 ) == 0 ) ? 4 : 5000 );
+			ulStart = ulHRTimerGetCount();
+			vHRTimerDelay( ulCounts );
+			ulNow = ulHRTimerGetCount();
+
+			/* The delay ends exactly ulCounts later, or as soon as the
+			compare value can be written for a very short delay. */
+			if( ulCounts >= ( uint32_t ) configHR_TIMER_MIN_COMPARE_DELTA )
+			{
+				configASSERT( ( ulNow - ulStart ) == ulCounts );
+			}
+			else
+			{
+				configASSERT( ( ulNow - ulStart ) == ( uint32_t ) configHR_TIMER_MIN_COMPARE_DELTA );
+			}
+
+			ulDelaysDone++;
+		}
+		else
+		{
+			vTaskSuspend( NULL );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* The delay task has a higher priority than the control task, so runs as soon
+as the compare interrupt unblocks it.  The control task also gives it
+notifications at the index the delay uses, which must not end a delay early. */
+static void prvTestDelay( void )
+{
+uint32_t ulNotifications = 0;
+
+	configASSERT( xTaskCreate( prvDelayTask, "Delay", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, &xDelayTask ) == pdPASS );
+
+	while( ulDelaysDone < testDELAYS )
+	{
+		if( ( prvRand() % 4 ) == 0 )
+		{
+			( void ) xTaskNotifyGiveIndexed( xDelayTask, configHR_TIMER_NOTIFICATION_INDEX );
+			ulNotifications++;
+		}
+
+		vPortAdvanceHRTimer( 1 + ( prvRand() % 64 ) );
+	}
+
+	vTaskDelete( xDelayTask );
+
+	printf( "%lu delays with %lu other notifications: ok\n", ( unsigned long ) testDELAYS, ( unsigned long ) ulNotifications );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+	configASSERT( ulHRTimerGetCount() == ( uint32_t ) configHR_TIMER_INITIAL_COUNT );
+	prvTestRandomTimers( 0 );
+	prvTestRandomTimers( 1 );
+	prvTestOverflowWhileMasked();
+	prvTestPassedBeforeOverflow();
+	prvTestDelay();
+
+	printf( "PASS\n" );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+UBaseType_t ux;
+
+	for( ux = 0; ux < testTIMERS; ux++ )
+	{
+		xModel[ ux ].xTimer = xHRTimerCreate( prvTimerCallback, ( void * ) ( uintptr_t ) ux );
+		configASSERT( xModel[ ux ].xTimer );
+	}
+
+	/* The control task is below the highest priority so the delay task can
+	preempt it. */
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 2, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
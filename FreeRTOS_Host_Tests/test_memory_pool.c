@@ -0,0 +1,405 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * Tests the fixed block memory pools in memory_pool.c.
+ *
+ * Blocks are allocated and freed by tasks and by interrupts, a task that
+ * waits for a block times out or is given the block another task or an
+ * interrupt frees, and the statistics count every call.  Blocks freed that
+ * do not belong to the pool, or that are already free, must fail the checks
+ * in prvPushFreeBlock() - the test catches the failures through
+ * vTestAssertFailed() rather than letting them abort the program.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "memory_pool.h"
+
+#define testBLOCK_SIZE			( ( size_t ) 20 )
+#define testBLOCK_COUNT			( ( UBaseType_t ) 6 )
+#define testSTATIC_BLOCK_COUNT	( ( UBaseType_t ) 4 )
+#define testTIMEOUT				( ( TickType_t ) 5 )
+
+/* The pool being tested, and the blocks allocated from it. */
+static MemoryPoolHandle_t xPool = NULL;
+static void *pvBlocks[ testBLOCK_COUNT ];
+static void *pvISRBlocks[ 3 ];
+
+/* The block the helper task frees, and whether the interrupt that freed it
+unblocked a task. */
+static void *volatile pvBlockToFree = NULL;
+static volatile BaseType_t xISRWokeTask = pdFALSE;
+static TaskHandle_t xHelperTask = NULL;
+
+/* Storage for the statically allocated pools, one block longer than the
+pools so a block just past the end of a pool can be freed without corrupting
+anything. */
+static uint8_t ucStaticStorage[ memorypoolSTORAGE_SIZE( testBLOCK_SIZE, testSTATIC_BLOCK_COUNT + 1 ) ] __attribute__( ( aligned( portBYTE_ALIGNMENT ) ) );
+static StaticMemoryPool_t xStaticPool;
+
+/* The number of assertions that have failed while they were expected to. */
+static volatile BaseType_t xExpectAssertFailures = pdFALSE;
+static volatile uint32_t ulAssertFailures = 0;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize )
+{
+static StaticTask_t xIdleTaskTCB;
+static StackType_t uxIdleTaskStack[ configMINIMAL_STACK_SIZE ];
+
+	*ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+	*ppxIdleTaskStackBuffer = uxIdleTaskStack;
+	*pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize )
+{
+static StaticTask_t xTimerTaskTCB;
+static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
+
+	*ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+	*ppxTimerTaskStackBuffer = uxTimerTaskStack;
+	*pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+/*-----------------------------------------------------------*/
+
+void vTestAssertFailed( const char *pcFile, int iLine )
+{
+	if( xExpectAssertFailures == pdFALSE )
+	{
+		printf( "assertion failed: %s:%d\n", pcFile, iLine );
+		abort();
+	}
+
+	ulAssertFailures++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckStats( UBaseType_t uxFreeBlocks, UBaseType_t uxMinimumEverFreeBlocks, uint32_t ulAllocations, uint32_t ulFailedAllocations, uint32_t ulFrees )
+{
+MemoryPoolStats_t xStats;
+
+	vMemoryPoolGetStats( xPool, &xStats );
+	configASSERT( xStats.xBlockSize == memorypoolBLOCK_SIZE( testBLOCK_SIZE ) );
+	configASSERT( xStats.uxBlockCount == testBLOCK_COUNT );
+	configASSERT( xStats.uxFreeBlocks == uxFreeBlocks );
+	configASSERT( xStats.uxMinimumEverFreeBlocks == uxMinimumEverFreeBlocks );
+	configASSERT( xStats.ulAllocations == ulAllocations );
+	configASSERT( xStats.ulFailedAllocations == ulFailedAllocations );
+	configASSERT( xStats.ulFrees == ulFrees );
+	configASSERT( uxMemoryPoolGetFreeBlocks( xPool ) == uxFreeBlocks );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvAllocateFromISR( void )
+{
+UBaseType_t ux;
+
+	for( ux = 0; ux < ( sizeof( pvISRBlocks ) / sizeof( pvISRBlocks[ 0 ] ) ); ux++ )
+	{
+		pvISRBlocks[ ux ] = pvMemoryPoolAllocFromISR( xPool );
+	}
+
+	return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvFreeFromISR( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	vMemoryPoolFreeFromISR( xPool, pvBlocks[ 0 ], &xHigherPriorityTaskWoken );
+	vMemoryPoolFreeFromISR( xPool, pvBlocks[ 1 ], &xHigherPriorityTaskWoken );
+	xISRWokeTask = xHigherPriorityTaskWoken;
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvFreeWaitedForBlockFromISR( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	vMemoryPoolFreeFromISR( xPool, pvBlockToFree, &xHigherPriorityTaskWoken );
+	xISRWokeTask = xHigherPriorityTaskWoken;
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+/* Frees pvBlockToFree a couple of ticks after being notified, from the task
+when the notification value is 1 and from an interrupt when it is 2, while
+the control task waits for a block. */
+static void prvHelperTask( void *pvParameters )
+{
+uint32_t ulHow;
+
+	for( ;; )
+	{
+		ulHow = ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		vTaskDelay( 2 );
+
+		if( ulHow == 1UL )
+		{
+			vMemoryPoolFree( xPool, pvBlockToFree );
+		}
+		else
+		{
+			vPortSimulateInterrupt( prvFreeWaitedForBlockFromISR );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void *prvWaitForFreedBlock( void *pvBlock, uint32_t ulHow )
+{
+TickType_t xStart = xTaskGetTickCount();
+void *pvReturn;
+
+	pvBlockToFree = pvBlock;
+	xISRWokeTask = pdFALSE;
+
+	while( ulHow-- > 0UL )
+	{
+		xTaskNotifyGive( xHelperTask );
+	}
+
+	pvReturn = pvMemoryPoolAlloc( xPool, portMAX_DELAY );
+	configASSERT( ( xTaskGetTickCount() - xStart ) >= ( TickType_t ) 2 );
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestAllocateAndFree( void )
+{
+const size_t xBlockSize = memorypoolBLOCK_SIZE( testBLOCK_SIZE );
+UBaseType_t ux, uxOther;
+size_t xOffset;
+TickType_t xStart;
+
+	xPool = xMemoryPoolCreate( testBLOCK_SIZE, testBLOCK_COUNT );
+	configASSERT( xPool );
+	prvCheckStats( testBLOCK_COUNT, testBLOCK_COUNT, 0, 0, 0 );
+
+	/* Every block can be allocated, each is aligned, and no two overlap. */
+	for( ux = 0; ux < testBLOCK_COUNT; ux++ )
+	{
+		pvBlocks[ ux ] = pvMemoryPoolAlloc( xPool, 0 );
+		configASSERT( pvBlocks[ ux ] );
+		configASSERT( ( ( ( size_t ) pvBlocks[ ux ] ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+		memset( pvBlocks[ ux ], ( int ) ux, testBLOCK_SIZE );
+
+		for( uxOther = 0; uxOther < ux; uxOther++ )
+		{
+			xOffset = ( pvBlocks[ ux ] > pvBlocks[ uxOther ] ) ? ( size_t ) ( ( uint8_t * ) pvBlocks[ ux ] - ( uint8_t * ) pvBlocks[ uxOther ] ) : ( size_t ) ( ( uint8_t * ) pvBlocks[ uxOther ] - ( uint8_t * ) pvBlocks[ ux ] );
+			configASSERT( xOffset >= xBlockSize );
+			configASSERT( ( xOffset % xBlockSize ) == 0 );
+		}
+	}
+
+	configASSERT( pvMemoryPoolAlloc( xPool, 0 ) == NULL );
+	prvCheckStats( 0, 0, testBLOCK_COUNT, 1, 0 );
+
+	/* Interrupts free two blocks, then allocate them again, most recently
+	freed first, and fail to allocate a third.  No task was waiting, so no
+	task was woken. */
+	vPortSimulateInterrupt( prvFreeFromISR );
+	configASSERT( xISRWokeTask == pdFALSE );
+	prvCheckStats( 2, 0, testBLOCK_COUNT, 1, 2 );
+
+	vPortSimulateInterrupt( prvAllocateFromISR );
+	configASSERT( pvISRBlocks[ 0 ] == pvBlocks[ 1 ] );
+	configASSERT( pvISRBlocks[ 1 ] == pvBlocks[ 0 ] );
+	configASSERT( pvISRBlocks[ 2 ] == NULL );
+	prvCheckStats( 0, 0, testBLOCK_COUNT + 2, 2, 2 );
+
+	/* A task that waits for a block times out when none is freed. */
+	xStart = xTaskGetTickCount();
+	configASSERT( pvMemoryPoolAlloc( xPool, testTIMEOUT ) == NULL );
+	configASSERT( ( xTaskGetTickCount() - xStart ) >= testTIMEOUT );
+	prvCheckStats( 0, 0, testBLOCK_COUNT + 2, 3, 2 );
+
+	/* A task that waits for a block is given the block freed by another task,
+	and then the block freed by an interrupt, which reports that it woke a
+	task. */
+	configASSERT( prvWaitForFreedBlock( pvBlocks[ 2 ], 1 ) == pvBlocks[ 2 ] );
+	prvCheckStats( 0, 0, testBLOCK_COUNT + 3, 3, 3 );
+
+	configASSERT( prvWaitForFreedBlock( pvBlocks[ 3 ], 2 ) == pvBlocks[ 3 ] );
+	configASSERT( xISRWokeTask == pdTRUE );
+	prvCheckStats( 0, 0, testBLOCK_COUNT + 4, 3, 4 );
+
+	/* The blocks that were never freed still hold what was written to
+	them. */
+	for( ux = 4; ux < testBLOCK_COUNT; ux++ )
+	{
+		for( xOffset = 0; xOffset < testBLOCK_SIZE; xOffset++ )
+		{
+			configASSERT( ( ( uint8_t * ) pvBlocks[ ux ] )[ xOffset ] == ( uint8_t ) ux );
+		}
+	}
+
+	for( ux = 0; ux < testBLOCK_COUNT; ux++ )
+	{
+		vMemoryPoolFree( xPool, pvBlocks[ ux ] );
+	}
+
+	/* Freeing NULL does nothing. */
+	vMemoryPoolFree( xPool, NULL );
+	prvCheckStats( testBLOCK_COUNT, 0, testBLOCK_COUNT + 4, 3, testBLOCK_COUNT + 4 );
+
+	vMemoryPoolDelete( xPool );
+	xPool = NULL;
+}
+/*-----------------------------------------------------------*/
+
+/* Allocates uxAllocated blocks from a new statically allocated pool, frees
+the first uxFreed of them again in order, then frees pvBad, or the first
+block allocated if pvBad is NULL.  Returns the number of assertions that
+failed during that last free.  The pool can be left inconsistent, so is
+deleted. */
+static uint32_t prvBadFree( void *pvBad, UBaseType_t uxAllocated, UBaseType_t uxFreed, void **ppvAllocated )
+{
+MemoryPoolHandle_t xBadPool;
+UBaseType_t ux;
+uint32_t ulFailures;
+
+	xBadPool = xMemoryPoolCreateStatic( testBLOCK_SIZE, testSTATIC_BLOCK_COUNT, ucStaticStorage, &xStaticPool );
+	configASSERT( xBadPool == ( MemoryPoolHandle_t ) &xStaticPool );
+
+	for( ux = 0; ux < uxAllocated; ux++ )
+	{
+		ppvAllocated[ ux ] = pvMemoryPoolAlloc( xBadPool, 0 );
+		configASSERT( ppvAllocated[ ux ] );
+	}
+
+	for( ux = 0; ux < uxFreed; ux++ )
+	{
+		vMemoryPoolFree( xBadPool, ppvAllocated[ ux ] );
+	}
+
+	if( pvBad == NULL )
+	{
+		pvBad = ppvAllocated[ 0 ];
+	}
+
+	ulAssertFailures = 0;
+	xExpectAssertFailures = pdTRUE;
+	vMemoryPoolFree( xBadPool, pvBad );
+	xExpectAssertFailures = pdFALSE;
+	ulFailures = ulAssertFailures;
+
+	vMemoryPoolDelete( xBadPool );
+
+	return ulFailures;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestBadFrees( void )
+{
+const size_t xBlockSize = memorypoolBLOCK_SIZE( testBLOCK_SIZE );
+void *pvAllocated[ testSTATIC_BLOCK_COUNT ];
+
+	/* Good frees fail no checks. */
+	configASSERT( prvBadFree( NULL, 2, 0, pvAllocated ) == 0 );
+
+	/* A block just past the end of the pool, which is otherwise a valid
+	block. */
+	configASSERT( prvBadFree( &( ucStaticStorage[ xBlockSize * testSTATIC_BLOCK_COUNT ] ), 1, 0, pvAllocated ) == 1 );
+
+	/* A block before the start of the pool. */
+	configASSERT( prvBadFree( pvAllocated, 1, 0, pvAllocated ) >= 1 );
+
+	/* A pointer into the middle of a block. */
+	configASSERT( prvBadFree( &( ucStaticStorage[ xBlockSize + 8 ] ), 1, 0, pvAllocated ) == 1 );
+
+	/* A block freed twice in succession, which is caught because it is the
+	first free block. */
+	configASSERT( prvBadFree( NULL, 2, 1, pvAllocated ) == 1 );
+
+	/* A block freed again after another block, which is caught because the
+	pool would then have more free blocks than blocks. */
+	configASSERT( prvBadFree( NULL, 2, 2, pvAllocated ) == 1 );
+
+	/* Both of the above. */
+	configASSERT( prvBadFree( NULL, 1, 1, pvAllocated ) == 2 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+const size_t xFreeBefore = xPortGetFreeHeapSize();
+UBaseType_t uxRound;
+
+	xTaskCreate( prvHelperTask, "Helper", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xHelperTask );
+
+	for( uxRound = 0; uxRound < 4; uxRound++ )
+	{
+		prvTestAllocateAndFree();
+		printf( "allocate and free, round %u: ok\n", ( unsigned ) uxRound );
+	}
+
+	prvTestBadFrees();
+	printf( "bad frees: ok\n" );
+
+	/* The dynamically allocated pools were returned to the heap, and the
+	statically allocated one never took from it. */
+	vTaskDelete( xHelperTask );
+	vTaskDelay( 2 );
+	configASSERT( xPortGetFreeHeapSize() == xFreeBefore );
+
+	printf( "PASS\n" );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
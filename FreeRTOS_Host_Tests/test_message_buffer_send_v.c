@@ -0,0 +1,453 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * Tests xMessageBufferSendV() and xMessageBufferSendVFromISR().
+ *
+ * Messages split into a random number of fragments, some of them empty, are
+ * sent from a task or an interrupt to a single writer and a multi-producer
+ * message buffer, and checked against a model of the buffer.  Each message
+ * must take exactly its length plus one length field from the free space, be
+ * received as one message, and be written either whole or not at all when
+ * there is not enough space - including when there is space for the data but
+ * not for the length.
+ *
+ * Several tasks, preempted at random between reserving and committing their
+ * space, and an interrupt then send multi-fragment messages through a small
+ * multi-producer message buffer, and each message must reach the reader
+ * intact.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "message_buffer.h"
+
+#define testLENGTH_BYTES		( sizeof( size_t ) )
+
+/* The model test. */
+#define testBUFFER_SIZE			( ( size_t ) 64 )
+#define testMAX_MESSAGE			( ( size_t ) 40 )
+#define testMAX_FRAGMENTS		( 5 )
+#define testMAX_QUEUED			( 16 )
+#define testMODEL_OPERATIONS	( 20000UL )
+
+/* The concurrent senders.  The buffer size is not a multiple of the message
+sizes, so messages wrap around the end of the buffer. */
+#define testPRODUCERS			( 3 )
+#define testMESSAGES			( 400 )
+#define testHEADER_BYTES		( 4 )
+#define testMAX_PAYLOAD			( 12 )
+#define testSTRESS_SIZE			( 50 )
+#define testISR_SEND_ONE_IN		( 3 )
+
+static MessageBufferHandle_t xMessageBuffer = NULL;
+static TaskHandle_t xControl = NULL;
+
+/* The model: the length and number of each message in the buffer, oldest
+first. */
+static size_t xQueuedLength[ testMAX_QUEUED ];
+static uint8_t ucQueuedNumber[ testMAX_QUEUED ];
+static UBaseType_t uxQueued = 0;
+static uint8_t ucNextNumber = 0;
+
+/* Sends that failed although there was space for the data, but not for its
+length. */
+static uint32_t ulShortOfLength = 0;
+
+/* The send performed by prvSendVFromISR(). */
+static const MessageBufferFragment_t *pxISRFragments = NULL;
+static UBaseType_t uxISRFragments = 0;
+static size_t xISRResult = 0;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+static uint32_t ulState = 0x5d1e4a93UL;
+
+	/* xorshift32. */
+	ulState ^= ulState << 13;
+	ulState ^= ulState >> 17;
+	ulState ^= ulState << 5;
+	return ulState;
+}
+/*-----------------------------------------------------------*/
+
+static uint8_t prvMessageByte( uint8_t ucNumber, size_t xOffset )
+{
+	return ( uint8_t ) ( ( ucNumber * 37U ) + xOffset );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSendVFromISR( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	xISRResult = xMessageBufferSendVFromISR( xMessageBuffer, pxISRFragments, uxISRFragments, &xHigherPriorityTaskWoken );
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+/* Splits a new message of random length into a random number of fragments at
+random points, so fragments can be empty, and sends it from a task or an
+interrupt. */
+static void prvSendMessage( void )
+{
+uint8_t ucMessage[ testMAX_MESSAGE ];
+MessageBufferFragment_t xFragments[ testMAX_FRAGMENTS ];
+const size_t xLength = 1 + ( prvRand() % testMAX_MESSAGE );
+const UBaseType_t uxFragments = 1 + ( prvRand() % testMAX_FRAGMENTS );
+const size_t xSpaceBefore = xMessageBufferSpaceAvailable( xMessageBuffer );
+size_t xOffset = 0, xSent, x;
+UBaseType_t ux;
+
+	for( x = 0; x < xLength; x++ )
+	{
+		ucMessage[ x ] = prvMessageByte( ucNextNumber, x );
+	}
+
+	for( ux = 0; ux < uxFragments; ux++ )
+	{
+		if( ux == ( uxFragments - 1 ) )
+		{
+			xFragments[ ux ].xLength = xLength - xOffset;
+		}
+		else
+		{
+			xFragments[ ux ].xLength = prvRand() % ( xLength - xOffset + 1 );
+		}
+
+		/* An empty fragment need not point anywhere. */
+		xFragments[ ux ].pvData = ( xFragments[ ux ].xLength > 0 ) ? &( ucMessage[ xOffset ] ) : NULL;
+		xOffset += xFragments[ ux ].xLength;
+	}
+
+	if( ( prvRand() & 1 ) != 0 )
+	{
+		pxISRFragments = xFragments;
+		uxISRFragments = uxFragments;
+		vPortSimulateInterrupt( prvSendVFromISR );
+		xSent = xISRResult;
+	}
+	else
+	{
+		xSent = xMessageBufferSendV( xMessageBuffer, xFragments, uxFragments, 0 );
+	}
+
+	if( xSpaceBefore >= ( xLength + testLENGTH_BYTES ) )
+	{
+		/* The whole message was written, with a single length. */
+		configASSERT( xSent == xLength );
+		configASSERT( xMessageBufferSpaceAvailable( xMessageBuffer ) == ( xSpaceBefore - xLength - testLENGTH_BYTES ) );
+		configASSERT( uxQueued < testMAX_QUEUED );
+		xQueuedLength[ uxQueued ] = xLength;
+		ucQueuedNumber[ uxQueued ] = ucNextNumber++;
+		uxQueued++;
+	}
+	else
+	{
+		/* None of it was written. */
+		configASSERT( xSent == 0 );
+		configASSERT( xMessageBufferSpaceAvailable( xMessageBuffer ) == xSpaceBefore );
+
+		if( xSpaceBefore >= xLength )
+		{
+			ulShortOfLength++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvReceiveMessage( void )
+{
+uint8_t ucReceived[ testMAX_MESSAGE ];
+size_t xReceived, x;
+
+	if( uxQueued == 0 )
+	{
+		configASSERT( xMessageBufferIsEmpty( xMessageBuffer ) == pdTRUE );
+		return;
+	}
+
+	/* The fragments of the oldest message are received as one message.
+	xMessageBufferNextLengthBytes() cannot be used inside an expression, as it
+	ends in a semicolon. */
+	configASSERT( xStreamBufferNextMessageLengthBytes( ( StreamBufferHandle_t ) xMessageBuffer ) == xQueuedLength[ 0 ] );
+	xReceived = xMessageBufferReceive( xMessageBuffer, ucReceived, sizeof( ucReceived ), 0 );
+	configASSERT( xReceived == xQueuedLength[ 0 ] );
+
+	for( x = 0; x < xReceived; x++ )
+	{
+		configASSERT( ucReceived[ x ] == prvMessageByte( ucQueuedNumber[ 0 ], x ) );
+	}
+
+	uxQueued--;
+	memmove( xQueuedLength, &( xQueuedLength[ 1 ] ), uxQueued * sizeof( xQueuedLength[ 0 ] ) );
+	memmove( ucQueuedNumber, &( ucQueuedNumber[ 1 ] ), uxQueued * sizeof( ucQueuedNumber[ 0 ] ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestAgainstModel( MessageBufferHandle_t xBuffer )
+{
+uint32_t ul;
+
+	xMessageBuffer = xBuffer;
+	configASSERT( xMessageBuffer );
+	uxQueued = 0;
+	ulShortOfLength = 0;
+
+	for( ul = 0; ul < testMODEL_OPERATIONS; ul++ )
+	{
+		/* Send slightly more often than receive, so the buffer is often too
+		full for the next message. */
+		if( ( prvRand() % 5 ) < 3 )
+		{
+			prvSendMessage();
+		}
+		else
+		{
+			prvReceiveMessage();
+		}
+	}
+
+	configASSERT( ulShortOfLength > 0 );
+
+	while( uxQueued > 0 )
+	{
+		prvReceiveMessage();
+	}
+
+	configASSERT( xMessageBufferIsEmpty( xMessageBuffer ) == pdTRUE );
+	vMessageBufferDelete( xMessageBuffer );
+}
+/*-----------------------------------------------------------*/
+
+/* Fills in the header and payload of message usNumber from ucSender and
+returns its three fragments: the header, the payload and a checksum, each held
+in a separate place. */
+static void prvBuildMessage( uint8_t ucSender, uint16_t usNumber, uint8_t *pucHeader, uint8_t *pucPayload, uint8_t *pucChecksum, MessageBufferFragment_t *pxFragments )
+{
+const size_t xPayload = ( ucSender + usNumber ) % ( testMAX_PAYLOAD + 1 );
+uint8_t ucSum = 0;
+size_t x;
+
+	pucHeader[ 0 ] = ucSender;
+	pucHeader[ 1 ] = ( uint8_t ) ( usNumber & 0xffU );
+	pucHeader[ 2 ] = ( uint8_t ) ( usNumber >> 8 );
+	pucHeader[ 3 ] = ( uint8_t ) xPayload;
+
+	for( x = 0; x < xPayload; x++ )
+	{
+		pucPayload[ x ] = ( uint8_t ) ( ( ucSender * 50U ) + usNumber + x );
+	}
+
+	for( x = 0; x < testHEADER_BYTES; x++ )
+	{
+		ucSum += pucHeader[ x ];
+	}
+
+	for( x = 0; x < xPayload; x++ )
+	{
+		ucSum += pucPayload[ x ];
+	}
+
+	*pucChecksum = ucSum;
+
+	pxFragments[ 0 ].pvData = pucHeader;
+	pxFragments[ 0 ].xLength = testHEADER_BYTES;
+	pxFragments[ 1 ].pvData = pucPayload;
+	pxFragments[ 1 ].xLength = xPayload;
+	pxFragments[ 2 ].pvData = pucChecksum;
+	pxFragments[ 2 ].xLength = 1;
+}
+/*-----------------------------------------------------------*/
+
+static void prvProducerTask( void *pvParameters )
+{
+const uint8_t ucSender = ( uint8_t ) ( uintptr_t ) pvParameters;
+uint8_t ucHeader[ testHEADER_BYTES ], ucPayload[ testMAX_PAYLOAD ], ucChecksum;
+MessageBufferFragment_t xFragments[ 3 ];
+uint16_t usNumber;
+
+	for( usNumber = 0; usNumber < testMESSAGES; usNumber++ )
+	{
+		prvBuildMessage( ucSender, usNumber, ucHeader, ucPayload, &ucChecksum, xFragments );
+		configASSERT( xMessageBufferSendV( xMessageBuffer, xFragments, 3, portMAX_DELAY ) == ( testHEADER_BYTES + xFragments[ 1 ].xLength + 1 ) );
+	}
+
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+/* The interrupt sends as sender testPRODUCERS.  It runs between the reader's
+receives, while producers can be part way through writing to the space they
+reserved. */
+static uint16_t usISRSent = 0;
+
+static BaseType_t prvProducerISR( void )
+{
+static uint8_t ucHeader[ testHEADER_BYTES ], ucPayload[ testMAX_PAYLOAD ], ucChecksum;
+static MessageBufferFragment_t xFragments[ 3 ];
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	prvBuildMessage( testPRODUCERS, usISRSent, ucHeader, ucPayload, &ucChecksum, xFragments );
+
+	if( xMessageBufferSendVFromISR( xMessageBuffer, xFragments, 3, &xHigherPriorityTaskWoken ) != 0 )
+	{
+		usISRSent++;
+	}
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+/* Checks a received message is whole and is the next one from its sender. */
+static void prvCheckMessage( const uint8_t *pucMessage, size_t xLength, uint16_t *pusNextNumber )
+{
+const uint8_t ucSender = pucMessage[ 0 ];
+const uint16_t usNumber = ( uint16_t ) ( pucMessage[ 1 ] | ( pucMessage[ 2 ] << 8 ) );
+uint8_t ucHeader[ testHEADER_BYTES ], ucPayload[ testMAX_PAYLOAD ], ucChecksum;
+MessageBufferFragment_t xFragments[ 3 ];
+
+	configASSERT( xLength >= ( testHEADER_BYTES + 1 ) );
+	configASSERT( ucSender <= testPRODUCERS );
+	configASSERT( usNumber == pusNextNumber[ ucSender ] );
+
+	prvBuildMessage( ucSender, usNumber, ucHeader, ucPayload, &ucChecksum, xFragments );
+	configASSERT( xLength == ( testHEADER_BYTES + xFragments[ 1 ].xLength + 1 ) );
+	configASSERT( memcmp( pucMessage, ucHeader, testHEADER_BYTES ) == 0 );
+	configASSERT( memcmp( &( pucMessage[ testHEADER_BYTES ] ), ucPayload, xFragments[ 1 ].xLength ) == 0 );
+	configASSERT( pucMessage[ xLength - 1 ] == ucChecksum );
+
+	pusNextNumber[ ucSender ]++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReaderTask( void *pvParameters )
+{
+uint8_t ucMessage[ testHEADER_BYTES + testMAX_PAYLOAD + 1 ];
+uint16_t usNextNumber[ testPRODUCERS + 1 ] = { 0 };
+uint32_t ulFromTasks = 0;
+size_t xLength;
+
+	while( ulFromTasks < ( testPRODUCERS * testMESSAGES ) )
+	{
+		xLength = xMessageBufferReceive( xMessageBuffer, ucMessage, sizeof( ucMessage ), portMAX_DELAY );
+		prvCheckMessage( ucMessage, xLength, usNextNumber );
+
+		if( ucMessage[ 0 ] < testPRODUCERS )
+		{
+			ulFromTasks++;
+		}
+
+		if( ( prvRand() % testISR_SEND_ONE_IN ) == 0 )
+		{
+			vPortSimulateInterrupt( prvProducerISR );
+		}
+	}
+
+	/* Collect what the interrupt sent after the last message from a task. */
+	while( xMessageBufferIsEmpty( xMessageBuffer ) == pdFALSE )
+	{
+		xLength = xMessageBufferReceive( xMessageBuffer, ucMessage, sizeof( ucMessage ), 0 );
+		prvCheckMessage( ucMessage, xLength, usNextNumber );
+	}
+
+	configASSERT( usNextNumber[ testPRODUCERS ] == usISRSent );
+	configASSERT( usISRSent > ( testMESSAGES / 2 ) );
+
+	xTaskNotifyGive( xControl );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestConcurrentSenders( void )
+{
+UBaseType_t ux;
+
+	xMessageBuffer = xMessageBufferCreateMultiProducer( testSTRESS_SIZE );
+	configASSERT( xMessageBuffer );
+	usISRSent = 0;
+	vPortSetRandomPreemption( 3, 1 );
+
+	for( ux = 0; ux < testPRODUCERS; ux++ )
+	{
+		configASSERT( xTaskCreate( prvProducerTask, "Producer", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) ux, 1, NULL ) == pdPASS );
+	}
+
+	configASSERT( xTaskCreate( prvReaderTask, "Reader", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	vPortSetRandomPreemption( 0, 0 );
+
+	/* Let the idle task free the tasks that deleted themselves. */
+	vTaskDelay( 2 );
+	vMessageBufferDelete( xMessageBuffer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+const size_t xFreeBefore = xPortGetFreeHeapSize();
+
+	prvTestAgainstModel( xMessageBufferCreate( testBUFFER_SIZE ) );
+	printf( "single writer: ok\n" );
+
+	prvTestAgainstModel( xMessageBufferCreateMultiProducer( testBUFFER_SIZE ) );
+	printf( "multi-producer: ok\n" );
+
+	prvTestConcurrentSenders();
+	printf( "%u producers and an interrupt: ok\n", ( unsigned ) testPRODUCERS );
+
+	configASSERT( xPortGetFreeHeapSize() == xFreeBefore );
+
+	printf( "PASS\n" );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, &xControl );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
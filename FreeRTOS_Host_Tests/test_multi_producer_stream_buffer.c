@@ -0,0 +1,267 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Tests stream buffers created with xStreamBufferCreateMultiProducer().  As
+ * with a single writer, a task that sends with a block time must wait until
+ * all of its data fits, and only writes part of it once the block time has
+ * expired, or when it cannot block.  Records sent by several producers that
+ * are preempted at random must then reach the reader intact.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+
+#define testBUFFER_SIZE		( 16 )
+#define testFILL_BYTES		( 12 )
+#define testSEND_BYTES		( 8 )
+
+/* The stress phase.  The buffer size is not a multiple of the record size, so
+records wrap around the end of the buffer. */
+#define testPRODUCERS		( 4 )
+#define testRECORDS			( 500 )
+#define testRECORD_BYTES	( 8 )
+#define testSTRESS_SIZE		( 44 )
+
+/* The send a sender task performs each time it is notified. */
+typedef struct
+{
+	StreamBufferHandle_t xStreamBuffer;
+	TickType_t xTicksToWait;
+	volatile size_t xResult;
+	volatile uint32_t ulReturns;
+	TaskHandle_t xTask;
+} Sender_t;
+
+static Sender_t xSender;
+static StreamBufferHandle_t xStreamBuffer;
+static TaskHandle_t xControl;
+
+static const uint8_t ucFill[ testFILL_BYTES ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 };
+static const uint8_t ucSend[ testSEND_BYTES ] = { 100, 101, 102, 103, 104, 105, 106, 107 };
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static void prvSenderTask( void *pvParameters )
+{
+Sender_t *pxSender = ( Sender_t * ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		pxSender->xResult = xStreamBufferSend( pxSender->xStreamBuffer, ucSend, testSEND_BYTES, pxSender->xTicksToWait );
+		pxSender->ulReturns++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSendFromISR( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	xSender.xResult = xStreamBufferSendFromISR( xStreamBuffer, ucSend, testSEND_BYTES, &xHigherPriorityTaskWoken );
+	xSender.ulReturns++;
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+/* Empty the buffer, checking it holds the last xFillBytes of ucFill followed
+by the first xSendBytes of ucSend. */
+static void prvDrainAndCheck( size_t xFillBytes, size_t xSendBytes )
+{
+uint8_t ucReceived[ testBUFFER_SIZE ];
+
+	configASSERT( xStreamBufferBytesAvailable( xStreamBuffer ) == ( xFillBytes + xSendBytes ) );
+	configASSERT( xStreamBufferReceive( xStreamBuffer, ucReceived, sizeof( ucReceived ), 0 ) == ( xFillBytes + xSendBytes ) );
+	configASSERT( memcmp( ucReceived, &( ucFill[ testFILL_BYTES - xFillBytes ] ), xFillBytes ) == 0 );
+	configASSERT( memcmp( &( ucReceived[ xFillBytes ] ), ucSend, xSendBytes ) == 0 );
+}
+/*-----------------------------------------------------------*/
+
+/* Each record holds the producer number, the record number, and a payload
+derived from both. */
+static void prvProducerTask( void *pvParameters )
+{
+uint8_t ucProducer = ( uint8_t ) ( uintptr_t ) pvParameters;
+uint8_t ucRecord[ testRECORD_BYTES ];
+uint16_t usRecord;
+size_t x;
+
+	for( usRecord = 0; usRecord < testRECORDS; usRecord++ )
+	{
+		ucRecord[ 0 ] = ucProducer;
+		ucRecord[ 1 ] = ( uint8_t ) ( usRecord & 0xffU );
+		ucRecord[ 2 ] = ( uint8_t ) ( usRecord >> 8 );
+
+		for( x = 3; x < testRECORD_BYTES; x++ )
+		{
+			ucRecord[ x ] = ( uint8_t ) ( ucProducer + usRecord + x );
+		}
+
+		configASSERT( xStreamBufferSend( xStreamBuffer, ucRecord, testRECORD_BYTES, portMAX_DELAY ) == testRECORD_BYTES );
+	}
+
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+/* Reads the stream in chunks of whatever size is available, and checks the
+records of each producer arrive whole and in order. */
+static void prvReaderTask( void *pvParameters )
+{
+uint8_t ucRecord[ testRECORD_BYTES ];
+uint16_t usNextRecord[ testPRODUCERS ] = { 0 };
+uint32_t ulRecords = 0;
+size_t xHave = 0, x;
+uint16_t usRecord;
+
+	while( ulRecords < ( testPRODUCERS * testRECORDS ) )
+	{
+		xHave += xStreamBufferReceive( xStreamBuffer, &( ucRecord[ xHave ] ), testRECORD_BYTES - xHave, portMAX_DELAY );
+
+		if( xHave == testRECORD_BYTES )
+		{
+			configASSERT( ucRecord[ 0 ] < testPRODUCERS );
+			usRecord = ( uint16_t ) ( ucRecord[ 1 ] | ( ucRecord[ 2 ] << 8 ) );
+			configASSERT( usRecord == usNextRecord[ ucRecord[ 0 ] ] );
+
+			for( x = 3; x < testRECORD_BYTES; x++ )
+			{
+				configASSERT( ucRecord[ x ] == ( uint8_t ) ( ucRecord[ 0 ] + usRecord + x ) );
+			}
+
+			usNextRecord[ ucRecord[ 0 ] ]++;
+			ulRecords++;
+			xHave = 0;
+		}
+	}
+
+	xTaskNotifyGive( xControl );
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+uint8_t ucReceived[ testSEND_BYTES ];
+UBaseType_t ux;
+
+	/* A blocking send waits until all of its data fits, rather than writing
+	the four bytes there is space for. */
+	configASSERT( xStreamBufferSend( xStreamBuffer, ucFill, testFILL_BYTES, 0 ) == testFILL_BYTES );
+	xSender.xTicksToWait = portMAX_DELAY;
+	xTaskNotifyGive( xSender.xTask );
+	vTaskDelay( 1 );
+	configASSERT( xSender.ulReturns == 0 );
+	configASSERT( xStreamBufferBytesAvailable( xStreamBuffer ) == testFILL_BYTES );
+
+	/* Freeing less space than the send needs leaves it blocked. */
+	configASSERT( xStreamBufferReceive( xStreamBuffer, ucReceived, 2, 0 ) == 2 );
+	vTaskDelay( 1 );
+	configASSERT( xSender.ulReturns == 0 );
+
+	/* Freeing enough space lets it write all of its data at once. */
+	configASSERT( xStreamBufferReceive( xStreamBuffer, ucReceived, 2, 0 ) == 2 );
+	vTaskDelay( 1 );
+	configASSERT( ( xSender.ulReturns == 1 ) && ( xSender.xResult == testSEND_BYTES ) );
+	prvDrainAndCheck( testFILL_BYTES - 4, testSEND_BYTES );
+	printf( "blocking send: ok\n" );
+
+	/* A send whose block time expires writes what fits. */
+	configASSERT( xStreamBufferSend( xStreamBuffer, ucFill, testFILL_BYTES, 0 ) == testFILL_BYTES );
+	xSender.xTicksToWait = 3;
+	xTaskNotifyGive( xSender.xTask );
+	vTaskDelay( 2 );
+	configASSERT( xSender.ulReturns == 1 );
+	vTaskDelay( 3 );
+	configASSERT( ( xSender.ulReturns == 2 ) && ( xSender.xResult == ( testBUFFER_SIZE - testFILL_BYTES ) ) );
+	prvDrainAndCheck( testFILL_BYTES, testBUFFER_SIZE - testFILL_BYTES );
+	printf( "timeout: ok\n" );
+
+	/* As does a send that cannot block, from a task or an interrupt. */
+	configASSERT( xStreamBufferSend( xStreamBuffer, ucFill, testFILL_BYTES, 0 ) == testFILL_BYTES );
+	configASSERT( xStreamBufferSend( xStreamBuffer, ucSend, testSEND_BYTES, 0 ) == ( testBUFFER_SIZE - testFILL_BYTES ) );
+	prvDrainAndCheck( testFILL_BYTES, testBUFFER_SIZE - testFILL_BYTES );
+	configASSERT( xStreamBufferSend( xStreamBuffer, ucFill, testFILL_BYTES, 0 ) == testFILL_BYTES );
+	vPortSimulateInterrupt( prvSendFromISR );
+	configASSERT( ( xSender.ulReturns == 3 ) && ( xSender.xResult == ( testBUFFER_SIZE - testFILL_BYTES ) ) );
+	prvDrainAndCheck( testFILL_BYTES, testBUFFER_SIZE - testFILL_BYTES );
+	printf( "no block time: ok\n" );
+
+	/* Several producers sending records through a small buffer, preempted at
+	random, so they often block waiting for space. */
+	vTaskDelete( xSender.xTask );
+	vStreamBufferDelete( xStreamBuffer );
+	xStreamBuffer = xStreamBufferCreateMultiProducer( testSTRESS_SIZE, 1 );
+	configASSERT( xStreamBuffer );
+	vPortSetRandomPreemption( 3, 1 );
+
+	for( ux = 0; ux < testPRODUCERS; ux++ )
+	{
+		configASSERT( xTaskCreate( prvProducerTask, "Producer", configMINIMAL_STACK_SIZE, ( void * ) ( uintptr_t ) ux, 1, NULL ) == pdPASS );
+	}
+
+	configASSERT( xTaskCreate( prvReaderTask, "Reader", configMINIMAL_STACK_SIZE, NULL, 1, NULL ) == pdPASS );
+	( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	vPortSetRandomPreemption( 0, 0 );
+	configASSERT( xStreamBufferIsEmpty( xStreamBuffer ) == pdTRUE );
+	printf( "%u producers: ok\n", ( unsigned ) testPRODUCERS );
+
+	printf( "PASS\n" );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xStreamBuffer = xStreamBufferCreateMultiProducer( testBUFFER_SIZE, 1 );
+	configASSERT( xStreamBuffer );
+	xSender.xStreamBuffer = xStreamBuffer;
+
+	xTaskCreate( prvSenderTask, "Sender", configMINIMAL_STACK_SIZE, &xSender, 1, &( xSender.xTask ) );
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, &xControl );
+	configASSERT( xSender.xTask && xControl );
+
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
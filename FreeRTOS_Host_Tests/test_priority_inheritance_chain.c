@@ -0,0 +1,207 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Tests transitive priority inheritance, with configMAX_PRIORITY_INHERITANCE_DEPTH
+ * set to 3.  A high priority task blocks on a mutex at the head of a chain of
+ * four mutex holders, each blocked on the mutex held by the next.  The first
+ * three holders must inherit its priority, the fourth must not, and all of them
+ * must drop back when it times out and when the mutexes are released.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#define testHIGH_PRIORITY		( 5 )
+#define testHIGH_BLOCK_TIME		( ( TickType_t ) 10 )
+
+/* A task in the chain takes the mutex it holds, then blocks on the mutex the
+next task holds or, at the end of the chain, on a notification. */
+typedef struct
+{
+	SemaphoreHandle_t *pxHeld;
+	SemaphoreHandle_t *pxWanted;
+	TickType_t xTicksToWait;
+	UBaseType_t uxBasePriority;
+	TaskHandle_t xTask;
+	volatile BaseType_t xGotWanted;
+} ChainLink_t;
+
+static SemaphoreHandle_t xMutexA, xMutexB, xMutexC, xMutexD;
+
+/* High -> M (holds A) -> K (holds B) -> L (holds C) -> J (holds D). */
+static ChainLink_t xChain[] =
+{
+	{ &xMutexD, NULL, 0, 1, NULL, pdFALSE },
+	{ &xMutexC, &xMutexD, portMAX_DELAY, 1, NULL, pdFALSE },
+	{ &xMutexB, &xMutexC, portMAX_DELAY, 2, NULL, pdFALSE },
+	{ &xMutexA, &xMutexB, portMAX_DELAY, 3, NULL, pdFALSE },
+	{ NULL, &xMutexA, testHIGH_BLOCK_TIME, testHIGH_PRIORITY, NULL, pdFALSE }
+};
+
+#define testJ		( 0 )
+#define testL		( 1 )
+#define testK		( 2 )
+#define testM		( 3 )
+#define testHIGH	( 4 )
+#define testLINKS	( sizeof( xChain ) / sizeof( xChain[ 0 ] ) )
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static void prvChainTask( void *pvParameters )
+{
+ChainLink_t *pxLink = ( ChainLink_t * ) pvParameters;
+
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+		if( pxLink->pxHeld != NULL )
+		{
+			configASSERT( xSemaphoreTake( *( pxLink->pxHeld ), 0 ) == pdPASS );
+		}
+
+		if( pxLink->pxWanted != NULL )
+		{
+			pxLink->xGotWanted = xSemaphoreTake( *( pxLink->pxWanted ), pxLink->xTicksToWait );
+
+			if( pxLink->xGotWanted != pdFALSE )
+			{
+				configASSERT( xSemaphoreGive( *( pxLink->pxWanted ) ) == pdPASS );
+			}
+		}
+		else
+		{
+			( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		}
+
+		if( pxLink->pxHeld != NULL )
+		{
+			configASSERT( xSemaphoreGive( *( pxLink->pxHeld ) ) == pdPASS );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckPriorities( UBaseType_t uxJ, UBaseType_t uxL, UBaseType_t uxK, UBaseType_t uxM )
+{
+	configASSERT( uxTaskPriorityGet( xChain[ testJ ].xTask ) == uxJ );
+	configASSERT( uxTaskPriorityGet( xChain[ testL ].xTask ) == uxL );
+	configASSERT( uxTaskPriorityGet( xChain[ testK ].xTask ) == uxK );
+	configASSERT( uxTaskPriorityGet( xChain[ testM ].xTask ) == uxM );
+}
+/*-----------------------------------------------------------*/
+
+static void prvStart( UBaseType_t uxLink )
+{
+	xTaskNotifyGive( xChain[ uxLink ].xTask );
+	vTaskDelay( 1 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+UBaseType_t uxRound;
+
+	for( uxRound = 0; uxRound < 2; uxRound++ )
+	{
+		/* Build the chain from its end, checking the priority each new
+		blocked task passes along it. */
+		prvStart( testJ );
+		prvCheckPriorities( 1, 1, 2, 3 );
+		prvStart( testL );
+		prvCheckPriorities( 1, 1, 2, 3 );
+		prvStart( testK );
+		prvCheckPriorities( 2, 2, 2, 3 );
+		prvStart( testM );
+		prvCheckPriorities( 3, 3, 3, 3 );
+
+		/* The high priority task raises three holders, not four. */
+		prvStart( testHIGH );
+		prvCheckPriorities( 3, testHIGH_PRIORITY, testHIGH_PRIORITY, testHIGH_PRIORITY );
+
+		if( uxRound == 0 )
+		{
+			/* When it times out the holders drop back to the priority of the
+			highest task still waiting on the mutex each holds. */
+			vTaskDelay( testHIGH_BLOCK_TIME );
+			configASSERT( xChain[ testHIGH ].xGotWanted == pdFALSE );
+			prvCheckPriorities( 3, 3, 3, 3 );
+		}
+
+		/* Release the end of the chain, which releases every mutex in turn
+		and returns each task to its base priority. */
+		xTaskNotifyGive( xChain[ testJ ].xTask );
+		vTaskDelay( 1 );
+		configASSERT( xChain[ testHIGH ].xGotWanted == ( ( uxRound == 0 ) ? pdFALSE : pdTRUE ) );
+		configASSERT( xChain[ testL ].xGotWanted != pdFALSE );
+		configASSERT( xChain[ testK ].xGotWanted != pdFALSE );
+		configASSERT( xChain[ testM ].xGotWanted != pdFALSE );
+		prvCheckPriorities( 1, 1, 2, 3 );
+
+		printf( "%s: ok\n", ( uxRound == 0 ) ? "timeout" : "release" );
+	}
+
+	printf( "PASS\n" );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+UBaseType_t ux;
+
+	xMutexA = xSemaphoreCreateMutex();
+	xMutexB = xSemaphoreCreateMutex();
+	xMutexC = xSemaphoreCreateMutex();
+	xMutexD = xSemaphoreCreateMutex();
+	configASSERT( xMutexA && xMutexB && xMutexC && xMutexD );
+
+	for( ux = 0; ux < testLINKS; ux++ )
+	{
+		xTaskCreate( prvChainTask, "Chain", configMINIMAL_STACK_SIZE, &( xChain[ ux ] ), xChain[ ux ].uxBasePriority, &( xChain[ ux ].xTask ) );
+		configASSERT( xChain[ ux ].xTask );
+	}
+
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,437 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Tests xSemaphoreGiveMultipleFromISR() and xSemaphoreTakeMultiple(), in
+ * particular with tasks that take several counts at once waiting on the same
+ * semaphore as tasks that take one count at a time.
+ *
+ * A give unblocks, in priority order, only the waiting tasks the new count can
+ * satisfy.  A task that wants more count than is available must not keep the
+ * give from lower priority tasks that could use it, must not be unblocked
+ * just to block again, and when several such tasks wait together they must
+ * not pass the give back and forth between themselves.  Time only advances in
+ * the idle task, so a task that keeps the count from others, or tasks that
+ * livelock, stop the test from finishing.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#define testMAX_COUNT			( 10 )
+#define testSINGLE_TAKERS		( 2 )
+#define testWAITERS				( 6 )
+
+static SemaphoreHandle_t xSemaphore = NULL;
+static volatile uint32_t ulMultipleTakes[ 2 ] = { 0 };
+static volatile uint32_t ulSingleTakes[ testSINGLE_TAKERS ] = { 0 };
+static volatile uint32_t ulMultipleTimeouts = 0;
+
+/* The count taken by each multiple taker. */
+static UBaseType_t uxTakeCount[ 2 ] = { 4, 4 };
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static void prvMultipleTakerTask( void *pvParameters )
+{
+const UBaseType_t uxIndex = ( UBaseType_t ) pvParameters;
+
+	for( ;; )
+	{
+		if( xSemaphoreTakeMultiple( xSemaphore, uxTakeCount[ uxIndex ], portMAX_DELAY ) == pdPASS )
+		{
+			ulMultipleTakes[ uxIndex ]++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimedMultipleTakerTask( void *pvParameters )
+{
+	for( ;; )
+	{
+		if( xSemaphoreTakeMultiple( xSemaphore, 4, 5 ) == pdPASS )
+		{
+			ulMultipleTakes[ 0 ]++;
+		}
+		else
+		{
+			ulMultipleTimeouts++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSingleTakerTask( void *pvParameters )
+{
+const UBaseType_t uxIndex = ( UBaseType_t ) pvParameters;
+
+	for( ;; )
+	{
+		if( xSemaphoreTake( xSemaphore, portMAX_DELAY ) == pdPASS )
+		{
+			ulSingleTakes[ uxIndex ]++;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvSingleTakesTotal( void )
+{
+	return ulSingleTakes[ 0 ] + ulSingleTakes[ 1 ];
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvGiveOneFromISR( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	configASSERT( xSemaphoreGiveFromISR( xSemaphore, &xHigherPriorityTaskWoken ) == pdPASS );
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t uxCountToGive;
+
+static BaseType_t prvGiveMultipleFromISR( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	configASSERT( xSemaphoreGiveMultipleFromISR( xSemaphore, uxCountToGive, &xHigherPriorityTaskWoken ) == pdPASS );
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static void prvGiveMultiple( UBaseType_t uxCount )
+{
+	uxCountToGive = uxCount;
+	vPortSimulateInterrupt( prvGiveMultipleFromISR );
+}
+/*-----------------------------------------------------------*/
+
+static void prvCreateSingleTakers( TaskHandle_t *pxHandles )
+{
+	/* Priorities 1 and 2, both below the multiple takers. */
+	xTaskCreate( prvSingleTakerTask, "Single0", configMINIMAL_STACK_SIZE, ( void * ) 0, 1, &( pxHandles[ 0 ] ) );
+	xTaskCreate( prvSingleTakerTask, "Single1", configMINIMAL_STACK_SIZE, ( void * ) 1, 2, &( pxHandles[ 1 ] ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvDeleteTasks( TaskHandle_t *pxHandles, UBaseType_t uxNumber )
+{
+UBaseType_t ux;
+
+	for( ux = 0; ux < uxNumber; ux++ )
+	{
+		vTaskDelete( pxHandles[ ux ] );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvResetCounts( void )
+{
+	ulMultipleTakes[ 0 ] = ulMultipleTakes[ 1 ] = 0;
+	ulSingleTakes[ 0 ] = ulSingleTakes[ 1 ] = 0;
+	ulMultipleTimeouts = 0;
+
+	while( xSemaphoreTake( xSemaphore, 0 ) == pdPASS )
+	{
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* Single takers alone: a multiple give unblocks up to that many of them. */
+static void prvTestGiveMultiple( void )
+{
+TaskHandle_t xTasks[ testSINGLE_TAKERS ];
+
+	prvResetCounts();
+	prvCreateSingleTakers( xTasks );
+	vTaskDelay( 2 );
+
+	prvGiveMultiple( 3 );
+	vTaskDelay( 2 );
+	configASSERT( prvSingleTakesTotal() == 3 );
+	configASSERT( uxSemaphoreGetCount( xSemaphore ) == 0 );
+
+	/* All or nothing - more than the space left is refused. */
+	uxCountToGive = testMAX_COUNT + 1;
+	configASSERT( xSemaphoreGiveMultipleFromISR( xSemaphore, uxCountToGive, NULL ) == errQUEUE_FULL );
+	configASSERT( uxSemaphoreGetCount( xSemaphore ) == 0 );
+
+	/* Given with the scheduler suspended, so the queue is not locked but the
+	unblocked tasks are held pending. */
+	vTaskSuspendAll();
+	{
+		configASSERT( xSemaphoreGiveMultipleFromISR( xSemaphore, 2, NULL ) == pdPASS );
+	}
+	xTaskResumeAll();
+	vTaskDelay( 2 );
+	configASSERT( prvSingleTakesTotal() == 5 );
+
+	prvDeleteTasks( xTasks, testSINGLE_TAKERS );
+	printf( "give multiple: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+/* A multiple taker above two single takers. */
+static void prvTestMixedTakers( void )
+{
+TaskHandle_t xTasks[ testSINGLE_TAKERS + 1 ];
+
+	prvResetCounts();
+	uxTakeCount[ 0 ] = 4;
+	prvCreateSingleTakers( xTasks );
+	xTaskCreate( prvMultipleTakerTask, "Multi0", configMINIMAL_STACK_SIZE, ( void * ) 0, 3, &( xTasks[ testSINGLE_TAKERS ] ) );
+	vTaskDelay( 2 );
+
+	/* The multiple taker cannot use a give from a task, so the higher
+	priority single taker must get it. */
+	xSemaphoreGive( xSemaphore );
+	vTaskDelay( 2 );
+	configASSERT( ulMultipleTakes[ 0 ] == 0 );
+	configASSERT( ulSingleTakes[ 1 ] == 1 );
+	configASSERT( ulSingleTakes[ 0 ] == 0 );
+	configASSERT( uxSemaphoreGetCount( xSemaphore ) == 0 );
+
+	/* The same from an interrupt. */
+	vPortSimulateInterrupt( prvGiveOneFromISR );
+	vTaskDelay( 2 );
+	configASSERT( ulMultipleTakes[ 0 ] == 0 );
+	configASSERT( prvSingleTakesTotal() == 2 );
+	configASSERT( uxSemaphoreGetCount( xSemaphore ) == 0 );
+
+	/* Enough for the multiple taker, which has the highest priority. */
+	prvGiveMultiple( 4 );
+	vTaskDelay( 2 );
+	configASSERT( ulMultipleTakes[ 0 ] == 1 );
+	configASSERT( prvSingleTakesTotal() == 2 );
+	configASSERT( uxSemaphoreGetCount( xSemaphore ) == 0 );
+
+	/* More than enough - the remainder goes to a single taker. */
+	prvGiveMultiple( 5 );
+	vTaskDelay( 2 );
+	configASSERT( ulMultipleTakes[ 0 ] == 2 );
+	configASSERT( prvSingleTakesTotal() == 3 );
+	configASSERT( uxSemaphoreGetCount( xSemaphore ) == 0 );
+
+	/* Three single gives with the scheduler suspended, so the unblocked
+	tasks are held pending until it is resumed. */
+	vTaskSuspendAll();
+	{
+		xSemaphoreGive( xSemaphore );
+		xSemaphoreGive( xSemaphore );
+		xSemaphoreGive( xSemaphore );
+	}
+	xTaskResumeAll();
+	vTaskDelay( 2 );
+	configASSERT( ulMultipleTakes[ 0 ] == 2 );
+	configASSERT( prvSingleTakesTotal() == 6 );
+	configASSERT( uxSemaphoreGetCount( xSemaphore ) == 0 );
+
+	prvDeleteTasks( xTasks, testSINGLE_TAKERS + 1 );
+	printf( "mixed takers: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+/* Two multiple takers that cannot use the count, at the same priority and at
+different priorities, above the single takers. */
+static void prvTestSeveralMultipleTakers( UBaseType_t uxSecondPriority )
+{
+TaskHandle_t xTasks[ testSINGLE_TAKERS + 2 ];
+
+	prvResetCounts();
+	uxTakeCount[ 0 ] = 4;
+	uxTakeCount[ 1 ] = 3;
+	prvCreateSingleTakers( xTasks );
+	xTaskCreate( prvMultipleTakerTask, "Multi0", configMINIMAL_STACK_SIZE, ( void * ) 0, 4, &( xTasks[ testSINGLE_TAKERS ] ) );
+	xTaskCreate( prvMultipleTakerTask, "Multi1", configMINIMAL_STACK_SIZE, ( void * ) 1, uxSecondPriority, &( xTasks[ testSINGLE_TAKERS + 1 ] ) );
+	vTaskDelay( 2 );
+
+	xSemaphoreGive( xSemaphore );
+	vTaskDelay( 2 );
+	configASSERT( ulMultipleTakes[ 0 ] == 0 );
+	configASSERT( ulMultipleTakes[ 1 ] == 0 );
+	configASSERT( ulSingleTakes[ 1 ] == 1 );
+	configASSERT( uxSemaphoreGetCount( xSemaphore ) == 0 );
+
+	/* Two counts are still too few for either multiple taker. */
+	prvGiveMultiple( 2 );
+	vTaskDelay( 2 );
+	configASSERT( ulMultipleTakes[ 0 ] == 0 );
+	configASSERT( ulMultipleTakes[ 1 ] == 0 );
+	configASSERT( prvSingleTakesTotal() == 3 );
+	configASSERT( uxSemaphoreGetCount( xSemaphore ) == 0 );
+
+	/* Three is enough for the second multiple taker only. */
+	prvGiveMultiple( 3 );
+	vTaskDelay( 2 );
+	configASSERT( ulMultipleTakes[ 0 ] == 0 );
+	configASSERT( ulMultipleTakes[ 1 ] == 1 );
+	configASSERT( prvSingleTakesTotal() == 3 );
+	configASSERT( uxSemaphoreGetCount( xSemaphore ) == 0 );
+
+	prvDeleteTasks( xTasks, testSINGLE_TAKERS + 2 );
+	printf( "multiple takers at priorities 4 and %u: ok\n", ( unsigned ) uxSecondPriority );
+}
+/*-----------------------------------------------------------*/
+
+/* A multiple taker that times out must not keep a give from the single
+takers either. */
+static void prvTestTimeout( void )
+{
+TaskHandle_t xTasks[ testSINGLE_TAKERS + 1 ];
+
+	prvResetCounts();
+	prvCreateSingleTakers( xTasks );
+	xTaskCreate( prvTimedMultipleTakerTask, "Timed", configMINIMAL_STACK_SIZE, NULL, 3, &( xTasks[ testSINGLE_TAKERS ] ) );
+	vTaskDelay( 12 );
+	configASSERT( ulMultipleTimeouts >= 2 );
+
+	xSemaphoreGive( xSemaphore );
+	vTaskDelay( 2 );
+	configASSERT( ulSingleTakes[ 1 ] == 1 );
+
+	prvGiveMultiple( 4 );
+	vTaskDelay( 2 );
+	configASSERT( ulMultipleTakes[ 0 ] == 1 );
+	configASSERT( uxSemaphoreGetCount( xSemaphore ) == 0 );
+
+	prvDeleteTasks( xTasks, testSINGLE_TAKERS + 1 );
+	printf( "timed multiple taker: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+/* Returns the number of tasks in pxHandles that are no longer blocked. */
+static UBaseType_t prvUnblocked( TaskHandle_t *pxHandles, UBaseType_t uxNumber )
+{
+UBaseType_t ux, uxUnblocked = 0;
+
+	for( ux = 0; ux < uxNumber; ux++ )
+	{
+		if( eTaskGetState( pxHandles[ ux ] ) != eBlocked )
+		{
+			uxUnblocked++;
+		}
+	}
+
+	return uxUnblocked;
+}
+/*-----------------------------------------------------------*/
+
+/* Many single takers below a multiple taker.  Each give must unblock only as
+many tasks as the count can satisfy, not every waiting task. */
+static void prvTestBoundedWake( void )
+{
+TaskHandle_t xSingles[ testWAITERS ], xMultiple;
+UBaseType_t ux;
+uint32_t ulSwitches;
+
+	prvResetCounts();
+	uxTakeCount[ 0 ] = 4;
+
+	for( ux = 0; ux < testWAITERS; ux++ )
+	{
+		xTaskCreate( prvSingleTakerTask, "Single", configMINIMAL_STACK_SIZE, ( void * ) ( ux % 2 ), 1 + ( ux % 2 ), &( xSingles[ ux ] ) );
+	}
+
+	xTaskCreate( prvMultipleTakerTask, "Multi0", configMINIMAL_STACK_SIZE, ( void * ) 0, 3, &xMultiple );
+	vTaskDelay( 2 );
+	configASSERT( prvUnblocked( xSingles, testWAITERS ) == 0 );
+
+	/* The control task has the highest priority, so the unblocked tasks
+	cannot run before they are counted. */
+	xSemaphoreGive( xSemaphore );
+	configASSERT( eTaskGetState( xMultiple ) == eBlocked );
+	configASSERT( prvUnblocked( xSingles, testWAITERS ) == 1 );
+	ulSwitches = ulPortGetContextSwitchCount();
+	vTaskDelay( 2 );
+	configASSERT( prvSingleTakesTotal() == 1 );
+
+	/* Only the unblocked single taker runs, so the switches are to it, to the
+	idle task, and back to the control task. */
+	configASSERT( ( ulPortGetContextSwitchCount() - ulSwitches ) == 3 );
+
+	prvGiveMultiple( 3 );
+	configASSERT( eTaskGetState( xMultiple ) == eBlocked );
+	configASSERT( prvUnblocked( xSingles, testWAITERS ) == 3 );
+	vTaskDelay( 2 );
+	configASSERT( prvSingleTakesTotal() == 4 );
+
+	/* Enough for the multiple taker, which has the highest priority, and
+	none left over. */
+	prvGiveMultiple( 4 );
+	configASSERT( eTaskGetState( xMultiple ) != eBlocked );
+	configASSERT( prvUnblocked( xSingles, testWAITERS ) == 0 );
+	vTaskDelay( 2 );
+	configASSERT( ulMultipleTakes[ 0 ] == 1 );
+	configASSERT( prvSingleTakesTotal() == 4 );
+	configASSERT( uxSemaphoreGetCount( xSemaphore ) == 0 );
+
+	prvDeleteTasks( xSingles, testWAITERS );
+	vTaskDelete( xMultiple );
+	printf( "bounded wake: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+	prvTestGiveMultiple();
+	prvTestMixedTakers();
+	prvTestSeveralMultipleTakers( 4 );
+	prvTestSeveralMultipleTakers( 3 );
+	prvTestTimeout();
+	prvTestBoundedWake();
+
+	printf( "PASS\n" );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xSemaphore = xSemaphoreCreateCounting( testMAX_COUNT, 0 );
+	configASSERT( xSemaphore );
+
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
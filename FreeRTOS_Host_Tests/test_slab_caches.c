@@ -0,0 +1,359 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * Tests the slab caches that kernel objects are allocated from when
+ * configUSE_SLAB_CACHES is 1.
+ *
+ * An object deleted and created again reuses the same memory, a cache that
+ * runs out grows by configSLAB_CACHE_GROW_OBJECTS objects or, when that is 0,
+ * fails the creation and counts the failure, and an object whose storage or
+ * stack cannot be allocated from the heap returns its structure to its cache.
+ * Slabs are never freed, so once the caches have grown to the most objects
+ * the test uses, the free heap must return to the same value after every
+ * round of creating and deleting objects.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "timers.h"
+#include "event_groups.h"
+#include "slab.h"
+
+#define testEVENT_GROUPS		( 6 )
+#define testQUEUE_LENGTH		( ( UBaseType_t ) 8 )
+#define testQUEUE_ITEM_SIZE		( ( UBaseType_t ) 32 )
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static void prvBlockedTask( void *pvParameters )
+{
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+}
+/*-----------------------------------------------------------*/
+
+static SlabCacheStats_t prvGetStats( eSlabCache eCache )
+{
+SlabCacheStats_t xStats;
+
+	vSlabCacheGetStats( eCache, &xStats );
+	return xStats;
+}
+/*-----------------------------------------------------------*/
+
+/* Each type of object, deleted and created again, reuses the memory it was
+deleted from, and leaves the heap as it was. */
+static void prvTestReuse( void )
+{
+const size_t xFreeBefore = xPortGetFreeHeapSize();
+EventGroupHandle_t xEventGroup;
+TimerHandle_t xTimer;
+QueueHandle_t xQueue;
+SemaphoreHandle_t xMutex;
+TaskHandle_t xTask;
+void *pvFirst;
+uint8_t ucItem[ testQUEUE_ITEM_SIZE ] = { 0 };
+UBaseType_t ux;
+
+	xEventGroup = xEventGroupCreate();
+	configASSERT( xEventGroup );
+	pvFirst = xEventGroup;
+	vEventGroupDelete( xEventGroup );
+	xEventGroup = xEventGroupCreate();
+	configASSERT( xEventGroup == pvFirst );
+	vEventGroupDelete( xEventGroup );
+
+	/* A timer is freed by the timer task, so it must run before the timer is
+	created again. */
+	xTimer = xTimerCreate( "Timer", 10, pdFALSE, NULL, prvTimerCallback );
+	configASSERT( xTimer );
+	pvFirst = xTimer;
+	configASSERT( xTimerDelete( xTimer, 0 ) == pdPASS );
+	vTaskDelay( 1 );
+	xTimer = xTimerCreate( "Timer", 10, pdFALSE, NULL, prvTimerCallback );
+	configASSERT( xTimer == pvFirst );
+	configASSERT( xTimerDelete( xTimer, 0 ) == pdPASS );
+	vTaskDelay( 1 );
+
+	/* A queue's storage is allocated from the heap separately, and freed
+	separately from its structure. */
+	xQueue = xQueueCreate( testQUEUE_LENGTH, testQUEUE_ITEM_SIZE );
+	configASSERT( xQueue );
+	configASSERT( xPortGetFreeHeapSize() <= ( xFreeBefore - ( testQUEUE_LENGTH * testQUEUE_ITEM_SIZE ) ) );
+	pvFirst = xQueue;
+
+	for( ux = 0; ux < testQUEUE_LENGTH; ux++ )
+	{
+		ucItem[ 0 ] = ( uint8_t ) ux;
+		configASSERT( xQueueSend( xQueue, ucItem, 0 ) == pdPASS );
+	}
+
+	vQueueDelete( xQueue );
+	configASSERT( xPortGetFreeHeapSize() == xFreeBefore );
+
+	/* A mutex is in the same cache as a queue, but has no storage to free. */
+	xMutex = xSemaphoreCreateMutex();
+	configASSERT( xMutex == pvFirst );
+	configASSERT( xSemaphoreTake( xMutex, 0 ) == pdPASS );
+	configASSERT( xSemaphoreGive( xMutex ) == pdPASS );
+	vSemaphoreDelete( xMutex );
+
+	/* A task deleted by another task is freed at once. */
+	configASSERT( xTaskCreate( prvBlockedTask, "Blocked", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xTask ) == pdPASS );
+	pvFirst = xTask;
+	vTaskDelete( xTask );
+	configASSERT( xTaskCreate( prvBlockedTask, "Blocked", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &xTask ) == pdPASS );
+	configASSERT( xTask == pvFirst );
+	vTaskDelete( xTask );
+
+	configASSERT( xPortGetFreeHeapSize() == xFreeBefore );
+}
+/*-----------------------------------------------------------*/
+
+/* Creates more event groups than the first slab of their cache holds. */
+static void prvTestGrowth( void )
+{
+const SlabCacheStats_t xBefore = prvGetStats( eSlabCacheEventGroup );
+const size_t xFreeBefore = xPortGetFreeHeapSize();
+EventGroupHandle_t xEventGroups[ testEVENT_GROUPS ];
+SlabCacheStats_t xAfter;
+UBaseType_t ux, uxCreated = 0;
+
+	for( ux = 0; ux < testEVENT_GROUPS; ux++ )
+	{
+		xEventGroups[ ux ] = xEventGroupCreate();
+
+		if( xEventGroups[ ux ] != NULL )
+		{
+			uxCreated++;
+		}
+	}
+
+	xAfter = prvGetStats( eSlabCacheEventGroup );
+	configASSERT( xAfter.uxObjectsInUse == uxCreated );
+	configASSERT( xAfter.ulAllocations == ( xBefore.ulAllocations + uxCreated ) );
+
+	#if( configSLAB_CACHE_GROW_OBJECTS > 0 )
+	{
+		UBaseType_t uxObjects = xBefore.uxObjects, uxSlabs = xBefore.uxSlabs;
+
+		/* The cache grows a slab at a time, only when it is empty. */
+		while( uxObjects < testEVENT_GROUPS )
+		{
+			uxObjects += configSLAB_CACHE_GROW_OBJECTS;
+			uxSlabs++;
+		}
+
+		configASSERT( uxCreated == testEVENT_GROUPS );
+		configASSERT( xAfter.uxObjects == uxObjects );
+		configASSERT( xAfter.uxSlabs == uxSlabs );
+		configASSERT( xAfter.xBytesReserved == ( xAfter.xObjectSize * uxObjects ) );
+		configASSERT( xAfter.ulFailedAllocations == xBefore.ulFailedAllocations );
+		configASSERT( ( xAfter.uxSlabs > xBefore.uxSlabs ) || ( xPortGetFreeHeapSize() == xFreeBefore ) );
+	}
+	#else
+	{
+		/* The cache does not grow, so each creation after the first slab is
+		used up fails, and takes nothing from the heap. */
+		configASSERT( uxCreated == configSLAB_CACHE_EVENT_GROUPS );
+		configASSERT( xAfter.uxObjects == configSLAB_CACHE_EVENT_GROUPS );
+		configASSERT( xAfter.uxSlabs == 1 );
+		configASSERT( xAfter.ulFailedAllocations == ( xBefore.ulFailedAllocations + ( testEVENT_GROUPS - configSLAB_CACHE_EVENT_GROUPS ) ) );
+		configASSERT( xPortGetFreeHeapSize() == xFreeBefore );
+	}
+	#endif /* configSLAB_CACHE_GROW_OBJECTS */
+
+	configASSERT( xAfter.uxMaximumObjectsInUse >= uxCreated );
+
+	for( ux = 0; ux < testEVENT_GROUPS; ux++ )
+	{
+		if( xEventGroups[ ux ] != NULL )
+		{
+			vEventGroupDelete( xEventGroups[ ux ] );
+		}
+	}
+
+	configASSERT( prvGetStats( eSlabCacheEventGroup ).uxObjectsInUse == 0 );
+}
+/*-----------------------------------------------------------*/
+
+/* Creates tasks until their cache is empty.  With the stack allocated from
+the heap before the TCB is taken from the cache, a creation that fails for
+want of a TCB must free the stack again. */
+static void prvTestTaskCacheEmpty( void )
+{
+#if( configSLAB_CACHE_GROW_OBJECTS == 0 )
+	const SlabCacheStats_t xBefore = prvGetStats( eSlabCacheTask );
+	const size_t xFreeBefore = xPortGetFreeHeapSize();
+	TaskHandle_t xTasks[ configSLAB_CACHE_TASKS ];
+	UBaseType_t ux, uxFree = xBefore.uxObjects - xBefore.uxObjectsInUse;
+
+	for( ux = 0; ux < uxFree; ux++ )
+	{
+		configASSERT( xTaskCreate( prvBlockedTask, "Blocked", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, &( xTasks[ ux ] ) ) == pdPASS );
+	}
+
+	configASSERT( xTaskCreate( prvBlockedTask, "Blocked", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, NULL ) == errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY );
+	configASSERT( prvGetStats( eSlabCacheTask ).ulFailedAllocations == ( xBefore.ulFailedAllocations + 1 ) );
+
+	for( ux = 0; ux < uxFree; ux++ )
+	{
+		vTaskDelete( xTasks[ ux ] );
+	}
+
+	configASSERT( xPortGetFreeHeapSize() == xFreeBefore );
+#endif /* configSLAB_CACHE_GROW_OBJECTS */
+}
+/*-----------------------------------------------------------*/
+
+/* A queue whose storage cannot be allocated from the heap returns its
+structure to the cache, where the next queue finds it. */
+static void prvTestStorageFailure( void )
+{
+const size_t xFreeBefore = xPortGetFreeHeapSize();
+SlabCacheStats_t xBefore, xAfter;
+SemaphoreHandle_t xSemaphore;
+QueueHandle_t xQueue;
+void *pvFirstFree;
+
+	/* Deleting a semaphore puts its structure at the head of the free
+	list. */
+	xSemaphore = xSemaphoreCreateBinary();
+	configASSERT( xSemaphore );
+	pvFirstFree = xSemaphore;
+	vSemaphoreDelete( xSemaphore );
+
+	xBefore = prvGetStats( eSlabCacheQueue );
+	configASSERT( xQueueCreate( 1, ( UBaseType_t ) ( xFreeBefore + 64 ) ) == NULL );
+	xAfter = prvGetStats( eSlabCacheQueue );
+
+	/* The structure was allocated, then freed when the storage could not
+	be. */
+	configASSERT( xAfter.uxObjectsInUse == xBefore.uxObjectsInUse );
+	configASSERT( xAfter.ulAllocations == ( xBefore.ulAllocations + 1 ) );
+	configASSERT( xAfter.ulFailedAllocations == xBefore.ulFailedAllocations );
+	configASSERT( xAfter.uxObjects == xBefore.uxObjects );
+	configASSERT( xPortGetFreeHeapSize() == xFreeBefore );
+
+	xQueue = xQueueCreate( testQUEUE_LENGTH, testQUEUE_ITEM_SIZE );
+	configASSERT( xQueue == pvFirstFree );
+	vQueueDelete( xQueue );
+
+	/* A task whose stack cannot be allocated never takes a TCB. */
+	xBefore = prvGetStats( eSlabCacheTask );
+	configASSERT( xTaskCreate( prvBlockedTask, "Blocked", ( configSTACK_DEPTH_TYPE ) ~0U, NULL, tskIDLE_PRIORITY + 1, NULL ) == errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY );
+	xAfter = prvGetStats( eSlabCacheTask );
+	configASSERT( xAfter.ulAllocations == xBefore.ulAllocations );
+	configASSERT( xAfter.uxObjectsInUse == xBefore.uxObjectsInUse );
+
+	configASSERT( xPortGetFreeHeapSize() == xFreeBefore );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+SlabCacheStats_t xFirstRound[ slabNUMBER_OF_CACHES ], xStats;
+size_t xFreeAfterFirstRound = 0;
+UBaseType_t uxRound, uxCache;
+
+	for( uxRound = 0; uxRound < 8; uxRound++ )
+	{
+		prvTestReuse();
+		prvTestGrowth();
+		prvTestTaskCacheEmpty();
+		prvTestStorageFailure();
+
+		/* The caches grow in the first round, and never again. */
+		for( uxCache = 0; uxCache < slabNUMBER_OF_CACHES; uxCache++ )
+		{
+			xStats = prvGetStats( ( eSlabCache ) uxCache );
+
+			if( uxRound == 0 )
+			{
+				xFirstRound[ uxCache ] = xStats;
+			}
+			else
+			{
+				configASSERT( xStats.uxSlabs == xFirstRound[ uxCache ].uxSlabs );
+				configASSERT( xStats.xBytesReserved == xFirstRound[ uxCache ].xBytesReserved );
+				configASSERT( xStats.uxObjectsInUse == xFirstRound[ uxCache ].uxObjectsInUse );
+			}
+
+			#if( configSLAB_CACHE_GROW_OBJECTS == 0 )
+			{
+				configASSERT( xStats.uxSlabs <= 1 );
+			}
+			#endif
+		}
+
+		if( uxRound == 0 )
+		{
+			xFreeAfterFirstRound = xPortGetFreeHeapSize();
+		}
+		else
+		{
+			configASSERT( xPortGetFreeHeapSize() == xFreeAfterFirstRound );
+		}
+
+		printf( "round %u: ok\n", ( unsigned ) uxRound );
+	}
+
+	printf( "PASS\n" );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,220 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * Tests the stream buffer trigger hold-off.  A reader blocked on an empty
+ * buffer with a trigger level above the data written must be unblocked when
+ * the hold-off expires, counted from the first write, whether that write is
+ * made by a task or an interrupt.  Reaching the trigger level before then
+ * must unblock it at once, and must not leave a hold-off that unblocks it
+ * again later.  xStreamBufferReset() must keep the hold-off.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+
+#define testBUFFER_SIZE		( 64 )
+#define testTRIGGER_LEVEL	( 16 )
+#define testHOLD_OFF_TICKS	( ( TickType_t ) 5 )
+#define testFIRST_BYTES		( 4 )
+
+/* Long enough that a reader unblocked by its block time is obviously not
+unblocked by the hold-off. */
+#define testREADER_BLOCK_TIME	( ( TickType_t ) 50 )
+
+static StreamBufferHandle_t xStreamBuffer;
+static TaskHandle_t xControl, xReader;
+static volatile TickType_t xWakeTick;
+static volatile size_t xReceived;
+static uint8_t ucData[ testBUFFER_SIZE ];
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+/* Each time it is notified, receives once and reports when it was unblocked
+and how many bytes it received. */
+static void prvReaderTask( void *pvParameters )
+{
+uint8_t ucReceived[ testBUFFER_SIZE ];
+
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		xReceived = xStreamBufferReceive( xStreamBuffer, ucReceived, sizeof( ucReceived ), testREADER_BLOCK_TIME );
+		xWakeTick = xTaskGetTickCount();
+		xTaskNotifyGive( xControl );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSendFromISR( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	configASSERT( xStreamBufferSendFromISR( xStreamBuffer, ucData, testFIRST_BYTES, &xHigherPriorityTaskWoken ) == testFIRST_BYTES );
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+/* Has the reader block on the empty buffer. */
+static void prvReaderBlocks( void )
+{
+	configASSERT( xStreamBufferIsEmpty( xStreamBuffer ) != pdFALSE );
+	xTaskNotifyGive( xReader );
+	vTaskDelay( 1 );
+	configASSERT( eTaskGetState( xReader ) == eBlocked );
+}
+/*-----------------------------------------------------------*/
+
+/* Waits for the reader, then checks it was unblocked xTicks after xStart with
+xBytes bytes. */
+static void prvCheckReader( TickType_t xStart, TickType_t xTicks, size_t xBytes )
+{
+	configASSERT( ulTaskNotifyTake( pdTRUE, testREADER_BLOCK_TIME * 2 ) == 1 );
+	configASSERT( ( xWakeTick - xStart ) == xTicks );
+	configASSERT( xReceived == xBytes );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestHoldOffExpires( void )
+{
+TickType_t xStart;
+
+	prvReaderBlocks();
+	xStart = xTaskGetTickCount();
+	configASSERT( xStreamBufferSend( xStreamBuffer, ucData, testFIRST_BYTES, 0 ) == testFIRST_BYTES );
+
+	/* A later write below the trigger level does not restart the hold-off. */
+	vTaskDelay( 2 );
+	configASSERT( xStreamBufferSend( xStreamBuffer, ucData, testFIRST_BYTES, 0 ) == testFIRST_BYTES );
+	prvCheckReader( xStart, testHOLD_OFF_TICKS, testFIRST_BYTES * 2 );
+
+	printf( "hold-off expires: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestHoldOffFromISR( void )
+{
+TickType_t xStart;
+
+	prvReaderBlocks();
+	xStart = xTaskGetTickCount();
+	vPortSimulateInterrupt( prvSendFromISR );
+	prvCheckReader( xStart, testHOLD_OFF_TICKS, testFIRST_BYTES );
+
+	printf( "hold-off started from an interrupt: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestTriggerFirst( void )
+{
+TickType_t xStart;
+
+	prvReaderBlocks();
+	configASSERT( xStreamBufferSend( xStreamBuffer, ucData, testFIRST_BYTES, 0 ) == testFIRST_BYTES );
+	vTaskDelay( 1 );
+	xStart = xTaskGetTickCount();
+	configASSERT( xStreamBufferSend( xStreamBuffer, ucData, testTRIGGER_LEVEL - testFIRST_BYTES, 0 ) == testTRIGGER_LEVEL - testFIRST_BYTES );
+	prvCheckReader( xStart, 0, testTRIGGER_LEVEL );
+
+	/* Blocked again on the empty buffer, the reader must wait for new data
+	rather than being unblocked by what is left of the earlier hold-off. */
+	prvReaderBlocks();
+	vTaskDelay( testHOLD_OFF_TICKS * 2 );
+	configASSERT( eTaskGetState( xReader ) == eBlocked );
+	xStart = xTaskGetTickCount();
+	configASSERT( xStreamBufferSend( xStreamBuffer, ucData, testTRIGGER_LEVEL, 0 ) == testTRIGGER_LEVEL );
+	prvCheckReader( xStart, 0, testTRIGGER_LEVEL );
+
+	printf( "trigger level before the hold-off: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestReset( void )
+{
+TickType_t xStart;
+
+	configASSERT( xStreamBufferSend( xStreamBuffer, ucData, testFIRST_BYTES, 0 ) == testFIRST_BYTES );
+	configASSERT( xStreamBufferReset( xStreamBuffer ) == pdPASS );
+
+	prvReaderBlocks();
+	xStart = xTaskGetTickCount();
+	configASSERT( xStreamBufferSend( xStreamBuffer, ucData, testFIRST_BYTES, 0 ) == testFIRST_BYTES );
+	prvCheckReader( xStart, testHOLD_OFF_TICKS, testFIRST_BYTES );
+
+	/* Without a hold-off the reader waits for its own block time. */
+	configASSERT( xStreamBufferSetTriggerHoldOff( xStreamBuffer, 0 ) == pdPASS );
+	prvReaderBlocks();
+	xStart = xTaskGetTickCount();
+	configASSERT( xStreamBufferSend( xStreamBuffer, ucData, testFIRST_BYTES, 0 ) == testFIRST_BYTES );
+	configASSERT( ulTaskNotifyTake( pdTRUE, testREADER_BLOCK_TIME * 2 ) == 1 );
+	configASSERT( ( xWakeTick - xStart ) > testHOLD_OFF_TICKS );
+	configASSERT( xReceived == testFIRST_BYTES );
+
+	printf( "hold-off kept across a reset: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+	xStreamBuffer = xStreamBufferCreate( testBUFFER_SIZE, testTRIGGER_LEVEL );
+	configASSERT( xStreamBuffer );
+	configASSERT( xStreamBufferSetTriggerHoldOff( xStreamBuffer, testHOLD_OFF_TICKS ) == pdPASS );
+
+	xTaskCreate( prvReaderTask, "Reader", configMINIMAL_STACK_SIZE, NULL, 2, &xReader );
+	configASSERT( xReader );
+
+	prvTestHoldOffExpires();
+	prvTestHoldOffFromISR();
+	prvTestTriggerFirst();
+	prvTestReset();
+
+	printf( "PASS\n" );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, &xControl );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
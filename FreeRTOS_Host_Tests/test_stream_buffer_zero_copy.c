@@ -0,0 +1,409 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+
+/*
+ * Tests the zero copy stream buffer functions enabled by
+ * configUSE_STREAM_BUFFER_ZERO_COPY.
+ *
+ * A random mix of zero copy and copying writes and reads, each committing or
+ * releasing a random part of what was acquired, is checked against a model
+ * of the buffer, including the two spans returned wherever the free space or
+ * the data wraps around the end of the storage area.  A reader blocked in
+ * xStreamBufferAcquireRead() must be woken by the commit, from a task or an
+ * interrupt, that brings the buffer up to its trigger level and not before,
+ * and a writer blocked in xStreamBufferAcquireWrite() must be woken by a
+ * partial release.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+
+#define testBUFFER_SIZE			( ( size_t ) 32 )
+#define testTRIGGER_LEVEL		( ( size_t ) 8 )
+#define testMODEL_OPERATIONS	( 40000UL )
+
+/* The stream buffer stores one byte more than its size. */
+#define testSTORAGE_SIZE		( testBUFFER_SIZE + 1 )
+
+static StreamBufferHandle_t xStreamBuffer = NULL;
+static uint8_t *pucStorage = NULL;
+
+/* The model: the indexes of the next byte to write and read in the storage
+area, the number of bytes in the buffer, and the values of the next byte to
+write and to read. */
+static size_t xHead = 0, xTail = 0, xUsed = 0;
+static uint8_t ucNextToWrite = 0, ucNextToRead = 0;
+
+/* What the task blocked in an acquire call was given. */
+static volatile size_t xAcquired = 0;
+static TaskHandle_t xControlTask = NULL;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+static uint32_t ulState = 0x2e0c0b7fUL;
+
+	/* xorshift32. */
+	ulState ^= ulState << 13;
+	ulState ^= ulState >> 17;
+	ulState ^= ulState << 5;
+	return ulState;
+}
+/*-----------------------------------------------------------*/
+
+/* The spans must describe xCount bytes starting at xIndex, the second span
+only being used if they wrap around the end of the storage area. */
+static void prvCheckSpans( const StreamBufferSpan_t pxSpans[ 2 ], size_t xIndex, size_t xCount )
+{
+const size_t xFirstLength = configMIN( testSTORAGE_SIZE - xIndex, xCount );
+
+	configASSERT( pxSpans[ 0 ].xLength == xFirstLength );
+	configASSERT( pxSpans[ 0 ].pucData == ( ( xFirstLength > 0 ) ? &( pucStorage[ xIndex ] ) : NULL ) );
+	configASSERT( pxSpans[ 1 ].xLength == ( xCount - xFirstLength ) );
+	configASSERT( pxSpans[ 1 ].pucData == ( ( xCount > xFirstLength ) ? pucStorage : NULL ) );
+}
+/*-----------------------------------------------------------*/
+
+static uint8_t *prvSpanByte( const StreamBufferSpan_t pxSpans[ 2 ], size_t xOffset )
+{
+	if( xOffset < pxSpans[ 0 ].xLength )
+	{
+		return &( pxSpans[ 0 ].pucData[ xOffset ] );
+	}
+
+	return &( pxSpans[ 1 ].pucData[ xOffset - pxSpans[ 0 ].xLength ] );
+}
+/*-----------------------------------------------------------*/
+
+static void prvZeroCopyWrite( void )
+{
+StreamBufferSpan_t xSpans[ 2 ];
+size_t xSpace, xCommit, x;
+
+	xSpace = xStreamBufferAcquireWrite( xStreamBuffer, xSpans, 0 );
+	configASSERT( xSpace == ( testBUFFER_SIZE - xUsed ) );
+	prvCheckSpans( xSpans, xHead, xSpace );
+
+	/* Commit part of the space, which may end in either span. */
+	xCommit = prvRand() % ( xSpace + 1 );
+
+	for( x = 0; x < xCommit; x++ )
+	{
+		*prvSpanByte( xSpans, x ) = ucNextToWrite++;
+	}
+
+	vStreamBufferCommitWrite( xStreamBuffer, xCommit );
+	xHead = ( xHead + xCommit ) % testSTORAGE_SIZE;
+	xUsed += xCommit;
+}
+/*-----------------------------------------------------------*/
+
+static void prvZeroCopyRead( void )
+{
+StreamBufferSpan_t xSpans[ 2 ];
+size_t xAvailable, xRelease, x;
+uint8_t ucExpected = ucNextToRead;
+
+	xAvailable = xStreamBufferAcquireRead( xStreamBuffer, xSpans, 0 );
+	configASSERT( xAvailable == xUsed );
+	prvCheckSpans( xSpans, xTail, xAvailable );
+
+	/* All the data is visible, in order, across the two spans. */
+	for( x = 0; x < xAvailable; x++ )
+	{
+		configASSERT( *prvSpanByte( xSpans, x ) == ucExpected++ );
+	}
+
+	/* Release part of it.  The rest is returned again by the next acquire
+	call. */
+	xRelease = prvRand() % ( xAvailable + 1 );
+	vStreamBufferReleaseRead( xStreamBuffer, xRelease );
+	ucNextToRead += ( uint8_t ) xRelease;
+	xTail = ( xTail + xRelease ) % testSTORAGE_SIZE;
+	xUsed -= xRelease;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyingWrite( void )
+{
+uint8_t ucData[ testBUFFER_SIZE ];
+size_t xLength = 1 + ( prvRand() % testBUFFER_SIZE ), xSent, x;
+
+	for( x = 0; x < xLength; x++ )
+	{
+		ucData[ x ] = ( uint8_t ) ( ucNextToWrite + x );
+	}
+
+	xSent = xStreamBufferSend( xStreamBuffer, ucData, xLength, 0 );
+	configASSERT( xSent == configMIN( xLength, testBUFFER_SIZE - xUsed ) );
+	ucNextToWrite += ( uint8_t ) xSent;
+	xHead = ( xHead + xSent ) % testSTORAGE_SIZE;
+	xUsed += xSent;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyingRead( void )
+{
+uint8_t ucData[ testBUFFER_SIZE ];
+size_t xLength = 1 + ( prvRand() % testBUFFER_SIZE ), xReceived, x;
+
+	xReceived = xStreamBufferReceive( xStreamBuffer, ucData, xLength, 0 );
+	configASSERT( xReceived == configMIN( xLength, xUsed ) );
+
+	for( x = 0; x < xReceived; x++ )
+	{
+		configASSERT( ucData[ x ] == ucNextToRead++ );
+	}
+
+	xTail = ( xTail + xReceived ) % testSTORAGE_SIZE;
+	xUsed -= xReceived;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestAgainstModel( void )
+{
+StreamBufferSpan_t xSpans[ 2 ];
+uint32_t ul, ulWrapped = 0;
+
+	xStreamBuffer = xStreamBufferCreate( testBUFFER_SIZE, 1 );
+	configASSERT( xStreamBuffer );
+
+	/* The free space of a new buffer starts at the beginning of its storage
+	area. */
+	configASSERT( xStreamBufferAcquireWrite( xStreamBuffer, xSpans, 0 ) == testBUFFER_SIZE );
+	configASSERT( xSpans[ 1 ].xLength == 0 );
+	pucStorage = xSpans[ 0 ].pucData;
+	xHead = xTail = xUsed = 0;
+	ucNextToRead = ucNextToWrite;
+
+	for( ul = 0; ul < testMODEL_OPERATIONS; ul++ )
+	{
+		switch( prvRand() % 4 )
+		{
+			case 0: prvZeroCopyWrite(); break;
+			case 1: prvZeroCopyRead(); break;
+			case 2: prvCopyingWrite(); break;
+			default: prvCopyingRead(); break;
+		}
+
+		configASSERT( xStreamBufferBytesAvailable( xStreamBuffer ) == xUsed );
+		configASSERT( xStreamBufferSpacesAvailable( xStreamBuffer ) == ( testBUFFER_SIZE - xUsed ) );
+
+		if( ( xTail + xUsed ) > testSTORAGE_SIZE )
+		{
+			ulWrapped++;
+		}
+	}
+
+	/* The data wrapped often enough for both spans to have been tested. */
+	configASSERT( ulWrapped > ( testMODEL_OPERATIONS / 8 ) );
+
+	vStreamBufferDelete( xStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvReaderTask( void *pvParameters )
+{
+StreamBufferSpan_t xSpans[ 2 ];
+size_t xAvailable;
+
+	for( ;; )
+	{
+		xAvailable = xStreamBufferAcquireRead( xStreamBuffer, xSpans, portMAX_DELAY );
+		vStreamBufferReleaseRead( xStreamBuffer, xAvailable );
+		xAcquired = xAvailable;
+		xTaskNotifyGive( xControlTask );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvWriterTask( void *pvParameters )
+{
+StreamBufferSpan_t xSpans[ 2 ];
+
+	for( ;; )
+	{
+		( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		xAcquired = xStreamBufferAcquireWrite( xStreamBuffer, xSpans, portMAX_DELAY );
+		vStreamBufferCommitWrite( xStreamBuffer, 0 );
+		xTaskNotifyGive( xControlTask );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static size_t xISRCommitBytes = 0;
+static BaseType_t xISRWokeTask = pdFALSE;
+
+static BaseType_t prvCommitFromISR( void )
+{
+StreamBufferSpan_t xSpans[ 2 ];
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	configASSERT( xStreamBufferAcquireWriteFromISR( xStreamBuffer, xSpans ) >= xISRCommitBytes );
+	vStreamBufferCommitWriteFromISR( xStreamBuffer, xISRCommitBytes, &xHigherPriorityTaskWoken );
+	xISRWokeTask = xHigherPriorityTaskWoken;
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+/* Commits xBytes, from a task or an interrupt, and returns whether the reader
+ran as a result.  The reader has a higher priority than this task, so runs
+as soon as it is unblocked. */
+static BaseType_t prvCommit( size_t xBytes, BaseType_t xFromISR )
+{
+StreamBufferSpan_t xSpans[ 2 ];
+
+	xAcquired = 0;
+
+	if( xFromISR != pdFALSE )
+	{
+		xISRCommitBytes = xBytes;
+		vPortSimulateInterrupt( prvCommitFromISR );
+		configASSERT( xISRWokeTask == ( ( xAcquired != 0 ) ? pdTRUE : pdFALSE ) );
+	}
+	else
+	{
+		configASSERT( xStreamBufferAcquireWrite( xStreamBuffer, xSpans, 0 ) >= xBytes );
+		vStreamBufferCommitWrite( xStreamBuffer, xBytes );
+	}
+
+	return ( xAcquired != 0 ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestWakeOnCommit( void )
+{
+TaskHandle_t xReader;
+BaseType_t xFromISR;
+
+	xStreamBuffer = xStreamBufferCreate( testBUFFER_SIZE, testTRIGGER_LEVEL );
+	configASSERT( xStreamBuffer );
+	xTaskCreate( prvReaderTask, "Reader", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, &xReader );
+
+	for( xFromISR = pdFALSE; xFromISR <= pdTRUE; xFromISR++ )
+	{
+		/* Committing less than the trigger level, in parts, leaves the reader
+		blocked.  The commit that reaches it wakes the reader, which is given
+		everything committed. */
+		configASSERT( eTaskGetState( xReader ) == eBlocked );
+		configASSERT( prvCommit( testTRIGGER_LEVEL - 3, xFromISR ) == pdFALSE );
+		configASSERT( prvCommit( 0, xFromISR ) == pdFALSE );
+		configASSERT( prvCommit( 2, xFromISR ) == pdFALSE );
+		configASSERT( eTaskGetState( xReader ) == eBlocked );
+		configASSERT( prvCommit( 1, xFromISR ) == pdTRUE );
+		configASSERT( xAcquired == testTRIGGER_LEVEL );
+		( void ) ulTaskNotifyTake( pdTRUE, 0 );
+
+		/* Committing more than the trigger level at once wakes it too. */
+		configASSERT( prvCommit( testBUFFER_SIZE, xFromISR ) == pdTRUE );
+		configASSERT( xAcquired == testBUFFER_SIZE );
+		( void ) ulTaskNotifyTake( pdTRUE, 0 );
+	}
+
+	vTaskDelete( xReader );
+	vStreamBufferDelete( xStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestWakeOnRelease( void )
+{
+StreamBufferSpan_t xSpans[ 2 ];
+uint8_t ucData[ testBUFFER_SIZE ] = { 0 };
+TaskHandle_t xWriter;
+
+	xStreamBuffer = xStreamBufferCreate( testBUFFER_SIZE, 1 );
+	configASSERT( xStreamBuffer );
+	xTaskCreate( prvWriterTask, "Writer", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, &xWriter );
+
+	/* The writer blocks in xStreamBufferAcquireWrite() as the buffer is
+	full. */
+	configASSERT( xStreamBufferSend( xStreamBuffer, ucData, testBUFFER_SIZE, 0 ) == testBUFFER_SIZE );
+	xAcquired = 0;
+	xTaskNotifyGive( xWriter );
+	configASSERT( eTaskGetState( xWriter ) == eBlocked );
+
+	/* Releasing nothing leaves it blocked, releasing part of the data wakes
+	it with the space that was released. */
+	configASSERT( xStreamBufferAcquireRead( xStreamBuffer, xSpans, 0 ) == testBUFFER_SIZE );
+	vStreamBufferReleaseRead( xStreamBuffer, 0 );
+	configASSERT( xAcquired == 0 );
+	configASSERT( xStreamBufferAcquireRead( xStreamBuffer, xSpans, 0 ) == testBUFFER_SIZE );
+	vStreamBufferReleaseRead( xStreamBuffer, 5 );
+	configASSERT( xAcquired == 5 );
+	( void ) ulTaskNotifyTake( pdTRUE, 0 );
+
+	vTaskDelete( xWriter );
+	vStreamBufferDelete( xStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+const size_t xFreeBefore = xPortGetFreeHeapSize();
+UBaseType_t uxRound;
+
+	for( uxRound = 0; uxRound < 4; uxRound++ )
+	{
+		prvTestAgainstModel();
+		prvTestWakeOnCommit();
+		prvTestWakeOnRelease();
+		printf( "round %u: ok\n", ( unsigned ) uxRound );
+	}
+
+	configASSERT( xPortGetFreeHeapSize() == xFreeBefore );
+
+	printf( "PASS\n" );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	/* The tasks that block in the acquire calls run at a higher priority, so
+	they run as soon as they are unblocked. */
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 2, &xControlTask );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
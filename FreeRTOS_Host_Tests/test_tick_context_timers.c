@@ -0,0 +1,258 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Tests tick context timers, in particular commands that arrive from an
+ * interrupt while the tick interrupt is processing the expiry of the timer
+ * they act on.  Such an interrupt is simulated from the traceTIMER_EXPIRED()
+ * point, which is reached after the expiry has been claimed and before the
+ * callback executes.
+ *
+ * A command that arrives then must take effect: a reset or restart must not
+ * be overwritten by the reload or stop of the expiry, and a stop must leave
+ * the timer stopped.  The expiry has already happened, so its callback still
+ * executes.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#define testPERIOD		( ( TickType_t ) 10 )
+
+/* What the simulated interrupt does to the timer being processed. */
+typedef enum
+{
+	eTestNoAction = 0,
+	eTestReset,
+	eTestStop
+} TestAction_t;
+
+static volatile TestAction_t eAction = eTestNoAction;
+static volatile TickType_t xActOnlyAfter = 0;
+static TimerHandle_t xActedOn = NULL;
+static TickType_t xActionTime = 0;
+
+static volatile uint32_t ulCallbacks[ 2 ] = { 0 };
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+	ulCallbacks[ ( uintptr_t ) pvTimerGetTimerID( xTimer ) ]++;
+}
+/*-----------------------------------------------------------*/
+
+static TimerHandle_t xTimerToCommand;
+
+static BaseType_t prvCommandFromISR( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	if( eAction == eTestReset )
+	{
+		configASSERT( xTimerResetFromISR( xTimerToCommand, &xHigherPriorityTaskWoken ) == pdPASS );
+	}
+	else
+	{
+		configASSERT( xTimerStopFromISR( xTimerToCommand, &xHigherPriorityTaskWoken ) == pdPASS );
+	}
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+void vTestTraceTimerExpired( void *pvTimer )
+{
+TickType_t xNow = xTaskGetTickCountFromISR();
+
+	/* Act once, on the first expiry processed after xActOnlyAfter. */
+	if( ( eAction != eTestNoAction ) && ( xNow > xActOnlyAfter ) )
+	{
+		xTimerToCommand = ( TimerHandle_t ) pvTimer;
+		vPortSimulateInterrupt( prvCommandFromISR );
+
+		xActedOn = xTimerToCommand;
+		xActionTime = xNow;
+		eAction = eTestNoAction;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvReset( TimerHandle_t *pxTimers, UBaseType_t uxNumber )
+{
+UBaseType_t ux;
+
+	for( ux = 0; ux < uxNumber; ux++ )
+	{
+		xTimerDelete( pxTimers[ ux ], 0 );
+	}
+
+	ulCallbacks[ 0 ] = ulCallbacks[ 1 ] = 0;
+	xActedOn = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestExpiry( void )
+{
+TimerHandle_t xTimers[ 2 ];
+
+	xTimers[ 0 ] = xTimerCreateTickContext( "OneShot", testPERIOD, pdFALSE, ( void * ) 0, prvTimerCallback );
+	xTimers[ 1 ] = xTimerCreateTickContext( "Reload", testPERIOD, pdTRUE, ( void * ) 1, prvTimerCallback );
+	configASSERT( xTimers[ 0 ] && xTimers[ 1 ] );
+
+	xTimerStart( xTimers[ 0 ], 0 );
+	xTimerStart( xTimers[ 1 ], 0 );
+	vTaskDelay( ( testPERIOD * 3 ) + ( testPERIOD / 2 ) );
+
+	configASSERT( ulCallbacks[ 0 ] == 1 );
+	configASSERT( ulCallbacks[ 1 ] == 3 );
+	configASSERT( xTimerIsTimerActive( xTimers[ 0 ] ) == pdFALSE );
+	configASSERT( xTimerIsTimerActive( xTimers[ 1 ] ) != pdFALSE );
+
+	prvReset( xTimers, 2 );
+	printf( "expiry: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestRestartOneShot( void )
+{
+TimerHandle_t xTimer;
+
+	xTimer = xTimerCreateTickContext( "OneShot", testPERIOD, pdFALSE, ( void * ) 0, prvTimerCallback );
+	configASSERT( xTimer );
+
+	/* Restarted from an interrupt as it expires, so it must still be running
+	afterwards, and expire again one period later. */
+	xActOnlyAfter = 0;
+	eAction = eTestReset;
+	xTimerStart( xTimer, 0 );
+	vTaskDelay( testPERIOD + 1 );
+
+	configASSERT( xActedOn == xTimer );
+	configASSERT( ulCallbacks[ 0 ] == 1 );
+	configASSERT( xTimerIsTimerActive( xTimer ) != pdFALSE );
+	configASSERT( xTimerGetExpiryTime( xTimer ) == ( xActionTime + testPERIOD ) );
+
+	vTaskDelay( testPERIOD );
+	configASSERT( ulCallbacks[ 0 ] == 2 );
+	configASSERT( xTimerIsTimerActive( xTimer ) == pdFALSE );
+
+	prvReset( &xTimer, 1 );
+	printf( "one-shot restarted as it expires: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestResetLateAutoReload( void )
+{
+TimerHandle_t xTimers[ 2 ];
+TickType_t xStartTime;
+
+	/* With configTICK_CONTEXT_TIMER_BUDGET set to 1 only one of two timers
+	that expire together is processed on time, the other one tick late.  Its
+	reload is then relative to its expiry time, so differs from a reset
+	relative to the current time, which is the one that must be kept. */
+	xTimers[ 0 ] = xTimerCreateTickContext( "Reload0", testPERIOD, pdTRUE, ( void * ) 0, prvTimerCallback );
+	xTimers[ 1 ] = xTimerCreateTickContext( "Reload1", testPERIOD, pdTRUE, ( void * ) 1, prvTimerCallback );
+	configASSERT( xTimers[ 0 ] && xTimers[ 1 ] );
+
+	vTaskSuspendAll();
+	{
+		xStartTime = xTaskGetTickCount();
+		xTimerStart( xTimers[ 0 ], 0 );
+		xTimerStart( xTimers[ 1 ], 0 );
+	}
+	xTaskResumeAll();
+
+	xActOnlyAfter = xStartTime + testPERIOD;
+	eAction = eTestReset;
+	vTaskDelay( testPERIOD + 2 );
+
+	configASSERT( xActedOn != NULL );
+	configASSERT( xActionTime == ( xStartTime + testPERIOD + 1 ) );
+	configASSERT( xTimerGetExpiryTime( xActedOn ) == ( xActionTime + testPERIOD ) );
+	configASSERT( ( ulCallbacks[ 0 ] == 1 ) && ( ulCallbacks[ 1 ] == 1 ) );
+
+	prvReset( xTimers, 2 );
+	printf( "late auto-reload reset as it expires: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestStopAutoReload( void )
+{
+TimerHandle_t xTimer;
+
+	xTimer = xTimerCreateTickContext( "Reload", testPERIOD, pdTRUE, ( void * ) 1, prvTimerCallback );
+	configASSERT( xTimer );
+
+	/* Stopped from an interrupt as it expires.  The callback for the expiry
+	executes, but the timer must not expire again. */
+	xActOnlyAfter = 0;
+	eAction = eTestStop;
+	xTimerStart( xTimer, 0 );
+	vTaskDelay( testPERIOD * 3 );
+
+	configASSERT( xActedOn == xTimer );
+	configASSERT( ulCallbacks[ 1 ] == 1 );
+	configASSERT( xTimerIsTimerActive( xTimer ) == pdFALSE );
+
+	prvReset( &xTimer, 1 );
+	printf( "auto-reload stopped as it expires: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+	prvTestExpiry();
+	prvTestRestartOneShot();
+	prvTestResetLateAutoReload();
+	prvTestStopAutoReload();
+
+	printf( "PASS\n" );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
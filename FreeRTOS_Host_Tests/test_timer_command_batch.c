@@ -0,0 +1,394 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Tests xTimerSendCommandBatch() and xTimerSendCommandBatchFromISR().  The
+ * array of commands is copied into a batch slot, so it can be changed as soon
+ * as the send returns, a task can wait for a free slot, and a batch that is
+ * not sent returns its slot.  A random model then checks that timers started
+ * by batches, which are merged into the active timers in one pass, expire at
+ * exactly the expected tick, including across the tick count overflowing.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#define testTIMERS			( 3 )
+#define testMODEL_TIMERS	( 16 )
+#define testMODEL_BATCHES	( 400 )
+
+static TimerHandle_t xTimers[ testTIMERS ];
+static TimerBatchCommand_t xCommands[ testTIMERS ];
+
+/* The model of the timers used by the random test. */
+static TimerHandle_t xModelTimers[ testMODEL_TIMERS ];
+static TickType_t xModelExpiry[ testMODEL_TIMERS ];
+static BaseType_t xModelActive[ testMODEL_TIMERS ];
+static uint32_t ulModelExpired = 0;
+
+/* The order in which timers with the same expiry time expired. */
+static UBaseType_t uxOrder[ testTIMERS + 1 ];
+static UBaseType_t uxOrderCount = 0;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+static uint32_t ulState = 0x5eed0411UL;
+
+	/* xorshift32. */
+	ulState ^= ulState << 13;
+	ulState ^= ulState >> 17;
+	ulState ^= ulState << 5;
+	return ulState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+	if( uxOrderCount < ( UBaseType_t ) ( testTIMERS + 1 ) )
+	{
+		uxOrder[ uxOrderCount ] = ( UBaseType_t ) pvTimerGetTimerID( xTimer );
+		uxOrderCount++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvModelCallback( TimerHandle_t xTimer )
+{
+UBaseType_t ux = ( UBaseType_t ) pvTimerGetTimerID( xTimer );
+
+	/* Each timer expires at exactly its expected tick, which is only the case
+	if the active timers are still in expiry time order. */
+	configASSERT( xModelActive[ ux ] != pdFALSE );
+	configASSERT( xTaskGetTickCount() == xModelExpiry[ ux ] );
+	xModelActive[ ux ] = pdFALSE;
+	ulModelExpired++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvFillCommands( BaseType_t xCommandID, TickType_t xNewPeriod )
+{
+UBaseType_t ux;
+
+	for( ux = 0; ux < testTIMERS; ux++ )
+	{
+		xCommands[ ux ].xTimer = xTimers[ ux ];
+		xCommands[ ux ].xCommandID = xCommandID;
+		xCommands[ ux ].xNewPeriod = xNewPeriod;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckActive( BaseType_t xActive )
+{
+UBaseType_t ux;
+
+	for( ux = 0; ux < testTIMERS; ux++ )
+	{
+		configASSERT( ( xTimerIsTimerActive( xTimers[ ux ] ) != pdFALSE ) == ( xActive != pdFALSE ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSendFromISR( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	configASSERT( xTimerSendCommandBatchFromISR( xCommands, testTIMERS, &xHigherPriorityTaskWoken ) == pdPASS );
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSendFromISRWithoutSlot( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	configASSERT( xTimerSendCommandBatchFromISR( xCommands, testTIMERS, &xHigherPriorityTaskWoken ) == pdFAIL );
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestCopy( void )
+{
+UBaseType_t ux;
+
+	/* This task has a higher priority than the timer service task, so the
+	batch is not applied until this task blocks.  The array is overwritten
+	straight away, which must not change the batch that was sent. */
+	prvFillCommands( tmrCOMMAND_START, 0 );
+	configASSERT( xTimerSendCommandBatch( xCommands, testTIMERS, 0 ) == pdPASS );
+	prvFillCommands( tmrCOMMAND_STOP, 0 );
+	prvCheckActive( pdFALSE );
+
+	vTaskDelay( 1 );
+	prvCheckActive( pdTRUE );
+	printf( "batch from a task: ok\n" );
+
+	/* The same from an interrupt. */
+	prvFillCommands( tmrCOMMAND_CHANGE_PERIOD, 50 );
+	vPortSimulateInterrupt( prvSendFromISR );
+	prvFillCommands( tmrCOMMAND_CHANGE_PERIOD, 70 );
+
+	vTaskDelay( 1 );
+	prvCheckActive( pdTRUE );
+
+	for( ux = 0; ux < testTIMERS; ux++ )
+	{
+		configASSERT( xTimerGetPeriod( xTimers[ ux ] ) == 50 );
+	}
+	printf( "batch from an interrupt: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestSlots( void )
+{
+UBaseType_t ux;
+TickType_t xStart;
+
+	/* Use every slot.  Further batches cannot be sent until the timer service
+	task has applied one, which it cannot do while this task is running. */
+	prvFillCommands( tmrCOMMAND_RESET, 0 );
+
+	for( ux = 0; ux < configTIMER_COMMAND_BATCH_SLOTS; ux++ )
+	{
+		configASSERT( xTimerSendCommandBatch( xCommands, testTIMERS, 0 ) == pdPASS );
+	}
+
+	configASSERT( xTimerSendCommandBatch( xCommands, testTIMERS, 0 ) == pdFAIL );
+	vPortSimulateInterrupt( prvSendFromISRWithoutSlot );
+
+	/* A task that waits for a slot gets one as soon as the timer service task
+	has applied a batch, without a tick passing. */
+	xStart = xTaskGetTickCount();
+	prvFillCommands( tmrCOMMAND_STOP, 0 );
+	configASSERT( xTimerSendCommandBatch( xCommands, testTIMERS, portMAX_DELAY ) == pdPASS );
+	configASSERT( xTaskGetTickCount() == xStart );
+
+	vTaskDelay( 1 );
+	prvCheckActive( pdFALSE );
+	printf( "wait for a batch slot: ok\n" );
+
+	/* A batch that cannot be sent because the timer command queue is full
+	returns its slot. */
+	for( ux = 0; ux < configTIMER_QUEUE_LENGTH; ux++ )
+	{
+		configASSERT( xTimerStop( xTimers[ 0 ], 0 ) == pdPASS );
+	}
+
+	for( ux = 0; ux < configTIMER_COMMAND_BATCH_SLOTS + 2; ux++ )
+	{
+		configASSERT( xTimerSendCommandBatch( xCommands, testTIMERS, 0 ) == pdFAIL );
+	}
+
+	vTaskDelay( 1 );
+	prvFillCommands( tmrCOMMAND_START, 0 );
+
+	for( ux = 0; ux < configTIMER_COMMAND_BATCH_SLOTS; ux++ )
+	{
+		configASSERT( xTimerSendCommandBatch( xCommands, testTIMERS, 0 ) == pdPASS );
+	}
+
+	vTaskDelay( 1 );
+	prvCheckActive( pdTRUE );
+	printf( "batch not sent: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestOrder( void )
+{
+UBaseType_t ux;
+
+	/* A later command in a batch applies to a timer started earlier in the
+	same batch. */
+	xCommands[ 0 ].xTimer = xTimers[ 0 ];
+	xCommands[ 0 ].xCommandID = tmrCOMMAND_START;
+	xCommands[ 1 ].xTimer = xTimers[ 0 ];
+	xCommands[ 1 ].xCommandID = tmrCOMMAND_STOP;
+	xCommands[ 2 ].xTimer = xTimers[ 1 ];
+	xCommands[ 2 ].xCommandID = tmrCOMMAND_STOP;
+	configASSERT( xTimerSendCommandBatch( xCommands, testTIMERS, 0 ) == pdPASS );
+	configASSERT( xTimerStop( xTimers[ 2 ], 0 ) == pdPASS );
+	vTaskDelay( 1 );
+	prvCheckActive( pdFALSE );
+
+	/* Timers that expire at the same time expire in the order they were
+	started, whether they were started singly or in a batch, so the batch
+	timers go after timer 2 that was started first.  The batch itself starts
+	timer 1 before timer 0. */
+	for( ux = 0; ux < testTIMERS; ux++ )
+	{
+		configASSERT( xTimerChangePeriod( xTimers[ ux ], 5, 0 ) == pdPASS );
+		configASSERT( xTimerStop( xTimers[ ux ], 0 ) == pdPASS );
+	}
+
+	vTaskDelay( 1 );
+	uxOrderCount = 0;
+	configASSERT( xTimerStart( xTimers[ 2 ], 0 ) == pdPASS );
+	xCommands[ 0 ].xTimer = xTimers[ 1 ];
+	xCommands[ 0 ].xCommandID = tmrCOMMAND_START;
+	xCommands[ 1 ].xTimer = xTimers[ 0 ];
+	xCommands[ 1 ].xCommandID = tmrCOMMAND_START;
+	configASSERT( xTimerSendCommandBatch( xCommands, 2, 0 ) == pdPASS );
+	vTaskDelay( 10 );
+
+	configASSERT( uxOrderCount >= 3 );
+	configASSERT( ( uxOrder[ 0 ] == 2 ) && ( uxOrder[ 1 ] == 1 ) && ( uxOrder[ 2 ] == 0 ) );
+
+	for( ux = 0; ux < testTIMERS; ux++ )
+	{
+		configASSERT( xTimerStop( xTimers[ ux ], 0 ) == pdPASS );
+	}
+
+	vTaskDelay( 1 );
+	printf( "same expiry time order: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestModel( void )
+{
+TimerBatchCommand_t xBatch[ configTIMER_COMMAND_BATCH_LENGTH ];
+UBaseType_t uxBatch, uxCommands, ux, uxTimer;
+TickType_t xNow, xStartTick;
+uint32_t ulStarted = 0;
+BaseType_t xCrossedZero = pdFALSE;
+
+	xStartTick = xTaskGetTickCount();
+
+	for( uxBatch = 0; uxBatch < testMODEL_BATCHES; uxBatch++ )
+	{
+		uxCommands = ( UBaseType_t ) ( prvRand() % configTIMER_COMMAND_BATCH_LENGTH ) + 1U;
+		xNow = xTaskGetTickCount();
+
+		for( ux = 0; ux < uxCommands; ux++ )
+		{
+			uxTimer = ( UBaseType_t ) ( prvRand() % testMODEL_TIMERS );
+			xBatch[ ux ].xTimer = xModelTimers[ uxTimer ];
+			xBatch[ ux ].xNewPeriod = ( TickType_t ) ( prvRand() % 40 ) + 1U;
+
+			switch( prvRand() % 4 )
+			{
+				case 0 :
+				case 1 :
+					xBatch[ ux ].xCommandID = ( ( prvRand() & 1 ) != 0 ) ? tmrCOMMAND_START : tmrCOMMAND_RESET;
+					xModelExpiry[ uxTimer ] = xNow + xTimerGetPeriod( xModelTimers[ uxTimer ] );
+					xModelActive[ uxTimer ] = pdTRUE;
+					ulStarted++;
+					break;
+
+				case 2 :
+					xBatch[ ux ].xCommandID = tmrCOMMAND_STOP;
+					xModelActive[ uxTimer ] = pdFALSE;
+					break;
+
+				default :
+					/* The period is only updated in the timer once the batch
+					is applied, so a change of period is the last command in
+					a batch for its timer. */
+					xBatch[ ux ].xCommandID = tmrCOMMAND_CHANGE_PERIOD;
+					xModelExpiry[ uxTimer ] = xNow + xBatch[ ux ].xNewPeriod;
+					xModelActive[ uxTimer ] = pdTRUE;
+					ulStarted++;
+					uxCommands = ux + 1U;
+					break;
+			}
+		}
+
+		configASSERT( xTimerSendCommandBatch( xBatch, uxCommands, portMAX_DELAY ) == pdPASS );
+
+		/* The time has not moved, as no tick can pass while this task is
+		ready. */
+		configASSERT( xTaskGetTickCount() == xNow );
+
+		vTaskDelay( ( TickType_t ) ( prvRand() % 4 ) );
+
+		if( xTaskGetTickCount() < xStartTick )
+		{
+			xCrossedZero = pdTRUE;
+		}
+	}
+
+	/* Let every timer that is still active expire. */
+	vTaskDelay( 50 );
+
+	for( ux = 0; ux < testMODEL_TIMERS; ux++ )
+	{
+		configASSERT( xModelActive[ ux ] == pdFALSE );
+	}
+
+	configASSERT( xCrossedZero != pdFALSE );
+	configASSERT( ulModelExpired > ( testMODEL_BATCHES / 8 ) );
+	printf( "model: %u batches, %u starts, %u expiries: ok\n", ( unsigned ) testMODEL_BATCHES, ( unsigned ) ulStarted, ( unsigned ) ulModelExpired );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+	prvTestCopy();
+	prvTestSlots();
+	prvTestOrder();
+	prvTestModel();
+
+	printf( "PASS\n" );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+UBaseType_t ux;
+
+	for( ux = 0; ux < testTIMERS; ux++ )
+	{
+		xTimers[ ux ] = xTimerCreate( "Timer", 100, pdTRUE, ( void * ) ux, prvTimerCallback );
+		configASSERT( xTimers[ ux ] );
+	}
+
+	for( ux = 0; ux < testMODEL_TIMERS; ux++ )
+	{
+		xModelTimers[ ux ] = xTimerCreate( "Model", ( TickType_t ) ( ux + 1U ), pdFALSE, ( void * ) ux, prvModelCallback );
+		configASSERT( xModelTimers[ ux ] );
+	}
+
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,226 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Tests moving timers between timer service tasks with
+ * xTimerSetServiceTask().
+ *
+ * A timer must only be moved when it is not active and no command sent to it
+ * is pending, as the timer service task it is moved from would otherwise
+ * apply the command to its own active timers after the move.  The stress test
+ * starts, stops and moves timers while commands are still queued, and checks
+ * that each callback executes in the timer service task the timer belongs to,
+ * which would fail, or corrupt the active timer lists, if a move were allowed
+ * with a command pending.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#define testTIMERS				( 8 )
+#define testSTRESS_ITERATIONS	( 20000 )
+
+static TimerHandle_t xTimers[ testTIMERS ];
+static volatile uint32_t ulCallbacks[ testTIMERS ] = { 0 };
+static volatile uint32_t ulWrongService = 0;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+UBaseType_t uxIndex = ( UBaseType_t ) pvTimerGetTimerID( xTimer );
+
+	if( xTaskGetCurrentTaskHandle() != xTimerGetTimerServiceTaskHandle( uxTimerGetServiceTask( xTimer ) ) )
+	{
+		ulWrongService++;
+	}
+
+	ulCallbacks[ uxIndex ]++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestPendingCommands( void )
+{
+TimerHandle_t xTimer = xTimers[ 0 ];
+TimerBatchCommand_t xBatch[ 1 ];
+
+	/* Nothing is pending straight after creation. */
+	configASSERT( xTimerSetServiceTask( xTimer, 1 ) == pdPASS );
+	configASSERT( uxTimerGetServiceTask( xTimer ) == 1 );
+	configASSERT( xTimerSetServiceTask( xTimer, 0 ) == pdPASS );
+
+	/* This task has a higher priority than the timer service tasks, so the
+	start command is still in the queue of timer service task 0. */
+	xTimerStart( xTimer, 0 );
+	configASSERT( xTimerSetServiceTask( xTimer, 1 ) == pdFAIL );
+	configASSERT( uxTimerGetServiceTask( xTimer ) == 0 );
+
+	/* Once processed the timer is active, so still cannot be moved. */
+	vTaskDelay( 1 );
+	configASSERT( xTimerIsTimerActive( xTimer ) != pdFALSE );
+	configASSERT( xTimerSetServiceTask( xTimer, 1 ) == pdFAIL );
+
+	/* Not while the stop command is pending either. */
+	xTimerStop( xTimer, 0 );
+	configASSERT( xTimerSetServiceTask( xTimer, 1 ) == pdFAIL );
+	vTaskDelay( 1 );
+	configASSERT( xTimerSetServiceTask( xTimer, 1 ) == pdPASS );
+
+	/* A batch counts as a command pending for each of its timers. */
+	xBatch[ 0 ].xTimer = xTimer;
+	xBatch[ 0 ].xCommandID = tmrCOMMAND_STOP;
+	xBatch[ 0 ].xNewPeriod = 0;
+	configASSERT( xTimerSendCommandBatch( xBatch, 1, 0 ) == pdPASS );
+	configASSERT( xTimerSetServiceTask( xTimer, 0 ) == pdFAIL );
+	vTaskDelay( 1 );
+	configASSERT( xTimerSetServiceTask( xTimer, 0 ) == pdPASS );
+
+	/* After a move the callback executes in the new timer service task. */
+	configASSERT( xTimerSetServiceTask( xTimer, 1 ) == pdPASS );
+	xTimerStart( xTimer, 0 );
+	vTaskDelay( xTimerGetPeriod( xTimer ) + 1 );
+	configASSERT( ulCallbacks[ 0 ] == 1 );
+	configASSERT( ulWrongService == 0 );
+
+	printf( "pending commands: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+static uint32_t ulState = 0x12345678UL;
+
+	/* xorshift32. */
+	ulState ^= ulState << 13;
+	ulState ^= ulState >> 17;
+	ulState ^= ulState << 5;
+	return ulState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestStress( void )
+{
+uint32_t ulIteration, ulMoves = 0, ulRefused = 0, ulTotal = 0;
+UBaseType_t uxIndex;
+TimerHandle_t xTimer;
+
+	for( ulIteration = 0; ulIteration < testSTRESS_ITERATIONS; ulIteration++ )
+	{
+		xTimer = xTimers[ prvRand() % testTIMERS ];
+
+		switch( prvRand() % 5 )
+		{
+			case 0 :
+			case 1 :
+				xTimerStart( xTimer, portMAX_DELAY );
+				break;
+
+			case 2 :
+				xTimerStop( xTimer, portMAX_DELAY );
+				break;
+
+			case 3 :
+				if( xTimerSetServiceTask( xTimer, prvRand() % configTIMER_SERVICE_TASKS ) == pdPASS )
+				{
+					ulMoves++;
+				}
+				else
+				{
+					ulRefused++;
+				}
+				break;
+
+			default :
+				vTaskDelay( prvRand() % 3 );
+				break;
+		}
+	}
+
+	for( uxIndex = 0; uxIndex < testTIMERS; uxIndex++ )
+	{
+		xTimerStop( xTimers[ uxIndex ], portMAX_DELAY );
+	}
+
+	vTaskDelay( 10 );
+
+	for( uxIndex = 0; uxIndex < testTIMERS; uxIndex++ )
+	{
+		configASSERT( xTimerIsTimerActive( xTimers[ uxIndex ] ) == pdFALSE );
+		configASSERT( xTimerSetServiceTask( xTimers[ uxIndex ], 0 ) == pdPASS );
+		ulTotal += ulCallbacks[ uxIndex ];
+	}
+
+	configASSERT( ulWrongService == 0 );
+	configASSERT( ( ulMoves > 0 ) && ( ulRefused > 0 ) && ( ulTotal > 0 ) );
+
+	printf( "stress: %u moves, %u refused, %u callbacks: ok\n", ( unsigned ) ulMoves, ( unsigned ) ulRefused, ( unsigned ) ulTotal );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+UBaseType_t uxIndex;
+
+	for( uxIndex = 0; uxIndex < testTIMERS; uxIndex++ )
+	{
+		xTimers[ uxIndex ] = xTimerCreate( "Timer", 2 + uxIndex, ( uxIndex & 1 ) ? pdTRUE : pdFALSE, ( void * ) uxIndex, prvTimerCallback );
+		configASSERT( xTimers[ uxIndex ] );
+	}
+
+	prvTestPendingCommands();
+
+	/* Preempt the timer service tasks at random points in their critical
+	sections, so the moves happen at as many points as possible. */
+	vPortSetRandomPreemption( 4, 1 );
+	prvTestStress();
+	vPortSetRandomPreemption( 0, 0 );
+
+	printf( "PASS\n" );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
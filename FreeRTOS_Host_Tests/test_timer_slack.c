@@ -0,0 +1,229 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Tests timer slack.  Timers whose slack windows overlap must share one wake
+ * up of the timer service task, every callback must run within its timer's
+ * slack window, and auto-reload timers must not drift however late they run.
+ * The Makefile builds it with the sorted lists and, as test_timer_slack_wheel,
+ * with configUSE_TIMER_WHEEL set to 1.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#define testTIMERS			( 50 )
+#define testTICKS			( 50000UL )
+
+/* The state of a timer in the model. */
+typedef struct
+{
+	TimerHandle_t xTimer;
+	TickType_t xPeriod;
+	TickType_t xSlack;
+	TickType_t xExpiry;
+	TickType_t xLastCallback;
+	uint32_t ulCallbacks;
+} ModelTimer_t;
+
+static ModelTimer_t xModel[ testTIMERS ];
+
+/* The number of different ticks at which callbacks ran. */
+static uint32_t ulCallbackTicks = 0;
+static TickType_t xLastCallbackTick;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+static uint32_t ulState = 0x0badf00dUL;
+
+	/* xorshift32. */
+	ulState ^= ulState << 13;
+	ulState ^= ulState >> 17;
+	ulState ^= ulState << 5;
+	return ulState;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+ModelTimer_t *pxModel = &( xModel[ ( uintptr_t ) pvTimerGetTimerID( xTimer ) ] );
+TickType_t xNow = xTaskGetTickCount();
+
+	/* The callback runs within the slack window of the expiry time, and the
+	next expiry time is relative to this one, not to when it ran. */
+	configASSERT( ( TickType_t ) ( xNow - pxModel->xExpiry ) <= pxModel->xSlack );
+	pxModel->xLastCallback = xNow;
+	pxModel->xExpiry += pxModel->xPeriod;
+	pxModel->ulCallbacks++;
+
+	if( ( ulCallbackTicks == 0 ) || ( xNow != xLastCallbackTick ) )
+	{
+		ulCallbackTicks++;
+		xLastCallbackTick = xNow;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartTimer( UBaseType_t uxTimer, TickType_t xPeriod, TickType_t xSlack )
+{
+ModelTimer_t *pxModel = &( xModel[ uxTimer ] );
+
+	pxModel->xPeriod = xPeriod;
+	pxModel->xSlack = xSlack;
+	vTimerSetSlack( pxModel->xTimer, xSlack );
+	configASSERT( xTimerGetSlack( pxModel->xTimer ) == xSlack );
+	configASSERT( xTimerChangePeriod( pxModel->xTimer, xPeriod, portMAX_DELAY ) == pdPASS );
+	pxModel->xExpiry = xTaskGetTickCount() + xPeriod;
+	pxModel->ulCallbacks = 0;
+}
+/*-----------------------------------------------------------*/
+
+static void prvStopTimers( void )
+{
+UBaseType_t ux;
+
+	for( ux = 0; ux < testTIMERS; ux++ )
+	{
+		configASSERT( xTimerStop( xModel[ ux ].xTimer, portMAX_DELAY ) == pdPASS );
+	}
+
+	vTaskDelay( 1 );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTestOverlappingWindows( void )
+{
+TimerWakeStats_t xBefore, xAfter;
+TickType_t xStart;
+
+	/* Timer 0 expires at 10 and may run until 15, timer 1 expires at 12 and
+	may not run late, and timer 2 expires at 14 and may run until 24.  The
+	first two share a wake up at 12.  Timer 2 has not expired by then so runs
+	at the end of its window, at 24, along with timer 0 expiring at 20 and
+	timer 1 expiring at 24.  The timers are stopped at 30, before the next
+	window ends.  Five expiry times are processed in two wake ups. */
+	vTimerGetWakeStats( &xBefore );
+	xStart = xTaskGetTickCount();
+	prvStartTimer( 0, 10, 5 );
+	prvStartTimer( 1, 12, 0 );
+	prvStartTimer( 2, 14, 10 );
+	vTaskDelay( 30 );
+	prvStopTimers();
+	vTimerGetWakeStats( &xAfter );
+
+	configASSERT( ( xModel[ 0 ].ulCallbacks == 2 ) && ( xModel[ 1 ].ulCallbacks == 2 ) && ( xModel[ 2 ].ulCallbacks == 1 ) );
+	configASSERT( xModel[ 2 ].xLastCallback == ( TickType_t ) ( xStart + 24 ) );
+	configASSERT( xModel[ 0 ].xLastCallback == ( TickType_t ) ( xStart + 24 ) );
+	configASSERT( ( xAfter.ulWakeUps - xBefore.ulWakeUps ) == 2 );
+	configASSERT( ( xAfter.ulExpiryTimes - xBefore.ulExpiryTimes ) == 5 );
+	configASSERT( xAfter.ulWakeUpsSaved == ( xAfter.ulExpiryTimes - xAfter.ulWakeUps ) );
+
+	printf( "overlapping windows: ok\n" );
+}
+/*-----------------------------------------------------------*/
+
+/* Auto-reload timers with random periods and slacks run for a long time.
+Every callback must run in its window, every tick at which callbacks ran must
+have been one wake up, and slack must have saved wake ups. */
+static void prvTestRandomTimers( void )
+{
+TimerWakeStats_t xBefore, xAfter;
+TickType_t xPeriod, xNow;
+uint32_t ulCallbacks = 0;
+UBaseType_t ux;
+
+	vTimerGetWakeStats( &xBefore );
+	ulCallbackTicks = 0;
+
+	for( ux = 0; ux < testTIMERS; ux++ )
+	{
+		xPeriod = ( TickType_t ) ( 5 + ( prvRand() % 500 ) );
+		prvStartTimer( ux, xPeriod, ( TickType_t ) ( prvRand() % xPeriod ) );
+	}
+
+	vTaskDelay( testTICKS );
+	vTimerGetWakeStats( &xAfter );
+	xNow = xTaskGetTickCount();
+
+	for( ux = 0; ux < testTIMERS; ux++ )
+	{
+		/* No expiry was missed.  Callbacks due by now but still within their
+		window may not have run yet. */
+		configASSERT( ( TickType_t ) ( xNow - xModel[ ux ].xExpiry + xModel[ ux ].xPeriod ) < xModel[ ux ].xPeriod + xModel[ ux ].xSlack );
+		ulCallbacks += xModel[ ux ].ulCallbacks;
+	}
+
+	prvStopTimers();
+
+	configASSERT( ( xAfter.ulWakeUps - xBefore.ulWakeUps ) == ulCallbackTicks );
+	configASSERT( ( xAfter.ulWakeUps - xBefore.ulWakeUps ) < ( xAfter.ulExpiryTimes - xBefore.ulExpiryTimes ) );
+
+	printf( "%lu callbacks, %lu wake ups, %lu expiry times: ok\n", ( unsigned long ) ulCallbacks,
+		( unsigned long ) ( xAfter.ulWakeUps - xBefore.ulWakeUps ), ( unsigned long ) ( xAfter.ulExpiryTimes - xBefore.ulExpiryTimes ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+	prvTestOverlappingWindows();
+	prvTestRandomTimers();
+
+	printf( "PASS\n" );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+UBaseType_t ux;
+
+	for( ux = 0; ux < testTIMERS; ux++ )
+	{
+		xModel[ ux ].xTimer = xTimerCreate( "Timer", 1, pdTRUE, ( void * ) ( uintptr_t ) ux, prvTimerCallback );
+		configASSERT( xModel[ ux ].xTimer );
+	}
+
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
@@ -0,0 +1,276 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Tests software timers against a model of when each callback must execute.
+ * Random start, reset, stop and change period commands are sent to timers
+ * with periods of up to 70000 ticks, so with configUSE_TIMER_WHEEL set to 1
+ * timers are cascaded through every level of the wheel.  The timer service
+ * task is also starved for a while from time to time, after which auto-reload
+ * timers must catch up on every period they missed.  The Makefile builds it
+ * with the wheel, and with the tick count starting shortly before it
+ * overflows.
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#define testTIMERS				( 60 )
+
+/* Commands are sent to the first testCOMMANDED_TIMERS timers.  The others are
+auto-reload timers that are started once, so timers with long periods are
+left in the higher levels of the wheel long enough to be cascaded. */
+#define testCOMMANDED_TIMERS	( 40 )
+#define testTICKS				( 100000UL )
+
+/* How often, in ticks, the timer service task is starved, and the longest
+time it is starved for. */
+#define testSTARVE_INTERVAL		( 5000UL )
+#define testMAX_STARVE_TICKS	( 300UL )
+
+/* The state of a timer in the model. */
+typedef struct
+{
+	TimerHandle_t xTimer;
+	TickType_t xPeriod;
+	TickType_t xExpiry;
+	BaseType_t xAutoReload;
+	BaseType_t xActive;
+	uint32_t ulCallbacks;
+} ModelTimer_t;
+
+static ModelTimer_t xModel[ testTIMERS ];
+
+/* Callbacks due before this tick can execute late, as the timer service task
+was starved when they were due. */
+static TickType_t xStarvedUntil;
+static BaseType_t xStarving = pdFALSE;
+static uint32_t ulLateCallbacks = 0;
+
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	vPortSimulateTick();
+}
+/*-----------------------------------------------------------*/
+
+static uint32_t prvRand( void )
+{
+static uint32_t ulState = 0x2468aceUL;
+
+	/* xorshift32. */
+	ulState ^= ulState << 13;
+	ulState ^= ulState >> 17;
+	ulState ^= ulState << 5;
+	return ulState;
+}
+/*-----------------------------------------------------------*/
+
+/* Mostly short periods, so callbacks are frequent, with some long enough to
+start in the highest levels of the wheel.  No command is sent to a timer with
+a period of one tick once it is active, as a callback is always due, so that
+period is not used. */
+static TickType_t prvRandomPeriod( void )
+{
+uint32_t ulKind = prvRand() % 10;
+
+	if( ulKind < 5 )
+	{
+		return ( TickType_t ) ( 2 + ( prvRand() % 40 ) );
+	}
+	else if( ulKind < 8 )
+	{
+		return ( TickType_t ) ( 2 + ( prvRand() % 1000 ) );
+	}
+	else
+	{
+		return ( TickType_t ) ( 2 + ( prvRand() % 70000 ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerCallback( TimerHandle_t xTimer )
+{
+ModelTimer_t *pxModel = &( xModel[ ( uintptr_t ) pvTimerGetTimerID( xTimer ) ] );
+TickType_t xNow = xTaskGetTickCount();
+
+	configASSERT( xStarving == pdFALSE );
+	configASSERT( pxModel->xActive != pdFALSE );
+
+	/* The callback is due now, or it was due while the timer service task
+	was starved.  The comparisons are of the time elapsed since the starving
+	ended, so they hold across a tick count overflow. */
+	if( xNow != pxModel->xExpiry )
+	{
+		configASSERT( ( TickType_t ) ( xStarvedUntil - pxModel->xExpiry ) <= ( TickType_t ) ( testMAX_STARVE_TICKS + 1 ) );
+		configASSERT( ( TickType_t ) ( xNow - pxModel->xExpiry ) <= ( TickType_t ) ( xNow - xStarvedUntil + testMAX_STARVE_TICKS + 1 ) );
+		ulLateCallbacks++;
+	}
+
+	pxModel->ulCallbacks++;
+
+	if( pxModel->xAutoReload != pdFALSE )
+	{
+		pxModel->xExpiry += pxModel->xPeriod;
+	}
+	else
+	{
+		pxModel->xActive = pdFALSE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* Send a random command to a random timer, unless a callback of the timer is
+due, as it executes before the command is processed. */
+static void prvRandomCommand( void )
+{
+ModelTimer_t *pxModel = &( xModel[ prvRand() % testCOMMANDED_TIMERS ] );
+TickType_t xNow = xTaskGetTickCount();
+uint32_t ulCommand = prvRand() % 10;
+
+	if( ( pxModel->xActive != pdFALSE ) && ( ( TickType_t ) ( pxModel->xExpiry - xNow - 1 ) >= ( TickType_t ) ( portMAX_DELAY / 2 ) ) )
+	{
+		return;
+	}
+
+	if( ulCommand < 4 )
+	{
+		configASSERT( xTimerStart( pxModel->xTimer, portMAX_DELAY ) == pdPASS );
+		pxModel->xExpiry = xNow + pxModel->xPeriod;
+		pxModel->xActive = pdTRUE;
+	}
+	else if( ulCommand < 6 )
+	{
+		configASSERT( xTimerReset( pxModel->xTimer, portMAX_DELAY ) == pdPASS );
+		pxModel->xExpiry = xNow + pxModel->xPeriod;
+		pxModel->xActive = pdTRUE;
+	}
+	else if( ulCommand < 8 )
+	{
+		configASSERT( xTimerStop( pxModel->xTimer, portMAX_DELAY ) == pdPASS );
+		pxModel->xActive = pdFALSE;
+	}
+	else
+	{
+		pxModel->xPeriod = prvRandomPeriod();
+		configASSERT( xTimerChangePeriod( pxModel->xTimer, pxModel->xPeriod, portMAX_DELAY ) == pdPASS );
+		pxModel->xExpiry = xNow + pxModel->xPeriod;
+		pxModel->xActive = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvControlTask( void *pvParameters )
+{
+uint32_t ulTick, ulCallbacks = 0;
+TickType_t xStarveTicks, xNow;
+UBaseType_t ux;
+
+	for( ux = testCOMMANDED_TIMERS; ux < testTIMERS; ux++ )
+	{
+		configASSERT( xTimerStart( xModel[ ux ].xTimer, portMAX_DELAY ) == pdPASS );
+		xModel[ ux ].xExpiry = xTaskGetTickCount() + xModel[ ux ].xPeriod;
+		xModel[ ux ].xActive = pdTRUE;
+	}
+
+	for( ulTick = 1; ulTick <= testTICKS; ulTick++ )
+	{
+		if( ( ulTick % testSTARVE_INTERVAL ) == 0 )
+		{
+			/* Keep the timer service task from running while time passes. */
+			xStarveTicks = ( TickType_t ) ( 1 + ( prvRand() % testMAX_STARVE_TICKS ) );
+			xStarving = pdTRUE;
+
+			while( xStarveTicks > ( TickType_t ) 0 )
+			{
+				vPortSimulateTick();
+				xStarveTicks--;
+			}
+
+			xStarving = pdFALSE;
+			xStarvedUntil = xTaskGetTickCount();
+		}
+		else if( ( TickType_t ) ( xTaskGetTickCount() - xStarvedUntil ) > ( TickType_t ) 1 )
+		{
+			/* Commands are not sent while the timer service task catches
+			up, so the model knows which happens first. */
+			ux = prvRand() % 3;
+
+			while( ux > 0 )
+			{
+				prvRandomCommand();
+				ux--;
+			}
+		}
+
+		vTaskDelay( 1 );
+	}
+
+	/* No callback was missed.  Those due now have not executed yet, as this
+	task runs before the timer service task. */
+	xNow = xTaskGetTickCount();
+
+	for( ux = 0; ux < testTIMERS; ux++ )
+	{
+		configASSERT( ( xModel[ ux ].xActive == pdFALSE ) || ( ( TickType_t ) ( xModel[ ux ].xExpiry - xNow ) < ( TickType_t ) ( portMAX_DELAY / 2 ) ) );
+		configASSERT( ( xTimerIsTimerActive( xModel[ ux ].xTimer ) != pdFALSE ) == ( xModel[ ux ].xActive != pdFALSE ) );
+		ulCallbacks += xModel[ ux ].ulCallbacks;
+	}
+
+	configASSERT( ulLateCallbacks > 0 );
+	printf( "%lu callbacks, %lu after starving, over %lu ticks: ok\n", ( unsigned long ) ulCallbacks, ( unsigned long ) ulLateCallbacks, ( unsigned long ) testTICKS );
+
+	printf( "PASS\n" );
+	vTaskEndScheduler();
+}
+/*-----------------------------------------------------------*/
+
+int main( void )
+{
+UBaseType_t ux;
+
+	for( ux = 0; ux < testTIMERS; ux++ )
+	{
+		xModel[ ux ].xPeriod = prvRandomPeriod();
+		xModel[ ux ].xAutoReload = ( ( ux >= testCOMMANDED_TIMERS ) || ( ( ux % 3 ) != 0 ) ) ? pdTRUE : pdFALSE;
+		xModel[ ux ].xTimer = xTimerCreate( "Timer", xModel[ ux ].xPeriod, ( UBaseType_t ) xModel[ ux ].xAutoReload, ( void * ) ( uintptr_t ) ux, prvTimerCallback );
+		configASSERT( xModel[ ux ].xTimer );
+	}
+
+	xTaskCreate( prvControlTask, "Control", configMINIMAL_STACK_SIZE, NULL, configMAX_PRIORITIES - 1, NULL );
+	vTaskStartScheduler();
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
@@ -64,6 +64,33 @@ extern "C" {
 struct StreamBufferDef_t;
 typedef struct StreamBufferDef_t * StreamBufferHandle_t;
 
+/* Values that can be passed as the xStreamBufferType parameter of
+xStreamBufferGenericCreate() and xStreamBufferGenericCreateStatic().
+sbTYPE_MULTI_PRODUCER can be bitwise ORed with either of the other two. */
+#define sbTYPE_STREAM_BUFFER	( ( BaseType_t ) 0 )
+#define sbTYPE_MESSAGE_BUFFER	( ( BaseType_t ) 1 )
+#define sbTYPE_MULTI_PRODUCER	( ( BaseType_t ) 2 )
+
+/**
+ * Describes a contiguous region of a stream buffer's storage area, as returned
+ * by xStreamBufferAcquireWrite() and xStreamBufferAcquireRead().
+ */
+typedef struct xSTREAM_BUFFER_SPAN
+{
+	uint8_t *pucData;	/* The start of the region, or NULL if xLength is 0. */
+	size_t xLength;		/* The number of bytes in the region. */
+} StreamBufferSpan_t;
+
+/**
+ * Describes one fragment of the data passed to xStreamBufferSendV() and
+ * xStreamBufferSendVFromISR().
+ */
+typedef struct xSTREAM_BUFFER_FRAGMENT
+{
+	const void *pvData;	/* The start of the fragment. */
+	size_t xLength;		/* The number of bytes in the fragment. */
+} StreamBufferFragment_t;
+
 
 /**
  * message_buffer.h
@@ -213,6 +240,47 @@ const size_t xTriggerLevel = 1;
  */
 #define xStreamBufferCreateStatic( xBufferSizeBytes, xTriggerLevelBytes, pucStreamBufferStorageArea, pxStaticStreamBuffer ) xStreamBufferGenericCreateStatic( xBufferSizeBytes, xTriggerLevelBytes, pdFALSE, pucStreamBufferStorageArea, pxStaticStreamBuffer )
 
+/**
+ * stream_buffer.h
+ *
+<pre>
+StreamBufferHandle_t xStreamBufferCreateMultiProducer( size_t xBufferSizeBytes, size_t xTriggerLevelBytes );
+StreamBufferHandle_t xStreamBufferCreateMultiProducerStatic( size_t xBufferSizeBytes,
+                                                             size_t xTriggerLevelBytes,
+                                                             uint8_t *pucStreamBufferStorageArea,
+                                                             StaticStreamBuffer_t *pxStaticStreamBuffer );
+</pre>
+ *
+ * Versions of xStreamBufferCreate() and xStreamBufferCreateStatic() that
+ * create a stream buffer that any number of tasks and interrupts can write to
+ * at the same time, without the writes having to be serialised by a mutex or
+ * critical section.  There must still only be one reader.
+ *
+ * configUSE_MULTI_PRODUCER_STREAM_BUFFERS must be set to 1 in FreeRTOSConfig.h
+ * for these macros to be available.
+ *
+ * Each write first reserves space in the buffer, then copies its data into the
+ * reserved space outside of any critical section, then commits the write.
+ * Writes can be committed in any order, and the reader is only given the data
+ * once every write that has reserved space has been committed.  Therefore a
+ * writer that is preempted part way through a write delays the reader seeing
+ * data written after it.  The bytes written by a single call are always
+ * contiguous in the stream.  Any number of tasks can block waiting for space,
+ * and are unblocked in priority order.  As with a single writer, a task that
+ * calls xStreamBufferSend() with a non zero block time waits until all of its
+ * data fits, and only writes part of it if the block time expires first.
+ *
+ * The parameters and return values are as for xStreamBufferCreate() and
+ * xStreamBufferCreateStatic().
+ *
+ * \defgroup xStreamBufferCreateMultiProducer xStreamBufferCreateMultiProducer
+ * \ingroup StreamBufferManagement
+ */
+#if( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+	#define xStreamBufferCreateMultiProducer( xBufferSizeBytes, xTriggerLevelBytes ) xStreamBufferGenericCreate( xBufferSizeBytes, xTriggerLevelBytes, ( sbTYPE_STREAM_BUFFER | sbTYPE_MULTI_PRODUCER ) )
+	#define xStreamBufferCreateMultiProducerStatic( xBufferSizeBytes, xTriggerLevelBytes, pucStreamBufferStorageArea, pxStaticStreamBuffer ) xStreamBufferGenericCreateStatic( xBufferSizeBytes, xTriggerLevelBytes, ( sbTYPE_STREAM_BUFFER | sbTYPE_MULTI_PRODUCER ), pucStreamBufferStorageArea, pxStaticStreamBuffer )
+#endif
+
 /**
  * stream_buffer.h
  *
@@ -411,6 +479,92 @@ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
 								 size_t xDataLengthBytes,
 								 BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferSendV( StreamBufferHandle_t xStreamBuffer,
+                           const StreamBufferFragment_t *pxFragments,
+                           UBaseType_t uxFragments,
+                           TickType_t xTicksToWait );
+</pre>
+ *
+ * A version of xStreamBufferSend() that gathers the data to send from several
+ * fragments, so data that is held in separate places - such as a protocol
+ * header, payload and checksum - does not first have to be copied into a
+ * temporary buffer.  The fragments are written in order, exactly as if they
+ * had been concatenated and passed to xStreamBufferSend().  In particular,
+ * when writing to a message buffer the fragments form a single message with a
+ * single length, and either all of it or none of it is written.
+ *
+ * Use xMessageBufferSendV() to write to a message buffer.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to which the data is
+ * being sent.
+ *
+ * @param pxFragments An array of uxFragments fragments describing the data to
+ * send.  Fragments with an xLength of 0 are skipped.
+ *
+ * @param uxFragments The number of fragments in the array.
+ *
+ * @param xTicksToWait As for xStreamBufferSend().
+ *
+ * @return As for xStreamBufferSend(), where the number of bytes being sent is
+ * the total length of all the fragments.
+ *
+ * Example use:
+<pre>
+void vAFunction( StreamBufferHandle_t xStreamBuffer, uint8_t *pucPayload, size_t xPayloadLength )
+{
+Header_t xHeader;
+uint16_t usCRC;
+StreamBufferFragment_t xFragments[ 3 ];
+
+    vFillHeader( &xHeader, xPayloadLength );
+    usCRC = usCalculateCRC( pucPayload, xPayloadLength );
+
+    xFragments[ 0 ].pvData = &xHeader;
+    xFragments[ 0 ].xLength = sizeof( xHeader );
+    xFragments[ 1 ].pvData = pucPayload;
+    xFragments[ 1 ].xLength = xPayloadLength;
+    xFragments[ 2 ].pvData = &usCRC;
+    xFragments[ 2 ].xLength = sizeof( usCRC );
+
+    xStreamBufferSendV( xStreamBuffer, xFragments, 3, pdMS_TO_TICKS( 100 ) );
+}
+</pre>
+ * \defgroup xStreamBufferSendV xStreamBufferSendV
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendV( StreamBufferHandle_t xStreamBuffer,
+						   const StreamBufferFragment_t *pxFragments,
+						   UBaseType_t uxFragments,
+						   TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferSendVFromISR( StreamBufferHandle_t xStreamBuffer,
+                                  const StreamBufferFragment_t *pxFragments,
+                                  UBaseType_t uxFragments,
+                                  BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * A version of xStreamBufferSendV() that can be called from an interrupt
+ * service routine (ISR).  The parameters and return value are as for
+ * xStreamBufferSendV() and xStreamBufferSendFromISR().
+ *
+ * Use xMessageBufferSendVFromISR() to write to a message buffer from an ISR.
+ *
+ * \defgroup xStreamBufferSendVFromISR xStreamBufferSendVFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendVFromISR( StreamBufferHandle_t xStreamBuffer,
+								  const StreamBufferFragment_t *pxFragments,
+								  UBaseType_t uxFragments,
+								  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /**
  * stream_buffer.h
  *
@@ -658,7 +812,7 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer );
  * Resets a stream buffer to its initial, empty, state.  Any data that was in
  * the stream buffer is discarded.  A stream buffer can only be reset if there
  * are no tasks blocked waiting to either send to or receive from the stream
- * buffer.
+ * buffer.  The trigger level and trigger hold-off are kept.
  *
  * @param xStreamBuffer The handle of the stream buffer being reset.
  *
@@ -750,6 +904,42 @@ BaseType_t xStreamBufferSetTriggerLevel( StreamBufferHandle_t xStreamBuffer, siz
  */
 BaseType_t xStreamBufferSetTriggerLevel( StreamBufferHandle_t xStreamBuffer, size_t xTriggerLevel ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+<pre>
+BaseType_t xStreamBufferSetTriggerHoldOff( StreamBufferHandle_t xStreamBuffer, TickType_t xHoldOffTicks );
+</pre>
+ *
+ * A task blocked waiting for data on a stream buffer is normally only
+ * unblocked once the number of bytes in the buffer reaches the trigger level,
+ * or its block time expires.  A high trigger level reduces the number of times
+ * the task is unblocked when data arrives quickly, but when data arrives
+ * slowly it can be left in the buffer for up to the full block time.
+ *
+ * Setting a hold-off bounds that delay.  The blocked task is unblocked when
+ * either the trigger level is reached, or xHoldOffTicks ticks have passed
+ * since the first byte arrived in the empty buffer, whichever happens first.
+ * The hold-off is implemented by shortening the task's own block time, so
+ * does not use a software timer.
+ *
+ * configUSE_STREAM_BUFFER_TRIGGER_HOLD_OFF must be set to 1 in
+ * FreeRTOSConfig.h for xStreamBufferSetTriggerHoldOff() to be available.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being updated.
+ *
+ * @param xHoldOffTicks The maximum number of ticks data can wait in the
+ * buffer below the trigger level before a blocked reader is unblocked.  Set to
+ * 0, the default, to unblock the reader on the trigger level alone.  The new
+ * value is used from the next time the reader blocks.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xStreamBufferSetTriggerHoldOff xStreamBufferSetTriggerHoldOff
+ * \ingroup StreamBufferManagement
+ */
+BaseType_t xStreamBufferSetTriggerHoldOff( StreamBufferHandle_t xStreamBuffer, TickType_t xHoldOffTicks ) PRIVILEGED_FUNCTION;
+
 /**
  * stream_buffer.h
  *
@@ -829,14 +1019,243 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
  */
 BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferAcquireWrite( StreamBufferHandle_t xStreamBuffer,
+                                  StreamBufferSpan_t pxSpans[ 2 ],
+                                  TickType_t xTicksToWait );
+</pre>
+ *
+ * Obtains the free space in a stream buffer so the writer can place data
+ * directly into the buffer's storage area - for example by pointing a DMA
+ * channel at it - rather than copying the data in with xStreamBufferSend().
+ * The data is not visible to the reader until it is committed using
+ * vStreamBufferCommitWrite() or vStreamBufferCommitWriteFromISR().
+ *
+ * The free space wraps around the end of the storage area, so is returned as
+ * up to two spans.  pxSpans[ 0 ] always starts at the point the next byte is to
+ * be written.  If the free space wraps then pxSpans[ 1 ] describes the
+ * remainder, starting at the beginning of the storage area, otherwise its
+ * xLength member is 0.  Data written to pxSpans[ 0 ] must be committed before,
+ * or together with, data written to pxSpans[ 1 ].
+ *
+ * configUSE_STREAM_BUFFER_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for
+ * the zero copy functions to be available.  They can only be used with stream
+ * buffers created using xStreamBufferCreate() or xStreamBufferCreateStatic(),
+ * not with message buffers or multi-producer buffers.  As with
+ * xStreamBufferSend(), only one task or interrupt can write to the stream
+ * buffer, and the space must not be acquired again until the previous write
+ * has been committed.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to write to.
+ *
+ * @param pxSpans An array of two spans that will be set to describe the free
+ * space.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for the stream buffer to have any free
+ * space, should it be full.
+ *
+ * @return The total number of free bytes described by both spans.  0 is
+ * returned if the stream buffer remained full.
+ *
+ * Example use:
+<pre>
+void vAFunction( StreamBufferHandle_t xStreamBuffer )
+{
+StreamBufferSpan_t xSpans[ 2 ];
+size_t xLength;
+
+    // Wait up to 100ms for space, then have the peripheral fill as much of the
+    // first span as it can.
+    if( xStreamBufferAcquireWrite( xStreamBuffer, xSpans, pdMS_TO_TICKS( 100 ) ) > 0 )
+    {
+        xLength = xReadPeripheral( xSpans[ 0 ].pucData, xSpans[ 0 ].xLength );
+
+        // Make the bytes available to the reader.
+        vStreamBufferCommitWrite( xStreamBuffer, xLength );
+    }
+}
+</pre>
+ * \defgroup xStreamBufferAcquireWrite xStreamBufferAcquireWrite
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferAcquireWrite( StreamBufferHandle_t xStreamBuffer,
+								  StreamBufferSpan_t pxSpans[ 2 ],
+								  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferAcquireWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+                                         StreamBufferSpan_t pxSpans[ 2 ] );
+</pre>
+ *
+ * A version of xStreamBufferAcquireWrite() that can be called from an
+ * interrupt service routine (ISR) - for example to re-arm a DMA transfer from
+ * the DMA complete interrupt.  It does not block.
+ *
+ * \defgroup xStreamBufferAcquireWriteFromISR xStreamBufferAcquireWriteFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferAcquireWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+										 StreamBufferSpan_t pxSpans[ 2 ] ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+void vStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer, size_t xBytesWritten );
+</pre>
+ *
+ * Makes xBytesWritten bytes, written directly into the space obtained by
+ * xStreamBufferAcquireWrite(), available to the reader.  Exactly as with
+ * xStreamBufferSend(), a task blocked waiting for data is unblocked once the
+ * number of bytes in the stream buffer reaches the buffer's trigger level.
+ *
+ * @param xStreamBuffer The handle of the stream buffer that was written to.
+ *
+ * @param xBytesWritten The number of bytes written, which must not be more
+ * than the total returned by the matching acquire call.  Can be 0 if no bytes
+ * were written.
+ *
+ * \defgroup vStreamBufferCommitWrite vStreamBufferCommitWrite
+ * \ingroup StreamBufferManagement
+ */
+void vStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer, size_t xBytesWritten ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+void vStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+                                      size_t xBytesWritten,
+                                      BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * A version of vStreamBufferCommitWrite() that can be called from an interrupt
+ * service routine (ISR).  *pxHigherPriorityTaskWoken is set to pdTRUE if
+ * committing the data unblocked a task that has a priority above the priority
+ * of the currently running task, in which case a context switch should be
+ * requested before the interrupt is exited.
+ *
+ * \defgroup vStreamBufferCommitWriteFromISR vStreamBufferCommitWriteFromISR
+ * \ingroup StreamBufferManagement
+ */
+void vStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+									  size_t xBytesWritten,
+									  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferAcquireRead( StreamBufferHandle_t xStreamBuffer,
+                                 StreamBufferSpan_t pxSpans[ 2 ],
+                                 TickType_t xTicksToWait );
+</pre>
+ *
+ * Obtains the data in a stream buffer so the reader can process it in place,
+ * rather than copying it out with xStreamBufferReceive().  The data remains in
+ * the stream buffer until it is released using vStreamBufferReleaseRead() or
+ * vStreamBufferReleaseReadFromISR().  As with xStreamBufferAcquireWrite() the
+ * data is returned as up to two spans, the second of which has an xLength of
+ * 0 unless the data wraps around the end of the storage area.
+ *
+ * The same restrictions apply as for xStreamBufferAcquireWrite().  Only one
+ * task or interrupt can read from the stream buffer.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to read from.
+ *
+ * @param pxSpans An array of two spans that will be set to describe the data.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for data, should the stream buffer be
+ * empty.  The task is unblocked when the amount of data in the buffer reaches
+ * the trigger level, or when the block time expires.
+ *
+ * @return The total number of bytes described by both spans.  0 is returned
+ * if the stream buffer remained empty.
+ *
+ * \defgroup xStreamBufferAcquireRead xStreamBufferAcquireRead
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferAcquireRead( StreamBufferHandle_t xStreamBuffer,
+								 StreamBufferSpan_t pxSpans[ 2 ],
+								 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+size_t xStreamBufferAcquireReadFromISR( StreamBufferHandle_t xStreamBuffer,
+                                        StreamBufferSpan_t pxSpans[ 2 ] );
+</pre>
+ *
+ * A version of xStreamBufferAcquireRead() that can be called from an interrupt
+ * service routine (ISR) - for example to start a DMA transfer out of the
+ * stream buffer.  It does not block.
+ *
+ * \defgroup xStreamBufferAcquireReadFromISR xStreamBufferAcquireReadFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferAcquireReadFromISR( StreamBufferHandle_t xStreamBuffer,
+										StreamBufferSpan_t pxSpans[ 2 ] ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+void vStreamBufferReleaseRead( StreamBufferHandle_t xStreamBuffer, size_t xBytesRead );
+</pre>
+ *
+ * Removes xBytesRead bytes, obtained using xStreamBufferAcquireRead(), from
+ * the stream buffer, freeing the space they occupied.  A task blocked waiting
+ * for space is unblocked, exactly as with xStreamBufferReceive().
+ *
+ * @param xStreamBuffer The handle of the stream buffer that was read from.
+ *
+ * @param xBytesRead The number of bytes consumed, which must not be more than
+ * the total returned by the matching acquire call.  Bytes that are not
+ * released remain at the start of the data returned by the next acquire call.
+ *
+ * \defgroup vStreamBufferReleaseRead vStreamBufferReleaseRead
+ * \ingroup StreamBufferManagement
+ */
+void vStreamBufferReleaseRead( StreamBufferHandle_t xStreamBuffer, size_t xBytesRead ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+<pre>
+void vStreamBufferReleaseReadFromISR( StreamBufferHandle_t xStreamBuffer,
+                                      size_t xBytesRead,
+                                      BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * A version of vStreamBufferReleaseRead() that can be called from an interrupt
+ * service routine (ISR).  *pxHigherPriorityTaskWoken is set to pdTRUE if
+ * releasing the space unblocked a task that has a priority above the priority
+ * of the currently running task.
+ *
+ * \defgroup vStreamBufferReleaseReadFromISR vStreamBufferReleaseReadFromISR
+ * \ingroup StreamBufferManagement
+ */
+void vStreamBufferReleaseReadFromISR( StreamBufferHandle_t xStreamBuffer,
+									  size_t xBytesRead,
+									  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /* Functions below here are not part of the public API. */
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
 												 size_t xTriggerLevelBytes,
-												 BaseType_t xIsMessageBuffer ) PRIVILEGED_FUNCTION;
+												 BaseType_t xStreamBufferType ) PRIVILEGED_FUNCTION;
 
 StreamBufferHandle_t xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes,
 													   size_t xTriggerLevelBytes,
-													   BaseType_t xIsMessageBuffer,
+													   BaseType_t xStreamBufferType,
 													   uint8_t * const pucStreamBufferStorageArea,
 													   StaticStreamBuffer_t * const pxStaticStreamBuffer ) PRIVILEGED_FUNCTION;
 
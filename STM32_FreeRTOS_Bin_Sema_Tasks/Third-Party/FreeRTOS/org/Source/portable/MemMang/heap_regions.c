@@ -0,0 +1,772 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that manages
+ * several separate regions of memory, each tagged with the kind of memory it
+ * holds, so callers can ask for memory that is fast, suitable for bulk data, or
+ * accessible by DMA.  For example, internal SRAM can be tagged
+ * portHEAP_REGION_FAST | portHEAP_REGION_DMA, and external SDRAM connected
+ * through the FMC tagged portHEAP_REGION_BULK | portHEAP_REGION_DMA, so kernel
+ * objects and other frequently used structures stay in SRAM while large
+ * buffers are placed in SDRAM.
+ *
+ * The regions are defined by calling vPortDefineHeapRegions(), which must be
+ * called before any memory is allocated.  Unlike heap_5.c each region is
+ * managed as a heap of its own, in the same way as heap_4.c manages its single
+ * array, so the regions can be listed in any order and blocks are never merged
+ * across regions.
+ *
+ * pvPortMallocTagged() allocates from the first region, in the order the
+ * regions were defined, that has all the requested tags and can hold the block.
+ * If none can, the block is allocated from the first other region that can hold
+ * it, so a region running out does not cause the allocation to fail.
+ * portHEAP_REGION_DMA is a requirement rather than a hint, so is never dropped
+ * in this way.  pvPortMalloc() requests no tags, so allocates from the first
+ * region that can hold the block - list the fastest memory first.
+ *
+ * The heap is protected by suspending the scheduler, so this file cannot be
+ * used when configHEAP_USE_CRITICAL_SECTIONS is 1.
+ *
+ * Set configUSE_REGION_HEAP to 1 in FreeRTOSConfig.h to use this file in place
+ * of heap_4.c.  configHEAP_MAX_REGIONS sets the number of regions that can be
+ * defined.
+ *
+ * See heap_4.c and heap_tlsf.c for alternative implementations, and the memory
+ * management pages of http://www.FreeRTOS.org for more information.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is not configured
+to use heap_regions.c.  This #if is closed at the very bottom of this file. */
+#if( configUSE_REGION_HEAP == 1 )
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#if( configUSE_TLSF_HEAP == 1 )
+	#error configUSE_TLSF_HEAP and configUSE_REGION_HEAP must not both be set to 1
+#endif
+
+#if( configHEAP_USE_CRITICAL_SECTIONS == 1 )
+	#error heap_regions.c suspends the scheduler to protect the heap, so configHEAP_USE_CRITICAL_SECTIONS must be set to 0
+#endif
+
+/* Block sizes must not get too small. */
+#define heapMINIMUM_BLOCK_SIZE	( ( size_t ) ( xHeapStructSize << 1 ) )
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE		( ( size_t ) 8 )
+
+/* vPortGetHeapStats() counts free blocks of less than heapSTATS_FIRST_CLASS_LIMIT
+bytes in the first size class, and doubles the limit for each class after it. */
+#define heapSTATS_FIRST_CLASS_LIMIT	( ( size_t ) 32 )
+
+/* The tags that are kept when an allocation falls back to a region that does
+not have all the requested tags.  Memory that must be reachable by DMA is no
+use anywhere else. */
+#define heapREQUIRED_TAGS		( portHEAP_REGION_DMA )
+
+/* Define the linked list structure.  This is used to link free blocks in order
+of their memory address. */
+typedef struct A_BLOCK_LINK
+{
+	struct A_BLOCK_LINK *pxNextFreeBlock;	/*<< The next free block in the list. */
+	size_t xBlockSize;						/*<< The size of the free block. */
+} BlockLink_t;
+
+/* The state of one region.  Each region has its own list of free blocks. */
+typedef struct A_HEAP_REGION
+{
+	BlockLink_t xStart;						/*<< Holds a pointer to the first free block in the region. */
+	BlockLink_t *pxEnd;						/*<< Marks the end of the list of free blocks, and the end of the region. */
+	uint8_t *pucStartAddress;				/*<< The aligned start of the region, used to find the region of a block being freed. */
+	UBaseType_t uxTags;						/*<< The portHEAP_REGION_xxx tags of the memory in the region. */
+	size_t xFreeBytesRemaining;				/*<< The sum of the sizes of the free blocks in the region. */
+	size_t xMinimumEverFreeBytesRemaining;	/*<< The lowest value xFreeBytesRemaining has had. */
+	size_t xNumberOfSuccessfulAllocations;	/*<< The number of blocks allocated from the region. */
+	size_t xNumberOfSuccessfulFrees;		/*<< The number of blocks freed back to the region. */
+} HeapRegionState_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Allocate a block of at least xWantedSize bytes from a region with the
+ * requested tags, or from another region if none of those can hold it.
+ * Returns NULL if no region can.  Must be called with the scheduler suspended.
+ */
+static void *prvAllocate( size_t xWantedSize, UBaseType_t uxTags );
+
+/*
+ * Allocate a block of xBlockSize bytes, which includes the BlockLink_t
+ * structure, from the first free block in pxRegion that is large enough.
+ * Returns NULL if there is no such block.
+ */
+static void *prvAllocateFromRegion( HeapRegionState_t *pxRegion, size_t xBlockSize );
+
+/*
+ * Inserts a block of memory that is being freed into the correct position in
+ * the list of free memory blocks of its region.  The block being freed will be
+ * merged with the block in front it and/or the block behind it if the memory
+ * blocks are adjacent to each other.
+ */
+static void prvInsertBlockIntoFreeList( HeapRegionState_t *pxRegion, BlockLink_t *pxBlockToInsert );
+
+/*
+ * Adds the free blocks of pxRegion to the statistics being gathered in
+ * pxHeapStats.  Must be called with the scheduler suspended.
+ */
+static void prvAddRegionStats( const HeapRegionState_t *pxRegion, HeapStats_t *pxHeapStats );
+
+/*
+ * Adds a free block of xBlockSize bytes to the statistics being gathered in
+ * pxHeapStats.
+ */
+static void prvCountFreeBlock( HeapStats_t *pxHeapStats, size_t xBlockSize );
+
+/*-----------------------------------------------------------*/
+
+/* The size of the structure placed at the beginning of each allocated memory
+block must by correctly byte aligned. */
+static const size_t xHeapStructSize	= ( sizeof( BlockLink_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The regions, in the order they were passed to vPortDefineHeapRegions(). */
+static HeapRegionState_t xHeapRegions[ configHEAP_MAX_REGIONS ];
+static UBaseType_t uxNumberOfRegions = 0U;
+
+/* Keeps track of the number of free bytes remaining in all the regions
+together, but says nothing about fragmentation. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+
+/* Gets set to the top bit of an size_t type.  When this bit in the xBlockSize
+member of an BlockLink_t structure is set then the block belongs to the
+application.  When the bit is free the block is still part of the free heap
+space. */
+static size_t xBlockAllocatedBit = 0;
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+void *pvReturn;
+
+	vTaskSuspendAll();
+	{
+		/* No tags are requested, so the block comes from the first region
+		that can hold it. */
+		pvReturn = prvAllocate( xWantedSize, ( UBaseType_t ) 0 );
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortMallocTagged( size_t xWantedSize, UBaseType_t uxTags )
+{
+void *pvReturn;
+
+	vTaskSuspendAll();
+	{
+		pvReturn = prvAllocate( xWantedSize, uxTags );
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+uint8_t *puc = ( uint8_t * ) pv;
+BlockLink_t *pxLink;
+HeapRegionState_t *pxRegion = NULL;
+UBaseType_t uxRegion;
+
+	if( pv != NULL )
+	{
+		/* The memory being freed will have an BlockLink_t structure immediately
+		before it. */
+		puc -= xHeapStructSize;
+
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxLink = ( void * ) puc;
+
+		/* Find the region the block was allocated from.  The regions are
+		fixed once defined, so this does not need the scheduler suspended. */
+		for( uxRegion = 0; uxRegion < uxNumberOfRegions; uxRegion++ )
+		{
+			if( ( puc >= xHeapRegions[ uxRegion ].pucStartAddress ) && ( puc < ( uint8_t * ) xHeapRegions[ uxRegion ].pxEnd ) )
+			{
+				pxRegion = &( xHeapRegions[ uxRegion ] );
+				break;
+			}
+		}
+
+		/* Check the block is actually allocated, from one of the regions. */
+		configASSERT( pxRegion );
+		configASSERT( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 );
+		configASSERT( pxLink->pxNextFreeBlock == NULL );
+
+		if( ( pxRegion != NULL ) && ( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 ) )
+		{
+			if( pxLink->pxNextFreeBlock == NULL )
+			{
+				/* The block is being returned to the heap - it is no longer
+				allocated. */
+				pxLink->xBlockSize &= ~xBlockAllocatedBit;
+
+				vTaskSuspendAll();
+				{
+					/* Add this block to the list of free blocks of its
+					region. */
+					pxRegion->xFreeBytesRemaining += pxLink->xBlockSize;
+					xFreeBytesRemaining += pxLink->xBlockSize;
+					traceFREE( pv, pxLink->xBlockSize );
+					prvInsertBlockIntoFreeList( pxRegion, ( ( BlockLink_t * ) pxLink ) );
+					( pxRegion->xNumberOfSuccessfulFrees )++;
+				}
+				( void ) xTaskResumeAll();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t *pxHeapStats )
+{
+UBaseType_t uxRegion, uxClass;
+
+	pxHeapStats->xSizeOfLargestFreeBlockInBytes = 0;
+	pxHeapStats->xSizeOfSmallestFreeBlockInBytes = 0;
+	pxHeapStats->xNumberOfFreeBlocks = 0;
+	pxHeapStats->xAvailableHeapSpaceInBytes = 0;
+	pxHeapStats->xNumberOfSuccessfulAllocations = 0;
+	pxHeapStats->xNumberOfSuccessfulFrees = 0;
+
+	for( uxClass = 0; uxClass < ( UBaseType_t ) portHEAP_STATS_SIZE_CLASSES; uxClass++ )
+	{
+		pxHeapStats->xFreeBlocksBySize[ uxClass ] = 0;
+	}
+
+	vTaskSuspendAll();
+	{
+		for( uxRegion = 0; uxRegion < uxNumberOfRegions; uxRegion++ )
+		{
+			prvAddRegionStats( &( xHeapRegions[ uxRegion ] ), pxHeapStats );
+		}
+
+		/* The regions did not all reach their minimums at the same time, so
+		the minimum for the whole heap is tracked separately. */
+		pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapRegionStats( UBaseType_t uxRegion, HeapStats_t *pxHeapStats )
+{
+UBaseType_t uxClass;
+
+	configASSERT( uxRegion < uxNumberOfRegions );
+
+	pxHeapStats->xSizeOfLargestFreeBlockInBytes = 0;
+	pxHeapStats->xSizeOfSmallestFreeBlockInBytes = 0;
+	pxHeapStats->xNumberOfFreeBlocks = 0;
+	pxHeapStats->xAvailableHeapSpaceInBytes = 0;
+	pxHeapStats->xNumberOfSuccessfulAllocations = 0;
+	pxHeapStats->xNumberOfSuccessfulFrees = 0;
+
+	for( uxClass = 0; uxClass < ( UBaseType_t ) portHEAP_STATS_SIZE_CLASSES; uxClass++ )
+	{
+		pxHeapStats->xFreeBlocksBySize[ uxClass ] = 0;
+	}
+
+	vTaskSuspendAll();
+	{
+		prvAddRegionStats( &( xHeapRegions[ uxRegion ] ), pxHeapStats );
+		pxHeapStats->xMinimumEverFreeBytesRemaining = xHeapRegions[ uxRegion ].xMinimumEverFreeBytesRemaining;
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions )
+{
+HeapRegionState_t *pxRegion;
+BlockLink_t *pxFirstFreeBlock;
+size_t xAlignedHeap;
+size_t xTotalRegionSize, xAddress;
+const HeapRegion_t *pxHeapRegion;
+
+	/* Can only call once! */
+	configASSERT( uxNumberOfRegions == 0 );
+
+	pxHeapRegion = pxHeapRegions;
+
+	while( pxHeapRegion->xSizeInBytes > 0 )
+	{
+		configASSERT( uxNumberOfRegions < ( UBaseType_t ) configHEAP_MAX_REGIONS );
+		pxRegion = &( xHeapRegions[ uxNumberOfRegions ] );
+
+		xTotalRegionSize = pxHeapRegion->xSizeInBytes;
+
+		/* Ensure the heap region starts on a correctly aligned boundary. */
+		xAddress = ( size_t ) pxHeapRegion->pucStartAddress;
+		if( ( xAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+		{
+			xAddress += ( portBYTE_ALIGNMENT - 1 );
+			xAddress &= ~portBYTE_ALIGNMENT_MASK;
+
+			/* Adjust the size for the bytes lost to alignment. */
+			xTotalRegionSize -= xAddress - ( size_t ) pxHeapRegion->pucStartAddress;
+		}
+
+		xAlignedHeap = xAddress;
+
+		/* xStart is used to hold a pointer to the first item in the list of
+		free blocks in the region.  The void cast is used to prevent compiler
+		warnings. */
+		pxRegion->xStart.pxNextFreeBlock = ( BlockLink_t * ) xAlignedHeap;
+		pxRegion->xStart.xBlockSize = ( size_t ) 0;
+		pxRegion->pucStartAddress = ( uint8_t * ) xAlignedHeap;
+
+		/* pxEnd is used to mark the end of the list of free blocks and is
+		inserted at the end of the region space. */
+		xAddress = xAlignedHeap + xTotalRegionSize;
+		xAddress -= xHeapStructSize;
+		xAddress &= ~portBYTE_ALIGNMENT_MASK;
+		pxRegion->pxEnd = ( BlockLink_t * ) xAddress;
+		pxRegion->pxEnd->xBlockSize = 0;
+		pxRegion->pxEnd->pxNextFreeBlock = NULL;
+
+		/* To start with there is a single free block in the region, that is
+		sized to take up the entire region, minus the space taken by pxEnd. */
+		pxFirstFreeBlock = ( BlockLink_t * ) xAlignedHeap;
+		pxFirstFreeBlock->xBlockSize = xAddress - ( size_t ) pxFirstFreeBlock;
+		pxFirstFreeBlock->pxNextFreeBlock = pxRegion->pxEnd;
+
+		pxRegion->uxTags = pxHeapRegion->uxTags;
+		pxRegion->xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+		pxRegion->xMinimumEverFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+		pxRegion->xNumberOfSuccessfulAllocations = 0;
+		pxRegion->xNumberOfSuccessfulFrees = 0;
+		xFreeBytesRemaining += pxFirstFreeBlock->xBlockSize;
+
+		/* Move onto the next HeapRegion_t structure. */
+		uxNumberOfRegions++;
+		pxHeapRegion = &( pxHeapRegions[ uxNumberOfRegions ] );
+	}
+
+	xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+
+	/* Check something was actually defined before it is accessed. */
+	configASSERT( xFreeBytesRemaining );
+
+	/* Work out the position of the top bit in a size_t variable. */
+	xBlockAllocatedBit = ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 );
+}
+/*-----------------------------------------------------------*/
+
+static void *prvAllocate( size_t xWantedSize, UBaseType_t uxTags )
+{
+HeapRegionState_t *pxRegion;
+UBaseType_t uxRegion, uxPass;
+BaseType_t xHasAllTags;
+void *pvReturn = NULL;
+
+	/* The heap must be initialised before the first call to
+	pvPortMalloc(). */
+	configASSERT( uxNumberOfRegions > 0 );
+
+	/* Check the requested block size is not so large that the top bit is set.
+	The top bit of the block size member of the BlockLink_t structure is used
+	to determine who owns the block - the application or the kernel, so it
+	must be free. */
+	if( ( xWantedSize & xBlockAllocatedBit ) == 0 )
+	{
+		/* The wanted size is increased so it can contain a BlockLink_t
+		structure in addition to the requested amount of bytes. */
+		if( xWantedSize > 0 )
+		{
+			xWantedSize += xHeapStructSize;
+
+			/* Ensure that blocks are always aligned to the required number of
+			bytes. */
+			if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+			{
+				/* Byte alignment required. */
+				xWantedSize += ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) );
+				configASSERT( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) == 0 );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+		{
+			/* The first pass only tries the regions that have all the
+			requested tags.  The second pass falls back to the regions that do
+			not, provided they have the tags that are requirements rather than
+			hints. */
+			for( uxPass = 0; ( uxPass < ( UBaseType_t ) 2 ) && ( pvReturn == NULL ); uxPass++ )
+			{
+				for( uxRegion = 0; ( uxRegion < uxNumberOfRegions ) && ( pvReturn == NULL ); uxRegion++ )
+				{
+					pxRegion = &( xHeapRegions[ uxRegion ] );
+					xHasAllTags = ( ( pxRegion->uxTags & uxTags ) == uxTags ) ? pdTRUE : pdFALSE;
+
+					if( uxPass == ( UBaseType_t ) 0 )
+					{
+						if( xHasAllTags != pdFALSE )
+						{
+							pvReturn = prvAllocateFromRegion( pxRegion, xWantedSize );
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						if( ( xHasAllTags == pdFALSE ) && ( ( pxRegion->uxTags & uxTags & heapREQUIRED_TAGS ) == ( uxTags & heapREQUIRED_TAGS ) ) )
+						{
+							pvReturn = prvAllocateFromRegion( pxRegion, xWantedSize );
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+				}
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvAllocateFromRegion( HeapRegionState_t *pxRegion, size_t xBlockSize )
+{
+BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
+void *pvReturn = NULL;
+
+	if( xBlockSize <= pxRegion->xFreeBytesRemaining )
+	{
+		/* Traverse the list from the start	(lowest address) block until one
+		of adequate size is found. */
+		pxPreviousBlock = &( pxRegion->xStart );
+		pxBlock = pxRegion->xStart.pxNextFreeBlock;
+		while( ( pxBlock->xBlockSize < xBlockSize ) && ( pxBlock->pxNextFreeBlock != NULL ) )
+		{
+			pxPreviousBlock = pxBlock;
+			pxBlock = pxBlock->pxNextFreeBlock;
+		}
+
+		/* If the end marker was reached then a block of adequate size was not
+		found. */
+		if( pxBlock != pxRegion->pxEnd )
+		{
+			/* Return the memory space pointed to - jumping over the
+			BlockLink_t structure at its start. */
+			pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+
+			/* This block is being returned for use so must be taken out of
+			the list of free blocks. */
+			pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+			/* If the block is larger than required it can be split into
+			two. */
+			if( ( pxBlock->xBlockSize - xBlockSize ) > heapMINIMUM_BLOCK_SIZE )
+			{
+				/* This block is to be split into two.  Create a new block
+				following the number of bytes requested. The void cast is used
+				to prevent byte alignment warnings from the compiler. */
+				pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xBlockSize );
+				configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+				/* Calculate the sizes of two blocks split from the single
+				block. */
+				pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xBlockSize;
+				pxBlock->xBlockSize = xBlockSize;
+
+				/* The new block takes the place of the block being allocated
+				in the list of free blocks.  It cannot be adjacent to either of
+				its neighbours, as the block it was split from was not, so it
+				is linked in directly rather than by searching the list for its
+				position. */
+				pxNewBlockLink->pxNextFreeBlock = pxPreviousBlock->pxNextFreeBlock;
+				pxPreviousBlock->pxNextFreeBlock = pxNewBlockLink;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxRegion->xFreeBytesRemaining -= pxBlock->xBlockSize;
+			xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+			if( pxRegion->xFreeBytesRemaining < pxRegion->xMinimumEverFreeBytesRemaining )
+			{
+				pxRegion->xMinimumEverFreeBytesRemaining = pxRegion->xFreeBytesRemaining;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+			{
+				xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* The block is being returned - it is allocated and owned by the
+			application and has no "next" block. */
+			pxBlock->xBlockSize |= xBlockAllocatedBit;
+			pxBlock->pxNextFreeBlock = NULL;
+			( pxRegion->xNumberOfSuccessfulAllocations )++;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList( HeapRegionState_t *pxRegion, BlockLink_t *pxBlockToInsert )
+{
+BlockLink_t *pxIterator;
+uint8_t *puc;
+
+	/* Iterate through the list until a block is found that has a higher
+	address than the block being inserted. */
+	for( pxIterator = &( pxRegion->xStart ); pxIterator->pxNextFreeBlock < pxBlockToInsert; pxIterator = pxIterator->pxNextFreeBlock )
+	{
+		/* Nothing to do here, just iterate to the right position. */
+	}
+
+	/* Do the block being inserted, and the block it is being inserted after
+	make a contiguous block of memory? */
+	puc = ( uint8_t * ) pxIterator;
+	if( ( puc + pxIterator->xBlockSize ) == ( uint8_t * ) pxBlockToInsert )
+	{
+		pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
+		pxBlockToInsert = pxIterator;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Do the block being inserted, and the block it is being inserted before
+	make a contiguous block of memory? */
+	puc = ( uint8_t * ) pxBlockToInsert;
+	if( ( puc + pxBlockToInsert->xBlockSize ) == ( uint8_t * ) pxIterator->pxNextFreeBlock )
+	{
+		if( pxIterator->pxNextFreeBlock != pxRegion->pxEnd )
+		{
+			/* Form one big block from the two blocks. */
+			pxBlockToInsert->xBlockSize += pxIterator->pxNextFreeBlock->xBlockSize;
+			pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock->pxNextFreeBlock;
+		}
+		else
+		{
+			pxBlockToInsert->pxNextFreeBlock = pxRegion->pxEnd;
+		}
+	}
+	else
+	{
+		pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock;
+	}
+
+	/* If the block being inserted plugged a gab, so was merged with the block
+	before and the block after, then it's pxNextFreeBlock pointer will have
+	already been set, and should not be set here as that would make it point
+	to itself. */
+	if( pxIterator != pxBlockToInsert )
+	{
+		pxIterator->pxNextFreeBlock = pxBlockToInsert;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvAddRegionStats( const HeapRegionState_t *pxRegion, HeapStats_t *pxHeapStats )
+{
+const BlockLink_t *pxBlock;
+
+	pxBlock = pxRegion->xStart.pxNextFreeBlock;
+
+	while( pxBlock != pxRegion->pxEnd )
+	{
+		prvCountFreeBlock( pxHeapStats, pxBlock->xBlockSize );
+		pxBlock = pxBlock->pxNextFreeBlock;
+	}
+
+	pxHeapStats->xAvailableHeapSpaceInBytes += pxRegion->xFreeBytesRemaining;
+	pxHeapStats->xNumberOfSuccessfulAllocations += pxRegion->xNumberOfSuccessfulAllocations;
+	pxHeapStats->xNumberOfSuccessfulFrees += pxRegion->xNumberOfSuccessfulFrees;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCountFreeBlock( HeapStats_t *pxHeapStats, size_t xBlockSize )
+{
+UBaseType_t uxClass = 0;
+
+	if( ( pxHeapStats->xNumberOfFreeBlocks == ( size_t ) 0 ) || ( xBlockSize < pxHeapStats->xSizeOfSmallestFreeBlockInBytes ) )
+	{
+		pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xBlockSize;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( xBlockSize > pxHeapStats->xSizeOfLargestFreeBlockInBytes )
+	{
+		pxHeapStats->xSizeOfLargestFreeBlockInBytes = xBlockSize;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Find the size class of the block.  The last class also holds all the
+	blocks that are larger than the classes before it. */
+	while( ( uxClass < ( ( UBaseType_t ) portHEAP_STATS_SIZE_CLASSES - ( UBaseType_t ) 1 ) ) && ( xBlockSize >= ( heapSTATS_FIRST_CLASS_LIMIT << uxClass ) ) )
+	{
+		uxClass++;
+	}
+
+	( pxHeapStats->xFreeBlocksBySize[ uxClass ] )++;
+	( pxHeapStats->xNumberOfFreeBlocks )++;
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to use heap_regions.c.  If you want to use this allocator then ensure
+configUSE_REGION_HEAP is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_REGION_HEAP == 1 */
@@ -500,6 +500,16 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_
  * context of the timer task - where a scheduler lock is used in place of a
  * critical section.
  *
+ * If configUSE_DIRECT_EVENT_GROUP_SET_FROM_ISR is set to 1 in FreeRTOSConfig.h
+ * then the bits are instead set, and the tasks waiting for them unblocked,
+ * directly within the interrupt - provided no more than
+ * configEVENT_GROUP_SET_BITS_FROM_ISR_BUDGET waiting tasks have to be visited
+ * to do so, which bounds the time interrupts are masked.  Setting
+ * configUSE_EVENT_GROUP_BIT_INDEXED_WAITERS to 1 limits the tasks visited to
+ * those that are waiting for one of the bits being set.  The timer task is
+ * still used if more tasks are waiting, if the scheduler is suspended, or if
+ * the timer task has still to set the bits from an earlier call.
+ *
  * @param xEventGroup The event group in which the bits are to be set.
  *
  * @param uxBitsToSet A bitwise value that indicates the bit or bits to set.
@@ -514,11 +524,14 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_
  * xEventGroupSetBitsFromISR(), indicating that a context switch should be
  * requested before the interrupt exits.  For that reason
  * *pxHigherPriorityTaskWoken must be initialised to pdFALSE.  See the
- * example code below.
+ * example code below.  When the bits are set directly it is a task unblocked by
+ * the bits being set, rather than the timer daemon task, that has its priority
+ * compared to the priority of the currently running task.
  *
  * @return If the request to execute the function was posted successfully then
  * pdPASS is returned, otherwise pdFALSE is returned.  pdFALSE will be returned
- * if the timer service queue was full.
+ * if the timer service queue was full.  pdPASS is always returned when the bits
+ * are set directly.
  *
  * Example usage:
    <pre>
@@ -556,7 +569,7 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_
  * \defgroup xEventGroupSetBitsFromISR xEventGroupSetBitsFromISR
  * \ingroup EventGroup
  */
-#if( configUSE_TRACE_FACILITY == 1 )
+#if( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_DIRECT_EVENT_GROUP_SET_FROM_ISR == 1 ) )
 	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 #else
 	#define xEventGroupSetBitsFromISR( xEventGroup, uxBitsToSet, pxHigherPriorityTaskWoken ) xTimerPendFunctionCallFromISR( vEventGroupSetBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToSet, pxHigherPriorityTaskWoken )
@@ -0,0 +1,284 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef HEAP_TRACKER_H
+#define HEAP_TRACKER_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include heap_tracker.h"
+#endif
+
+/* FreeRTOS includes. */
+#include "task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The heap tracker implements the traceMALLOC() and traceFREE() hooks of the
+ * heap to record every live allocation in a side table - its address, its
+ * size, the task that owns it, the return address of the code that called
+ * pvPortMalloc() and the tick count at which it was made.  From that table the
+ * heap use of each call site can be reported, together with the call sites
+ * holding the most memory and the allocations that have outlived the task that
+ * owns them, which are suspected leaks.
+ *
+ * The task that allocates a block owns it.  Blocks allocated before the
+ * scheduler is started, or from an interrupt, have no owner and are never
+ * reported as leaks.  The TCB and stack of a task created with xTaskCreate()
+ * are owned by the task itself rather than by the task that created it.
+ * vHeapTrackerSetOwner() hands a block, such as a queue or a buffer passed
+ * between tasks, on to another task.
+ *
+ * The sizes recorded are those the heap passes to traceMALLOC().  heap_4.c
+ * passes the size of the block including its header and alignment padding,
+ * heap_tlsf.c passes the size that was requested.
+ *
+ * The side table holds configHEAP_TRACKER_TABLE_SIZE allocations, and up to
+ * configHEAP_TRACKER_CALL_SITES different call sites are recorded.
+ * Allocations that do not fit are counted, but not tracked.  Each allocation
+ * and free adds a hash table lookup with interrupts masked - measured by
+ * bench_heap_tracker on the host simulator, a pvPortMalloc() and vPortFree()
+ * pair takes about 20 ns more with the tracker.  Each entry of the side table
+ * takes 20 bytes on a 32-bit MCU.
+ *
+ * configUSE_HEAP_TRACKER must be set to 1 in FreeRTOSConfig.h for the tracker
+ * to be available, in which case traceMALLOC() and traceFREE() must not be
+ * defined by the application.
+ *
+ * \defgroup HeapTracker
+ */
+
+/**
+ * heap_tracker.h
+ *
+ * Used with uxHeapTrackerGetCallSites() and uxHeapTrackerGetTopCallSites() to
+ * obtain the totals of each call site.
+ *
+ * \ingroup HeapTracker
+ */
+typedef struct xHEAP_TRACKER_CALL_SITE
+{
+	void *pvCaller;					/* The return address of the call to pvPortMalloc(). */
+	size_t xLiveBytes;				/* The bytes currently allocated from the call site. */
+	size_t xPeakLiveBytes;			/* The most bytes that have been allocated from the call site at any one time. */
+	UBaseType_t uxLiveBlocks;		/* The number of blocks currently allocated from the call site. */
+	uint32_t ulAllocations;			/* The number of successful allocations made from the call site. */
+	uint32_t ulFailedAllocations;	/* The number of allocations from the call site that returned NULL. */
+} HeapTrackerCallSite_t;
+
+/**
+ * heap_tracker.h
+ *
+ * Used with uxHeapTrackerGetAllocations() and uxHeapTrackerGetLeaks() to
+ * obtain the details of live allocations.
+ *
+ * \ingroup HeapTracker
+ */
+typedef struct xHEAP_TRACKER_ALLOCATION
+{
+	void *pvAddress;				/* The address returned by pvPortMalloc(). */
+	size_t xSize;					/* The size passed to traceMALLOC(). */
+	void *pvCaller;					/* The return address of the call to pvPortMalloc(). */
+	TaskHandle_t xOwner;			/* The task that owns the block, or NULL if it has no owner.  The handle is no longer valid if xOwnerDeleted is pdTRUE. */
+	TickType_t xTimeAllocated;		/* The tick count at which the block was allocated. */
+	BaseType_t xOwnerDeleted;		/* pdTRUE if the task that owns the block has been deleted, so the block is a suspected leak. */
+} HeapTrackerAllocation_t;
+
+/**
+ * heap_tracker.h
+ *
+ * Used with vHeapTrackerGetStats() to obtain the overall statistics of the
+ * tracker.
+ *
+ * \ingroup HeapTracker
+ */
+typedef struct xHEAP_TRACKER_STATS
+{
+	UBaseType_t uxTrackedBlocks;	/* The number of live allocations in the side table. */
+	size_t xTrackedBytes;			/* The total size of the live allocations in the side table. */
+	UBaseType_t uxCallSites;		/* The number of different call sites recorded. */
+	UBaseType_t uxSuspectedLeaks;	/* The number of live allocations whose owner has been deleted. */
+	size_t xSuspectedLeakBytes;		/* The total size of the live allocations whose owner has been deleted. */
+	uint32_t ulUntrackedAllocations;	/* The number of allocations that were not tracked because the side table or the call site table was full. */
+} HeapTrackerStats_t;
+
+/**
+ * heap_tracker.h
+ *<pre>
+ UBaseType_t uxHeapTrackerGetCallSites( HeapTrackerCallSite_t *pxCallSites, UBaseType_t uxMaxCallSites );
+ </pre>
+ *
+ * Obtain the totals of every call site recorded, in no particular order.
+ *
+ * @param pxCallSites An array into which the totals are written.
+ *
+ * @param uxMaxCallSites The number of elements in pxCallSites.
+ *
+ * @return The number of elements written to pxCallSites.
+ *
+ * \defgroup uxHeapTrackerGetCallSites uxHeapTrackerGetCallSites
+ * \ingroup HeapTracker
+ */
+UBaseType_t uxHeapTrackerGetCallSites( HeapTrackerCallSite_t *pxCallSites, UBaseType_t uxMaxCallSites ) PRIVILEGED_FUNCTION;
+
+/**
+ * heap_tracker.h
+ *<pre>
+ UBaseType_t uxHeapTrackerGetTopCallSites( HeapTrackerCallSite_t *pxCallSites, UBaseType_t uxCount );
+ </pre>
+ *
+ * Obtain the totals of the uxCount call sites that currently hold the most
+ * memory, sorted by the number of live bytes, largest first.  Call sites that
+ * hold no memory are not included.
+ *
+ * @param pxCallSites An array of uxCount elements into which the totals are
+ * written.
+ *
+ * @param uxCount The number of call sites to obtain.
+ *
+ * @return The number of elements written to pxCallSites.
+ *
+ * Example usage:
+   <pre>
+	void vPrintTopAllocators( void )
+	{
+	HeapTrackerCallSite_t xSites[ 5 ];
+	UBaseType_t x, uxCount;
+
+		uxCount = uxHeapTrackerGetTopCallSites( xSites, 5 );
+
+		for( x = 0; x < uxCount; x++ )
+		{
+			printf( "%p: %u bytes in %u blocks\r\n", xSites[ x ].pvCaller, ( unsigned ) xSites[ x ].xLiveBytes, ( unsigned ) xSites[ x ].uxLiveBlocks );
+		}
+	}
+   </pre>
+ * \defgroup uxHeapTrackerGetTopCallSites uxHeapTrackerGetTopCallSites
+ * \ingroup HeapTracker
+ */
+UBaseType_t uxHeapTrackerGetTopCallSites( HeapTrackerCallSite_t *pxCallSites, UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
+/**
+ * heap_tracker.h
+ *<pre>
+ UBaseType_t uxHeapTrackerGetAllocations( HeapTrackerAllocation_t *pxAllocations, UBaseType_t uxMaxAllocations );
+ </pre>
+ *
+ * Obtain the details of the live allocations in the side table, in no
+ * particular order.  Interrupts are masked while the side table is copied, for
+ * a time proportional to configHEAP_TRACKER_TABLE_SIZE, so this is a
+ * diagnostic function that should not be called where interrupt latency
+ * matters.
+ *
+ * @param pxAllocations An array into which the details are written.
+ *
+ * @param uxMaxAllocations The number of elements in pxAllocations.
+ *
+ * @return The number of elements written to pxAllocations.
+ *
+ * \defgroup uxHeapTrackerGetAllocations uxHeapTrackerGetAllocations
+ * \ingroup HeapTracker
+ */
+UBaseType_t uxHeapTrackerGetAllocations( HeapTrackerAllocation_t *pxAllocations, UBaseType_t uxMaxAllocations ) PRIVILEGED_FUNCTION;
+
+/**
+ * heap_tracker.h
+ *<pre>
+ UBaseType_t uxHeapTrackerGetLeaks( HeapTrackerAllocation_t *pxAllocations, UBaseType_t uxMaxAllocations );
+ </pre>
+ *
+ * As uxHeapTrackerGetAllocations(), but only the allocations whose owner has
+ * been deleted are written to pxAllocations.
+ *
+ * Example usage:
+   <pre>
+	void vCheckForLeaks( void )
+	{
+	HeapTrackerAllocation_t xLeaks[ 8 ];
+	UBaseType_t x, uxCount;
+
+		uxCount = uxHeapTrackerGetLeaks( xLeaks, 8 );
+
+		for( x = 0; x < uxCount; x++ )
+		{
+			printf( "%u bytes at %p allocated by %p at tick %u\r\n", ( unsigned ) xLeaks[ x ].xSize, xLeaks[ x ].pvAddress, xLeaks[ x ].pvCaller, ( unsigned ) xLeaks[ x ].xTimeAllocated );
+		}
+	}
+   </pre>
+ * \defgroup uxHeapTrackerGetLeaks uxHeapTrackerGetLeaks
+ * \ingroup HeapTracker
+ */
+UBaseType_t uxHeapTrackerGetLeaks( HeapTrackerAllocation_t *pxAllocations, UBaseType_t uxMaxAllocations ) PRIVILEGED_FUNCTION;
+
+/**
+ * heap_tracker.h
+ *<pre>
+ void vHeapTrackerGetStats( HeapTrackerStats_t *pxStats );
+ </pre>
+ *
+ * Obtain the overall statistics of the tracker.  Takes a constant time.
+ *
+ * @param pxStats The structure into which the statistics are written.
+ *
+ * \defgroup vHeapTrackerGetStats vHeapTrackerGetStats
+ * \ingroup HeapTracker
+ */
+void vHeapTrackerGetStats( HeapTrackerStats_t *pxStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * heap_tracker.h
+ *<pre>
+ void vHeapTrackerSetOwner( void *pvAddress, TaskHandle_t xOwner );
+ </pre>
+ *
+ * Transfer the ownership of an allocated block to another task, so the block
+ * is not reported as a leak when the task that allocated it is deleted.
+ *
+ * @param pvAddress The address returned by pvPortMalloc().
+ *
+ * @param xOwner The task that becomes the owner of the block.  Passing NULL
+ * leaves the block without an owner, so it is never reported as a leak.
+ *
+ * \defgroup vHeapTrackerSetOwner vHeapTrackerSetOwner
+ * \ingroup HeapTracker
+ */
+void vHeapTrackerSetOwner( void *pvAddress, TaskHandle_t xOwner ) PRIVILEGED_FUNCTION;
+
+/*
+ * THE FOLLOWING FUNCTION IS FOR KERNEL USE ONLY.  It is called by tasks.c
+ * when a task is deleted, before the task's TCB and stack are freed, to mark
+ * the blocks the task still owns as suspected leaks.
+ */
+void vHeapTrackerTaskDeleted( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HEAP_TRACKER_H */
@@ -0,0 +1,149 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef SLAB_H
+#define SLAB_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include slab.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * When configUSE_SLAB_CACHES is 1 the control blocks of tasks, queues
+ * (including semaphores and mutexes), software timers and event groups are
+ * not allocated with pvPortMalloc(), but from a slab cache per object type.
+ * Each cache holds objects of a single size in slabs - arrays of objects
+ * allocated from the FreeRTOS heap - and links the free objects into a list,
+ * so allocating and freeing an object takes a constant time.  Objects are
+ * never returned to the FreeRTOS heap, so the memory of a deleted object is
+ * only ever reused for an object of the same type, and the heap does not
+ * fragment as objects are created and deleted.
+ *
+ * The first slab of each cache is allocated the first time an object of any
+ * type is created, holding the number of objects set by
+ * configSLAB_CACHE_TASKS, configSLAB_CACHE_QUEUES, configSLAB_CACHE_TIMERS
+ * and configSLAB_CACHE_EVENT_GROUPS.  While a cache has free objects,
+ * creating an object of its type takes a deterministic time.  When a cache
+ * runs out it grows by a slab of configSLAB_CACHE_GROW_OBJECTS objects, or the
+ * creation fails if configSLAB_CACHE_GROW_OBJECTS is 0.
+ *
+ * A queue's storage area, and a task's stack, have a size that depends on the
+ * object, so are still allocated with pvPortMalloc().
+ *
+ * The size of the objects in each cache is taken from the StaticTask_t,
+ * StaticQueue_t, StaticTimer_t and StaticEventGroup_t structures.
+ *
+ * \defgroup SlabCache
+ */
+
+/**
+ * slab.h
+ *
+ * The slab caches, one per type of kernel object.
+ *
+ * \ingroup SlabCache
+ */
+typedef enum
+{
+	eSlabCacheTask = 0,		/* Task control blocks. */
+	eSlabCacheQueue,		/* Queues, semaphores and mutexes. */
+	eSlabCacheTimer,		/* Software timers. */
+	eSlabCacheEventGroup	/* Event groups. */
+} eSlabCache;
+
+/* The number of slab caches. */
+#define slabNUMBER_OF_CACHES	4
+
+/**
+ * slab.h
+ *
+ * Used with vSlabCacheGetStats() to obtain the usage statistics of a slab
+ * cache.
+ *
+ * \ingroup SlabCache
+ */
+typedef struct xSLAB_CACHE_STATS
+{
+	size_t xObjectSize;					/* The size of each object, rounded up to a multiple of portBYTE_ALIGNMENT. */
+	size_t xBytesReserved;				/* The number of bytes the cache holds in all its slabs. */
+	UBaseType_t uxSlabs;				/* The number of slabs the cache holds, including the first. */
+	UBaseType_t uxObjects;				/* The total number of objects in the slabs. */
+	UBaseType_t uxObjectsInUse;			/* The number of objects currently allocated. */
+	UBaseType_t uxMaximumObjectsInUse;	/* The most objects that have been allocated at any one time. */
+	uint32_t ulAllocations;				/* The number of successful allocations. */
+	uint32_t ulFailedAllocations;		/* The number of allocations that returned NULL because the cache was empty and could not grow. */
+} SlabCacheStats_t;
+
+/**
+ * slab.h
+ *<pre>
+ void vSlabCacheGetStats( eSlabCache eCache, SlabCacheStats_t *pxStats );
+ </pre>
+ *
+ * Obtain the usage statistics of a slab cache, including the memory it holds.
+ *
+ * @param eCache The cache being queried.
+ *
+ * @param pxStats The structure into which the statistics are written.
+ *
+ * Example usage:
+   <pre>
+	void vPrintSlabCaches( void )
+	{
+	SlabCacheStats_t xStats;
+	eSlabCache eCache;
+
+		for( eCache = eSlabCacheTask; eCache <= eSlabCacheEventGroup; eCache++ )
+		{
+			vSlabCacheGetStats( eCache, &xStats );
+			printf( "%u of %u objects in use, %u bytes\r\n", ( unsigned ) xStats.uxObjectsInUse, ( unsigned ) xStats.uxObjects, ( unsigned ) xStats.xBytesReserved );
+		}
+	}
+   </pre>
+ * \defgroup vSlabCacheGetStats vSlabCacheGetStats
+ * \ingroup SlabCache
+ */
+void vSlabCacheGetStats( eSlabCache eCache, SlabCacheStats_t *pxStats ) PRIVILEGED_FUNCTION;
+
+/*
+ * THE FOLLOWING FUNCTIONS ARE FOR KERNEL USE ONLY.  They allocate an object
+ * from a slab cache, returning NULL if the cache is empty and cannot grow, and
+ * return an object to the cache it was allocated from.  They must not be
+ * called from an interrupt.
+ */
+void *pvSlabAlloc( eSlabCache eCache ) PRIVILEGED_FUNCTION;
+void vSlabFree( eSlabCache eCache, void *pvObject ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SLAB_H */
@@ -38,6 +38,9 @@ task.h is included from an application file. */
 #include "FreeRTOS.h"
 #include "task.h"
 #include "timers.h"
+#include "arena.h"
+#include "heap_tracker.h"
+#include "slab.h"
 #include "stack_macros.h"
 
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
@@ -64,7 +67,8 @@ functions but without including stdio.h here. */
 	#define taskYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
 #endif
 
-/* Values that can be assigned to the ucNotifyState member of the TCB. */
+/* Values that can be assigned to the entries of the ucNotifyState member of
+the TCB. */
 #define taskNOT_WAITING_NOTIFICATION	( ( uint8_t ) 0 )
 #define taskWAITING_NOTIFICATION		( ( uint8_t ) 1 )
 #define taskNOTIFICATION_RECEIVED		( ( uint8_t ) 2 )
@@ -97,6 +101,17 @@ changed then the definition of StaticTask_t must also be updated. */
 #define tskSTATICALLY_ALLOCATED_STACK_ONLY 			( ( uint8_t ) 1 )
 #define tskSTATICALLY_ALLOCATED_STACK_AND_TCB		( ( uint8_t ) 2 )
 
+/* When configUSE_SLAB_CACHES is 1 the TCBs of dynamically allocated tasks are
+taken from a slab cache rather than from the FreeRTOS heap.  Stacks are always
+allocated from the heap, as their size differs from task to task. */
+#if( configUSE_SLAB_CACHES == 1 )
+	#define prvAllocateTCB()		( ( TCB_t * ) pvSlabAlloc( eSlabCacheTask ) )
+	#define prvFreeTCB( pxTCB )		vSlabFree( eSlabCacheTask, ( pxTCB ) )
+#else
+	#define prvAllocateTCB()		( ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ) )
+	#define prvFreeTCB( pxTCB )		vPortFree( pxTCB )
+#endif
+
 /* If any of the following are set then task stacks are filled with a known
 value so the high water mark can be determined.  If none of the following are
 set then don't fill the stack so there is no unnecessary dependency on memset. */
@@ -272,6 +287,17 @@ to its original value when it is released. */
 	#define taskEVENT_LIST_ITEM_VALUE_IN_USE	0x80000000UL
 #endif
 
+/* A task waiting on a semaphore with vTaskPlaceOnEventListWithCount() keeps
+the count it needs in the low bits of its event list item value, below its
+priority. */
+#if( configUSE_16_BIT_TICKS == 1 )
+	#define taskEVENT_LIST_ITEM_COUNT_BITS		8U
+	#define taskEVENT_LIST_ITEM_COUNT_MASK		0xffU
+#else
+	#define taskEVENT_LIST_ITEM_COUNT_BITS		16U
+	#define taskEVENT_LIST_ITEM_COUNT_MASK		0xffffUL
+#endif
+
 /*
  * Task control block.  A task control block (TCB) is allocated for each task,
  * and stores task state information, including a pointer to the task's context
@@ -309,6 +335,10 @@ typedef struct tskTaskControlBlock /* The old naming convention is used to preve
 		UBaseType_t		uxMutexesHeld;
 	#endif
 
+	#if ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 )
+		void			*pvMutexBlockedOn;	/*< The mutex the task is blocked waiting to take, if any.  Used to pass inherited priorities along chains of mutex holders. */
+	#endif
+
 	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
 		TaskHookFunction_t pxTaskTag;
 	#endif
@@ -333,8 +363,8 @@ typedef struct tskTaskControlBlock /* The old naming convention is used to preve
 	#endif
 
 	#if( configUSE_TASK_NOTIFICATIONS == 1 )
-		volatile uint32_t ulNotifiedValue;
-		volatile uint8_t ucNotifyState;
+		volatile uint32_t ulNotifiedValue[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		volatile uint8_t ucNotifyState[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 
 	/* See the comments above the definition of
@@ -351,6 +381,10 @@ typedef struct tskTaskControlBlock /* The old naming convention is used to preve
 		int iTaskErrno;
 	#endif
 
+	#if( configUSE_ARENAS == 1 )
+		ArenaHandle_t	xArena;				/*< The arena bound to the task, if any, which is deleted along with the task. */
+	#endif
+
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -503,6 +537,13 @@ static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
  */
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseType_t xCanBlockIndefinitely ) PRIVILEGED_FUNCTION;
 
+/*
+ * Called by xTaskLimitBlockTime() and xTaskLimitBlockTimeFromISR() to ensure a
+ * blocked task leaves the Blocked state within xTicksToWait ticks.  Returns
+ * pdFAIL if the task is not in the Blocked state.
+ */
+static BaseType_t prvLimitBlockTime( TCB_t * const pxTCB, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /*
  * Fills an TaskStatus_t structure with information on each task that is
  * referenced from the pxList list (which may be a ready list, a delayed list,
@@ -569,6 +610,29 @@ static void prvResetNextTaskUnblockTime( void );
 
 #endif
 
+#if ( configUSE_MUTEXES == 1 )
+
+	/*
+	 * Raises the priority of the task that holds a mutex to
+	 * uxInheritedPriority should the holder have a lower priority.  Used by
+	 * both xTaskPriorityInherit() and xTaskPriorityInheritFrom().
+	 */
+	static BaseType_t prvInheritPriority( TaskHandle_t const pxMutexHolder, const UBaseType_t uxInheritedPriority ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 )
+
+	/*
+	 * Event lists are ordered by priority.  If the priority of a task that is
+	 * blocked on an event list changes then move the task to its new position
+	 * in the list, so the holder of a mutex further along a blocking chain
+	 * disinherits to the correct priority should a waiting task time out.
+	 */
+	static void prvReorderWithinEventList( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Called after a Task_t structure has been allocated either statically or
  * dynamically to fill in the structure's members.
@@ -718,7 +782,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			/* Allocate space for the TCB.  Where the memory comes from depends
 			on the implementation of the port malloc function and whether or
 			not static allocation is being used. */
-			pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+			pxNewTCB = prvAllocateTCB();
 
 			if( pxNewTCB != NULL )
 			{
@@ -742,6 +806,15 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 										pxCreatedTask, pxNewTCB,
 										pxTaskDefinition->xRegions );
 
+				#if( ( configUSE_HEAP_TRACKER == 1 ) && ( configUSE_SLAB_CACHES == 0 ) )
+				{
+					/* The TCB belongs to the new task rather than to the task
+					creating it.  A TCB taken from a slab cache is not a heap
+					block of its own. */
+					vHeapTrackerSetOwner( pxNewTCB, pxNewTCB );
+				}
+				#endif /* configUSE_HEAP_TRACKER */
+
 				prvAddNewTaskToReadyList( pxNewTCB );
 				xReturn = pdPASS;
 			}
@@ -773,7 +846,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			/* Allocate space for the TCB.  Where the memory comes from depends on
 			the implementation of the port malloc function and whether or not static
 			allocation is being used. */
-			pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+			pxNewTCB = prvAllocateTCB();
 
 			if( pxNewTCB != NULL )
 			{
@@ -785,7 +858,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 				if( pxNewTCB->pxStack == NULL )
 				{
 					/* Could not allocate the stack.  Delete the allocated TCB. */
-					vPortFree( pxNewTCB );
+					prvFreeTCB( pxNewTCB );
 					pxNewTCB = NULL;
 				}
 			}
@@ -800,7 +873,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			if( pxStack != NULL )
 			{
 				/* Allocate space for the TCB. */
-				pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
+				pxNewTCB = prvAllocateTCB(); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
 
 				if( pxNewTCB != NULL )
 				{
@@ -832,6 +905,23 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 			#endif /* configSUPPORT_STATIC_ALLOCATION */
 
 			prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
+
+			#if( configUSE_HEAP_TRACKER == 1 )
+			{
+				/* The TCB and stack belong to the new task rather than to the
+				task creating it, so they are not reported as leaks if the
+				creating task is deleted first.  A TCB taken from a slab cache
+				is not a heap block of its own, and may share its address with
+				the slab, which belongs to no task. */
+				#if( configUSE_SLAB_CACHES == 0 )
+				{
+					vHeapTrackerSetOwner( pxNewTCB, pxNewTCB );
+				}
+				#endif
+				vHeapTrackerSetOwner( pxNewTCB->pxStack, pxNewTCB );
+			}
+			#endif /* configUSE_HEAP_TRACKER */
+
 			prvAddNewTaskToReadyList( pxNewTCB );
 			xReturn = pdPASS;
 		}
@@ -956,6 +1046,12 @@ UBaseType_t x;
 	}
 	#endif /* configUSE_MUTEXES */
 
+	#if ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 )
+	{
+		pxNewTCB->pvMutexBlockedOn = NULL;
+	}
+	#endif
+
 	vListInitialiseItem( &( pxNewTCB->xStateListItem ) );
 	vListInitialiseItem( &( pxNewTCB->xEventListItem ) );
 
@@ -1007,8 +1103,11 @@ UBaseType_t x;
 
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 	{
-		pxNewTCB->ulNotifiedValue = 0;
-		pxNewTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+		for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+		{
+			pxNewTCB->ulNotifiedValue[ x ] = 0;
+			pxNewTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+		}
 	}
 	#endif
 
@@ -1025,6 +1124,12 @@ UBaseType_t x;
 	}
 	#endif
 
+	#if( configUSE_ARENAS == 1 )
+	{
+		pxNewTCB->xArena = NULL;
+	}
+	#endif
+
 	/* Initialize the TCB stack to look as if the task was already running,
 	but had been interrupted by the scheduler.  The return address is set
 	to the start of the task function. Once the stack has been initialised
@@ -1398,17 +1503,21 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					{
 						#if( configUSE_TASK_NOTIFICATIONS == 1 )
 						{
+						BaseType_t x;
+
 							/* The task does not appear on the event list item of
 							and of the RTOS objects, but could still be in the
-							blocked state if it is waiting on its notification
-							rather than waiting on an object. */
-							if( pxTCB->ucNotifyState == taskWAITING_NOTIFICATION )
-							{
-								eReturn = eBlocked;
-							}
-							else
+							blocked state if it is waiting on one of its
+							notifications rather than waiting on an object. */
+							eReturn = eSuspended;
+
+							for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
 							{
-								eReturn = eSuspended;
+								if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+								{
+									eReturn = eBlocked;
+									break;
+								}
 							}
 						}
 						#else
@@ -1713,11 +1822,16 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 			#if( configUSE_TASK_NOTIFICATIONS == 1 )
 			{
-				if( pxTCB->ucNotifyState == taskWAITING_NOTIFICATION )
+			BaseType_t x;
+
+				for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
 				{
-					/* The task was blocked to wait for a notification, but is
-					now suspended, so no notification was received. */
-					pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+					if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+					{
+						/* The task was blocked to wait for a notification, but is
+						now suspended, so no notification was received. */
+						pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+					}
 				}
 			}
 			#endif
@@ -2771,6 +2885,21 @@ BaseType_t xSwitchRequired = pdFALSE;
 		}
 		#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
 
+		#if ( configUSE_TICK_CONTEXT_TIMERS == 1 )
+		{
+			/* As with the tick hook, tick context timers have already been
+			processed for any pended ticks that are being unwound. */
+			if( uxPendedTicks == ( UBaseType_t ) 0U )
+			{
+				vTimerProcessTickContextTimers( xConstTickCount );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_TICK_CONTEXT_TIMERS */
+
 		#if ( configUSE_TICK_HOOK == 1 )
 		{
 			/* Guard against the tick hook being called when the pended tick
@@ -2790,6 +2919,14 @@ BaseType_t xSwitchRequired = pdFALSE;
 	{
 		++uxPendedTicks;
 
+		/* Tick context timers also run on time while the scheduler is locked,
+		using the tick count the pended ticks will take it to. */
+		#if ( configUSE_TICK_CONTEXT_TIMERS == 1 )
+		{
+			vTimerProcessTickContextTimers( xTickCount + ( TickType_t ) uxPendedTicks );
+		}
+		#endif /* configUSE_TICK_CONTEXT_TIMERS */
+
 		/* The tick hook gets called at regular intervals, even if the
 		scheduler is locked. */
 		#if ( configUSE_TICK_HOOK == 1 )
@@ -3157,6 +3294,325 @@ TCB_t *pxUnblockedTCB;
 }
 /*-----------------------------------------------------------*/
 
+BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem, const TickType_t xItemValue )
+{
+TCB_t *pxUnblockedTCB;
+BaseType_t xReturn;
+
+	/* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
+	called from a critical section within an ISR.  It is used by the event
+	flags implementation when bits are set directly from an interrupt. */
+
+	/* Store the new item value in the event list. */
+	listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+	pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+	configASSERT( pxUnblockedTCB );
+	( void ) uxListRemove( pxEventListItem );
+
+	if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+	{
+		( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
+		prvAddTaskToReadyList( pxUnblockedTCB );
+	}
+	else
+	{
+		/* The delayed and ready lists cannot be accessed, so hold this task
+		pending until the scheduler is resumed. */
+		vListInsertEnd( &( xPendingReadyList ), pxEventListItem );
+	}
+
+	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	{
+		/* Return true if the task removed from the event list has a higher
+		priority than the calling task, and mark that a yield is pending in
+		case the caller does not use the returned value. */
+		xReturn = pdTRUE;
+		xYieldPending = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	#if( configUSE_TICKLESS_IDLE != 0 )
+	{
+		/* See the comment in xTaskRemoveFromEventList(). */
+		prvResetNextTaskUnblockTime();
+	}
+	#endif
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+
+	void vTaskPlaceOnEventListWithCount( List_t * const pxEventList, const UBaseType_t uxCount, const TickType_t xTicksToWait )
+	{
+	TickType_t xItemValue;
+
+		configASSERT( pxEventList );
+		configASSERT( uxCount > ( UBaseType_t ) 0 );
+
+		/* The priority must fit in the bits above the count. */
+		configASSERT( ( TickType_t ) configMAX_PRIORITIES < ( taskEVENT_LIST_ITEM_VALUE_IN_USE >> taskEVENT_LIST_ITEM_COUNT_BITS ) );
+
+		/* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
+		SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+
+		/* The item value holds the priority above the count, so the list is
+		still in priority order.  The item is inserted as if the task needed
+		the largest count, which places it after every task of the same
+		priority already waiting, then the real count is filled in.  A count
+		too large to hold is recorded as the largest that can be held, which
+		can only cause the task to be unblocked early to check the count for
+		itself.  The task must call uxTaskResetEventItemValue() once it has
+		left the event list. */
+		xItemValue = taskEVENT_LIST_ITEM_VALUE_IN_USE | ( ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ) << taskEVENT_LIST_ITEM_COUNT_BITS ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_COUNT_MASK );
+		vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+		if( uxCount < ( UBaseType_t ) taskEVENT_LIST_ITEM_COUNT_MASK )
+		{
+			xItemValue |= ( TickType_t ) uxCount;
+		}
+		else
+		{
+			xItemValue |= taskEVENT_LIST_ITEM_COUNT_MASK;
+		}
+
+		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue );
+
+		prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+	}
+
+#endif /* configUSE_COUNTING_SEMAPHORES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+
+	BaseType_t xTaskRemoveFromEventListByCount( const List_t * const pxEventList, UBaseType_t uxCount )
+	{
+	const ListItem_t * const pxEndMarker = listGET_END_MARKER( pxEventList );
+	ListItem_t *pxIterator, *pxNext;
+	TCB_t *pxUnblockedTCB;
+	TickType_t xItemValue;
+	UBaseType_t uxNeeded;
+	BaseType_t xReturn = pdFALSE, xUnblocked = pdFALSE;
+
+		/* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
+		called from a critical section within an ISR.
+
+		The event list is in priority order.  Each task that needs no more than
+		what is left of uxCount is unblocked and its need taken from uxCount,
+		and a task that needs more is left blocked, so the walk stops as soon
+		as uxCount is used up.  A task that did not record a count is taken to
+		need one. */
+		for( pxIterator = listGET_HEAD_ENTRY( pxEventList ); ( pxIterator != pxEndMarker ) && ( uxCount > ( UBaseType_t ) 0 ); pxIterator = pxNext )
+		{
+			pxNext = listGET_NEXT( pxIterator );
+			xItemValue = listGET_LIST_ITEM_VALUE( pxIterator );
+
+			if( ( xItemValue & taskEVENT_LIST_ITEM_VALUE_IN_USE ) != 0UL )
+			{
+				uxNeeded = ( UBaseType_t ) ( xItemValue & taskEVENT_LIST_ITEM_COUNT_MASK );
+			}
+			else
+			{
+				uxNeeded = ( UBaseType_t ) 1;
+			}
+
+			if( uxNeeded <= uxCount )
+			{
+				uxCount -= uxNeeded;
+				pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+				/* As xTaskRemoveFromEventList(). */
+				( void ) uxListRemove( &( pxUnblockedTCB->xEventListItem ) );
+
+				if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+				{
+					( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
+					prvAddTaskToReadyList( pxUnblockedTCB );
+				}
+				else
+				{
+					vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
+				}
+
+				if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+				{
+					xReturn = pdTRUE;
+					xYieldPending = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xUnblocked = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		#if( configUSE_TICKLESS_IDLE != 0 )
+		{
+			/* See the comment in xTaskRemoveFromEventList(). */
+			if( xUnblocked != pdFALSE )
+			{
+				prvResetNextTaskUnblockTime();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#else
+		{
+			( void ) xUnblocked;
+		}
+		#endif
+
+		return xReturn;
+	}
+
+#endif /* configUSE_COUNTING_SEMAPHORES */
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskLimitBlockTime( TaskHandle_t xTask, TickType_t xTicksToWait )
+{
+	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  The delayed
+	task lists are only accessed by tasks with the scheduler suspended or from
+	a critical section, so that is sufficient protection. */
+	configASSERT( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE );
+	configASSERT( xTask );
+
+	return prvLimitBlockTime( xTask, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskLimitBlockTimeFromISR( TaskHandle_t xTask, TickType_t xTicksToWait )
+{
+BaseType_t xReturn;
+
+	/* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION, or from an ISR
+	with interrupts masked.  No task can be part way through updating a delayed
+	list unless the scheduler is suspended, in which case the lists cannot be
+	accessed and the caller must wake the task by other means. */
+	configASSERT( xTask );
+
+	if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+	{
+		xReturn = prvLimitBlockTime( xTask, xTicksToWait );
+	}
+	else
+	{
+		xReturn = pdFAIL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvLimitBlockTime( TCB_t * const pxTCB, TickType_t xTicksToWait )
+{
+const List_t * const pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
+const TickType_t xConstTickCount = xTickCount;
+TickType_t xTimeToWake;
+BaseType_t xMove = pdFALSE, xReturn = pdFAIL;
+
+	if( ( pxStateList == pxDelayedTaskList ) || ( pxStateList == pxOverflowDelayedTaskList ) )
+	{
+		xReturn = pdPASS;
+
+		/* The task is blocked with a timeout.  Every wake time held in the
+		delayed lists is later than the current tick count, so the number of
+		ticks remaining can be calculated without concern for overflow.  Only
+		move the task if it would otherwise wake later than requested. */
+		if( ( TickType_t ) ( listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) ) - xConstTickCount ) > xTicksToWait )
+		{
+			xMove = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#if ( INCLUDE_vTaskSuspend == 1 )
+		else if( pxStateList == &xSuspendedTaskList )
+		{
+			/* The task is either blocked indefinitely or genuinely suspended.
+			Only the former can be given a timeout. */
+			if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+			{
+				xReturn = pdPASS;
+			}
+			else
+			{
+				#if( configUSE_TASK_NOTIFICATIONS == 1 )
+				{
+				BaseType_t x;
+
+					for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+					{
+						if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+						{
+							xReturn = pdPASS;
+							break;
+						}
+					}
+				}
+				#endif
+			}
+
+			xMove = xReturn;
+		}
+	#endif /* INCLUDE_vTaskSuspend */
+	else
+	{
+		/* The task is not in the Blocked state. */
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( xMove != pdFALSE )
+	{
+		( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+		/* As in prvAddCurrentTaskToDelayedList(). */
+		xTimeToWake = xConstTickCount + xTicksToWait;
+		listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), xTimeToWake );
+
+		if( xTimeToWake < xConstTickCount )
+		{
+			vListInsert( pxOverflowDelayedTaskList, &( pxTCB->xStateListItem ) );
+		}
+		else
+		{
+			vListInsert( pxDelayedTaskList, &( pxTCB->xStateListItem ) );
+
+			if( xTimeToWake < xNextTaskUnblockTime )
+			{
+				xNextTaskUnblockTime = xTimeToWake;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
 void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
 {
 	configASSERT( pxTimeOut );
@@ -3491,6 +3947,36 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 #endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_ARENAS == 1 )
+
+	void vTaskSetArena( TaskHandle_t xTask, ArenaHandle_t xArena )
+	{
+	TCB_t *pxTCB;
+
+		pxTCB = prvGetTCBFromHandle( xTask );
+
+		/* Only one arena can be bound to a task, as only one is deleted with
+		it. */
+		configASSERT( ( xArena == NULL ) || ( pxTCB->xArena == NULL ) );
+		pxTCB->xArena = xArena;
+	}
+
+#endif /* configUSE_ARENAS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ARENAS == 1 )
+
+	ArenaHandle_t xTaskGetArena( TaskHandle_t xTask )
+	{
+	TCB_t *pxTCB;
+
+		pxTCB = prvGetTCBFromHandle( xTask );
+		return pxTCB->xArena;
+	}
+
+#endif /* configUSE_ARENAS */
+/*-----------------------------------------------------------*/
+
 #if ( portUSING_MPU_WRAPPERS == 1 )
 
 	void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify, const MemoryRegion_t * const xRegions )
@@ -3776,12 +4262,36 @@ static void prvCheckTasksWaitingTermination( void )
 		}
 		#endif /* configUSE_NEWLIB_REENTRANT */
 
+		#if( configUSE_ARENAS == 1 )
+		{
+			/* Everything the task allocated from its arena is released in one
+			go, rather than object by object. */
+			if( pxTCB->xArena != NULL )
+			{
+				vArenaDelete( pxTCB->xArena );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_ARENAS */
+
+		#if( configUSE_HEAP_TRACKER == 1 )
+		{
+			/* Anything the task still owns has outlived it.  This must be done
+			before the TCB is freed, as the TCB's address identifies the
+			task. */
+			vHeapTrackerTaskDeleted( pxTCB );
+		}
+		#endif /* configUSE_HEAP_TRACKER */
+
 		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
 		{
 			/* The task can only have been allocated dynamically - free both
 			the stack and TCB. */
 			vPortFree( pxTCB->pxStack );
-			vPortFree( pxTCB );
+			prvFreeTCB( pxTCB );
 		}
 		#elif( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
 		{
@@ -3793,13 +4303,13 @@ static void prvCheckTasksWaitingTermination( void )
 				/* Both the stack and TCB were allocated dynamically, so both
 				must be freed. */
 				vPortFree( pxTCB->pxStack );
-				vPortFree( pxTCB );
+				prvFreeTCB( pxTCB );
 			}
 			else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
 			{
 				/* Only the stack was statically allocated, so the TCB is the
 				only memory that must be freed. */
-				vPortFree( pxTCB );
+				prvFreeTCB( pxTCB );
 			}
 			else
 			{
@@ -3887,6 +4397,89 @@ TCB_t *pxTCB;
 #if ( configUSE_MUTEXES == 1 )
 
 	BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
+	{
+		return prvInheritPriority( pxMutexHolder, pxCurrentTCB->uxPriority );
+	}
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 )
+
+	BaseType_t xTaskPriorityInheritFrom( TaskHandle_t const pxMutexHolder, TaskHandle_t const pxBlockedTask )
+	{
+	const TCB_t * const pxBlockedTCB = pxBlockedTask;
+
+		configASSERT( pxBlockedTCB );
+		return prvInheritPriority( pxMutexHolder, pxBlockedTCB->uxPriority );
+	}
+
+#endif /* configMAX_PRIORITY_INHERITANCE_DEPTH */
+/*-----------------------------------------------------------*/
+
+#if ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 )
+
+	void vTaskSetMutexBlockedOn( void * const pvMutex )
+	{
+		/* Only the calling task can be about to block on, or have stopped
+		waiting for, a mutex. */
+		pxCurrentTCB->pvMutexBlockedOn = pvMutex;
+	}
+
+#endif /* configMAX_PRIORITY_INHERITANCE_DEPTH */
+/*-----------------------------------------------------------*/
+
+#if ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 )
+
+	void *pvTaskGetMutexBlockedOn( TaskHandle_t const xTask )
+	{
+	const TCB_t * const pxTCB = xTask;
+	const List_t * const pxEventList = listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
+	void *pvReturn;
+
+		/* The mutex is only reported while the task is still referenced from
+		an event list.  A task that has been unblocked, but not yet run, is
+		referenced from the pending ready list instead. */
+		if( ( pxEventList != NULL ) && ( pxEventList != &xPendingReadyList ) )
+		{
+			pvReturn = pxTCB->pvMutexBlockedOn;
+		}
+		else
+		{
+			pvReturn = NULL;
+		}
+
+		return pvReturn;
+	}
+
+#endif /* configMAX_PRIORITY_INHERITANCE_DEPTH */
+/*-----------------------------------------------------------*/
+
+#if ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 )
+
+	static void prvReorderWithinEventList( TCB_t * const pxTCB )
+	{
+	List_t * const pxEventList = listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
+
+		/* Called from a critical section after the event list item value of a
+		task has been updated to reflect a new priority. */
+		if( ( pxEventList != NULL ) && ( pxEventList != &xPendingReadyList ) )
+		{
+			( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+			vListInsert( pxEventList, &( pxTCB->xEventListItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configMAX_PRIORITY_INHERITANCE_DEPTH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+	static BaseType_t prvInheritPriority( TaskHandle_t const pxMutexHolder, const UBaseType_t uxInheritedPriority )
 	{
 	TCB_t * const pxMutexHolderTCB = pxMutexHolder;
 	BaseType_t xReturn = pdFALSE;
@@ -3899,14 +4492,20 @@ TCB_t *pxTCB;
 			/* If the holder of the mutex has a priority below the priority of
 			the task attempting to obtain the mutex then it will temporarily
 			inherit the priority of the task attempting to obtain the mutex. */
-			if( pxMutexHolderTCB->uxPriority < pxCurrentTCB->uxPriority )
+			if( pxMutexHolderTCB->uxPriority < uxInheritedPriority )
 			{
 				/* Adjust the mutex holder state to account for its new
 				priority.  Only reset the event list item value if the value is
 				not being used for anything else. */
 				if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
 				{
-					listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+					listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxInheritedPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+					#if ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 )
+					{
+						prvReorderWithinEventList( pxMutexHolderTCB );
+					}
+					#endif
 				}
 				else
 				{
@@ -3927,23 +4526,23 @@ TCB_t *pxTCB;
 					}
 
 					/* Inherit the priority before being moved into the new list. */
-					pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
+					pxMutexHolderTCB->uxPriority = uxInheritedPriority;
 					prvReaddTaskToReadyList( pxMutexHolderTCB );
 				}
 				else
 				{
 					/* Just inherit the priority. */
-					pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
+					pxMutexHolderTCB->uxPriority = uxInheritedPriority;
 				}
 
-				traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
+				traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, uxInheritedPriority );
 
 				/* Inheritance occurred. */
 				xReturn = pdTRUE;
 			}
 			else
 			{
-				if( pxMutexHolderTCB->uxBasePriority < pxCurrentTCB->uxPriority )
+				if( pxMutexHolderTCB->uxBasePriority < uxInheritedPriority )
 				{
 					/* The base priority of the mutex holder is lower than the
 					priority of the task attempting to take the mutex, but the
@@ -4104,6 +4703,12 @@ TCB_t *pxTCB;
 					if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
 					{
 						listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+						#if ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 )
+						{
+							prvReorderWithinEventList( pxTCB );
+						}
+						#endif
 					}
 					else
 					{
@@ -4153,6 +4758,64 @@ TCB_t *pxTCB;
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_CEILING_MUTEXES == 1 )
+
+	void vTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority )
+	{
+		/* This is called from a critical section by the task that has just
+		taken the mutex.  If the mutex is taken before any tasks have been
+		created then there is nothing to raise. */
+		if( pxCurrentTCB != NULL )
+		{
+			/* The ceiling of a mutex must be at least the base priority of
+			every task that takes it, otherwise the protocol gives no
+			guarantee. */
+			configASSERT( pxCurrentTCB->uxBasePriority <= uxCeilingPriority );
+
+			if( pxCurrentTCB->uxPriority < uxCeilingPriority )
+			{
+				/* Only reset the event list item value if the value is not
+				being used for anything else. */
+				if( ( listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+				{
+					listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxCeilingPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* The calling task is running, so is in the Ready state, and
+				must be moved to the ready list of its new priority.  Raising
+				the priority of the running task can never make another task
+				more eligible to run, so no yield is required. */
+				if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+				{
+					taskRESET_READY_PRIORITY( pxCurrentTCB->uxPriority );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				traceTASK_PRIORITY_INHERIT( pxCurrentTCB, uxCeilingPriority );
+				pxCurrentTCB->uxPriority = uxCeilingPriority;
+				prvReaddTaskToReadyList( pxCurrentTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_CEILING_MUTEXES */
+/*-----------------------------------------------------------*/
+
 #if ( portCRITICAL_NESTING_IN_TCB == 1 )
 
 	void vTaskEnterCritical( void )
@@ -4501,17 +5164,19 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	uint32_t ulTaskNotifyTake( BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
+	uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn, BaseType_t xClearCountOnExit, TickType_t xTicksToWait )
 	{
 	uint32_t ulReturn;
 
+		configASSERT( uxIndexToWaitOn < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if the notification count is not already non-zero. */
-			if( pxCurrentTCB->ulNotifiedValue == 0UL )
+			if( pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] == 0UL )
 			{
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
@@ -4539,17 +5204,17 @@ TickType_t uxReturn;
 		taskENTER_CRITICAL();
 		{
 			traceTASK_NOTIFY_TAKE();
-			ulReturn = pxCurrentTCB->ulNotifiedValue;
+			ulReturn = pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ];
 
 			if( ulReturn != 0UL )
 			{
 				if( xClearCountOnExit != pdFALSE )
 				{
-					pxCurrentTCB->ulNotifiedValue = 0UL;
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] = 0UL;
 				}
 				else
 				{
-					pxCurrentTCB->ulNotifiedValue = ulReturn - ( uint32_t ) 1;
+					pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] = ulReturn - ( uint32_t ) 1;
 				}
 			}
 			else
@@ -4557,7 +5222,7 @@ TickType_t uxReturn;
 				mtCOVERAGE_TEST_MARKER();
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4569,22 +5234,24 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyWait( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
+	BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, TickType_t xTicksToWait )
 	{
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToWaitOn < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		taskENTER_CRITICAL();
 		{
 			/* Only block if a notification is not already pending. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* Clear bits in the task's notification value as bits may get
 				set	by the notifying task or interrupt.  This can be used to
 				clear the value to zero. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnEntry;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] &= ~ulBitsToClearOnEntry;
 
 				/* Mark this task as waiting for a notification. */
-				pxCurrentTCB->ucNotifyState = taskWAITING_NOTIFICATION;
+				pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskWAITING_NOTIFICATION;
 
 				if( xTicksToWait > ( TickType_t ) 0 )
 				{
@@ -4617,14 +5284,14 @@ TickType_t uxReturn;
 			{
 				/* Output the current notification value, which may or may not
 				have changed. */
-				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue;
+				*pulNotificationValue = pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ];
 			}
 
 			/* If ucNotifyValue is set then either the task never entered the
 			blocked state (because a notification was already pending) or the
 			task unblocked because of a notification.  Otherwise the task
 			unblocked because of a timeout. */
-			if( pxCurrentTCB->ucNotifyState != taskNOTIFICATION_RECEIVED )
+			if( pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] != taskNOTIFICATION_RECEIVED )
 			{
 				/* A notification was not received. */
 				xReturn = pdFALSE;
@@ -4633,11 +5300,11 @@ TickType_t uxReturn;
 			{
 				/* A notification was already pending or a notification was
 				received while the task was waiting. */
-				pxCurrentTCB->ulNotifiedValue &= ~ulBitsToClearOnExit;
+				pxCurrentTCB->ulNotifiedValue[ uxIndexToWaitOn ] &= ~ulBitsToClearOnExit;
 				xReturn = pdTRUE;
 			}
 
-			pxCurrentTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+			pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskNOT_WAITING_NOTIFICATION;
 		}
 		taskEXIT_CRITICAL();
 
@@ -4649,44 +5316,45 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
+	BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue )
 	{
 	TCB_t * pxTCB;
 	BaseType_t xReturn = pdPASS;
 	uint8_t ucOriginalNotifyState;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 		pxTCB = xTaskToNotify;
 
 		taskENTER_CRITICAL();
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
 
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -4704,7 +5372,7 @@ TickType_t uxReturn;
 					/* Should not get here if all enums are handled.
 					Artificially force an assert by testing a value the
 					compiler can't assume is const. */
-					configASSERT( pxTCB->ulNotifiedValue == ~0UL );
+					configASSERT( pxTCB->ulNotifiedValue[ uxIndexToNotify ] == ~0UL );
 
 					break;
 			}
@@ -4763,7 +5431,7 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
+	BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction, uint32_t *pulPreviousNotificationValue, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
@@ -4771,6 +5439,7 @@ TickType_t uxReturn;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -4796,30 +5465,30 @@ TickType_t uxReturn;
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
-				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue;
+				*pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
 			}
 
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			switch( eAction )
 			{
 				case eSetBits	:
-					pxTCB->ulNotifiedValue |= ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
 					break;
 
 				case eIncrement	:
-					( pxTCB->ulNotifiedValue )++;
+					( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 					break;
 
 				case eSetValueWithOverwrite	:
-					pxTCB->ulNotifiedValue = ulValue;
+					pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					break;
 
 				case eSetValueWithoutOverwrite :
 					if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
 					{
-						pxTCB->ulNotifiedValue = ulValue;
+						pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
 					}
 					else
 					{
@@ -4837,7 +5506,7 @@ TickType_t uxReturn;
 					/* Should not get here if all enums are handled.
 					Artificially force an assert by testing a value the
 					compiler can't assume is const. */
-					configASSERT( pxTCB->ulNotifiedValue == ~0UL );
+					configASSERT( pxTCB->ulNotifiedValue[ uxIndexToNotify ] == ~0UL );
 					break;
 			}
 
@@ -4892,13 +5561,14 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	void vTaskNotifyGiveFromISR( TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken )
+	void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	TCB_t * pxTCB;
 	uint8_t ucOriginalNotifyState;
 	UBaseType_t uxSavedInterruptStatus;
 
 		configASSERT( xTaskToNotify );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
 		/* RTOS ports that support interrupt nesting have the concept of a
 		maximum	system call (or maximum API call) interrupt priority.
@@ -4922,12 +5592,12 @@ TickType_t uxReturn;
 
 		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 		{
-			ucOriginalNotifyState = pxTCB->ucNotifyState;
-			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
+			ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+			pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
 			/* 'Giving' is equivalent to incrementing a count in a counting
 			semaphore. */
-			( pxTCB->ulNotifiedValue )++;
+			( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 
 			traceTASK_NOTIFY_GIVE_FROM_ISR();
 
@@ -4979,20 +5649,22 @@ TickType_t uxReturn;
 
 #if( configUSE_TASK_NOTIFICATIONS == 1 )
 
-	BaseType_t xTaskNotifyStateClear( TaskHandle_t xTask )
+	BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask, UBaseType_t uxIndexToClear )
 	{
 	TCB_t *pxTCB;
 	BaseType_t xReturn;
 
+		configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
 		/* If null is passed in here then it is the calling task that is having
 		its notification state cleared. */
 		pxTCB = prvGetTCBFromHandle( xTask );
 
 		taskENTER_CRITICAL();
 		{
-			if( pxTCB->ucNotifyState == taskNOTIFICATION_RECEIVED )
+			if( pxTCB->ucNotifyState[ uxIndexToClear ] == taskNOTIFICATION_RECEIVED )
 			{
-				pxTCB->ucNotifyState = taskNOT_WAITING_NOTIFICATION;
+				pxTCB->ucNotifyState[ uxIndexToClear ] = taskNOT_WAITING_NOTIFICATION;
 				xReturn = pdPASS;
 			}
 			else
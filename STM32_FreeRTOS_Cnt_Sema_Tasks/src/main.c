@@ -158,20 +158,18 @@ void EXTI15_10_IRQHandler( void )
 {
 	portBASE_TYPE xHigherPriorityTaskWoken = pdFALSE;
 
-	/* 'Give' the semaphore multiple times.  The first will unblock the handler
-	task, the following 'gives' are to demonstrate that the semaphore latches
-	the events to allow the handler task to process them in turn without any
-	events getting lost.  This simulates multiple interrupts being taken by the
-	processor, even though in this case the events are simulated within a single
-	interrupt occurrence.*/
+	/* 'Give' the semaphore five times in one call.  The first count will
+	unblock the handler task, the following counts are to demonstrate that the
+	semaphore latches the events to allow the handler task to process them in
+	turn without any events getting lost.  This simulates multiple interrupts
+	being taken by the processor, even though in this case the events are
+	simulated within a single interrupt occurrence.  Giving all five at once
+	only masks interrupts and checks the waiting list once, rather than five
+	times.*/
 	sprintf(usr_msg,"==>Button_Handler\r\n");
 	printmsg(usr_msg);
 
-	xSemaphoreGiveFromISR( xCountingSemaphore, &xHigherPriorityTaskWoken );
-	xSemaphoreGiveFromISR( xCountingSemaphore, &xHigherPriorityTaskWoken );
-	xSemaphoreGiveFromISR( xCountingSemaphore, &xHigherPriorityTaskWoken );
-	xSemaphoreGiveFromISR( xCountingSemaphore, &xHigherPriorityTaskWoken );
-	xSemaphoreGiveFromISR( xCountingSemaphore, &xHigherPriorityTaskWoken );
+	xSemaphoreGiveMultipleFromISR( xCountingSemaphore, 5, &xHigherPriorityTaskWoken );
 
     /* Clear the software interrupt bit using the interrupt controllers  */
 
@@ -61,6 +61,29 @@ typedef struct QueueDefinition * QueueSetHandle_t;
  */
 typedef struct QueueDefinition * QueueSetMemberHandle_t;
 
+/**
+ * Contention statistics gathered for each mutex when
+ * configUSE_MUTEX_STATISTICS is set to 1.  Times are measured in units of
+ * portGET_MUTEX_STATS_TIME().  The task handles identify the tasks involved in
+ * the worst events seen so far, and may refer to tasks that have since been
+ * deleted.  See xSemaphoreGetMutexStats().
+ */
+typedef struct xMUTEX_STATS
+{
+	UBaseType_t uxAcquisitions;				/*< The number of times the mutex was taken. */
+	UBaseType_t uxContendedAcquisitions;	/*< The number of those takes that had to wait for another task to give the mutex. */
+	UBaseType_t uxPriorityInheritances;		/*< The number of times a waiting task caused the holder to inherit a priority. */
+	uint32_t ulTotalHoldTime;				/*< The time the mutex has been held, summed over all completed holds. */
+	uint32_t ulMaxHoldTime;					/*< The longest single hold. */
+	uint32_t ulTotalWaitTime;				/*< The time tasks spent waiting for the mutex, summed over all contended takes. */
+	uint32_t ulMaxWaitTime;					/*< The longest single wait. */
+	TaskHandle_t xMaxHoldTask;				/*< The task that held the mutex for ulMaxHoldTime. */
+	TaskHandle_t xMaxWaitTask;				/*< The task that waited for ulMaxWaitTime. */
+	TaskHandle_t xMaxWaitHolder;			/*< The task that held the mutex when the longest wait started. */
+	TaskHandle_t xLastInheritHolder;		/*< The task whose priority was most recently raised by inheritance. */
+	TaskHandle_t xLastInheritWaiter;		/*< The task that caused the most recent inheritance. */
+} MutexStats_t;
+
 /* For internal use only. */
 #define	queueSEND_TO_BACK		( ( BaseType_t ) 0 )
 #define	queueSEND_TO_FRONT		( ( BaseType_t ) 1 )
@@ -1294,6 +1317,7 @@ uint32_t ulVarToSend, ulValReceived;
  */
 BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue, const void * const pvItemToQueue, BaseType_t * const pxHigherPriorityTaskWoken, const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION;
 BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+BaseType_t xQueueGiveMultipleFromISR( QueueHandle_t xQueue, const UBaseType_t uxCount, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
 /**
  * queue. h
@@ -1413,11 +1437,16 @@ BaseType_t xQueueCRReceive( QueueHandle_t xQueue, void *pvBuffer, TickType_t xTi
  */
 QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateMutexStatic( const uint8_t ucQueueType, StaticQueue_t *pxStaticQueue ) PRIVILEGED_FUNCTION;
+QueueHandle_t xQueueCreateMutexWithCeiling( const uint8_t ucQueueType, const UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+QueueHandle_t xQueueCreateMutexWithCeilingStatic( const uint8_t ucQueueType, const UBaseType_t uxCeilingPriority, StaticQueue_t *pxStaticQueue ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount, const UBaseType_t uxInitialCount ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount, const UBaseType_t uxInitialCount, StaticQueue_t *pxStaticQueue ) PRIVILEGED_FUNCTION;
 BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xQueueSemaphoreTakeMultiple( QueueHandle_t xQueue, const UBaseType_t uxCount, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore ) PRIVILEGED_FUNCTION;
 TaskHandle_t xQueueGetMutexHolderFromISR( QueueHandle_t xSemaphore ) PRIVILEGED_FUNCTION;
+BaseType_t xQueueGetMutexStats( QueueHandle_t xMutex, MutexStats_t *pxMutexStats ) PRIVILEGED_FUNCTION;
+void vQueueResetMutexStats( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
 
 /*
  * For internal use only.  Use xSemaphoreTakeMutexRecursive() or
@@ -27,6 +27,7 @@
 
 /* Standard includes. */
 #include <stdlib.h>
+#include <string.h>
 
 /* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
 all the API functions to use the MPU wrappers.  That should only be done when
@@ -37,11 +38,16 @@ task.h is included from an application file. */
 #include "task.h"
 #include "queue.h"
 #include "timers.h"
+#include "slab.h"
 
 #if ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 0 )
 	#error configUSE_TIMERS must be set to 1 to make the xTimerPendFunctionCall() function available.
 #endif
 
+#if ( configUSE_TICK_CONTEXT_TIMERS == 1 ) && ( configUSE_TIMERS == 0 )
+	#error configUSE_TIMERS must be set to 1 to make tick context timers available.
+#endif
+
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
 because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
 for the header files above, but not in this file, in order to generate the
@@ -64,6 +70,57 @@ defining trmTIMER_SERVICE_TASK_NAME in FreeRTOSConfig.h. */
 	#define configTIMER_SERVICE_TASK_NAME "Tmr Svc"
 #endif
 
+/* Dynamically allocated timers come from their slab cache if slab caches are
+used, otherwise from the FreeRTOS heap. */
+#if( configUSE_SLAB_CACHES == 1 )
+	#define prvAllocateTimer()			( ( Timer_t * ) pvSlabAlloc( eSlabCacheTimer ) )
+	#define prvFreeTimer( pxTimer )		vSlabFree( eSlabCacheTimer, ( pxTimer ) )
+#else
+	#define prvAllocateTimer()			( ( Timer_t * ) pvPortMalloc( sizeof( Timer_t ) ) ) /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of Timer_t is always a pointer to the timer's mame. */
+	#define prvFreeTimer( pxTimer )		vPortFree( pxTimer )
+#endif
+
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	/* Each level of the timing wheel has tmrWHEEL_SLOTS slots.  A slot in level
+	n covers tmrWHEEL_SLOTS^n ticks, and there are enough levels to cover every
+	possible TickType_t value. */
+	#if( ( configTIMER_WHEEL_SLOT_BITS != 1 ) && ( configTIMER_WHEEL_SLOT_BITS != 2 ) && ( configTIMER_WHEEL_SLOT_BITS != 4 ) )
+		#error configTIMER_WHEEL_SLOT_BITS must be set to 1, 2 or 4.
+	#endif
+
+	#if( configUSE_16_BIT_TICKS == 1 )
+		#define tmrWHEEL_TICK_BITS		( 16U )
+	#else
+		#define tmrWHEEL_TICK_BITS		( 32U )
+	#endif
+
+	#define tmrWHEEL_SLOTS				( 1U << configTIMER_WHEEL_SLOT_BITS )
+	#define tmrWHEEL_SLOT_MASK			( tmrWHEEL_SLOTS - 1U )
+	#define tmrWHEEL_LEVELS				( tmrWHEEL_TICK_BITS / configTIMER_WHEEL_SLOT_BITS )
+	#define tmrWHEEL_OCCUPIED_MASK		( ( 1UL << tmrWHEEL_SLOTS ) - 1UL )
+
+	/* The wheel has work to do at tick xTick if xTick is not later than
+	xTimeNow.  Both are measured from the wheel time, which is never more than
+	one tick ahead of xTimeNow, so the tick count overflowing does not matter. */
+	#define tmrWHEEL_TICK_IS_DUE( xTick, xTimeNow, xWheelTime ) ( ( TickType_t ) ( ( xTick ) - ( xWheelTime ) ) < ( TickType_t ) ( ( xTimeNow ) + ( TickType_t ) 1U - ( xWheelTime ) ) )
+
+#endif /* configUSE_TIMER_WHEEL */
+
+#if( configUSE_TICK_CONTEXT_TIMERS == 1 )
+
+	/* Values for the ucTickContext member of Timer_t. */
+	#define tmrTICK_CONTEXT_NONE		( ( uint8_t ) 0 )
+	#define tmrTICK_CONTEXT_STOPPED		( ( uint8_t ) 1 )
+	#define tmrTICK_CONTEXT_RUNNING		( ( uint8_t ) 2 )
+
+	/* A tick context timer is due when the tick count is no more than
+	tmrTICK_CONTEXT_MAX_PERIOD ticks past its expiry time, so its period must
+	not be longer than that. */
+	#define tmrTICK_CONTEXT_MAX_PERIOD	( portMAX_DELAY >> 1 )
+
+#endif /* configUSE_TICK_CONTEXT_TIMERS */
+
 /* The definition of the timers themselves. */
 typedef struct tmrTimerControl /* The old naming convention is used to prevent breaking kernel aware debuggers. */
 {
@@ -80,6 +137,19 @@ typedef struct tmrTimerControl /* The old naming convention is used to prevent b
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t 			ucStaticallyAllocated; /*<< Set to pdTRUE if the timer was created statically so no attempt is made to free the memory again if the timer is later deleted. */
 	#endif
+
+	#if( configUSE_TICK_CONTEXT_TIMERS == 1 )
+		volatile uint8_t	ucTickContext;		/*<< tmrTICK_CONTEXT_NONE for a timer serviced by the timer service task, otherwise whether the tick context timer is running. */
+	#endif
+
+	#if( configUSE_TIMER_SLACK == 1 )
+		TickType_t			xTimerSlack;		/*<< The number of ticks after its expiry time by which the timer service task may process the timer, so its expiry can share a wake up with other timers. */
+	#endif
+
+	#if( configTIMER_SERVICE_TASKS > 1 )
+		uint8_t				ucService;			/*<< The index of the timer service task that services the timer. */
+		UBaseType_t			uxCommandsPending;	/*<< The number of commands sent to the timer that its timer service task has not finished processing.  The timer cannot be moved to another timer service task while any are pending. */
+	#endif
 } xTIMER;
 
 /* The old xTIMER name is maintained above then typedefed to the new Timer_t
@@ -105,6 +175,15 @@ typedef struct tmrCallbackParameters
 	uint32_t ulParameter2;					/* << The value that will be used as the callback functions second parameter. */
 } CallbackParameters_t;
 
+#if( configUSE_TIMER_COMMAND_BATCHES == 1 )
+	typedef struct tmrBatchParameters
+	{
+		TimerBatchCommand_t *pxCommands;	/* << The batch slot holding a copy of the commands to apply. */
+		UBaseType_t uxNumberOfCommands;		/* << The number of commands in the batch slot. */
+		TickType_t xCommandTime;			/* << The tick count when the batch was sent, used by the start and reset commands. */
+	} BatchParameters_t;
+#endif /* configUSE_TIMER_COMMAND_BATCHES */
+
 /* The structure that contains the two message types, along with an identifier
 that is used to determine which message type is valid. */
 typedef struct tmrTimerQueueMessage
@@ -119,26 +198,100 @@ typedef struct tmrTimerQueueMessage
 		#if ( INCLUDE_xTimerPendFunctionCall == 1 )
 			CallbackParameters_t xCallbackParameters;
 		#endif /* INCLUDE_xTimerPendFunctionCall */
+
+		/* Likewise xBatchParameters. */
+		#if( configUSE_TIMER_COMMAND_BATCHES == 1 )
+			BatchParameters_t xBatchParameters;
+		#endif /* configUSE_TIMER_COMMAND_BATCHES */
 	} u;
 } DaemonTaskMessage_t;
 
+/* The state of one timer service task.  There are configTIMER_SERVICE_TASKS
+timer service tasks, each with its own priority, command queue and active
+timers, and each timer is serviced by the task selected by its ucService member
+(always 0 if there is only one timer service task).  Only the timer service
+task is allowed to access its active timers. */
+typedef struct tmrTimerService
+{
+	#if( configUSE_TIMER_WHEEL == 0 )
+		/* The lists in which active timers are stored.  Timers are referenced
+		in expire time order, with the nearest expiry time at the front of the
+		list.  xLastTime is the tick count when the task last checked for the
+		tick count overflowing, at which point the lists are switched. */
+		List_t xActiveTimerList1;
+		List_t xActiveTimerList2;
+		List_t *pxCurrentTimerList;
+		List_t *pxOverflowTimerList;
+		TickType_t xLastTime;
+	#else
+		/* When configUSE_TIMER_WHEEL is 1 active timers are instead held,
+		unsorted, in the slots of a hierarchical timing wheel.
+		ulTimerWheelOccupied holds a bit for each slot that is not empty, and
+		xTimerWheelTime is the next tick the wheel has still to process.  Timers
+		in level 0 expire at the tick selected by their slot.  Timers in higher
+		levels are moved down a level (cascaded) when the wheel reaches the
+		start of their slot. */
+		List_t xTimerWheel[ tmrWHEEL_LEVELS ][ tmrWHEEL_SLOTS ];
+		uint32_t ulTimerWheelOccupied[ tmrWHEEL_LEVELS ];
+		TickType_t xTimerWheelTime;
+
+		#if( configUSE_TIMER_SLACK == 1 )
+			/* The smallest slack of the timers placed in each slot since the
+			slot was last empty. */
+			TickType_t xTimerWheelSlack[ tmrWHEEL_LEVELS ][ tmrWHEEL_SLOTS ];
+		#endif
+	#endif /* configUSE_TIMER_WHEEL */
+
+	/* The queue that is used to send commands to the timer service task. */
+	QueueHandle_t xTimerQueue;
+	TaskHandle_t xTimerTaskHandle;
+
+	#if( configUSE_TIMER_SLACK == 1 )
+		/* Counts reported by vTimerGetWakeStats().  xTimerTaskBlocked is set
+		each time the task blocks so the next expiry it processes is counted as
+		a new wake up. */
+		uint32_t ulTimerWakeUps;
+		uint32_t ulTimerExpiryTimes;
+		TickType_t xLastExpiryTime;
+		BaseType_t xTimerTaskBlocked;
+	#endif
+} TimerService_t;
+
+/* The timer service task that services a timer. */
+#if( configTIMER_SERVICE_TASKS > 1 )
+	#define tmrSERVICE_OF( pxTimer )	( &( xTimerServices[ ( pxTimer )->ucService ] ) )
+#else
+	#define tmrSERVICE_OF( pxTimer )	( &( xTimerServices[ 0 ] ) )
+#endif
+
 /*lint -save -e956 A manual analysis and inspection has been used to determine
 which static variables must be declared volatile. */
 
-/* The list in which active timers are stored.  Timers are referenced in expire
-time order, with the nearest expiry time at the front of the list.  Only the
-timer service task is allowed to access these lists. 
-xActiveTimerList1 and xActiveTimerList2 could be at function scope but that
-breaks some kernel aware debuggers, and debuggers that reply on removing the
-static qualifier. */
-PRIVILEGED_DATA static List_t xActiveTimerList1;
-PRIVILEGED_DATA static List_t xActiveTimerList2;
-PRIVILEGED_DATA static List_t *pxCurrentTimerList;
-PRIVILEGED_DATA static List_t *pxOverflowTimerList;
-
-/* A queue that is used to send commands to the timer service task. */
-PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
-PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandle = NULL;
+/* xTimerServices could be at function scope but that breaks some kernel aware
+debuggers, and debuggers that reply on removing the static qualifier. */
+PRIVILEGED_DATA static TimerService_t xTimerServices[ configTIMER_SERVICE_TASKS ];
+
+#if( configUSE_TICK_CONTEXT_TIMERS == 1 )
+	/* Every tick context timer, running or not, is referenced from this list,
+	which is only modified from within a critical section.  The tick interrupt
+	scans the list when xTickContextTimersChanged is set by a timer being
+	started, or when xTicksToNextTickContextScan ticks have passed since the
+	last scan at xTickContextScanTime. */
+	PRIVILEGED_DATA static List_t xTickContextTimerList;
+	PRIVILEGED_DATA static volatile BaseType_t xTickContextTimersChanged = pdFALSE;
+	PRIVILEGED_DATA static TickType_t xTickContextScanTime = ( TickType_t ) 0U;
+	PRIVILEGED_DATA static TickType_t xTicksToNextTickContextScan = ( TickType_t ) 0U;
+#endif
+
+#if( configUSE_TIMER_COMMAND_BATCHES == 1 )
+	/* The commands in a batch are copied into one of these slots when the
+	batch is sent, so the sender's array is not referenced once the send
+	returns.  xFreeBatchSlots holds a pointer to each slot that is not in use,
+	so a task can wait for a slot to become free.  The timer service task
+	returns the slot once it has applied the batch. */
+	PRIVILEGED_DATA static TimerBatchCommand_t xBatchSlots[ configTIMER_COMMAND_BATCH_SLOTS ][ configTIMER_COMMAND_BATCH_LENGTH ];
+	PRIVILEGED_DATA static QueueHandle_t xFreeBatchSlots = NULL;
+#endif
 
 /*lint -restore */
 
@@ -152,6 +305,12 @@ PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandle = NULL;
 	and TCB. */
 	extern void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize );
 
+	#if( configTIMER_SERVICE_TASKS > 1 )
+		/* As vApplicationGetTimerTaskMemory(), but for each timer service task
+		other than the first. */
+		extern void vApplicationGetTimerServiceTaskMemory( UBaseType_t uxService, StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize );
+	#endif
+
 #endif
 
 /*
@@ -171,31 +330,71 @@ static void prvTimerTask( void *pvParameters ) PRIVILEGED_FUNCTION;
  * Called by the timer service task to interpret and process a command it
  * received on the timer queue.
  */
-static void prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
+static void prvProcessReceivedCommands( TimerService_t * const pxService ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_TIMER_COMMAND_BATCHES == 1 )
+
+	/*
+	 * Called by the timer service task to apply every command in a batch sent
+	 * by xTimerGenericBatchCommand().
+	 */
+	static void prvProcessCommandBatch( TimerService_t * const pxService, const BatchParameters_t * const pxBatch ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_COMMAND_BATCHES */
 
 /*
  * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
  * depending on if the expire time causes a timer counter overflow.
  */
-static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
+static BaseType_t prvInsertTimerInActiveList( TimerService_t * const pxService, Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
 
 /*
  * An active timer has reached its expire time.  Reload the timer if it is an
- * auto reload timer, then call its callback.
+ * auto reload timer, then call its callback.  When configUSE_TIMER_WHEEL is 1
+ * this instead processes the wheel at tick xNextExpireTime, which expires every
+ * timer in the wheel slot for that tick.
  */
-static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+static void prvProcessExpiredTimer( TimerService_t * const pxService, const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
 
-/*
- * The tick count has overflowed.  Switch the timer lists after ensuring the
- * current timer list does not still reference some timers.
- */
-static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+#if( configUSE_TIMER_WHEEL == 0 )
+
+	/*
+	 * The tick count has overflowed.  Switch the timer lists after ensuring the
+	 * current timer list does not still reference some timers.
+	 */
+	static void prvSwitchTimerLists( TimerService_t * const pxService ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * As prvInsertTimerInActiveList(), but inserts the timer into either
+	 * pxCurrentList or pxOverflowList.
+	 */
+	static BaseType_t prvInsertTimerInLists( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime, List_t * const pxCurrentList, List_t * const pxOverflowList ) PRIVILEGED_FUNCTION;
+
+#else
+
+	/*
+	 * Place a timer in the timing wheel slot for the expiry time held in its
+	 * list item.  The expiry time must not be before xTimerWheelTime.
+	 */
+	static void prvInsertTimerInWheel( TimerService_t * const pxService, Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Remove a timer from the timing wheel, updating the occupied slot bits.
+	 */
+	static void prvRemoveTimerFromWheel( TimerService_t * const pxService, Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns the index of the lowest bit set in ulBits, which must not be 0.
+	 */
+	static UBaseType_t prvLowestSetBit( uint32_t ulBits ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_WHEEL */
 
 /*
  * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
  * if a tick count overflow occurred since prvSampleTimeNow() was last called.
  */
-static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched ) PRIVILEGED_FUNCTION;
+static TickType_t prvSampleTimeNow( TimerService_t * const pxService, BaseType_t * const pxTimerListsWereSwitched ) PRIVILEGED_FUNCTION;
 
 /*
  * If the timer list contains any active timers then return the expire time of
@@ -203,13 +402,31 @@ static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched
  * timer list does not contain any timers then return 0 and set *pxListWasEmpty
  * to pdTRUE.
  */
-static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty ) PRIVILEGED_FUNCTION;
+static TickType_t prvGetNextExpireTime( TimerService_t * const pxService, BaseType_t * const pxListWasEmpty ) PRIVILEGED_FUNCTION;
 
 /*
  * If a timer has expired, process it.  Otherwise, block the timer service task
  * until either a timer does expire or a command is received.
  */
-static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime, BaseType_t xListWasEmpty ) PRIVILEGED_FUNCTION;
+static void prvProcessTimerOrBlockTask( TimerService_t * const pxService, const TickType_t xNextExpireTime, BaseType_t xListWasEmpty ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_TIMER_SLACK == 1 )
+
+	/*
+	 * Returns the number of ticks the timer service task can block for
+	 * without processing any timer later than its expiry time plus its slack.
+	 * xNextExpireTime is the value returned by prvGetNextExpireTime(), which
+	 * must be later than xTimeNow, and the task never wakes before it.
+	 */
+	static TickType_t prvGetSlackTicksToWait( TimerService_t * const pxService, const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Updates the counts reported by vTimerGetWakeStats() when timers that
+	 * expired at xExpiryTime are processed.
+	 */
+	static void prvRecordExpiry( TimerService_t * const pxService, const TickType_t xExpiryTime ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_SLACK */
 
 /*
  * Called after a Timer_t structure has been allocated either statically or
@@ -221,54 +438,119 @@ static void prvInitialiseNewTimer(	const char * const pcTimerName,			/*lint !e97
 									void * const pvTimerID,
 									TimerCallbackFunction_t pxCallbackFunction,
 									Timer_t *pxNewTimer ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_TICK_CONTEXT_TIMERS == 1 )
+
+	/*
+	 * Turn a newly created timer into a stopped tick context timer.
+	 */
+	static void prvInitialiseTickContextTimer( Timer_t * const pxNewTimer ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Apply a command to a tick context timer directly, rather than sending it
+	 * to the timer service task.
+	 */
+	static BaseType_t prvTickContextTimerCommand( Timer_t * const pxTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TICK_CONTEXT_TIMERS */
+
+#if( configTIMER_SERVICE_TASKS > 1 )
+
+	/*
+	 * Count a command sent to a timer when xPending is pdTRUE, or the end of
+	 * processing a command when xPending is pdFALSE.  xFromISR selects how
+	 * interrupts are masked while the count is updated.
+	 */
+	static void prvCountCommandPending( Timer_t * const pxTimer, const BaseType_t xPending, const BaseType_t xFromISR ) PRIVILEGED_FUNCTION;
+
+	#define tmrCOMMAND_PENDING( pxTimer, xFromISR )		prvCountCommandPending( ( pxTimer ), pdTRUE, ( xFromISR ) )
+	#define tmrCOMMAND_DONE( pxTimer, xFromISR )		prvCountCommandPending( ( pxTimer ), pdFALSE, ( xFromISR ) )
+
+	#if( configUSE_TIMER_COMMAND_BATCHES == 1 )
+
+		/*
+		 * As prvCountCommandPending(), for each command in a batch.
+		 */
+		static void prvCountBatchPending( const TimerBatchCommand_t * const pxCommands, const UBaseType_t uxNumberOfCommands, const BaseType_t xPending, const BaseType_t xFromISR ) PRIVILEGED_FUNCTION;
+
+	#endif /* configUSE_TIMER_COMMAND_BATCHES */
+
+#else
+
+	/* A timer can only be serviced by the one timer service task, so there is
+	no need to know if commands sent to it are pending. */
+	#define tmrCOMMAND_PENDING( pxTimer, xFromISR )
+	#define tmrCOMMAND_DONE( pxTimer, xFromISR )
+	#define prvCountBatchPending( pxCommands, uxNumberOfCommands, xPending, xFromISR )
+
+#endif /* configTIMER_SERVICE_TASKS */
 /*-----------------------------------------------------------*/
 
 BaseType_t xTimerCreateTimerTask( void )
 {
-BaseType_t xReturn = pdFAIL;
+BaseType_t xReturn = pdPASS;
+UBaseType_t uxService;
+TimerService_t *pxService;
 
 	/* This function is called when the scheduler is started if
 	configUSE_TIMERS is set to 1.  Check that the infrastructure used by the
-	timer service task has been created/initialised.  If timers have already
+	timer service tasks has been created/initialised.  If timers have already
 	been created then the initialisation will already have been performed. */
 	prvCheckForValidListAndQueue();
 
-	if( xTimerQueue != NULL )
+	/* Create each timer service task, passing it its own state. */
+	for( uxService = ( UBaseType_t ) 0U; ( uxService < ( UBaseType_t ) configTIMER_SERVICE_TASKS ) && ( xReturn != pdFAIL ); uxService++ )
 	{
-		#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+		pxService = &( xTimerServices[ uxService ] );
+		xReturn = pdFAIL;
+
+		if( pxService->xTimerQueue != NULL )
 		{
-			StaticTask_t *pxTimerTaskTCBBuffer = NULL;
-			StackType_t *pxTimerTaskStackBuffer = NULL;
-			uint32_t ulTimerTaskStackSize;
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				StaticTask_t *pxTimerTaskTCBBuffer = NULL;
+				StackType_t *pxTimerTaskStackBuffer = NULL;
+				uint32_t ulTimerTaskStackSize;
+
+				#if( configTIMER_SERVICE_TASKS > 1 )
+				if( uxService != ( UBaseType_t ) 0U )
+				{
+					vApplicationGetTimerServiceTaskMemory( uxService, &pxTimerTaskTCBBuffer, &pxTimerTaskStackBuffer, &ulTimerTaskStackSize );
+				}
+				else
+				#endif /* configTIMER_SERVICE_TASKS */
+				{
+					vApplicationGetTimerTaskMemory( &pxTimerTaskTCBBuffer, &pxTimerTaskStackBuffer, &ulTimerTaskStackSize );
+				}
 
-			vApplicationGetTimerTaskMemory( &pxTimerTaskTCBBuffer, &pxTimerTaskStackBuffer, &ulTimerTaskStackSize );
-			xTimerTaskHandle = xTaskCreateStatic(	prvTimerTask,
-													configTIMER_SERVICE_TASK_NAME,
-													ulTimerTaskStackSize,
-													NULL,
-													( ( UBaseType_t ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
-													pxTimerTaskStackBuffer,
-													pxTimerTaskTCBBuffer );
+				pxService->xTimerTaskHandle = xTaskCreateStatic(	prvTimerTask,
+																	configTIMER_SERVICE_TASK_NAME,
+																	ulTimerTaskStackSize,
+																	( void * ) pxService,
+																	( ( UBaseType_t ) configTIMER_SERVICE_TASK_PRIORITY( uxService ) ) | portPRIVILEGE_BIT,
+																	pxTimerTaskStackBuffer,
+																	pxTimerTaskTCBBuffer );
 
-			if( xTimerTaskHandle != NULL )
+				if( pxService->xTimerTaskHandle != NULL )
+				{
+					xReturn = pdPASS;
+				}
+			}
+			#else
 			{
-				xReturn = pdPASS;
+				xReturn = xTaskCreate(	prvTimerTask,
+										configTIMER_SERVICE_TASK_NAME,
+										configTIMER_TASK_STACK_DEPTH,
+										( void * ) pxService,
+										( ( UBaseType_t ) configTIMER_SERVICE_TASK_PRIORITY( uxService ) ) | portPRIVILEGE_BIT,
+										&( pxService->xTimerTaskHandle ) );
 			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
 		}
-		#else
+		else
 		{
-			xReturn = xTaskCreate(	prvTimerTask,
-									configTIMER_SERVICE_TASK_NAME,
-									configTIMER_TASK_STACK_DEPTH,
-									NULL,
-									( ( UBaseType_t ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
-									&xTimerTaskHandle );
+			mtCOVERAGE_TEST_MARKER();
 		}
-		#endif /* configSUPPORT_STATIC_ALLOCATION */
-	}
-	else
-	{
-		mtCOVERAGE_TEST_MARKER();
 	}
 
 	configASSERT( xReturn );
@@ -286,7 +568,7 @@ BaseType_t xReturn = pdFAIL;
 	{
 	Timer_t *pxNewTimer;
 
-		pxNewTimer = ( Timer_t * ) pvPortMalloc( sizeof( Timer_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of Timer_t is always a pointer to the timer's mame. */
+		pxNewTimer = prvAllocateTimer();
 
 		if( pxNewTimer != NULL )
 		{
@@ -353,6 +635,83 @@ BaseType_t xReturn = pdFAIL;
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+#if( ( configUSE_TICK_CONTEXT_TIMERS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	TimerHandle_t xTimerCreateTickContext(	const char * const pcTimerName,	/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+											const TickType_t xTimerPeriodInTicks,
+											const UBaseType_t uxAutoReload,
+											void * const pvTimerID,
+											TimerCallbackFunction_t pxCallbackFunction )
+	{
+	Timer_t *pxNewTimer;
+
+		pxNewTimer = xTimerCreate( pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction );
+
+		if( pxNewTimer != NULL )
+		{
+			prvInitialiseTickContextTimer( pxNewTimer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxNewTimer;
+	}
+
+#endif /* ( configUSE_TICK_CONTEXT_TIMERS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if( ( configUSE_TICK_CONTEXT_TIMERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+	TimerHandle_t xTimerCreateTickContextStatic(	const char * const pcTimerName,	/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+													const TickType_t xTimerPeriodInTicks,
+													const UBaseType_t uxAutoReload,
+													void * const pvTimerID,
+													TimerCallbackFunction_t pxCallbackFunction,
+													StaticTimer_t *pxTimerBuffer )
+	{
+	Timer_t *pxNewTimer;
+
+		pxNewTimer = xTimerCreateStatic( pcTimerName, xTimerPeriodInTicks, uxAutoReload, pvTimerID, pxCallbackFunction, pxTimerBuffer );
+
+		if( pxNewTimer != NULL )
+		{
+			prvInitialiseTickContextTimer( pxNewTimer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxNewTimer;
+	}
+
+#endif /* ( configUSE_TICK_CONTEXT_TIMERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TICK_CONTEXT_TIMERS == 1 )
+
+	static void prvInitialiseTickContextTimer( Timer_t * const pxNewTimer )
+	{
+		/* The timer is compared with the tick count using wrapping arithmetic,
+		which limits its period. */
+		configASSERT( pxNewTimer->xTimerPeriodInTicks <= tmrTICK_CONTEXT_MAX_PERIOD );
+
+		/* From now on the timer is never referenced from the timer service
+		task's active timers, only from the list of tick context timers. */
+		taskENTER_CRITICAL();
+		{
+			pxNewTimer->ucTickContext = tmrTICK_CONTEXT_STOPPED;
+			listSET_LIST_ITEM_OWNER( &( pxNewTimer->xTimerListItem ), pxNewTimer );
+			vListInsertEnd( &xTickContextTimerList, &( pxNewTimer->xTimerListItem ) );
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TICK_CONTEXT_TIMERS */
+/*-----------------------------------------------------------*/
+
 static void prvInitialiseNewTimer(	const char * const pcTimerName,			/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 									const TickType_t xTimerPeriodInTicks,
 									const UBaseType_t uxAutoReload,
@@ -377,6 +736,22 @@ static void prvInitialiseNewTimer(	const char * const pcTimerName,			/*lint !e97
 		pxNewTimer->pvTimerID = pvTimerID;
 		pxNewTimer->pxCallbackFunction = pxCallbackFunction;
 		vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
+		#if( configUSE_TICK_CONTEXT_TIMERS == 1 )
+		{
+			pxNewTimer->ucTickContext = tmrTICK_CONTEXT_NONE;
+		}
+		#endif
+		#if( configTIMER_SERVICE_TASKS > 1 )
+		{
+			pxNewTimer->ucService = ( uint8_t ) 0U;
+			pxNewTimer->uxCommandsPending = ( UBaseType_t ) 0U;
+		}
+		#endif
+		#if( configUSE_TIMER_SLACK == 1 )
+		{
+			pxNewTimer->xTimerSlack = ( TickType_t ) 0U;
+		}
+		#endif
 		traceTIMER_CREATE( pxNewTimer );
 	}
 }
@@ -386,9 +761,24 @@ BaseType_t xTimerGenericCommand( TimerHandle_t xTimer, const BaseType_t xCommand
 {
 BaseType_t xReturn = pdFAIL;
 DaemonTaskMessage_t xMessage;
+QueueHandle_t xTimerQueue;
 
 	configASSERT( xTimer );
 
+	/* Commands go to the timer service task that services the timer. */
+	xTimerQueue = tmrSERVICE_OF( xTimer )->xTimerQueue;
+
+	#if( configUSE_TICK_CONTEXT_TIMERS == 1 )
+	if( xTimer->ucTickContext != tmrTICK_CONTEXT_NONE )
+	{
+		/* Tick context timers are not serviced by the timer service task, so
+		the command is applied directly and cannot fail. */
+		xReturn = prvTickContextTimerCommand( xTimer, xCommandID, xOptionalValue );
+		traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
+	}
+	else
+	#endif /* configUSE_TICK_CONTEXT_TIMERS */
+
 	/* Send a message to the timer service task to perform a particular action
 	on a particular timer definition. */
 	if( xTimerQueue != NULL )
@@ -398,8 +788,13 @@ DaemonTaskMessage_t xMessage;
 		xMessage.u.xTimerParameters.xMessageValue = xOptionalValue;
 		xMessage.u.xTimerParameters.pxTimer = xTimer;
 
+		/* The command is counted as pending before it is sent, so the timer
+		cannot be moved to another timer service task between the command
+		being queued and it being counted. */
 		if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
 		{
+			tmrCOMMAND_PENDING( xTimer, pdFALSE );
+
 			if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
 			{
 				xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
@@ -408,10 +803,29 @@ DaemonTaskMessage_t xMessage;
 			{
 				xReturn = xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
 			}
+
+			if( xReturn == pdFAIL )
+			{
+				tmrCOMMAND_DONE( xTimer, pdFALSE );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
 		else
 		{
+			tmrCOMMAND_PENDING( xTimer, pdTRUE );
 			xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+
+			if( xReturn == pdFAIL )
+			{
+				tmrCOMMAND_DONE( xTimer, pdTRUE );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
 
 		traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
@@ -425,101 +839,573 @@ DaemonTaskMessage_t xMessage;
 }
 /*-----------------------------------------------------------*/
 
-TaskHandle_t xTimerGetTimerDaemonTaskHandle( void )
-{
-	/* If xTimerGetTimerDaemonTaskHandle() is called before the scheduler has been
-	started, then xTimerTaskHandle will be NULL. */
-	configASSERT( ( xTimerTaskHandle != NULL ) );
-	return xTimerTaskHandle;
-}
-/*-----------------------------------------------------------*/
-
-TickType_t xTimerGetPeriod( TimerHandle_t xTimer )
-{
-Timer_t *pxTimer = xTimer;
-
-	configASSERT( xTimer );
-	return pxTimer->xTimerPeriodInTicks;
-}
-/*-----------------------------------------------------------*/
-
-TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer )
-{
-Timer_t * pxTimer =  xTimer;
-TickType_t xReturn;
+#if( configUSE_TIMER_COMMAND_BATCHES == 1 )
 
-	configASSERT( xTimer );
-	xReturn = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
-	return xReturn;
-}
-/*-----------------------------------------------------------*/
+	BaseType_t xTimerGenericBatchCommand( const TimerBatchCommand_t * const pxCommands, const UBaseType_t uxNumberOfCommands, const BaseType_t xCommandID, const TickType_t xCommandTime, BaseType_t * const pxHigherPriorityTaskWoken, const TickType_t xTicksToWait )
+	{
+	BaseType_t xReturn = pdFAIL;
+	DaemonTaskMessage_t xMessage;
+	QueueHandle_t xTimerQueue;
+	TimerBatchCommand_t *pxSlot = NULL;
+	TickType_t xTicksLeft = tmrNO_DELAY;
+	TimeOut_t xTimeOut;
 
-const char * pcTimerGetName( TimerHandle_t xTimer ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-{
-Timer_t *pxTimer = xTimer;
+		configASSERT( pxCommands );
+		configASSERT( uxNumberOfCommands > ( UBaseType_t ) 0 );
+		configASSERT( uxNumberOfCommands <= ( UBaseType_t ) configTIMER_COMMAND_BATCH_LENGTH );
+		configASSERT( pxCommands[ 0 ].xTimer );
 
-	configASSERT( xTimer );
-	return pxTimer->pcTimerName;
-}
-/*-----------------------------------------------------------*/
+		/* The whole batch is applied by the timer service task that services
+		the first timer, so every timer in the batch must be serviced by that
+		task. */
+		xTimerQueue = tmrSERVICE_OF( pxCommands[ 0 ].xTimer )->xTimerQueue;
 
-static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow )
-{
-BaseType_t xResult;
-Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		#if( configASSERT_DEFINED == 1 )
+		{
+		UBaseType_t uxCommand;
 
-	/* Remove the timer from the list of active timers.  A check has already
-	been performed to ensure the list is not empty. */
-	( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
-	traceTIMER_EXPIRED( pxTimer );
+			for( uxCommand = ( UBaseType_t ) 0; uxCommand < uxNumberOfCommands; uxCommand++ )
+			{
+				configASSERT( pxCommands[ uxCommand ].xTimer );
+				configASSERT( tmrSERVICE_OF( pxCommands[ uxCommand ].xTimer )->xTimerQueue == xTimerQueue );
 
-	/* If the timer is an auto reload timer then calculate the next
-	expiry time and re-insert the timer in the list of active timers. */
-	if( pxTimer->uxAutoReload == ( UBaseType_t ) pdTRUE )
-	{
-		/* The timer is inserted into a list using a time relative to anything
-		other than the current time.  It will therefore be inserted into the
-		correct list relative to the time this task thinks it is now. */
-		if( prvInsertTimerInActiveList( pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNextExpireTime ) != pdFALSE )
-		{
-			/* The timer expired before it was added to the active timer
-			list.  Reload it now.  */
-			xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
-			configASSERT( xResult );
-			( void ) xResult;
-		}
-		else
-		{
-			mtCOVERAGE_TEST_MARKER();
+				#if( configUSE_TICK_CONTEXT_TIMERS == 1 )
+				{
+					configASSERT( pxCommands[ uxCommand ].xTimer->ucTickContext == tmrTICK_CONTEXT_NONE );
+				}
+				#endif /* configUSE_TICK_CONTEXT_TIMERS */
+			}
 		}
-	}
-	else
-	{
-		mtCOVERAGE_TEST_MARKER();
-	}
-
-	/* Call the timer callback. */
-	pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
-}
-/*-----------------------------------------------------------*/
+		#endif /* configASSERT_DEFINED */
 
-static void prvTimerTask( void *pvParameters )
-{
-TickType_t xNextExpireTime;
-BaseType_t xListWasEmpty;
+		if( ( xTimerQueue != NULL ) && ( uxNumberOfCommands <= ( UBaseType_t ) configTIMER_COMMAND_BATCH_LENGTH ) )
+		{
+			/* Take a free batch slot.  A task waits at most xTicksToWait ticks
+			in total for the slot and then for space in the timer queue. */
+			if( xCommandID == tmrCOMMAND_BATCH )
+			{
+				if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
+				{
+					xTicksLeft = xTicksToWait;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 
-	/* Just to avoid compiler warnings. */
-	( void ) pvParameters;
+				vTaskSetTimeOutState( &xTimeOut );
+				xReturn = xQueueReceive( xFreeBatchSlots, &pxSlot, xTicksLeft );
 
-	#if( configUSE_DAEMON_TASK_STARTUP_HOOK == 1 )
-	{
-		extern void vApplicationDaemonTaskStartupHook( void );
+				if( ( xReturn != pdFAIL ) && ( xTaskCheckForTimeOut( &xTimeOut, &xTicksLeft ) != pdFALSE ) )
+				{
+					xTicksLeft = tmrNO_DELAY;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				xReturn = xQueueReceiveFromISR( xFreeBatchSlots, &pxSlot, pxHigherPriorityTaskWoken );
+			}
+
+			if( xReturn != pdFAIL )
+			{
+				/* The commands are copied into the slot, so the caller can
+				change or reuse its array as soon as this function returns,
+				and the whole batch still takes only one space in the timer
+				queue. */
+				( void ) memcpy( ( void * ) pxSlot, ( const void * ) pxCommands, ( size_t ) uxNumberOfCommands * sizeof( TimerBatchCommand_t ) ); /*lint !e9087 !e9079 Copying to the batch slot. */
+
+				xMessage.xMessageID = xCommandID;
+				xMessage.u.xBatchParameters.pxCommands = pxSlot;
+				xMessage.u.xBatchParameters.uxNumberOfCommands = uxNumberOfCommands;
+				xMessage.u.xBatchParameters.xCommandTime = xCommandTime;
+
+				/* Each command in the batch is counted as pending, as if it
+				had been sent on its own. */
+				prvCountBatchPending( pxSlot, uxNumberOfCommands, pdTRUE, ( xCommandID == tmrCOMMAND_BATCH ) ? pdFALSE : pdTRUE );
+
+				if( xCommandID == tmrCOMMAND_BATCH )
+				{
+					xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksLeft );
+				}
+				else
+				{
+					xReturn = xQueueSendToBackFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+				}
+
+				if( xReturn == pdFAIL )
+				{
+					/* The batch was not sent, so its slot is free again.  There
+					is always space for it in xFreeBatchSlots. */
+					prvCountBatchPending( pxSlot, uxNumberOfCommands, pdFALSE, ( xCommandID == tmrCOMMAND_BATCH ) ? pdFALSE : pdTRUE );
+
+					if( xCommandID == tmrCOMMAND_BATCH )
+					{
+						( void ) xQueueSendToBack( xFreeBatchSlots, &pxSlot, tmrNO_DELAY );
+					}
+					else
+					{
+						( void ) xQueueSendToBackFromISR( xFreeBatchSlots, &pxSlot, pxHigherPriorityTaskWoken );
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_TIMER_COMMAND_BATCHES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TICK_CONTEXT_TIMERS == 1 )
+
+	static BaseType_t prvTickContextTimerCommand( Timer_t * const pxTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue )
+	{
+	TickType_t xTimeNow;
+	UBaseType_t uxSavedInterruptStatus;
+
+		/* The commands can be used from tasks and from interrupts, and the
+		tick interrupt updates a timer when it expires, so the state and expiry
+		time of a timer are only updated with interrupts masked.  Masking
+		interrupts this way is valid from a task too. */
+		switch( xCommandID )
+		{
+			case tmrCOMMAND_START :
+			case tmrCOMMAND_START_FROM_ISR :
+			case tmrCOMMAND_RESET :
+			case tmrCOMMAND_RESET_FROM_ISR :
+			case tmrCOMMAND_START_DONT_TRACE :
+				uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+				{
+					listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xOptionalValue + pxTimer->xTimerPeriodInTicks );
+					pxTimer->ucTickContext = tmrTICK_CONTEXT_RUNNING;
+					xTickContextTimersChanged = pdTRUE;
+				}
+				portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+				break;
+
+			case tmrCOMMAND_STOP :
+			case tmrCOMMAND_STOP_FROM_ISR :
+				/* A stopped timer is skipped by the tick interrupt, so there is
+				no need to scan the list again.  A single write cannot be torn,
+				but the mask keeps the stop ordered with respect to an expiry
+				being processed by the tick interrupt. */
+				uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+				{
+					pxTimer->ucTickContext = tmrTICK_CONTEXT_STOPPED;
+				}
+				portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+				break;
+
+			case tmrCOMMAND_CHANGE_PERIOD :
+			case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR :
+				configASSERT( ( xOptionalValue > ( TickType_t ) 0U ) && ( xOptionalValue <= tmrTICK_CONTEXT_MAX_PERIOD ) );
+
+				if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+				{
+					xTimeNow = xTaskGetTickCount();
+				}
+				else
+				{
+					xTimeNow = xTaskGetTickCountFromISR();
+				}
+
+				/* As when changing the period of a timer serviced by the timer
+				service task, the timer is started relative to the current
+				time. */
+				uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+				{
+					pxTimer->xTimerPeriodInTicks = xOptionalValue;
+					listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xTimeNow + xOptionalValue );
+					pxTimer->ucTickContext = tmrTICK_CONTEXT_RUNNING;
+					xTickContextTimersChanged = pdTRUE;
+				}
+				portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+				break;
+
+			case tmrCOMMAND_DELETE :
+				/* Deleting a timer is not a lock free operation.  The tick
+				interrupt cannot be using the timer while it is removed from
+				the list. */
+				taskENTER_CRITICAL();
+				{
+					( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+				}
+				taskEXIT_CRITICAL();
+
+				#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+				{
+					prvFreeTimer( pxTimer );
+				}
+				#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+				{
+					if( pxTimer->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+					{
+						prvFreeTimer( pxTimer );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+				break;
+
+			default :
+				/* Don't expect to get here. */
+				break;
+		}
+
+		return pdPASS;
+	}
+
+#endif /* configUSE_TICK_CONTEXT_TIMERS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TICK_CONTEXT_TIMERS == 1 )
+
+	void vTimerProcessTickContextTimers( const TickType_t xTimeNow )
+	{
+	Timer_t *pxTimer;
+	TickType_t xExpiryTime, xTicksToExpiry;
+	UBaseType_t uxTimersToCheck, uxBudget = ( UBaseType_t ) configTICK_CONTEXT_TIMER_BUDGET;
+	UBaseType_t uxSavedInterruptStatus;
+	BaseType_t xExpired, xRunning;
+
+		/* No timer can be due before the nearest expiry time found by the last
+		scan unless a timer has been started since, so most ticks do not
+		need to look at the timers at all. */
+		if( ( xTickContextTimersChanged != pdFALSE ) || ( ( TickType_t ) ( xTimeNow - xTickContextScanTime ) >= xTicksToNextTickContextScan ) )
+		{
+			xTickContextTimersChanged = pdFALSE;
+			xTickContextScanTime = xTimeNow;
+			xTicksToNextTickContextScan = tmrTICK_CONTEXT_MAX_PERIOD;
+
+			for( uxTimersToCheck = listCURRENT_LIST_LENGTH( &xTickContextTimerList ); uxTimersToCheck > ( UBaseType_t ) 0U; uxTimersToCheck-- )
+			{
+				if( uxBudget == ( UBaseType_t ) 0U )
+				{
+					/* No more callbacks can be executed in this tick.  The list
+					is walked round robin, so the timers not yet checked are
+					checked first in the next tick. */
+					xTicksToNextTickContextScan = ( TickType_t ) 1U;
+					break;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				listGET_OWNER_OF_NEXT_ENTRY( pxTimer, &xTickContextTimerList ); /*lint !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+				/* Not every port masks interrupts while the tick is processed,
+				so a higher priority interrupt can start, reset or stop the
+				timer while it is being checked.  The expiry is claimed - the
+				timer reloaded or stopped - with interrupts masked, so a
+				command either comes before the claim and is seen by it, or
+				comes after it and is not overwritten by it.  A command that
+				comes after the claim is treated as having been issued after
+				the timer expired, so the callback still executes. */
+				xExpired = pdFALSE;
+				uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+				{
+					xRunning = ( pxTimer->ucTickContext == tmrTICK_CONTEXT_RUNNING ) ? pdTRUE : pdFALSE;
+					xExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+
+					if( ( xRunning != pdFALSE ) && ( ( TickType_t ) ( xTimeNow - xExpiryTime ) <= tmrTICK_CONTEXT_MAX_PERIOD ) )
+					{
+						xExpired = pdTRUE;
+
+						if( pxTimer->uxAutoReload == ( UBaseType_t ) pdTRUE )
+						{
+							/* Reload relative to the expiry time rather than
+							the current time so the period does not drift if
+							the callback ran late. */
+							xExpiryTime += pxTimer->xTimerPeriodInTicks;
+							listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xExpiryTime );
+						}
+						else
+						{
+							pxTimer->ucTickContext = tmrTICK_CONTEXT_STOPPED;
+							xRunning = pdFALSE;
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+				if( xExpired != pdFALSE )
+				{
+					uxBudget--;
+					traceTIMER_EXPIRED( pxTimer );
+					pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* Note how long until this timer next needs checking, using the
+				expiry time claimed above.  If the callback or an interrupt has
+				changed the timer since then xTickContextTimersChanged is set
+				and the list is scanned again on the next tick anyway. */
+				if( xRunning != pdFALSE )
+				{
+					if( ( TickType_t ) ( xTimeNow - xExpiryTime ) <= tmrTICK_CONTEXT_MAX_PERIOD )
+					{
+						/* Still due after being reloaded. */
+						xTicksToExpiry = ( TickType_t ) 1U;
+					}
+					else
+					{
+						xTicksToExpiry = xExpiryTime - xTimeNow;
+					}
+
+					if( xTicksToExpiry < xTicksToNextTickContextScan )
+					{
+						xTicksToNextTickContextScan = xTicksToExpiry;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_TICK_CONTEXT_TIMERS */
+/*-----------------------------------------------------------*/
+
+TaskHandle_t xTimerGetTimerDaemonTaskHandle( void )
+{
+	return xTimerGetTimerServiceTaskHandle( ( UBaseType_t ) 0U );
+}
+/*-----------------------------------------------------------*/
+
+TaskHandle_t xTimerGetTimerServiceTaskHandle( UBaseType_t uxService )
+{
+	configASSERT( uxService < ( UBaseType_t ) configTIMER_SERVICE_TASKS );
+
+	/* If xTimerGetTimerServiceTaskHandle() is called before the scheduler has
+	been started, then xTimerTaskHandle will be NULL. */
+	configASSERT( ( xTimerServices[ uxService ].xTimerTaskHandle != NULL ) );
+	return xTimerServices[ uxService ].xTimerTaskHandle;
+}
+/*-----------------------------------------------------------*/
+
+TickType_t xTimerGetPeriod( TimerHandle_t xTimer )
+{
+Timer_t *pxTimer = xTimer;
+
+	configASSERT( xTimer );
+	return pxTimer->xTimerPeriodInTicks;
+}
+/*-----------------------------------------------------------*/
+
+TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer )
+{
+Timer_t * pxTimer =  xTimer;
+TickType_t xReturn;
+
+	configASSERT( xTimer );
+	xReturn = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+const char * pcTimerGetName( TimerHandle_t xTimer ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+{
+Timer_t *pxTimer = xTimer;
+
+	configASSERT( xTimer );
+	return pxTimer->pcTimerName;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_WHEEL == 1 )
+
+static void prvProcessExpiredTimer( TimerService_t * const pxService, const TickType_t xNextExpireTime, const TickType_t xTimeNow )
+{
+UBaseType_t uxLevel, uxShift, uxSlot;
+List_t *pxSlot;
+Timer_t *pxTimer;
+
+	/* Only the timer service task moves the wheel forward, and the wheel has no
+	work to do at any tick before xNextExpireTime. */
+	( void ) xTimeNow;
+	pxService->xTimerWheelTime = xNextExpireTime;
+
+	/* First cascade any higher level slots that start at this tick.  Their
+	timers now expire within the span of a lower level so are re-inserted
+	relative to this tick.  If this tick does not start a slot in one level
+	then it cannot start a slot in any higher level. */
+	for( uxLevel = ( UBaseType_t ) 1U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+	{
+		uxShift = uxLevel * configTIMER_WHEEL_SLOT_BITS;
+
+		if( ( xNextExpireTime & ( ( ( TickType_t ) 1U << uxShift ) - ( TickType_t ) 1U ) ) != ( TickType_t ) 0U )
+		{
+			break;
+		}
+
+		uxSlot = ( UBaseType_t ) ( xNextExpireTime >> uxShift ) & tmrWHEEL_SLOT_MASK;
+		pxSlot = &( pxService->xTimerWheel[ uxLevel ][ uxSlot ] );
+		pxService->ulTimerWheelOccupied[ uxLevel ] &= ~( 1UL << uxSlot );
+
+		while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+		{
+			pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+			( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+			prvInsertTimerInWheel( pxService, pxTimer );
+		}
+	}
+
+	/* Then expire every timer in the level 0 slot for this tick.  A reloaded
+	timer expires at least one tick later so cannot go back into this slot. */
+	uxSlot = ( UBaseType_t ) xNextExpireTime & tmrWHEEL_SLOT_MASK;
+	pxSlot = &( pxService->xTimerWheel[ 0 ][ uxSlot ] );
+	pxService->ulTimerWheelOccupied[ 0 ] &= ~( 1UL << uxSlot );
+
+	#if( configUSE_TIMER_SLACK == 1 )
+	{
+		if( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+		{
+			prvRecordExpiry( pxService, xNextExpireTime );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_TIMER_SLACK */
+
+	while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+	{
+		pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+		traceTIMER_EXPIRED( pxTimer );
+
+		/* If the timer is an auto reload timer then calculate the next expiry
+		time and re-insert the timer in the wheel.  If the new expiry time has
+		also passed then the timer is processed again as the wheel catches up
+		with the current time. */
+		if( pxTimer->uxAutoReload == ( UBaseType_t ) pdTRUE )
+		{
+			listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ) );
+			prvInsertTimerInWheel( pxService, pxTimer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Call the timer callback. */
+		pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+	}
+
+	pxService->xTimerWheelTime = xNextExpireTime + ( TickType_t ) 1U;
+}
+
+#else /* configUSE_TIMER_WHEEL */
+
+static void prvProcessExpiredTimer( TimerService_t * const pxService, const TickType_t xNextExpireTime, const TickType_t xTimeNow )
+{
+BaseType_t xResult;
+Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxService->pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+	/* Remove the timer from the list of active timers.  A check has already
+	been performed to ensure the list is not empty. */
+	( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+	traceTIMER_EXPIRED( pxTimer );
+
+	#if( configUSE_TIMER_SLACK == 1 )
+	{
+		prvRecordExpiry( pxService, xNextExpireTime );
+	}
+	#endif
+
+	/* If the timer is an auto reload timer then calculate the next
+	expiry time and re-insert the timer in the list of active timers. */
+	if( pxTimer->uxAutoReload == ( UBaseType_t ) pdTRUE )
+	{
+		/* The timer is inserted into a list using a time relative to anything
+		other than the current time.  It will therefore be inserted into the
+		correct list relative to the time this task thinks it is now. */
+		if( prvInsertTimerInActiveList( pxService, pxTimer, ( xNextExpireTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xNextExpireTime ) != pdFALSE )
+		{
+			/* The timer expired before it was added to the active timer
+			list.  Reload it now.  */
+			xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
+			configASSERT( xResult );
+			( void ) xResult;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Call the timer callback. */
+	pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+}
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+static void prvTimerTask( void *pvParameters )
+{
+TickType_t xNextExpireTime;
+BaseType_t xListWasEmpty;
+TimerService_t * const pxService = ( TimerService_t * ) pvParameters;
+
+	#if( configUSE_DAEMON_TASK_STARTUP_HOOK == 1 )
+	{
+		extern void vApplicationDaemonTaskStartupHook( void );
 
 		/* Allow the application writer to execute some code in the context of
 		this task at the point the task starts executing.  This is useful if the
 		application includes initialisation code that would benefit from
-		executing after the scheduler has been started. */
-		vApplicationDaemonTaskStartupHook();
+		executing after the scheduler has been started.  Only the first timer
+		service task calls the hook. */
+		if( pxService == &( xTimerServices[ 0 ] ) )
+		{
+			vApplicationDaemonTaskStartupHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 	}
 	#endif /* configUSE_DAEMON_TASK_STARTUP_HOOK */
 
@@ -527,19 +1413,19 @@ BaseType_t xListWasEmpty;
 	{
 		/* Query the timers list to see if it contains any timers, and if so,
 		obtain the time at which the next timer will expire. */
-		xNextExpireTime = prvGetNextExpireTime( &xListWasEmpty );
+		xNextExpireTime = prvGetNextExpireTime( pxService, &xListWasEmpty );
 
 		/* If a timer has expired, process it.  Otherwise, block this task
 		until either a timer does expire, or a command is received. */
-		prvProcessTimerOrBlockTask( xNextExpireTime, xListWasEmpty );
+		prvProcessTimerOrBlockTask( pxService, xNextExpireTime, xListWasEmpty );
 
 		/* Empty the command queue. */
-		prvProcessReceivedCommands();
+		prvProcessReceivedCommands( pxService );
 	}
 }
 /*-----------------------------------------------------------*/
 
-static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime, BaseType_t xListWasEmpty )
+static void prvProcessTimerOrBlockTask( TimerService_t * const pxService, const TickType_t xNextExpireTime, BaseType_t xListWasEmpty )
 {
 TickType_t xTimeNow;
 BaseType_t xTimerListsWereSwitched;
@@ -551,14 +1437,18 @@ BaseType_t xTimerListsWereSwitched;
 		then don't process this timer as any timers that remained in the list
 		when the lists were switched will have been processed within the
 		prvSampleTimeNow() function. */
-		xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+		xTimeNow = prvSampleTimeNow( pxService, &xTimerListsWereSwitched );
 		if( xTimerListsWereSwitched == pdFALSE )
 		{
 			/* The tick count has not overflowed, has the timer expired? */
-			if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+			#if( configUSE_TIMER_WHEEL == 1 )
+				if( ( xListWasEmpty == pdFALSE ) && ( tmrWHEEL_TICK_IS_DUE( xNextExpireTime, xTimeNow, pxService->xTimerWheelTime ) != pdFALSE ) )
+			#else
+				if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+			#endif
 			{
 				( void ) xTaskResumeAll();
-				prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+				prvProcessExpiredTimer( pxService, xNextExpireTime, xTimeNow );
 			}
 			else
 			{
@@ -568,14 +1458,30 @@ BaseType_t xTimerListsWereSwitched;
 				received - whichever comes first.  The following line cannot
 				be reached unless xNextExpireTime > xTimeNow, except in the
 				case when the current timer list is empty. */
-				if( xListWasEmpty != pdFALSE )
+				#if( configUSE_TIMER_WHEEL == 0 )
 				{
-					/* The current timer list is empty - is the overflow list
-					also empty? */
-					xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
+					if( xListWasEmpty != pdFALSE )
+					{
+						/* The current timer list is empty - is the overflow list
+						also empty? */
+						xListWasEmpty = listLIST_IS_EMPTY( pxService->pxOverflowTimerList );
+					}
 				}
+				#endif /* configUSE_TIMER_WHEEL */
 
-				vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
+				#if( configUSE_TIMER_SLACK == 1 )
+				{
+					/* Block until the first timer reaches the end of its slack,
+					rather than until the first timer expires, so every timer
+					that expires before then is processed in one wake up. */
+					pxService->xTimerTaskBlocked = pdTRUE;
+					vQueueWaitForMessageRestricted( pxService->xTimerQueue, prvGetSlackTicksToWait( pxService, xNextExpireTime, xTimeNow ), xListWasEmpty );
+				}
+				#else
+				{
+					vQueueWaitForMessageRestricted( pxService->xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
+				}
+				#endif /* configUSE_TIMER_SLACK */
 
 				if( xTaskResumeAll() == pdFALSE )
 				{
@@ -599,7 +1505,57 @@ BaseType_t xTimerListsWereSwitched;
 }
 /*-----------------------------------------------------------*/
 
-static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
+#if( configUSE_TIMER_WHEEL == 1 )
+
+static TickType_t prvGetNextExpireTime( TimerService_t * const pxService, BaseType_t * const pxListWasEmpty )
+{
+TickType_t xNextExpireTime = ( TickType_t ) 0U, xAlign, xTicks;
+UBaseType_t uxLevel, uxShift, uxFirst;
+uint32_t ulOccupied;
+
+	/* The wheel next has work to do either when a level 0 slot that is not
+	empty is reached, or when the start of a higher level slot that is not empty
+	is reached and its timers must be cascaded.  Find the nearest such tick.
+	Cascading may reveal no timer that is due, in which case this task simply
+	blocks again, so there are at most tmrWHEEL_LEVELS extra wake ups per
+	timer.  If the wheel is empty then the time returned is not used. */
+	*pxListWasEmpty = pdTRUE;
+
+	for( uxLevel = ( UBaseType_t ) 0U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+	{
+		ulOccupied = pxService->ulTimerWheelOccupied[ uxLevel ];
+
+		if( ulOccupied != 0UL )
+		{
+			/* xAlign is the number of ticks until the next slot in this level
+			starts, and uxFirst is the index of that slot. */
+			uxShift = uxLevel * configTIMER_WHEEL_SLOT_BITS;
+			xAlign = ( ( TickType_t ) 0U - pxService->xTimerWheelTime ) & ( ( ( TickType_t ) 1U << uxShift ) - ( TickType_t ) 1U );
+			uxFirst = ( UBaseType_t ) ( ( pxService->xTimerWheelTime + xAlign ) >> uxShift ) & tmrWHEEL_SLOT_MASK;
+
+			/* Rotate the occupied bits so bit 0 represents slot uxFirst. */
+			if( uxFirst != ( UBaseType_t ) 0U )
+			{
+				ulOccupied = ( ( ulOccupied >> uxFirst ) | ( ulOccupied << ( tmrWHEEL_SLOTS - uxFirst ) ) ) & tmrWHEEL_OCCUPIED_MASK;
+			}
+
+			xTicks = xAlign + ( ( TickType_t ) prvLowestSetBit( ulOccupied ) << uxShift );
+
+			if( ( *pxListWasEmpty != pdFALSE ) || ( xTicks < xNextExpireTime ) )
+			{
+				xNextExpireTime = xTicks;
+			}
+
+			*pxListWasEmpty = pdFALSE;
+		}
+	}
+
+	return pxService->xTimerWheelTime + xNextExpireTime;
+}
+
+#else /* configUSE_TIMER_WHEEL */
+
+static TickType_t prvGetNextExpireTime( TimerService_t * const pxService, BaseType_t * const pxListWasEmpty )
 {
 TickType_t xNextExpireTime;
 
@@ -610,10 +1566,10 @@ TickType_t xNextExpireTime;
 	this task to unblock when the tick count overflows, at which point the
 	timer lists will be switched and the next expiry time can be
 	re-assessed.  */
-	*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+	*pxListWasEmpty = listLIST_IS_EMPTY( pxService->pxCurrentTimerList );
 	if( *pxListWasEmpty == pdFALSE )
 	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxService->pxCurrentTimerList );
 	}
 	else
 	{
@@ -623,32 +1579,343 @@ TickType_t xNextExpireTime;
 
 	return xNextExpireTime;
 }
+
+#endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if( ( configUSE_TIMER_SLACK == 1 ) && ( configUSE_TIMER_WHEEL == 1 ) )
+
+	static TickType_t prvGetSlackTicksToWait( TimerService_t * const pxService, const TickType_t xNextExpireTime, const TickType_t xTimeNow )
+	{
+	TickType_t xWakeTicks = portMAX_DELAY, xAlign, xTicks, xSlack;
+	UBaseType_t uxLevel, uxShift, uxFirst, uxBit;
+	uint32_t ulOccupied;
+	BaseType_t xFound = pdFALSE;
+
+		/* Each timer in a slot expires no earlier than the start of the slot, so
+		the start of each slot that is not empty plus the smallest slack in the
+		slot is a time by which the wheel must be processed.  Find the earliest,
+		measured in ticks from xTimerWheelTime.  Any cascade or expiry before
+		then is processed late as the wheel catches up with the current time. */
+		for( uxLevel = ( UBaseType_t ) 0U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+		{
+			ulOccupied = pxService->ulTimerWheelOccupied[ uxLevel ];
+
+			if( ulOccupied != 0UL )
+			{
+				/* As prvGetNextExpireTime(), rotate the occupied bits so bit 0
+				represents uxFirst, the next slot in this level to start. */
+				uxShift = uxLevel * configTIMER_WHEEL_SLOT_BITS;
+				xAlign = ( ( TickType_t ) 0U - pxService->xTimerWheelTime ) & ( ( ( TickType_t ) 1U << uxShift ) - ( TickType_t ) 1U );
+				uxFirst = ( UBaseType_t ) ( ( pxService->xTimerWheelTime + xAlign ) >> uxShift ) & tmrWHEEL_SLOT_MASK;
+
+				if( uxFirst != ( UBaseType_t ) 0U )
+				{
+					ulOccupied = ( ( ulOccupied >> uxFirst ) | ( ulOccupied << ( tmrWHEEL_SLOTS - uxFirst ) ) ) & tmrWHEEL_OCCUPIED_MASK;
+				}
+
+				while( ulOccupied != 0UL )
+				{
+					uxBit = prvLowestSetBit( ulOccupied );
+					ulOccupied &= ~( 1UL << uxBit );
+					xTicks = xAlign + ( ( TickType_t ) uxBit << uxShift );
+
+					/* Later slots in this level start later still. */
+					if( ( xFound != pdFALSE ) && ( xTicks >= xWakeTicks ) )
+					{
+						break;
+					}
+
+					xSlack = pxService->xTimerWheelSlack[ uxLevel ][ ( uxFirst + uxBit ) & tmrWHEEL_SLOT_MASK ];
+
+					if( xSlack > ( portMAX_DELAY - xTicks ) )
+					{
+						xTicks = portMAX_DELAY;
+					}
+					else
+					{
+						xTicks += xSlack;
+					}
+
+					if( ( xFound == pdFALSE ) || ( xTicks < xWakeTicks ) )
+					{
+						xWakeTicks = xTicks;
+						xFound = pdTRUE;
+					}
+				}
+			}
+		}
+
+		if( xFound != pdFALSE )
+		{
+			/* The next tick the wheel has work to do is after xTimeNow, so
+			xWakeTicks is too. */
+			xTicks = xWakeTicks - ( xTimeNow - pxService->xTimerWheelTime );
+		}
+		else
+		{
+			xTicks = xNextExpireTime - xTimeNow;
+		}
+
+		return xTicks;
+	}
+
+#elif( configUSE_TIMER_SLACK == 1 )
+
+	static TickType_t prvGetSlackTicksToWait( TimerService_t * const pxService, const TickType_t xNextExpireTime, const TickType_t xTimeNow )
+	{
+	TickType_t xWakeTime, xExpiryTime;
+	const ListItem_t *pxItem;
+	const ListItem_t * const pxListEnd = listGET_END_MARKER( pxService->pxCurrentTimerList );
+	const Timer_t *pxTimer;
+
+		if( listLIST_IS_EMPTY( pxService->pxCurrentTimerList ) == pdFALSE )
+		{
+			/* Each timer can be processed at any time from its expiry time to
+			its expiry time plus its slack, so wake at the earliest end of such
+			a window.  The list is in expiry time order and no window ends
+			before its timer expires, so only timers that expire before the
+			wake time found so far need to be checked.  Slack is not carried
+			past the tick count overflowing. */
+			xWakeTime = portMAX_DELAY;
+
+			for( pxItem = listGET_HEAD_ENTRY( pxService->pxCurrentTimerList ); pxItem != pxListEnd; pxItem = listGET_NEXT( pxItem ) )
+			{
+				xExpiryTime = listGET_LIST_ITEM_VALUE( pxItem );
+
+				if( xExpiryTime >= xWakeTime )
+				{
+					break;
+				}
+
+				pxTimer = ( const Timer_t * ) listGET_LIST_ITEM_OWNER( pxItem ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+				if( pxTimer->xTimerSlack < ( xWakeTime - xExpiryTime ) )
+				{
+					xWakeTime = xExpiryTime + pxTimer->xTimerSlack;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		else
+		{
+			/* Wait for the tick count to overflow as before. */
+			xWakeTime = xNextExpireTime;
+		}
+
+		return xWakeTime - xTimeNow;
+	}
+
+#endif /* configUSE_TIMER_SLACK */
 /*-----------------------------------------------------------*/
 
-static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
+#if( configUSE_TIMER_SLACK == 1 )
+
+	static void prvRecordExpiry( TimerService_t * const pxService, const TickType_t xExpiryTime )
+	{
+		if( pxService->xTimerTaskBlocked != pdFALSE )
+		{
+			/* The first expiry processed since the task last blocked. */
+			pxService->xTimerTaskBlocked = pdFALSE;
+			pxService->ulTimerWakeUps++;
+			pxService->ulTimerExpiryTimes++;
+		}
+		else if( xExpiryTime != pxService->xLastExpiryTime )
+		{
+			/* Without slack this expiry time would have needed a separate
+			wake up. */
+			pxService->ulTimerExpiryTimes++;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxService->xLastExpiryTime = xExpiryTime;
+	}
+
+#endif /* configUSE_TIMER_SLACK */
+/*-----------------------------------------------------------*/
+
+static TickType_t prvSampleTimeNow( TimerService_t * const pxService, BaseType_t * const pxTimerListsWereSwitched )
 {
 TickType_t xTimeNow;
-PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
 
-	xTimeNow = xTaskGetTickCount();
+	xTimeNow = xTaskGetTickCount();
+
+	#if( configUSE_TIMER_WHEEL == 1 )
+	{
+		/* The wheel works with times relative to xTimerWheelTime, so there are
+		no lists to switch when the tick count overflows. */
+		*pxTimerListsWereSwitched = pdFALSE;
+	}
+	#else
+	{
+		if( xTimeNow < pxService->xLastTime )
+		{
+			prvSwitchTimerLists( pxService );
+			*pxTimerListsWereSwitched = pdTRUE;
+		}
+		else
+		{
+			*pxTimerListsWereSwitched = pdFALSE;
+		}
+
+		pxService->xLastTime = xTimeNow;
+	}
+	#endif /* configUSE_TIMER_WHEEL */
+
+	return xTimeNow;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_WHEEL == 1 )
+
+static BaseType_t prvInsertTimerInActiveList( TimerService_t * const pxService, Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime )
+{
+BaseType_t xProcessTimerNow = pdFALSE;
+TickType_t xElapsedTime;
+UBaseType_t uxLevel;
+uint32_t ulOccupied = 0UL;
+
+	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
+	listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+
+	/* If no timers are active then the wheel can be moved straight to the
+	current time. */
+	for( uxLevel = ( UBaseType_t ) 0U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+	{
+		ulOccupied |= pxService->ulTimerWheelOccupied[ uxLevel ];
+	}
+
+	if( ulOccupied == 0UL )
+	{
+		pxService->xTimerWheelTime = xTimeNow + ( TickType_t ) 1U;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Has the expiry time elapsed between the command to start/reset a timer
+	was issued and the time the command was processed?  If so the timer only
+	needs processing now if the wheel has already moved past its expiry time,
+	otherwise the wheel will expire it as it catches up with the current
+	time. */
+	xElapsedTime = xTimeNow - xCommandTime;
+
+	if( ( xElapsedTime >= pxTimer->xTimerPeriodInTicks ) && ( ( TickType_t ) ( xElapsedTime - pxTimer->xTimerPeriodInTicks ) >= ( TickType_t ) ( xTimeNow + ( TickType_t ) 1U - pxService->xTimerWheelTime ) ) ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+	{
+		xProcessTimerNow = pdTRUE;
+	}
+	else
+	{
+		prvInsertTimerInWheel( pxService, pxTimer );
+	}
+
+	return xProcessTimerNow;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertTimerInWheel( TimerService_t * const pxService, Timer_t * const pxTimer )
+{
+const TickType_t xExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+const TickType_t xTicksRemaining = xExpiryTime - pxService->xTimerWheelTime;
+UBaseType_t uxLevel = ( UBaseType_t ) 0U, uxSlot;
+
+	/* Use the lowest level whose span covers the ticks remaining, so the timer
+	is cascaded down before its expiry time, and index the slot by the
+	expiry time itself. */
+	while( ( uxLevel < ( tmrWHEEL_LEVELS - 1U ) ) && ( ( xTicksRemaining >> ( ( uxLevel + 1U ) * configTIMER_WHEEL_SLOT_BITS ) ) != ( TickType_t ) 0U ) )
+	{
+		uxLevel++;
+	}
+
+	uxSlot = ( UBaseType_t ) ( xExpiryTime >> ( uxLevel * configTIMER_WHEEL_SLOT_BITS ) ) & tmrWHEEL_SLOT_MASK;
+	vListInsertEnd( &( pxService->xTimerWheel[ uxLevel ][ uxSlot ] ), &( pxTimer->xTimerListItem ) );
+
+	#if( configUSE_TIMER_SLACK == 1 )
+	{
+		/* Removing a timer does not raise the slot's slack again until the
+		slot is empty, which can only make the timer service task wake
+		earlier than necessary. */
+		if( ( ( pxService->ulTimerWheelOccupied[ uxLevel ] & ( 1UL << uxSlot ) ) == 0UL ) || ( pxTimer->xTimerSlack < pxService->xTimerWheelSlack[ uxLevel ][ uxSlot ] ) )
+		{
+			pxService->xTimerWheelSlack[ uxLevel ][ uxSlot ] = pxTimer->xTimerSlack;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_TIMER_SLACK */
+
+	pxService->ulTimerWheelOccupied[ uxLevel ] |= ( 1UL << uxSlot );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveTimerFromWheel( TimerService_t * const pxService, Timer_t * const pxTimer )
+{
+const List_t * const pxSlot = listLIST_ITEM_CONTAINER( &( pxTimer->xTimerListItem ) );
+UBaseType_t uxIndex;
+
+	if( uxListRemove( &( pxTimer->xTimerListItem ) ) == ( UBaseType_t ) 0U )
+	{
+		/* The slot is now empty.  Its position in the wheel gives its level
+		and slot number. */
+		uxIndex = ( UBaseType_t ) ( pxSlot - &( pxService->xTimerWheel[ 0 ][ 0 ] ) ); /*lint !e946 !e947 The slot is always within xTimerWheel. */
+		pxService->ulTimerWheelOccupied[ uxIndex >> configTIMER_WHEEL_SLOT_BITS ] &= ~( 1UL << ( uxIndex & tmrWHEEL_SLOT_MASK ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvLowestSetBit( uint32_t ulBits )
+{
+UBaseType_t uxBit = ( UBaseType_t ) 0U;
+
+	/* At most 16 slots per level, so a fixed number of steps. */
+	if( ( ulBits & 0xffUL ) == 0UL )
+	{
+		ulBits >>= 8;
+		uxBit += ( UBaseType_t ) 8U;
+	}
 
-	if( xTimeNow < xLastTime )
+	if( ( ulBits & 0x0fUL ) == 0UL )
 	{
-		prvSwitchTimerLists();
-		*pxTimerListsWereSwitched = pdTRUE;
+		ulBits >>= 4;
+		uxBit += ( UBaseType_t ) 4U;
 	}
-	else
+
+	if( ( ulBits & 0x03UL ) == 0UL )
 	{
-		*pxTimerListsWereSwitched = pdFALSE;
+		ulBits >>= 2;
+		uxBit += ( UBaseType_t ) 2U;
+	}
+
+	if( ( ulBits & 0x01UL ) == 0UL )
+	{
+		uxBit += ( UBaseType_t ) 1U;
 	}
 
-	xLastTime = xTimeNow;
+	return uxBit;
+}
+
+#else /* configUSE_TIMER_WHEEL */
 
-	return xTimeNow;
+static BaseType_t prvInsertTimerInActiveList( TimerService_t * const pxService, Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime )
+{
+	return prvInsertTimerInLists( pxTimer, xNextExpiryTime, xTimeNow, xCommandTime, pxService->pxCurrentTimerList, pxService->pxOverflowTimerList );
 }
 /*-----------------------------------------------------------*/
 
-static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime )
+static BaseType_t prvInsertTimerInLists( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime, List_t * const pxCurrentList, List_t * const pxOverflowList )
 {
 BaseType_t xProcessTimerNow = pdFALSE;
 
@@ -667,7 +1934,7 @@ BaseType_t xProcessTimerNow = pdFALSE;
 		}
 		else
 		{
-			vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			vListInsert( pxOverflowList, &( pxTimer->xTimerListItem ) );
 		}
 	}
 	else
@@ -681,22 +1948,24 @@ BaseType_t xProcessTimerNow = pdFALSE;
 		}
 		else
 		{
-			vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			vListInsert( pxCurrentList, &( pxTimer->xTimerListItem ) );
 		}
 	}
 
 	return xProcessTimerNow;
 }
+
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
-static void	prvProcessReceivedCommands( void )
+static void	prvProcessReceivedCommands( TimerService_t * const pxService )
 {
 DaemonTaskMessage_t xMessage;
 Timer_t *pxTimer;
 BaseType_t xTimerListsWereSwitched, xResult;
 TickType_t xTimeNow;
 
-	while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
+	while( xQueueReceive( pxService->xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
 	{
 		#if ( INCLUDE_xTimerPendFunctionCall == 1 )
 		{
@@ -720,6 +1989,15 @@ TickType_t xTimeNow;
 		}
 		#endif /* INCLUDE_xTimerPendFunctionCall */
 
+		#if( configUSE_TIMER_COMMAND_BATCHES == 1 )
+		if( ( xMessage.xMessageID == tmrCOMMAND_BATCH ) || ( xMessage.xMessageID == tmrCOMMAND_BATCH_FROM_ISR ) )
+		{
+			/* The message references an array of timer commands. */
+			prvProcessCommandBatch( pxService, &( xMessage.u.xBatchParameters ) );
+		}
+		else
+		#endif /* configUSE_TIMER_COMMAND_BATCHES */
+
 		/* Commands that are positive are timer commands rather than pended
 		function calls. */
 		if( xMessage.xMessageID >= ( BaseType_t ) 0 )
@@ -731,7 +2009,15 @@ TickType_t xTimeNow;
 			if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
 			{
 				/* The timer is in a list, remove it. */
-				( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+				#if( configUSE_TIMER_WHEEL == 1 )
+				{
+					prvRemoveTimerFromWheel( pxService, pxTimer );
+				}
+				#else
+				{
+					( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+				}
+				#endif /* configUSE_TIMER_WHEEL */
 			}
 			else
 			{
@@ -746,7 +2032,7 @@ TickType_t xTimeNow;
 			possibility of a higher priority task adding a message to the message
 			queue with a time that is ahead of the timer daemon task (because it
 			pre-empted the timer daemon task after the xTimeNow value was set). */
-			xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+			xTimeNow = prvSampleTimeNow( pxService, &xTimerListsWereSwitched );
 
 			switch( xMessage.xMessageID )
 			{
@@ -756,7 +2042,7 @@ TickType_t xTimeNow;
 			    case tmrCOMMAND_RESET_FROM_ISR :
 				case tmrCOMMAND_START_DONT_TRACE :
 					/* Start or restart a timer. */
-					if( prvInsertTimerInActiveList( pxTimer,  xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) != pdFALSE )
+					if( prvInsertTimerInActiveList( pxService, pxTimer,  xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) != pdFALSE )
 					{
 						/* The timer expired before it was added to the active
 						timer list.  Process it now. */
@@ -797,7 +2083,7 @@ TickType_t xTimeNow;
 					be zero the next expiry time can only be in the future,
 					meaning (unlike for the xTimerStart() case above) there is
 					no fail case that needs to be handled here. */
-					( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+					( void ) prvInsertTimerInActiveList( pxService, pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
 					break;
 
 				case tmrCOMMAND_DELETE :
@@ -808,7 +2094,7 @@ TickType_t xTimeNow;
 					{
 						/* The timer can only have been allocated dynamically -
 						free it again. */
-						vPortFree( pxTimer );
+						prvFreeTimer( pxTimer );
 					}
 					#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
 					{
@@ -817,7 +2103,7 @@ TickType_t xTimeNow;
 						memory. */
 						if( pxTimer->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
 						{
-							vPortFree( pxTimer );
+							prvFreeTimer( pxTimer );
 						}
 						else
 						{
@@ -831,12 +2117,174 @@ TickType_t xTimeNow;
 					/* Don't expect to get here. */
 					break;
 			}
+
+			/* A deleted timer no longer exists, so only the other commands
+			are counted as done. */
+			if( xMessage.xMessageID != tmrCOMMAND_DELETE )
+			{
+				tmrCOMMAND_DONE( pxTimer, pdFALSE );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
 	}
 }
 /*-----------------------------------------------------------*/
 
-static void prvSwitchTimerLists( void )
+#if( configUSE_TIMER_COMMAND_BATCHES == 1 )
+
+	static void prvProcessCommandBatch( TimerService_t * const pxService, const BatchParameters_t * const pxBatch )
+	{
+	const TimerBatchCommand_t *pxCommand;
+	Timer_t *pxTimer;
+	UBaseType_t uxCommand;
+	BaseType_t xTimerListsWereSwitched, xProcessTimerNow;
+	TickType_t xTimeNow, xCommandTime;
+
+		#if( configUSE_TIMER_WHEEL == 0 )
+			/* The timers started by the batch are first sorted into these
+			short lists, which are then merged into the active lists in a
+			single pass, rather than searching the active lists once for each
+			timer.  A timer in one of these lists is still active, and can be
+			removed again by a later command in the batch. */
+			List_t xBatchCurrentList, xBatchOverflowList;
+
+			vListInitialise( &xBatchCurrentList );
+			vListInitialise( &xBatchOverflowList );
+		#endif
+
+		/* The time is sampled once for the whole batch.  As in
+		prvProcessReceivedCommands(), this is done after the batch was received
+		from the timer queue, so xTimeNow cannot be behind the time at which
+		the batch was sent. */
+		xTimeNow = prvSampleTimeNow( pxService, &xTimerListsWereSwitched );
+
+		for( uxCommand = ( UBaseType_t ) 0; uxCommand < pxBatch->uxNumberOfCommands; uxCommand++ )
+		{
+			pxCommand = &( pxBatch->pxCommands[ uxCommand ] );
+			pxTimer = pxCommand->xTimer;
+			configASSERT( tmrSERVICE_OF( pxTimer ) == pxService );
+
+			if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+			{
+				/* The timer is in a list, remove it. */
+				#if( configUSE_TIMER_WHEEL == 1 )
+				{
+					prvRemoveTimerFromWheel( pxService, pxTimer );
+				}
+				#else
+				{
+					( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+				}
+				#endif /* configUSE_TIMER_WHEEL */
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Traced with the value the equivalent single command would carry. */
+			traceTIMER_COMMAND_RECEIVED( pxTimer, pxCommand->xCommandID, ( ( pxCommand->xCommandID == tmrCOMMAND_CHANGE_PERIOD ) ? pxCommand->xNewPeriod : pxBatch->xCommandTime ) );
+
+			switch( pxCommand->xCommandID )
+			{
+				case tmrCOMMAND_START :
+				case tmrCOMMAND_RESET :
+					/* Start or restart the timer.  If the timer expired before
+					it was added to the active timer list its callback is
+					executed now, as in prvProcessReceivedCommands().  An auto
+					reload timer is then reloaded directly rather than by
+					posting a further command to the timer queue, as a batch of
+					late timers could otherwise fill the timer queue. */
+					xCommandTime = pxBatch->xCommandTime;
+
+					for( ;; )
+					{
+						#if( configUSE_TIMER_WHEEL == 1 )
+						{
+							/* Inserting into the wheel does not search, so
+							the timer is placed in the wheel directly. */
+							xProcessTimerNow = prvInsertTimerInActiveList( pxService, pxTimer, xCommandTime + pxTimer->xTimerPeriodInTicks, xTimeNow, xCommandTime );
+						}
+						#else
+						{
+							xProcessTimerNow = prvInsertTimerInLists( pxTimer, xCommandTime + pxTimer->xTimerPeriodInTicks, xTimeNow, xCommandTime, &xBatchCurrentList, &xBatchOverflowList );
+						}
+						#endif /* configUSE_TIMER_WHEEL */
+
+						if( xProcessTimerNow == pdFALSE )
+						{
+							break;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+
+						pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+						traceTIMER_EXPIRED( pxTimer );
+
+						if( pxTimer->uxAutoReload == ( UBaseType_t ) pdFALSE )
+						{
+							break;
+						}
+						else
+						{
+							xCommandTime += pxTimer->xTimerPeriodInTicks;
+						}
+					}
+					break;
+
+				case tmrCOMMAND_STOP :
+					/* The timer has already been removed from the active list.
+					There is nothing to do here. */
+					break;
+
+				case tmrCOMMAND_CHANGE_PERIOD :
+					pxTimer->xTimerPeriodInTicks = pxCommand->xNewPeriod;
+					configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+
+					#if( configUSE_TIMER_WHEEL == 1 )
+					{
+						( void ) prvInsertTimerInActiveList( pxService, pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+					}
+					#else
+					{
+						( void ) prvInsertTimerInLists( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow, &xBatchCurrentList, &xBatchOverflowList );
+					}
+					#endif /* configUSE_TIMER_WHEEL */
+					break;
+
+				default	:
+					/* Only start, reset, stop and change period commands can
+					be batched. */
+					configASSERT( pdFALSE );
+					break;
+			}
+
+			tmrCOMMAND_DONE( pxTimer, pdFALSE );
+		}
+
+		/* The batch slot is not referenced again, so it can be reused.  There
+		is always space for it in xFreeBatchSlots. */
+		( void ) xQueueSendToBack( xFreeBatchSlots, &( pxBatch->pxCommands ), tmrNO_DELAY );
+
+		#if( configUSE_TIMER_WHEEL == 0 )
+		{
+			vListMerge( pxService->pxCurrentTimerList, &xBatchCurrentList );
+			vListMerge( pxService->pxOverflowTimerList, &xBatchOverflowList );
+		}
+		#endif /* configUSE_TIMER_WHEEL */
+	}
+
+#endif /* configUSE_TIMER_COMMAND_BATCHES */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_WHEEL == 0 )
+
+static void prvSwitchTimerLists( TimerService_t * const pxService )
 {
 TickType_t xNextExpireTime, xReloadTime;
 List_t *pxTemp;
@@ -847,12 +2295,12 @@ BaseType_t xResult;
 	If there are any timers still referenced from the current timer list
 	then they must have expired and should be processed before the lists
 	are switched. */
-	while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+	while( listLIST_IS_EMPTY( pxService->pxCurrentTimerList ) == pdFALSE )
 	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxService->pxCurrentTimerList );
 
 		/* Remove the timer from the list. */
-		pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxService->pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
 		traceTIMER_EXPIRED( pxTimer );
 
@@ -874,7 +2322,7 @@ BaseType_t xResult;
 			{
 				listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xReloadTime );
 				listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
-				vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+				vListInsert( pxService->pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
 			}
 			else
 			{
@@ -889,53 +2337,124 @@ BaseType_t xResult;
 		}
 	}
 
-	pxTemp = pxCurrentTimerList;
-	pxCurrentTimerList = pxOverflowTimerList;
-	pxOverflowTimerList = pxTemp;
+	pxTemp = pxService->pxCurrentTimerList;
+	pxService->pxCurrentTimerList = pxService->pxOverflowTimerList;
+	pxService->pxOverflowTimerList = pxTemp;
 }
+
+#endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
 static void prvCheckForValidListAndQueue( void )
 {
-	/* Check that the list from which active timers are referenced, and the
-	queue used to communicate with the timer service, have been
+UBaseType_t uxService;
+TimerService_t *pxService;
+
+	/* Check that the lists from which active timers are referenced, and the
+	queues used to communicate with the timer service tasks, have been
 	initialised. */
 	taskENTER_CRITICAL();
 	{
-		if( xTimerQueue == NULL )
+		if( xTimerServices[ 0 ].xTimerQueue == NULL )
 		{
-			vListInitialise( &xActiveTimerList1 );
-			vListInitialise( &xActiveTimerList2 );
-			pxCurrentTimerList = &xActiveTimerList1;
-			pxOverflowTimerList = &xActiveTimerList2;
-
-			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			#if( configUSE_TICK_CONTEXT_TIMERS == 1 )
 			{
-				/* The timer queue is allocated statically in case
-				configSUPPORT_DYNAMIC_ALLOCATION is 0. */
-				static StaticQueue_t xStaticTimerQueue; /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
-				static uint8_t ucStaticTimerQueueStorage[ ( size_t ) configTIMER_QUEUE_LENGTH * sizeof( DaemonTaskMessage_t ) ]; /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
-
-				xTimerQueue = xQueueCreateStatic( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, ( UBaseType_t ) sizeof( DaemonTaskMessage_t ), &( ucStaticTimerQueueStorage[ 0 ] ), &xStaticTimerQueue );
+				vListInitialise( &xTickContextTimerList );
 			}
-			#else
+			#endif /* configUSE_TICK_CONTEXT_TIMERS */
+
+			for( uxService = ( UBaseType_t ) 0U; uxService < ( UBaseType_t ) configTIMER_SERVICE_TASKS; uxService++ )
 			{
-				xTimerQueue = xQueueCreate( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, sizeof( DaemonTaskMessage_t ) );
+				pxService = &( xTimerServices[ uxService ] );
+
+				#if( configUSE_TIMER_WHEEL == 1 )
+				{
+				UBaseType_t uxLevel, uxSlot;
+
+					for( uxLevel = ( UBaseType_t ) 0U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+					{
+						for( uxSlot = ( UBaseType_t ) 0U; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+						{
+							vListInitialise( &( pxService->xTimerWheel[ uxLevel ][ uxSlot ] ) );
+						}
+					}
+				}
+				#else
+				{
+					vListInitialise( &( pxService->xActiveTimerList1 ) );
+					vListInitialise( &( pxService->xActiveTimerList2 ) );
+					pxService->pxCurrentTimerList = &( pxService->xActiveTimerList1 );
+					pxService->pxOverflowTimerList = &( pxService->xActiveTimerList2 );
+				}
+				#endif /* configUSE_TIMER_WHEEL */
+
+				#if( configUSE_TIMER_SLACK == 1 )
+				{
+					pxService->xTimerTaskBlocked = pdTRUE;
+				}
+				#endif
+
+				#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+				{
+					/* The timer queues are allocated statically in case
+					configSUPPORT_DYNAMIC_ALLOCATION is 0. */
+					static StaticQueue_t xStaticTimerQueue[ configTIMER_SERVICE_TASKS ]; /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
+					static uint8_t ucStaticTimerQueueStorage[ configTIMER_SERVICE_TASKS ][ ( size_t ) configTIMER_QUEUE_LENGTH * sizeof( DaemonTaskMessage_t ) ]; /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
+
+					pxService->xTimerQueue = xQueueCreateStatic( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, ( UBaseType_t ) sizeof( DaemonTaskMessage_t ), &( ucStaticTimerQueueStorage[ uxService ][ 0 ] ), &( xStaticTimerQueue[ uxService ] ) );
+				}
+				#else
+				{
+					pxService->xTimerQueue = xQueueCreate( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, sizeof( DaemonTaskMessage_t ) );
+				}
+				#endif
+
+				#if ( configQUEUE_REGISTRY_SIZE > 0 )
+				{
+					if( pxService->xTimerQueue != NULL )
+					{
+						vQueueAddToRegistry( pxService->xTimerQueue, "TmrQ" );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configQUEUE_REGISTRY_SIZE */
 			}
-			#endif
 
-			#if ( configQUEUE_REGISTRY_SIZE > 0 )
+			#if( configUSE_TIMER_COMMAND_BATCHES == 1 )
 			{
-				if( xTimerQueue != NULL )
+			UBaseType_t uxSlot;
+			TimerBatchCommand_t *pxSlot;
+
+				#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+				{
+					static StaticQueue_t xStaticFreeBatchSlots; /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
+					static uint8_t ucStaticFreeBatchSlotsStorage[ ( size_t ) configTIMER_COMMAND_BATCH_SLOTS * sizeof( TimerBatchCommand_t * ) ]; /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
+
+					xFreeBatchSlots = xQueueCreateStatic( ( UBaseType_t ) configTIMER_COMMAND_BATCH_SLOTS, ( UBaseType_t ) sizeof( TimerBatchCommand_t * ), &( ucStaticFreeBatchSlotsStorage[ 0 ] ), &xStaticFreeBatchSlots );
+				}
+				#else
+				{
+					xFreeBatchSlots = xQueueCreate( ( UBaseType_t ) configTIMER_COMMAND_BATCH_SLOTS, sizeof( TimerBatchCommand_t * ) );
+				}
+				#endif
+
+				if( xFreeBatchSlots != NULL )
 				{
-					vQueueAddToRegistry( xTimerQueue, "TmrQ" );
+					for( uxSlot = ( UBaseType_t ) 0U; uxSlot < ( UBaseType_t ) configTIMER_COMMAND_BATCH_SLOTS; uxSlot++ )
+					{
+						pxSlot = &( xBatchSlots[ uxSlot ][ 0 ] );
+						( void ) xQueueSendToBack( xFreeBatchSlots, &pxSlot, tmrNO_DELAY );
+					}
 				}
 				else
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
 			}
-			#endif /* configQUEUE_REGISTRY_SIZE */
+			#endif /* configUSE_TIMER_COMMAND_BATCHES */
 		}
 		else
 		{
@@ -956,6 +2475,16 @@ Timer_t *pxTimer = xTimer;
 	/* Is the timer in the list of active timers? */
 	taskENTER_CRITICAL();
 	{
+		#if( configUSE_TICK_CONTEXT_TIMERS == 1 )
+		if( pxTimer->ucTickContext != tmrTICK_CONTEXT_NONE )
+		{
+			/* Tick context timers are always referenced from the list of tick
+			context timers, so record whether they are running separately. */
+			xTimerIsInActiveList = ( pxTimer->ucTickContext == tmrTICK_CONTEXT_RUNNING ) ? pdTRUE : pdFALSE;
+		}
+		else
+		#endif /* configUSE_TICK_CONTEXT_TIMERS */
+
 		/* Checking to see if it is in the NULL list in effect checks to see if
 		it is referenced from either the current or the overflow timer lists in
 		one go, but the logic has to be reversed, hence the '!'. */
@@ -1005,13 +2534,189 @@ Timer_t * const pxTimer = xTimer;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TIMER_SLACK == 1 )
+
+	void vTimerSetSlack( TimerHandle_t xTimer, const TickType_t xSlack )
+	{
+	Timer_t * const pxTimer = xTimer;
+
+		configASSERT( xTimer );
+
+		taskENTER_CRITICAL();
+		{
+			pxTimer->xTimerSlack = xSlack;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TIMER_SLACK */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_SLACK == 1 )
+
+	TickType_t xTimerGetSlack( TimerHandle_t xTimer )
+	{
+	Timer_t * const pxTimer = xTimer;
+
+		configASSERT( xTimer );
+		return pxTimer->xTimerSlack;
+	}
+
+#endif /* configUSE_TIMER_SLACK */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TIMER_SLACK == 1 )
+
+	void vTimerGetWakeStats( TimerWakeStats_t *pxStats )
+	{
+	UBaseType_t uxService;
+
+		configASSERT( pxStats );
+
+		pxStats->ulWakeUps = 0UL;
+		pxStats->ulExpiryTimes = 0UL;
+
+		/* The counts are totals for all the timer service tasks. */
+		taskENTER_CRITICAL();
+		{
+			for( uxService = ( UBaseType_t ) 0U; uxService < ( UBaseType_t ) configTIMER_SERVICE_TASKS; uxService++ )
+			{
+				pxStats->ulWakeUps += xTimerServices[ uxService ].ulTimerWakeUps;
+				pxStats->ulExpiryTimes += xTimerServices[ uxService ].ulTimerExpiryTimes;
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		pxStats->ulWakeUpsSaved = pxStats->ulExpiryTimes - pxStats->ulWakeUps;
+	}
+
+#endif /* configUSE_TIMER_SLACK */
+/*-----------------------------------------------------------*/
+
+#if( configTIMER_SERVICE_TASKS > 1 )
+
+	BaseType_t xTimerSetServiceTask( TimerHandle_t xTimer, UBaseType_t uxService )
+	{
+	Timer_t * const pxTimer = xTimer;
+	BaseType_t xReturn = pdFAIL;
+
+		configASSERT( xTimer );
+		configASSERT( uxService < ( UBaseType_t ) configTIMER_SERVICE_TASKS );
+
+		/* Only the current timer service task can access its active timers,
+		and a command still waiting in its queue, or being processed, would be
+		applied by it after the move.  So the timer is only moved if it is not
+		active and no command sent to it is pending.  The check and the move
+		are made in one critical section, so no command can be sent to the
+		old timer service task in between. */
+		taskENTER_CRITICAL();
+		{
+			if( ( xTimerIsTimerActive( xTimer ) == pdFALSE ) && ( pxTimer->uxCommandsPending == ( UBaseType_t ) 0U ) )
+			{
+				pxTimer->ucService = ( uint8_t ) uxService;
+				xReturn = pdPASS;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		return xReturn;
+	}
+
+#endif /* configTIMER_SERVICE_TASKS */
+/*-----------------------------------------------------------*/
+
+#if( configTIMER_SERVICE_TASKS > 1 )
+
+	static void prvCountCommandPending( Timer_t * const pxTimer, const BaseType_t xPending, const BaseType_t xFromISR )
+	{
+	UBaseType_t uxSavedInterruptStatus = 0;
+
+		/* Commands are sent from tasks and interrupts, and processed by the
+		timer service task, so the count is only updated with interrupts
+		masked. */
+		if( xFromISR == pdFALSE )
+		{
+			taskENTER_CRITICAL();
+		}
+		else
+		{
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		}
+
+		if( xPending != pdFALSE )
+		{
+			( pxTimer->uxCommandsPending )++;
+		}
+		else
+		{
+			configASSERT( pxTimer->uxCommandsPending > ( UBaseType_t ) 0U );
+			( pxTimer->uxCommandsPending )--;
+		}
+
+		if( xFromISR == pdFALSE )
+		{
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+	}
+
+#endif /* configTIMER_SERVICE_TASKS */
+/*-----------------------------------------------------------*/
+
+#if( ( configTIMER_SERVICE_TASKS > 1 ) && ( configUSE_TIMER_COMMAND_BATCHES == 1 ) )
+
+	static void prvCountBatchPending( const TimerBatchCommand_t * const pxCommands, const UBaseType_t uxNumberOfCommands, const BaseType_t xPending, const BaseType_t xFromISR )
+	{
+	UBaseType_t uxCommand;
+
+		for( uxCommand = ( UBaseType_t ) 0; uxCommand < uxNumberOfCommands; uxCommand++ )
+		{
+			prvCountCommandPending( pxCommands[ uxCommand ].xTimer, xPending, xFromISR );
+		}
+	}
+
+#endif /* ( configTIMER_SERVICE_TASKS > 1 ) && ( configUSE_TIMER_COMMAND_BATCHES == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if( configTIMER_SERVICE_TASKS > 1 )
+
+	UBaseType_t uxTimerGetServiceTask( TimerHandle_t xTimer )
+	{
+	Timer_t * const pxTimer = xTimer;
+
+		configASSERT( xTimer );
+		return ( UBaseType_t ) pxTimer->ucService;
+	}
+
+#endif /* configTIMER_SERVICE_TASKS */
+/*-----------------------------------------------------------*/
+
 #if( INCLUDE_xTimerPendFunctionCall == 1 )
 
 	BaseType_t xTimerPendFunctionCallFromISR( PendedFunction_t xFunctionToPend, void *pvParameter1, uint32_t ulParameter2, BaseType_t *pxHigherPriorityTaskWoken )
+	{
+		return xTimerPendFunctionCallFromISRToService( ( UBaseType_t ) 0U, xFunctionToPend, pvParameter1, ulParameter2, pxHigherPriorityTaskWoken );
+	}
+
+#endif /* INCLUDE_xTimerPendFunctionCall */
+/*-----------------------------------------------------------*/
+
+#if( INCLUDE_xTimerPendFunctionCall == 1 )
+
+	BaseType_t xTimerPendFunctionCallFromISRToService( UBaseType_t uxService, PendedFunction_t xFunctionToPend, void *pvParameter1, uint32_t ulParameter2, BaseType_t *pxHigherPriorityTaskWoken )
 	{
 	DaemonTaskMessage_t xMessage;
 	BaseType_t xReturn;
 
+		configASSERT( uxService < ( UBaseType_t ) configTIMER_SERVICE_TASKS );
+
 		/* Complete the message with the function parameters and post it to the
 		daemon task. */
 		xMessage.xMessageID = tmrCOMMAND_EXECUTE_CALLBACK_FROM_ISR;
@@ -1019,7 +2724,7 @@ Timer_t * const pxTimer = xTimer;
 		xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
 		xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
 
-		xReturn = xQueueSendFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+		xReturn = xQueueSendFromISR( xTimerServices[ uxService ].xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
 
 		tracePEND_FUNC_CALL_FROM_ISR( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
 
@@ -1032,14 +2737,26 @@ Timer_t * const pxTimer = xTimer;
 #if( INCLUDE_xTimerPendFunctionCall == 1 )
 
 	BaseType_t xTimerPendFunctionCall( PendedFunction_t xFunctionToPend, void *pvParameter1, uint32_t ulParameter2, TickType_t xTicksToWait )
+	{
+		return xTimerPendFunctionCallToService( ( UBaseType_t ) 0U, xFunctionToPend, pvParameter1, ulParameter2, xTicksToWait );
+	}
+
+#endif /* INCLUDE_xTimerPendFunctionCall */
+/*-----------------------------------------------------------*/
+
+#if( INCLUDE_xTimerPendFunctionCall == 1 )
+
+	BaseType_t xTimerPendFunctionCallToService( UBaseType_t uxService, PendedFunction_t xFunctionToPend, void *pvParameter1, uint32_t ulParameter2, TickType_t xTicksToWait )
 	{
 	DaemonTaskMessage_t xMessage;
 	BaseType_t xReturn;
 
+		configASSERT( uxService < ( UBaseType_t ) configTIMER_SERVICE_TASKS );
+
 		/* This function can only be called after a timer has been created or
 		after the scheduler has been started because, until then, the timer
 		queue does not exist. */
-		configASSERT( xTimerQueue );
+		configASSERT( xTimerServices[ uxService ].xTimerQueue );
 
 		/* Complete the message with the function parameters and post it to the
 		daemon task. */
@@ -1048,7 +2765,7 @@ Timer_t * const pxTimer = xTimer;
 		xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
 		xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
 
-		xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+		xReturn = xQueueSendToBack( xTimerServices[ uxService ].xTimerQueue, &xMessage, xTicksToWait );
 
 		tracePEND_FUNC_CALL( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
 
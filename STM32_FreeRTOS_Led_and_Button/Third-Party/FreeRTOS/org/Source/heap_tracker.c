@@ -0,0 +1,624 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "heap_tracker.h"
+
+/* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+to include the heap tracker.  This #if is closed at the very bottom of this
+file.  If you want to include the heap tracker then ensure
+configUSE_HEAP_TRACKER is set to 1 in FreeRTOSConfig.h. */
+#if( configUSE_HEAP_TRACKER == 1 )
+
+#if( ( configHEAP_TRACKER_TABLE_SIZE & ( configHEAP_TRACKER_TABLE_SIZE - 1 ) ) != 0 )
+	#error configHEAP_TRACKER_TABLE_SIZE must be a power of two.
+#endif
+
+#if( ( configHEAP_TRACKER_CALL_SITES & ( configHEAP_TRACKER_CALL_SITES - 1 ) ) != 0 ) || ( configHEAP_TRACKER_CALL_SITES > 0x10000 )
+	#error configHEAP_TRACKER_CALL_SITES must be a power of two no larger than 0x10000.
+#endif
+
+#if( ( INCLUDE_xTaskGetSchedulerState != 1 ) && ( configUSE_TIMERS != 1 ) )
+	#error INCLUDE_xTaskGetSchedulerState or configUSE_TIMERS must be set to 1 to use the heap tracker.
+#endif
+
+#if( ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error INCLUDE_xTaskGetCurrentTaskHandle or configUSE_MUTEXES must be set to 1 to use the heap tracker.
+#endif
+
+/* The side table is a hash table keyed by the address of the allocation, using
+linear probing.  It is never filled beyond three quarters of its entries so
+the probe sequences stay short, which keeps the time interrupts are masked for
+short too. */
+#define trackerTABLE_MASK		( ( UBaseType_t ) configHEAP_TRACKER_TABLE_SIZE - ( UBaseType_t ) 1 )
+#define trackerMAX_ENTRIES		( ( ( UBaseType_t ) configHEAP_TRACKER_TABLE_SIZE / ( UBaseType_t ) 4 ) * ( UBaseType_t ) 3 )
+#define trackerCALL_SITE_MASK	( ( UBaseType_t ) configHEAP_TRACKER_CALL_SITES - ( UBaseType_t ) 1 )
+
+/* Bits used in the ucFlags member of a HeapTrackerEntry_t. */
+#define trackerOWNER_DELETED	( ( uint8_t ) 0x01 )
+
+/* An entry in the side table.  Entries whose pvAddress member is NULL are
+unused. */
+typedef struct HEAP_TRACKER_ENTRY
+{
+	void *pvAddress;						/*<< The address returned by pvPortMalloc(). */
+	uint32_t ulSize;						/*<< The size passed to traceMALLOC(). */
+	TickType_t xTimeAllocated;				/*<< The tick count at which the block was allocated. */
+	TaskHandle_t xOwner;					/*<< The task that owns the block, or NULL if the block has no owner. */
+	uint16_t usCallSite;					/*<< The index of the block's call site in xCallSites[]. */
+	uint8_t ucFlags;						/*<< trackerOWNER_DELETED if the owner has been deleted. */
+} HeapTrackerEntry_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Hash an address or a return address to a starting index in a table of
+ * ( uxMask + 1 ) entries.
+ */
+static UBaseType_t prvHash( const void *pv, UBaseType_t uxMask ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the index of the call site pvCaller in xCallSites[], adding the call
+ * site if it has not been seen before.  Returns configHEAP_TRACKER_CALL_SITES
+ * if the call site is new and xCallSites[] is full.
+ */
+static UBaseType_t prvFindCallSite( void *pvCaller ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the index of the entry for pvAddress in xEntries[], or
+ * configHEAP_TRACKER_TABLE_SIZE if pvAddress is not tracked.
+ */
+static UBaseType_t prvFindEntry( const void *pvAddress ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove the entry at uxHole from xEntries[], moving the entries that follow
+ * it back so no probe sequence is broken by the unused entry.
+ */
+static void prvRemoveEntry( UBaseType_t uxHole ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by uxHeapTrackerGetAllocations() and uxHeapTrackerGetLeaks().
+ */
+static UBaseType_t prvGetAllocations( HeapTrackerAllocation_t *pxAllocations, UBaseType_t uxMaxAllocations, BaseType_t xLeaksOnly ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+/* The side table and the totals of each call site.  A call site is in use if
+it has made at least one allocation, so a NULL return address, as recorded when
+configHEAP_TRACKER_CALLER() is not available, is a call site like any other. */
+static HeapTrackerEntry_t xEntries[ configHEAP_TRACKER_TABLE_SIZE ];
+static HeapTrackerCallSite_t xCallSites[ configHEAP_TRACKER_CALL_SITES ];
+
+/* Overall statistics, reported by vHeapTrackerGetStats(). */
+static UBaseType_t uxTrackedBlocks = 0U;
+static size_t xTrackedBytes = 0U;
+static UBaseType_t uxCallSitesUsed = 0U;
+static UBaseType_t uxSuspectedLeaks = 0U;
+static size_t xSuspectedLeakBytes = 0U;
+static uint32_t ulUntrackedAllocations = 0UL;
+
+/*-----------------------------------------------------------*/
+
+void vHeapTrackerMalloc( void *pvAddress, size_t xSize, void *pvCaller, BaseType_t xFromISR )
+{
+HeapTrackerEntry_t *pxEntry;
+HeapTrackerCallSite_t *pxCallSite;
+TaskHandle_t xOwner;
+TickType_t xTimeNow;
+UBaseType_t uxSavedInterruptStatus, uxCallSite, uxIndex;
+
+	/* Blocks allocated before the scheduler starts belong to no task, and
+	neither do blocks allocated from an interrupt. */
+	if( ( xFromISR == pdFALSE ) && ( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED ) )
+	{
+		xOwner = xTaskGetCurrentTaskHandle();
+	}
+	else
+	{
+		xOwner = NULL;
+	}
+
+	xTimeNow = xTaskGetTickCountFromISR();
+
+	/* The heap may be used from interrupts, so the tables are protected by
+	masking interrupts rather than by suspending the scheduler. */
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		uxCallSite = prvFindCallSite( pvCaller );
+
+		if( uxCallSite < ( UBaseType_t ) configHEAP_TRACKER_CALL_SITES )
+		{
+			pxCallSite = &( xCallSites[ uxCallSite ] );
+
+			if( pvAddress == NULL )
+			{
+				( pxCallSite->ulFailedAllocations )++;
+			}
+			else
+			{
+				( pxCallSite->ulAllocations )++;
+
+				if( uxTrackedBlocks < trackerMAX_ENTRIES )
+				{
+					/* The table is never full, so an unused entry will be
+					found. */
+					uxIndex = prvHash( pvAddress, trackerTABLE_MASK );
+
+					while( xEntries[ uxIndex ].pvAddress != NULL )
+					{
+						uxIndex = ( uxIndex + ( UBaseType_t ) 1 ) & trackerTABLE_MASK;
+					}
+
+					pxEntry = &( xEntries[ uxIndex ] );
+					pxEntry->pvAddress = pvAddress;
+					pxEntry->ulSize = ( uint32_t ) xSize;
+					pxEntry->xTimeAllocated = xTimeNow;
+					pxEntry->xOwner = xOwner;
+					pxEntry->usCallSite = ( uint16_t ) uxCallSite;
+					pxEntry->ucFlags = 0U;
+
+					uxTrackedBlocks++;
+					xTrackedBytes += xSize;
+					( pxCallSite->uxLiveBlocks )++;
+					pxCallSite->xLiveBytes += xSize;
+
+					if( pxCallSite->xLiveBytes > pxCallSite->xPeakLiveBytes )
+					{
+						pxCallSite->xPeakLiveBytes = pxCallSite->xLiveBytes;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					ulUntrackedAllocations++;
+				}
+			}
+		}
+		else if( pvAddress != NULL )
+		{
+			ulUntrackedAllocations++;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vHeapTrackerFree( void *pvAddress )
+{
+HeapTrackerEntry_t *pxEntry;
+HeapTrackerCallSite_t *pxCallSite;
+UBaseType_t uxSavedInterruptStatus, uxIndex;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		uxIndex = prvFindEntry( pvAddress );
+
+		/* Blocks that were not tracked are ignored. */
+		if( uxIndex < ( UBaseType_t ) configHEAP_TRACKER_TABLE_SIZE )
+		{
+			pxEntry = &( xEntries[ uxIndex ] );
+			pxCallSite = &( xCallSites[ pxEntry->usCallSite ] );
+
+			( pxCallSite->uxLiveBlocks )--;
+			pxCallSite->xLiveBytes -= ( size_t ) pxEntry->ulSize;
+			uxTrackedBlocks--;
+			xTrackedBytes -= ( size_t ) pxEntry->ulSize;
+
+			if( ( pxEntry->ucFlags & trackerOWNER_DELETED ) != 0U )
+			{
+				/* A block that outlived its owner is freed after all. */
+				uxSuspectedLeaks--;
+				xSuspectedLeakBytes -= ( size_t ) pxEntry->ulSize;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			prvRemoveEntry( uxIndex );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vHeapTrackerSetOwner( void *pvAddress, TaskHandle_t xOwner )
+{
+HeapTrackerEntry_t *pxEntry;
+UBaseType_t uxSavedInterruptStatus, uxIndex;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		uxIndex = prvFindEntry( pvAddress );
+
+		if( uxIndex < ( UBaseType_t ) configHEAP_TRACKER_TABLE_SIZE )
+		{
+			pxEntry = &( xEntries[ uxIndex ] );
+			pxEntry->xOwner = xOwner;
+
+			if( ( pxEntry->ucFlags & trackerOWNER_DELETED ) != 0U )
+			{
+				/* The block has been adopted, so is no longer a suspected
+				leak. */
+				pxEntry->ucFlags &= ( uint8_t ) ~trackerOWNER_DELETED;
+				uxSuspectedLeaks--;
+				xSuspectedLeakBytes -= ( size_t ) pxEntry->ulSize;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vHeapTrackerTaskDeleted( TaskHandle_t xTask )
+{
+HeapTrackerEntry_t *pxEntry;
+UBaseType_t uxSavedInterruptStatus, uxIndex;
+
+	/* The whole table is scanned in one go, as entries can move when another
+	block is freed. */
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		for( uxIndex = 0; uxIndex < ( UBaseType_t ) configHEAP_TRACKER_TABLE_SIZE; uxIndex++ )
+		{
+			pxEntry = &( xEntries[ uxIndex ] );
+
+			/* The handle of a deleted task can be reused by a task created
+			later, so blocks that are already marked keep their mark and are
+			not counted again. */
+			if( ( pxEntry->pvAddress != NULL ) && ( pxEntry->xOwner == xTask ) && ( ( pxEntry->ucFlags & trackerOWNER_DELETED ) == 0U ) )
+			{
+				pxEntry->ucFlags |= trackerOWNER_DELETED;
+				uxSuspectedLeaks++;
+				xSuspectedLeakBytes += ( size_t ) pxEntry->ulSize;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxHeapTrackerGetCallSites( HeapTrackerCallSite_t *pxCallSites, UBaseType_t uxMaxCallSites )
+{
+HeapTrackerCallSite_t xCallSite;
+UBaseType_t uxSavedInterruptStatus, uxIndex, uxFound = 0;
+
+	/* Call sites are never removed or moved, so each can be copied in its own
+	short critical section. */
+	for( uxIndex = 0; ( uxIndex < ( UBaseType_t ) configHEAP_TRACKER_CALL_SITES ) && ( uxFound < uxMaxCallSites ); uxIndex++ )
+	{
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			xCallSite = xCallSites[ uxIndex ];
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		if( ( xCallSite.ulAllocations != 0UL ) || ( xCallSite.ulFailedAllocations != 0UL ) )
+		{
+			pxCallSites[ uxFound ] = xCallSite;
+			uxFound++;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return uxFound;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxHeapTrackerGetTopCallSites( HeapTrackerCallSite_t *pxCallSites, UBaseType_t uxCount )
+{
+HeapTrackerCallSite_t xCallSite;
+UBaseType_t uxSavedInterruptStatus, uxIndex, uxPosition, uxFound = 0;
+
+	for( uxIndex = 0; uxIndex < ( UBaseType_t ) configHEAP_TRACKER_CALL_SITES; uxIndex++ )
+	{
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			xCallSite = xCallSites[ uxIndex ];
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		if( xCallSite.xLiveBytes > ( size_t ) 0 )
+		{
+			/* Insert the call site into the sorted array, dropping the
+			smallest if the array is already full. */
+			for( uxPosition = uxFound; ( uxPosition > ( UBaseType_t ) 0 ) && ( pxCallSites[ uxPosition - 1 ].xLiveBytes < xCallSite.xLiveBytes ); uxPosition-- )
+			{
+				if( uxPosition < uxCount )
+				{
+					pxCallSites[ uxPosition ] = pxCallSites[ uxPosition - 1 ];
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			if( uxPosition < uxCount )
+			{
+				pxCallSites[ uxPosition ] = xCallSite;
+
+				if( uxFound < uxCount )
+				{
+					uxFound++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return uxFound;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxHeapTrackerGetAllocations( HeapTrackerAllocation_t *pxAllocations, UBaseType_t uxMaxAllocations )
+{
+	return prvGetAllocations( pxAllocations, uxMaxAllocations, pdFALSE );
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxHeapTrackerGetLeaks( HeapTrackerAllocation_t *pxAllocations, UBaseType_t uxMaxAllocations )
+{
+	return prvGetAllocations( pxAllocations, uxMaxAllocations, pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+void vHeapTrackerGetStats( HeapTrackerStats_t *pxStats )
+{
+UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		pxStats->uxTrackedBlocks = uxTrackedBlocks;
+		pxStats->xTrackedBytes = xTrackedBytes;
+		pxStats->uxCallSites = uxCallSitesUsed;
+		pxStats->uxSuspectedLeaks = uxSuspectedLeaks;
+		pxStats->xSuspectedLeakBytes = xSuspectedLeakBytes;
+		pxStats->ulUntrackedAllocations = ulUntrackedAllocations;
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvHash( const void *pv, UBaseType_t uxMask )
+{
+uint32_t ulHash;
+
+	/* Fibonacci hashing, folded so the high bits, which depend on all the
+	bits of the address, reach the bits used as the index. */
+	ulHash = ( uint32_t ) ( size_t ) pv;
+	ulHash *= 0x9E3779B1UL;
+	ulHash ^= ulHash >> 16;
+
+	return ( UBaseType_t ) ulHash & uxMask;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindCallSite( void *pvCaller )
+{
+HeapTrackerCallSite_t *pxCallSite;
+UBaseType_t uxIndex, uxProbes;
+
+	uxIndex = prvHash( pvCaller, trackerCALL_SITE_MASK );
+
+	for( uxProbes = 0; uxProbes < ( UBaseType_t ) configHEAP_TRACKER_CALL_SITES; uxProbes++ )
+	{
+		pxCallSite = &( xCallSites[ uxIndex ] );
+
+		if( ( pxCallSite->ulAllocations == 0UL ) && ( pxCallSite->ulFailedAllocations == 0UL ) )
+		{
+			/* An unused call site, so pvCaller has not been seen before.  The
+			caller counts the allocation, which marks the call site as used. */
+			pxCallSite->pvCaller = pvCaller;
+			uxCallSitesUsed++;
+			break;
+		}
+		else if( pxCallSite->pvCaller == pvCaller )
+		{
+			break;
+		}
+		else
+		{
+			uxIndex = ( uxIndex + ( UBaseType_t ) 1 ) & trackerCALL_SITE_MASK;
+		}
+	}
+
+	if( uxProbes == ( UBaseType_t ) configHEAP_TRACKER_CALL_SITES )
+	{
+		uxIndex = ( UBaseType_t ) configHEAP_TRACKER_CALL_SITES;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return uxIndex;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindEntry( const void *pvAddress )
+{
+UBaseType_t uxIndex;
+
+	uxIndex = prvHash( pvAddress, trackerTABLE_MASK );
+
+	/* The table always has unused entries, which end every probe sequence. */
+	while( ( xEntries[ uxIndex ].pvAddress != pvAddress ) && ( xEntries[ uxIndex ].pvAddress != NULL ) )
+	{
+		uxIndex = ( uxIndex + ( UBaseType_t ) 1 ) & trackerTABLE_MASK;
+	}
+
+	if( ( pvAddress == NULL ) || ( xEntries[ uxIndex ].pvAddress == NULL ) )
+	{
+		uxIndex = ( UBaseType_t ) configHEAP_TRACKER_TABLE_SIZE;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return uxIndex;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveEntry( UBaseType_t uxHole )
+{
+UBaseType_t uxNext, uxHome;
+
+	uxNext = uxHole;
+
+	for( ;; )
+	{
+		uxNext = ( uxNext + ( UBaseType_t ) 1 ) & trackerTABLE_MASK;
+
+		if( xEntries[ uxNext ].pvAddress == NULL )
+		{
+			break;
+		}
+
+		/* The entry can fill the hole if the hole lies between the entry's
+		home index and its current index, as it would otherwise no longer be
+		found. */
+		uxHome = prvHash( xEntries[ uxNext ].pvAddress, trackerTABLE_MASK );
+
+		if( ( ( uxNext - uxHome ) & trackerTABLE_MASK ) >= ( ( uxNext - uxHole ) & trackerTABLE_MASK ) )
+		{
+			xEntries[ uxHole ] = xEntries[ uxNext ];
+			uxHole = uxNext;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	xEntries[ uxHole ].pvAddress = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvGetAllocations( HeapTrackerAllocation_t *pxAllocations, UBaseType_t uxMaxAllocations, BaseType_t xLeaksOnly )
+{
+HeapTrackerEntry_t *pxEntry;
+HeapTrackerAllocation_t *pxAllocation;
+UBaseType_t uxSavedInterruptStatus, uxIndex, uxFound = 0;
+
+	/* Entries move when a block is freed, so the whole table is copied with
+	interrupts masked to be sure no entry is missed or copied twice. */
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		for( uxIndex = 0; ( uxIndex < ( UBaseType_t ) configHEAP_TRACKER_TABLE_SIZE ) && ( uxFound < uxMaxAllocations ); uxIndex++ )
+		{
+			pxEntry = &( xEntries[ uxIndex ] );
+
+			if( ( pxEntry->pvAddress != NULL ) && ( ( xLeaksOnly == pdFALSE ) || ( ( pxEntry->ucFlags & trackerOWNER_DELETED ) != 0U ) ) )
+			{
+				pxAllocation = &( pxAllocations[ uxFound ] );
+				pxAllocation->pvAddress = pxEntry->pvAddress;
+				pxAllocation->xSize = ( size_t ) pxEntry->ulSize;
+				pxAllocation->pvCaller = xCallSites[ pxEntry->usCallSite ].pvCaller;
+				pxAllocation->xOwner = pxEntry->xOwner;
+				pxAllocation->xTimeAllocated = pxEntry->xTimeAllocated;
+
+				if( ( pxEntry->ucFlags & trackerOWNER_DELETED ) != 0U )
+				{
+					pxAllocation->xOwnerDeleted = pdTRUE;
+				}
+				else
+				{
+					pxAllocation->xOwnerDeleted = pdFALSE;
+				}
+
+				uxFound++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return uxFound;
+}
+
+/* This entire source file will be skipped if the application is not configured
+to include the heap tracker.  If you want to include the heap tracker then
+ensure configUSE_HEAP_TRACKER is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_HEAP_TRACKER == 1 */
@@ -0,0 +1,774 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "hr_timers.h"
+
+/* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e9021 !e961 !e750. */
+
+
+/* This entire source file will be skipped if the application is not configured
+to include high resolution timer functionality.  This #if is closed at the very
+bottom of this file.  If you want to include high resolution timer
+functionality then ensure configUSE_HR_TIMERS is set to 1 in
+FreeRTOSConfig.h. */
+#if ( configUSE_HR_TIMERS == 1 )
+
+#if( configUSE_16_BIT_TICKS == 1 )
+	#error Expiry counts are held as list item values, so configUSE_16_BIT_TICKS must be 0 when configUSE_HR_TIMERS is 1.
+#endif
+
+/* The definition of the high resolution timers themselves. */
+typedef struct HRTimerDefinition
+{
+	ListItem_t					xTimerListItem;		/*<< Standard linked list item as used by all kernel features for event management.  Its value is the counter value the timer is sorted by - the expiry count, or the count when the timer was started if its expiry count had already passed. */
+	HRTimerCallbackFunction_t	pxCallbackFunction;	/*<< The function that will be called when the timer expires, or NULL. */
+	void 						*pvTimerID;			/*<< An ID to identify the timer. */
+	uint32_t					ulExpiryCount;		/*<< The counter value at which the timer expires, as it was started. */
+	#if( configUSE_TASK_NOTIFICATIONS == 1 )
+		TaskHandle_t			xTaskToNotify;		/*<< The task given a notification when the timer expires, or NULL. */
+		UBaseType_t				uxIndexToNotify;	/*<< The index of the notification given to xTaskToNotify. */
+	#endif
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t 				ucStaticallyAllocated; /*<< Set to pdTRUE if the timer was created statically so no attempt is made to free the memory again if the timer is later deleted. */
+	#endif
+} HRTimer_t;
+
+/*lint -save -e956 A manual analysis and inspection has been used to determine
+which static variables must be declared volatile. */
+
+/* Active timers are held in two lists sorted by expiry count, in the same way
+as the software timers in timers.c.  Timers that expire before the counter next
+overflows are referenced from pxCurrentHRTimerList, and timers that expire
+after it overflows are referenced from pxOverflowHRTimerList.  ulLastCount is
+the counter value when the lists were last checked for an overflow, at which
+point the lists are switched.  The lists are only switched when
+pxCurrentHRTimerList is empty - if it is not then the timers it references have
+all expired, and the compare interrupt switches the lists once it has processed
+them.  The lists and ulLastCount are only accessed with interrupts masked up to
+configMAX_SYSCALL_INTERRUPT_PRIORITY, so they cannot be accessed by the compare
+interrupt at the same time. */
+PRIVILEGED_DATA static List_t xActiveHRTimerList1;
+PRIVILEGED_DATA static List_t xActiveHRTimerList2;
+PRIVILEGED_DATA static List_t *pxCurrentHRTimerList = NULL;
+PRIVILEGED_DATA static List_t *pxOverflowHRTimerList = NULL;
+PRIVILEGED_DATA static uint32_t ulLastCount = 0UL;
+
+/*lint -restore */
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Initialises the active timer lists and configures the counter, if that has
+ * not been done already.
+ */
+static void prvCheckForValidLists( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called after a high resolution timer has been allocated statically or
+ * dynamically to fill in the structure's members.
+ */
+static void prvInitialiseNewHRTimer( HRTimerCallbackFunction_t pxCallbackFunction, void * const pvTimerID, HRTimer_t *pxNewTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Swap pxCurrentHRTimerList and pxOverflowHRTimerList.
+ */
+static void prvSwitchHRTimerLists( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Switch the active timer lists if the counter has overflowed since it was
+ * last sampled and no timers from before the overflow remain, and record the
+ * counter value.
+ */
+static void prvCheckForOverflow( const uint32_t ulNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove the timer from the active timer lists if it is in one, then insert it
+ * into the list that is correct for ulExpiryCount and set the compare value.
+ */
+static void prvStartHRTimer( HRTimer_t * const pxTimer, const uint32_t ulExpiryCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove the timer from the active timer lists and set the compare value.
+ * Returns pdPASS if the timer was active, otherwise pdFAIL.
+ */
+static BaseType_t prvStopHRTimer( HRTimer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the compare interrupt to obtain the next timer that has expired
+ * and has still to be processed, or NULL if there is none.
+ */
+static HRTimer_t *prvGetExpiredHRTimer( const uint32_t ulNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Set the compare value to the expiry count of the timer that will expire
+ * next, or disable the compare interrupt if no timers are active.  Returns
+ * pdTRUE if that timer has already expired, in which case the compare value
+ * is set a little ahead of the current count.
+ */
+static BaseType_t prvSetCompareValue( void ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	HRTimerHandle_t xHRTimerCreate( HRTimerCallbackFunction_t pxCallbackFunction, void * const pvTimerID )
+	{
+	HRTimer_t *pxNewTimer;
+
+		pxNewTimer = ( HRTimer_t * ) pvPortMalloc( sizeof( HRTimer_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack. */
+
+		if( pxNewTimer != NULL )
+		{
+			prvInitialiseNewHRTimer( pxCallbackFunction, pvTimerID, pxNewTimer );
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				/* Timers can be created statically or dynamically, so note this
+				timer was created dynamically in case the timer is later
+				deleted. */
+				pxNewTimer->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+		}
+
+		return pxNewTimer;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	HRTimerHandle_t xHRTimerCreateStatic( HRTimerCallbackFunction_t pxCallbackFunction, void * const pvTimerID, StaticHRTimer_t *pxTimerBuffer )
+	{
+	HRTimer_t *pxNewTimer;
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticHRTimer_t equals the size of the real timer
+			structure. */
+			volatile size_t xSize = sizeof( StaticHRTimer_t );
+			configASSERT( xSize == sizeof( HRTimer_t ) );
+			( void ) xSize; /* Keeps lint quiet when configASSERT() is not defined. */
+		}
+		#endif /* configASSERT_DEFINED */
+
+		/* A pointer to a StaticHRTimer_t structure MUST be provided, use it. */
+		configASSERT( pxTimerBuffer );
+		pxNewTimer = ( HRTimer_t * ) pxTimerBuffer; /*lint !e740 !e9087 StaticHRTimer_t is a pointer to a HRTimer_t, so guaranteed to be aligned and sized correctly (checked by an assert()), so this is safe. */
+
+		if( pxNewTimer != NULL )
+		{
+			prvInitialiseNewHRTimer( pxCallbackFunction, pvTimerID, pxNewTimer );
+
+			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				/* Timers can be created statically or dynamically so note this
+				timer was created statically in case it is later deleted. */
+				pxNewTimer->ucStaticallyAllocated = pdTRUE;
+			}
+			#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+		}
+
+		return pxNewTimer;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewHRTimer( HRTimerCallbackFunction_t pxCallbackFunction, void * const pvTimerID, HRTimer_t *pxNewTimer )
+{
+	/* Ensure the lists and the counter are ready to be used before the first
+	timer is started. */
+	prvCheckForValidLists();
+
+	pxNewTimer->pxCallbackFunction = pxCallbackFunction;
+	pxNewTimer->pvTimerID = pvTimerID;
+	vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
+	listSET_LIST_ITEM_OWNER( &( pxNewTimer->xTimerListItem ), pxNewTimer );
+	listSET_LIST_ITEM_VALUE( &( pxNewTimer->xTimerListItem ), ( TickType_t ) 0 );
+	pxNewTimer->ulExpiryCount = 0UL;
+
+	#if( configUSE_TASK_NOTIFICATIONS == 1 )
+	{
+		pxNewTimer->xTaskToNotify = NULL;
+		pxNewTimer->uxIndexToNotify = ( UBaseType_t ) 0;
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+void vHRTimerDelete( HRTimerHandle_t xTimer )
+{
+HRTimer_t * const pxTimer = xTimer;
+
+	configASSERT( xTimer );
+
+	( void ) xHRTimerStop( xTimer );
+
+	/* Free up the memory if the memory was dynamically allocated. */
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+	{
+		/* The timer can only have been allocated dynamically - free it
+		again. */
+		vPortFree( pxTimer );
+	}
+	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	{
+		/* The timer could have been allocated statically or dynamically, so
+		check before attempting to free the memory. */
+		if( pxTimer->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			vPortFree( pxTimer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#else
+	{
+		( void ) pxTimer;
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xHRTimerStartAt( HRTimerHandle_t xTimer, const uint32_t ulExpiryCount )
+{
+	configASSERT( xTimer );
+
+	taskENTER_CRITICAL();
+	{
+		prvStartHRTimer( xTimer, ulExpiryCount );
+	}
+	taskEXIT_CRITICAL();
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xHRTimerStartAtFromISR( HRTimerHandle_t xTimer, const uint32_t ulExpiryCount )
+{
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( xTimer );
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		prvStartHRTimer( xTimer, ulExpiryCount );
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xHRTimerStop( HRTimerHandle_t xTimer )
+{
+BaseType_t xReturn;
+
+	configASSERT( xTimer );
+
+	taskENTER_CRITICAL();
+	{
+		xReturn = prvStopHRTimer( xTimer );
+	}
+	taskEXIT_CRITICAL();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xHRTimerStopFromISR( HRTimerHandle_t xTimer )
+{
+BaseType_t xReturn;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( xTimer );
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		xReturn = prvStopHRTimer( xTimer );
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xHRTimerIsTimerActive( HRTimerHandle_t xTimer )
+{
+BaseType_t xIsInActiveList;
+HRTimer_t * const pxTimer = xTimer;
+
+	configASSERT( xTimer );
+
+	/* Is the timer in the list of active timers? */
+	taskENTER_CRITICAL();
+	{
+		/* Checking to see if it is in the NULL list in effect checks to see if
+		it is referenced from either the current or the overflow timer lists in
+		one go, but the logic has to be reversed, hence the '!'. */
+		xIsInActiveList = ( BaseType_t ) !( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) ); /*lint !e961. Cast is only redundant when NULL is passed into the macro. */
+	}
+	taskEXIT_CRITICAL();
+
+	return xIsInActiveList;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulHRTimerGetExpiryCount( HRTimerHandle_t xTimer )
+{
+HRTimer_t * const pxTimer = xTimer;
+
+	configASSERT( xTimer );
+	return pxTimer->ulExpiryCount;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulHRTimerGetCount( void )
+{
+	return ( uint32_t ) portGET_HR_TIMER_COUNT();
+}
+/*-----------------------------------------------------------*/
+
+void *pvHRTimerGetTimerID( const HRTimerHandle_t xTimer )
+{
+HRTimer_t * const pxTimer = xTimer;
+
+	configASSERT( xTimer );
+	return pxTimer->pvTimerID;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	void vHRTimerSetTaskToNotify( HRTimerHandle_t xTimer, TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify )
+	{
+	HRTimer_t * const pxTimer = xTimer;
+
+		configASSERT( xTimer );
+		configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+		/* The compare interrupt reads both members. */
+		taskENTER_CRITICAL();
+		{
+			pxTimer->xTaskToNotify = xTaskToNotify;
+			pxTimer->uxIndexToNotify = uxIndexToNotify;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TASK_NOTIFICATIONS == 1 )
+
+	void vHRTimerDelay( const uint32_t ulCounts )
+	{
+	HRTimer_t xTimer;
+
+		configASSERT( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING );
+
+		/* The timer only exists for the duration of the delay, so is created
+		on the stack of the calling task. */
+		prvInitialiseNewHRTimer( NULL, NULL, &xTimer );
+		xTimer.xTaskToNotify = xTaskGetCurrentTaskHandle();
+		xTimer.uxIndexToNotify = configHR_TIMER_NOTIFICATION_INDEX;
+		( void ) xHRTimerStartAt( &xTimer, ulHRTimerGetCount() + ulCounts );
+
+		/* Something else giving a notification to the same index can unblock
+		the task before the timer expires, so wait again until the timer is
+		no longer active.  The compare interrupt removes the timer from the
+		active list and gives the notification without a task running in
+		between, so the timer's notification has been given by the time the
+		timer is seen to be inactive. */
+		do
+		{
+			( void ) ulTaskNotifyTakeIndexed( configHR_TIMER_NOTIFICATION_INDEX, pdTRUE, portMAX_DELAY );
+		} while( xHRTimerIsTimerActive( &xTimer ) != pdFALSE );
+	}
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+BaseType_t xHRTimerProcessCompareInterrupt( void )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+UBaseType_t uxSavedInterruptStatus;
+HRTimer_t *pxTimer;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		do
+		{
+			pxTimer = prvGetExpiredHRTimer( ( uint32_t ) portGET_HR_TIMER_COUNT() );
+
+			while( pxTimer != NULL )
+			{
+				( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+				traceHR_TIMER_EXPIRED( pxTimer );
+
+				/* The callback executes with interrupts unmasked, so it can
+				start and stop timers, and other interrupts are not held off
+				while it executes. */
+				portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+				{
+					if( pxTimer->pxCallbackFunction != NULL )
+					{
+						pxTimer->pxCallbackFunction( ( HRTimerHandle_t ) pxTimer, &xHigherPriorityTaskWoken );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					#if( configUSE_TASK_NOTIFICATIONS == 1 )
+					{
+						if( pxTimer->xTaskToNotify != NULL )
+						{
+							vTaskNotifyGiveIndexedFromISR( pxTimer->xTaskToNotify, pxTimer->uxIndexToNotify, &xHigherPriorityTaskWoken );
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configUSE_TASK_NOTIFICATIONS */
+				}
+				uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+				pxTimer = prvGetExpiredHRTimer( ( uint32_t ) portGET_HR_TIMER_COUNT() );
+			}
+
+			/* If the next timer expired while the compare value was being
+			set then process it now rather than waiting for the interrupt to
+			execute again. */
+		} while( prvSetCompareValue() != pdFALSE );
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartHRTimer( HRTimer_t * const pxTimer, const uint32_t ulExpiryCount )
+{
+uint32_t ulNow, ulSortCount;
+List_t *pxList;
+
+	if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+	{
+		/* The timer is already active.  Remove it so it can be inserted again
+		with its new expiry count. */
+		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	ulNow = ( uint32_t ) portGET_HR_TIMER_COUNT();
+	prvCheckForOverflow( ulNow );
+
+	/* Expiry counts are interpreted relative to the current count, so the
+	timer has expired if its expiry count is not more than 2^31 counts ahead.
+	A timer that has not expired is sorted by its expiry count, and is
+	referenced from the overflow list if it expires after the counter
+	overflows - either because its expiry count has wrapped past zero or
+	because the counter has already overflowed while timers from before the
+	overflow remain in the current list.
+
+	A timer that has expired is sorted by the current count instead, so it is
+	processed by the next compare interrupt even if its expiry count is from
+	before the counter last overflowed, which a count compared without regard
+	to the overflow would place after the current count.  It is referenced from
+	the overflow list if timers from before the overflow remain in the current
+	list, so those are processed first. */
+	if( ( int32_t ) ( ulExpiryCount - ulNow ) > 0 )
+	{
+		ulSortCount = ulExpiryCount;
+
+		if( ( ulExpiryCount < ulNow ) || ( ulNow < ulLastCount ) )
+		{
+			pxList = pxOverflowHRTimerList;
+		}
+		else
+		{
+			pxList = pxCurrentHRTimerList;
+		}
+	}
+	else
+	{
+		ulSortCount = ulNow;
+
+		if( ulNow < ulLastCount )
+		{
+			pxList = pxOverflowHRTimerList;
+		}
+		else
+		{
+			pxList = pxCurrentHRTimerList;
+		}
+	}
+
+	pxTimer->ulExpiryCount = ulExpiryCount;
+	listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), ( TickType_t ) ulSortCount );
+	vListInsert( pxList, &( pxTimer->xTimerListItem ) );
+	traceHR_TIMER_START( pxTimer, ulExpiryCount );
+
+	( void ) prvSetCompareValue();
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvStopHRTimer( HRTimer_t * const pxTimer )
+{
+BaseType_t xReturn;
+
+	if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+	{
+		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+		( void ) prvSetCompareValue();
+		xReturn = pdPASS;
+	}
+	else
+	{
+		xReturn = pdFAIL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchHRTimerLists( void )
+{
+List_t *pxTemp;
+
+	pxTemp = pxCurrentHRTimerList;
+	pxCurrentHRTimerList = pxOverflowHRTimerList;
+	pxOverflowHRTimerList = pxTemp;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckForOverflow( const uint32_t ulNow )
+{
+	if( ulNow < ulLastCount )
+	{
+		/* The counter has overflowed.  If timers from before the overflow
+		remain then they have expired and the compare interrupt will process
+		them, then switch the lists itself, so leave ulLastCount unchanged to
+		show the overflow is still pending. */
+		if( listLIST_IS_EMPTY( pxCurrentHRTimerList ) != pdFALSE )
+		{
+			prvSwitchHRTimerLists();
+			ulLastCount = ulNow;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		ulLastCount = ulNow;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static HRTimer_t *prvGetExpiredHRTimer( const uint32_t ulNow )
+{
+HRTimer_t *pxTimer = NULL;
+
+	if( ulNow < ulLastCount )
+	{
+		/* The counter has overflowed, so every timer still referenced from the
+		current list has expired.  Process those before switching the
+		lists. */
+		if( listLIST_IS_EMPTY( pxCurrentHRTimerList ) == pdFALSE )
+		{
+			pxTimer = ( HRTimer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentHRTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		}
+		else
+		{
+			prvSwitchHRTimerLists();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxTimer == NULL )
+	{
+		ulLastCount = ulNow;
+
+		if( listLIST_IS_EMPTY( pxCurrentHRTimerList ) == pdFALSE )
+		{
+			if( ( uint32_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentHRTimerList ) <= ulNow )
+			{
+				pxTimer = ( HRTimer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentHRTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pxTimer;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvSetCompareValue( void )
+{
+BaseType_t xExpired = pdFALSE;
+uint32_t ulCompareValue, ulNow;
+List_t *pxList;
+
+	/* Timers in the current list expire before any in the overflow list. */
+	if( listLIST_IS_EMPTY( pxCurrentHRTimerList ) == pdFALSE )
+	{
+		pxList = pxCurrentHRTimerList;
+	}
+	else if( listLIST_IS_EMPTY( pxOverflowHRTimerList ) == pdFALSE )
+	{
+		pxList = pxOverflowHRTimerList;
+	}
+	else
+	{
+		pxList = NULL;
+	}
+
+	if( pxList != NULL )
+	{
+		ulCompareValue = ( uint32_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxList );
+
+		for( ;; )
+		{
+			/* The compare interrupt only executes when the counter becomes
+			equal to the compare value, so a compare value that has already
+			been passed, or is passed before it is written, would not generate
+			an interrupt until the counter next wraps.  Keep the compare value
+			at least configHR_TIMER_MIN_COMPARE_DELTA ahead of the counter, and
+			check the counter again after writing it. */
+			ulNow = ( uint32_t ) portGET_HR_TIMER_COUNT();
+
+			if( ( int32_t ) ( ulCompareValue - ulNow ) < ( int32_t ) configHR_TIMER_MIN_COMPARE_DELTA )
+			{
+				if( ( int32_t ) ( ulCompareValue - ulNow ) <= 0 )
+				{
+					xExpired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				ulCompareValue = ulNow + ( uint32_t ) configHR_TIMER_MIN_COMPARE_DELTA;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			portSET_HR_TIMER_COMPARE( ulCompareValue );
+
+			if( ( int32_t ) ( ( uint32_t ) portGET_HR_TIMER_COUNT() - ulCompareValue ) < 0 )
+			{
+				/* The counter had not reached the compare value when it was
+				written, so the interrupt will execute. */
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+	else
+	{
+		portDISABLE_HR_TIMER_COMPARE();
+	}
+
+	return xExpired;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckForValidLists( void )
+{
+	/* Check that the lists used to reference active timers have been
+	initialised. */
+	taskENTER_CRITICAL();
+	{
+		if( pxCurrentHRTimerList == NULL )
+		{
+			vListInitialise( &xActiveHRTimerList1 );
+			vListInitialise( &xActiveHRTimerList2 );
+			pxCurrentHRTimerList = &xActiveHRTimerList1;
+			pxOverflowHRTimerList = &xActiveHRTimerList2;
+
+			portCONFIGURE_HR_TIMER();
+			ulLastCount = ( uint32_t ) portGET_HR_TIMER_COUNT();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include high resolution timer functionality.  If you want to include high
+resolution timer functionality then ensure configUSE_HR_TIMERS is set to 1 in
+FreeRTOSConfig.h. */
+#endif /* configUSE_HR_TIMERS == 1 */
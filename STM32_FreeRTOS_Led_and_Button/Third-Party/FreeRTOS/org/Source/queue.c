@@ -37,6 +37,8 @@ task.h is included from an application file. */
 #include "task.h"
 #include "queue.h"
 
+#include "slab.h"
+
 #if ( configUSE_CO_ROUTINES == 1 )
 	#include "croutine.h"
 #endif
@@ -81,6 +83,10 @@ zero. */
 #define queueSEMAPHORE_QUEUE_ITEM_LENGTH ( ( UBaseType_t ) 0 )
 #define queueMUTEX_GIVE_BLOCK_TIME		 ( ( TickType_t ) 0U )
 
+/* The ceiling priority of a mutex that uses priority inheritance rather than
+the immediate priority ceiling protocol. */
+#define queueNO_CEILING_PRIORITY		 ( ~( UBaseType_t ) 0U )
+
 #if( configUSE_PREEMPTION == 0 )
 	/* If the cooperative scheduler is being used then a yield should not be
 	performed just because a higher priority task has been woken. */
@@ -89,6 +95,22 @@ zero. */
 	#define queueYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
 #endif
 
+#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+	/* A semaphore other than a mutex.  Tasks waiting on a semaphore record
+	the count they need, so a give only unblocks as many of them as the new
+	count can satisfy, rather than the highest priority task whatever it
+	needs. */
+	#define queueIS_SEMAPHORE( pxQueue ) ( ( ( pxQueue )->uxItemSize == ( UBaseType_t ) 0 ) && ( ( pxQueue )->uxQueueType != queueQUEUE_IS_MUTEX ) )
+	#define queueREMOVE_FROM_RECEIVE_LIST( pxQueue ) ( queueIS_SEMAPHORE( pxQueue ) ? xTaskRemoveFromEventListByCount( &( ( pxQueue )->xTasksWaitingToReceive ), ( pxQueue )->uxMessagesWaiting ) : xTaskRemoveFromEventList( &( ( pxQueue )->xTasksWaitingToReceive ) ) )
+
+	/* The count of a semaphore already includes every give made while it was
+	locked, so one pass unblocks every task the count can satisfy. */
+	#define queueUNLOCK_IN_ONE_PASS( pxQueue ) queueIS_SEMAPHORE( pxQueue )
+#else
+	#define queueREMOVE_FROM_RECEIVE_LIST( pxQueue ) xTaskRemoveFromEventList( &( ( pxQueue )->xTasksWaitingToReceive ) )
+	#define queueUNLOCK_IN_ONE_PASS( pxQueue ) pdFALSE
+#endif
+
 /*
  * Definition of the queue used by the scheduler.
  * Items are queued by copy, not reference.  See the following link for the
@@ -128,6 +150,19 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
 		uint8_t ucQueueType;
 	#endif
 
+	#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+		UBaseType_t uxGiveCount;		/*< The number of times the semaphore has been given, which only ever wraps.  xQueueSemaphoreTakeMultiple() uses it to tell a give it has not yet seen from one it has already passed on to other tasks.  Only used when the structure is used as a semaphore. */
+	#endif
+
+	#if ( configUSE_CEILING_MUTEXES == 1 )
+		UBaseType_t uxCeilingPriority;	/*< The priority a task is raised to as soon as it takes the mutex, or queueNO_CEILING_PRIORITY if the mutex uses priority inheritance.  Only used when the structure is used as a mutex. */
+	#endif
+
+	#if ( configUSE_MUTEX_STATISTICS == 1 )
+		MutexStats_t xMutexStats;	/*< Contention statistics, only used when the structure is used as a mutex. */
+		uint32_t ulTimeTaken;		/*< The time at which the current holder took the mutex. */
+	#endif
+
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -173,6 +208,22 @@ typedef xQUEUE Queue_t;
  */
 static void prvUnlockQueue( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_MUTEX_STATISTICS == 1 )
+	/*
+	 * Update the contention statistics of a mutex that has just been taken by
+	 * the calling task.  If xWaited is pdTRUE then the task blocked from
+	 * ulWaitStartTime, at which point the mutex was held by xHolderAtWaitStart.
+	 * Called from a critical section.
+	 */
+	static void prvMutexStatsTaken( Queue_t * const pxMutex, const BaseType_t xWaited, const uint32_t ulWaitStartTime, TaskHandle_t const xHolderAtWaitStart ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Update the hold time statistics of a mutex that is about to be given
+	 * back by its holder.  Called from a critical section.
+	 */
+	static void prvMutexStatsGiven( Queue_t * const pxMutex ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Uses a critical section to determine if there is any data in a queue.
  *
@@ -212,6 +263,18 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer
  */
 static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseType_t uxItemSize, uint8_t *pucQueueStorage, const uint8_t ucQueueType, Queue_t *pxNewQueue ) PRIVILEGED_FUNCTION;
 
+/*
+ * Frees the memory used by a dynamically allocated queue.  When slab caches are
+ * used the queue structure goes back to its cache and the storage area, which
+ * was allocated separately, goes back to the heap.  Otherwise the structure and
+ * the storage area are a single block.
+ */
+#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_SLAB_CACHES == 1 ) )
+	static void prvFreeQueue( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#else
+	#define prvFreeQueue( pxQueue ) vPortFree( pxQueue )
+#endif
+
 /*
  * Mutexes are a special type of queue.  When a mutex is created, first the
  * queue is created, then prvInitialiseMutex() is called to configure the queue
@@ -231,6 +294,37 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	 */
 	static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
+
+#if( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 )
+	/*
+	 * If the holder of pxMutex is itself blocked on a mutex then pass its
+	 * priority on to the holder of that mutex, and so on along the chain of
+	 * blocked mutex holders, for at most configMAX_PRIORITY_INHERITANCE_DEPTH
+	 * holders in total.
+	 */
+	static void prvInheritPriorityAlongChain( const Queue_t *pxMutex ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called after the holder of pxMutex has disinherited a priority because
+	 * a waiting task timed out.  Lowers the priorities of the holders further
+	 * along the same chain to match.
+	 */
+	static void prvDisinheritPriorityAlongChainAfterTimeout( const Queue_t *pxMutex ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+	/*
+	 * Called from a critical section by a task in xQueueSemaphoreTakeMultiple()
+	 * that found the count too small for it.  A give can unblock such a task in
+	 * preference to lower priority tasks that could have used the count, so if
+	 * there has been a give since *puxGiveCountSeen the give is passed on to
+	 * the waiting tasks that the count can satisfy.  Each task passes each
+	 * give on at most once, so tasks that cannot use the count do not pass it
+	 * back and forth between themselves.  Returns pdTRUE if a task of higher
+	 * priority than the calling task was unblocked.
+	 */
+	static BaseType_t prvPassOnSemaphoreGive( Queue_t * const pxQueue, UBaseType_t * const puxGiveCountSeen ) PRIVILEGED_FUNCTION;
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -385,24 +479,58 @@ Queue_t * const pxQueue = xQueue;
 			xQueueSizeInBytes = ( size_t ) ( uxQueueLength * uxItemSize ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 		}
 
-		/* Allocate the queue and storage area.  Justification for MISRA
-		deviation as follows:  pvPortMalloc() always ensures returned memory
-		blocks are aligned per the requirements of the MCU stack.  In this case
-		pvPortMalloc() must return a pointer that is guaranteed to meet the
-		alignment requirements of the Queue_t structure - which in this case
-		is an int8_t *.  Therefore, whenever the stack alignment requirements
-		are greater than or equal to the pointer to char requirements the cast
-		is safe.  In other cases alignment requirements are not strict (one or
-		two bytes). */
-		pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + xQueueSizeInBytes ); /*lint !e9087 !e9079 see comment above. */
+		#if( configUSE_SLAB_CACHES == 1 )
+		{
+			/* The queue structure comes from its slab cache, so only the
+			storage area, if there is one, is allocated from the heap. */
+			pxNewQueue = ( Queue_t * ) pvSlabAlloc( eSlabCacheQueue );
+			pucQueueStorage = NULL;
 
-		if( pxNewQueue != NULL )
+			if( ( pxNewQueue != NULL ) && ( xQueueSizeInBytes > ( size_t ) 0 ) )
+			{
+				pucQueueStorage = ( uint8_t * ) pvPortMalloc( xQueueSizeInBytes );
+
+				if( pucQueueStorage == NULL )
+				{
+					vSlabFree( eSlabCacheQueue, pxNewQueue );
+					pxNewQueue = NULL;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#else
 		{
-			/* Jump past the queue structure to find the location of the queue
-			storage area. */
-			pucQueueStorage = ( uint8_t * ) pxNewQueue;
-			pucQueueStorage += sizeof( Queue_t ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+			/* Allocate the queue and storage area.  Justification for MISRA
+			deviation as follows:  pvPortMalloc() always ensures returned memory
+			blocks are aligned per the requirements of the MCU stack.  In this case
+			pvPortMalloc() must return a pointer that is guaranteed to meet the
+			alignment requirements of the Queue_t structure - which in this case
+			is an int8_t *.  Therefore, whenever the stack alignment requirements
+			are greater than or equal to the pointer to char requirements the cast
+			is safe.  In other cases alignment requirements are not strict (one or
+			two bytes). */
+			pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + xQueueSizeInBytes ); /*lint !e9087 !e9079 see comment above. */
+			pucQueueStorage = NULL;
+
+			if( pxNewQueue != NULL )
+			{
+				/* Jump past the queue structure to find the location of the
+				queue storage area. */
+				pucQueueStorage = ( uint8_t * ) pxNewQueue;
+				pucQueueStorage += sizeof( Queue_t ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+			}
+		}
+		#endif /* configUSE_SLAB_CACHES */
 
+		if( pxNewQueue != NULL )
+		{
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
 				/* Queues can be created either statically or dynamically, so
@@ -464,6 +592,12 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	}
 	#endif /* configUSE_QUEUE_SETS */
 
+	#if( configUSE_COUNTING_SEMAPHORES == 1 )
+	{
+		pxNewQueue->uxGiveCount = ( UBaseType_t ) 0;
+	}
+	#endif /* configUSE_COUNTING_SEMAPHORES */
+
 	traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -484,6 +618,21 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 			/* In case this is a recursive mutex. */
 			pxNewQueue->u.xSemaphore.uxRecursiveCallCount = 0;
 
+			#if ( configUSE_CEILING_MUTEXES == 1 )
+			{
+				/* Mutexes use priority inheritance unless created with a
+				ceiling. */
+				pxNewQueue->uxCeilingPriority = queueNO_CEILING_PRIORITY;
+			}
+			#endif
+
+			#if ( configUSE_MUTEX_STATISTICS == 1 )
+			{
+				( void ) memset( ( void * ) &( pxNewQueue->xMutexStats ), 0x00, sizeof( pxNewQueue->xMutexStats ) );
+				pxNewQueue->ulTimeTaken = 0;
+			}
+			#endif
+
 			traceCREATE_MUTEX( pxNewQueue );
 
 			/* Start with the semaphore in the expected state. */
@@ -534,6 +683,56 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if( ( configUSE_CEILING_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	QueueHandle_t xQueueCreateMutexWithCeiling( const uint8_t ucQueueType, const UBaseType_t uxCeilingPriority )
+	{
+	QueueHandle_t xNewQueue;
+
+		configASSERT( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+		xNewQueue = xQueueCreateMutex( ucQueueType );
+
+		if( xNewQueue != NULL )
+		{
+			( ( Queue_t * ) xNewQueue )->uxCeilingPriority = uxCeilingPriority;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xNewQueue;
+	}
+
+#endif /* configUSE_CEILING_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if( ( configUSE_CEILING_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+	QueueHandle_t xQueueCreateMutexWithCeilingStatic( const uint8_t ucQueueType, const UBaseType_t uxCeilingPriority, StaticQueue_t *pxStaticQueue )
+	{
+	QueueHandle_t xNewQueue;
+
+		configASSERT( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+		xNewQueue = xQueueCreateMutexStatic( ucQueueType, pxStaticQueue );
+
+		if( xNewQueue != NULL )
+		{
+			( ( Queue_t * ) xNewQueue )->uxCeilingPriority = uxCeilingPriority;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xNewQueue;
+	}
+
+#endif /* configUSE_CEILING_MUTEXES */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
 
 	TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore )
@@ -591,6 +790,124 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 #endif
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MUTEX_STATISTICS == 1 )
+
+	BaseType_t xQueueGetMutexStats( QueueHandle_t xMutex, MutexStats_t *pxMutexStats )
+	{
+	BaseType_t xReturn;
+	Queue_t * const pxMutex = xMutex;
+
+		configASSERT( pxMutex );
+		configASSERT( pxMutexStats );
+
+		if( pxMutex->uxQueueType == queueQUEUE_IS_MUTEX )
+		{
+			/* The statistics are updated from within critical sections, so
+			take a consistent snapshot. */
+			taskENTER_CRITICAL();
+			{
+				*pxMutexStats = pxMutex->xMutexStats;
+			}
+			taskEXIT_CRITICAL();
+
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = pdFAIL;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MUTEX_STATISTICS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_STATISTICS == 1 )
+
+	void vQueueResetMutexStats( QueueHandle_t xMutex )
+	{
+	Queue_t * const pxMutex = xMutex;
+
+		configASSERT( pxMutex );
+		configASSERT( pxMutex->uxQueueType == queueQUEUE_IS_MUTEX );
+
+		taskENTER_CRITICAL();
+		{
+			( void ) memset( ( void * ) &( pxMutex->xMutexStats ), 0x00, sizeof( pxMutex->xMutexStats ) );
+
+			/* A hold that is in progress is accounted from now. */
+			pxMutex->ulTimeTaken = portGET_MUTEX_STATS_TIME();
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#endif /* configUSE_MUTEX_STATISTICS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_STATISTICS == 1 )
+
+	static void prvMutexStatsTaken( Queue_t * const pxMutex, const BaseType_t xWaited, const uint32_t ulWaitStartTime, TaskHandle_t const xHolderAtWaitStart )
+	{
+	MutexStats_t * const pxStats = &( pxMutex->xMutexStats );
+	const uint32_t ulNow = portGET_MUTEX_STATS_TIME();
+	uint32_t ulWaitTime;
+
+		( pxStats->uxAcquisitions )++;
+		pxMutex->ulTimeTaken = ulNow;
+
+		if( xWaited != pdFALSE )
+		{
+			/* Unsigned arithmetic gives the right answer across a single
+			overflow of the time base. */
+			ulWaitTime = ulNow - ulWaitStartTime;
+
+			( pxStats->uxContendedAcquisitions )++;
+			pxStats->ulTotalWaitTime += ulWaitTime;
+
+			if( ulWaitTime >= pxStats->ulMaxWaitTime )
+			{
+				pxStats->ulMaxWaitTime = ulWaitTime;
+				pxStats->xMaxWaitTask = pxMutex->u.xSemaphore.xMutexHolder;
+				pxStats->xMaxWaitHolder = xHolderAtWaitStart;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_MUTEX_STATISTICS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEX_STATISTICS == 1 )
+
+	static void prvMutexStatsGiven( Queue_t * const pxMutex )
+	{
+	MutexStats_t * const pxStats = &( pxMutex->xMutexStats );
+	const uint32_t ulHoldTime = portGET_MUTEX_STATS_TIME() - pxMutex->ulTimeTaken;
+
+		pxStats->ulTotalHoldTime += ulHoldTime;
+
+		if( ulHoldTime >= pxStats->ulMaxHoldTime )
+		{
+			pxStats->ulMaxHoldTime = ulHoldTime;
+			pxStats->xMaxHoldTask = pxMutex->u.xSemaphore.xMutexHolder;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_MUTEX_STATISTICS */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_RECURSIVE_MUTEXES == 1 )
 
 	BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex )
@@ -808,7 +1125,7 @@ Queue_t * const pxQueue = xQueue;
 						queue then unblock it now. */
 						if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
 						{
-							if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+							if( queueREMOVE_FROM_RECEIVE_LIST( pxQueue ) != pdFALSE )
 							{
 								/* The unblocked task has a priority higher than
 								our own so yield immediately.  Yes it is ok to
@@ -843,7 +1160,7 @@ Queue_t * const pxQueue = xQueue;
 					queue then unblock it now. */
 					if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
 					{
-						if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+						if( queueREMOVE_FROM_RECEIVE_LIST( pxQueue ) != pdFALSE )
 						{
 							/* The unblocked task has a priority higher than
 							our own so yield immediately.  Yes it is ok to do
@@ -1165,6 +1482,19 @@ Queue_t * const pxQueue = xQueue;
 			messages (semaphores) available. */
 			pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
 
+			#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+			{
+				if( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX )
+				{
+					( pxQueue->uxGiveCount )++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_COUNTING_SEMAPHORES */
+
 			/* The event list is not altered if the queue is locked.  This will
 			be done when the queue is unlocked later. */
 			if( cTxLock == queueUNLOCKED )
@@ -1196,7 +1526,7 @@ Queue_t * const pxQueue = xQueue;
 					{
 						if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
 						{
-							if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+							if( queueREMOVE_FROM_RECEIVE_LIST( pxQueue ) != pdFALSE )
 							{
 								/* The task waiting has a higher priority so
 								record that a context switch is required. */
@@ -1224,7 +1554,7 @@ Queue_t * const pxQueue = xQueue;
 				{
 					if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
 					{
-						if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+						if( queueREMOVE_FROM_RECEIVE_LIST( pxQueue ) != pdFALSE )
 						{
 							/* The task waiting has a higher priority so record that a
 							context	switch is required. */
@@ -1270,53 +1600,196 @@ Queue_t * const pxQueue = xQueue;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueReceive( QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait )
-{
-BaseType_t xEntryTimeSet = pdFALSE;
-TimeOut_t xTimeOut;
-Queue_t * const pxQueue = xQueue;
+#if ( configUSE_COUNTING_SEMAPHORES == 1 )
 
-	/* Check the pointer is not NULL. */
-	configASSERT( ( pxQueue ) );
+	BaseType_t xQueueGiveMultipleFromISR( QueueHandle_t xQueue, const UBaseType_t uxCount, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	BaseType_t xReturn;
+	UBaseType_t uxSavedInterruptStatus, uxToWake;
+	Queue_t * const pxQueue = xQueue;
 
-	/* The buffer into which data is received can only be NULL if the data size
-	is zero (so no data is copied into the buffer. */
-	configASSERT( !( ( ( pvBuffer ) == NULL ) && ( ( pxQueue )->uxItemSize != ( UBaseType_t ) 0U ) ) );
+		/* As xQueueGiveFromISR(), but the count is raised by uxCount within a
+		single interrupt masked section, and the tasks waiting on the semaphore
+		that the new count can satisfy are unblocked in the same pass.  Either
+		the whole count is given or none of it is. */
 
-	/* Cannot block if the scheduler is suspended. */
-	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
-	{
-		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
-	}
-	#endif
+		configASSERT( pxQueue );
+		configASSERT( uxCount > ( UBaseType_t ) 0 );
 
+		/* Only semaphores can be given, and a mutex only ever has a count of
+		one so giving it more than once is meaningless. */
+		configASSERT( pxQueue->uxItemSize == 0 );
+		configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
 
-	/*lint -save -e904  This function relaxes the coding standard somewhat to
-	allow return statements within the function itself.  This is done in the
-	interest of execution time efficiency. */
-	for( ;; )
-	{
-		taskENTER_CRITICAL();
+		/* See the comments in xQueueGiveFromISR(). */
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 		{
 			const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
-			/* Is there data in the queue now?  To be running the calling task
-			must be the highest priority task wanting to access the queue. */
-			if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+			/* Is there space for all uxCount gives?  Written so the sum cannot
+			overflow. */
+			if( uxCount <= ( pxQueue->uxLength - uxMessagesWaiting ) )
 			{
-				/* Data available, remove one item. */
-				prvCopyDataFromQueue( pxQueue, pvBuffer );
-				traceQUEUE_RECEIVE( pxQueue );
-				pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+				const int8_t cTxLock = pxQueue->cTxLock;
 
-				/* There is now space in the queue, were any tasks waiting to
-				post to the queue?  If so, unblock the highest priority waiting
-				task. */
-				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+				traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+				pxQueue->uxMessagesWaiting = uxMessagesWaiting + uxCount;
+				( pxQueue->uxGiveCount )++;
+
+				/* The event list is not altered if the queue is locked.  This
+				will be done when the queue is unlocked later. */
+				if( cTxLock == queueUNLOCKED )
 				{
-					if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+					#if ( configUSE_QUEUE_SETS == 1 )
 					{
-						queueYIELD_IF_USING_PREEMPTION();
+						if( pxQueue->pxQueueSetContainer != NULL )
+						{
+							/* The queue set holds one entry per count given. */
+							for( uxToWake = uxCount; uxToWake > ( UBaseType_t ) 0; uxToWake-- )
+							{
+								if( prvNotifyQueueSetContainer( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
+								{
+									if( pxHigherPriorityTaskWoken != NULL )
+									{
+										*pxHigherPriorityTaskWoken = pdTRUE;
+									}
+									else
+									{
+										mtCOVERAGE_TEST_MARKER();
+									}
+								}
+								else
+								{
+									mtCOVERAGE_TEST_MARKER();
+								}
+							}
+						}
+						else
+						{
+							/* Unblock the waiting tasks, in priority order,
+							that the new count can satisfy. */
+							if( xTaskRemoveFromEventListByCount( &( pxQueue->xTasksWaitingToReceive ), pxQueue->uxMessagesWaiting ) != pdFALSE )
+							{
+								if( pxHigherPriorityTaskWoken != NULL )
+								{
+									*pxHigherPriorityTaskWoken = pdTRUE;
+								}
+								else
+								{
+									mtCOVERAGE_TEST_MARKER();
+								}
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+					}
+					#else /* configUSE_QUEUE_SETS */
+					{
+						/* Unblock the waiting tasks, in priority order, that
+						the new count can satisfy. */
+						if( xTaskRemoveFromEventListByCount( &( pxQueue->xTasksWaitingToReceive ), pxQueue->uxMessagesWaiting ) != pdFALSE )
+						{
+							if( pxHigherPriorityTaskWoken != NULL )
+							{
+								*pxHigherPriorityTaskWoken = pdTRUE;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif /* configUSE_QUEUE_SETS */
+				}
+				else
+				{
+					/* Add the count to the lock count so the task that unlocks
+					the queue notifies a queue set containing the semaphore as
+					many times as it would have done had the semaphore been
+					given uxCount times.  The lock count is only eight bits, so
+					saturate rather than wrap. */
+					if( uxCount < ( UBaseType_t ) ( ( int8_t ) 0x7f - cTxLock ) )
+					{
+						pxQueue->cTxLock = ( int8_t ) ( cTxLock + ( int8_t ) uxCount );
+					}
+					else
+					{
+						pxQueue->cTxLock = ( int8_t ) 0x7f;
+					}
+				}
+
+				xReturn = pdPASS;
+			}
+			else
+			{
+				traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+				xReturn = errQUEUE_FULL;
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return xReturn;
+	}
+
+#endif /* configUSE_COUNTING_SEMAPHORES */
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueReceive( QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait )
+{
+BaseType_t xEntryTimeSet = pdFALSE;
+TimeOut_t xTimeOut;
+Queue_t * const pxQueue = xQueue;
+
+	/* Check the pointer is not NULL. */
+	configASSERT( ( pxQueue ) );
+
+	/* The buffer into which data is received can only be NULL if the data size
+	is zero (so no data is copied into the buffer. */
+	configASSERT( !( ( ( pvBuffer ) == NULL ) && ( ( pxQueue )->uxItemSize != ( UBaseType_t ) 0U ) ) );
+
+	/* Cannot block if the scheduler is suspended. */
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+
+	/*lint -save -e904  This function relaxes the coding standard somewhat to
+	allow return statements within the function itself.  This is done in the
+	interest of execution time efficiency. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+			/* Is there data in the queue now?  To be running the calling task
+			must be the highest priority task wanting to access the queue. */
+			if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+			{
+				/* Data available, remove one item. */
+				prvCopyDataFromQueue( pxQueue, pvBuffer );
+				traceQUEUE_RECEIVE( pxQueue );
+				pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+
+				/* There is now space in the queue, were any tasks waiting to
+				post to the queue?  If so, unblock the highest priority waiting
+				task. */
+				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+				{
+					if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+					{
+						queueYIELD_IF_USING_PREEMPTION();
 					}
 					else
 					{
@@ -1421,6 +1894,11 @@ Queue_t * const pxQueue = xQueue;
 	BaseType_t xInheritanceOccurred = pdFALSE;
 #endif
 
+#if( configUSE_MUTEX_STATISTICS == 1 )
+	uint32_t ulWaitStartTime = 0;
+	TaskHandle_t xHolderAtWaitStart = NULL;
+#endif
+
 	/* Check the queue pointer is not NULL. */
 	configASSERT( ( pxQueue ) );
 
@@ -1464,6 +1942,38 @@ Queue_t * const pxQueue = xQueue;
 						/* Record the information required to implement
 						priority inheritance should it become necessary. */
 						pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+
+						#if ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 )
+						{
+							/* The task is no longer part of a blocking chain. */
+							vTaskSetMutexBlockedOn( NULL );
+						}
+						#endif
+
+						#if ( configUSE_CEILING_MUTEXES == 1 )
+						{
+							/* Under the immediate priority ceiling protocol
+							the holder runs at the ceiling for as long as it
+							holds the mutex, so no task that might take the
+							mutex can preempt it. */
+							if( pxQueue->uxCeilingPriority != queueNO_CEILING_PRIORITY )
+							{
+								vTaskPriorityRaiseToCeiling( pxQueue->uxCeilingPriority );
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						#endif
+
+						#if ( configUSE_MUTEX_STATISTICS == 1 )
+						{
+							/* The entry time is only set once the task has
+							found the mutex unavailable and decided to wait. */
+							prvMutexStatsTaken( pxQueue, xEntryTimeSet, ulWaitStartTime, xHolderAtWaitStart );
+						}
+						#endif
 					}
 					else
 					{
@@ -1506,6 +2016,12 @@ Queue_t * const pxQueue = xQueue;
 					}
 					#endif /* configUSE_MUTEXES */
 
+					#if ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 )
+					{
+						vTaskSetMutexBlockedOn( NULL );
+					}
+					#endif
+
 					/* The semaphore count was 0 and no block time is specified
 					(or the block time has expired) so exit now. */
 					taskEXIT_CRITICAL();
@@ -1518,6 +2034,20 @@ Queue_t * const pxQueue = xQueue;
 					so configure the timeout structure ready to block. */
 					vTaskInternalSetTimeOutState( &xTimeOut );
 					xEntryTimeSet = pdTRUE;
+
+					#if ( configUSE_MUTEX_STATISTICS == 1 )
+					{
+						if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+						{
+							ulWaitStartTime = portGET_MUTEX_STATS_TIME();
+							xHolderAtWaitStart = pxQueue->u.xSemaphore.xMutexHolder;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#endif
 				}
 				else
 				{
@@ -1552,6 +2082,28 @@ Queue_t * const pxQueue = xQueue;
 						taskENTER_CRITICAL();
 						{
 							xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
+
+							#if ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 )
+							{
+								vTaskSetMutexBlockedOn( pxQueue );
+								prvInheritPriorityAlongChain( pxQueue );
+							}
+							#endif
+
+							#if ( configUSE_MUTEX_STATISTICS == 1 )
+							{
+								if( xInheritanceOccurred != pdFALSE )
+								{
+									( pxQueue->xMutexStats.uxPriorityInheritances )++;
+									pxQueue->xMutexStats.xLastInheritHolder = pxQueue->u.xSemaphore.xMutexHolder;
+									pxQueue->xMutexStats.xLastInheritWaiter = xTaskGetCurrentTaskHandle();
+								}
+								else
+								{
+									mtCOVERAGE_TEST_MARKER();
+								}
+							}
+							#endif
 						}
 						taskEXIT_CRITICAL();
 					}
@@ -1562,7 +2114,25 @@ Queue_t * const pxQueue = xQueue;
 				}
 				#endif
 
-				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+				#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+				{
+					/* Record that this task needs a count of one, so a give
+					can tell it from tasks that need more. */
+					if( queueIS_SEMAPHORE( pxQueue ) )
+					{
+						vTaskPlaceOnEventListWithCount( &( pxQueue->xTasksWaitingToReceive ), ( UBaseType_t ) 1, xTicksToWait );
+					}
+					else
+					{
+						vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+					}
+				}
+				#else
+				{
+					vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+				}
+				#endif
+
 				prvUnlockQueue( pxQueue );
 				if( xTaskResumeAll() == pdFALSE )
 				{
@@ -1572,6 +2142,19 @@ Queue_t * const pxQueue = xQueue;
 				{
 					mtCOVERAGE_TEST_MARKER();
 				}
+
+				#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+				{
+					if( queueIS_SEMAPHORE( pxQueue ) )
+					{
+						( void ) uxTaskResetEventItemValue();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif
 			}
 			else
 			{
@@ -1593,6 +2176,36 @@ Queue_t * const pxQueue = xQueue;
 			queue being empty is equivalent to the semaphore count being 0. */
 			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
 			{
+				#if ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 )
+				{
+					if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+					{
+						taskENTER_CRITICAL();
+						{
+							vTaskSetMutexBlockedOn( NULL );
+
+							/* The priority of this task may have been raised
+							along a chain after it blocked, and so passed on to
+							the mutex holder even if the holder did not inherit
+							when this task first blocked. */
+							if( ( pxQueue->u.xSemaphore.xMutexHolder != NULL ) && ( pxQueue->u.xSemaphore.xMutexHolder != xTaskGetCurrentTaskHandle() ) )
+							{
+								xInheritanceOccurred = pdTRUE;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+						}
+						taskEXIT_CRITICAL();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif
+
 				#if ( configUSE_MUTEXES == 1 )
 				{
 					/* xInheritanceOccurred could only have be set if
@@ -1611,6 +2224,12 @@ Queue_t * const pxQueue = xQueue;
 							task that is waiting for the same mutex. */
 							uxHighestWaitingPriority = prvGetDisinheritPriorityAfterTimeout( pxQueue );
 							vTaskPriorityDisinheritAfterTimeout( pxQueue->u.xSemaphore.xMutexHolder, uxHighestWaitingPriority );
+
+							#if ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 )
+							{
+								prvDisinheritPriorityAlongChainAfterTimeout( pxQueue );
+							}
+							#endif
 						}
 						taskEXIT_CRITICAL();
 					}
@@ -1629,6 +2248,235 @@ Queue_t * const pxQueue = xQueue;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+
+	BaseType_t xQueueSemaphoreTakeMultiple( QueueHandle_t xQueue, const UBaseType_t uxCount, TickType_t xTicksToWait )
+	{
+	BaseType_t xEntryTimeSet = pdFALSE, xInsufficientCount;
+	TimeOut_t xTimeOut;
+	UBaseType_t uxGiveCountSeen = 0;
+	Queue_t * const pxQueue = xQueue;
+
+		/* Check the queue pointer is not NULL. */
+		configASSERT( ( pxQueue ) );
+
+		/* Check this really is a semaphore, and not a mutex, as priority
+		inheritance is not defined for multiple takes. */
+		configASSERT( pxQueue->uxItemSize == 0 );
+		configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+
+		/* A take of more than the maximum count would block forever. */
+		configASSERT( ( uxCount > ( UBaseType_t ) 0 ) && ( uxCount <= pxQueue->uxLength ) );
+
+		/* Cannot block if the scheduler is suspended. */
+		#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+		{
+			configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+		}
+		#endif
+
+		/*lint -save -e904 This function relaxes the coding standard somewhat to
+		allow return statements within the function itself.  This is done in the
+		interest of execution time efficiency. */
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+			{
+				const UBaseType_t uxSemaphoreCount = pxQueue->uxMessagesWaiting;
+
+				/* The count is only reduced if all uxCount are available, so
+				a partial take never strands counts with a blocked task. */
+				if( uxSemaphoreCount >= uxCount )
+				{
+					traceQUEUE_RECEIVE( pxQueue );
+
+					pxQueue->uxMessagesWaiting = uxSemaphoreCount - uxCount;
+
+					/* Check to see if other tasks are blocked waiting to give
+					the semaphore, and if so, unblock the highest priority such
+					task. */
+					if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+					{
+						if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+						{
+							queueYIELD_IF_USING_PREEMPTION();
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					taskEXIT_CRITICAL();
+					return pdPASS;
+				}
+				else
+				{
+					if( xTicksToWait == ( TickType_t ) 0 )
+					{
+						/* Not enough count and no block time is specified (or
+						the block time has expired) so exit now. */
+						taskEXIT_CRITICAL();
+						traceQUEUE_RECEIVE_FAILED( pxQueue );
+						return errQUEUE_EMPTY;
+					}
+					else if( xEntryTimeSet == pdFALSE )
+					{
+						vTaskInternalSetTimeOutState( &xTimeOut );
+						xEntryTimeSet = pdTRUE;
+
+						/* Gives before this point are not ones this task can
+						have been unblocked by. */
+						uxGiveCountSeen = pxQueue->uxGiveCount;
+					}
+					else
+					{
+						/* Entry time was already set. */
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			/* Interrupts and other tasks can give to and take from the
+			semaphore now the critical section has been exited. */
+
+			vTaskSuspendAll();
+			prvLockQueue( pxQueue );
+
+			/* Update the timeout state to see if it has expired yet. */
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+			{
+				taskENTER_CRITICAL();
+				{
+					xInsufficientCount = ( pxQueue->uxMessagesWaiting < uxCount ) ? pdTRUE : pdFALSE;
+
+					/* Before blocking again pass on any give this task has
+					been unblocked by but cannot use.  This must be done before
+					the task places itself back on the event list.  The task is
+					about to block, so does not need to yield to a task that is
+					unblocked. */
+					if( xInsufficientCount != pdFALSE )
+					{
+						( void ) prvPassOnSemaphoreGive( pxQueue, &uxGiveCountSeen );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				taskEXIT_CRITICAL();
+
+				if( xInsufficientCount != pdFALSE )
+				{
+					traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+					vTaskPlaceOnEventListWithCount( &( pxQueue->xTasksWaitingToReceive ), uxCount, xTicksToWait );
+					prvUnlockQueue( pxQueue );
+					if( xTaskResumeAll() == pdFALSE )
+					{
+						portYIELD_WITHIN_API();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					/* The event list item value held the count this task was
+					waiting for. */
+					( void ) uxTaskResetEventItemValue();
+				}
+				else
+				{
+					/* Enough count became available, so attempt the take
+					again. */
+					prvUnlockQueue( pxQueue );
+					( void ) xTaskResumeAll();
+				}
+			}
+			else
+			{
+				/* Timed out. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+
+				taskENTER_CRITICAL();
+				{
+					xInsufficientCount = ( pxQueue->uxMessagesWaiting < uxCount ) ? pdTRUE : pdFALSE;
+
+					/* A give can coincide with the timeout, so it must be
+					passed on here too. */
+					if( xInsufficientCount != pdFALSE )
+					{
+						if( prvPassOnSemaphoreGive( pxQueue, &uxGiveCountSeen ) != pdFALSE )
+						{
+							queueYIELD_IF_USING_PREEMPTION();
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				taskEXIT_CRITICAL();
+
+				if( xInsufficientCount != pdFALSE )
+				{
+					traceQUEUE_RECEIVE_FAILED( pxQueue );
+					return errQUEUE_EMPTY;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		} /*lint -restore */
+	}
+
+#endif /* configUSE_COUNTING_SEMAPHORES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+
+	static BaseType_t prvPassOnSemaphoreGive( Queue_t * const pxQueue, UBaseType_t * const puxGiveCountSeen )
+	{
+	BaseType_t xReturn = pdFALSE;
+
+		/* This function is called from a critical section. */
+
+		if( pxQueue->uxGiveCount != *puxGiveCountSeen )
+		{
+			*puxGiveCountSeen = pxQueue->uxGiveCount;
+
+			/* Each waiting task recorded the count it needs, so only the
+			tasks the count can satisfy are unblocked. */
+			if( ( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) )
+			{
+				xReturn = xTaskRemoveFromEventListByCount( &( pxQueue->xTasksWaitingToReceive ), pxQueue->uxMessagesWaiting );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_COUNTING_SEMAPHORES */
+/*-----------------------------------------------------------*/
+
 BaseType_t xQueuePeek( QueueHandle_t xQueue, void * const pvBuffer, TickType_t xTicksToWait )
 {
 BaseType_t xEntryTimeSet = pdFALSE;
@@ -1985,7 +2833,7 @@ Queue_t * const pxQueue = xQueue;
 	{
 		/* The queue can only have been allocated dynamically - free it
 		again. */
-		vPortFree( pxQueue );
+		prvFreeQueue( pxQueue );
 	}
 	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
 	{
@@ -1993,7 +2841,7 @@ Queue_t * const pxQueue = xQueue;
 		check before attempting to free the memory. */
 		if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
 		{
-			vPortFree( pxQueue );
+			prvFreeQueue( pxQueue );
 		}
 		else
 		{
@@ -2010,6 +2858,28 @@ Queue_t * const pxQueue = xQueue;
 }
 /*-----------------------------------------------------------*/
 
+#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_SLAB_CACHES == 1 ) )
+
+	static void prvFreeQueue( Queue_t * const pxQueue )
+	{
+		/* Only queues have a storage area.  Semaphores and mutexes are created
+		with an item size of zero, and pcHead is used for something else when
+		the queue is a mutex. */
+		if( pxQueue->uxItemSize > ( UBaseType_t ) 0 )
+		{
+			vPortFree( pxQueue->pcHead );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		vSlabFree( eSlabCacheQueue, pxQueue );
+	}
+
+#endif /* configUSE_SLAB_CACHES */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TRACE_FACILITY == 1 )
 
 	UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
@@ -2061,12 +2931,109 @@ Queue_t * const pxQueue = xQueue;
 			uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
 		}
 
+		#if ( configUSE_CEILING_MUTEXES == 1 )
+		{
+			/* The holder of a ceiling mutex must not drop below the ceiling
+			while it still holds the mutex. */
+			if( ( pxQueue->uxCeilingPriority != queueNO_CEILING_PRIORITY ) && ( pxQueue->uxCeilingPriority > uxHighestPriorityOfWaitingTasks ) )
+			{
+				uxHighestPriorityOfWaitingTasks = pxQueue->uxCeilingPriority;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
 		return uxHighestPriorityOfWaitingTasks;
 	}
 
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 )
+
+	static void prvInheritPriorityAlongChain( const Queue_t *pxMutex )
+	{
+	TaskHandle_t xBlockedTask = pxMutex->u.xSemaphore.xMutexHolder, xMutexHolder;
+	const TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+	UBaseType_t uxDepth;
+
+		/* Called from a critical section by the task that is about to block
+		on pxMutex, after the holder of pxMutex has inherited its priority. */
+		for( uxDepth = ( UBaseType_t ) 1; uxDepth < ( UBaseType_t ) configMAX_PRIORITY_INHERITANCE_DEPTH; uxDepth++ )
+		{
+			if( xBlockedTask == NULL )
+			{
+				break;
+			}
+
+			pxMutex = ( const Queue_t * ) pvTaskGetMutexBlockedOn( xBlockedTask );
+
+			if( pxMutex == NULL )
+			{
+				/* The end of the chain. */
+				break;
+			}
+
+			xMutexHolder = pxMutex->u.xSemaphore.xMutexHolder;
+
+			/* A chain that leads back to the calling task is a deadlock that
+			inheritance cannot resolve. */
+			if( xMutexHolder == xCurrentTask )
+			{
+				break;
+			}
+
+			( void ) xTaskPriorityInheritFrom( xMutexHolder, xBlockedTask );
+			xBlockedTask = xMutexHolder;
+		}
+	}
+
+#endif /* configMAX_PRIORITY_INHERITANCE_DEPTH */
+/*-----------------------------------------------------------*/
+
+#if( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 )
+
+	static void prvDisinheritPriorityAlongChainAfterTimeout( const Queue_t *pxMutex )
+	{
+	TaskHandle_t xMutexHolder = pxMutex->u.xSemaphore.xMutexHolder;
+	const TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+	UBaseType_t uxDepth;
+
+		/* Called from a critical section.  Each holder along the chain is
+		waiting for the next mutex, and has already been moved to its new
+		position in that mutex's list of waiting tasks, so each mutex can be
+		treated as if a task waiting for it had just timed out. */
+		for( uxDepth = ( UBaseType_t ) 1; uxDepth < ( UBaseType_t ) configMAX_PRIORITY_INHERITANCE_DEPTH; uxDepth++ )
+		{
+			if( xMutexHolder == NULL )
+			{
+				break;
+			}
+
+			pxMutex = ( const Queue_t * ) pvTaskGetMutexBlockedOn( xMutexHolder );
+
+			if( pxMutex == NULL )
+			{
+				break;
+			}
+
+			xMutexHolder = pxMutex->u.xSemaphore.xMutexHolder;
+
+			if( xMutexHolder == xCurrentTask )
+			{
+				break;
+			}
+
+			vTaskPriorityDisinheritAfterTimeout( xMutexHolder, prvGetDisinheritPriorityAfterTimeout( pxMutex ) );
+		}
+	}
+
+#endif /* configMAX_PRIORITY_INHERITANCE_DEPTH */
+/*-----------------------------------------------------------*/
+
 static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvItemToQueue, const BaseType_t xPosition )
 {
 BaseType_t xReturn = pdFALSE;
@@ -2082,6 +3049,20 @@ UBaseType_t uxMessagesWaiting;
 		{
 			if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
 			{
+				#if ( configUSE_MUTEX_STATISTICS == 1 )
+				{
+					/* There is no holder when the mutex is first created. */
+					if( pxQueue->u.xSemaphore.xMutexHolder != NULL )
+					{
+						prvMutexStatsGiven( pxQueue );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif
+
 				/* The mutex is no longer being held. */
 				xReturn = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
 				pxQueue->u.xSemaphore.xMutexHolder = NULL;
@@ -2092,6 +3073,19 @@ UBaseType_t uxMessagesWaiting;
 			}
 		}
 		#endif /* configUSE_MUTEXES */
+
+		#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+		{
+			if( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX )
+			{
+				( pxQueue->uxGiveCount )++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configUSE_COUNTING_SEMAPHORES */
 	}
 	else if( xPosition == queueSEND_TO_BACK )
 	{
@@ -2204,7 +3198,7 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
 					suspended. */
 					if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
 					{
-						if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+						if( queueREMOVE_FROM_RECEIVE_LIST( pxQueue ) != pdFALSE )
 						{
 							/* The task waiting has a higher priority so record that a
 							context	switch is required. */
@@ -2219,6 +3213,15 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
 					{
 						break;
 					}
+
+					if( queueUNLOCK_IN_ONE_PASS( pxQueue ) != pdFALSE )
+					{
+						break;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
 			}
 			#else /* configUSE_QUEUE_SETS */
@@ -2227,7 +3230,7 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
 				the pending ready list as the scheduler is still suspended. */
 				if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
 				{
-					if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+					if( queueREMOVE_FROM_RECEIVE_LIST( pxQueue ) != pdFALSE )
 					{
 						/* The task waiting has a higher priority so record that
 						a context switch is required. */
@@ -2242,6 +3245,15 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
 				{
 					break;
 				}
+
+				if( queueUNLOCK_IN_ONE_PASS( pxQueue ) != pdFALSE )
+				{
+					break;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 			#endif /* configUSE_QUEUE_SETS */
 
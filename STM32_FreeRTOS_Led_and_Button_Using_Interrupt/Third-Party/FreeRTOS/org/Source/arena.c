@@ -0,0 +1,442 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "arena.h"
+
+/* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+to include arena functionality.  This #if is closed at the very bottom of this
+file.  If you want to include arenas then ensure configUSE_ARENAS is set to 1 in
+FreeRTOSConfig.h. */
+#if( configUSE_ARENAS == 1 )
+
+/* The header placed at the start of each chunk an arena grows by, so the
+chunks can be found and freed again when the arena is reset or deleted. */
+typedef struct ARENA_CHUNK
+{
+	struct ARENA_CHUNK *pxNextChunk;		/*<< The chunk the arena grew by before this one. */
+} ArenaChunk_t;
+
+/* The size of the chunk header, rounded up so the memory that follows it is
+aligned. */
+#define arenaCHUNK_HEADER_SIZE	arenaALLOCATION_SIZE( sizeof( ArenaChunk_t ) )
+
+/* The definition of the arena itself. */
+typedef struct ArenaDef_t
+{
+	uint8_t *pucNextFree;					/*<< The next byte that will be handed out. */
+	uint8_t *pucEnd;						/*<< The end of the region or chunk pucNextFree points into. */
+	uint8_t *pucStorage;					/*<< The start of the initial region. */
+	size_t xStorageSize;					/*<< The size of the initial region. */
+	size_t xGrowSize;						/*<< The minimum size of each chunk the arena grows by, or 0 if the arena never grows. */
+	ArenaChunk_t *pxChunks;					/*<< The most recent chunk the arena grew by, through which all its chunks are linked. */
+	size_t xBytesAllocated;					/*<< The bytes handed out since the arena was created or last reset. */
+	size_t xBytesReserved;					/*<< The size of the initial region plus the size of all the chunks. */
+	UBaseType_t uxChunks;					/*<< The number of chunks in the pxChunks list. */
+	uint32_t ulAllocations;					/*<< The number of successful allocations. */
+	uint32_t ulFailedAllocations;			/*<< The number of allocations that returned NULL. */
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucStaticallyAllocated;		/*<< Set to pdTRUE if the arena was created statically, so no attempt is made to free its memory when it is deleted. */
+	#endif
+} Arena_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by both arena creation functions to fill in the arena's structure.
+ */
+static void prvInitialiseNewArena( Arena_t * const pxArena, uint8_t * const pucStorage, size_t xStorageSize, size_t xGrowSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Grow the arena by a chunk allocated from the FreeRTOS heap, and allocate
+ * xSize bytes from the new chunk.  Returns NULL if the arena cannot grow.
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	static void *prvGrowArena( Arena_t * const pxArena, size_t xSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Return all the chunks the arena has grown by to the FreeRTOS heap.
+ */
+static void prvFreeChunks( Arena_t * const pxArena ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	ArenaHandle_t xArenaCreate( size_t xSize, size_t xGrowSize )
+	{
+	Arena_t *pxNewArena;
+	size_t xStructSize;
+
+		configASSERT( ( xSize > ( size_t ) 0 ) || ( xGrowSize > ( size_t ) 0 ) );
+
+		/* The initial region follows the arena's structure in the same
+		allocation, so the structure's size is rounded up to keep the region
+		aligned. */
+		xStructSize = arenaALLOCATION_SIZE( sizeof( Arena_t ) );
+		xSize = arenaALLOCATION_SIZE( xSize );
+		pxNewArena = ( Arena_t * ) pvPortMalloc( xStructSize + xSize ); /*lint !e9087 !e9079 pvPortMalloc() returns memory aligned to portBYTE_ALIGNMENT. */
+
+		if( pxNewArena != NULL )
+		{
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				/* Both static and dynamic allocation can be used, so note this
+				arena was allocated dynamically in case it is later deleted. */
+				pxNewArena->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+			prvInitialiseNewArena( pxNewArena, ( ( uint8_t * ) pxNewArena ) + xStructSize, xSize, xGrowSize );
+			traceARENA_CREATE( pxNewArena );
+		}
+		else
+		{
+			traceARENA_CREATE_FAILED();
+		}
+
+		return pxNewArena;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	ArenaHandle_t xArenaCreateStatic( size_t xSize, uint8_t *pucArenaStorage, StaticArena_t *pxStaticArena )
+	{
+	Arena_t *pxNewArena;
+
+		configASSERT( xSize > ( size_t ) 0 );
+		configASSERT( pucArenaStorage );
+		configASSERT( pxStaticArena );
+		configASSERT( ( ( ( size_t ) pucArenaStorage ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticArena_t equals the size of the real arena
+			structure. */
+			volatile size_t xSize = sizeof( StaticArena_t );
+			configASSERT( xSize == sizeof( Arena_t ) );
+			( void ) xSize; /* Keeps lint quiet when configASSERT() is not defined. */
+		}
+		#endif /* configASSERT_DEFINED */
+
+		pxNewArena = ( Arena_t * ) pxStaticArena; /*lint !e740 !e9087 StaticArena_t is a pointer to an Arena_t, so guaranteed to be aligned and sized correctly (checked by an assert()), so this is safe. */
+
+		#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		{
+			/* Both static and dynamic allocation can be used, so note this
+			arena was allocated statically in case it is later deleted. */
+			pxNewArena->ucStaticallyAllocated = pdTRUE;
+		}
+		#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+		/* Only whole allocations fit in the region, so any bytes beyond the
+		last multiple of portBYTE_ALIGNMENT are not used.  A statically
+		created arena does not grow, so no heap is ever used. */
+		prvInitialiseNewArena( pxNewArena, pucArenaStorage, xSize & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ), ( size_t ) 0 );
+		traceARENA_CREATE( pxNewArena );
+
+		return pxNewArena;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewArena( Arena_t * const pxArena, uint8_t * const pucStorage, size_t xStorageSize, size_t xGrowSize )
+{
+	pxArena->pucStorage = pucStorage;
+	pxArena->xStorageSize = xStorageSize;
+	pxArena->xGrowSize = xGrowSize;
+	pxArena->pxChunks = NULL;
+	pxArena->uxChunks = ( UBaseType_t ) 0;
+	pxArena->pucNextFree = pucStorage;
+	pxArena->pucEnd = pucStorage + xStorageSize;
+	pxArena->xBytesAllocated = ( size_t ) 0;
+	pxArena->xBytesReserved = xStorageSize;
+	pxArena->ulAllocations = 0UL;
+	pxArena->ulFailedAllocations = 0UL;
+}
+/*-----------------------------------------------------------*/
+
+void *pvArenaAlloc( ArenaHandle_t xArena, size_t xSize )
+{
+Arena_t * const pxArena = xArena;
+void *pvReturn = NULL;
+
+	configASSERT( pxArena );
+
+	/* Requests of 0 bytes, and requests so large that rounding them up to a
+	multiple of portBYTE_ALIGNMENT would overflow, are not satisfied. */
+	if( ( xSize > ( size_t ) 0 ) && ( arenaALLOCATION_SIZE( xSize ) >= xSize ) )
+	{
+		xSize = arenaALLOCATION_SIZE( xSize );
+
+		if( xSize <= ( size_t ) ( pxArena->pucEnd - pxArena->pucNextFree ) )
+		{
+			/* The common case - the allocation fits in the space that
+			remains, so only the pointer needs to move. */
+			pvReturn = pxArena->pucNextFree;
+			pxArena->pucNextFree += xSize;
+		}
+		else
+		{
+			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+			{
+				pvReturn = prvGrowArena( pxArena, xSize );
+			}
+			#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pvReturn != NULL )
+	{
+		pxArena->xBytesAllocated += xSize;
+		( pxArena->ulAllocations )++;
+	}
+	else
+	{
+		( pxArena->ulFailedAllocations )++;
+	}
+
+	traceARENA_ALLOC( pxArena, pvReturn, xSize );
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vArenaReset( ArenaHandle_t xArena )
+{
+Arena_t * const pxArena = xArena;
+
+	configASSERT( pxArena );
+	traceARENA_RESET( pxArena );
+
+	prvFreeChunks( pxArena );
+
+	pxArena->pucNextFree = pxArena->pucStorage;
+	pxArena->pucEnd = pxArena->pucStorage + pxArena->xStorageSize;
+	pxArena->xBytesAllocated = ( size_t ) 0;
+	pxArena->xBytesReserved = pxArena->xStorageSize;
+}
+/*-----------------------------------------------------------*/
+
+void vArenaGetStats( ArenaHandle_t xArena, ArenaStats_t *pxStats )
+{
+Arena_t * const pxArena = xArena;
+
+	configASSERT( pxArena );
+	configASSERT( pxStats );
+
+	pxStats->xBytesAllocated = pxArena->xBytesAllocated;
+	pxStats->xBytesReserved = pxArena->xBytesReserved;
+	pxStats->uxChunks = pxArena->uxChunks;
+	pxStats->ulAllocations = pxArena->ulAllocations;
+	pxStats->ulFailedAllocations = pxArena->ulFailedAllocations;
+}
+/*-----------------------------------------------------------*/
+
+void vArenaDelete( ArenaHandle_t xArena )
+{
+Arena_t * const pxArena = xArena;
+
+	configASSERT( pxArena );
+	traceARENA_DELETE( pxArena );
+
+	prvFreeChunks( pxArena );
+
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+	{
+		/* The arena can only have been allocated dynamically - free it
+		again. */
+		vPortFree( pxArena );
+	}
+	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	{
+		/* The arena could have been allocated statically or dynamically, so
+		check before attempting to free the memory. */
+		if( pxArena->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			vPortFree( pxArena );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	void *pvTaskArenaAlloc( size_t xSize )
+	{
+	ArenaHandle_t xArena;
+	void *pvReturn;
+
+		xArena = xTaskGetArena( NULL );
+
+		if( xArena == NULL )
+		{
+			/* The first allocation made by this task, so create its arena.
+			The arena belongs to the task from now on, and is deleted when the
+			task is deleted. */
+			xArena = xArenaCreate( configTASK_ARENA_SIZE, configTASK_ARENA_SIZE );
+
+			if( xArena != NULL )
+			{
+				vTaskSetArena( NULL, xArena );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xArena != NULL )
+		{
+			pvReturn = pvArenaAlloc( xArena, xSize );
+		}
+		else
+		{
+			pvReturn = NULL;
+		}
+
+		return pvReturn;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	static void *prvGrowArena( Arena_t * const pxArena, size_t xSize )
+	{
+	ArenaChunk_t *pxNewChunk = NULL;
+	size_t xChunkSize;
+	void *pvReturn = NULL;
+
+		if( pxArena->xGrowSize > ( size_t ) 0 )
+		{
+			/* The chunk is large enough to hold the allocation.  Whatever
+			remains of the current region or chunk is not used again until the
+			arena is reset. */
+			xChunkSize = ( xSize > pxArena->xGrowSize ) ? xSize : arenaALLOCATION_SIZE( pxArena->xGrowSize );
+
+			if( ( xChunkSize + arenaCHUNK_HEADER_SIZE ) > xChunkSize )
+			{
+				pxNewChunk = ( ArenaChunk_t * ) pvPortMalloc( arenaCHUNK_HEADER_SIZE + xChunkSize ); /*lint !e9087 !e9079 pvPortMalloc() returns memory aligned to portBYTE_ALIGNMENT. */
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( pxNewChunk != NULL )
+			{
+				pxNewChunk->pxNextChunk = pxArena->pxChunks;
+				pxArena->pxChunks = pxNewChunk;
+				( pxArena->uxChunks )++;
+				pxArena->xBytesReserved += xChunkSize;
+
+				pvReturn = ( ( uint8_t * ) pxNewChunk ) + arenaCHUNK_HEADER_SIZE;
+				pxArena->pucNextFree = ( ( uint8_t * ) pvReturn ) + xSize;
+				pxArena->pucEnd = ( ( uint8_t * ) pvReturn ) + xChunkSize;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pvReturn;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvFreeChunks( Arena_t * const pxArena )
+{
+	#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	{
+	ArenaChunk_t *pxChunk;
+
+		while( pxArena->pxChunks != NULL )
+		{
+			pxChunk = pxArena->pxChunks;
+			pxArena->pxChunks = pxChunk->pxNextChunk;
+			vPortFree( pxChunk );
+		}
+
+		pxArena->uxChunks = ( UBaseType_t ) 0;
+	}
+	#else
+	{
+		/* Only dynamically created arenas grow, so there are no chunks to
+		free. */
+		( void ) pxArena;
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include arena functionality.  If you want to include arenas then ensure
+configUSE_ARENAS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_ARENAS == 1 */
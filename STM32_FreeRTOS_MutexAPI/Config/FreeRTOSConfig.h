@@ -69,6 +69,11 @@ extern void vApplicationMallocFailedHook( void );
 #define configUSE_APPLICATION_TASK_TAG	0
 #define configUSE_COUNTING_SEMAPHORES	1
 #define configGENERATE_RUN_TIME_STATS	0
+#define configUSE_MUTEX_STATISTICS		1
+
+/* Mutex hold and wait times are measured in CPU cycles using the DWT cycle
+counter (DWT->CYCCNT), which is enabled at the start of main(). */
+#define portGET_MUTEX_STATS_TIME()		( *( ( volatile uint32_t * ) 0xE0001004UL ) )
 
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES 		0
@@ -565,10 +565,109 @@ extern "C" {
 	#define traceTIMER_COMMAND_RECEIVED( pxTimer, xMessageID, xMessageValue )
 #endif
 
+#ifndef traceHR_TIMER_START
+	#define traceHR_TIMER_START( pxTimer, ulExpiryCount )
+#endif
+
+#ifndef traceHR_TIMER_EXPIRED
+	#define traceHR_TIMER_EXPIRED( pxTimer )
+#endif
+
+#ifndef traceMEMORY_POOL_CREATE
+	#define traceMEMORY_POOL_CREATE( pxMemoryPool )
+#endif
+
+#ifndef traceMEMORY_POOL_CREATE_FAILED
+	#define traceMEMORY_POOL_CREATE_FAILED()
+#endif
+
+#ifndef traceMEMORY_POOL_ALLOC
+	#define traceMEMORY_POOL_ALLOC( pxMemoryPool, pvBlock )
+#endif
+
+#ifndef traceMEMORY_POOL_FREE
+	#define traceMEMORY_POOL_FREE( pxMemoryPool, pvBlock )
+#endif
+
+#ifndef traceMEMORY_POOL_DELETE
+	#define traceMEMORY_POOL_DELETE( pxMemoryPool )
+#endif
+
+#ifndef traceARENA_CREATE
+	#define traceARENA_CREATE( pxArena )
+#endif
+
+#ifndef traceARENA_CREATE_FAILED
+	#define traceARENA_CREATE_FAILED()
+#endif
+
+#ifndef traceARENA_ALLOC
+	#define traceARENA_ALLOC( pxArena, pvAddress, xSize )
+#endif
+
+#ifndef traceARENA_RESET
+	#define traceARENA_RESET( pxArena )
+#endif
+
+#ifndef traceARENA_DELETE
+	#define traceARENA_DELETE( pxArena )
+#endif
+
+#ifndef traceSLAB_CACHE_GROW
+	#define traceSLAB_CACHE_GROW( eCache, uxObjects )
+#endif
+
+#ifndef traceSLAB_ALLOC
+	#define traceSLAB_ALLOC( eCache, pvObject )
+#endif
+
+#ifndef traceSLAB_ALLOC_FAILED
+	#define traceSLAB_ALLOC_FAILED( eCache )
+#endif
+
+#ifndef traceSLAB_FREE
+	#define traceSLAB_FREE( eCache, pvObject )
+#endif
+
+#ifndef configUSE_HEAP_TRACKER
+	#define configUSE_HEAP_TRACKER 0
+#endif
+
+#if ( configUSE_HEAP_TRACKER == 1 )
+
+	/* heap_tracker.c implements the heap trace macros, so the application must
+	not define them too. */
+	#if defined( traceMALLOC ) || defined( traceMALLOC_FROM_ISR ) || defined( traceFREE )
+		#error traceMALLOC, traceMALLOC_FROM_ISR and traceFREE must not be defined when configUSE_HEAP_TRACKER is 1, as they are implemented by heap_tracker.c.
+	#endif
+
+	#ifndef configHEAP_TRACKER_CALLER
+		/* Evaluated inside pvPortMalloc() to obtain the address pvPortMalloc()
+		will return to, which identifies the call site of the allocation. */
+		#ifdef __GNUC__
+			#define configHEAP_TRACKER_CALLER() __builtin_return_address( 0 )
+		#else
+			#define configHEAP_TRACKER_CALLER() NULL
+		#endif
+	#endif
+
+	void vHeapTrackerMalloc( void *pvAddress, size_t xSize, void *pvCaller, BaseType_t xFromISR ) PRIVILEGED_FUNCTION;
+	void vHeapTrackerFree( void *pvAddress ) PRIVILEGED_FUNCTION;
+
+	#define traceMALLOC( pvAddress, uiSize ) vHeapTrackerMalloc( ( pvAddress ), ( uiSize ), configHEAP_TRACKER_CALLER(), pdFALSE )
+	#define traceMALLOC_FROM_ISR( pvAddress, uiSize ) vHeapTrackerMalloc( ( pvAddress ), ( uiSize ), configHEAP_TRACKER_CALLER(), pdTRUE )
+	#define traceFREE( pvAddress, uiSize ) vHeapTrackerFree( pvAddress )
+
+#endif /* configUSE_HEAP_TRACKER */
+
 #ifndef traceMALLOC
     #define traceMALLOC( pvAddress, uiSize )
 #endif
 
+#ifndef traceMALLOC_FROM_ISR
+	#define traceMALLOC_FROM_ISR( pvAddress, uiSize ) traceMALLOC( pvAddress, uiSize )
+#endif
+
 #ifndef traceFREE
     #define traceFREE( pvAddress, uiSize )
 #endif
@@ -747,6 +846,51 @@ extern "C" {
 	#define configUSE_MALLOC_FAILED_HOOK 0
 #endif
 
+#ifndef configUSE_CEILING_MUTEXES
+	#define configUSE_CEILING_MUTEXES 0
+#endif
+
+#ifndef configMAX_PRIORITY_INHERITANCE_DEPTH
+	/* The number of mutex holders along a blocking chain that inherit the
+	priority of a task that blocks on a mutex.  1 raises only the direct
+	holder of the mutex. */
+	#define configMAX_PRIORITY_INHERITANCE_DEPTH 1
+#endif
+
+#ifndef configUSE_MUTEX_STATISTICS
+	#define configUSE_MUTEX_STATISTICS 0
+#endif
+
+#if ( configUSE_MUTEX_STATISTICS == 1 )
+
+	/* The time base used to measure mutex hold and wait times.  Defaults to
+	the run time stats counter if one is available, otherwise the tick count.
+	Define portGET_MUTEX_STATS_TIME() in FreeRTOSConfig.h to use a faster
+	free running counter, such as a cycle counter. */
+	#ifndef portGET_MUTEX_STATS_TIME
+		#if ( configGENERATE_RUN_TIME_STATS == 1 ) && defined( portGET_RUN_TIME_COUNTER_VALUE )
+			#define portGET_MUTEX_STATS_TIME() ( ( uint32_t ) portGET_RUN_TIME_COUNTER_VALUE() )
+		#else
+			#define portGET_MUTEX_STATS_TIME() ( ( uint32_t ) xTaskGetTickCount() )
+		#endif
+	#endif
+
+#endif /* configUSE_MUTEX_STATISTICS */
+
+#ifndef configUSE_EVENT_GROUP_BIT_INDEXED_WAITERS
+	#define configUSE_EVENT_GROUP_BIT_INDEXED_WAITERS 0
+#endif
+
+#ifndef configUSE_DIRECT_EVENT_GROUP_SET_FROM_ISR
+	#define configUSE_DIRECT_EVENT_GROUP_SET_FROM_ISR 0
+#endif
+
+#ifndef configEVENT_GROUP_SET_BITS_FROM_ISR_BUDGET
+	/* The maximum number of waiting tasks xEventGroupSetBitsFromISR() visits
+	with interrupts masked when it sets bits directly. */
+	#define configEVENT_GROUP_SET_BITS_FROM_ISR_BUDGET 4
+#endif
+
 #ifndef portPRIVILEGE_BIT
 	#define portPRIVILEGE_BIT ( ( UBaseType_t ) 0x00 )
 #endif
@@ -839,6 +983,14 @@ extern "C" {
 	#define configUSE_TASK_NOTIFICATIONS 1
 #endif
 
+#ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
+	#define configTASK_NOTIFICATION_ARRAY_ENTRIES 1
+#endif
+
+#if configTASK_NOTIFICATION_ARRAY_ENTRIES < 1
+	#error configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 1
+#endif
+
 #ifndef configUSE_POSIX_ERRNO
 	#define configUSE_POSIX_ERRNO 0
 #endif
@@ -870,6 +1022,207 @@ extern "C" {
 	#define configMESSAGE_BUFFER_LENGTH_TYPE size_t
 #endif
 
+#ifndef configUSE_MULTI_PRODUCER_STREAM_BUFFERS
+	#define configUSE_MULTI_PRODUCER_STREAM_BUFFERS 0
+#endif
+
+#ifndef configUSE_STREAM_BUFFER_ZERO_COPY
+	#define configUSE_STREAM_BUFFER_ZERO_COPY 0
+#endif
+
+#ifndef configUSE_STREAM_BUFFER_TRIGGER_HOLD_OFF
+	#define configUSE_STREAM_BUFFER_TRIGGER_HOLD_OFF 0
+#endif
+
+#ifndef configUSE_TIMER_WHEEL
+	#define configUSE_TIMER_WHEEL 0
+#endif
+
+#ifndef configTIMER_WHEEL_SLOT_BITS
+	/* Each level of the timer wheel has 2^configTIMER_WHEEL_SLOT_BITS slots. */
+	#define configTIMER_WHEEL_SLOT_BITS 4
+#endif
+
+#ifndef configUSE_TICK_CONTEXT_TIMERS
+	#define configUSE_TICK_CONTEXT_TIMERS 0
+#endif
+
+#ifndef configTICK_CONTEXT_TIMER_BUDGET
+	/* The maximum number of tick context timer callbacks executed in one tick
+	interrupt. */
+	#define configTICK_CONTEXT_TIMER_BUDGET 4
+#endif
+
+#ifndef configUSE_TIMER_SLACK
+	#define configUSE_TIMER_SLACK 0
+#endif
+
+#ifndef configTIMER_SERVICE_TASKS
+	#define configTIMER_SERVICE_TASKS 1
+#endif
+
+#ifndef configTIMER_SERVICE_TASK_PRIORITY
+	/* The priority of timer service task uxService, where uxService is from 0
+	to configTIMER_SERVICE_TASKS - 1. */
+	#define configTIMER_SERVICE_TASK_PRIORITY( uxService ) configTIMER_TASK_PRIORITY
+#endif
+
+#ifndef configUSE_TIMER_COMMAND_BATCHES
+	#define configUSE_TIMER_COMMAND_BATCHES 0
+#endif
+
+#ifndef configTIMER_COMMAND_BATCH_LENGTH
+	/* The most commands one timer command batch can hold. */
+	#define configTIMER_COMMAND_BATCH_LENGTH 8
+#endif
+
+#ifndef configTIMER_COMMAND_BATCH_SLOTS
+	/* The number of timer command batches, shared by all the timer service
+	tasks, that can have been sent but not yet applied at any one time. */
+	#define configTIMER_COMMAND_BATCH_SLOTS 2
+#endif
+
+#ifndef configUSE_HR_TIMERS
+	#define configUSE_HR_TIMERS 0
+#endif
+
+#ifndef configHR_TIMER_COUNT_RATE_HZ
+	/* The rate at which the counter returned by portGET_HR_TIMER_COUNT()
+	increments. */
+	#define configHR_TIMER_COUNT_RATE_HZ 1000000UL
+#endif
+
+#ifndef configHR_TIMER_MIN_COMPARE_DELTA
+	/* The minimum number of counts between reading the counter and the compare
+	value that is written, so the counter cannot pass the compare value before
+	it takes effect. */
+	#define configHR_TIMER_MIN_COMPARE_DELTA 2
+#endif
+
+#ifndef configHR_TIMER_NOTIFICATION_INDEX
+	/* The task notification index used by vHRTimerDelay(). */
+	#define configHR_TIMER_NOTIFICATION_INDEX ( configTASK_NOTIFICATION_ARRAY_ENTRIES - 1 )
+#endif
+
+#if ( configUSE_HR_TIMERS == 1 )
+
+	#ifndef portCONFIGURE_HR_TIMER
+		#error If configUSE_HR_TIMERS is 1 then portCONFIGURE_HR_TIMER must also be defined.  portCONFIGURE_HR_TIMER should call a port layer function to setup a free running 32-bit peripheral counter with a compare interrupt that calls xHRTimerProcessCompareInterrupt().
+	#endif /* portCONFIGURE_HR_TIMER */
+
+	#ifndef portGET_HR_TIMER_COUNT
+		#error If configUSE_HR_TIMERS is 1 then portGET_HR_TIMER_COUNT must also be defined to return the current counter value.
+	#endif /* portGET_HR_TIMER_COUNT */
+
+	#ifndef portSET_HR_TIMER_COMPARE
+		#error If configUSE_HR_TIMERS is 1 then portSET_HR_TIMER_COMPARE must also be defined to set the compare value and enable the compare interrupt.
+	#endif /* portSET_HR_TIMER_COMPARE */
+
+#endif /* configUSE_HR_TIMERS */
+
+#ifndef portDISABLE_HR_TIMER_COMPARE
+	#define portDISABLE_HR_TIMER_COMPARE()
+#endif
+
+#ifndef configUSE_TLSF_HEAP
+	/* Set to 1 to use heap_tlsf.c rather than heap_4.c. */
+	#define configUSE_TLSF_HEAP 0
+#endif
+
+#ifndef configTLSF_SL_INDEX_COUNT_LOG2
+	/* heap_tlsf.c divides each power of two range of block sizes into
+	( 1 << configTLSF_SL_INDEX_COUNT_LOG2 ) size classes. */
+	#define configTLSF_SL_INDEX_COUNT_LOG2 4
+#endif
+
+#ifndef configTLSF_FL_INDEX_MAX
+	/* heap_tlsf.c can manage blocks of up to
+	( ( 2 << configTLSF_FL_INDEX_MAX ) - 1 ) bytes, so this must be at least the
+	log2 of configTOTAL_HEAP_SIZE. */
+	#define configTLSF_FL_INDEX_MAX 20
+#endif
+
+#ifndef configUSE_REGION_HEAP
+	/* Set to 1 to use heap_regions.c rather than heap_4.c. */
+	#define configUSE_REGION_HEAP 0
+#endif
+
+#ifndef configHEAP_MAX_REGIONS
+	/* The number of regions that can be passed to vPortDefineHeapRegions()
+	when heap_regions.c is used. */
+	#define configHEAP_MAX_REGIONS 4
+#endif
+
+#ifndef configUSE_MEMORY_POOLS
+	#define configUSE_MEMORY_POOLS 0
+#endif
+
+#ifndef configUSE_ARENAS
+	#define configUSE_ARENAS 0
+#endif
+
+#ifndef configTASK_ARENA_SIZE
+	/* The initial size, and the grow size, of the arena pvTaskArenaAlloc()
+	creates for a task that does not already have one. */
+	#define configTASK_ARENA_SIZE 256
+#endif
+
+#ifndef configHEAP_USE_CRITICAL_SECTIONS
+	/* Set to 1 to protect the heap with short critical sections rather than by
+	suspending the scheduler, which also allows small blocks to be allocated
+	and freed from interrupts. */
+	#define configHEAP_USE_CRITICAL_SECTIONS 0
+#endif
+
+#ifndef configHEAP_SMALL_BLOCK_MAX_SIZE
+	/* The largest block, in bytes, that heap_4.c keeps in its small block lists
+	when configHEAP_USE_CRITICAL_SECTIONS is 1. */
+	#define configHEAP_SMALL_BLOCK_MAX_SIZE 64
+#endif
+
+#ifndef configHEAP_TRACKER_TABLE_SIZE
+	/* The number of entries in the heap tracker's side table, which must be a
+	power of two.  Up to three quarters of the entries are used, so the table
+	can track ( ( configHEAP_TRACKER_TABLE_SIZE * 3 ) / 4 ) live allocations. */
+	#define configHEAP_TRACKER_TABLE_SIZE 128
+#endif
+
+#ifndef configHEAP_TRACKER_CALL_SITES
+	/* The number of different call sites the heap tracker records, which must
+	be a power of two. */
+	#define configHEAP_TRACKER_CALL_SITES 32
+#endif
+
+#ifndef configUSE_SLAB_CACHES
+	/* Set to 1 to allocate the control blocks of tasks, queues, timers and
+	event groups from slab caches rather than with pvPortMalloc(). */
+	#define configUSE_SLAB_CACHES 0
+#endif
+
+#ifndef configSLAB_CACHE_TASKS
+	/* The number of objects in the first slab of each slab cache, allocated
+	when the first kernel object is created. */
+	#define configSLAB_CACHE_TASKS 4
+#endif
+
+#ifndef configSLAB_CACHE_QUEUES
+	#define configSLAB_CACHE_QUEUES 4
+#endif
+
+#ifndef configSLAB_CACHE_TIMERS
+	#define configSLAB_CACHE_TIMERS 0
+#endif
+
+#ifndef configSLAB_CACHE_EVENT_GROUPS
+	#define configSLAB_CACHE_EVENT_GROUPS 0
+#endif
+
+#ifndef configSLAB_CACHE_GROW_OBJECTS
+	/* The number of objects in each slab added to a slab cache that has run
+	out of objects.  Set to 0 so creating an object fails instead. */
+	#define configSLAB_CACHE_GROW_OBJECTS 2
+#endif
+
 /* Sanity check the configuration. */
 #if( configUSE_TICKLESS_IDLE != 0 )
 	#if( INCLUDE_vTaskSuspend != 1 )
@@ -885,6 +1238,22 @@ extern "C" {
 	#error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
 
+#if( ( configUSE_CEILING_MUTEXES == 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error configUSE_MUTEXES must be set to 1 to use priority ceiling mutexes
+#endif
+
+#if( configMAX_PRIORITY_INHERITANCE_DEPTH < 1 )
+	#error configMAX_PRIORITY_INHERITANCE_DEPTH must be at least 1
+#endif
+
+#if( ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error configUSE_MUTEXES must be set to 1 to use transitive priority inheritance
+#endif
+
+#if( ( configUSE_MUTEX_STATISTICS == 1 ) && ( configUSE_MUTEXES != 1 ) )
+	#error configUSE_MUTEXES must be set to 1 to use mutex statistics
+#endif
+
 #ifndef configINITIAL_TICK_COUNT
 	#define configINITIAL_TICK_COUNT 0
 #endif
@@ -1051,6 +1420,9 @@ typedef struct xSTATIC_TCB
 	#if ( configUSE_MUTEXES == 1 )
 		UBaseType_t		uxDummy12[ 2 ];
 	#endif
+	#if ( configMAX_PRIORITY_INHERITANCE_DEPTH > 1 )
+		void			*pvDummy13;
+	#endif
 	#if ( configUSE_APPLICATION_TASK_TAG == 1 )
 		void			*pxDummy14;
 	#endif
@@ -1064,8 +1436,8 @@ typedef struct xSTATIC_TCB
 		struct	_reent	xDummy17;
 	#endif
 	#if ( configUSE_TASK_NOTIFICATIONS == 1 )
-		uint32_t 		ulDummy18;
-		uint8_t 		ucDummy19;
+		uint32_t 		ulDummy18[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+		uint8_t 		ucDummy19[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
 	#endif
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t			uxDummy20;
@@ -1077,6 +1449,9 @@ typedef struct xSTATIC_TCB
 	#if ( configUSE_POSIX_ERRNO == 1 )
 		int				iDummy22;
 	#endif
+	#if ( configUSE_ARENAS == 1 )
+		void			*pvDummy23;
+	#endif
 } StaticTask_t;
 
 /*
@@ -1120,6 +1495,24 @@ typedef struct xSTATIC_QUEUE
 		uint8_t ucDummy9;
 	#endif
 
+	#if ( configUSE_COUNTING_SEMAPHORES == 1 )
+		UBaseType_t uxDummy16;
+	#endif
+
+	#if ( configUSE_CEILING_MUTEXES == 1 )
+		UBaseType_t uxDummy15;
+	#endif
+
+	#if ( configUSE_MUTEX_STATISTICS == 1 )
+		struct
+		{
+			UBaseType_t uxDummy10[ 3 ];
+			uint32_t ulDummy11[ 4 ];
+			void *pvDummy12[ 5 ];
+		} xDummy13;
+		uint32_t ulDummy14;
+	#endif
+
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -1142,10 +1535,18 @@ typedef struct xSTATIC_EVENT_GROUP
 	TickType_t xDummy1;
 	StaticList_t xDummy2;
 
+	#if( configUSE_EVENT_GROUP_BIT_INDEXED_WAITERS == 1 )
+		StaticList_t xDummy5[ ( configUSE_16_BIT_TICKS == 1 ) ? 8 : 24 ];
+	#endif
+
 	#if( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxDummy3;
 	#endif
 
+	#if( configUSE_DIRECT_EVENT_GROUP_SET_FROM_ISR == 1 )
+		UBaseType_t uxDummy6;
+	#endif
+
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 			uint8_t ucDummy4;
 	#endif
@@ -1182,6 +1583,19 @@ typedef struct xSTATIC_TIMER
 		uint8_t 		ucDummy8;
 	#endif
 
+	#if( configUSE_TICK_CONTEXT_TIMERS == 1 )
+		uint8_t 		ucDummy9;
+	#endif
+
+	#if( configUSE_TIMER_SLACK == 1 )
+		TickType_t		xDummy10;
+	#endif
+
+	#if( configTIMER_SERVICE_TASKS > 1 )
+		uint8_t			ucDummy11;
+		UBaseType_t		uxDummy12;
+	#endif
+
 } StaticTimer_t;
 
 /*
@@ -1203,6 +1617,14 @@ typedef struct xSTATIC_STREAM_BUFFER
 	size_t uxDummy1[ 4 ];
 	void * pvDummy2[ 3 ];
 	uint8_t ucDummy3;
+	#if ( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+		size_t uxDummy5[ 2 ];
+		StaticList_t xDummy6;
+	#endif
+	#if ( configUSE_STREAM_BUFFER_TRIGGER_HOLD_OFF == 1 )
+		TickType_t xDummy7;
+		BaseType_t xDummy8;
+	#endif
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxDummy4;
 	#endif
@@ -1211,6 +1633,84 @@ typedef struct xSTATIC_STREAM_BUFFER
 /* Message buffers are built on stream buffers. */
 typedef StaticStreamBuffer_t StaticMessageBuffer_t;
 
+/*
+ * In line with software engineering best practice, especially when supplying a
+ * library that is likely to change in future versions, FreeRTOS implements a
+ * strict data hiding policy.  This means the high resolution timer structure
+ * used internally by FreeRTOS is not accessible to application code.  However,
+ * if the application writer wants to statically allocate the memory required
+ * to create a high resolution timer then the size of the timer object needs to
+ * be known.  The StaticHRTimer_t structure below is provided for this purpose.
+ * Its sizes and alignment requirements are guaranteed to match those of the
+ * genuine structure, no matter which architecture is being used, and no matter
+ * how the values in FreeRTOSConfig.h are set.  Its contents are somewhat
+ * obfuscated in the hope users will recognise that it would be unwise to make
+ * direct use of the structure members.
+ */
+typedef struct xSTATIC_HR_TIMER
+{
+	StaticListItem_t	xDummy1;
+	void				*pvDummy2[ 2 ];
+	uint32_t			ulDummy3;
+	#if( configUSE_TASK_NOTIFICATIONS == 1 )
+		void			*pvDummy4;
+		UBaseType_t		uxDummy5;
+	#endif
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t 		ucDummy6;
+	#endif
+} StaticHRTimer_t;
+
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the real memory pool structure is not accessible to
+ * the application.  However, if the application writer wants to statically
+ * allocate a memory pool then the size of the pool object needs to be known.
+ * The StaticMemoryPool_t structure below is provided for this purpose.  Its
+ * size and alignment requirements are guaranteed to match those of the genuine
+ * structure, no matter which architecture is being used, and no matter how the
+ * values in FreeRTOSConfig.h are set.  Its contents are somewhat obfuscated in
+ * the hope users will recognise that it would be unwise to make direct use of
+ * the structure members.
+ */
+typedef struct xSTATIC_MEMORY_POOL
+{
+	void *pvDummy1[ 2 ];
+	size_t xDummy2;
+	UBaseType_t uxDummy3[ 3 ];
+	uint32_t ulDummy4[ 3 ];
+	void *pvDummy5;
+	#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+		StaticSemaphore_t xDummy6;
+		uint8_t ucDummy7;
+	#endif
+} StaticMemoryPool_t;
+
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the real arena structure is not accessible to the
+ * application.  However, if the application writer wants to statically
+ * allocate an arena then the size of the arena object needs to be known.  The
+ * StaticArena_t structure below is provided for this purpose.  Its size and
+ * alignment requirements are guaranteed to match those of the genuine
+ * structure, no matter which architecture is being used, and no matter how the
+ * values in FreeRTOSConfig.h are set.  Its contents are somewhat obfuscated in
+ * the hope users will recognise that it would be unwise to make direct use of
+ * the structure members.
+ */
+typedef struct xSTATIC_ARENA
+{
+	void *pvDummy1[ 3 ];
+	size_t xDummy2[ 2 ];
+	void *pvDummy3;
+	size_t xDummy4[ 2 ];
+	UBaseType_t uxDummy5;
+	uint32_t ulDummy6[ 2 ];
+	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+		uint8_t ucDummy7;
+	#endif
+} StaticArena_t;
+
 #ifdef __cplusplus
 }
 #endif
@@ -84,6 +84,10 @@ must be set in the compiler's include path. */
 	#define portNUM_CONFIGURABLE_REGIONS 1
 #endif
 
+#ifndef portHEAP_STATS_SIZE_CLASSES
+	#define portHEAP_STATS_SIZE_CLASSES 10
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -102,26 +106,64 @@ extern "C" {
 	StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters ) PRIVILEGED_FUNCTION;
 #endif
 
-/* Used by heap_5.c. */
+/* Tags that describe the memory in a heap region, used by heap_regions.c.  A
+region can have any combination of them. */
+#define portHEAP_REGION_FAST	( ( UBaseType_t ) 0x01U )	/* Fast memory, such as internal SRAM, for frequently used data. */
+#define portHEAP_REGION_BULK	( ( UBaseType_t ) 0x02U )	/* Larger but slower memory, such as external SDRAM, for big buffers. */
+#define portHEAP_REGION_DMA		( ( UBaseType_t ) 0x04U )	/* Memory the DMA controllers can access. */
+
+/* Used by heap_5.c and heap_regions.c. */
 typedef struct HeapRegion
 {
 	uint8_t *pucStartAddress;
 	size_t xSizeInBytes;
+	UBaseType_t uxTags;			/* The portHEAP_REGION_xxx tags of the region.  Only used by heap_regions.c. */
 } HeapRegion_t;
 
 /*
- * Used to define multiple heap regions for use by heap_5.c.  This function
- * must be called before any calls to pvPortMalloc() - not creating a task,
- * queue, semaphore, mutex, software timer, event group, etc. will result in
- * pvPortMalloc being called.
+ * Used to define multiple heap regions for use by heap_5.c or heap_regions.c.
+ * This function must be called before any calls to pvPortMalloc() - not
+ * creating a task, queue, semaphore, mutex, software timer, event group, etc.
+ * will result in pvPortMalloc being called.
  *
  * pxHeapRegions passes in an array of HeapRegion_t structures - each of which
  * defines a region of memory that can be used as the heap.  The array is
- * terminated by a HeapRegions_t structure that has a size of 0.  The region
- * with the lowest start address must appear first in the array.
+ * terminated by a HeapRegions_t structure that has a size of 0.  For heap_5.c
+ * the region with the lowest start address must appear first in the array.
+ * For heap_regions.c the regions can be in any order, and are searched in that
+ * order when memory is allocated, so the fastest memory should appear first.
  */
 void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEGED_FUNCTION;
 
+/* Used to pass information about the heap out of vPortGetHeapStats().  Block
+sizes include the structure the heap places at the start of each block. */
+typedef struct xHeapStats
+{
+	size_t xAvailableHeapSpaceInBytes;		/* The total heap size currently available - this is the sum of all the free blocks, not the largest block that can be allocated. */
+	size_t xSizeOfLargestFreeBlockInBytes; 	/* The maximum size, in bytes, of all the free blocks within the heap at the time vPortGetHeapStats() is called. */
+	size_t xSizeOfSmallestFreeBlockInBytes;	/* The minimum size, in bytes, of all the free blocks within the heap at the time vPortGetHeapStats() is called. */
+	size_t xNumberOfFreeBlocks;				/* The number of free memory blocks within the heap at the time vPortGetHeapStats() is called. */
+	size_t xMinimumEverFreeBytesRemaining;	/* The minimum amount of total free memory (sum of all free blocks) there has been in the heap since the system booted. */
+	size_t xNumberOfSuccessfulAllocations;	/* The number of calls to pvPortMalloc() that have returned a valid memory block. */
+	size_t xNumberOfSuccessfulFrees;		/* The number of calls to vPortFree() that have successfully freed a block of memory. */
+	size_t xFreeBlocksBySize[ portHEAP_STATS_SIZE_CLASSES ];	/* Element n holds the number of free blocks of at least ( 16 << n ) bytes and less than ( 32 << n ) bytes.  The first element also counts smaller blocks, and the last element also counts larger blocks. */
+} HeapStats_t;
+
+/*
+ * Returns information on the blocks of free memory in the heap, so
+ * fragmentation can be seen before allocations start to fail.  The free blocks
+ * are walked, so the time taken depends on how many there are, but the walk is
+ * no longer than the one made by an allocation that fails.
+ */
+void vPortGetHeapStats( HeapStats_t *pxHeapStats ) PRIVILEGED_FUNCTION;
+
+/*
+ * Only available when configUSE_REGION_HEAP is 1.  Returns the same
+ * information as vPortGetHeapStats() for a single region, where uxRegion is the
+ * index of the region in the array passed to vPortDefineHeapRegions().
+ */
+void vPortGetHeapRegionStats( UBaseType_t uxRegion, HeapStats_t *pxHeapStats ) PRIVILEGED_FUNCTION;
+
 
 /*
  * Map to the memory management routines required for the port.
@@ -132,6 +174,32 @@ void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Only available when configUSE_REGION_HEAP is 1.  Allocates from a heap
+ * region that has all the portHEAP_REGION_xxx tags in uxTags, or if none of
+ * those regions can hold the block, from another region - except that
+ * portHEAP_REGION_DMA is never dropped, so memory requested with it is only
+ * allocated from regions that have it.
+ */
+void *pvPortMallocTagged( size_t xSize, UBaseType_t uxTags ) PRIVILEGED_FUNCTION;
+
+/*
+ * Only available when configHEAP_USE_CRITICAL_SECTIONS is 1.  heap_4.c only
+ * allocates blocks of up to configHEAP_SMALL_BLOCK_MAX_SIZE bytes from an
+ * interrupt, and only from blocks set aside by xPortReserveSmallBlocks() or
+ * freed by the application.
+ *
+ * Blocks set aside by xPortReserveSmallBlocks() are only ever allocated by
+ * pvPortMallocFromISR(), never by pvPortMalloc(), even when pvPortMalloc()
+ * would otherwise fail, and a freed block of the same size replaces one that an
+ * interrupt has used.  So, once xPortReserveSmallBlocks( xSize, uxCount ) has
+ * returned pdPASS, interrupts can always hold uxCount blocks of xSize bytes at
+ * once.  Reserved blocks are not counted as free heap space.
+ */
+void *pvPortMallocFromISR( size_t xSize ) PRIVILEGED_FUNCTION;
+void vPortFreeFromISR( void *pv ) PRIVILEGED_FUNCTION;
+BaseType_t xPortReserveSmallBlocks( size_t xSize, UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
 /*
  * Setup the hardware ready for the scheduler to take control.  This generally
  * sets up a tick interrupt and sets timers for the correct tick frequency.
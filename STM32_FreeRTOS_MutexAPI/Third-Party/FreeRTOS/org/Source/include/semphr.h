@@ -288,6 +288,38 @@ typedef QueueHandle_t SemaphoreHandle_t;
  */
 #define xSemaphoreTake( xSemaphore, xBlockTime )		xQueueSemaphoreTake( ( xSemaphore ), ( xBlockTime ) )
 
+/**
+ * semphr. h
+ * <pre>xSemaphoreTakeMultiple(
+ *                   SemaphoreHandle_t xSemaphore,
+ *                   UBaseType_t uxCount,
+ *                   TickType_t xBlockTime
+ *               )</pre>
+ *
+ * <i>Macro</i> to take uxCount from a counting semaphore in one operation.  The
+ * semaphore must have previously been created with a call to
+ * xSemaphoreCreateCounting().  The count is only reduced if all uxCount are
+ * available, otherwise the calling task blocks until they are.
+ *
+ * Mutex type semaphores must not be used with this macro.
+ *
+ * @param xSemaphore A handle to the semaphore being taken - obtained when
+ * the semaphore was created.
+ *
+ * @param uxCount The amount by which to reduce the semaphore count.  Must be
+ * at least 1 and no more than the semaphore's maximum count.
+ *
+ * @param xBlockTime The time in ticks to wait for uxCount to become
+ * available.  A block time of zero can be used to poll the semaphore.
+ *
+ * @return pdTRUE if the uxCount were obtained.  pdFALSE if xBlockTime expired
+ * before the semaphore count reached uxCount.
+ *
+ * \defgroup xSemaphoreTakeMultiple xSemaphoreTakeMultiple
+ * \ingroup Semaphores
+ */
+#define xSemaphoreTakeMultiple( xSemaphore, uxCount, xBlockTime )	xQueueSemaphoreTakeMultiple( ( xSemaphore ), ( uxCount ), ( xBlockTime ) )
+
 /**
  * semphr. h
  * xSemaphoreTakeRecursive(
@@ -623,6 +655,56 @@ typedef QueueHandle_t SemaphoreHandle_t;
  */
 #define xSemaphoreGiveFromISR( xSemaphore, pxHigherPriorityTaskWoken )	xQueueGiveFromISR( ( QueueHandle_t ) ( xSemaphore ), ( pxHigherPriorityTaskWoken ) )
 
+/**
+ * semphr. h
+ * <pre>
+ xSemaphoreGiveMultipleFromISR(
+                          SemaphoreHandle_t xSemaphore,
+                          UBaseType_t uxCount,
+                          BaseType_t *pxHigherPriorityTaskWoken
+                      )</pre>
+ *
+ * <i>Macro</i> to release a counting semaphore uxCount times from a single
+ * call.  Equivalent to calling xSemaphoreGiveFromISR() uxCount times, but the
+ * interrupt mask is only raised once and up to uxCount waiting tasks are
+ * unblocked in one pass.  The count is only raised if there is room for all
+ * uxCount gives.
+ *
+ * Mutex type semaphores (those created using a call to xSemaphoreCreateMutex())
+ * must not be used with this macro.
+ *
+ * This macro can be used from an ISR.
+ *
+ * @param xSemaphore A handle to the semaphore being released.  This is the
+ * handle returned when the semaphore was created.
+ *
+ * @param uxCount The amount by which to raise the semaphore count.
+ *
+ * @param pxHigherPriorityTaskWoken xSemaphoreGiveMultipleFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if giving the semaphore caused a task
+ * to unblock, and the unblocked task has a priority higher than the currently
+ * running task.
+ *
+ * @return pdTRUE if the semaphore was given uxCount times, otherwise
+ * errQUEUE_FULL and the count is left unchanged.
+ *
+ * Example usage:
+ <pre>
+ void vBurstISR( void )
+ {
+ BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+    // Five events were latched by the peripheral, signal them all at once.
+    xSemaphoreGiveMultipleFromISR( xSemaphore, 5, &xHigherPriorityTaskWoken );
+
+    portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+ }
+ </pre>
+ * \defgroup xSemaphoreGiveMultipleFromISR xSemaphoreGiveMultipleFromISR
+ * \ingroup Semaphores
+ */
+#define xSemaphoreGiveMultipleFromISR( xSemaphore, uxCount, pxHigherPriorityTaskWoken )	xQueueGiveMultipleFromISR( ( QueueHandle_t ) ( xSemaphore ), ( uxCount ), ( pxHigherPriorityTaskWoken ) )
+
 /**
  * semphr. h
  * <pre>
@@ -918,6 +1000,90 @@ typedef QueueHandle_t SemaphoreHandle_t;
 	#define xSemaphoreCreateRecursiveMutexStatic( pxStaticSemaphore ) xQueueCreateMutexStatic( queueQUEUE_TYPE_RECURSIVE_MUTEX, pxStaticSemaphore )
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * semphr. h
+ * <pre>SemaphoreHandle_t xSemaphoreCreateCeilingMutex( UBaseType_t uxCeilingPriority )</pre>
+ *
+ * Creates a mutex that uses the immediate priority ceiling protocol instead of
+ * priority inheritance, and returns a handle by which the mutex can be
+ * referenced.  configUSE_CEILING_MUTEXES must be set to 1 in FreeRTOSConfig.h
+ * for this macro to be available.
+ *
+ * A task that takes a ceiling mutex is raised to uxCeilingPriority straight
+ * away, rather than only once a higher priority task blocks on the mutex.  As
+ * long as uxCeilingPriority is at least the priority of every task that takes
+ * the mutex, no task that uses the mutex can preempt the holder, so tasks do
+ * not block on the mutex and the context switches that priority inheritance
+ * would cause never happen.  Taking the mutex from a task whose base priority
+ * is above the ceiling is an error.
+ *
+ * If configUSE_TIME_SLICING is 1 then tasks whose priority equals the ceiling
+ * still share processing time with the holder, and may run and block on the
+ * mutex while it is held.  Setting the ceiling one above the highest priority
+ * of the tasks that use the mutex avoids this.
+ *
+ * Ceiling and inheritance mutexes can be nested in any order.  As with
+ * priority inheritance, a task keeps its raised priority until it has given
+ * back every mutex it holds, at which point it returns to its base priority.
+ *
+ * Ceiling mutexes are taken and given using xSemaphoreTake() and
+ * xSemaphoreGive(), and the same restrictions as xSemaphoreCreateMutex() apply.
+ *
+ * @param uxCeilingPriority The priority a task runs at while it holds the
+ * mutex.  Must be less than configMAX_PRIORITIES.
+ *
+ * @return If the mutex was successfully created then a handle to the created
+ * mutex is returned.  If there was not enough heap to allocate the mutex data
+ * structures then NULL is returned.
+ *
+ * Example usage:
+ <pre>
+ SemaphoreHandle_t xSemaphore;
+
+ void vATask( void * pvParameters )
+ {
+    // The UART is used by tasks of priority 1, 2 and 3, so its mutex has a
+    // ceiling of 3.
+    xSemaphore = xSemaphoreCreateCeilingMutex( 3 );
+ }
+ </pre>
+ * \defgroup xSemaphoreCreateCeilingMutex xSemaphoreCreateCeilingMutex
+ * \ingroup Semaphores
+ */
+#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_CEILING_MUTEXES == 1 ) )
+	#define xSemaphoreCreateCeilingMutex( uxCeilingPriority ) xQueueCreateMutexWithCeiling( queueQUEUE_TYPE_MUTEX, ( uxCeilingPriority ) )
+#endif
+
+/**
+ * semphr. h
+ * <pre>SemaphoreHandle_t xSemaphoreCreateCeilingMutexStatic( UBaseType_t uxCeilingPriority, StaticSemaphore_t *pxMutexBuffer )</pre>
+ *
+ * As xSemaphoreCreateCeilingMutex(), but the memory used to hold the mutex is
+ * provided by pxMutexBuffer, as for xSemaphoreCreateMutexStatic().
+ *
+ * \defgroup xSemaphoreCreateCeilingMutexStatic xSemaphoreCreateCeilingMutexStatic
+ * \ingroup Semaphores
+ */
+#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_CEILING_MUTEXES == 1 ) )
+	#define xSemaphoreCreateCeilingMutexStatic( uxCeilingPriority, pxMutexBuffer ) xQueueCreateMutexWithCeilingStatic( queueQUEUE_TYPE_MUTEX, ( uxCeilingPriority ), ( pxMutexBuffer ) )
+#endif
+
+/**
+ * semphr. h
+ * <pre>SemaphoreHandle_t xSemaphoreCreateRecursiveCeilingMutex( UBaseType_t uxCeilingPriority )</pre>
+ *
+ * As xSemaphoreCreateCeilingMutex(), but creates a recursive mutex that is
+ * taken and given using xSemaphoreTakeRecursive() and
+ * xSemaphoreGiveRecursive().  The holder is raised to the ceiling by the
+ * outermost take.
+ *
+ * \defgroup xSemaphoreCreateRecursiveCeilingMutex xSemaphoreCreateRecursiveCeilingMutex
+ * \ingroup Semaphores
+ */
+#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_RECURSIVE_MUTEXES == 1 ) && ( configUSE_CEILING_MUTEXES == 1 ) )
+	#define xSemaphoreCreateRecursiveCeilingMutex( uxCeilingPriority ) xQueueCreateMutexWithCeiling( queueQUEUE_TYPE_RECURSIVE_MUTEX, ( uxCeilingPriority ) )
+#endif
+
 /**
  * semphr. h
  * <pre>SemaphoreHandle_t xSemaphoreCreateCounting( UBaseType_t uxMaxCount, UBaseType_t uxInitialCount )</pre>
@@ -1123,6 +1289,32 @@ typedef QueueHandle_t SemaphoreHandle_t;
  */
 #define xSemaphoreGetMutexHolderFromISR( xSemaphore ) xQueueGetMutexHolderFromISR( ( xSemaphore ) )
 
+/**
+ * semphr.h
+ * <pre>BaseType_t xSemaphoreGetMutexStats( SemaphoreHandle_t xMutex, MutexStats_t *pxMutexStats );</pre>
+ *
+ * Copies the contention statistics gathered for a mutex or recursive mutex
+ * into *pxMutexStats.  Only available when configUSE_MUTEX_STATISTICS is set
+ * to 1 in FreeRTOSConfig.h.
+ *
+ * Hold times are measured from the first take to the final give, so a
+ * recursive mutex is accounted once per outermost take.  A take is counted as
+ * contended if the calling task had to block before obtaining the mutex.
+ *
+ * @return pdPASS if xMutex is a mutex, otherwise pdFAIL and *pxMutexStats is
+ * not written.
+ */
+#define xSemaphoreGetMutexStats( xMutex, pxMutexStats ) xQueueGetMutexStats( ( xMutex ), ( pxMutexStats ) )
+
+/**
+ * semphr.h
+ * <pre>void vSemaphoreResetMutexStats( SemaphoreHandle_t xMutex );</pre>
+ *
+ * Clears the contention statistics gathered for a mutex.  Only available when
+ * configUSE_MUTEX_STATISTICS is set to 1 in FreeRTOSConfig.h.
+ */
+#define vSemaphoreResetMutexStats( xMutex ) vQueueResetMutexStats( ( xMutex ) )
+
 /**
  * semphr.h
  * <pre>UBaseType_t uxSemaphoreGetCount( SemaphoreHandle_t xSemaphore );</pre>
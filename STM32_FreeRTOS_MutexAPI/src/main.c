@@ -34,6 +34,14 @@ static void prvPrintTask( void *pvParameters );
 /* The function that uses a mutex to control access to standard out. */
 static void prvNewPrintString( const portCHAR *pcString );
 
+#ifdef USE_MUTEX
+/* Periodically reports the contention statistics gathered for the mutex. */
+static void prvMutexStatsTask( void *pvParameters );
+
+/* How often the mutex statistics are reported. */
+#define mainSTATS_PERIOD_MS	( 5000 )
+#endif
+
 /*-----------------------------------------------------------*/
 
 #ifdef USE_MUTEX
@@ -86,6 +94,12 @@ int main( void )
 		xTaskCreate( prvPrintTask, "Print1", 240, "Task 1 ******************************************\r\n", 1, NULL );
 		xTaskCreate( prvPrintTask, "Print2", 240, "Task 2 ------------------------------------------\r\n", 2, NULL );
 
+#ifdef USE_MUTEX
+		/* The reporting task runs above both print tasks so the report is not
+		delayed by them, but it still has to take the mutex to print. */
+		xTaskCreate( prvMutexStatsTask, "Stats", 400, NULL, 3, NULL );
+#endif
+
 		/* Start the scheduler so the created tasks start executing. */
 		vTaskStartScheduler();
 #ifdef USE_MUTEX
@@ -150,6 +164,46 @@ char *pcStringToPrint;
 }
 /*-----------------------------------------------------------*/
 
+#ifdef USE_MUTEX
+static void prvMutexStatsTask( void *pvParameters )
+{
+MutexStats_t xStats;
+static char cBuffer[ 250 ];
+
+	for( ;; )
+	{
+		vTaskDelay( pdMS_TO_TICKS( mainSTATS_PERIOD_MS ) );
+
+		/* Take the snapshot before taking the mutex to print it, so this
+		task's own use of the mutex is not part of the report. */
+		xSemaphoreGetMutexStats( xMutex, &xStats );
+
+		sprintf( cBuffer, "Mutex: taken %lu, contended %lu, inherited %lu\r\n"
+						  "  hold total %lu max %lu cycles (%s)\r\n"
+						  "  wait total %lu max %lu cycles (%s waiting on %s)\r\n",
+				( unsigned long ) xStats.uxAcquisitions,
+				( unsigned long ) xStats.uxContendedAcquisitions,
+				( unsigned long ) xStats.uxPriorityInheritances,
+				( unsigned long ) xStats.ulTotalHoldTime,
+				( unsigned long ) xStats.ulMaxHoldTime,
+				( xStats.xMaxHoldTask != NULL ) ? pcTaskGetName( xStats.xMaxHoldTask ) : "-",
+				( unsigned long ) xStats.ulTotalWaitTime,
+				( unsigned long ) xStats.ulMaxWaitTime,
+				( xStats.xMaxWaitTask != NULL ) ? pcTaskGetName( xStats.xMaxWaitTask ) : "-",
+				( xStats.xMaxWaitHolder != NULL ) ? pcTaskGetName( xStats.xMaxWaitHolder ) : "-" );
+
+		/* The report is longer than prvNewPrintString() can buffer, so print
+		it directly while holding the mutex. */
+		xSemaphoreTake( xMutex, portMAX_DELAY );
+		{
+			printmsg( cBuffer );
+		}
+		xSemaphoreGive( xMutex );
+	}
+}
+#endif
+/*-----------------------------------------------------------*/
+
 
 
 
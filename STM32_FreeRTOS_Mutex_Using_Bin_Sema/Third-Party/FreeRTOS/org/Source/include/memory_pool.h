@@ -0,0 +1,312 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef MEMORY_POOL_H
+#define MEMORY_POOL_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include memory_pool.h"
+#endif
+
+/* FreeRTOS includes. */
+#include "semphr.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A memory pool holds a fixed number of blocks that are all the same size.
+ * Allocating a block from a pool and returning it to the pool each take a
+ * constant time, only mask interrupts for a few instructions, and never
+ * suspend the scheduler, so, unlike pvPortMalloc() and vPortFree(), they can
+ * be used from interrupts.  A pool cannot become fragmented.
+ *
+ * A task can optionally wait in the Blocked state for a block to be returned
+ * to an empty pool.  The number of free blocks is held in a counting
+ * semaphore, which is taken before a block is allocated and given after a
+ * block is freed.
+ *
+ * configUSE_MEMORY_POOLS and configUSE_COUNTING_SEMAPHORES must both be set to
+ * 1 in FreeRTOSConfig.h for memory pools to be available.
+ *
+ * \defgroup MemoryPool
+ */
+
+/**
+ * memory_pool.h
+ *
+ * Type by which memory pools are referenced.  For example, a call to
+ * xMemoryPoolCreate() returns a MemoryPoolHandle_t variable that can then be
+ * used as a parameter to other memory pool functions.
+ *
+ * \defgroup MemoryPoolHandle_t MemoryPoolHandle_t
+ * \ingroup MemoryPool
+ */
+struct MemoryPoolDef_t;
+typedef struct MemoryPoolDef_t * MemoryPoolHandle_t;
+
+/**
+ * memory_pool.h
+ *
+ * Used with vMemoryPoolGetStats() to obtain the usage statistics of a memory
+ * pool.
+ *
+ * \ingroup MemoryPool
+ */
+typedef struct xMEMORY_POOL_STATS
+{
+	size_t xBlockSize;						/* The size of each block, after it was rounded up to a multiple of portBYTE_ALIGNMENT. */
+	UBaseType_t uxBlockCount;				/* The total number of blocks in the pool. */
+	UBaseType_t uxFreeBlocks;				/* The number of blocks that are currently free. */
+	UBaseType_t uxMinimumEverFreeBlocks;	/* The lowest number of free blocks there have been since the pool was created. */
+	uint32_t ulAllocations;					/* The number of blocks that have been allocated. */
+	uint32_t ulFailedAllocations;			/* The number of allocations that failed because no block became free in time. */
+	uint32_t ulFrees;						/* The number of blocks that have been freed. */
+} MemoryPoolStats_t;
+
+/*
+ * The size to which the block size of a pool is rounded up - a multiple of
+ * portBYTE_ALIGNMENT that can hold a pointer, which is used to link the free
+ * blocks together.
+ */
+#define memorypoolBLOCK_SIZE( xBlockSize ) ( ( ( ( ( size_t ) ( xBlockSize ) < sizeof( void * ) ) ? sizeof( void * ) : ( size_t ) ( xBlockSize ) ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/*
+ * The number of bytes of storage that must be provided to
+ * xMemoryPoolCreateStatic() to hold uxBlockCount blocks of xBlockSize bytes.
+ */
+#define memorypoolSTORAGE_SIZE( xBlockSize, uxBlockCount ) ( memorypoolBLOCK_SIZE( xBlockSize ) * ( size_t ) ( uxBlockCount ) )
+
+/**
+ * memory_pool.h
+ *<pre>
+ MemoryPoolHandle_t xMemoryPoolCreate( size_t xBlockSize, UBaseType_t uxBlockCount );
+ </pre>
+ *
+ * Create a new memory pool of uxBlockCount blocks, each of which can hold
+ * xBlockSize bytes.  The pool's structure and its blocks are allocated from
+ * the FreeRTOS heap in a single allocation.
+ *
+ * @param xBlockSize The size of each block in bytes.  Blocks are aligned to
+ * portBYTE_ALIGNMENT.
+ *
+ * @param uxBlockCount The number of blocks in the pool.
+ *
+ * @return If the pool was created then its handle is returned.  If there was
+ * insufficient FreeRTOS heap available to create the pool then NULL is
+ * returned.
+ *
+ * Example usage:
+   <pre>
+	typedef struct
+	{
+		uint8_t ucCommand;
+		uint8_t ucArguments[ 10 ];
+	} Command_t;
+
+	MemoryPoolHandle_t xCommandPool;
+
+	void vCreatePool( void )
+	{
+		xCommandPool = xMemoryPoolCreate( sizeof( Command_t ), 8 );
+		configASSERT( xCommandPool );
+	}
+   </pre>
+ * \defgroup xMemoryPoolCreate xMemoryPoolCreate
+ * \ingroup MemoryPool
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	MemoryPoolHandle_t xMemoryPoolCreate( size_t xBlockSize, UBaseType_t uxBlockCount ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * memory_pool.h
+ *<pre>
+ MemoryPoolHandle_t xMemoryPoolCreateStatic( size_t xBlockSize,
+                                             UBaseType_t uxBlockCount,
+                                             uint8_t *pucPoolStorage,
+                                             StaticMemoryPool_t *pxStaticMemoryPool );
+ </pre>
+ *
+ * As xMemoryPoolCreate(), but the memory used by the pool is provided by the
+ * application.
+ *
+ * @param pucPoolStorage An array of at least
+ * memorypoolSTORAGE_SIZE( xBlockSize, uxBlockCount ) bytes, aligned to
+ * portBYTE_ALIGNMENT, that holds the blocks.
+ *
+ * @param pxStaticMemoryPool A variable of type StaticMemoryPool_t, which is
+ * used to hold the pool's data structure.
+ *
+ * @return The handle of the pool.
+ *
+ * \defgroup xMemoryPoolCreateStatic xMemoryPoolCreateStatic
+ * \ingroup MemoryPool
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	MemoryPoolHandle_t xMemoryPoolCreateStatic( size_t xBlockSize, UBaseType_t uxBlockCount, uint8_t *pucPoolStorage, StaticMemoryPool_t *pxStaticMemoryPool ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * memory_pool.h
+ *<pre>
+ void *pvMemoryPoolAlloc( MemoryPoolHandle_t xMemoryPool, TickType_t xTicksToWait );
+ </pre>
+ *
+ * Allocate a block from a memory pool.
+ *
+ * @param xMemoryPool The pool from which the block is allocated.
+ *
+ * @param xTicksToWait The maximum amount of time the task should wait in the
+ * Blocked state for a block to be freed if the pool is empty.  Set to 0 to
+ * return immediately, or portMAX_DELAY to wait indefinitely (provided
+ * INCLUDE_vTaskSuspend is set to 1).
+ *
+ * @return A pointer to the block, or NULL if no block became free within
+ * xTicksToWait.
+ *
+ * Example usage:
+   <pre>
+	void vSendCommand( uint8_t ucCommand )
+	{
+	Command_t *pxCommand;
+
+		pxCommand = pvMemoryPoolAlloc( xCommandPool, portMAX_DELAY );
+		pxCommand->ucCommand = ucCommand;
+		xQueueSend( xCommandQueue, &pxCommand, portMAX_DELAY );
+	}
+   </pre>
+ * \defgroup pvMemoryPoolAlloc pvMemoryPoolAlloc
+ * \ingroup MemoryPool
+ */
+void *pvMemoryPoolAlloc( MemoryPoolHandle_t xMemoryPool, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * memory_pool.h
+ *<pre>
+ void *pvMemoryPoolAllocFromISR( MemoryPoolHandle_t xMemoryPool );
+ </pre>
+ *
+ * A version of pvMemoryPoolAlloc() that can be called from an interrupt
+ * service routine.  It never blocks.
+ *
+ * @return A pointer to the block, or NULL if the pool is empty.
+ *
+ * \defgroup pvMemoryPoolAllocFromISR pvMemoryPoolAllocFromISR
+ * \ingroup MemoryPool
+ */
+void *pvMemoryPoolAllocFromISR( MemoryPoolHandle_t xMemoryPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * memory_pool.h
+ *<pre>
+ void vMemoryPoolFree( MemoryPoolHandle_t xMemoryPool, void *pvBlock );
+ </pre>
+ *
+ * Return a block to the memory pool from which it was allocated.  If a task is
+ * waiting for a block it is unblocked.
+ *
+ * @param xMemoryPool The pool from which the block was allocated.
+ *
+ * @param pvBlock The block being freed.
+ *
+ * \defgroup vMemoryPoolFree vMemoryPoolFree
+ * \ingroup MemoryPool
+ */
+void vMemoryPoolFree( MemoryPoolHandle_t xMemoryPool, void *pvBlock ) PRIVILEGED_FUNCTION;
+
+/**
+ * memory_pool.h
+ *<pre>
+ void vMemoryPoolFreeFromISR( MemoryPoolHandle_t xMemoryPool,
+                              void *pvBlock,
+                              BaseType_t *pxHigherPriorityTaskWoken );
+ </pre>
+ *
+ * A version of vMemoryPoolFree() that can be called from an interrupt service
+ * routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if freeing the block
+ * unblocked a task that has a priority higher than the currently running
+ * task, in which case a context switch should be requested before the
+ * interrupt is exited.
+ *
+ * \defgroup vMemoryPoolFreeFromISR vMemoryPoolFreeFromISR
+ * \ingroup MemoryPool
+ */
+void vMemoryPoolFreeFromISR( MemoryPoolHandle_t xMemoryPool, void *pvBlock, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * memory_pool.h
+ *<pre>
+ UBaseType_t uxMemoryPoolGetFreeBlocks( MemoryPoolHandle_t xMemoryPool );
+ </pre>
+ *
+ * @return The number of blocks that are currently free in the pool.
+ *
+ * \defgroup uxMemoryPoolGetFreeBlocks uxMemoryPoolGetFreeBlocks
+ * \ingroup MemoryPool
+ */
+UBaseType_t uxMemoryPoolGetFreeBlocks( MemoryPoolHandle_t xMemoryPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * memory_pool.h
+ *<pre>
+ void vMemoryPoolGetStats( MemoryPoolHandle_t xMemoryPool, MemoryPoolStats_t *pxStats );
+ </pre>
+ *
+ * Obtain the usage statistics of a memory pool.  The statistics are kept as
+ * blocks are allocated and freed, so this function takes a constant time.
+ *
+ * @param pxStats The structure into which the statistics are written.
+ *
+ * \defgroup vMemoryPoolGetStats vMemoryPoolGetStats
+ * \ingroup MemoryPool
+ */
+void vMemoryPoolGetStats( MemoryPoolHandle_t xMemoryPool, MemoryPoolStats_t *pxStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * memory_pool.h
+ *<pre>
+ void vMemoryPoolDelete( MemoryPoolHandle_t xMemoryPool );
+ </pre>
+ *
+ * Delete a memory pool, freeing its memory if it was created with
+ * xMemoryPoolCreate().  Blocks allocated from the pool must not be used once
+ * the pool has been deleted, and no task may be waiting for a block.
+ *
+ * \defgroup vMemoryPoolDelete vMemoryPoolDelete
+ * \ingroup MemoryPool
+ */
+void vMemoryPoolDelete( MemoryPoolHandle_t xMemoryPool ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MEMORY_POOL_H */
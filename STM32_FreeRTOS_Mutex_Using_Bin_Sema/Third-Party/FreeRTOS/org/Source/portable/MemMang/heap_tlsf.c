@@ -0,0 +1,945 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that uses a two
+ * level segregated fit (TLSF) allocator, so the time taken to allocate and free
+ * memory does not depend on the number of free blocks, and combines adjacent
+ * memory blocks as they are freed.
+ *
+ * Free blocks are held in an array of lists indexed by size class.  The first
+ * level index is the position of the most significant bit of the block size,
+ * and the second level index divides each power of two range into
+ * ( 1 << configTLSF_SL_INDEX_COUNT_LOG2 ) linear classes.  A bitmap records
+ * which lists are not empty, so a suitable list is found with two find first
+ * set operations rather than by walking the free blocks as heap_4.c does.  The
+ * requested size is rounded up to the next class boundary before the search,
+ * so any block in the list found is large enough (a 'good fit').  Each block
+ * references the block physically before it, so a block being freed is merged
+ * with its neighbours without searching for them.
+ *
+ * Set configHEAP_USE_CRITICAL_SECTIONS to 1 to protect the heap by masking
+ * interrupts rather than by suspending the scheduler, which also makes
+ * pvPortMallocFromISR() and vPortFreeFromISR() available.
+ *
+ * Set configUSE_TLSF_HEAP to 1 in FreeRTOSConfig.h to use this file in place of
+ * heap_4.c.  configTLSF_FL_INDEX_MAX sets the size of the largest block that
+ * can be managed, which must not be less than configTOTAL_HEAP_SIZE.
+ *
+ * See heap_4.c for an alternative implementation, and the memory management
+ * pages of http://www.FreeRTOS.org for more information.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* This entire source file will be skipped if the application is configured to
+use heap_4.c.  This #if is closed at the very bottom of this file. */
+#if( configUSE_TLSF_HEAP == 1 )
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+/* The number of bits used to hold the alignment. */
+#if portBYTE_ALIGNMENT == 32
+	#define heapALIGNMENT_LOG2	5
+#elif portBYTE_ALIGNMENT == 16
+	#define heapALIGNMENT_LOG2	4
+#elif portBYTE_ALIGNMENT == 8
+	#define heapALIGNMENT_LOG2	3
+#elif portBYTE_ALIGNMENT == 4
+	#define heapALIGNMENT_LOG2	2
+#else
+	#error heap_tlsf.c requires portBYTE_ALIGNMENT to be 4, 8, 16 or 32
+#endif
+
+/* Blocks smaller than heapSMALL_BLOCK_SIZE are all held in first level list 0,
+in second level lists that are portBYTE_ALIGNMENT bytes apart.  Larger blocks
+are held in first level list ( n - heapFL_INDEX_SHIFT + 1 ), where n is the
+position of the most significant bit of their size. */
+#define heapSL_INDEX_COUNT		( 1UL << configTLSF_SL_INDEX_COUNT_LOG2 )
+#define heapFL_INDEX_SHIFT		( configTLSF_SL_INDEX_COUNT_LOG2 + heapALIGNMENT_LOG2 )
+#define heapFL_INDEX_COUNT		( configTLSF_FL_INDEX_MAX - heapFL_INDEX_SHIFT + 2 )
+#define heapSMALL_BLOCK_SIZE	( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+
+#if( ( configTLSF_SL_INDEX_COUNT_LOG2 < 1 ) || ( configTLSF_SL_INDEX_COUNT_LOG2 > 5 ) )
+	#error configTLSF_SL_INDEX_COUNT_LOG2 must be between 1 and 5
+#endif
+
+#if( ( configTLSF_FL_INDEX_MAX < heapFL_INDEX_SHIFT ) || ( configTLSF_FL_INDEX_MAX > 30 ) )
+	#error configTLSF_FL_INDEX_MAX must be at least configTLSF_SL_INDEX_COUNT_LOG2 plus the log2 of portBYTE_ALIGNMENT, and no more than 30
+#endif
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE		( ( size_t ) 8 )
+
+/* vPortGetHeapStats() counts free blocks of less than heapSTATS_FIRST_CLASS_LIMIT
+bytes in the first size class, and doubles the limit for each class after it. */
+#define heapSTATS_FIRST_CLASS_LIMIT	( ( size_t ) 32 )
+
+/* The time taken to allocate or free a block is bounded, so if
+configHEAP_USE_CRITICAL_SECTIONS is 1 the heap is protected by masking
+interrupts for the whole operation rather than by suspending the scheduler. */
+#if( configHEAP_USE_CRITICAL_SECTIONS == 1 )
+	#define heapLOCK()		taskENTER_CRITICAL()
+	#define heapUNLOCK()	taskEXIT_CRITICAL()
+#else
+	#define heapLOCK()		vTaskSuspendAll()
+	#define heapUNLOCK()	( void ) xTaskResumeAll()
+#endif
+
+/* Allocate the memory for the heap. */
+#if( configAPPLICATION_ALLOCATED_HEAP == 1 )
+	/* The application writer has already defined the array used for the RTOS
+	heap - probably so it can be placed in a special segment or address. */
+	extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+	static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+/* Define the structure placed at the start of each block.  Every block holds
+pxPrevPhysBlock and xBlockSize.  pxNextFreeBlock and pxPrevFreeBlock are only
+used while the block is free, so they occupy the start of the memory returned
+to the application when the block is allocated. */
+typedef struct A_TLSF_BLOCK
+{
+	struct A_TLSF_BLOCK *pxPrevPhysBlock;	/*<< The block immediately before this one in memory, or NULL if this is the first block. */
+	size_t xBlockSize;						/*<< The size of the block, including this structure. */
+	struct A_TLSF_BLOCK *pxNextFreeBlock;	/*<< The next block in the same free list. */
+	struct A_TLSF_BLOCK *pxPrevFreeBlock;	/*<< The previous block in the same free list. */
+} TLSFBlock_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called automatically to setup the required heap structures the first time
+ * pvPortMalloc() is called.
+ */
+static void prvHeapInit( void );
+
+/*
+ * Allocate a block of at least xWantedSize bytes, or return a block to the
+ * free lists, merging it with its neighbours.  The caller must hold the heap
+ * lock.
+ */
+static void *prvAllocate( size_t xWantedSize );
+static void prvFree( TLSFBlock_t *pxLink );
+
+/*
+ * Returns the position of the most significant set bit in ulValue, which must
+ * not be zero.
+ */
+static UBaseType_t prvFindLastSet( uint32_t ulValue );
+
+/*
+ * Returns the first and second level list indexes of the list that holds free
+ * blocks of xBlockSize bytes.
+ */
+static void prvMappingInsert( size_t xBlockSize, UBaseType_t *puxFLIndex, UBaseType_t *puxSLIndex );
+
+/*
+ * Returns the first and second level list indexes from which the search for a
+ * free block of at least xBlockSize bytes starts.  Any block held in that list,
+ * or in a later one, is large enough.
+ */
+static void prvMappingSearch( size_t xBlockSize, UBaseType_t *puxFLIndex, UBaseType_t *puxSLIndex );
+
+/*
+ * Removes and returns a free block from the first non empty list at or after
+ * the list indexed by uxFLIndex and uxSLIndex, or returns NULL if there is no
+ * such list.
+ */
+static TLSFBlock_t *prvRemoveSuitableBlock( UBaseType_t uxFLIndex, UBaseType_t uxSLIndex );
+
+/*
+ * Inserts a free block into, or removes it from, the list for its size.
+ */
+static void prvInsertBlockIntoFreeList( TLSFBlock_t *pxBlockToInsert );
+static void prvRemoveBlockFromFreeList( TLSFBlock_t *pxBlockToRemove );
+
+/*
+ * Adds a free block of xBlockSize bytes to the statistics being gathered by
+ * vPortGetHeapStats().
+ */
+static void prvCountFreeBlock( HeapStats_t *pxHeapStats, size_t xBlockSize );
+
+/*-----------------------------------------------------------*/
+
+/* The size of the structure placed at the beginning of each allocated memory
+block must by correctly byte aligned.  Only the first two members are present
+in allocated blocks. */
+static const size_t xHeapStructSize	= ( ( size_t ) offsetof( TLSFBlock_t, pxNextFreeBlock ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* Blocks must be able to hold all the members of TLSFBlock_t once freed. */
+static const size_t xMinimumBlockSize = ( sizeof( TLSFBlock_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The heads of the free lists, and bitmaps of which lists are not empty.  Bit n
+of ulFLBitmap is set if any bit of ulSLBitmap[ n ] is set, and bit m of
+ulSLBitmap[ n ] is set if pxFreeLists[ n ][ m ] is not NULL. */
+static TLSFBlock_t *pxFreeLists[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+static uint32_t ulFLBitmap = 0UL;
+static uint32_t ulSLBitmap[ heapFL_INDEX_COUNT ];
+
+/* Marks the end of the heap.  It is permanently allocated, so the last real
+block is never merged with it. */
+static TLSFBlock_t *pxEnd = NULL;
+
+/* Keeps track of the number of free bytes remaining, but says nothing about
+fragmentation. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+
+/* Gets set to the top bit of an size_t type.  When this bit in the xBlockSize
+member of an TLSFBlock_t structure is set then the block belongs to the
+application.  When the bit is free the block is still part of the free heap
+space. */
+static size_t xBlockAllocatedBit = 0;
+
+/* Counts of the blocks allocated and freed, reported by vPortGetHeapStats(). */
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfSuccessfulFrees = 0;
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+void *pvReturn;
+
+	heapLOCK();
+	{
+		pvReturn = prvAllocate( xWantedSize );
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	heapUNLOCK();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if( configHEAP_USE_CRITICAL_SECTIONS == 1 )
+
+	void *pvPortMallocFromISR( size_t xWantedSize )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+	void *pvReturn;
+
+		/* Allocating a block takes a bounded time, so any size can be
+		allocated from an interrupt. */
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			pvReturn = prvAllocate( xWantedSize );
+			traceMALLOC_FROM_ISR( pvReturn, xWantedSize );
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return pvReturn;
+	}
+
+#endif /* configHEAP_USE_CRITICAL_SECTIONS */
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+uint8_t *puc = ( uint8_t * ) pv;
+TLSFBlock_t *pxLink;
+
+	if( pv != NULL )
+	{
+		/* The memory being freed will have the block header immediately
+		before it. */
+		puc -= xHeapStructSize;
+
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxLink = ( void * ) puc;
+
+		/* The allocated bit is what a free of a neighbouring block looks at
+		to decide whether to merge with this block, so it is only checked and
+		cleared while the heap is locked. */
+		heapLOCK();
+		{
+			/* Check the block is actually allocated. */
+			configASSERT( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 );
+
+			if( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 )
+			{
+				/* The block is being returned to the heap - it is no longer
+				allocated. */
+				pxLink->xBlockSize &= ~xBlockAllocatedBit;
+
+				traceFREE( pv, pxLink->xBlockSize );
+				prvFree( pxLink );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		heapUNLOCK();
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if( configHEAP_USE_CRITICAL_SECTIONS == 1 )
+
+	void vPortFreeFromISR( void *pv )
+	{
+	uint8_t *puc = ( uint8_t * ) pv;
+	TLSFBlock_t *pxLink;
+	UBaseType_t uxSavedInterruptStatus;
+
+		if( pv != NULL )
+		{
+			puc -= xHeapStructSize;
+			pxLink = ( void * ) puc;
+
+			/* Freeing a block takes a bounded time, so any block can be freed
+			from an interrupt.  As in vPortFree() the allocated bit is only
+			checked and cleared with interrupts masked. */
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				/* Check the block is actually allocated. */
+				configASSERT( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 );
+
+				if( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 )
+				{
+					pxLink->xBlockSize &= ~xBlockAllocatedBit;
+
+					traceFREE( pv, pxLink->xBlockSize );
+					prvFree( pxLink );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xPortReserveSmallBlocks( size_t xWantedSize, UBaseType_t uxCount )
+	{
+		/* Any free block can be allocated from an interrupt, so nothing needs
+		to be set aside. */
+		( void ) xWantedSize;
+		( void ) uxCount;
+
+		return pdPASS;
+	}
+
+#endif /* configHEAP_USE_CRITICAL_SECTIONS */
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t *pxHeapStats )
+{
+TLSFBlock_t *pxBlock;
+UBaseType_t uxFLIndex, uxSLIndex, uxClass;
+
+	pxHeapStats->xSizeOfLargestFreeBlockInBytes = 0;
+	pxHeapStats->xSizeOfSmallestFreeBlockInBytes = 0;
+	pxHeapStats->xNumberOfFreeBlocks = 0;
+
+	for( uxClass = 0; uxClass < ( UBaseType_t ) portHEAP_STATS_SIZE_CLASSES; uxClass++ )
+	{
+		pxHeapStats->xFreeBlocksBySize[ uxClass ] = 0;
+	}
+
+	/* The heap is only locked while one free list is walked, so allocations
+	and frees are not held up for the time taken to walk every free block.
+	Lists the bitmap shows to be empty are skipped without locking the heap. */
+	for( uxFLIndex = 0; uxFLIndex < ( UBaseType_t ) heapFL_INDEX_COUNT; uxFLIndex++ )
+	{
+		for( uxSLIndex = 0; uxSLIndex < ( UBaseType_t ) heapSL_INDEX_COUNT; uxSLIndex++ )
+		{
+			if( ( ulSLBitmap[ uxFLIndex ] & ( 1UL << uxSLIndex ) ) != 0UL )
+			{
+				heapLOCK();
+				{
+					for( pxBlock = pxFreeLists[ uxFLIndex ][ uxSLIndex ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+					{
+						prvCountFreeBlock( pxHeapStats, pxBlock->xBlockSize );
+					}
+				}
+				heapUNLOCK();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+
+	taskENTER_CRITICAL();
+	{
+		pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+		pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+		pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+		pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void *prvAllocate( size_t xWantedSize )
+{
+TLSFBlock_t *pxBlock, *pxNewBlock, *pxNextBlock;
+UBaseType_t uxFLIndex, uxSLIndex;
+void *pvReturn = NULL;
+
+	/* If this is the first call to malloc then the heap will require
+	initialisation to setup the list of free blocks. */
+	if( pxEnd == NULL )
+	{
+		prvHeapInit();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Check the requested block size is not so large that the top bit is
+	set.  The top bit of the block size member of the TLSFBlock_t structure
+	is used to determine who owns the block - the application or the
+	kernel, so it must be free. */
+	if( ( xWantedSize & xBlockAllocatedBit ) == 0 )
+	{
+		/* The wanted size is increased so it can contain the block header
+		in addition to the requested amount of bytes. */
+		if( xWantedSize > 0 )
+		{
+			xWantedSize += xHeapStructSize;
+
+			/* Ensure that blocks are always aligned to the required number
+			of bytes. */
+			if( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) != 0x00 )
+			{
+				/* Byte alignment required. */
+				xWantedSize += ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) );
+				configASSERT( ( xWantedSize & portBYTE_ALIGNMENT_MASK ) == 0 );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* The block must be able to hold the free list links when it
+			is freed again. */
+			if( xWantedSize < xMinimumBlockSize )
+			{
+				xWantedSize = xMinimumBlockSize;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+		{
+			/* Find the list holding the smallest blocks that are all
+			guaranteed to be large enough, then take a block from that list
+			or from the next non empty list after it. */
+			prvMappingSearch( xWantedSize, &uxFLIndex, &uxSLIndex );
+
+			if( uxFLIndex < ( UBaseType_t ) heapFL_INDEX_COUNT )
+			{
+				pxBlock = prvRemoveSuitableBlock( uxFLIndex, uxSLIndex );
+			}
+			else
+			{
+				/* Larger than the largest block that can exist. */
+				pxBlock = NULL;
+			}
+
+			if( pxBlock == NULL )
+			{
+				/* No list holds blocks that are all large enough, but the
+				block at the head of the list that xWantedSize itself maps
+				to might be, which matters when a large part of the
+				remaining heap is requested. */
+				prvMappingInsert( xWantedSize, &uxFLIndex, &uxSLIndex );
+
+				if( ( uxFLIndex < ( UBaseType_t ) heapFL_INDEX_COUNT ) && ( pxFreeLists[ uxFLIndex ][ uxSLIndex ] != NULL ) && ( pxFreeLists[ uxFLIndex ][ uxSLIndex ]->xBlockSize >= xWantedSize ) )
+				{
+					pxBlock = pxFreeLists[ uxFLIndex ][ uxSLIndex ];
+					prvRemoveBlockFromFreeList( pxBlock );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( pxBlock != NULL )
+			{
+				configASSERT( pxBlock->xBlockSize >= xWantedSize );
+
+				/* Return the memory space pointed to - jumping over the
+				block header at its start. */
+				pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+				xNumberOfSuccessfulAllocations++;
+
+				/* If the block is larger than required it can be split into
+				two. */
+				if( ( pxBlock->xBlockSize - xWantedSize ) >= xMinimumBlockSize )
+				{
+					/* This block is to be split into two.  Create a new
+					block following the number of bytes requested. The void
+					cast is used to prevent byte alignment warnings from the
+					compiler. */
+					pxNewBlock = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+					configASSERT( ( ( ( size_t ) pxNewBlock ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+					/* Calculate the sizes of two blocks split from the
+					single block, and link the new block into the physical
+					order of the blocks. */
+					pxNewBlock->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+					pxNewBlock->pxPrevPhysBlock = pxBlock;
+					pxBlock->xBlockSize = xWantedSize;
+					pxNextBlock = ( void * ) ( ( ( uint8_t * ) pxNewBlock ) + pxNewBlock->xBlockSize );
+					pxNextBlock->pxPrevPhysBlock = pxNewBlock;
+
+					/* The block after the new block cannot be free, as
+					free blocks are always merged, so the new block is
+					inserted into the free lists as it is. */
+					prvInsertBlockIntoFreeList( pxNewBlock );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+				if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+				{
+					xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* The block is being returned - it is allocated and owned
+				by the application. */
+				pxBlock->xBlockSize |= xBlockAllocatedBit;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvFree( TLSFBlock_t *pxLink )
+{
+TLSFBlock_t *pxNeighbour;
+
+	xFreeBytesRemaining += pxLink->xBlockSize;
+
+	/* Merge the block with the block after it if that block is
+	free.  The end marker is always allocated. */
+	pxNeighbour = ( void * ) ( ( ( uint8_t * ) pxLink ) + pxLink->xBlockSize );
+
+	if( ( pxNeighbour->xBlockSize & xBlockAllocatedBit ) == 0 )
+	{
+		prvRemoveBlockFromFreeList( pxNeighbour );
+		pxLink->xBlockSize += pxNeighbour->xBlockSize;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Merge the block with the block before it if that block is
+	free. */
+	pxNeighbour = pxLink->pxPrevPhysBlock;
+
+	if( ( pxNeighbour != NULL ) && ( ( pxNeighbour->xBlockSize & xBlockAllocatedBit ) == 0 ) )
+	{
+		prvRemoveBlockFromFreeList( pxNeighbour );
+		pxNeighbour->xBlockSize += pxLink->xBlockSize;
+		pxLink = pxNeighbour;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* The block after the merged block must reference it as the
+	block before it. */
+	pxNeighbour = ( void * ) ( ( ( uint8_t * ) pxLink ) + pxLink->xBlockSize );
+	pxNeighbour->pxPrevPhysBlock = pxLink;
+
+	/* Add the merged block to the list of free blocks of its
+	size. */
+	prvInsertBlockIntoFreeList( pxLink );
+	xNumberOfSuccessfulFrees++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCountFreeBlock( HeapStats_t *pxHeapStats, size_t xBlockSize )
+{
+UBaseType_t uxClass = 0;
+
+	if( ( pxHeapStats->xNumberOfFreeBlocks == ( size_t ) 0 ) || ( xBlockSize < pxHeapStats->xSizeOfSmallestFreeBlockInBytes ) )
+	{
+		pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xBlockSize;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( xBlockSize > pxHeapStats->xSizeOfLargestFreeBlockInBytes )
+	{
+		pxHeapStats->xSizeOfLargestFreeBlockInBytes = xBlockSize;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Find the size class of the block.  The last class also holds all the
+	blocks that are larger than the classes before it. */
+	while( ( uxClass < ( ( UBaseType_t ) portHEAP_STATS_SIZE_CLASSES - ( UBaseType_t ) 1 ) ) && ( xBlockSize >= ( heapSTATS_FIRST_CLASS_LIMIT << uxClass ) ) )
+	{
+		uxClass++;
+	}
+
+	pxHeapStats->xFreeBlocksBySize[ uxClass ]++;
+	pxHeapStats->xNumberOfFreeBlocks++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void )
+{
+TLSFBlock_t *pxFirstFreeBlock;
+uint8_t *pucAlignedHeap;
+size_t uxAddress;
+size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
+
+	/* Ensure the heap starts on a correctly aligned boundary. */
+	uxAddress = ( size_t ) ucHeap;
+
+	if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+	{
+		uxAddress += ( portBYTE_ALIGNMENT - 1 );
+		uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		xTotalHeapSize -= uxAddress - ( size_t ) ucHeap;
+	}
+
+	pucAlignedHeap = ( uint8_t * ) uxAddress;
+
+	/* pxEnd is used to mark the end of the heap space.  It only needs to hold
+	the members that are present in allocated blocks. */
+	uxAddress = ( ( size_t ) pucAlignedHeap ) + xTotalHeapSize;
+	uxAddress -= xHeapStructSize;
+	uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+	pxEnd = ( void * ) uxAddress;
+
+	/* To start with there is a single free block that is sized to take up the
+	entire heap space, minus the space taken by pxEnd. */
+	pxFirstFreeBlock = ( void * ) pucAlignedHeap;
+	pxFirstFreeBlock->xBlockSize = uxAddress - ( size_t ) pxFirstFreeBlock;
+	pxFirstFreeBlock->pxPrevPhysBlock = NULL;
+
+	/* configTLSF_FL_INDEX_MAX must be large enough for the whole heap to be
+	held in a single block. */
+	configASSERT( prvFindLastSet( ( uint32_t ) pxFirstFreeBlock->xBlockSize ) <= ( UBaseType_t ) configTLSF_FL_INDEX_MAX );
+
+	/* Work out the position of the top bit in a size_t variable. */
+	xBlockAllocatedBit = ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 );
+
+	/* The end marker is permanently allocated. */
+	pxEnd->xBlockSize = xBlockAllocatedBit;
+	pxEnd->pxPrevPhysBlock = pxFirstFreeBlock;
+
+	prvInsertBlockIntoFreeList( pxFirstFreeBlock );
+
+	/* Only one block exists - and it covers the entire usable heap space. */
+	xMinimumEverFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+	xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindLastSet( uint32_t ulValue )
+{
+UBaseType_t uxBit;
+
+	configASSERT( ulValue != 0UL );
+
+	#if defined( __GNUC__ )
+	{
+		/* Compiles to a single count leading zeros instruction where the
+		architecture has one. */
+		uxBit = ( UBaseType_t ) ( 31 - __builtin_clz( ulValue ) );
+	}
+	#else
+	{
+		uxBit = ( UBaseType_t ) 0;
+
+		while( ulValue > 1UL )
+		{
+			ulValue >>= 1UL;
+			uxBit++;
+		}
+	}
+	#endif
+
+	return uxBit;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingInsert( size_t xBlockSize, UBaseType_t *puxFLIndex, UBaseType_t *puxSLIndex )
+{
+UBaseType_t uxBit;
+
+	if( xBlockSize < heapSMALL_BLOCK_SIZE )
+	{
+		/* Small blocks are held in linear classes portBYTE_ALIGNMENT bytes
+		apart. */
+		*puxFLIndex = ( UBaseType_t ) 0;
+		*puxSLIndex = ( UBaseType_t ) ( xBlockSize >> heapALIGNMENT_LOG2 );
+	}
+	else
+	{
+		/* The second level index is taken from the bits below the most
+		significant bit. */
+		uxBit = prvFindLastSet( ( uint32_t ) xBlockSize );
+		*puxSLIndex = ( UBaseType_t ) ( ( xBlockSize >> ( uxBit - ( UBaseType_t ) configTLSF_SL_INDEX_COUNT_LOG2 ) ) ^ heapSL_INDEX_COUNT );
+		*puxFLIndex = uxBit - ( ( UBaseType_t ) heapFL_INDEX_SHIFT - ( UBaseType_t ) 1 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingSearch( size_t xBlockSize, UBaseType_t *puxFLIndex, UBaseType_t *puxSLIndex )
+{
+	if( xBlockSize >= heapSMALL_BLOCK_SIZE )
+	{
+		/* Round up to the next second level class boundary, so every block in
+		the list found is at least xBlockSize bytes. */
+		xBlockSize += ( ( size_t ) 1 << ( prvFindLastSet( ( uint32_t ) xBlockSize ) - ( UBaseType_t ) configTLSF_SL_INDEX_COUNT_LOG2 ) ) - ( size_t ) 1;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	prvMappingInsert( xBlockSize, puxFLIndex, puxSLIndex );
+}
+/*-----------------------------------------------------------*/
+
+static TLSFBlock_t *prvRemoveSuitableBlock( UBaseType_t uxFLIndex, UBaseType_t uxSLIndex )
+{
+TLSFBlock_t *pxBlock = NULL;
+uint32_t ulMap;
+
+	/* Look for a non empty list in the same first level range, at or after the
+	second level index. */
+	ulMap = ulSLBitmap[ uxFLIndex ] & ( ~0UL << uxSLIndex );
+
+	if( ulMap == 0UL )
+	{
+		/* There is none, so look for the first non empty first level range
+		after this one.  Any block in it is large enough. */
+		ulMap = ulFLBitmap & ( ~0UL << ( uxFLIndex + ( UBaseType_t ) 1 ) );
+
+		if( ulMap != 0UL )
+		{
+			uxFLIndex = prvFindLastSet( ulMap & ( ~ulMap + 1UL ) );
+			ulMap = ulSLBitmap[ uxFLIndex ];
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( ulMap != 0UL )
+	{
+		/* Take the block at the head of the lowest non empty list. */
+		uxSLIndex = prvFindLastSet( ulMap & ( ~ulMap + 1UL ) );
+		pxBlock = pxFreeLists[ uxFLIndex ][ uxSLIndex ];
+		configASSERT( pxBlock != NULL );
+		prvRemoveBlockFromFreeList( pxBlock );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList( TLSFBlock_t *pxBlockToInsert )
+{
+UBaseType_t uxFLIndex, uxSLIndex;
+TLSFBlock_t *pxHead;
+
+	prvMappingInsert( pxBlockToInsert->xBlockSize, &uxFLIndex, &uxSLIndex );
+
+	/* Insert the block at the head of its list and mark the list as not
+	empty. */
+	pxHead = pxFreeLists[ uxFLIndex ][ uxSLIndex ];
+	pxBlockToInsert->pxNextFreeBlock = pxHead;
+	pxBlockToInsert->pxPrevFreeBlock = NULL;
+
+	if( pxHead != NULL )
+	{
+		pxHead->pxPrevFreeBlock = pxBlockToInsert;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxFreeLists[ uxFLIndex ][ uxSLIndex ] = pxBlockToInsert;
+	ulFLBitmap |= ( 1UL << uxFLIndex );
+	ulSLBitmap[ uxFLIndex ] |= ( 1UL << uxSLIndex );
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveBlockFromFreeList( TLSFBlock_t *pxBlockToRemove )
+{
+UBaseType_t uxFLIndex, uxSLIndex;
+
+	prvMappingInsert( pxBlockToRemove->xBlockSize, &uxFLIndex, &uxSLIndex );
+
+	if( pxBlockToRemove->pxNextFreeBlock != NULL )
+	{
+		pxBlockToRemove->pxNextFreeBlock->pxPrevFreeBlock = pxBlockToRemove->pxPrevFreeBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxBlockToRemove->pxPrevFreeBlock != NULL )
+	{
+		pxBlockToRemove->pxPrevFreeBlock->pxNextFreeBlock = pxBlockToRemove->pxNextFreeBlock;
+	}
+	else
+	{
+		/* The block was at the head of its list.  If the list is now empty
+		then clear its bit, and the first level bit if the whole first level
+		range is now empty. */
+		configASSERT( pxFreeLists[ uxFLIndex ][ uxSLIndex ] == pxBlockToRemove );
+		pxFreeLists[ uxFLIndex ][ uxSLIndex ] = pxBlockToRemove->pxNextFreeBlock;
+
+		if( pxBlockToRemove->pxNextFreeBlock == NULL )
+		{
+			ulSLBitmap[ uxFLIndex ] &= ~( 1UL << uxSLIndex );
+
+			if( ulSLBitmap[ uxFLIndex ] == 0UL )
+			{
+				ulFLBitmap &= ~( 1UL << uxFLIndex );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is configured to
+use heap_4.c.  If you want to use this allocator then ensure configUSE_TLSF_HEAP
+is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_TLSF_HEAP == 1 */
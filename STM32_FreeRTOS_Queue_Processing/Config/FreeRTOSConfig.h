@@ -57,6 +57,12 @@ extern void vApplicationMallocFailedHook( void );
 #define configMAX_PRIORITIES			( 5 )
 #define configMINIMAL_STACK_SIZE		( ( unsigned short ) 130 )
 #define configTOTAL_HEAP_SIZE			( ( size_t ) ( 75 * 1024 ) )
+#define configUSE_TLSF_HEAP				1
+#define configUSE_MEMORY_POOLS			1
+#define configUSE_SLAB_CACHES			1
+#define configSLAB_CACHE_TASKS			6
+#define configSLAB_CACHE_QUEUES			4
+#define configSLAB_CACHE_TIMERS			1
 #define configMAX_TASK_NAME_LEN			( 10 )
 #define configUSE_TRACE_FACILITY		1
 #define configUSE_16_BIT_TICKS			0
@@ -69,6 +75,7 @@ extern void vApplicationMallocFailedHook( void );
 #define configUSE_APPLICATION_TASK_TAG	0
 #define configUSE_COUNTING_SEMAPHORES	1
 #define configGENERATE_RUN_TIME_STATS	0
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES	2
 
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES 		0
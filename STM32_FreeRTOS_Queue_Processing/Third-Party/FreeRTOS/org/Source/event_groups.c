@@ -38,6 +38,7 @@ task.h is included from an application file. */
 #include "task.h"
 #include "timers.h"
 #include "event_groups.h"
+#include "slab.h"
 
 /* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
 because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
@@ -53,11 +54,29 @@ taskEVENT_LIST_ITEM_VALUE_IN_USE definition. */
 	#define eventUNBLOCKED_DUE_TO_BIT_SET	0x0200U
 	#define eventWAIT_FOR_ALL_BITS			0x0400U
 	#define eventEVENT_BITS_CONTROL_BYTES	0xff00U
+	#define eventNUMBER_OF_EVENT_BITS		8U
 #else
 	#define eventCLEAR_EVENTS_ON_EXIT_BIT	0x01000000UL
 	#define eventUNBLOCKED_DUE_TO_BIT_SET	0x02000000UL
 	#define eventWAIT_FOR_ALL_BITS			0x04000000UL
 	#define eventEVENT_BITS_CONTROL_BYTES	0xff000000UL
+	#define eventNUMBER_OF_EVENT_BITS		24U
+#endif
+
+#if( ( configUSE_DIRECT_EVENT_GROUP_SET_FROM_ISR == 1 ) && ( ( configUSE_TIMERS != 1 ) || ( INCLUDE_xTimerPendFunctionCall != 1 ) ) )
+	/* xEventGroupSetBitsFromISR() still uses the timer task when it cannot
+	set the bits directly. */
+	#error configUSE_DIRECT_EVENT_GROUP_SET_FROM_ISR requires configUSE_TIMERS and INCLUDE_xTimerPendFunctionCall to be set to 1
+#endif
+
+/* Dynamically allocated event groups come from their slab cache if slab caches
+are used, otherwise from the FreeRTOS heap. */
+#if( configUSE_SLAB_CACHES == 1 )
+	#define prvAllocateEventGroup()				( ( EventGroup_t * ) pvSlabAlloc( eSlabCacheEventGroup ) )
+	#define prvFreeEventGroup( pxEventBits )	vSlabFree( eSlabCacheEventGroup, ( pxEventBits ) )
+#else
+	#define prvAllocateEventGroup()				( ( EventGroup_t * ) pvPortMalloc( sizeof( EventGroup_t ) ) ) /*lint !e9087 !e9079 see comment in xEventGroupCreate(). */
+	#define prvFreeEventGroup( pxEventBits )	vPortFree( pxEventBits )
 #endif
 
 typedef struct EventGroupDef_t
@@ -65,10 +84,18 @@ typedef struct EventGroupDef_t
 	EventBits_t uxEventBits;
 	List_t xTasksWaitingForBits;		/*< List of tasks waiting for a bit to be set. */
 
+	#if( configUSE_EVENT_GROUP_BIT_INDEXED_WAITERS == 1 )
+		List_t xTasksWaitingForBit[ eventNUMBER_OF_EVENT_BITS ];	/*< Tasks indexed by a bit that must be set before their wait condition can be met.  xTasksWaitingForBits then only holds tasks waiting for any one of several bits. */
+	#endif
+
 	#if( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxEventGroupNumber;
 	#endif
 
+	#if( configUSE_DIRECT_EVENT_GROUP_SET_FROM_ISR == 1 )
+		UBaseType_t uxSetsDeferred;		/*< The number of xEventGroupSetBitsFromISR() calls the timer task has still to execute. */
+	#endif
+
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the event group is statically allocated to ensure no attempt is made to free the memory. */
 	#endif
@@ -86,6 +113,70 @@ typedef struct EventGroupDef_t
  */
 static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, const EventBits_t uxBitsToWaitFor, const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Initialise the list, or lists, used to hold the tasks that are blocked on
+ * the event group.
+ */
+static void prvInitialiseWaitingLists( EventGroup_t *pxEventBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Set uxBitsToSet, unblock the tasks whose wait condition is then met, and
+ * clear any bits the unblocked tasks requested to be cleared on exit.  Called
+ * with the scheduler suspended, or from xEventGroupSetBitsFromISR().
+ */
+static void prvSetBitsAndUnblockTasks( EventGroup_t *pxEventBits, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock the tasks in pxList whose wait condition is met by the current event
+ * bits.  Returns the bits that must be cleared because a task that was
+ * unblocked specified that its bits should be cleared on exit.  If
+ * pxHigherPriorityTaskWoken is NULL the function is being called from a task
+ * with the scheduler suspended, otherwise it is set to pdTRUE if an unblocked
+ * task has a priority above that of the running task.
+ */
+static EventBits_t prvUnblockWaitingTasks( EventGroup_t *pxEventBits, List_t const *pxList, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock every task in pxTasksWaitingForBits - used when the event group is
+ * deleted.
+ */
+static void prvUnblockAllWaitingTasks( const List_t *pxTasksWaitingForBits ) PRIVILEGED_FUNCTION;
+
+#if( configUSE_DIRECT_EVENT_GROUP_SET_FROM_ISR == 1 )
+
+	/*
+	 * Return the number of tasks prvSetBitsAndUnblockTasks() would visit when
+	 * setting uxBitsToSet, or uxLimit if the number is greater than uxLimit.
+	 */
+	static UBaseType_t prvCountTasksToVisit( EventGroup_t const *pxEventBits, const EventBits_t uxBitsToSet, const UBaseType_t uxLimit ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Executed by the timer task to set the bits an xEventGroupSetBitsFromISR()
+	 * call could not set directly.
+	 */
+	static void prvSetBitsDeferredCallback( void *pvEventGroup, const uint32_t ulBitsToSet ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if( configUSE_EVENT_GROUP_BIT_INDEXED_WAITERS == 1 )
+
+	/*
+	 * Return the list a task that is about to block with event list item value
+	 * uxEventListItemValue should be placed on.  A task waiting for a single
+	 * bit, or for all of a set of bits, is indexed by a bit that is not yet set,
+	 * so xEventGroupSetBits() only has to visit it when that bit is set.  A task
+	 * waiting for any one of several bits cannot be indexed by a single bit so
+	 * is placed on xTasksWaitingForBits, which is checked on every set.
+	 */
+	static List_t *prvGetWaitingList( EventGroup_t *pxEventBits, const EventBits_t uxEventListItemValue ) PRIVILEGED_FUNCTION;
+
+#else
+
+	/* Without bit indexing all the blocked tasks are held in the same list. */
+	#define prvGetWaitingList( pxEventBits, uxEventListItemValue ) ( &( ( pxEventBits )->xTasksWaitingForBits ) )
+
+#endif /* configUSE_EVENT_GROUP_BIT_INDEXED_WAITERS */
+
 /*-----------------------------------------------------------*/
 
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -113,7 +204,13 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 		if( pxEventBits != NULL )
 		{
 			pxEventBits->uxEventBits = 0;
-			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+			prvInitialiseWaitingLists( pxEventBits );
+
+			#if( configUSE_DIRECT_EVENT_GROUP_SET_FROM_ISR == 1 )
+			{
+				pxEventBits->uxSetsDeferred = 0;
+			}
+			#endif
 
 			#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 			{
@@ -159,12 +256,18 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits, co
 		sizeof( TickType_t ), the TickType_t variables will be accessed in two
 		or more reads operations, and the alignment requirements is only that
 		of each individual read. */
-		pxEventBits = ( EventGroup_t * ) pvPortMalloc( sizeof( EventGroup_t ) ); /*lint !e9087 !e9079 see comment above. */
+		pxEventBits = prvAllocateEventGroup();
 
 		if( pxEventBits != NULL )
 		{
 			pxEventBits->uxEventBits = 0;
-			vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+			prvInitialiseWaitingLists( pxEventBits );
+
+			#if( configUSE_DIRECT_EVENT_GROUP_SET_FROM_ISR == 1 )
+			{
+				pxEventBits->uxSetsDeferred = 0;
+			}
+			#endif
 
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
@@ -229,7 +332,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 				/* Store the bits that the calling task is waiting for in the
 				task's event list item so the kernel knows when a match is
 				found.  Then enter the blocked state. */
-				vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+				vTaskPlaceOnUnorderedEventList( prvGetWaitingList( pxEventBits, ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ) ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
 
 				/* This assignment is obsolete as uxReturn will get set after
 				the task unblocks, but some compilers mistakenly generate a
@@ -384,7 +487,7 @@ BaseType_t xTimeoutOccurred = pdFALSE;
 			/* Store the bits that the calling task is waiting for in the
 			task's event list item so the kernel knows when a match is
 			found.  Then enter the blocked state. */
-			vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+			vTaskPlaceOnUnorderedEventList( prvGetWaitingList( pxEventBits, ( uxBitsToWaitFor | uxControlBits ) ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
 
 			/* This is obsolete as it will get set after the task unblocks, but
 			some compilers mistakenly generate a warning about the variable
@@ -518,91 +621,18 @@ EventBits_t uxReturn;
 
 EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet )
 {
-ListItem_t *pxListItem, *pxNext;
-ListItem_t const *pxListEnd;
-List_t const * pxList;
-EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
 EventGroup_t *pxEventBits = xEventGroup;
-BaseType_t xMatchFound = pdFALSE;
 
 	/* Check the user is not attempting to set the bits used by the kernel
 	itself. */
 	configASSERT( xEventGroup );
 	configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-	pxList = &( pxEventBits->xTasksWaitingForBits );
-	pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
 	vTaskSuspendAll();
 	{
 		traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
 
-		pxListItem = listGET_HEAD_ENTRY( pxList );
-
-		/* Set the bits. */
-		pxEventBits->uxEventBits |= uxBitsToSet;
-
-		/* See if the new bit value should unblock any tasks. */
-		while( pxListItem != pxListEnd )
-		{
-			pxNext = listGET_NEXT( pxListItem );
-			uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
-			xMatchFound = pdFALSE;
-
-			/* Split the bits waited for from the control bits. */
-			uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
-			uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
-
-			if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
-			{
-				/* Just looking for single bit being set. */
-				if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
-				{
-					xMatchFound = pdTRUE;
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER();
-				}
-			}
-			else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
-			{
-				/* All bits are set. */
-				xMatchFound = pdTRUE;
-			}
-			else
-			{
-				/* Need all bits to be set, but not all the bits were set. */
-			}
-
-			if( xMatchFound != pdFALSE )
-			{
-				/* The bits match.  Should the bits be cleared on exit? */
-				if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
-				{
-					uxBitsToClear |= uxBitsWaitedFor;
-				}
-				else
-				{
-					mtCOVERAGE_TEST_MARKER();
-				}
-
-				/* Store the actual event flag value in the task's event list
-				item before removing the task from the event list.  The
-				eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
-				that is was unblocked due to its required bits matching, rather
-				than because it timed out. */
-				vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
-			}
-
-			/* Move onto the next list item.  Note pxListItem->pxNext is not
-			used here as the list item may have been removed from the event list
-			and inserted into the ready/pending reading list. */
-			pxListItem = pxNext;
-		}
-
-		/* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
-		bit was set in the control word. */
-		pxEventBits->uxEventBits &= ~uxBitsToClear;
+		prvSetBitsAndUnblockTasks( pxEventBits, uxBitsToSet, NULL );
 	}
 	( void ) xTaskResumeAll();
 
@@ -613,25 +643,29 @@ BaseType_t xMatchFound = pdFALSE;
 void vEventGroupDelete( EventGroupHandle_t xEventGroup )
 {
 EventGroup_t *pxEventBits = xEventGroup;
-const List_t *pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
 
 	vTaskSuspendAll();
 	{
 		traceEVENT_GROUP_DELETE( xEventGroup );
 
-		while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+		prvUnblockAllWaitingTasks( &( pxEventBits->xTasksWaitingForBits ) );
+
+		#if( configUSE_EVENT_GROUP_BIT_INDEXED_WAITERS == 1 )
 		{
-			/* Unblock the task, returning 0 as the event list is being deleted
-			and cannot therefore have any bits set. */
-			configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
-			vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+		UBaseType_t uxBitNumber;
+
+			for( uxBitNumber = 0; uxBitNumber < eventNUMBER_OF_EVENT_BITS; uxBitNumber++ )
+			{
+				prvUnblockAllWaitingTasks( &( pxEventBits->xTasksWaitingForBit[ uxBitNumber ] ) );
+			}
 		}
+		#endif /* configUSE_EVENT_GROUP_BIT_INDEXED_WAITERS */
 
 		#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
 		{
 			/* The event group can only have been allocated dynamically - free
 			it again. */
-			vPortFree( pxEventBits );
+			prvFreeEventGroup( pxEventBits );
 		}
 		#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
 		{
@@ -639,7 +673,7 @@ const List_t *pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBits );
 			dynamically, so check before attempting to free the memory. */
 			if( pxEventBits->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
 			{
-				vPortFree( pxEventBits );
+				prvFreeEventGroup( pxEventBits );
 			}
 			else
 			{
@@ -703,7 +737,338 @@ BaseType_t xWaitConditionMet = pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+static void prvInitialiseWaitingLists( EventGroup_t *pxEventBits )
+{
+	vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+
+	#if( configUSE_EVENT_GROUP_BIT_INDEXED_WAITERS == 1 )
+	{
+	UBaseType_t uxBitNumber;
+
+		for( uxBitNumber = 0; uxBitNumber < eventNUMBER_OF_EVENT_BITS; uxBitNumber++ )
+		{
+			vListInitialise( &( pxEventBits->xTasksWaitingForBit[ uxBitNumber ] ) );
+		}
+	}
+	#endif /* configUSE_EVENT_GROUP_BIT_INDEXED_WAITERS */
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetBitsAndUnblockTasks( EventGroup_t *pxEventBits, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
+{
+EventBits_t uxBitsToClear = 0;
+
+	/* Set the bits. */
+	pxEventBits->uxEventBits |= uxBitsToSet;
+
+	#if( configUSE_EVENT_GROUP_BIT_INDEXED_WAITERS == 1 )
+	{
+	UBaseType_t uxBitNumber;
+	EventBits_t uxBitsRemaining = uxBitsToSet;
+
+		/* Only the tasks indexed by one of the bits just set can have had
+		their wait condition met, so the tasks indexed by other bits are not
+		visited. */
+		for( uxBitNumber = 0; uxBitsRemaining != ( EventBits_t ) 0; uxBitNumber++ )
+		{
+			if( ( uxBitsRemaining & ( EventBits_t ) 1 ) != ( EventBits_t ) 0 )
+			{
+				uxBitsToClear |= prvUnblockWaitingTasks( pxEventBits, &( pxEventBits->xTasksWaitingForBit[ uxBitNumber ] ), pxHigherPriorityTaskWoken );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			uxBitsRemaining >>= 1;
+		}
+	}
+	#endif /* configUSE_EVENT_GROUP_BIT_INDEXED_WAITERS */
+
+	/* See if the new bit value should unblock any tasks. */
+	uxBitsToClear |= prvUnblockWaitingTasks( pxEventBits, &( pxEventBits->xTasksWaitingForBits ), pxHigherPriorityTaskWoken );
+
+	/* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
+	bit was set in the control word. */
+	pxEventBits->uxEventBits &= ~uxBitsToClear;
+}
+/*-----------------------------------------------------------*/
+
+static EventBits_t prvUnblockWaitingTasks( EventGroup_t *pxEventBits, List_t const *pxList, BaseType_t *pxHigherPriorityTaskWoken )
+{
+ListItem_t *pxListItem, *pxNext;
+ListItem_t const *pxListEnd;
+EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
+BaseType_t xMatchFound = pdFALSE;
+
+	pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+	pxListItem = listGET_HEAD_ENTRY( pxList );
+
+	while( pxListItem != pxListEnd )
+	{
+		pxNext = listGET_NEXT( pxListItem );
+		uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
+		xMatchFound = pdFALSE;
+
+		/* Split the bits waited for from the control bits. */
+		uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+		uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+		if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+		{
+			/* Just looking for single bit being set. */
+			if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
+			{
+				xMatchFound = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+		{
+			/* All bits are set. */
+			xMatchFound = pdTRUE;
+		}
+		else
+		{
+			/* Need all bits to be set, but not all the bits were set. */
+			#if( configUSE_EVENT_GROUP_BIT_INDEXED_WAITERS == 1 )
+			{
+				/* The bit the task was indexed by is now set, so index it by
+				one of the bits it is still waiting for. */
+				( void ) uxListRemove( pxListItem );
+				vListInsertEnd( prvGetWaitingList( pxEventBits, listGET_LIST_ITEM_VALUE( pxListItem ) ), pxListItem );
+			}
+			#endif /* configUSE_EVENT_GROUP_BIT_INDEXED_WAITERS */
+		}
+
+		if( xMatchFound != pdFALSE )
+		{
+			/* The bits match.  Should the bits be cleared on exit? */
+			if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+			{
+				uxBitsToClear |= uxBitsWaitedFor;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Store the actual event flag value in the task's event list
+			item before removing the task from the event list.  The
+			eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
+			that is was unblocked due to its required bits matching, rather
+			than because it timed out. */
+			if( pxHigherPriorityTaskWoken == NULL )
+			{
+				vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+			}
+			else if( xTaskRemoveFromUnorderedEventListFromISR( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET ) != pdFALSE )
+			{
+				*pxHigherPriorityTaskWoken = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		/* Move onto the next list item.  Note pxListItem->pxNext is not
+		used here as the list item may have been removed from the event list
+		and inserted into the ready/pending reading list. */
+		pxListItem = pxNext;
+	}
+
+	return uxBitsToClear;
+}
+/*-----------------------------------------------------------*/
+
+static void prvUnblockAllWaitingTasks( const List_t *pxTasksWaitingForBits )
+{
+	while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+	{
+		/* Unblock the task, returning 0 as the event list is being deleted
+		and cannot therefore have any bits set. */
+		configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
+		vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_EVENT_GROUP_BIT_INDEXED_WAITERS == 1 )
+
+	static List_t *prvGetWaitingList( EventGroup_t *pxEventBits, const EventBits_t uxEventListItemValue )
+	{
+	List_t *pxList;
+	EventBits_t uxIndexBits = uxEventListItemValue & ~eventEVENT_BITS_CONTROL_BYTES;
+	UBaseType_t uxBitNumber = 0;
+
+		if( ( uxEventListItemValue & eventWAIT_FOR_ALL_BITS ) != ( EventBits_t ) 0 )
+		{
+			/* The wait condition cannot be met until all the bits not yet set
+			are set, so the task can be indexed by any one of them. */
+			uxIndexBits &= ~( pxEventBits->uxEventBits );
+			configASSERT( uxIndexBits != ( EventBits_t ) 0 );
+		}
+		else if( ( uxIndexBits & ( uxIndexBits - ( EventBits_t ) 1 ) ) != ( EventBits_t ) 0 )
+		{
+			/* Waiting for any one of several bits, so any of them can meet the
+			wait condition. */
+			uxIndexBits = 0;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( uxIndexBits == ( EventBits_t ) 0 )
+		{
+			pxList = &( pxEventBits->xTasksWaitingForBits );
+		}
+		else
+		{
+			/* Index the task by the lowest candidate bit. */
+			while( ( uxIndexBits & ( EventBits_t ) 1 ) == ( EventBits_t ) 0 )
+			{
+				uxIndexBits >>= 1;
+				uxBitNumber++;
+			}
+
+			pxList = &( pxEventBits->xTasksWaitingForBit[ uxBitNumber ] );
+		}
+
+		return pxList;
+	}
+
+#endif /* configUSE_EVENT_GROUP_BIT_INDEXED_WAITERS */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_DIRECT_EVENT_GROUP_SET_FROM_ISR == 1 )
+
+	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
+	{
+	EventGroup_t *pxEventBits = xEventGroup;
+	UBaseType_t uxSavedInterruptStatus;
+	BaseType_t xYieldRequired = pdFALSE, xReturn = pdPASS;
+	const UBaseType_t uxBudget = ( UBaseType_t ) configEVENT_GROUP_SET_BITS_FROM_ISR_BUDGET;
+
+		configASSERT( xEventGroup );
+		configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+		/* See the comments in xQueueGenericSendFromISR() regarding the
+		interrupt priorities that can call interrupt safe API functions. */
+		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
+
+			/* Tasks only access the event group with the scheduler suspended,
+			so the bits can only be set here if the scheduler is not
+			suspended.  They must also be set after any bits an earlier call
+			left to the timer task, and only if setting them does not mean
+			visiting more waiting tasks than the budget allows - so the time
+			spent with interrupts masked does not grow with the number of
+			waiting tasks.  Otherwise the bits are set by the timer task, as
+			they are when they are not set directly. */
+			if( ( xTaskGetSchedulerState() != taskSCHEDULER_SUSPENDED ) &&
+				( pxEventBits->uxSetsDeferred == ( UBaseType_t ) 0 ) &&
+				( prvCountTasksToVisit( pxEventBits, uxBitsToSet, uxBudget + ( UBaseType_t ) 1 ) <= uxBudget ) )
+			{
+				prvSetBitsAndUnblockTasks( pxEventBits, uxBitsToSet, &xYieldRequired );
+			}
+			else
+			{
+				xReturn = xTimerPendFunctionCallFromISR( prvSetBitsDeferredCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToSet, pxHigherPriorityTaskWoken ); /*lint !e9087 Can't avoid cast to void* as a generic callback function not specific to this use case. Callback casts back to original type so safe. */
+
+				if( xReturn != pdFAIL )
+				{
+					( pxEventBits->uxSetsDeferred )++;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		if( ( xYieldRequired != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+		{
+			*pxHigherPriorityTaskWoken = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+/*-----------------------------------------------------------*/
+
+	static UBaseType_t prvCountTasksToVisit( EventGroup_t const *pxEventBits, const EventBits_t uxBitsToSet, const UBaseType_t uxLimit )
+	{
+	UBaseType_t uxTasks;
+
+		uxTasks = listCURRENT_LIST_LENGTH( &( pxEventBits->xTasksWaitingForBits ) );
+
+		#if( configUSE_EVENT_GROUP_BIT_INDEXED_WAITERS == 1 )
+		{
+		UBaseType_t uxBitNumber;
+		EventBits_t uxBitsRemaining = uxBitsToSet;
+
+			for( uxBitNumber = 0; ( uxBitsRemaining != ( EventBits_t ) 0 ) && ( uxTasks < uxLimit ); uxBitNumber++ )
+			{
+				if( ( uxBitsRemaining & ( EventBits_t ) 1 ) != ( EventBits_t ) 0 )
+				{
+					uxTasks += listCURRENT_LIST_LENGTH( &( pxEventBits->xTasksWaitingForBit[ uxBitNumber ] ) );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				uxBitsRemaining >>= 1;
+			}
+		}
+		#else
+		{
+			( void ) uxBitsToSet;
+		}
+		#endif /* configUSE_EVENT_GROUP_BIT_INDEXED_WAITERS */
+
+		if( uxTasks > uxLimit )
+		{
+			uxTasks = uxLimit;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return uxTasks;
+	}
+/*-----------------------------------------------------------*/
+
+	static void prvSetBitsDeferredCallback( void *pvEventGroup, const uint32_t ulBitsToSet )
+	{
+	EventGroup_t *pxEventBits = ( EventGroup_t * ) pvEventGroup; /*lint !e9079 Can't avoid cast to void* as a generic timer callback prototype. Callback casts back to original type so safe. */
+
+		( void ) xEventGroupSetBits( pxEventBits, ( EventBits_t ) ulBitsToSet );
+
+		/* xEventGroupSetBitsFromISR() can update the count even while the
+		scheduler is suspended. */
+		taskENTER_CRITICAL();
+		{
+			configASSERT( pxEventBits->uxSetsDeferred > ( UBaseType_t ) 0 );
+			( pxEventBits->uxSetsDeferred )--;
+		}
+		taskEXIT_CRITICAL();
+	}
+
+#elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
 	BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup, const EventBits_t uxBitsToSet, BaseType_t *pxHigherPriorityTaskWoken )
 	{
@@ -14,6 +14,8 @@
 #include "task.h"
 #include "queue.h"
 #include "timers.h"
+#include "memory_pool.h"
+#include "slab.h"
 
 #define TRUE 							1
 #define FALSE 							0
@@ -23,6 +25,11 @@
 #define LED_TOGGLE_STOP_COMMAND 		4
 #define LED_READ_STATUS_COMMAND 		5
 #define RTC_READ_DATE_TIME_COMMAND 		6
+#define HEAP_STATS_COMMAND 				7
+
+//task notification indexes, each task notification slot carries one kind of signal
+#define CMD_RECEIVED_NOTIFY_INDEX		0
+#define MENU_REPRINT_NOTIFY_INDEX		1
 
 //function prototypes
 static void prvSetupHardware(void);
@@ -40,6 +47,7 @@ void led_toggle_start(uint32_t duration);
 void led_toggle_stop(void);
 void read_led_status(char *task_msg);
 void read_rtc_info(char *task_msg);
+void read_heap_stats(char *task_msg);
 void print_error_message(char *task_msg);
 
 //tasks prototypes
@@ -67,6 +75,9 @@ QueueHandle_t uart_write_queue = NULL;
 //software timer handle
 TimerHandle_t led_timer_handle = NULL;
 
+//memory pool handle, commands are allocated from here instead of the heap
+MemoryPoolHandle_t command_pool = NULL;
+
 //command structure
 typedef struct APP_CMD
 {
@@ -85,6 +96,7 @@ char menu[]={"\
 \r\nLED_TOGGLE_OFF					----> 4 \
 \r\nLED_READ_STATUS					----> 5 \
 \r\nRTC_PRINT_DATETIME				----> 6 \
+\r\nHEAP_STATS					----> 7 \
 \r\nEXIT_APP					----> 0 \
 \r\nType your option here : "};
 
@@ -111,7 +123,10 @@ int main(void)
 	//lets create the write queue
 	uart_write_queue = xQueueCreate(10, sizeof(char*));  	//a memory pointer is 32-bit or 4-bytes
 
-	if((command_queue != NULL) && (uart_write_queue != NULL))
+	//lets create the command pool, one block for every command the command queue can hold
+	command_pool = xMemoryPoolCreate(sizeof(APP_CMD_t), 10);
+
+	if((command_queue != NULL) && (uart_write_queue != NULL) && (command_pool != NULL))
 	{
 		//lets create Task-1
 		xTaskCreate(vTask1_menu_display, "TASK1-MENU", 500, NULL, 1, &xTaskHandle1);
@@ -145,8 +160,8 @@ void vTask1_menu_display(void *params)
 	{
 		xQueueSend(uart_write_queue, &pData, portMAX_DELAY);
 
-		//lets wait here until someone notifies
-		xTaskNotifyWait(0, 0, NULL, portMAX_DELAY);
+		//lets wait here until the last command has been processed
+		ulTaskNotifyTakeIndexed(MENU_REPRINT_NOTIFY_INDEX, pdTRUE, portMAX_DELAY);
 	}
 }
 
@@ -158,9 +173,9 @@ void vTask2_cmd_handling(void *params)
 
 	while(1)
 	{
-		xTaskNotifyWait(0, 0, NULL, portMAX_DELAY);
+		xTaskNotifyWaitIndexed(CMD_RECEIVED_NOTIFY_INDEX, 0, 0, NULL, portMAX_DELAY);
 		//1. send command to queue
-		new_cmd = (APP_CMD_t*) pvPortMalloc(sizeof(APP_CMD_t));
+		new_cmd = (APP_CMD_t*) pvMemoryPoolAlloc(command_pool, portMAX_DELAY);
 
 		taskENTER_CRITICAL();
 		command_code = getCommandCode(command_buffer);
@@ -176,7 +191,7 @@ void vTask2_cmd_handling(void *params)
 void vTask3_cmd_processing(void *params)
 {
 	APP_CMD_t *new_cmd;
-	char task_msg[50];
+	char task_msg[100];
 
 	uint32_t toggle_duration = pdMS_TO_TICKS(500);
 
@@ -208,13 +223,20 @@ void vTask3_cmd_processing(void *params)
 		{
 			read_rtc_info(task_msg);
 		}
+		else if(new_cmd->COMMAND_NUM == HEAP_STATS_COMMAND)
+		{
+			read_heap_stats(task_msg);
+		}
 		else
 		{
 			print_error_message(task_msg);
 		}
 
-		//lets free the allocated memory for the new command
-		vPortFree(new_cmd);
+		//lets return the command to the command pool
+		vMemoryPoolFree(command_pool, new_cmd);
+
+		//the command output is queued, now let the menu task print the menu again
+		xTaskNotifyGiveIndexed(xTaskHandle1, MENU_REPRINT_NOTIFY_INDEX);
 
 	}
 }
@@ -369,10 +391,8 @@ void USART2_IRQHandler(void)
 			//reset the command_len variable
 			command_len = 0;
 
-			//lets notify the command handling task
-			xTaskNotifyFromISR(xTaskHandle2, 0, eNoAction, &xHigherPriorityTaskWoken);
-
-			xTaskNotifyFromISR(xTaskHandle1, 0, eNoAction, &xHigherPriorityTaskWoken);
+			//lets notify the command handling task, the menu is reprinted once the command is processed
+			xTaskNotifyIndexedFromISR(xTaskHandle2, CMD_RECEIVED_NOTIFY_INDEX, 0, eNoAction, &xHigherPriorityTaskWoken);
 		}
 	}
 
@@ -446,6 +466,33 @@ void read_rtc_info(char *task_msg)
 	xQueueSend(uart_write_queue,&task_msg,portMAX_DELAY);
 }
 
+void read_heap_stats(char *task_msg)
+{
+	HeapStats_t heap_stats;
+	//the largest free block shrinking while the free size stays the same means the heap is fragmenting
+	vPortGetHeapStats(&heap_stats);
+
+	sprintf(task_msg, "\r\nHeap free: %u, largest block: %u, free blocks: %u, min ever: %u\r\n", (unsigned)heap_stats.xAvailableHeapSpaceInBytes, \
+									(unsigned)heap_stats.xSizeOfLargestFreeBlockInBytes, (unsigned)heap_stats.xNumberOfFreeBlocks, (unsigned)heap_stats.xMinimumEverFreeBytesRemaining);
+	xQueueSend(uart_write_queue, &task_msg, portMAX_DELAY);
+
+	//task, queue and timer control blocks come from the slab caches, not from the heap above
+	static char slab_msg[160];
+	static const char * const cache_names[slabNUMBER_OF_CACHES] = { "tasks", "queues", "timers", "event groups" };
+	SlabCacheStats_t slab_stats;
+	int len = sprintf(slab_msg, "Slab caches (in use/objects, bytes):");
+
+	for(int i = 0; i < slabNUMBER_OF_CACHES; i++)
+	{
+		vSlabCacheGetStats((eSlabCache) i, &slab_stats);
+		len += sprintf(&slab_msg[len], " %s %lu/%lu %u,", cache_names[i], (unsigned long)slab_stats.uxObjectsInUse, (unsigned long)slab_stats.uxObjects, (unsigned)slab_stats.xBytesReserved);
+	}
+
+	sprintf(&slab_msg[len - 1], "\r\n");
+	char *msg = slab_msg;
+	xQueueSend(uart_write_queue, &msg, portMAX_DELAY);
+}
+
 void print_error_message(char *task_msg)
 {
 	sprintf(task_msg, "\r\nInvalid command received\r\n");
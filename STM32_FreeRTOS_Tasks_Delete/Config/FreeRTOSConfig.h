@@ -57,6 +57,9 @@ extern void vApplicationMallocFailedHook( void );
 #define configMAX_PRIORITIES			( 5 )
 #define configMINIMAL_STACK_SIZE		( ( unsigned short ) 130 )
 #define configTOTAL_HEAP_SIZE			( ( size_t ) ( 75 * 1024 ) )
+#define configUSE_ARENAS				1
+#define configHEAP_USE_CRITICAL_SECTIONS	1
+#define configUSE_HEAP_TRACKER			1
 #define configMAX_TASK_NAME_LEN			( 10 )
 #define configUSE_TRACE_FACILITY		1
 #define configUSE_16_BIT_TICKS			0
@@ -91,6 +94,7 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelay				1
 #define INCLUDE_xTaskGetIdleTaskHandle  1
 #define INCLUDE_pxTaskGetStackStart     1
+#define INCLUDE_xTaskGetSchedulerState	1
 
 
 /* Cortex-M specific definitions. */
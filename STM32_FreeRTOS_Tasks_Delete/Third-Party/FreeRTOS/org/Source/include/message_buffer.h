@@ -77,6 +77,12 @@ extern "C" {
  */
 typedef void * MessageBufferHandle_t;
 
+/**
+ * Describes one fragment of a message passed to xMessageBufferSendV() and
+ * xMessageBufferSendVFromISR().
+ */
+typedef StreamBufferFragment_t MessageBufferFragment_t;
+
 /*-----------------------------------------------------------*/
 
 /**
@@ -203,6 +209,36 @@ MessageBufferHandle_t xMessageBuffer;
  */
 #define xMessageBufferCreateStatic( xBufferSizeBytes, pucMessageBufferStorageArea, pxStaticMessageBuffer ) ( MessageBufferHandle_t ) xStreamBufferGenericCreateStatic( xBufferSizeBytes, 0, pdTRUE, pucMessageBufferStorageArea, pxStaticMessageBuffer )
 
+/**
+ * message_buffer.h
+ *
+<pre>
+MessageBufferHandle_t xMessageBufferCreateMultiProducer( size_t xBufferSizeBytes );
+MessageBufferHandle_t xMessageBufferCreateMultiProducerStatic( size_t xBufferSizeBytes,
+                                                               uint8_t *pucMessageBufferStorageArea,
+                                                               StaticMessageBuffer_t *pxStaticMessageBuffer );
+</pre>
+ *
+ * Versions of xMessageBufferCreate() and xMessageBufferCreateStatic() that
+ * create a message buffer that any number of tasks and interrupts can send to
+ * at the same time, without the sends having to be serialised by a mutex or
+ * critical section.  There must still only be one reader.  Each message,
+ * including its length, is written into space reserved for it alone, so
+ * messages from different writers are never interleaved, and the reader never
+ * receives a message that is still being written.  See
+ * xStreamBufferCreateMultiProducer() for more information.
+ *
+ * configUSE_MULTI_PRODUCER_STREAM_BUFFERS must be set to 1 in FreeRTOSConfig.h
+ * for these macros to be available.
+ *
+ * \defgroup xMessageBufferCreateMultiProducer xMessageBufferCreateMultiProducer
+ * \ingroup MessageBufferManagement
+ */
+#if( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+	#define xMessageBufferCreateMultiProducer( xBufferSizeBytes ) ( MessageBufferHandle_t ) xStreamBufferGenericCreate( xBufferSizeBytes, ( size_t ) 0, ( sbTYPE_MESSAGE_BUFFER | sbTYPE_MULTI_PRODUCER ) )
+	#define xMessageBufferCreateMultiProducerStatic( xBufferSizeBytes, pucMessageBufferStorageArea, pxStaticMessageBuffer ) ( MessageBufferHandle_t ) xStreamBufferGenericCreateStatic( xBufferSizeBytes, 0, ( sbTYPE_MESSAGE_BUFFER | sbTYPE_MULTI_PRODUCER ), pucMessageBufferStorageArea, pxStaticMessageBuffer )
+#endif
+
 /**
  * message_buffer.h
  *
@@ -406,6 +442,50 @@ BaseType_t xHigherPriorityTaskWoken = pdFALSE; // Initialised to pdFALSE.
  */
 #define xMessageBufferSendFromISR( xMessageBuffer, pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken ) xStreamBufferSendFromISR( ( StreamBufferHandle_t ) xMessageBuffer, pvTxData, xDataLengthBytes, pxHigherPriorityTaskWoken )
 
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferSendV( MessageBufferHandle_t xMessageBuffer,
+                            const MessageBufferFragment_t *pxFragments,
+                            UBaseType_t uxFragments,
+                            TickType_t xTicksToWait );
+</pre>
+ *
+ * Sends a discrete message that is gathered from several fragments, such as a
+ * protocol header, payload and checksum, to the message buffer.  The message
+ * is stored with a single length equal to the total length of the fragments,
+ * and is received as one message by xMessageBufferReceive().  Either all of
+ * the message is written or none of it is.  This avoids assembling the
+ * message in a temporary buffer before calling xMessageBufferSend().
+ *
+ * The parameters, return value and blocking behaviour are otherwise the same
+ * as for xMessageBufferSend().  See xStreamBufferSendV() for an example.
+ *
+ * \defgroup xMessageBufferSendV xMessageBufferSendV
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSendV( xMessageBuffer, pxFragments, uxFragments, xTicksToWait ) xStreamBufferSendV( ( StreamBufferHandle_t ) xMessageBuffer, pxFragments, uxFragments, xTicksToWait )
+
+/**
+ * message_buffer.h
+ *
+<pre>
+size_t xMessageBufferSendVFromISR( MessageBufferHandle_t xMessageBuffer,
+                                   const MessageBufferFragment_t *pxFragments,
+                                   UBaseType_t uxFragments,
+                                   BaseType_t *pxHigherPriorityTaskWoken );
+</pre>
+ *
+ * A version of xMessageBufferSendV() that can be called from an interrupt
+ * service routine (ISR).  The parameters and return value are as for
+ * xMessageBufferSendV() and xMessageBufferSendFromISR().
+ *
+ * \defgroup xMessageBufferSendVFromISR xMessageBufferSendVFromISR
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSendVFromISR( xMessageBuffer, pxFragments, uxFragments, pxHigherPriorityTaskWoken ) xStreamBufferSendVFromISR( ( StreamBufferHandle_t ) xMessageBuffer, pxFragments, uxFragments, pxHigherPriorityTaskWoken )
+
 /**
  * message_buffer.h
  *
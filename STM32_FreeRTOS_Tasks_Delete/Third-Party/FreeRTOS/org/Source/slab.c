@@ -0,0 +1,362 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "slab.h"
+#include "heap_tracker.h"
+
+/* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+to include slab caches.  This #if is closed at the very bottom of this file.
+If you want to include slab caches then ensure configUSE_SLAB_CACHES is set to
+1 in FreeRTOSConfig.h. */
+#if( configUSE_SLAB_CACHES == 1 )
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION != 1 )
+	#error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h to use slab caches
+#endif
+
+/* The size of the objects of a type, rounded up so every object in a slab is
+aligned. */
+#define slabOBJECT_SIZE( xSize ) ( ( ( size_t ) ( xSize ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/* A free object.  The first bytes of each free object hold a pointer to the
+next free object in the same cache. */
+typedef struct SLAB_OBJECT
+{
+	struct SLAB_OBJECT *pxNextFree;			/*<< The next free object in the cache. */
+} SlabObject_t;
+
+/* The definition of a slab cache.  The slabs themselves are not linked
+together, as they are never freed. */
+typedef struct SLAB_CACHE
+{
+	SlabObject_t *pxFreeList;				/*<< The first free object. */
+	size_t xBytesReserved;					/*<< The total size of the slabs. */
+	UBaseType_t uxSlabs;					/*<< The number of slabs allocated. */
+	UBaseType_t uxObjects;					/*<< The number of objects in the slabs. */
+	UBaseType_t uxObjectsInUse;				/*<< The number of objects allocated. */
+	UBaseType_t uxMaximumObjectsInUse;		/*<< The highest value uxObjectsInUse has had. */
+	uint32_t ulAllocations;					/*<< The number of successful allocations. */
+	uint32_t ulFailedAllocations;			/*<< The number of allocations that returned NULL. */
+} SlabCache_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Allocate the first slab of every cache, with the number of objects set in
+ * FreeRTOSConfig.h.
+ */
+static void prvProvisionCaches( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Allocate a slab of uxObjects objects from the FreeRTOS heap and add its
+ * objects to the free list of the cache.  Returns pdFAIL if the heap did not
+ * have enough memory.
+ */
+static BaseType_t prvAddSlab( eSlabCache eCache, UBaseType_t uxObjects ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove an object from the free list of a cache, and update the statistics.
+ * Returns NULL if the free list is empty.  Must be called from a critical
+ * section.
+ */
+static void *prvPopFreeObject( SlabCache_t * const pxCache ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+/* The size of the objects in each cache, and the number of objects in the
+first slab of each cache, indexed by eSlabCache. */
+static const size_t xObjectSizes[ slabNUMBER_OF_CACHES ] =
+{
+	slabOBJECT_SIZE( sizeof( StaticTask_t ) ),
+	slabOBJECT_SIZE( sizeof( StaticQueue_t ) ),
+	slabOBJECT_SIZE( sizeof( StaticTimer_t ) ),
+	slabOBJECT_SIZE( sizeof( StaticEventGroup_t ) )
+};
+
+static const UBaseType_t uxProvisionedObjects[ slabNUMBER_OF_CACHES ] =
+{
+	( UBaseType_t ) configSLAB_CACHE_TASKS,
+	( UBaseType_t ) configSLAB_CACHE_QUEUES,
+	( UBaseType_t ) configSLAB_CACHE_TIMERS,
+	( UBaseType_t ) configSLAB_CACHE_EVENT_GROUPS
+};
+
+static SlabCache_t xSlabCaches[ slabNUMBER_OF_CACHES ];
+
+/* Set once the first slab of every cache has been allocated. */
+static volatile BaseType_t xCachesProvisioned = pdFALSE;
+
+/*-----------------------------------------------------------*/
+
+void *pvSlabAlloc( eSlabCache eCache )
+{
+SlabCache_t * const pxCache = &( xSlabCaches[ eCache ] );
+void *pvObject;
+
+	configASSERT( ( UBaseType_t ) eCache < ( UBaseType_t ) slabNUMBER_OF_CACHES );
+
+	if( xCachesProvisioned == pdFALSE )
+	{
+		prvProvisionCaches();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	taskENTER_CRITICAL();
+	{
+		pvObject = prvPopFreeObject( pxCache );
+	}
+	taskEXIT_CRITICAL();
+
+	if( pvObject == NULL )
+	{
+		/* The cache is empty.  Growing it is the only path that does not take
+		a constant time, as it allocates from the FreeRTOS heap. */
+		if( ( configSLAB_CACHE_GROW_OBJECTS > 0 ) && ( prvAddSlab( eCache, ( UBaseType_t ) configSLAB_CACHE_GROW_OBJECTS ) == pdPASS ) )
+		{
+			taskENTER_CRITICAL();
+			{
+				pvObject = prvPopFreeObject( pxCache );
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pvObject != NULL )
+	{
+		traceSLAB_ALLOC( eCache, pvObject );
+	}
+	else
+	{
+		taskENTER_CRITICAL();
+		{
+			( pxCache->ulFailedAllocations )++;
+		}
+		taskEXIT_CRITICAL();
+
+		traceSLAB_ALLOC_FAILED( eCache );
+	}
+
+	return pvObject;
+}
+/*-----------------------------------------------------------*/
+
+void vSlabFree( eSlabCache eCache, void *pvObject )
+{
+SlabCache_t * const pxCache = &( xSlabCaches[ eCache ] );
+SlabObject_t * const pxObject = ( SlabObject_t * ) pvObject; /*lint !e9087 !e9079 Objects are aligned to portBYTE_ALIGNMENT. */
+
+	configASSERT( ( UBaseType_t ) eCache < ( UBaseType_t ) slabNUMBER_OF_CACHES );
+	configASSERT( pxObject );
+	configASSERT( pxCache->uxObjectsInUse > ( UBaseType_t ) 0 );
+
+	traceSLAB_FREE( eCache, pvObject );
+
+	/* The object goes back to the cache it came from, so its memory is only
+	ever reused for an object of the same type. */
+	taskENTER_CRITICAL();
+	{
+		pxObject->pxNextFree = pxCache->pxFreeList;
+		pxCache->pxFreeList = pxObject;
+		( pxCache->uxObjectsInUse )--;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vSlabCacheGetStats( eSlabCache eCache, SlabCacheStats_t *pxStats )
+{
+SlabCache_t * const pxCache = &( xSlabCaches[ eCache ] );
+
+	configASSERT( ( UBaseType_t ) eCache < ( UBaseType_t ) slabNUMBER_OF_CACHES );
+
+	pxStats->xObjectSize = xObjectSizes[ eCache ];
+
+	taskENTER_CRITICAL();
+	{
+		pxStats->xBytesReserved = pxCache->xBytesReserved;
+		pxStats->uxSlabs = pxCache->uxSlabs;
+		pxStats->uxObjects = pxCache->uxObjects;
+		pxStats->uxObjectsInUse = pxCache->uxObjectsInUse;
+		pxStats->uxMaximumObjectsInUse = pxCache->uxMaximumObjectsInUse;
+		pxStats->ulAllocations = pxCache->ulAllocations;
+		pxStats->ulFailedAllocations = pxCache->ulFailedAllocations;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static void prvProvisionCaches( void )
+{
+UBaseType_t uxCache;
+
+	/* The scheduler is suspended so two tasks creating their first objects at
+	the same time do not both provision the caches. */
+	vTaskSuspendAll();
+	{
+		if( xCachesProvisioned == pdFALSE )
+		{
+			for( uxCache = 0; uxCache < ( UBaseType_t ) slabNUMBER_OF_CACHES; uxCache++ )
+			{
+				if( uxProvisionedObjects[ uxCache ] > ( UBaseType_t ) 0 )
+				{
+					/* A cache whose first slab could not be allocated is left
+					empty, and grows when an object is allocated from it. */
+					( void ) prvAddSlab( ( eSlabCache ) uxCache, uxProvisionedObjects[ uxCache ] );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			xCachesProvisioned = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvAddSlab( eSlabCache eCache, UBaseType_t uxObjects )
+{
+SlabCache_t * const pxCache = &( xSlabCaches[ eCache ] );
+const size_t xObjectSize = xObjectSizes[ eCache ];
+uint8_t *pucSlab;
+SlabObject_t *pxFirst, *pxObject;
+UBaseType_t uxObject;
+BaseType_t xReturn;
+
+	pucSlab = ( uint8_t * ) pvPortMalloc( xObjectSize * ( size_t ) uxObjects );
+
+	if( pucSlab != NULL )
+	{
+		#if( configUSE_HEAP_TRACKER == 1 )
+		{
+			/* Slabs are never freed, so they belong to no task and are never
+			reported as leaks. */
+			vHeapTrackerSetOwner( pucSlab, NULL );
+		}
+		#endif /* configUSE_HEAP_TRACKER */
+
+		/* Link the objects of the slab together before entering the critical
+		section, so only the two ends of the chain need to be linked into the
+		free list. */
+		pxFirst = ( SlabObject_t * ) pucSlab; /*lint !e9087 !e9079 pvPortMalloc() returns memory aligned to portBYTE_ALIGNMENT. */
+		pxObject = pxFirst;
+
+		for( uxObject = ( UBaseType_t ) 1; uxObject < uxObjects; uxObject++ )
+		{
+			pxObject->pxNextFree = ( SlabObject_t * ) ( pucSlab + ( xObjectSize * ( size_t ) uxObject ) ); /*lint !e9087 !e9079 xObjectSize is a multiple of portBYTE_ALIGNMENT. */
+			pxObject = pxObject->pxNextFree;
+		}
+
+		taskENTER_CRITICAL();
+		{
+			pxObject->pxNextFree = pxCache->pxFreeList;
+			pxCache->pxFreeList = pxFirst;
+			pxCache->xBytesReserved += xObjectSize * ( size_t ) uxObjects;
+			( pxCache->uxSlabs )++;
+			pxCache->uxObjects += uxObjects;
+		}
+		taskEXIT_CRITICAL();
+
+		traceSLAB_CACHE_GROW( eCache, uxObjects );
+		xReturn = pdPASS;
+	}
+	else
+	{
+		xReturn = pdFAIL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvPopFreeObject( SlabCache_t * const pxCache )
+{
+SlabObject_t *pxObject;
+
+	pxObject = pxCache->pxFreeList;
+
+	if( pxObject != NULL )
+	{
+		pxCache->pxFreeList = pxObject->pxNextFree;
+		( pxCache->uxObjectsInUse )++;
+		( pxCache->ulAllocations )++;
+
+		if( pxCache->uxObjectsInUse > pxCache->uxMaximumObjectsInUse )
+		{
+			pxCache->uxMaximumObjectsInUse = pxCache->uxObjectsInUse;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return ( void * ) pxObject;
+}
+
+/* This entire source file will be skipped if the application is not configured
+to include slab caches.  If you want to include slab caches then ensure
+configUSE_SLAB_CACHES is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_SLAB_CACHES == 1 */
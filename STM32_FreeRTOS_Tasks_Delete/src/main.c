@@ -14,6 +14,8 @@
 
 #include "FreeRTOS.h"
 #include "task.h"
+#include "arena.h"
+#include "heap_tracker.h"
 
 #define TRUE 1
 #define FALSE 0
@@ -29,6 +31,7 @@ static void prvSetupUart(void);
 void prvSetupGPIO(void);
 void printmsg(char *msg);
 void rtos_delay(uint32_t delay_in_ms);
+void report_heap_leaks(void);
 
 void vTask1_handler(void *params);
 void vTask2_handler(void *params);
@@ -37,6 +40,7 @@ void vTask2_handler(void *params);
 char usr_msg[250] = {0};
 //global space for some variables
 uint8_t button_status_flag = NOT_PRESSED;
+volatile uint8_t task2_deleted = FALSE;
 
 int main(void)
 {
@@ -79,6 +83,13 @@ void vTask1_handler(void *params)
 			vTaskDelay(200);			//This will n;lock Task-1 and this will allow IDLE task to run and deallocate memory of Task-2
 			GPIO_ToggleBits(GPIOA, GPIO_Pin_5);
 		}
+
+		if(task2_deleted)
+		{
+			//The IDLE task has freed the memory of Task-2 by now, so anything Task-2 allocated that is still live has leaked
+			task2_deleted = FALSE;
+			report_heap_leaks();
+		}
 	}
 }
 
@@ -86,8 +97,13 @@ void vTask2_handler(void *params)
 {
 	//TickType_t current_tick = 0;
 
-	sprintf(usr_msg, "Task-2 is running\r\n");
-	printmsg(usr_msg);
+	//Task-2 keeps its messages in its own arena, so they need not be freed one by one
+	//The IDLE task releases the whole arena together with the TCB and stack of Task-2
+	char *task_msg = pvTaskArenaAlloc(100);
+	configASSERT(task_msg != NULL);
+
+	sprintf(task_msg, "Task-2 is running\r\n");
+	printmsg(task_msg);
 
 	while(1)
 	{
@@ -102,8 +118,9 @@ void vTask2_handler(void *params)
 		{
 			//button is pressed on the nucleo board
 			//Task2 deletes itself
-			sprintf(usr_msg, "Task-2 is getting deleted\r\n");
-			printmsg(usr_msg);
+			sprintf(task_msg, "Task-2 is getting deleted\r\n");
+			printmsg(task_msg);
+			task2_deleted = TRUE;
 			vTaskDelete(NULL);
 		}
 	}
@@ -197,3 +214,22 @@ void rtos_delay(uint32_t delay_in_ms)
 
 	while(xTaskGetTickCount() < (current_tick_count + delay_in_ticks));
 }
+
+void report_heap_leaks(void)
+{
+	HeapTrackerStats_t stats;
+	HeapTrackerAllocation_t leaks[4];
+	UBaseType_t count;
+
+	vHeapTrackerGetStats(&stats);
+	sprintf(usr_msg, "Heap: %u blocks live, %u suspected leaks (%u bytes)\r\n", (unsigned)stats.uxTrackedBlocks, (unsigned)stats.uxSuspectedLeaks, (unsigned)stats.xSuspectedLeakBytes);
+	printmsg(usr_msg);
+
+	//each leak is shown with the return address of its pvPortMalloc() call, which can be looked up in the map file
+	count = uxHeapTrackerGetLeaks(leaks, 4);
+	for(UBaseType_t i = 0; i < count; i++)
+	{
+		sprintf(usr_msg, "Leak: %u bytes at %p allocated from %p at tick %u\r\n", (unsigned)leaks[i].xSize, leaks[i].pvAddress, leaks[i].pvCaller, (unsigned)leaks[i].xTimeAllocated);
+		printmsg(usr_msg);
+	}
+}
@@ -368,6 +368,23 @@ void vListInitialiseItem( ListItem_t * const pxItem ) PRIVILEGED_FUNCTION;
  */
 void vListInsert( List_t * const pxList, ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION;
 
+/*
+ * Move every item in one sorted list into another sorted list, in a single
+ * pass through both.  The result is the same as removing each item in turn
+ * from pxItemsToMerge and inserting it into pxList with vListInsert(), so an
+ * item is placed after any items already in pxList that have the same item
+ * value.
+ *
+ * @param pxList The list into which the items are to be placed.
+ *
+ * @param pxItemsToMerge The list holding the items to be placed in pxList,
+ * in item value order as built by vListInsert().  It is empty on return.
+ *
+ * \page vListMerge vListMerge
+ * \ingroup LinkedList
+ */
+void vListMerge( List_t * const pxList, List_t * const pxItemsToMerge ) PRIVILEGED_FUNCTION;
+
 /*
  * Insert a list item into a list.  The item will be inserted in a position
  * such that it will be the last item within the list returned by multiple
@@ -167,6 +167,53 @@ const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
 }
 /*-----------------------------------------------------------*/
 
+void vListMerge( List_t * const pxList, List_t * const pxItemsToMerge )
+{
+ListItem_t *pxIterator, *pxNewListItem, *pxNextItemToMerge;
+const MiniListItem_t * const pxListEnd = &( pxList->xListEnd );
+const MiniListItem_t * const pxItemsToMergeEnd = &( pxItemsToMerge->xListEnd );
+TickType_t xValueOfInsertion;
+
+	listTEST_LIST_INTEGRITY( pxList );
+	listTEST_LIST_INTEGRITY( pxItemsToMerge );
+
+	/* The items to merge are taken in ascending item value order, so each is
+	inserted at or after the position of the one before it, and the iterator
+	never has to move backwards.  As in vListInsert() a new item is placed
+	after any items with the same value.  The iterator stops before the end
+	marker, rather than comparing against the end marker's value, so items
+	with a value of portMAX_DELAY are placed at the end. */
+	pxIterator = ( ListItem_t * ) pxListEnd; /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+
+	/* The items are moved without removing them from pxItemsToMerge one at a
+	time, which is then left empty. */
+	for( pxNewListItem = listGET_HEAD_ENTRY( pxItemsToMerge ); pxNewListItem != ( const ListItem_t * ) pxItemsToMergeEnd; pxNewListItem = pxNextItemToMerge ) /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+	{
+		listTEST_LIST_ITEM_INTEGRITY( pxNewListItem );
+		pxNextItemToMerge = pxNewListItem->pxNext;
+		xValueOfInsertion = pxNewListItem->xItemValue;
+
+		while( ( pxIterator->pxNext != ( const ListItem_t * ) pxListEnd ) && ( pxIterator->pxNext->xItemValue <= xValueOfInsertion ) ) /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+		{
+			pxIterator = pxIterator->pxNext;
+		}
+
+		pxNewListItem->pxNext = pxIterator->pxNext;
+		pxNewListItem->pxNext->pxPrevious = pxNewListItem;
+		pxNewListItem->pxPrevious = pxIterator;
+		pxIterator->pxNext = pxNewListItem;
+		pxNewListItem->pxContainer = pxList;
+
+		( pxList->uxNumberOfItems )++;
+
+		/* The next item to merge goes after this one. */
+		pxIterator = pxNewListItem;
+	}
+
+	vListInitialise( pxItemsToMerge );
+}
+/*-----------------------------------------------------------*/
+
 UBaseType_t uxListRemove( ListItem_t * const pxItemToRemove )
 {
 /* The list item knows which list it is in.  Obtain the list from the list
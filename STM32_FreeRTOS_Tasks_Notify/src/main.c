@@ -26,7 +26,9 @@ TaskHandle_t xTaskHandle2 = NULL;
 //function prototypes
 static void prvSetupHardware(void);
 static void prvSetupUart(void);
+static void prvSetupHeap(void);
 void prvSetupGPIO(void);
+void print_heap_regions(void);
 void printmsg(char *msg);
 void rtos_delay(uint32_t delay_in_ms);
 
@@ -38,6 +40,24 @@ char usr_msg[250] = {0};
 //global space for some variables
 uint8_t button_status_flag = NOT_PRESSED;
 
+//external SDRAM on FMC SDRAM bank 1. On boards that have it, configure the FMC with stm32f4xx_fmc.c
+//before prvSetupHeap() and set SDRAM_HEAP_SIZE to the size of the device
+#define SDRAM_BANK1_ADDR	((uint8_t *) 0xC0000000)
+#define SDRAM_HEAP_SIZE		0
+
+//the heap regions, in the order they are searched. Internal SRAM comes first so the kernel's TCBs and
+//stacks stay there, and buffers allocated with portHEAP_REGION_BULK go to SDRAM while it has space
+static uint8_t sram_heap[configTOTAL_HEAP_SIZE];
+
+static const HeapRegion_t heap_regions[] =
+{
+	{ sram_heap, sizeof(sram_heap), portHEAP_REGION_FAST | portHEAP_REGION_DMA },
+#if SDRAM_HEAP_SIZE > 0
+	{ SDRAM_BANK1_ADDR, SDRAM_HEAP_SIZE, portHEAP_REGION_BULK | portHEAP_REGION_DMA },
+#endif
+	{ NULL, 0, 0 }
+};
+
 int main(void)
 {
 	DWT->CTRL |= (1 << 0); 	//Enable CYCCNT in DWL_CTRL //Used for segger to maintain the timestamp
@@ -51,6 +71,9 @@ int main(void)
 
 	prvSetupHardware();
 
+	//the heap regions must be defined before anything is allocated
+	prvSetupHeap();
+
 	sprintf(usr_msg, "This is Demo of Task Notify APIs\r\n");
 	printmsg(usr_msg);
 
@@ -62,6 +85,8 @@ int main(void)
 	xTaskCreate(vtask_led_handler, "TASK-LED", 500, NULL, 2, &xTaskHandle1);
 	xTaskCreate(vtask_button_handler, "TASK-Button", 500, NULL, 2, &xTaskHandle2);
 
+	print_heap_regions();
+
 	//let start scheduler
 	vTaskStartScheduler();
 
@@ -138,6 +163,11 @@ static void prvSetupUart(void)
 	USART_Cmd(USART2, ENABLE);
 }
 
+static void prvSetupHeap(void)
+{
+	vPortDefineHeapRegions(heap_regions);
+}
+
 static void prvSetupHardware(void)
 {
 	//setup Button and LED
@@ -158,6 +188,19 @@ void printmsg(char *msg)
 	while( USART_GetFlagStatus(USART2, USART_FLAG_TC) != SET);
 }
 
+void print_heap_regions(void)
+{
+	HeapStats_t heap_stats;
+
+	for(uint32_t i = 0; heap_regions[i].xSizeInBytes > 0; i++)
+	{
+		vPortGetHeapRegionStats(i, &heap_stats);
+		sprintf(usr_msg, "Heap region %lu: free %u of %u, largest block: %u, allocations: %u\r\n", (unsigned long)i, (unsigned)heap_stats.xAvailableHeapSpaceInBytes, \
+									(unsigned)heap_regions[i].xSizeInBytes, (unsigned)heap_stats.xSizeOfLargestFreeBlockInBytes, (unsigned)heap_stats.xNumberOfSuccessfulAllocations);
+		printmsg(usr_msg);
+	}
+}
+
 void prvSetupGPIO(void)
 {
 //this function is board specific
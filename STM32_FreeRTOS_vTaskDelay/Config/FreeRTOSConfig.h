@@ -80,6 +80,19 @@ extern void vApplicationMallocFailedHook( void );
 #define configTIMER_QUEUE_LENGTH		10
 #define configTIMER_TASK_STACK_DEPTH	( configMINIMAL_STACK_SIZE * 2 )
 
+/* High resolution timer definitions.  The counter and compare interrupt are
+provided by TIM5, see src/hr_timer_tim5.c. */
+#define configUSE_HR_TIMERS				1
+#define configHR_TIMER_COUNT_RATE_HZ	1000000UL
+extern void vConfigureHRTimer( void );
+extern uint32_t ulGetHRTimerCount( void );
+extern void vSetHRTimerCompare( uint32_t ulCompareValue );
+extern void vDisableHRTimerCompare( void );
+#define portCONFIGURE_HR_TIMER()				vConfigureHRTimer()
+#define portGET_HR_TIMER_COUNT()				ulGetHRTimerCount()
+#define portSET_HR_TIMER_COMPARE( ulCompareValue )	vSetHRTimerCompare( ulCompareValue )
+#define portDISABLE_HR_TIMER_COMPARE()			vDisableHRTimerCompare()
+
 /* Set the following definitions to 1 to include the API function, or zero
 to exclude the API function. */
 #define INCLUDE_vTaskPrioritySet		1
@@ -0,0 +1,329 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include arena.h"
+#endif
+
+/* FreeRTOS includes. */
+#include "task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * An arena hands out memory by advancing a pointer through a region of RAM,
+ * so allocating from it takes a constant time and adds no per-object header.
+ * Objects allocated from an arena are never freed individually.  Instead all
+ * the memory of the arena is released in one operation when the arena is
+ * reset or deleted, so a task that builds up many small objects and then
+ * exits neither pays the cost of freeing each object nor leaves the FreeRTOS
+ * heap fragmented.
+ *
+ * An arena can be bound to a task with vTaskSetArena(), or created on demand
+ * by pvTaskArenaAlloc().  An arena bound to a task is deleted along with the
+ * task's TCB and stack when the task is deleted.
+ *
+ * Arenas are not protected against concurrent access - an arena must only be
+ * used by one task at a time, and never from an interrupt.
+ *
+ * configUSE_ARENAS must be set to 1 in FreeRTOSConfig.h for arenas to be
+ * available.
+ *
+ * \defgroup Arena
+ */
+
+/**
+ * arena.h
+ *
+ * Type by which arenas are referenced.  For example, a call to xArenaCreate()
+ * returns an ArenaHandle_t variable that can then be used as a parameter to
+ * other arena functions.
+ *
+ * \defgroup ArenaHandle_t ArenaHandle_t
+ * \ingroup Arena
+ */
+struct ArenaDef_t;
+typedef struct ArenaDef_t * ArenaHandle_t;
+
+/**
+ * arena.h
+ *
+ * Used with vArenaGetStats() to obtain the usage statistics of an arena.
+ *
+ * \ingroup Arena
+ */
+typedef struct xARENA_STATS
+{
+	size_t xBytesAllocated;			/* The number of bytes handed out since the arena was created or last reset, including the padding that keeps each allocation aligned. */
+	size_t xBytesReserved;			/* The number of bytes the arena currently holds, in its initial region and any chunks it has grown by. */
+	UBaseType_t uxChunks;			/* The number of chunks the arena has grown by since it was created or last reset. */
+	uint32_t ulAllocations;			/* The number of successful allocations since the arena was created. */
+	uint32_t ulFailedAllocations;	/* The number of allocations that returned NULL since the arena was created. */
+} ArenaStats_t;
+
+/*
+ * The size to which each allocation from an arena is rounded up, so every
+ * allocation is aligned to portBYTE_ALIGNMENT.
+ */
+#define arenaALLOCATION_SIZE( xSize ) ( ( ( size_t ) ( xSize ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/**
+ * arena.h
+ *<pre>
+ ArenaHandle_t xArenaCreate( size_t xSize, size_t xGrowSize );
+ </pre>
+ *
+ * Create a new arena.  The arena's structure and its initial region are
+ * allocated from the FreeRTOS heap in a single allocation.
+ *
+ * @param xSize The size of the arena's initial region in bytes.
+ *
+ * @param xGrowSize The minimum size in bytes of each chunk the arena allocates
+ * from the FreeRTOS heap when an allocation does not fit in the space that
+ * remains.  Set to 0 to create an arena that never grows beyond xSize bytes.
+ *
+ * @return If the arena was created then its handle is returned.  If there was
+ * insufficient FreeRTOS heap available to create the arena then NULL is
+ * returned.
+ *
+ * Example usage:
+   <pre>
+	void vParserTask( void *pvParameters )
+	{
+	ArenaHandle_t xArena;
+
+		// Objects built while parsing are allocated from an arena that is
+		// bound to this task, so they are all released when the task is
+		// deleted.
+		xArena = xArenaCreate( 512, 256 );
+		configASSERT( xArena );
+		vTaskSetArena( NULL, xArena );
+
+		vParse( xArena );
+
+		vTaskDelete( NULL );
+	}
+   </pre>
+ * \defgroup xArenaCreate xArenaCreate
+ * \ingroup Arena
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	ArenaHandle_t xArenaCreate( size_t xSize, size_t xGrowSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * arena.h
+ *<pre>
+ ArenaHandle_t xArenaCreateStatic( size_t xSize,
+                                   uint8_t *pucArenaStorage,
+                                   StaticArena_t *pxStaticArena );
+ </pre>
+ *
+ * As xArenaCreate(), but the memory used by the arena is provided by the
+ * application.  An arena created statically never grows.
+ *
+ * @param xSize The size of pucArenaStorage in bytes.
+ *
+ * @param pucArenaStorage An array of xSize bytes, aligned to
+ * portBYTE_ALIGNMENT, from which allocations are made.
+ *
+ * @param pxStaticArena A variable of type StaticArena_t, which is used to hold
+ * the arena's data structure.
+ *
+ * @return The handle of the arena.
+ *
+ * \defgroup xArenaCreateStatic xArenaCreateStatic
+ * \ingroup Arena
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	ArenaHandle_t xArenaCreateStatic( size_t xSize, uint8_t *pucArenaStorage, StaticArena_t *pxStaticArena ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * arena.h
+ *<pre>
+ void *pvArenaAlloc( ArenaHandle_t xArena, size_t xSize );
+ </pre>
+ *
+ * Allocate memory from an arena.  The memory remains allocated until the arena
+ * is reset or deleted.
+ *
+ * @param xArena The arena from which the memory is allocated.
+ *
+ * @param xSize The number of bytes to allocate.
+ *
+ * @return A pointer to the memory, aligned to portBYTE_ALIGNMENT, or NULL if
+ * xSize is 0, or if the arena is full and could not grow.
+ *
+ * \defgroup pvArenaAlloc pvArenaAlloc
+ * \ingroup Arena
+ */
+void *pvArenaAlloc( ArenaHandle_t xArena, size_t xSize ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ *<pre>
+ void vArenaReset( ArenaHandle_t xArena );
+ </pre>
+ *
+ * Release everything allocated from an arena at once.  Chunks the arena grew
+ * by are returned to the FreeRTOS heap, and the initial region is reused by
+ * the following allocations.
+ *
+ * \defgroup vArenaReset vArenaReset
+ * \ingroup Arena
+ */
+void vArenaReset( ArenaHandle_t xArena ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ *<pre>
+ void vArenaGetStats( ArenaHandle_t xArena, ArenaStats_t *pxStats );
+ </pre>
+ *
+ * Obtain the usage statistics of an arena.
+ *
+ * @param pxStats The structure into which the statistics are written.
+ *
+ * \defgroup vArenaGetStats vArenaGetStats
+ * \ingroup Arena
+ */
+void vArenaGetStats( ArenaHandle_t xArena, ArenaStats_t *pxStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ *<pre>
+ void vArenaDelete( ArenaHandle_t xArena );
+ </pre>
+ *
+ * Delete an arena, returning all its memory to the FreeRTOS heap if it was
+ * created with xArenaCreate().  Memory allocated from the arena must not be
+ * used once the arena has been deleted.  An arena bound to a task must not be
+ * deleted directly, as it is deleted by the kernel when the task is deleted.
+ *
+ * \defgroup vArenaDelete vArenaDelete
+ * \ingroup Arena
+ */
+void vArenaDelete( ArenaHandle_t xArena ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ *<pre>
+ void vTaskSetArena( TaskHandle_t xTask, ArenaHandle_t xArena );
+ </pre>
+ *
+ * Bind an arena to a task.  The task takes ownership of the arena, which is
+ * then deleted by the kernel when the task is deleted - after the task has
+ * been removed from the scheduler, so nothing allocated from the arena can be
+ * referenced by the task once it has been released.  Passing NULL as xArena
+ * unbinds the task's arena, if any, and ownership of it returns to the
+ * caller.  Only one arena can be bound to a task at a time.
+ *
+ * This function is implemented in tasks.c, as it accesses the task's TCB.
+ *
+ * @param xTask The task to which the arena is bound.  Passing NULL binds the
+ * arena to the calling task.
+ *
+ * @param xArena The arena to bind to the task.
+ *
+ * \defgroup vTaskSetArena vTaskSetArena
+ * \ingroup Arena
+ */
+void vTaskSetArena( TaskHandle_t xTask, ArenaHandle_t xArena ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ *<pre>
+ ArenaHandle_t xTaskGetArena( TaskHandle_t xTask );
+ </pre>
+ *
+ * @param xTask The task being queried.  Passing NULL queries the calling task.
+ *
+ * @return The arena bound to the task, or NULL if no arena is bound to it.
+ *
+ * \defgroup xTaskGetArena xTaskGetArena
+ * \ingroup Arena
+ */
+ArenaHandle_t xTaskGetArena( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * arena.h
+ *<pre>
+ void *pvTaskArenaAlloc( size_t xSize );
+ </pre>
+ *
+ * Allocate memory from the arena bound to the calling task.  If no arena is
+ * bound to the calling task then one is created with xArenaCreate(), using
+ * configTASK_ARENA_SIZE as both its initial size and its grow size, and bound
+ * to the task.  The memory is released when the task is deleted.
+ *
+ * Must only be called from a task.
+ *
+ * @param xSize The number of bytes to allocate.
+ *
+ * @return A pointer to the memory, or NULL if there was insufficient FreeRTOS
+ * heap available.
+ *
+ * Example usage:
+   <pre>
+	void vWorkerTask( void *pvParameters )
+	{
+	char *pcLine;
+
+		for( ;; )
+		{
+			// Nothing allocated here is freed individually - it is all
+			// returned to the heap when the task deletes itself.
+			pcLine = pvTaskArenaAlloc( 80 );
+			if( ( pcLine == NULL ) || ( xReadLine( pcLine, 80 ) == pdFALSE ) )
+			{
+				break;
+			}
+
+			vProcessLine( pcLine );
+		}
+
+		vTaskDelete( NULL );
+	}
+   </pre>
+ * \defgroup pvTaskArenaAlloc pvTaskArenaAlloc
+ * \ingroup Arena
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	void *pvTaskArenaAlloc( size_t xSize ) PRIVILEGED_FUNCTION;
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ARENA_H */
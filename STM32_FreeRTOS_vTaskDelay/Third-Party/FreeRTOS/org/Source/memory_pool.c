@@ -0,0 +1,471 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "memory_pool.h"
+
+/* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
+because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+for the header files above, but not in this file, in order to generate the
+correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+to include memory pool functionality.  This #if is closed at the very bottom of
+this file.  If you want to include memory pools then ensure
+configUSE_MEMORY_POOLS is set to 1 in FreeRTOSConfig.h. */
+#if( configUSE_MEMORY_POOLS == 1 )
+
+#if( configUSE_COUNTING_SEMAPHORES != 1 )
+	#error configUSE_COUNTING_SEMAPHORES must be set to 1 in FreeRTOSConfig.h to use memory pools
+#endif
+
+/* The definition of the memory pool itself. */
+typedef struct MemoryPoolDef_t
+{
+	void *pvFreeList;						/*<< The first free block.  The first bytes of each free block hold a pointer to the next free block. */
+	uint8_t *pucStorage;					/*<< The start of the array of blocks. */
+	size_t xBlockSize;						/*<< The size of each block, rounded by memorypoolBLOCK_SIZE(). */
+	UBaseType_t uxBlockCount;				/*<< The number of blocks in the array. */
+	UBaseType_t uxFreeBlocks;				/*<< The number of blocks in the free list. */
+	UBaseType_t uxMinimumEverFreeBlocks;	/*<< The lowest value uxFreeBlocks has had. */
+	uint32_t ulAllocations;					/*<< The number of successful allocations. */
+	uint32_t ulFailedAllocations;			/*<< The number of allocations that returned NULL. */
+	uint32_t ulFrees;						/*<< The number of blocks freed. */
+	SemaphoreHandle_t xFreeBlockSemaphore;	/*<< A counting semaphore holding the number of blocks that can be allocated, on which tasks wait for a block. */
+	#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+		StaticSemaphore_t xSemaphoreBuffer;	/*<< The memory used by xFreeBlockSemaphore, so the pool only needs one allocation. */
+		uint8_t ucStaticallyAllocated;		/*<< Set to pdTRUE if the pool was created statically, so no attempt is made to free its memory when it is deleted. */
+	#endif
+} MemoryPool_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by both pool creation functions to fill in the pool's structure and
+ * link all its blocks into the free list.  Returns pdFAIL if the semaphore
+ * could not be created.
+ */
+static BaseType_t prvInitialiseNewMemoryPool( MemoryPool_t * const pxPool, size_t xBlockSize, UBaseType_t uxBlockCount, uint8_t * const pucStorage ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove a block from the free list, or return a block to it, and update the
+ * statistics.  Must be called with interrupts masked.
+ */
+static void *prvPopFreeBlock( MemoryPool_t * const pxPool ) PRIVILEGED_FUNCTION;
+static void prvPushFreeBlock( MemoryPool_t * const pxPool, void *pvBlock ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	MemoryPoolHandle_t xMemoryPoolCreate( size_t xBlockSize, UBaseType_t uxBlockCount )
+	{
+	MemoryPool_t *pxNewPool;
+	size_t xStructSize;
+
+		configASSERT( xBlockSize > ( size_t ) 0 );
+		configASSERT( uxBlockCount > ( UBaseType_t ) 0 );
+
+		/* The blocks follow the pool's structure in the same allocation, so
+		the structure's size is rounded up to keep the blocks aligned. */
+		xStructSize = ( sizeof( MemoryPool_t ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		pxNewPool = ( MemoryPool_t * ) pvPortMalloc( xStructSize + memorypoolSTORAGE_SIZE( xBlockSize, uxBlockCount ) ); /*lint !e9087 !e9079 pvPortMalloc() returns memory aligned to portBYTE_ALIGNMENT. */
+
+		if( pxNewPool != NULL )
+		{
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				/* Both static and dynamic allocation can be used, so note this
+				pool was allocated dynamically in case it is later deleted. */
+				pxNewPool->ucStaticallyAllocated = pdFALSE;
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+			if( prvInitialiseNewMemoryPool( pxNewPool, xBlockSize, uxBlockCount, ( ( uint8_t * ) pxNewPool ) + xStructSize ) == pdPASS )
+			{
+				traceMEMORY_POOL_CREATE( pxNewPool );
+			}
+			else
+			{
+				vPortFree( pxNewPool );
+				pxNewPool = NULL;
+				traceMEMORY_POOL_CREATE_FAILED();
+			}
+		}
+		else
+		{
+			traceMEMORY_POOL_CREATE_FAILED();
+		}
+
+		return pxNewPool;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+	MemoryPoolHandle_t xMemoryPoolCreateStatic( size_t xBlockSize, UBaseType_t uxBlockCount, uint8_t *pucPoolStorage, StaticMemoryPool_t *pxStaticMemoryPool )
+	{
+	MemoryPool_t *pxNewPool;
+
+		configASSERT( xBlockSize > ( size_t ) 0 );
+		configASSERT( uxBlockCount > ( UBaseType_t ) 0 );
+		configASSERT( pucPoolStorage );
+		configASSERT( pxStaticMemoryPool );
+		configASSERT( ( ( ( size_t ) pucPoolStorage ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+
+		#if( configASSERT_DEFINED == 1 )
+		{
+			/* Sanity check that the size of the structure used to declare a
+			variable of type StaticMemoryPool_t equals the size of the real
+			memory pool structure. */
+			volatile size_t xSize = sizeof( StaticMemoryPool_t );
+			configASSERT( xSize == sizeof( MemoryPool_t ) );
+			( void ) xSize; /* Keeps lint quiet when configASSERT() is not defined. */
+		}
+		#endif /* configASSERT_DEFINED */
+
+		pxNewPool = ( MemoryPool_t * ) pxStaticMemoryPool; /*lint !e740 !e9087 StaticMemoryPool_t is a pointer to a MemoryPool_t, so guaranteed to be aligned and sized correctly (checked by an assert()), so this is safe. */
+
+		#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		{
+			/* Both static and dynamic allocation can be used, so note this
+			pool was allocated statically in case it is later deleted. */
+			pxNewPool->ucStaticallyAllocated = pdTRUE;
+		}
+		#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+
+		/* The semaphore is created statically so cannot fail. */
+		( void ) prvInitialiseNewMemoryPool( pxNewPool, xBlockSize, uxBlockCount, pucPoolStorage );
+		traceMEMORY_POOL_CREATE( pxNewPool );
+
+		return pxNewPool;
+	}
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvInitialiseNewMemoryPool( MemoryPool_t * const pxPool, size_t xBlockSize, UBaseType_t uxBlockCount, uint8_t * const pucStorage )
+{
+BaseType_t xReturn;
+UBaseType_t ux;
+uint8_t *pucBlock;
+
+	pxPool->pucStorage = pucStorage;
+	pxPool->xBlockSize = memorypoolBLOCK_SIZE( xBlockSize );
+	pxPool->uxBlockCount = uxBlockCount;
+	pxPool->uxFreeBlocks = uxBlockCount;
+	pxPool->uxMinimumEverFreeBlocks = uxBlockCount;
+	pxPool->ulAllocations = 0UL;
+	pxPool->ulFailedAllocations = 0UL;
+	pxPool->ulFrees = 0UL;
+
+	/* Link the blocks into the free list in address order, the last block
+	first, so the first block is allocated first. */
+	pxPool->pvFreeList = NULL;
+	pucBlock = pucStorage + ( pxPool->xBlockSize * ( size_t ) uxBlockCount );
+
+	for( ux = ( UBaseType_t ) 0; ux < uxBlockCount; ux++ )
+	{
+		pucBlock -= pxPool->xBlockSize;
+		*( ( void ** ) pucBlock ) = pxPool->pvFreeList; /*lint !e9087 The block is aligned to portBYTE_ALIGNMENT so can hold a pointer. */
+		pxPool->pvFreeList = pucBlock;
+	}
+
+	/* The semaphore uses the memory inside the pool's structure when static
+	allocation is available, so a dynamically created pool still only needs
+	one allocation. */
+	#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	{
+		pxPool->xFreeBlockSemaphore = xSemaphoreCreateCountingStatic( uxBlockCount, uxBlockCount, &( pxPool->xSemaphoreBuffer ) );
+	}
+	#else
+	{
+		pxPool->xFreeBlockSemaphore = xSemaphoreCreateCounting( uxBlockCount, uxBlockCount );
+	}
+	#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+	if( pxPool->xFreeBlockSemaphore != NULL )
+	{
+		xReturn = pdPASS;
+	}
+	else
+	{
+		xReturn = pdFAIL;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void *pvMemoryPoolAlloc( MemoryPoolHandle_t xMemoryPool, TickType_t xTicksToWait )
+{
+MemoryPool_t * const pxPool = xMemoryPool;
+void *pvReturn;
+
+	configASSERT( pxPool );
+
+	/* Taking the semaphore reserves one of the free blocks, so the free list
+	cannot be empty once it has been taken. */
+	if( xSemaphoreTake( pxPool->xFreeBlockSemaphore, xTicksToWait ) != pdFALSE )
+	{
+		taskENTER_CRITICAL();
+		{
+			pvReturn = prvPopFreeBlock( pxPool );
+		}
+		taskEXIT_CRITICAL();
+	}
+	else
+	{
+		taskENTER_CRITICAL();
+		{
+			( pxPool->ulFailedAllocations )++;
+		}
+		taskEXIT_CRITICAL();
+
+		pvReturn = NULL;
+	}
+
+	traceMEMORY_POOL_ALLOC( pxPool, pvReturn );
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void *pvMemoryPoolAllocFromISR( MemoryPoolHandle_t xMemoryPool )
+{
+MemoryPool_t * const pxPool = xMemoryPool;
+UBaseType_t uxSavedInterruptStatus;
+void *pvReturn;
+
+	configASSERT( pxPool );
+
+	/* Tasks never wait to give the semaphore, so taking it cannot unblock a
+	task. */
+	if( xSemaphoreTakeFromISR( pxPool->xFreeBlockSemaphore, NULL ) != pdFALSE )
+	{
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			pvReturn = prvPopFreeBlock( pxPool );
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+	else
+	{
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			( pxPool->ulFailedAllocations )++;
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		pvReturn = NULL;
+	}
+
+	traceMEMORY_POOL_ALLOC( pxPool, pvReturn );
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vMemoryPoolFree( MemoryPoolHandle_t xMemoryPool, void *pvBlock )
+{
+MemoryPool_t * const pxPool = xMemoryPool;
+
+	configASSERT( pxPool );
+
+	if( pvBlock != NULL )
+	{
+		traceMEMORY_POOL_FREE( pxPool, pvBlock );
+
+		/* The block is returned to the free list before the semaphore is
+		given, so a task unblocked by the semaphore finds it there. */
+		taskENTER_CRITICAL();
+		{
+			prvPushFreeBlock( pxPool, pvBlock );
+		}
+		taskEXIT_CRITICAL();
+
+		( void ) xSemaphoreGive( pxPool->xFreeBlockSemaphore );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vMemoryPoolFreeFromISR( MemoryPoolHandle_t xMemoryPool, void *pvBlock, BaseType_t *pxHigherPriorityTaskWoken )
+{
+MemoryPool_t * const pxPool = xMemoryPool;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxPool );
+
+	if( pvBlock != NULL )
+	{
+		traceMEMORY_POOL_FREE( pxPool, pvBlock );
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			prvPushFreeBlock( pxPool, pvBlock );
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		( void ) xSemaphoreGiveFromISR( pxPool->xFreeBlockSemaphore, pxHigherPriorityTaskWoken );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxMemoryPoolGetFreeBlocks( MemoryPoolHandle_t xMemoryPool )
+{
+MemoryPool_t * const pxPool = xMemoryPool;
+
+	configASSERT( pxPool );
+	return pxPool->uxFreeBlocks;
+}
+/*-----------------------------------------------------------*/
+
+void vMemoryPoolGetStats( MemoryPoolHandle_t xMemoryPool, MemoryPoolStats_t *pxStats )
+{
+MemoryPool_t * const pxPool = xMemoryPool;
+
+	configASSERT( pxPool );
+	configASSERT( pxStats );
+
+	/* Take a consistent copy, as the counters can be updated from
+	interrupts. */
+	taskENTER_CRITICAL();
+	{
+		pxStats->xBlockSize = pxPool->xBlockSize;
+		pxStats->uxBlockCount = pxPool->uxBlockCount;
+		pxStats->uxFreeBlocks = pxPool->uxFreeBlocks;
+		pxStats->uxMinimumEverFreeBlocks = pxPool->uxMinimumEverFreeBlocks;
+		pxStats->ulAllocations = pxPool->ulAllocations;
+		pxStats->ulFailedAllocations = pxPool->ulFailedAllocations;
+		pxStats->ulFrees = pxPool->ulFrees;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vMemoryPoolDelete( MemoryPoolHandle_t xMemoryPool )
+{
+MemoryPool_t * const pxPool = xMemoryPool;
+
+	configASSERT( pxPool );
+	traceMEMORY_POOL_DELETE( pxPool );
+
+	vSemaphoreDelete( pxPool->xFreeBlockSemaphore );
+
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+	{
+		/* The pool can only have been allocated dynamically - free it
+		again. */
+		vPortFree( pxPool );
+	}
+	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	{
+		/* The pool could have been allocated statically or dynamically, so
+		check before attempting to free the memory. */
+		if( pxPool->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			vPortFree( pxPool );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+static void *prvPopFreeBlock( MemoryPool_t * const pxPool )
+{
+void *pvBlock;
+
+	/* The caller has taken the semaphore, so a free block exists. */
+	pvBlock = pxPool->pvFreeList;
+	configASSERT( pvBlock );
+	pxPool->pvFreeList = *( ( void ** ) pvBlock );
+
+	( pxPool->uxFreeBlocks )--;
+	( pxPool->ulAllocations )++;
+
+	if( pxPool->uxFreeBlocks < pxPool->uxMinimumEverFreeBlocks )
+	{
+		pxPool->uxMinimumEverFreeBlocks = pxPool->uxFreeBlocks;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pvBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvPushFreeBlock( MemoryPool_t * const pxPool, void *pvBlock )
+{
+	/* Check the block belongs to this pool.  A block freed twice is caught
+	if it is still the first free block, or if freeing it again would leave
+	more free blocks than the pool holds - finding it anywhere else in the
+	free list would take a walk of the list. */
+	configASSERT( ( ( uint8_t * ) pvBlock >= pxPool->pucStorage ) && ( ( uint8_t * ) pvBlock < ( pxPool->pucStorage + ( pxPool->xBlockSize * ( size_t ) pxPool->uxBlockCount ) ) ) );
+	configASSERT( ( ( size_t ) ( ( uint8_t * ) pvBlock - pxPool->pucStorage ) % pxPool->xBlockSize ) == ( size_t ) 0 );
+	configASSERT( pvBlock != pxPool->pvFreeList );
+	configASSERT( pxPool->uxFreeBlocks < pxPool->uxBlockCount );
+
+	*( ( void ** ) pvBlock ) = pxPool->pvFreeList;
+	pxPool->pvFreeList = pvBlock;
+
+	( pxPool->uxFreeBlocks )++;
+	( pxPool->ulFrees )++;
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+to include memory pool functionality.  If you want to include memory pools
+then ensure configUSE_MEMORY_POOLS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_MEMORY_POOLS == 1 */
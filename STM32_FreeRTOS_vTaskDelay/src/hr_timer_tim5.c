@@ -0,0 +1,82 @@
+/**
+  ******************************************************************************
+  * @file    hr_timer_tim5.c
+  * @brief   TIM5 compare backend for the FreeRTOS high resolution timers.
+  ******************************************************************************
+*/
+#include<string.h>
+#include<stdint.h>
+#include "stm32f4xx.h"
+
+#include "FreeRTOS.h"
+#include "hr_timers.h"
+
+//TIM5 is a 32-bit timer, so it counts the full range of the kernel's expiry
+//counts. Channel 1 compare generates the interrupt for the next timer to expire.
+
+void vConfigureHRTimer(void)
+{
+	TIM_TimeBaseInitTypeDef tim5_init;
+	TIM_OCInitTypeDef tim5_oc1_init;
+	RCC_ClocksTypeDef clocks;
+	uint32_t tim_clock;
+
+	//1. Enable the TIM5 peripheral clock
+	RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM5, ENABLE);
+
+	//2. APB1 timers run at twice PCLK1 unless the APB1 prescaler is 1
+	RCC_GetClocksFreq(&clocks);
+	tim_clock = clocks.PCLK1_Frequency;
+	if((RCC->CFGR & RCC_CFGR_PPRE1) != RCC_CFGR_PPRE1_DIV1)
+	{
+		tim_clock *= 2;
+	}
+
+	//3. Free running up counter at configHR_TIMER_COUNT_RATE_HZ over the full 32 bits
+	memset(&tim5_init, 0, sizeof(tim5_init));
+	tim5_init.TIM_Prescaler = (uint16_t)((tim_clock / configHR_TIMER_COUNT_RATE_HZ) - 1);
+	tim5_init.TIM_CounterMode = TIM_CounterMode_Up;
+	tim5_init.TIM_Period = 0xFFFFFFFF;
+	tim5_init.TIM_ClockDivision = TIM_CKD_DIV1;
+	TIM_TimeBaseInit(TIM5, &tim5_init);
+
+	//4. Channel 1 compare without an output pin, and without preload so a new
+	//compare value takes effect immediately
+	TIM_OCStructInit(&tim5_oc1_init);
+	tim5_oc1_init.TIM_OCMode = TIM_OCMode_Timing;
+	TIM_OC1Init(TIM5, &tim5_oc1_init);
+	TIM_OC1PreloadConfig(TIM5, TIM_OCPreload_Disable);
+
+	//5. The callbacks call FreeRTOS API functions, so the interrupt must not be
+	//above configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+	TIM_ClearITPendingBit(TIM5, TIM_IT_CC1);
+	NVIC_SetPriority(TIM5_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY);
+	NVIC_EnableIRQ(TIM5_IRQn);
+
+	TIM_Cmd(TIM5, ENABLE);
+}
+
+uint32_t ulGetHRTimerCount(void)
+{
+	return TIM_GetCounter(TIM5);
+}
+
+void vSetHRTimerCompare(uint32_t ulCompareValue)
+{
+	//clear a match against the previous compare value, the kernel checks for
+	//the counter passing the new one before it could be written
+	TIM_SetCompare1(TIM5, ulCompareValue);
+	TIM_ClearITPendingBit(TIM5, TIM_IT_CC1);
+	TIM_ITConfig(TIM5, TIM_IT_CC1, ENABLE);
+}
+
+void vDisableHRTimerCompare(void)
+{
+	TIM_ITConfig(TIM5, TIM_IT_CC1, DISABLE);
+}
+
+void TIM5_IRQHandler(void)
+{
+	TIM_ClearITPendingBit(TIM5, TIM_IT_CC1);
+	portYIELD_FROM_ISR(xHRTimerProcessCompareInterrupt());
+}
@@ -0,0 +1,319 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * High resolution timers are one-shot timers that expire at a time measured
+ * by a free running hardware counter, rather than by the RTOS tick count, so
+ * their resolution is that of the counter (typically one microsecond) and not
+ * that of configTICK_RATE_HZ.  The callback of a high resolution timer
+ * executes in the counter's compare interrupt, and the timer can also be set to
+ * give a task notification to a task when it expires.
+ *
+ * The counter is provided by the port layer or application, which must define
+ * the following macros in FreeRTOSConfig.h when configUSE_HR_TIMERS is 1:
+ *
+ * portCONFIGURE_HR_TIMER() - Start a free running, up counting, 32-bit counter
+ * that increments configHR_TIMER_COUNT_RATE_HZ times a second, and enable its
+ * compare interrupt.  Called before the first high resolution timer is
+ * created.
+ *
+ * portGET_HR_TIMER_COUNT() - Return the current value of the counter.
+ *
+ * portSET_HR_TIMER_COMPARE( ulCompareValue ) - Arrange for the compare
+ * interrupt to execute when the counter next equals ulCompareValue.  The
+ * interrupt handler must clear the interrupt, then call
+ * xHRTimerProcessCompareInterrupt() and pass its return value to
+ * portYIELD_FROM_ISR().  The interrupt must not have a logical priority above
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ *
+ * portDISABLE_HR_TIMER_COMPARE() - Optional.  Stop the compare interrupt from
+ * executing again until portSET_HR_TIMER_COMPARE() is next called.  Used when
+ * no high resolution timers are active.
+ */
+
+#ifndef HR_TIMERS_H
+#define HR_TIMERS_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h must appear in source files before include hr_timers.h"
+#endif
+
+/*lint -save -e537 This headers are only multiply included if the application code
+happens to also be including task.h. */
+#include "task.h"
+/*lint -restore */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*-----------------------------------------------------------
+ * MACROS AND DEFINITIONS
+ *----------------------------------------------------------*/
+
+/* Converts a time in microseconds to a number of high resolution timer
+counts. */
+#define hrUS_TO_COUNTS( xTimeInUs ) ( ( uint32_t ) ( ( ( uint64_t ) ( xTimeInUs ) * ( uint64_t ) configHR_TIMER_COUNT_RATE_HZ ) / ( uint64_t ) 1000000 ) )
+
+/**
+ * Type by which high resolution timers are referenced.
+ */
+struct HRTimerDefinition;
+typedef struct HRTimerDefinition * HRTimerHandle_t;
+
+/*
+ * Defines the prototype to which high resolution timer callback functions must
+ * conform.  The callback executes in the compare interrupt, so may only call
+ * interrupt safe API functions.  *pxHigherPriorityTaskWoken should be passed
+ * to any of those functions that can unblock a task, as it is used to request
+ * a context switch when the interrupt exits.
+ */
+typedef void (*HRTimerCallbackFunction_t)( HRTimerHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken );
+
+/**
+ * HRTimerHandle_t xHRTimerCreate( HRTimerCallbackFunction_t pxCallbackFunction,
+ *                                 void *pvTimerID );
+ *
+ * Creates a new high resolution one-shot timer, and returns a handle by which
+ * it can be referenced.  The memory for the timer is allocated from the
+ * FreeRTOS heap.  The timer is created dormant - it does not run until it is
+ * started with xHRTimerStart() or xHRTimerStartAt().
+ *
+ * @param pxCallbackFunction The function to call from the compare interrupt
+ * when the timer expires, or NULL if the timer only gives a task notification
+ * (see vHRTimerSetTaskToNotify()).
+ *
+ * @param pvTimerID An identifier assigned to the timer, which can be read
+ * with pvHRTimerGetTimerID().
+ *
+ * @return The handle of the timer, or NULL if there was insufficient heap
+ * memory.
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	HRTimerHandle_t xHRTimerCreate( HRTimerCallbackFunction_t pxCallbackFunction, void * const pvTimerID ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * HRTimerHandle_t xHRTimerCreateStatic( HRTimerCallbackFunction_t pxCallbackFunction,
+ *                                       void *pvTimerID,
+ *                                       StaticHRTimer_t *pxTimerBuffer );
+ *
+ * As xHRTimerCreate(), but the memory for the timer is provided by the
+ * application in pxTimerBuffer, which must remain valid for as long as the
+ * timer is used.
+ */
+#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	HRTimerHandle_t xHRTimerCreateStatic( HRTimerCallbackFunction_t pxCallbackFunction, void * const pvTimerID, StaticHRTimer_t *pxTimerBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * void vHRTimerDelete( HRTimerHandle_t xTimer );
+ *
+ * Stops xTimer if it is active, then frees its memory if it was created with
+ * xHRTimerCreate().
+ */
+void vHRTimerDelete( HRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * BaseType_t xHRTimerStartAt( HRTimerHandle_t xTimer, uint32_t ulExpiryCount );
+ *
+ * Starts xTimer so it expires when the high resolution counter reaches
+ * ulExpiryCount, or restarts it with that expiry count if it is already
+ * active.  ulExpiryCount must be less than 2^31 counts after the current count.
+ * If ulExpiryCount has already passed the timer expires as soon as the compare
+ * interrupt can execute.
+ *
+ * Timers are kept sorted by expiry count, and the compare interrupt is only
+ * set for the timer that expires first, so the cost of starting a timer grows
+ * with the number of active timers while the cost of each expiry does not.
+ *
+ * As the expiry count is absolute, a callback can restart its own timer a
+ * fixed number of counts after its previous expiry count, using
+ * xHRTimerStartAtFromISR() and ulHRTimerGetExpiryCount(), to generate a
+ * periodic event that does not drift.
+ *
+ * @param xTimer The timer being started.
+ *
+ * @param ulExpiryCount The counter value at which the timer expires.
+ *
+ * @return pdPASS.
+ */
+BaseType_t xHRTimerStartAt( HRTimerHandle_t xTimer, const uint32_t ulExpiryCount ) PRIVILEGED_FUNCTION;
+
+/**
+ * BaseType_t xHRTimerStartAtFromISR( HRTimerHandle_t xTimer, uint32_t ulExpiryCount );
+ *
+ * A version of xHRTimerStartAt() that can be called from an interrupt service
+ * routine, including from a high resolution timer callback.
+ */
+BaseType_t xHRTimerStartAtFromISR( HRTimerHandle_t xTimer, const uint32_t ulExpiryCount ) PRIVILEGED_FUNCTION;
+
+/**
+ * BaseType_t xHRTimerStart( HRTimerHandle_t xTimer, uint32_t ulCounts );
+ *
+ * Starts xTimer so it expires ulCounts high resolution counts from now.  See
+ * xHRTimerStartAt().
+ *
+ * Example usage:
+ * @verbatim
+ *     // Deassert the chip select 150us after a transfer is started.
+ *     static void prvEndTransfer( HRTimerHandle_t xTimer, BaseType_t *pxHigherPriorityTaskWoken )
+ *     {
+ *         vChipSelect( pdFALSE );
+ *     }
+ *
+ *     void vStartTransfer( void )
+ *     {
+ *         vChipSelect( pdTRUE );
+ *         xHRTimerStart( xCSTimer, hrUS_TO_COUNTS( 150 ) );
+ *     }
+ * @endverbatim
+ */
+#define xHRTimerStart( xTimer, ulCounts ) xHRTimerStartAt( ( xTimer ), ( ulHRTimerGetCount() + ( ulCounts ) ) )
+
+/**
+ * BaseType_t xHRTimerStartFromISR( HRTimerHandle_t xTimer, uint32_t ulCounts );
+ *
+ * A version of xHRTimerStart() that can be called from an interrupt service
+ * routine.
+ */
+#define xHRTimerStartFromISR( xTimer, ulCounts ) xHRTimerStartAtFromISR( ( xTimer ), ( ulHRTimerGetCount() + ( ulCounts ) ) )
+
+/**
+ * BaseType_t xHRTimerStop( HRTimerHandle_t xTimer );
+ *
+ * Stops xTimer if it is active.  Its callback will not execute unless it is
+ * started again.
+ *
+ * @return pdPASS if the timer was active, otherwise pdFAIL.
+ */
+BaseType_t xHRTimerStop( HRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * BaseType_t xHRTimerStopFromISR( HRTimerHandle_t xTimer );
+ *
+ * A version of xHRTimerStop() that can be called from an interrupt service
+ * routine.
+ */
+BaseType_t xHRTimerStopFromISR( HRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * BaseType_t xHRTimerIsTimerActive( HRTimerHandle_t xTimer );
+ *
+ * @return pdFALSE if xTimer is dormant, otherwise pdTRUE.  A high resolution
+ * timer is dormant from when it is created, stopped or expires until it is
+ * next started.
+ */
+BaseType_t xHRTimerIsTimerActive( HRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * uint32_t ulHRTimerGetExpiryCount( HRTimerHandle_t xTimer );
+ *
+ * @return The counter value at which xTimer expires, or last expired if it is
+ * dormant.
+ */
+uint32_t ulHRTimerGetExpiryCount( HRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * uint32_t ulHRTimerGetCount( void );
+ *
+ * @return The current value of the high resolution counter.
+ */
+uint32_t ulHRTimerGetCount( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * void *pvHRTimerGetTimerID( HRTimerHandle_t xTimer );
+ *
+ * @return The identifier passed as pvTimerID when xTimer was created.
+ */
+void *pvHRTimerGetTimerID( const HRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+
+/**
+ * void vHRTimerSetTaskToNotify( HRTimerHandle_t xTimer,
+ *                               TaskHandle_t xTaskToNotify,
+ *                               UBaseType_t uxIndexToNotify );
+ *
+ * configUSE_TASK_NOTIFICATIONS must be set to 1 for this function to be
+ * available.
+ *
+ * Sets a task to which xTimer gives a task notification, as if by
+ * vTaskNotifyGiveIndexedFromISR(), each time it expires, after its callback (if
+ * any) has executed.  The task can wait for the timer with
+ * ulTaskNotifyTakeIndexed().  Pass xTaskToNotify as NULL to stop giving
+ * notifications.
+ *
+ * @param xTimer The timer being updated.
+ *
+ * @param xTaskToNotify The task to notify.
+ *
+ * @param uxIndexToNotify The index within the task's array of notification
+ * values to which the notification is given.
+ */
+#if( configUSE_TASK_NOTIFICATIONS == 1 )
+	void vHRTimerSetTaskToNotify( HRTimerHandle_t xTimer, TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * void vHRTimerDelay( uint32_t ulCounts );
+ *
+ * configUSE_TASK_NOTIFICATIONS must be set to 1 for this function to be
+ * available.
+ *
+ * Places the calling task into the Blocked state for ulCounts high resolution
+ * counts, so the task can be delayed far more precisely than vTaskDelay()
+ * allows.  The task waits on notification index
+ * configHR_TIMER_NOTIFICATION_INDEX, which should not be used for anything
+ * else.
+ *
+ * Example usage:
+ * @verbatim
+ *     // Hold the reset line low for 250us.
+ *     vResetLine( pdTRUE );
+ *     vHRTimerDelay( hrUS_TO_COUNTS( 250 ) );
+ *     vResetLine( pdFALSE );
+ * @endverbatim
+ */
+#if( configUSE_TASK_NOTIFICATIONS == 1 )
+	void vHRTimerDelay( const uint32_t ulCounts ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Functions beyond this part are not part of the public API and are intended
+ * for use by the port layer only.
+ */
+
+/*
+ * Called by the compare interrupt handler to execute the callbacks of the
+ * timers that have expired.  Returns pdTRUE if a context switch should be
+ * requested before the interrupt exits.
+ */
+BaseType_t xHRTimerProcessCompareInterrupt( void ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* HR_TIMERS_H */
@@ -50,7 +50,9 @@ extern "C" {
 be used solely through the macros that make up the public software timer API,
 as defined below.  The commands that are sent from interrupts must use the
 highest numbers as tmrFIRST_FROM_ISR_COMMAND is used to determine if the task
-or interrupt version of the queue send function should be used. */
+or interrupt version of the queue send function should be used.  Command
+batches are sent by xTimerGenericBatchCommand(), which makes that choice
+itself. */
 #define tmrCOMMAND_EXECUTE_CALLBACK_FROM_ISR 	( ( BaseType_t ) -2 )
 #define tmrCOMMAND_EXECUTE_CALLBACK				( ( BaseType_t ) -1 )
 #define tmrCOMMAND_START_DONT_TRACE				( ( BaseType_t ) 0 )
@@ -66,6 +68,9 @@ or interrupt version of the queue send function should be used. */
 #define tmrCOMMAND_STOP_FROM_ISR				( ( BaseType_t ) 8 )
 #define tmrCOMMAND_CHANGE_PERIOD_FROM_ISR		( ( BaseType_t ) 9 )
 
+#define tmrCOMMAND_BATCH						( ( BaseType_t ) 10 )
+#define tmrCOMMAND_BATCH_FROM_ISR				( ( BaseType_t ) 11 )
+
 
 /**
  * Type by which software timers are referenced.  For example, a call to
@@ -87,6 +92,33 @@ typedef void (*TimerCallbackFunction_t)( TimerHandle_t xTimer );
  */
 typedef void (*PendedFunction_t)( void *, uint32_t );
 
+#if( configUSE_TIMER_SLACK == 1 )
+	/*
+	 * Used with vTimerGetWakeStats() to report how many times the timer
+	 * service/daemon task has woken to process expired timers, and how many of
+	 * those wake ups were saved by timer slack.
+	 */
+	typedef struct xTIMER_WAKE_STATS
+	{
+		uint32_t ulWakeUps;			/* The number of times the timer service task unblocked and then processed expired timers. */
+		uint32_t ulExpiryTimes;		/* The number of different expiry times processed.  Without slack each would need a wake up of its own. */
+		uint32_t ulWakeUpsSaved;	/* ulExpiryTimes minus ulWakeUps. */
+	} TimerWakeStats_t;
+#endif
+
+#if( configUSE_TIMER_COMMAND_BATCHES == 1 )
+	/*
+	 * One entry in the array of commands passed to xTimerSendCommandBatch()
+	 * and xTimerSendCommandBatchFromISR().
+	 */
+	typedef struct xTIMER_BATCH_COMMAND
+	{
+		TimerHandle_t xTimer;		/* The timer the command is applied to. */
+		BaseType_t xCommandID;		/* tmrCOMMAND_START, tmrCOMMAND_RESET, tmrCOMMAND_STOP or tmrCOMMAND_CHANGE_PERIOD. */
+		TickType_t xNewPeriod;		/* The new period of the timer if xCommandID is tmrCOMMAND_CHANGE_PERIOD, otherwise not used. */
+	} TimerBatchCommand_t;
+#endif
+
 /**
  * TimerHandle_t xTimerCreate( 	const char * const pcTimerName,
  * 								TickType_t xTimerPeriodInTicks,
@@ -363,6 +395,92 @@ typedef void (*PendedFunction_t)( void *, uint32_t );
 										StaticTimer_t *pxTimerBuffer ) PRIVILEGED_FUNCTION;
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * TimerHandle_t xTimerCreateTickContext(	const char * const pcTimerName,
+ * 											TickType_t xTimerPeriodInTicks,
+ * 											UBaseType_t uxAutoReload,
+ * 											void * pvTimerID,
+ * 											TimerCallbackFunction_t pxCallbackFunction );
+ *
+ * TimerHandle_t xTimerCreateTickContextStatic(	const char * const pcTimerName,
+ * 												TickType_t xTimerPeriodInTicks,
+ * 												UBaseType_t uxAutoReload,
+ * 												void * pvTimerID,
+ * 												TimerCallbackFunction_t pxCallbackFunction,
+ * 												StaticTimer_t *pxTimerBuffer );
+ *
+ * configUSE_TICK_CONTEXT_TIMERS must be set to 1 in FreeRTOSConfig.h for these
+ * functions to be available.
+ *
+ * Create a software timer whose callback function executes directly from the
+ * tick interrupt, rather than from the timer service/daemon task.  The
+ * callback therefore runs on time regardless of the priority of the timer
+ * service task, or of how many commands are waiting for it, and no context
+ * switch is needed to run it.  The parameters and return value are the same
+ * as for xTimerCreate() and xTimerCreateStatic(), except the period cannot be
+ * more than half the range of TickType_t.
+ *
+ * xTimerStart(), xTimerStop(), xTimerReset(), xTimerChangePeriod() and their
+ * FromISR() versions do not send a command to the timer service task when used
+ * with a tick context timer.  Instead they update the timer directly, with
+ * interrupts masked for only a few instructions, so they never block and never
+ * fail, and their xTicksToWait parameter is ignored.  A command from an
+ * interrupt that arrives while the tick interrupt is processing the expiry of
+ * the timer takes effect, but the callback for that expiry still executes.
+ * xTimerDelete() frees the timer immediately.
+ *
+ * The callback function executes inside the tick interrupt so it must be
+ * short, must not block, and must only call interrupt safe API functions (those
+ * that end in "FromISR").  In particular it must not call pvTimerGetTimerID()
+ * or vTimerSetTimerID().  If the callback unblocks a task that has a priority
+ * above that of the interrupted task then a context switch is performed when
+ * the tick interrupt exits, so the pxHigherPriorityTaskWoken parameter of the
+ * FromISR() functions can be set to NULL.  At most
+ * configTICK_CONTEXT_TIMER_BUDGET callbacks execute in any one tick, and any
+ * other timers that are due are processed in the following ticks.
+ *
+ * Callbacks continue to execute while the scheduler is suspended.
+ *
+ * Example usage:
+ * @verbatim
+ * // Toggle an LED every 100 ticks from the tick interrupt.
+ * void vLEDTimerCallback( TimerHandle_t xTimer )
+ * {
+ *     vToggleLED();
+ * }
+ *
+ * void vStartLEDTimer( void )
+ * {
+ * TimerHandle_t xLEDTimer;
+ *
+ *     xLEDTimer = xTimerCreateTickContext( "LED", 100, pdTRUE, NULL, vLEDTimerCallback );
+ *
+ *     if( xLEDTimer != NULL )
+ *     {
+ *         // Starts the timer directly, without sending a command to the
+ *         // timer service task.
+ *         xTimerStart( xLEDTimer, 0 );
+ *     }
+ * }
+ * @endverbatim
+ */
+#if( ( configUSE_TICK_CONTEXT_TIMERS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+	TimerHandle_t xTimerCreateTickContext(	const char * const pcTimerName,	/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+											const TickType_t xTimerPeriodInTicks,
+											const UBaseType_t uxAutoReload,
+											void * const pvTimerID,
+											TimerCallbackFunction_t pxCallbackFunction ) PRIVILEGED_FUNCTION;
+#endif
+
+#if( ( configUSE_TICK_CONTEXT_TIMERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	TimerHandle_t xTimerCreateTickContextStatic(	const char * const pcTimerName,	/*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+													const TickType_t xTimerPeriodInTicks,
+													const UBaseType_t uxAutoReload,
+													void * const pvTimerID,
+													TimerCallbackFunction_t pxCallbackFunction,
+													StaticTimer_t *pxTimerBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * void *pvTimerGetTimerID( TimerHandle_t xTimer );
  *
@@ -451,6 +569,88 @@ BaseType_t xTimerIsTimerActive( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t xTimerGetTimerDaemonTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * TaskHandle_t xTimerGetTimerServiceTaskHandle( UBaseType_t uxService );
+ *
+ * Returns the handle of timer service task uxService, where uxService is from
+ * 0 to configTIMER_SERVICE_TASKS - 1.  Timer service task 0 is the task
+ * returned by xTimerGetTimerDaemonTaskHandle().  It is not valid to call
+ * xTimerGetTimerServiceTaskHandle() before the scheduler has been started.
+ */
+TaskHandle_t xTimerGetTimerServiceTaskHandle( UBaseType_t uxService ) PRIVILEGED_FUNCTION;
+
+/**
+ * BaseType_t xTimerSetServiceTask( TimerHandle_t xTimer, UBaseType_t uxService );
+ *
+ * configTIMER_SERVICE_TASKS must be set to more than 1 in FreeRTOSConfig.h for
+ * xTimerSetServiceTask() to be available.
+ *
+ * When configTIMER_SERVICE_TASKS is greater than 1 the kernel creates that
+ * many timer service tasks, each with its own command queue and its own
+ * active timers.  Timer service task n runs at priority
+ * configTIMER_SERVICE_TASK_PRIORITY( n ), so timers whose callbacks must run
+ * promptly can be serviced by a higher priority task than timers with long
+ * running callbacks, and never wait behind them.  Commands sent to a timer,
+ * for example by xTimerStart(), are sent to the timer service task that
+ * services the timer.
+ *
+ * Timers are created to be serviced by timer service task 0.
+ * xTimerSetServiceTask() selects a different timer service task.  The timer
+ * can only be moved while it is not active and every command sent to it has
+ * been processed by its current timer service task - for example, straight
+ * after the timer is created.  Otherwise the timer is left where it is and
+ * xTimerSetServiceTask() returns pdFAIL.  A timer that is running can be moved
+ * by stopping it, calling xTimerSetServiceTask() until it returns pdPASS (the
+ * stop command is pending until the current timer service task has processed
+ * it), then starting it again.
+ *
+ * If configSUPPORT_STATIC_ALLOCATION is 1 then, in addition to
+ * vApplicationGetTimerTaskMemory(), the application must provide
+ * vApplicationGetTimerServiceTaskMemory( UBaseType_t uxService,
+ * StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer,
+ * uint32_t *pulTimerTaskStackSize ), which is called to obtain the memory
+ * used by each timer service task other than task 0.
+ *
+ * @param xTimer The timer being updated.
+ *
+ * @param uxService The index of the timer service task that will service the
+ * timer, from 0 to configTIMER_SERVICE_TASKS - 1.
+ *
+ * @return pdPASS if the timer is now serviced by timer service task uxService,
+ * or pdFAIL if the timer was active or had commands pending, in which case it
+ * is still serviced by its previous timer service task.
+ *
+ * Example usage:
+ * @verbatim
+ * // In FreeRTOSConfig.h, a second timer service task above the first.
+ * #define configTIMER_SERVICE_TASKS 2
+ * #define configTIMER_SERVICE_TASK_PRIORITY( uxService ) ( ( uxService ) == 0 ? 2 : 6 )
+ *
+ * // The motor timer is serviced by the higher priority task, so its callback
+ * // does not wait behind slow callbacks of timers serviced by task 0.
+ * xMotorTimer = xTimerCreate( "Motor", pdMS_TO_TICKS( 5 ), pdTRUE, NULL, vMotorCallback );
+ * configASSERT( xTimerSetServiceTask( xMotorTimer, 1 ) == pdPASS );
+ * xTimerStart( xMotorTimer, 0 );
+ * @endverbatim
+ */
+#if( configTIMER_SERVICE_TASKS > 1 )
+	BaseType_t xTimerSetServiceTask( TimerHandle_t xTimer, UBaseType_t uxService ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * UBaseType_t uxTimerGetServiceTask( TimerHandle_t xTimer );
+ *
+ * configTIMER_SERVICE_TASKS must be set to more than 1 in FreeRTOSConfig.h for
+ * uxTimerGetServiceTask() to be available.
+ *
+ * @param xTimer The handle of the timer being queried.
+ *
+ * @return The index of the timer service task that services the timer.
+ */
+#if( configTIMER_SERVICE_TASKS > 1 )
+	UBaseType_t uxTimerGetServiceTask( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * BaseType_t xTimerStart( TimerHandle_t xTimer, TickType_t xTicksToWait );
  *
@@ -1095,6 +1295,109 @@ TaskHandle_t xTimerGetTimerDaemonTaskHandle( void ) PRIVILEGED_FUNCTION;
  */
 #define xTimerResetFromISR( xTimer, pxHigherPriorityTaskWoken ) xTimerGenericCommand( ( xTimer ), tmrCOMMAND_RESET_FROM_ISR, ( xTaskGetTickCountFromISR() ), ( pxHigherPriorityTaskWoken ), 0U )
 
+/**
+ * BaseType_t xTimerSendCommandBatch( const TimerBatchCommand_t *pxCommands,
+ *                                    UBaseType_t uxNumberOfCommands,
+ *                                    TickType_t xTicksToWait );
+ *
+ * configUSE_TIMER_COMMAND_BATCHES must be set to 1 in FreeRTOSConfig.h for
+ * xTimerSendCommandBatch() to be available.
+ *
+ * Sends an array of start, reset, stop and change period commands to the timer
+ * service/daemon task as a single item on the timer command queue.  The timer
+ * service task applies the whole batch in one pass, so starting or resetting
+ * many timers at once wakes the timer service task once and uses one space in
+ * the timer command queue, instead of one of each per timer.  The commands are
+ * applied in array order, and the start and reset commands are all referenced
+ * to the tick count at the time xTimerSendCommandBatch() was called, exactly
+ * as if xTimerStart() or xTimerReset() had been called for each timer at that
+ * time.  Unless configUSE_TIMER_WHEEL is 1, the timers started by a batch are
+ * sorted among themselves and then merged into the list of active timers in a
+ * single pass.
+ *
+ * The commands are copied into one of configTIMER_COMMAND_BATCH_SLOTS batch
+ * slots, each of which holds up to configTIMER_COMMAND_BATCH_LENGTH commands,
+ * so the array can be changed or reused as soon as xTimerSendCommandBatch()
+ * returns.  A slot is in use from the time the batch is sent until the timer
+ * service task has applied it.  The slots are shared by all the timer service
+ * tasks.
+ *
+ * All the timers in a batch must be serviced by the same timer service task
+ * (see xTimerSetServiceTask()), and tick context timers cannot be batched.
+ *
+ * @param pxCommands The array of commands.
+ *
+ * @param uxNumberOfCommands The number of commands in the pxCommands array,
+ * from 1 to configTIMER_COMMAND_BATCH_LENGTH.
+ *
+ * @param xTicksToWait The number of ticks the calling task should remain in
+ * the Blocked state to wait for a free batch slot and then for space in the
+ * timer command queue, in total.
+ *
+ * @return pdFAIL will be returned if a batch slot and space in the timer
+ * command queue could not both be obtained before xTicksToWait ticks passed,
+ * in which case none of the commands are applied.  pdPASS will be returned if
+ * the batch was successfully sent to the timer command queue.
+ *
+ * Example usage:
+ * @verbatim
+ *     // Re-arm the retransmit, keep alive and idle timers of a connection
+ *     // each time a packet is received.
+ *     typedef struct CONNECTION
+ *     {
+ *         TimerHandle_t xRetransmitTimer, xKeepAliveTimer, xIdleTimer;
+ *         TickType_t xIdleTimeout;
+ *     } Connection_t;
+ *
+ *     void vPacketReceived( Connection_t *pxConnection )
+ *     {
+ *     TimerBatchCommand_t xRearm[ 3 ];
+ *
+ *         xRearm[ 0 ].xTimer = pxConnection->xRetransmitTimer;
+ *         xRearm[ 0 ].xCommandID = tmrCOMMAND_STOP;
+ *         xRearm[ 1 ].xTimer = pxConnection->xKeepAliveTimer;
+ *         xRearm[ 1 ].xCommandID = tmrCOMMAND_RESET;
+ *         xRearm[ 2 ].xTimer = pxConnection->xIdleTimer;
+ *         xRearm[ 2 ].xCommandID = tmrCOMMAND_CHANGE_PERIOD;
+ *         xRearm[ 2 ].xNewPeriod = pxConnection->xIdleTimeout;
+ *
+ *         // xRearm is copied, so it can go out of scope when this function
+ *         // returns, before the timer service task has applied the batch.
+ *         if( xTimerSendCommandBatch( xRearm, 3, portMAX_DELAY ) != pdPASS )
+ *         {
+ *             // The timers were not re-armed.
+ *         }
+ *     }
+ * @endverbatim
+ */
+#define xTimerSendCommandBatch( pxCommands, uxNumberOfCommands, xTicksToWait ) xTimerGenericBatchCommand( ( pxCommands ), ( uxNumberOfCommands ), tmrCOMMAND_BATCH, ( xTaskGetTickCount() ), NULL, ( xTicksToWait ) )
+
+/**
+ * BaseType_t xTimerSendCommandBatchFromISR( const TimerBatchCommand_t *pxCommands,
+ *                                           UBaseType_t uxNumberOfCommands,
+ *                                           BaseType_t *pxHigherPriorityTaskWoken );
+ *
+ * A version of xTimerSendCommandBatch() that can be called from an interrupt
+ * service routine.  As with xTimerSendCommandBatch() the commands are copied,
+ * so the array can be reused as soon as the function returns.
+ *
+ * @param pxCommands The array of commands.
+ *
+ * @param uxNumberOfCommands The number of commands in the pxCommands array,
+ * from 1 to configTIMER_COMMAND_BATCH_LENGTH.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the batch caused
+ * the timer service/daemon task to leave the Blocked state and it has a
+ * priority equal to or greater than the currently executing task, in which
+ * case a context switch should be requested before the interrupt exits, as
+ * for xTimerStartFromISR().
+ *
+ * @return pdFAIL will be returned if every batch slot was in use or the timer
+ * command queue was already full.  pdPASS will be returned if the batch was
+ * successfully sent to the timer command queue.
+ */
+#define xTimerSendCommandBatchFromISR( pxCommands, uxNumberOfCommands, pxHigherPriorityTaskWoken ) xTimerGenericBatchCommand( ( pxCommands ), ( uxNumberOfCommands ), tmrCOMMAND_BATCH_FROM_ISR, ( xTaskGetTickCountFromISR() ), ( pxHigherPriorityTaskWoken ), 0U )
+
 
 /**
  * BaseType_t xTimerPendFunctionCallFromISR( PendedFunction_t xFunctionToPend,
@@ -1220,6 +1523,29 @@ BaseType_t xTimerPendFunctionCallFromISR( PendedFunction_t xFunctionToPend, void
   */
 BaseType_t xTimerPendFunctionCall( PendedFunction_t xFunctionToPend, void *pvParameter1, uint32_t ulParameter2, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/**
+ * BaseType_t xTimerPendFunctionCallToService( UBaseType_t uxService,
+ *                                             PendedFunction_t xFunctionToPend,
+ *                                             void *pvParameter1,
+ *                                             uint32_t ulParameter2,
+ *                                             TickType_t xTicksToWait );
+ *
+ * BaseType_t xTimerPendFunctionCallFromISRToService( UBaseType_t uxService,
+ *                                                    PendedFunction_t xFunctionToPend,
+ *                                                    void *pvParameter1,
+ *                                                    uint32_t ulParameter2,
+ *                                                    BaseType_t *pxHigherPriorityTaskWoken );
+ *
+ * As xTimerPendFunctionCall() and xTimerPendFunctionCallFromISR(), but the
+ * function is executed by timer service task uxService, where uxService is
+ * from 0 to configTIMER_SERVICE_TASKS - 1, so urgent deferred interrupt
+ * processing can be given its own higher priority timer service task.
+ * xTimerPendFunctionCall() and xTimerPendFunctionCallFromISR() use timer
+ * service task 0.  See xTimerSetServiceTask().
+ */
+BaseType_t xTimerPendFunctionCallToService( UBaseType_t uxService, PendedFunction_t xFunctionToPend, void *pvParameter1, uint32_t ulParameter2, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xTimerPendFunctionCallFromISRToService( UBaseType_t uxService, PendedFunction_t xFunctionToPend, void *pvParameter1, uint32_t ulParameter2, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /**
  * const char * const pcTimerGetName( TimerHandle_t xTimer );
  *
@@ -1257,6 +1583,84 @@ TickType_t xTimerGetPeriod( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 */
 TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 
+/**
+ * void vTimerSetSlack( TimerHandle_t xTimer, const TickType_t xSlack );
+ *
+ * configUSE_TIMER_SLACK must be set to 1 in FreeRTOSConfig.h for
+ * vTimerSetSlack() to be available.
+ *
+ * Sets the number of ticks by which the timer service/daemon task may run the
+ * timer's callback later than the timer's expiry time.  Timers created with
+ * xTimerCreate() or xTimerCreateStatic() have a slack of 0, so always run at
+ * their expiry time.
+ *
+ * The timer service task blocks until the earliest time at which a timer
+ * reaches the end of its slack, rather than until the earliest expiry time,
+ * then processes every timer that has expired by that time.  Timers whose
+ * slack windows overlap therefore share one wake up instead of each
+ * unblocking the timer service task separately, which saves context switches
+ * and lets tickless idle sleep for longer.  A timer that has expired is also
+ * processed whenever the timer service task runs to process a command, after
+ * the command - so stopping, resetting or changing the period of a timer that
+ * has expired but not yet been processed means its callback is not called for
+ * that expiry.
+ *
+ * Auto-reload timers are reloaded relative to their expiry time, not the time
+ * they were processed, so slack does not make a periodic timer drift.  Slack
+ * is not carried past the tick count overflowing, and has no effect on tick
+ * context timers.  The new slack is used from the next time the timer is
+ * started, reset or reloaded at the latest.
+ *
+ * @param xTimer The timer being updated.
+ *
+ * @param xSlack The number of ticks the timer may run late.
+ *
+ * Example usage:
+ * @verbatim
+ *     // A status LED that blinks roughly every second.  It does not matter if
+ *     // it runs up to 100ms late, so let it share wake ups with other timers.
+ *     xLEDTimer = xTimerCreate( "LED", pdMS_TO_TICKS( 1000 ), pdTRUE, NULL, vLEDTimerCallback );
+ *     vTimerSetSlack( xLEDTimer, pdMS_TO_TICKS( 100 ) );
+ *     xTimerStart( xLEDTimer, 0 );
+ * @endverbatim
+ */
+#if( configUSE_TIMER_SLACK == 1 )
+	void vTimerSetSlack( TimerHandle_t xTimer, const TickType_t xSlack ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * TickType_t xTimerGetSlack( TimerHandle_t xTimer );
+ *
+ * configUSE_TIMER_SLACK must be set to 1 in FreeRTOSConfig.h for
+ * xTimerGetSlack() to be available.
+ *
+ * @param xTimer The handle of the timer being queried.
+ *
+ * @return The slack set by vTimerSetSlack(), in ticks.
+ */
+#if( configUSE_TIMER_SLACK == 1 )
+	TickType_t xTimerGetSlack( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * void vTimerGetWakeStats( TimerWakeStats_t *pxStats );
+ *
+ * configUSE_TIMER_SLACK must be set to 1 in FreeRTOSConfig.h for
+ * vTimerGetWakeStats() to be available.
+ *
+ * Populates *pxStats with the number of times the timer service/daemon task
+ * has woken to process expired timers, the number of different expiry times
+ * it has processed, and the difference between the two - the number of wake
+ * ups saved by timer slack.  The counts include wake ups that processed
+ * expired timers while the timer service task was running to process a
+ * command.
+ *
+ * @param pxStats The structure into which the counts are written.
+ */
+#if( configUSE_TIMER_SLACK == 1 )
+	void vTimerGetWakeStats( TimerWakeStats_t *pxStats ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Functions beyond this part are not part of the public API and are intended
  * for use by the kernel only.
@@ -1264,6 +1668,19 @@ TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 BaseType_t xTimerCreateTimerTask( void ) PRIVILEGED_FUNCTION;
 BaseType_t xTimerGenericCommand( TimerHandle_t xTimer, const BaseType_t xCommandID, const TickType_t xOptionalValue, BaseType_t * const pxHigherPriorityTaskWoken, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_TIMER_COMMAND_BATCHES == 1 )
+	BaseType_t xTimerGenericBatchCommand( const TimerBatchCommand_t * const pxCommands, const UBaseType_t uxNumberOfCommands, const BaseType_t xCommandID, const TickType_t xCommandTime, BaseType_t * const pxHigherPriorityTaskWoken, const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif
+
+#if( configUSE_TICK_CONTEXT_TIMERS == 1 )
+	/*
+	 * Called from xTaskIncrementTick() on each tick interrupt, with the tick
+	 * count the interrupt represents, to execute the callbacks of any tick
+	 * context timers that are due.
+	 */
+	void vTimerProcessTickContextTimers( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+#endif
+
 #if( configUSE_TRACE_FACILITY == 1 )
 	void vTimerSetTimerNumber( TimerHandle_t xTimer, UBaseType_t uxTimerNumber ) PRIVILEGED_FUNCTION;
 	UBaseType_t uxTimerGetTimerNumber( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
@@ -30,8 +30,17 @@
  * (coalescences) adjacent memory blocks as they are freed, and in so doing
  * limits memory fragmentation.
  *
- * See heap_1.c, heap_2.c and heap_3.c for alternative implementations, and the
- * memory management pages of http://www.FreeRTOS.org for more information.
+ * By default the scheduler is suspended while the heap is in use.  If
+ * configHEAP_USE_CRITICAL_SECTIONS is set to 1 then interrupts are masked
+ * instead, but only while a few free blocks are examined at a time, so a task
+ * that is walking a long list of free blocks can be preempted.  Freed blocks of
+ * up to configHEAP_SMALL_BLOCK_MAX_SIZE bytes are also held in lists of blocks
+ * of the same size, from which they are allocated again without a search -
+ * including by pvPortMallocFromISR().
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_tlsf.c and heap_regions.c for
+ * alternative implementations, and the memory management pages of
+ * http://www.FreeRTOS.org for more information.
  */
 #include <stdlib.h>
 
@@ -45,6 +54,11 @@ task.h is included from an application file. */
 
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+/* This entire source file will be skipped if the application is configured to
+use heap_tlsf.c or heap_regions.c.  This #if is closed at the very bottom of
+this file. */
+#if( ( configUSE_TLSF_HEAP == 0 ) && ( configUSE_REGION_HEAP == 0 ) )
+
 #if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
 	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
 #endif
@@ -52,9 +66,44 @@ task.h is included from an application file. */
 /* Block sizes must not get too small. */
 #define heapMINIMUM_BLOCK_SIZE	( ( size_t ) ( xHeapStructSize << 1 ) )
 
+/* The number of free blocks examined each time the list of free blocks is
+locked while it is walked. */
+#define heapBLOCKS_PER_CRITICAL_SECTION	( ( UBaseType_t ) 16 )
+
+/* The number of times a walk of the list of free blocks is started again,
+because another task changed the list, before the scheduler is suspended so
+the walk can complete. */
+#define heapMAX_WALK_RESTARTS			( ( UBaseType_t ) 2 )
+
+#if( configHEAP_USE_CRITICAL_SECTIONS == 1 )
+
+	/* The list of free blocks is only changed with interrupts masked. */
+	#define heapLOCK_FREE_LIST()		taskENTER_CRITICAL()
+	#define heapUNLOCK_FREE_LIST()		taskEXIT_CRITICAL()
+
+	/* There is one small block list for each multiple of portBYTE_ALIGNMENT up
+	to configHEAP_SMALL_BLOCK_MAX_SIZE.  The index of the list that holds a
+	block is calculated from the size of the block, which includes its
+	BlockLink_t structure. */
+	#define heapSMALL_BLOCK_LIST_COUNT		( ( ( size_t ) configHEAP_SMALL_BLOCK_MAX_SIZE + ( size_t ) portBYTE_ALIGNMENT_MASK ) / ( size_t ) portBYTE_ALIGNMENT )
+	#define heapSMALL_BLOCK_INDEX( xBlockSize )	( ( ( ( xBlockSize ) - xHeapStructSize ) / ( size_t ) portBYTE_ALIGNMENT ) - ( size_t ) 1 )
+	#define heapIS_SMALL_BLOCK( xBlockSize )	( ( ( xBlockSize ) - xHeapStructSize ) <= ( heapSMALL_BLOCK_LIST_COUNT * ( size_t ) portBYTE_ALIGNMENT ) )
+
+#else
+
+	/* The list of free blocks is only changed with the scheduler suspended. */
+	#define heapLOCK_FREE_LIST()		vTaskSuspendAll()
+	#define heapUNLOCK_FREE_LIST()		( void ) xTaskResumeAll()
+
+#endif /* configHEAP_USE_CRITICAL_SECTIONS */
+
 /* Assumes 8bit bytes! */
 #define heapBITS_PER_BYTE		( ( size_t ) 8 )
 
+/* vPortGetHeapStats() counts free blocks of less than heapSTATS_FIRST_CLASS_LIMIT
+bytes in the first size class, and doubles the limit for each class after it. */
+#define heapSTATS_FIRST_CLASS_LIMIT	( ( size_t ) 32 )
+
 /* Allocate the memory for the heap. */
 #if( configAPPLICATION_ALLOCATED_HEAP == 1 )
 	/* The application writer has already defined the array used for the RTOS
@@ -80,7 +129,83 @@ typedef struct A_BLOCK_LINK
  * the block in front it and/or the block behind it if the memory blocks are
  * adjacent to each other.
  */
-static void prvInsertBlockIntoFreeList( BlockLink_t *pxBlockToInsert );
+#if( configHEAP_USE_CRITICAL_SECTIONS == 0 )
+	static void prvInsertBlockIntoFreeList( BlockLink_t *pxBlockToInsert );
+#endif
+
+/*
+ * Inserts pxBlockToInsert into the list of free blocks after pxIterator, which
+ * must be the free block with the highest address below pxBlockToInsert, and
+ * merges it with the blocks either side of it if they are adjacent.
+ */
+static void prvInsertBlockAfter( BlockLink_t *pxIterator, BlockLink_t *pxBlockToInsert );
+
+/*
+ * Takes pxBlock, which follows pxPreviousBlock in the list of free blocks, out
+ * of the list, splitting off and keeping in the list any part of it that is
+ * not needed to hold xWantedSize bytes.  Returns the memory that follows the
+ * block's BlockLink_t structure.
+ */
+static void *prvAllocateBlock( BlockLink_t *pxPreviousBlock, BlockLink_t *pxBlock, size_t xWantedSize );
+
+/*
+ * Adds xCount free blocks of xBlockSize bytes to the statistics being gathered
+ * by vPortGetHeapStats().
+ */
+static void prvCountFreeBlocks( HeapStats_t *pxHeapStats, size_t xBlockSize, size_t xCount );
+
+#if( configHEAP_USE_CRITICAL_SECTIONS == 1 )
+
+	/*
+	 * Walks the list of free blocks, masking interrupts only while up to
+	 * heapBLOCKS_PER_CRITICAL_SECTION blocks are examined at a time.  If
+	 * pxBlockToInsert is NULL the walk stops at the block before the first
+	 * block of at least xWantedSize bytes, or before pxEnd if there is no such
+	 * block.  Otherwise it stops at the block before the first block above
+	 * pxBlockToInsert.  Returns the block at which the walk stopped with
+	 * interrupts still masked, so the caller can update the list before any
+	 * other task can change it, then must call taskEXIT_CRITICAL().  If the
+	 * walk had to suspend the scheduler to complete then *pxSchedulerSuspended
+	 * is set to pdTRUE, and the caller must also call xTaskResumeAll().
+	 */
+	static BlockLink_t *prvWalkFreeList( size_t xWantedSize, const BlockLink_t *pxBlockToInsert, BaseType_t *pxSchedulerSuspended );
+
+	/*
+	 * Allocate a block of xBlockSize bytes from the list of free blocks, or
+	 * return a block to it.  Interrupts are only masked for short periods.
+	 */
+	static void *prvAllocateFromFreeList( size_t xBlockSize );
+	static void prvFreeToFreeList( BlockLink_t *pxLink );
+
+	/*
+	 * Returns the size of the block needed to hold xWantedSize bytes, or 0 if
+	 * xWantedSize is 0 or too large.
+	 */
+	static size_t prvGetBlockSize( size_t xWantedSize );
+
+	/*
+	 * Take a block of exactly xBlockSize bytes from, or return a block to, the
+	 * small block lists.  Must be called with interrupts masked.
+	 */
+	static void *prvSmallBlockAlloc( size_t xBlockSize );
+	static void prvSmallBlockFree( BlockLink_t *pxLink );
+
+	/*
+	 * Take a block of at least xBlockSize bytes from the blocks reserved for
+	 * interrupts by xPortReserveSmallBlocks().  Must be called with interrupts
+	 * masked.
+	 */
+	static void *prvReservedBlockAlloc( size_t xBlockSize );
+
+	/*
+	 * Return every block held in the small block lists to the list of free
+	 * blocks, so they can be merged and used for larger blocks again.  Called
+	 * when an allocation cannot otherwise be satisfied.  Blocks reserved for
+	 * interrupts are not released.
+	 */
+	static void prvReleaseSmallBlocks( void );
+
+#endif /* configHEAP_USE_CRITICAL_SECTIONS */
 
 /*
  * Called automatically to setup the required heap structures the first time
@@ -108,11 +233,49 @@ application.  When the bit is free the block is still part of the free heap
 space. */
 static size_t xBlockAllocatedBit = 0;
 
+/* Counts of the calls to pvPortMalloc() that returned a block, and of the calls
+to vPortFree() that freed one, reported by vPortGetHeapStats(). */
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfSuccessfulFrees = 0;
+
+/* Incremented each time the list of free blocks is changed, so a walk that
+unlocked the list part way through can tell if the block it stopped at might no
+longer be in the list. */
+static UBaseType_t uxFreeListChanges = 0U;
+
+#if( configHEAP_USE_CRITICAL_SECTIONS == 1 )
+
+	/* Freed blocks that are small enough are held in these lists, by size,
+	rather than being returned to the list of free blocks.  They remain marked
+	as allocated, and their pxNextFreeBlock members link the lists. */
+	static BlockLink_t *pxSmallBlockLists[ heapSMALL_BLOCK_LIST_COUNT ];
+
+	/* The total size of the blocks in the small block lists, which are free as
+	far as the application is concerned. */
+	static size_t xSmallBlockFreeBytes = 0U;
+
+	/* The number of blocks in each small block list. */
+	static size_t xSmallBlockCounts[ heapSMALL_BLOCK_LIST_COUNT ];
+
+	/* Blocks set aside by xPortReserveSmallBlocks(), by size, which only
+	pvPortMallocFromISR() allocates from.  A small block that is freed while
+	its reserved list holds fewer than the target number of blocks for its
+	size goes back to the reserved list rather than to its small block list.
+	Reserved blocks are not free as far as pvPortMalloc() is concerned, so are
+	not counted as free heap space. */
+	static BlockLink_t *pxReservedBlockLists[ heapSMALL_BLOCK_LIST_COUNT ];
+	static size_t xReservedBlockCounts[ heapSMALL_BLOCK_LIST_COUNT ];
+	static size_t xReservedBlockTargets[ heapSMALL_BLOCK_LIST_COUNT ];
+
+#endif /* configHEAP_USE_CRITICAL_SECTIONS */
+
 /*-----------------------------------------------------------*/
 
+#if( configHEAP_USE_CRITICAL_SECTIONS == 0 )
+
 void *pvPortMalloc( size_t xWantedSize )
 {
-BlockLink_t *pxBlock, *pxPreviousBlock, *pxNewBlockLink;
+BlockLink_t *pxBlock, *pxPreviousBlock;
 void *pvReturn = NULL;
 
 	vTaskSuspendAll();
@@ -174,53 +337,8 @@ void *pvReturn = NULL;
 				was	not found. */
 				if( pxBlock != pxEnd )
 				{
-					/* Return the memory space pointed to - jumping over the
-					BlockLink_t structure at its start. */
-					pvReturn = ( void * ) ( ( ( uint8_t * ) pxPreviousBlock->pxNextFreeBlock ) + xHeapStructSize );
-
-					/* This block is being returned for use so must be taken out
-					of the list of free blocks. */
-					pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
-
-					/* If the block is larger than required it can be split into
-					two. */
-					if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
-					{
-						/* This block is to be split into two.  Create a new
-						block following the number of bytes requested. The void
-						cast is used to prevent byte alignment warnings from the
-						compiler. */
-						pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
-						configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
-
-						/* Calculate the sizes of two blocks split from the
-						single block. */
-						pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
-						pxBlock->xBlockSize = xWantedSize;
-
-						/* Insert the new block into the list of free blocks. */
-						prvInsertBlockIntoFreeList( pxNewBlockLink );
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
-
-					xFreeBytesRemaining -= pxBlock->xBlockSize;
-
-					if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
-					{
-						xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
-					}
-					else
-					{
-						mtCOVERAGE_TEST_MARKER();
-					}
-
-					/* The block is being returned - it is allocated and owned
-					by the application and has no "next" block. */
-					pxBlock->xBlockSize |= xBlockAllocatedBit;
-					pxBlock->pxNextFreeBlock = NULL;
+					pvReturn = prvAllocateBlock( pxPreviousBlock, pxBlock, xWantedSize );
+					xNumberOfSuccessfulAllocations++;
 				}
 				else
 				{
@@ -292,6 +410,7 @@ BlockLink_t *pxLink;
 					xFreeBytesRemaining += pxLink->xBlockSize;
 					traceFREE( pv, pxLink->xBlockSize );
 					prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
+					xNumberOfSuccessfulFrees++;
 				}
 				( void ) xTaskResumeAll();
 			}
@@ -306,131 +425,992 @@ BlockLink_t *pxLink;
 		}
 	}
 }
-/*-----------------------------------------------------------*/
-
-size_t xPortGetFreeHeapSize( void )
-{
-	return xFreeBytesRemaining;
-}
-/*-----------------------------------------------------------*/
 
-size_t xPortGetMinimumEverFreeHeapSize( void )
-{
-	return xMinimumEverFreeBytesRemaining;
-}
+#endif /* configHEAP_USE_CRITICAL_SECTIONS == 0 */
 /*-----------------------------------------------------------*/
 
-void vPortInitialiseBlocks( void )
-{
-	/* This just exists to keep the linker quiet. */
-}
-/*-----------------------------------------------------------*/
+#if( configHEAP_USE_CRITICAL_SECTIONS == 1 )
 
-static void prvHeapInit( void )
+void *pvPortMalloc( size_t xWantedSize )
 {
-BlockLink_t *pxFirstFreeBlock;
-uint8_t *pucAlignedHeap;
-size_t uxAddress;
-size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
+void *pvReturn = NULL;
 
-	/* Ensure the heap starts on a correctly aligned boundary. */
-	uxAddress = ( size_t ) ucHeap;
+	xWantedSize = prvGetBlockSize( xWantedSize );
 
-	if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+	if( xWantedSize > 0 )
 	{
-		uxAddress += ( portBYTE_ALIGNMENT - 1 );
-		uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
-		xTotalHeapSize -= uxAddress - ( size_t ) ucHeap;
-	}
+		/* A block of the right size that was freed earlier can be reused
+		without searching for it. */
+		if( heapIS_SMALL_BLOCK( xWantedSize ) )
+		{
+			taskENTER_CRITICAL();
+			{
+				pvReturn = prvSmallBlockAlloc( xWantedSize );
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-	pucAlignedHeap = ( uint8_t * ) uxAddress;
+		if( pvReturn == NULL )
+		{
+			pvReturn = prvAllocateFromFreeList( xWantedSize );
 
-	/* xStart is used to hold a pointer to the first item in the list of free
-	blocks.  The void cast is used to prevent compiler warnings. */
-	xStart.pxNextFreeBlock = ( void * ) pucAlignedHeap;
-	xStart.xBlockSize = ( size_t ) 0;
+			/* If there was no block large enough then try again once the
+			blocks held in the small block lists have been returned to the list
+			of free blocks, where they can be merged with their neighbours. */
+			if( ( pvReturn == NULL ) && ( xSmallBlockFreeBytes > ( size_t ) 0 ) )
+			{
+				prvReleaseSmallBlocks();
+				pvReturn = prvAllocateFromFreeList( xWantedSize );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-	/* pxEnd is used to mark the end of the list of free blocks and is inserted
-	at the end of the heap space. */
-	uxAddress = ( ( size_t ) pucAlignedHeap ) + xTotalHeapSize;
-	uxAddress -= xHeapStructSize;
-	uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
-	pxEnd = ( void * ) uxAddress;
-	pxEnd->xBlockSize = 0;
-	pxEnd->pxNextFreeBlock = NULL;
+		if( pvReturn != NULL )
+		{
+			taskENTER_CRITICAL();
+			{
+				xNumberOfSuccessfulAllocations++;
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
 
-	/* To start with there is a single free block that is sized to take up the
-	entire heap space, minus the space taken by pxEnd. */
-	pxFirstFreeBlock = ( void * ) pucAlignedHeap;
-	pxFirstFreeBlock->xBlockSize = uxAddress - ( size_t ) pxFirstFreeBlock;
-	pxFirstFreeBlock->pxNextFreeBlock = pxEnd;
+	traceMALLOC( pvReturn, xWantedSize );
 
-	/* Only one block exists - and it covers the entire usable heap space. */
-	xMinimumEverFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
-	xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
 
-	/* Work out the position of the top bit in a size_t variable. */
-	xBlockAllocatedBit = ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 );
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
 }
 /*-----------------------------------------------------------*/
 
-static void prvInsertBlockIntoFreeList( BlockLink_t *pxBlockToInsert )
+void *pvPortMallocFromISR( size_t xWantedSize )
 {
-BlockLink_t *pxIterator;
-uint8_t *puc;
+UBaseType_t uxSavedInterruptStatus;
+void *pvReturn = NULL;
 
-	/* Iterate through the list until a block is found that has a higher address
-	than the block being inserted. */
-	for( pxIterator = &xStart; pxIterator->pxNextFreeBlock < pxBlockToInsert; pxIterator = pxIterator->pxNextFreeBlock )
-	{
-		/* Nothing to do here, just iterate to the right position. */
-	}
+	/* Only blocks held in the small block lists, or reserved for interrupts,
+	can be allocated from an interrupt, as the time taken to walk the list of
+	free blocks cannot be bounded.  The reserved blocks are used last, so they
+	are left for when nothing else is available. */
+	xWantedSize = prvGetBlockSize( xWantedSize );
 
-	/* Do the block being inserted, and the block it is being inserted after
-	make a contiguous block of memory? */
-	puc = ( uint8_t * ) pxIterator;
-	if( ( puc + pxIterator->xBlockSize ) == ( uint8_t * ) pxBlockToInsert )
+	if( ( xWantedSize > 0 ) && ( heapIS_SMALL_BLOCK( xWantedSize ) ) )
 	{
-		pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
-		pxBlockToInsert = pxIterator;
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			pvReturn = prvSmallBlockAlloc( xWantedSize );
+
+			if( pvReturn == NULL )
+			{
+				pvReturn = prvReservedBlockAlloc( xWantedSize );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( pvReturn != NULL )
+			{
+				xNumberOfSuccessfulAllocations++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 	}
 	else
 	{
 		mtCOVERAGE_TEST_MARKER();
 	}
 
-	/* Do the block being inserted, and the block it is being inserted before
-	make a contiguous block of memory? */
-	puc = ( uint8_t * ) pxBlockToInsert;
-	if( ( puc + pxBlockToInsert->xBlockSize ) == ( uint8_t * ) pxIterator->pxNextFreeBlock )
+	traceMALLOC_FROM_ISR( pvReturn, xWantedSize );
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+uint8_t *puc = ( uint8_t * ) pv;
+BlockLink_t *pxLink;
+
+	if( pv != NULL )
 	{
-		if( pxIterator->pxNextFreeBlock != pxEnd )
+		/* The memory being freed will have an BlockLink_t structure immediately
+		before it. */
+		puc -= xHeapStructSize;
+
+		/* This casting is to keep the compiler from issuing warnings. */
+		pxLink = ( void * ) puc;
+
+		/* Check the block is actually allocated. */
+		configASSERT( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 );
+		configASSERT( pxLink->pxNextFreeBlock == NULL );
+
+		if( ( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 ) && ( pxLink->pxNextFreeBlock == NULL ) )
 		{
-			/* Form one big block from the two blocks. */
-			pxBlockToInsert->xBlockSize += pxIterator->pxNextFreeBlock->xBlockSize;
-			pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock->pxNextFreeBlock;
+			traceFREE( pv, pxLink->xBlockSize & ~xBlockAllocatedBit );
+
+			if( heapIS_SMALL_BLOCK( pxLink->xBlockSize & ~xBlockAllocatedBit ) )
+			{
+				taskENTER_CRITICAL();
+				{
+					prvSmallBlockFree( pxLink );
+				}
+				taskEXIT_CRITICAL();
+			}
+			else
+			{
+				prvFreeToFreeList( pxLink );
+			}
+
+			taskENTER_CRITICAL();
+			{
+				xNumberOfSuccessfulFrees++;
+			}
+			taskEXIT_CRITICAL();
 		}
 		else
 		{
-			pxBlockToInsert->pxNextFreeBlock = pxEnd;
+			mtCOVERAGE_TEST_MARKER();
 		}
 	}
-	else
-	{
-		pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock;
-	}
+}
+/*-----------------------------------------------------------*/
 
-	/* If the block being inserted plugged a gab, so was merged with the block
-	before and the block after, then it's pxNextFreeBlock pointer will have
-	already been set, and should not be set here as that would make it point
-	to itself. */
-	if( pxIterator != pxBlockToInsert )
+void vPortFreeFromISR( void *pv )
+{
+uint8_t *puc = ( uint8_t * ) pv;
+BlockLink_t *pxLink;
+UBaseType_t uxSavedInterruptStatus;
+
+	if( pv != NULL )
 	{
-		pxIterator->pxNextFreeBlock = pxBlockToInsert;
+		puc -= xHeapStructSize;
+		pxLink = ( void * ) puc;
+
+		/* Check the block is actually allocated, and is small enough to be
+		held in a small block list, as blocks cannot be returned to the list of
+		free blocks from an interrupt. */
+		configASSERT( ( pxLink->xBlockSize & xBlockAllocatedBit ) != 0 );
+		configASSERT( pxLink->pxNextFreeBlock == NULL );
+		configASSERT( heapIS_SMALL_BLOCK( pxLink->xBlockSize & ~xBlockAllocatedBit ) );
+
+		traceFREE( pv, pxLink->xBlockSize & ~xBlockAllocatedBit );
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			prvSmallBlockFree( pxLink );
+			xNumberOfSuccessfulFrees++;
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 	}
 	else
 	{
 		mtCOVERAGE_TEST_MARKER();
 	}
 }
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortReserveSmallBlocks( size_t xWantedSize, UBaseType_t uxCount )
+{
+void *pvBlock;
+BlockLink_t *pxLink;
+UBaseType_t ux;
+BaseType_t xReturn = pdPASS;
+
+	xWantedSize = prvGetBlockSize( xWantedSize );
+	configASSERT( ( xWantedSize > 0 ) && ( heapIS_SMALL_BLOCK( xWantedSize ) ) );
+
+	/* Each block is taken from the list of free blocks, never from a small
+	block list, and the target for its reserved list raised before it is
+	freed, which places it in its reserved list.  pvPortMalloc() never takes a
+	block from a reserved list, and never releases them when it runs out of
+	memory, so the blocks remain available to interrupts. */
+	for( ux = 0; ux < uxCount; ux++ )
+	{
+		pvBlock = prvAllocateFromFreeList( xWantedSize );
+
+		if( pvBlock != NULL )
+		{
+			/* The block might be larger than requested, if what would have
+			been left of the free block it came from was too small to be a
+			block of its own.  It is then reserved in the list for its own
+			size, which prvReservedBlockAlloc() also searches. */
+			pxLink = ( void * ) ( ( ( uint8_t * ) pvBlock ) - xHeapStructSize );
+
+			if( heapIS_SMALL_BLOCK( pxLink->xBlockSize & ~xBlockAllocatedBit ) )
+			{
+				taskENTER_CRITICAL();
+				{
+					xReservedBlockTargets[ heapSMALL_BLOCK_INDEX( pxLink->xBlockSize & ~xBlockAllocatedBit ) ]++;
+					prvSmallBlockFree( pxLink );
+				}
+				taskEXIT_CRITICAL();
+			}
+			else
+			{
+				prvFreeToFreeList( pxLink );
+				xReturn = pdFAIL;
+				break;
+			}
+		}
+		else
+		{
+			xReturn = pdFAIL;
+			break;
+		}
+	}
+
+	return xReturn;
+}
+
+#endif /* configHEAP_USE_CRITICAL_SECTIONS == 1 */
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	#if( configHEAP_USE_CRITICAL_SECTIONS == 1 )
+	{
+		/* Blocks held in the small block lists are free as far as the
+		application is concerned. */
+		return xFreeBytesRemaining + xSmallBlockFreeBytes;
+	}
+	#else
+	{
+		return xFreeBytesRemaining;
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t *pxHeapStats )
+{
+BlockLink_t *pxBlock = NULL;
+UBaseType_t uxClass, uxChanges = 0U, uxRestarts = 0U, uxBlocks;
+BaseType_t xWalkStarted = pdFALSE, xSchedulerSuspended = pdFALSE;
+
+	/* The list of free blocks is walked heapBLOCKS_PER_CRITICAL_SECTION blocks
+	at a time, and unlocked in between, so other tasks - and interrupts if
+	configHEAP_USE_CRITICAL_SECTIONS is 1 - are only held off briefly however
+	many free blocks there are.  As in prvWalkFreeList(), if the list changed
+	while it was unlocked the walk starts again, discarding the counts made so
+	far, so the statistics always describe the list at a single point in time.
+	After heapMAX_WALK_RESTARTS restarts the scheduler is suspended so the walk
+	can complete. */
+	for( ;; )
+	{
+		heapLOCK_FREE_LIST();
+
+		if( ( xWalkStarted == pdFALSE ) || ( uxChanges != uxFreeListChanges ) )
+		{
+			if( xWalkStarted != pdFALSE )
+			{
+				uxRestarts++;
+
+				if( ( uxRestarts >= heapMAX_WALK_RESTARTS ) && ( xSchedulerSuspended == pdFALSE ) )
+				{
+					heapUNLOCK_FREE_LIST();
+					vTaskSuspendAll();
+					xSchedulerSuspended = pdTRUE;
+					heapLOCK_FREE_LIST();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxHeapStats->xSizeOfLargestFreeBlockInBytes = 0;
+			pxHeapStats->xSizeOfSmallestFreeBlockInBytes = 0;
+			pxHeapStats->xNumberOfFreeBlocks = 0;
+
+			for( uxClass = 0; uxClass < ( UBaseType_t ) portHEAP_STATS_SIZE_CLASSES; uxClass++ )
+			{
+				pxHeapStats->xFreeBlocksBySize[ uxClass ] = 0;
+			}
+
+			/* pxBlock will be NULL if the heap has not been initialised.  The
+			heap is initialised automatically when the first allocation is
+			made. */
+			pxBlock = xStart.pxNextFreeBlock;
+			uxChanges = uxFreeListChanges;
+			xWalkStarted = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		for( uxBlocks = 0U; ( uxBlocks < heapBLOCKS_PER_CRITICAL_SECTION ) && ( pxBlock != NULL ) && ( pxBlock != pxEnd ); uxBlocks++ )
+		{
+			prvCountFreeBlocks( pxHeapStats, pxBlock->xBlockSize, 1 );
+			pxBlock = pxBlock->pxNextFreeBlock;
+		}
+
+		if( ( pxBlock == NULL ) || ( pxBlock == pxEnd ) )
+		{
+			/* The walk is complete.  The list is left locked so the totals
+			below are from the same point in time. */
+			break;
+		}
+		else
+		{
+			heapUNLOCK_FREE_LIST();
+		}
+	}
+
+	#if( configHEAP_USE_CRITICAL_SECTIONS == 1 )
+	{
+	size_t xIndex;
+
+		/* The number of blocks in each small block list is kept up to date as
+		blocks are added and removed, and all the blocks in a list are the same
+		size, so the lists do not have to be walked.  Each is counted as a free
+		block of its own, although it is merged with any free neighbours before
+		an allocation is allowed to fail. */
+		for( xIndex = 0; xIndex < heapSMALL_BLOCK_LIST_COUNT; xIndex++ )
+		{
+			if( xSmallBlockCounts[ xIndex ] > ( size_t ) 0 )
+			{
+				prvCountFreeBlocks( pxHeapStats, xHeapStructSize + ( ( xIndex + ( size_t ) 1 ) * ( size_t ) portBYTE_ALIGNMENT ), xSmallBlockCounts[ xIndex ] );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining + xSmallBlockFreeBytes;
+	}
+	#else
+	{
+		pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+	}
+	#endif /* configHEAP_USE_CRITICAL_SECTIONS */
+
+	pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+	pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+	pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+
+	heapUNLOCK_FREE_LIST();
+
+	if( xSchedulerSuspended != pdFALSE )
+	{
+		( void ) xTaskResumeAll();
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void )
+{
+BlockLink_t *pxFirstFreeBlock;
+uint8_t *pucAlignedHeap;
+size_t uxAddress;
+size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
+
+	/* Ensure the heap starts on a correctly aligned boundary. */
+	uxAddress = ( size_t ) ucHeap;
+
+	if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+	{
+		uxAddress += ( portBYTE_ALIGNMENT - 1 );
+		uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		xTotalHeapSize -= uxAddress - ( size_t ) ucHeap;
+	}
+
+	pucAlignedHeap = ( uint8_t * ) uxAddress;
+
+	/* xStart is used to hold a pointer to the first item in the list of free
+	blocks.  The void cast is used to prevent compiler warnings. */
+	xStart.pxNextFreeBlock = ( void * ) pucAlignedHeap;
+	xStart.xBlockSize = ( size_t ) 0;
+
+	/* pxEnd is used to mark the end of the list of free blocks and is inserted
+	at the end of the heap space. */
+	uxAddress = ( ( size_t ) pucAlignedHeap ) + xTotalHeapSize;
+	uxAddress -= xHeapStructSize;
+	uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+	pxEnd = ( void * ) uxAddress;
+	pxEnd->xBlockSize = 0;
+	pxEnd->pxNextFreeBlock = NULL;
+
+	/* To start with there is a single free block that is sized to take up the
+	entire heap space, minus the space taken by pxEnd. */
+	pxFirstFreeBlock = ( void * ) pucAlignedHeap;
+	pxFirstFreeBlock->xBlockSize = uxAddress - ( size_t ) pxFirstFreeBlock;
+	pxFirstFreeBlock->pxNextFreeBlock = pxEnd;
+
+	/* Only one block exists - and it covers the entire usable heap space. */
+	xMinimumEverFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+	xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+
+	/* Work out the position of the top bit in a size_t variable. */
+	xBlockAllocatedBit = ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 );
+}
+/*-----------------------------------------------------------*/
+
+#if( configHEAP_USE_CRITICAL_SECTIONS == 0 )
+
+	static void prvInsertBlockIntoFreeList( BlockLink_t *pxBlockToInsert )
+	{
+	BlockLink_t *pxIterator;
+
+		/* Iterate through the list until a block is found that has a higher
+		address than the block being inserted. */
+		for( pxIterator = &xStart; pxIterator->pxNextFreeBlock < pxBlockToInsert; pxIterator = pxIterator->pxNextFreeBlock )
+		{
+			/* Nothing to do here, just iterate to the right position. */
+		}
+
+		prvInsertBlockAfter( pxIterator, pxBlockToInsert );
+	}
+
+#endif /* configHEAP_USE_CRITICAL_SECTIONS */
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockAfter( BlockLink_t *pxIterator, BlockLink_t *pxBlockToInsert )
+{
+uint8_t *puc;
+
+	uxFreeListChanges++;
+
+	/* Do the block being inserted, and the block it is being inserted after
+	make a contiguous block of memory? */
+	puc = ( uint8_t * ) pxIterator;
+	if( ( puc + pxIterator->xBlockSize ) == ( uint8_t * ) pxBlockToInsert )
+	{
+		pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
+		pxBlockToInsert = pxIterator;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Do the block being inserted, and the block it is being inserted before
+	make a contiguous block of memory? */
+	puc = ( uint8_t * ) pxBlockToInsert;
+	if( ( puc + pxBlockToInsert->xBlockSize ) == ( uint8_t * ) pxIterator->pxNextFreeBlock )
+	{
+		if( pxIterator->pxNextFreeBlock != pxEnd )
+		{
+			/* Form one big block from the two blocks. */
+			pxBlockToInsert->xBlockSize += pxIterator->pxNextFreeBlock->xBlockSize;
+			pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock->pxNextFreeBlock;
+		}
+		else
+		{
+			pxBlockToInsert->pxNextFreeBlock = pxEnd;
+		}
+	}
+	else
+	{
+		pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock;
+	}
+
+	/* If the block being inserted plugged a gab, so was merged with the block
+	before and the block after, then it's pxNextFreeBlock pointer will have
+	already been set, and should not be set here as that would make it point
+	to itself. */
+	if( pxIterator != pxBlockToInsert )
+	{
+		pxIterator->pxNextFreeBlock = pxBlockToInsert;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void *prvAllocateBlock( BlockLink_t *pxPreviousBlock, BlockLink_t *pxBlock, size_t xWantedSize )
+{
+BlockLink_t *pxNewBlockLink;
+void *pvReturn;
+
+	uxFreeListChanges++;
+
+	/* Return the memory space pointed to - jumping over the BlockLink_t
+	structure at its start. */
+	pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+
+	/* This block is being returned for use so must be taken out of the list of
+	free blocks. */
+	pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+	/* If the block is larger than required it can be split into two. */
+	if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
+	{
+		/* This block is to be split into two.  Create a new block following
+		the number of bytes requested. The void cast is used to prevent byte
+		alignment warnings from the compiler. */
+		pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+		configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+		/* Calculate the sizes of two blocks split from the single block. */
+		pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+		pxBlock->xBlockSize = xWantedSize;
+
+		/* The new block takes the place of the block being allocated in the
+		list of free blocks.  It cannot be adjacent to either of its
+		neighbours, as the block it was split from was not, so it is linked in
+		directly rather than by searching the list for its position. */
+		pxNewBlockLink->pxNextFreeBlock = pxPreviousBlock->pxNextFreeBlock;
+		pxPreviousBlock->pxNextFreeBlock = pxNewBlockLink;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+	if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+	{
+		xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* The block is being returned - it is allocated and owned by the
+	application and has no "next" block. */
+	pxBlock->xBlockSize |= xBlockAllocatedBit;
+	pxBlock->pxNextFreeBlock = NULL;
+
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCountFreeBlocks( HeapStats_t *pxHeapStats, size_t xBlockSize, size_t xCount )
+{
+UBaseType_t uxClass = 0;
+
+	if( ( pxHeapStats->xNumberOfFreeBlocks == ( size_t ) 0 ) || ( xBlockSize < pxHeapStats->xSizeOfSmallestFreeBlockInBytes ) )
+	{
+		pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xBlockSize;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( xBlockSize > pxHeapStats->xSizeOfLargestFreeBlockInBytes )
+	{
+		pxHeapStats->xSizeOfLargestFreeBlockInBytes = xBlockSize;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Find the size class of the block.  The last class also holds all the
+	blocks that are larger than the classes before it. */
+	while( ( uxClass < ( ( UBaseType_t ) portHEAP_STATS_SIZE_CLASSES - ( UBaseType_t ) 1 ) ) && ( xBlockSize >= ( heapSTATS_FIRST_CLASS_LIMIT << uxClass ) ) )
+	{
+		uxClass++;
+	}
+
+	pxHeapStats->xFreeBlocksBySize[ uxClass ] += xCount;
+	pxHeapStats->xNumberOfFreeBlocks += xCount;
+}
+/*-----------------------------------------------------------*/
+
+#if( configHEAP_USE_CRITICAL_SECTIONS == 1 )
+
+	static BlockLink_t *prvWalkFreeList( size_t xWantedSize, const BlockLink_t *pxBlockToInsert, BaseType_t *pxSchedulerSuspended )
+	{
+	BlockLink_t *pxIterator = NULL;
+	UBaseType_t uxChanges = 0U, uxRestarts = 0U, uxBlocks;
+	BaseType_t xFound = pdFALSE;
+
+		*pxSchedulerSuspended = pdFALSE;
+
+		for( ;; )
+		{
+			taskENTER_CRITICAL();
+
+			if( ( pxIterator == NULL ) || ( uxChanges != uxFreeListChanges ) )
+			{
+				/* Either the walk is starting, or another task changed the list
+				while interrupts were unmasked, so pxIterator might no longer
+				be in it and the walk must start again. */
+				if( pxIterator != NULL )
+				{
+					uxRestarts++;
+
+					if( ( uxRestarts >= heapMAX_WALK_RESTARTS ) && ( *pxSchedulerSuspended == pdFALSE ) )
+					{
+						/* Other tasks keep changing the list, so stop them
+						running until the walk has completed.  Interrupts do
+						not use the list of free blocks, so it cannot change
+						again. */
+						taskEXIT_CRITICAL();
+						vTaskSuspendAll();
+						*pxSchedulerSuspended = pdTRUE;
+						taskENTER_CRITICAL();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pxIterator = &xStart;
+				uxChanges = uxFreeListChanges;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			for( uxBlocks = 0U; uxBlocks < heapBLOCKS_PER_CRITICAL_SECTION; uxBlocks++ )
+			{
+				if( pxBlockToInsert != NULL )
+				{
+					/* Looking for the position of a block being freed, which
+					the list of free blocks is ordered by. */
+					xFound = ( pxIterator->pxNextFreeBlock >= pxBlockToInsert ) ? pdTRUE : pdFALSE;
+				}
+				else
+				{
+					/* Looking for the first block that is large enough. */
+					xFound = ( ( pxIterator->pxNextFreeBlock->xBlockSize >= xWantedSize ) || ( pxIterator->pxNextFreeBlock == pxEnd ) ) ? pdTRUE : pdFALSE;
+				}
+
+				if( xFound != pdFALSE )
+				{
+					break;
+				}
+				else
+				{
+					pxIterator = pxIterator->pxNextFreeBlock;
+				}
+			}
+
+			if( xFound != pdFALSE )
+			{
+				/* Return with interrupts still masked. */
+				break;
+			}
+			else
+			{
+				/* Give higher priority tasks and interrupts the chance to run
+				before the walk continues. */
+				taskEXIT_CRITICAL();
+			}
+		}
+
+		return pxIterator;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void *prvAllocateFromFreeList( size_t xBlockSize )
+	{
+	BlockLink_t *pxPreviousBlock;
+	BaseType_t xSchedulerSuspended;
+	void *pvReturn = NULL;
+
+		/* If this is the first call to malloc then the heap will require
+		initialisation to setup the list of free blocks. */
+		if( pxEnd == NULL )
+		{
+			taskENTER_CRITICAL();
+			{
+				if( pxEnd == NULL )
+				{
+					prvHeapInit();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xBlockSize <= xFreeBytesRemaining )
+		{
+			/* Traverse the list from the start (lowest address) block until
+			one of adequate size is found.  The walk returns with interrupts
+			masked, so the block found is still free while it is taken out of
+			the list. */
+			pxPreviousBlock = prvWalkFreeList( xBlockSize, NULL, &xSchedulerSuspended );
+			{
+				/* If the end marker was reached then a block of adequate size
+				was not found. */
+				if( pxPreviousBlock->pxNextFreeBlock != pxEnd )
+				{
+					pvReturn = prvAllocateBlock( pxPreviousBlock, pxPreviousBlock->pxNextFreeBlock, xBlockSize );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( xSchedulerSuspended != pdFALSE )
+			{
+				( void ) xTaskResumeAll();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pvReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvFreeToFreeList( BlockLink_t *pxLink )
+	{
+	BlockLink_t *pxIterator;
+	BaseType_t xSchedulerSuspended;
+
+		/* The block is being returned to the heap - it is no longer
+		allocated. */
+		pxLink->xBlockSize &= ~xBlockAllocatedBit;
+
+		/* Find where the block goes in the list of free blocks.  The walk
+		returns with interrupts masked. */
+		pxIterator = prvWalkFreeList( 0, pxLink, &xSchedulerSuspended );
+		{
+			xFreeBytesRemaining += pxLink->xBlockSize;
+			prvInsertBlockAfter( pxIterator, pxLink );
+		}
+		taskEXIT_CRITICAL();
+
+		if( xSchedulerSuspended != pdFALSE )
+		{
+			( void ) xTaskResumeAll();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static size_t prvGetBlockSize( size_t xWantedSize )
+	{
+	size_t xBlockSize = 0;
+
+		/* The wanted size is increased so it can contain a BlockLink_t
+		structure in addition to the requested amount of bytes, and rounded up
+		so blocks are always aligned to the required number of bytes.  The top
+		bit of the result must be clear, as it is used to mark blocks as
+		allocated. */
+		if( ( xWantedSize > 0 ) && ( xWantedSize < ( ( ( size_t ) 1 << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 ) ) - xHeapStructSize - ( size_t ) portBYTE_ALIGNMENT ) ) )
+		{
+			xBlockSize = ( xWantedSize + xHeapStructSize + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xBlockSize;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void *prvSmallBlockAlloc( size_t xBlockSize )
+	{
+	BlockLink_t *pxBlock;
+	void *pvReturn = NULL;
+	size_t xIndex = heapSMALL_BLOCK_INDEX( xBlockSize );
+
+		pxBlock = pxSmallBlockLists[ xIndex ];
+
+		if( pxBlock != NULL )
+		{
+			pxSmallBlockLists[ xIndex ] = pxBlock->pxNextFreeBlock;
+			pxBlock->pxNextFreeBlock = NULL;
+			xSmallBlockFreeBytes -= xBlockSize;
+			xSmallBlockCounts[ xIndex ]--;
+			pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pvReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvSmallBlockFree( BlockLink_t *pxLink )
+	{
+	size_t xBlockSize = pxLink->xBlockSize & ~xBlockAllocatedBit;
+	size_t xIndex = heapSMALL_BLOCK_INDEX( xBlockSize );
+
+		/* The block stays marked as allocated, so it is never merged with its
+		neighbours while it is in a small block list or a reserved list.
+		Replacing a reserved block that an interrupt has used takes priority
+		over keeping the block for reuse by anything. */
+		if( xReservedBlockCounts[ xIndex ] < xReservedBlockTargets[ xIndex ] )
+		{
+			pxLink->pxNextFreeBlock = pxReservedBlockLists[ xIndex ];
+			pxReservedBlockLists[ xIndex ] = pxLink;
+			xReservedBlockCounts[ xIndex ]++;
+		}
+		else
+		{
+			pxLink->pxNextFreeBlock = pxSmallBlockLists[ xIndex ];
+			pxSmallBlockLists[ xIndex ] = pxLink;
+			xSmallBlockFreeBytes += xBlockSize;
+			xSmallBlockCounts[ xIndex ]++;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void *prvReservedBlockAlloc( size_t xBlockSize )
+	{
+	BlockLink_t *pxBlock;
+	void *pvReturn = NULL;
+	size_t xIndex;
+
+		/* A reserved block can be larger than the size it was reserved for,
+		so the lists for larger sizes are searched too.  There are only
+		heapSMALL_BLOCK_LIST_COUNT lists, so the time taken is bounded. */
+		for( xIndex = heapSMALL_BLOCK_INDEX( xBlockSize ); xIndex < heapSMALL_BLOCK_LIST_COUNT; xIndex++ )
+		{
+			pxBlock = pxReservedBlockLists[ xIndex ];
+
+			if( pxBlock != NULL )
+			{
+				pxReservedBlockLists[ xIndex ] = pxBlock->pxNextFreeBlock;
+				pxBlock->pxNextFreeBlock = NULL;
+				xReservedBlockCounts[ xIndex ]--;
+				pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+				break;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		return pvReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvReleaseSmallBlocks( void )
+	{
+	BlockLink_t *pxLink;
+	size_t xIndex;
+
+		for( xIndex = 0; xIndex < heapSMALL_BLOCK_LIST_COUNT; xIndex++ )
+		{
+			do
+			{
+				/* Interrupts are only masked while one block is taken from its
+				list, so another task or an interrupt can use the list in
+				between. */
+				taskENTER_CRITICAL();
+				{
+					pxLink = pxSmallBlockLists[ xIndex ];
+
+					if( pxLink != NULL )
+					{
+						pxSmallBlockLists[ xIndex ] = pxLink->pxNextFreeBlock;
+						pxLink->pxNextFreeBlock = NULL;
+						xSmallBlockFreeBytes -= pxLink->xBlockSize & ~xBlockAllocatedBit;
+						xSmallBlockCounts[ xIndex ]--;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				taskEXIT_CRITICAL();
+
+				if( pxLink != NULL )
+				{
+					prvFreeToFreeList( pxLink );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			} while( pxLink != NULL );
+		}
+	}
+
+#endif /* configHEAP_USE_CRITICAL_SECTIONS */
+
+/* This entire source file will be skipped if the application is configured to
+use heap_tlsf.c or heap_regions.c.  If you want to use this allocator then
+ensure configUSE_TLSF_HEAP and configUSE_REGION_HEAP are set to 0 in
+FreeRTOSConfig.h. */
+#endif /* ( configUSE_TLSF_HEAP == 0 ) && ( configUSE_REGION_HEAP == 0 ) */
 
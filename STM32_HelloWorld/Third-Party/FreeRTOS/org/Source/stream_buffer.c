@@ -128,12 +128,34 @@ that uses task notifications. */
 #endif /* sbSEND_COMPLETE_FROM_ISR */
 /*lint -restore (9026) */
 
+#if ( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+	/* A multi-producer buffer cannot be reset while a writer is blocked on it
+	or part way through writing to it. */
+	#define sbWRITERS_ARE_IDLE( pxStreamBuffer ) ( ( listLIST_IS_EMPTY( &( ( pxStreamBuffer )->xTasksWaitingToSend ) ) != pdFALSE ) && ( ( pxStreamBuffer )->uxWritersInProgress == ( UBaseType_t ) 0 ) )
+#else
+	#define sbWRITERS_ARE_IDLE( pxStreamBuffer ) ( pdTRUE )
+#endif
+
+#if ( configUSE_STREAM_BUFFER_TRIGGER_HOLD_OFF == 1 )
+	/* A reader that blocks on an empty buffer arms the hold-off.  The first
+	write that leaves the buffer below the trigger level then starts it, by
+	limiting how long the reader can remain blocked. */
+	#define sbARM_HOLD_OFF( pxStreamBuffer ) ( pxStreamBuffer )->xHoldOffPending = ( ( ( pxStreamBuffer )->xHoldOffTicks != ( TickType_t ) 0 ) ? pdTRUE : pdFALSE )
+	#define sbSTART_HOLD_OFF( pxStreamBuffer ) prvStartHoldOff( pxStreamBuffer )
+	#define sbSTART_HOLD_OFF_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken ) prvStartHoldOffFromISR( pxStreamBuffer, pxHigherPriorityTaskWoken )
+#else
+	#define sbARM_HOLD_OFF( pxStreamBuffer )
+	#define sbSTART_HOLD_OFF( pxStreamBuffer ) mtCOVERAGE_TEST_MARKER()
+	#define sbSTART_HOLD_OFF_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken ) mtCOVERAGE_TEST_MARKER()
+#endif
+
 /* The number of bytes used to hold the length of a message in the buffer. */
 #define sbBYTES_TO_STORE_MESSAGE_LENGTH ( sizeof( configMESSAGE_BUFFER_LENGTH_TYPE ) )
 
 /* Bits stored in the ucFlags field of the stream buffer. */
 #define sbFLAGS_IS_MESSAGE_BUFFER		( ( uint8_t ) 1 ) /* Set if the stream buffer was created as a message buffer, in which case it holds discrete messages rather than a stream. */
 #define sbFLAGS_IS_STATICALLY_ALLOCATED ( ( uint8_t ) 2 ) /* Set if the stream buffer was created using statically allocated memory. */
+#define sbFLAGS_IS_MULTI_PRODUCER		( ( uint8_t ) 4 ) /* Set if more than one task or interrupt can write to the buffer at the same time. */
 
 /*-----------------------------------------------------------*/
 
@@ -149,6 +171,17 @@ typedef struct StreamBufferDef_t /*lint !e9058 Style convention uses tag. */
 	uint8_t *pucBuffer;					/* Points to the buffer itself - that is - the RAM that stores the data passed through the buffer. */
 	uint8_t ucFlags;
 
+	#if ( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+		volatile size_t xReserveHead;			/* Index to the next item to reserve within a multi-producer buffer.  xHead is only moved up to xReserveHead once no writer is still copying into the space it reserved. */
+		volatile UBaseType_t uxWritersInProgress;	/* The number of writers that have reserved space in a multi-producer buffer but not yet committed it. */
+		List_t xTasksWaitingToSend;				/* Tasks blocked waiting for space in a multi-producer buffer, stored in priority order. */
+	#endif
+
+	#if ( configUSE_STREAM_BUFFER_TRIGGER_HOLD_OFF == 1 )
+		TickType_t xHoldOffTicks;				/* The longest a waiting reader is kept blocked once data is available below the trigger level, or 0 to wait for the trigger level alone. */
+		volatile BaseType_t xHoldOffPending;	/* Set when the reader blocks on an empty buffer, cleared by the write that starts the hold-off. */
+	#endif
+
 	#if ( configUSE_TRACE_FACILITY == 1 )
 		UBaseType_t uxStreamBufferNumber;		/* Used for tracing purposes. */
 	#endif
@@ -160,12 +193,39 @@ typedef struct StreamBufferDef_t /*lint !e9058 Style convention uses tag. */
 static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
 
 /*
- * Add xCount bytes from pucData into the pxStreamBuffer message buffer.
- * Returns the number of bytes written, which will either equal xCount in the
- * success case, or 0 if there was not enough space in the buffer (in which case
- * no data is written into the buffer).
+ * Add xCount bytes from pucData into the pxStreamBuffer message buffer,
+ * starting at index xHead.  The caller must already have checked there is
+ * enough space.  Returns the index following the last byte written, which
+ * becomes the new head once the bytes are to be made available to the reader.
+ */
+static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount, size_t xHead ) PRIVILEGED_FUNCTION;
+
+/*
+ * As prvWriteBytesToBuffer(), but the xCount bytes are gathered from the
+ * fragments pointed to by pxFragments in turn.
+ */
+static size_t prvWriteFragmentsToBuffer( StreamBuffer_t * const pxStreamBuffer, const StreamBufferFragment_t *pxFragments, size_t xCount, size_t xHead ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the total number of bytes in the uxFragments fragments pointed to by
+ * pxFragments.
+ */
+static size_t prvGetFragmentsLength( const StreamBufferFragment_t *pxFragments, UBaseType_t uxFragments ) PRIVILEGED_FUNCTION;
+
+/*
+ * The implementation of xStreamBufferSend() and xStreamBufferSendV(), and of
+ * their FromISR() versions.  xDataLengthBytes is the total length of the
+ * fragments pointed to by pxFragments.
  */
-static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount ) PRIVILEGED_FUNCTION;
+static size_t prvSendFragments( StreamBufferHandle_t xStreamBuffer,
+								const StreamBufferFragment_t *pxFragments,
+								size_t xDataLengthBytes,
+								TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+static size_t prvSendFragmentsFromISR( StreamBufferHandle_t xStreamBuffer,
+									   const StreamBufferFragment_t *pxFragments,
+									   size_t xDataLengthBytes,
+									   BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
 /*
  * If the stream buffer is being used as a message buffer, then reads an entire
@@ -188,7 +248,7 @@ static size_t prvReadMessageFromBuffer( StreamBuffer_t *pxStreamBuffer,
  * data storage area.
  */
 static size_t prvWriteMessageToBuffer(  StreamBuffer_t * const pxStreamBuffer,
-										const void * pvTxData,
+										const StreamBufferFragment_t *pxFragments,
 										size_t xDataLengthBytes,
 										size_t xSpace,
 										size_t xRequiredSpace ) PRIVILEGED_FUNCTION;
@@ -212,20 +272,113 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 										  size_t xTriggerLevelBytes,
 										  uint8_t ucFlags ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_STREAM_BUFFER_TRIGGER_HOLD_OFF == 1 )
+
+	/*
+	 * Called when data has been written but the trigger level has not been
+	 * reached.  If the hold-off is armed, ensure the reader is unblocked no more
+	 * than the hold-off time after this first data arrived.
+	 */
+	static void prvStartHoldOff( StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+	static void prvStartHoldOffFromISR( StreamBuffer_t * const pxStreamBuffer, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_TRIGGER_HOLD_OFF */
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	/*
+	 * Describe the xCount bytes of the buffer's storage area that start at index
+	 * xIndex as up to two contiguous spans, the second of which is only used if
+	 * the bytes wrap around the end of the storage area.  Returns xCount.
+	 */
+	static size_t prvGetSpans( const StreamBuffer_t * const pxStreamBuffer,
+							   size_t xIndex,
+							   size_t xCount,
+							   StreamBufferSpan_t pxSpans[ 2 ] ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Move the index pointed to by pxIndex xCount bytes forward, wrapping at the
+	 * end of the storage area.
+	 */
+	static void prvAdvanceIndex( const StreamBuffer_t * const pxStreamBuffer,
+								 volatile size_t * const pxIndex,
+								 size_t xCount ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+
+#if ( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+
+	/*
+	 * Reserve space in a multi-producer buffer for a write of xDataLengthBytes,
+	 * which needs xRequiredSpace bytes if the buffer is a message buffer.  The
+	 * index at which the reserved space starts is returned in pxWriteIndex.
+	 * Returns the number of data bytes that can be written, which is 0 if no
+	 * space was reserved.  Must be called from a critical section.
+	 *
+	 * As with a single writer, a write to a stream buffer only reserves less
+	 * space than it needs, so is only partial, if xWriterCanBlock is pdFALSE -
+	 * because it is from an interrupt or its block time has expired.
+	 */
+	static size_t prvReserveSpace( StreamBuffer_t * const pxStreamBuffer,
+								   size_t xDataLengthBytes,
+								   size_t xRequiredSpace,
+								   BaseType_t xWriterCanBlock,
+								   size_t * const pxWriteIndex ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Copy a message, or stream of bytes, into space previously reserved by
+	 * prvReserveSpace().  Does not need to be called from a critical section,
+	 * so writers can copy into their reserved space at the same time.
+	 */
+	static void prvWriteToReservedSpace( StreamBuffer_t * const pxStreamBuffer,
+										 const StreamBufferFragment_t *pxFragments,
+										 size_t xDataLengthBytes,
+										 size_t xWriteIndex ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Mark a write to space reserved by prvReserveSpace() as complete.  Writers
+	 * can commit in any order.  The reader is only given access to the data
+	 * once every writer that reserved space has committed it, so it never sees
+	 * a partially written message.  Returns pdTRUE if committing unblocked a
+	 * task waiting for space that has a priority above the calling task.  Must
+	 * be called from a critical section.
+	 */
+	static BaseType_t prvCommitReservedSpace( StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Reserve space in, and then write to, a multi-producer buffer, blocking
+	 * for up to xTicksToWait ticks for space to become available.
+	 */
+	static size_t prvSendToMultiProducerBuffer( StreamBuffer_t * const pxStreamBuffer,
+												const StreamBufferFragment_t *pxFragments,
+												size_t xDataLengthBytes,
+												size_t xRequiredSpace,
+												TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Unblock the highest priority task waiting for space in a multi-producer
+	 * buffer, if any.  Returns pdTRUE if the unblocked task has a priority above
+	 * the calling task.  Must be called from a critical section.
+	 */
+	static BaseType_t prvUnblockTaskWaitingToSend( StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_MULTI_PRODUCER_STREAM_BUFFERS */
+
 /*-----------------------------------------------------------*/
 
 #if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 
-	StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xIsMessageBuffer )
+	StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes, size_t xTriggerLevelBytes, BaseType_t xStreamBufferType )
 	{
 	uint8_t *pucAllocatedMemory;
 	uint8_t ucFlags;
+	const BaseType_t xIsMessageBuffer = ( xStreamBufferType & sbTYPE_MESSAGE_BUFFER );
 
 		/* In case the stream buffer is going to be used as a message buffer
 		(that is, it will hold discrete messages with a little meta data that
 		says how big the next message is) check the buffer will be large enough
 		to hold at least one message. */
-		if( xIsMessageBuffer == pdTRUE )
+		if( xIsMessageBuffer != pdFALSE )
 		{
 			/* Is a message buffer but not statically allocated. */
 			ucFlags = sbFLAGS_IS_MESSAGE_BUFFER;
@@ -239,6 +392,23 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 		}
 		configASSERT( xTriggerLevelBytes <= xBufferSizeBytes );
 
+		#if ( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+		{
+			if( ( xStreamBufferType & sbTYPE_MULTI_PRODUCER ) != ( BaseType_t ) 0 )
+			{
+				ucFlags |= sbFLAGS_IS_MULTI_PRODUCER;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#else
+		{
+			configASSERT( ( xStreamBufferType & sbTYPE_MULTI_PRODUCER ) == ( BaseType_t ) 0 );
+		}
+		#endif /* configUSE_MULTI_PRODUCER_STREAM_BUFFERS */
+
 		/* A trigger level of 0 would cause a waiting task to unblock even when
 		the buffer was empty. */
 		if( xTriggerLevelBytes == ( size_t ) 0 )
@@ -282,13 +452,14 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 
 	StreamBufferHandle_t xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes,
 														   size_t xTriggerLevelBytes,
-														   BaseType_t xIsMessageBuffer,
+														   BaseType_t xStreamBufferType,
 														   uint8_t * const pucStreamBufferStorageArea,
 														   StaticStreamBuffer_t * const pxStaticStreamBuffer )
 	{
 	StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) pxStaticStreamBuffer; /*lint !e740 !e9087 Safe cast as StaticStreamBuffer_t is opaque Streambuffer_t. */
 	StreamBufferHandle_t xReturn;
 	uint8_t ucFlags;
+	const BaseType_t xIsMessageBuffer = ( xStreamBufferType & sbTYPE_MESSAGE_BUFFER );
 
 		configASSERT( pucStreamBufferStorageArea );
 		configASSERT( pxStaticStreamBuffer );
@@ -312,6 +483,23 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 			ucFlags = sbFLAGS_IS_STATICALLY_ALLOCATED;
 		}
 
+		#if ( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+		{
+			if( ( xStreamBufferType & sbTYPE_MULTI_PRODUCER ) != ( BaseType_t ) 0 )
+			{
+				ucFlags |= sbFLAGS_IS_MULTI_PRODUCER;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#else
+		{
+			configASSERT( ( xStreamBufferType & sbTYPE_MULTI_PRODUCER ) == ( BaseType_t ) 0 );
+		}
+		#endif /* configUSE_MULTI_PRODUCER_STREAM_BUFFERS */
+
 		/* In case the stream buffer is going to be used as a message buffer
 		(that is, it will hold discrete messages with a little meta data that
 		says how big the next message is) check the buffer will be large enough
@@ -398,6 +586,10 @@ BaseType_t xReturn = pdFAIL;
 	UBaseType_t uxStreamBufferNumber;
 #endif
 
+#if( configUSE_STREAM_BUFFER_TRIGGER_HOLD_OFF == 1 )
+	TickType_t xHoldOffTicks;
+#endif
+
 	configASSERT( pxStreamBuffer );
 
 	#if( configUSE_TRACE_FACILITY == 1 )
@@ -408,12 +600,20 @@ BaseType_t xReturn = pdFAIL;
 	}
 	#endif
 
+	#if( configUSE_STREAM_BUFFER_TRIGGER_HOLD_OFF == 1 )
+	{
+		/* The hold-off is a setting, like the trigger level, so is kept
+		across the reset. */
+		xHoldOffTicks = pxStreamBuffer->xHoldOffTicks;
+	}
+	#endif
+
 	/* Can only reset a message buffer if there are no tasks blocked on it. */
 	taskENTER_CRITICAL();
 	{
 		if( pxStreamBuffer->xTaskWaitingToReceive == NULL )
 		{
-			if( pxStreamBuffer->xTaskWaitingToSend == NULL )
+			if( ( pxStreamBuffer->xTaskWaitingToSend == NULL ) && ( sbWRITERS_ARE_IDLE( pxStreamBuffer ) != pdFALSE ) )
 			{
 				prvInitialiseNewStreamBuffer( pxStreamBuffer,
 											  pxStreamBuffer->pucBuffer,
@@ -428,6 +628,12 @@ BaseType_t xReturn = pdFAIL;
 				}
 				#endif
 
+				#if( configUSE_STREAM_BUFFER_TRIGGER_HOLD_OFF == 1 )
+				{
+					pxStreamBuffer->xHoldOffTicks = xHoldOffTicks;
+				}
+				#endif
+
 				traceSTREAM_BUFFER_RESET( xStreamBuffer );
 			}
 		}
@@ -467,15 +673,49 @@ BaseType_t xReturn;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_STREAM_BUFFER_TRIGGER_HOLD_OFF == 1 )
+
+	BaseType_t xStreamBufferSetTriggerHoldOff( StreamBufferHandle_t xStreamBuffer, TickType_t xHoldOffTicks )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+		configASSERT( pxStreamBuffer );
+
+		/* The new value takes effect the next time the reader blocks. */
+		pxStreamBuffer->xHoldOffTicks = xHoldOffTicks;
+
+		return pdPASS;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_TRIGGER_HOLD_OFF */
+/*-----------------------------------------------------------*/
+
 size_t xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer )
 {
 const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
-size_t xSpace;
+size_t xSpace, xHead;
 
 	configASSERT( pxStreamBuffer );
 
+	xHead = pxStreamBuffer->xHead;
+
+	#if ( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+	{
+		/* Space reserved by a writer is not free even though the writer has
+		not yet committed it. */
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 )
+		{
+			xHead = pxStreamBuffer->xReserveHead;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_MULTI_PRODUCER_STREAM_BUFFERS */
+
 	xSpace = pxStreamBuffer->xLength + pxStreamBuffer->xTail;
-	xSpace -= pxStreamBuffer->xHead;
+	xSpace -= xHead;
 	xSpace -= ( size_t ) 1;
 
 	if( xSpace >= pxStreamBuffer->xLength )
@@ -508,12 +748,39 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
 						  size_t xDataLengthBytes,
 						  TickType_t xTicksToWait )
 {
+StreamBufferFragment_t xFragment;
+
+	configASSERT( pvTxData );
+
+	/* A single block of data is sent as a message with one fragment. */
+	xFragment.pvData = pvTxData;
+	xFragment.xLength = xDataLengthBytes;
+
+	return prvSendFragments( xStreamBuffer, &xFragment, xDataLengthBytes, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendV( StreamBufferHandle_t xStreamBuffer,
+						   const StreamBufferFragment_t *pxFragments,
+						   UBaseType_t uxFragments,
+						   TickType_t xTicksToWait )
+{
+	configASSERT( pxFragments );
+
+	return prvSendFragments( xStreamBuffer, pxFragments, prvGetFragmentsLength( pxFragments, uxFragments ), xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvSendFragments( StreamBufferHandle_t xStreamBuffer,
+								const StreamBufferFragment_t *pxFragments,
+								size_t xDataLengthBytes,
+								TickType_t xTicksToWait )
+{
 StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
 size_t xReturn, xSpace = 0;
 size_t xRequiredSpace = xDataLengthBytes;
 TimeOut_t xTimeOut;
 
-	configASSERT( pvTxData );
 	configASSERT( pxStreamBuffer );
 
 	/* This send function is used to write to both message buffers and stream
@@ -532,56 +799,65 @@ TimeOut_t xTimeOut;
 		mtCOVERAGE_TEST_MARKER();
 	}
 
-	if( xTicksToWait != ( TickType_t ) 0 )
+	#if ( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 )
 	{
-		vTaskSetTimeOutState( &xTimeOut );
-
-		do
+		xReturn = prvSendToMultiProducerBuffer( pxStreamBuffer, pxFragments, xDataLengthBytes, xRequiredSpace, xTicksToWait );
+	}
+	else
+	#endif /* configUSE_MULTI_PRODUCER_STREAM_BUFFERS */
+	{
+		if( xTicksToWait != ( TickType_t ) 0 )
 		{
-			/* Wait until the required number of bytes are free in the message
-			buffer. */
-			taskENTER_CRITICAL();
-			{
-				xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
-
-				if( xSpace < xRequiredSpace )
-				{
-					/* Clear notification state as going to wait for space. */
-					( void ) xTaskNotifyStateClear( NULL );
+			vTaskSetTimeOutState( &xTimeOut );
 
-					/* Should only be one writer. */
-					configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
-					pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
-				}
-				else
+			do
+			{
+				/* Wait until the required number of bytes are free in the message
+				buffer. */
+				taskENTER_CRITICAL();
 				{
-					taskEXIT_CRITICAL();
-					break;
+					xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+					if( xSpace < xRequiredSpace )
+					{
+						/* Clear notification state as going to wait for space. */
+						( void ) xTaskNotifyStateClear( NULL );
+
+						/* Should only be one writer. */
+						configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+						pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+					}
+					else
+					{
+						taskEXIT_CRITICAL();
+						break;
+					}
 				}
-			}
-			taskEXIT_CRITICAL();
+				taskEXIT_CRITICAL();
 
-			traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
-			( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
-			pxStreamBuffer->xTaskWaitingToSend = NULL;
+				traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+				( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+				pxStreamBuffer->xTaskWaitingToSend = NULL;
 
-		} while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
-	}
-	else
-	{
-		mtCOVERAGE_TEST_MARKER();
-	}
+			} while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-	if( xSpace == ( size_t ) 0 )
-	{
-		xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
-	}
-	else
-	{
-		mtCOVERAGE_TEST_MARKER();
-	}
+		if( xSpace == ( size_t ) 0 )
+		{
+			xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-	xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
+		xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pxFragments, xDataLengthBytes, xSpace, xRequiredSpace );
+	}
 
 	if( xReturn > ( size_t ) 0 )
 	{
@@ -594,7 +870,7 @@ TimeOut_t xTimeOut;
 		}
 		else
 		{
-			mtCOVERAGE_TEST_MARKER();
+			sbSTART_HOLD_OFF( pxStreamBuffer );
 		}
 	}
 	else
@@ -612,11 +888,37 @@ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
 								 size_t xDataLengthBytes,
 								 BaseType_t * const pxHigherPriorityTaskWoken )
 {
+StreamBufferFragment_t xFragment;
+
+	configASSERT( pvTxData );
+
+	xFragment.pvData = pvTxData;
+	xFragment.xLength = xDataLengthBytes;
+
+	return prvSendFragmentsFromISR( xStreamBuffer, &xFragment, xDataLengthBytes, pxHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendVFromISR( StreamBufferHandle_t xStreamBuffer,
+								  const StreamBufferFragment_t *pxFragments,
+								  UBaseType_t uxFragments,
+								  BaseType_t * const pxHigherPriorityTaskWoken )
+{
+	configASSERT( pxFragments );
+
+	return prvSendFragmentsFromISR( xStreamBuffer, pxFragments, prvGetFragmentsLength( pxFragments, uxFragments ), pxHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvSendFragmentsFromISR( StreamBufferHandle_t xStreamBuffer,
+									   const StreamBufferFragment_t *pxFragments,
+									   size_t xDataLengthBytes,
+									   BaseType_t * const pxHigherPriorityTaskWoken )
+{
 StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
 size_t xReturn, xSpace;
 size_t xRequiredSpace = xDataLengthBytes;
 
-	configASSERT( pvTxData );
 	configASSERT( pxStreamBuffer );
 
 	/* This send function is used to write to both message buffers and stream
@@ -632,8 +934,51 @@ size_t xRequiredSpace = xDataLengthBytes;
 		mtCOVERAGE_TEST_MARKER();
 	}
 
-	xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
-	xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
+	#if ( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+	if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+	size_t xWriteIndex = 0;
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		/* Only reserving and committing the space is performed with
+		interrupts masked, the data is copied with interrupts enabled. */
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			xReturn = prvReserveSpace( pxStreamBuffer, xDataLengthBytes, xRequiredSpace, pdFALSE, &xWriteIndex );
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		if( xReturn > ( size_t ) 0 )
+		{
+			prvWriteToReservedSpace( pxStreamBuffer, pxFragments, xReturn, xWriteIndex );
+
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				xHigherPriorityTaskWoken = prvCommitReservedSpace( pxStreamBuffer );
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+			if( ( xHigherPriorityTaskWoken != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+			{
+				*pxHigherPriorityTaskWoken = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	#endif /* configUSE_MULTI_PRODUCER_STREAM_BUFFERS */
+	{
+		xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+		xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pxFragments, xDataLengthBytes, xSpace, xRequiredSpace );
+	}
 
 	if( xReturn > ( size_t ) 0 )
 	{
@@ -644,7 +989,7 @@ size_t xRequiredSpace = xDataLengthBytes;
 		}
 		else
 		{
-			mtCOVERAGE_TEST_MARKER();
+			sbSTART_HOLD_OFF_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
 		}
 	}
 	else
@@ -659,13 +1004,14 @@ size_t xRequiredSpace = xDataLengthBytes;
 /*-----------------------------------------------------------*/
 
 static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
-									   const void * pvTxData,
+									   const StreamBufferFragment_t *pxFragments,
 									   size_t xDataLengthBytes,
 									   size_t xSpace,
 									   size_t xRequiredSpace )
 {
 	BaseType_t xShouldWrite;
 	size_t xReturn;
+	size_t xNextHead = pxStreamBuffer->xHead;
 
 	if( xSpace == ( size_t ) 0 )
 	{
@@ -688,7 +1034,7 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
 		into the buffer.  Start by writing the length of the data, the data
 		itself will be written later in this function. */
 		xShouldWrite = pdTRUE;
-		( void ) prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xDataLengthBytes ), sbBYTES_TO_STORE_MESSAGE_LENGTH );
+		xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xDataLengthBytes ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextHead );
 	}
 	else
 	{
@@ -698,8 +1044,11 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
 
 	if( xShouldWrite != pdFALSE )
 	{
-		/* Writes the data itself. */
-		xReturn = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alighment and access. */
+		/* Writes the data itself, then makes the message available to the
+		reader by updating the head. */
+		xNextHead = prvWriteFragmentsToBuffer( pxStreamBuffer, pxFragments, xDataLengthBytes, xNextHead );
+		pxStreamBuffer->xHead = xNextHead;
+		xReturn = xDataLengthBytes;
 	}
 	else
 	{
@@ -756,6 +1105,7 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 				/* Should only be one reader. */
 				configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
 				pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+				sbARM_HOLD_OFF( pxStreamBuffer );
 			}
 			else
 			{
@@ -798,6 +1148,30 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 		{
 			traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
 			sbRECEIVE_COMPLETED( pxStreamBuffer );
+
+			#if ( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+			{
+				if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 )
+				{
+					taskENTER_CRITICAL();
+					{
+						if( prvUnblockTaskWaitingToSend( pxStreamBuffer ) != pdFALSE )
+						{
+							portYIELD_WITHIN_API();
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					taskEXIT_CRITICAL();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_MULTI_PRODUCER_STREAM_BUFFERS */
 		}
 		else
 		{
@@ -898,6 +1272,32 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 		if( xReceivedLength != ( size_t ) 0 )
 		{
 			sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+
+			#if ( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+			{
+				if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 )
+				{
+				UBaseType_t uxSavedInterruptStatus;
+
+					uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+					{
+						if( ( prvUnblockTaskWaitingToSend( pxStreamBuffer ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+						{
+							*pxHigherPriorityTaskWoken = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configUSE_MULTI_PRODUCER_STREAM_BUFFERS */
 		}
 		else
 		{
@@ -915,65 +1315,546 @@ size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 }
 /*-----------------------------------------------------------*/
 
-static size_t prvReadMessageFromBuffer( StreamBuffer_t *pxStreamBuffer,
-										void *pvRxData,
-										size_t xBufferLengthBytes,
-										size_t xBytesAvailable,
-										size_t xBytesToStoreMessageLength )
-{
-size_t xOriginalTail, xReceivedLength, xNextMessageLength;
-configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
 
-	if( xBytesToStoreMessageLength != ( size_t ) 0 )
+	size_t xStreamBufferAcquireWrite( StreamBufferHandle_t xStreamBuffer,
+									  StreamBufferSpan_t pxSpans[ 2 ],
+									  TickType_t xTicksToWait )
 	{
-		/* A discrete message is being received.  First receive the length
-		of the message.  A copy of the tail is stored so the buffer can be
-		returned to its prior state if the length of the message is too
-		large for the provided buffer. */
-		xOriginalTail = pxStreamBuffer->xTail;
-		( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, xBytesToStoreMessageLength, xBytesAvailable );
-		xNextMessageLength = ( size_t ) xTempNextMessageLength;
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xSpace;
+	TimeOut_t xTimeOut;
+
+		configASSERT( pxSpans );
+		configASSERT( pxStreamBuffer );
+
+		/* A message buffer cannot be written in place as each message must be
+		preceded by its length, and a multi-producer buffer has its own way of
+		sharing out the free space. */
+		configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+		#if ( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+		{
+			configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) == ( uint8_t ) 0 );
+		}
+		#endif
 
-		/* Reduce the number of bytes available by the number of bytes just
-		read out. */
-		xBytesAvailable -= xBytesToStoreMessageLength;
+		xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
 
-		/* Check there is enough space in the buffer provided by the
-		user. */
-		if( xNextMessageLength > xBufferLengthBytes )
+		if( ( xSpace == ( size_t ) 0 ) && ( xTicksToWait != ( TickType_t ) 0 ) )
 		{
-			/* The user has provided insufficient space to read the message
-			so return the buffer to its previous state (so the length of
-			the message is in the buffer again). */
-			pxStreamBuffer->xTail = xOriginalTail;
-			xNextMessageLength = 0;
+			vTaskSetTimeOutState( &xTimeOut );
+
+			do
+			{
+				/* Wait until there is at least one free byte.  As in
+				xStreamBufferSend() the writer waits for a notification from
+				the reader. */
+				taskENTER_CRITICAL();
+				{
+					xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+					if( xSpace == ( size_t ) 0 )
+					{
+						/* Clear notification state as going to wait for space. */
+						( void ) xTaskNotifyStateClear( NULL );
+
+						/* Should only be one writer. */
+						configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+						pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+					}
+					else
+					{
+						taskEXIT_CRITICAL();
+						break;
+					}
+				}
+				taskEXIT_CRITICAL();
+
+				traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+				( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+				pxStreamBuffer->xTaskWaitingToSend = NULL;
+
+			} while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+
+			if( xSpace == ( size_t ) 0 )
+			{
+				xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
-	}
-	else
-	{
-		/* A stream of bytes is being received (as opposed to a discrete
-		message), so read as many bytes as possible. */
-		xNextMessageLength = xBufferLengthBytes;
-	}
 
-	/* Read the actual data. */
-	xReceivedLength = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pvRxData, xNextMessageLength, xBytesAvailable ); /*lint !e9079 Data storage area is implemented as uint8_t array for ease of sizing, indexing and alignment. */
+		return prvGetSpans( pxStreamBuffer, pxStreamBuffer->xHead, xSpace, pxSpans );
+	}
 
-	return xReceivedLength;
-}
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
 /*-----------------------------------------------------------*/
 
-BaseType_t xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer )
-{
-const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
-BaseType_t xReturn;
-size_t xTail;
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
 
-	configASSERT( pxStreamBuffer );
+	size_t xStreamBufferAcquireWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+											 StreamBufferSpan_t pxSpans[ 2 ] )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+		configASSERT( pxSpans );
+		configASSERT( pxStreamBuffer );
+		configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+		#if ( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+		{
+			configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) == ( uint8_t ) 0 );
+		}
+		#endif
+
+		return prvGetSpans( pxStreamBuffer, pxStreamBuffer->xHead, xStreamBufferSpacesAvailable( pxStreamBuffer ), pxSpans );
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	void vStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer, size_t xBytesWritten )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+		configASSERT( pxStreamBuffer );
+		configASSERT( xBytesWritten <= xStreamBufferSpacesAvailable( pxStreamBuffer ) );
+
+		if( xBytesWritten > ( size_t ) 0 )
+		{
+			/* Moving the head is what makes the bytes available to the
+			reader. */
+			prvAdvanceIndex( pxStreamBuffer, &( pxStreamBuffer->xHead ), xBytesWritten );
+			traceSTREAM_BUFFER_SEND( xStreamBuffer, xBytesWritten );
+
+			/* Was a task waiting for the data? */
+			if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+			{
+				sbSEND_COMPLETED( pxStreamBuffer );
+			}
+			else
+			{
+				sbSTART_HOLD_OFF( pxStreamBuffer );
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	void vStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+										  size_t xBytesWritten,
+										  BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+		configASSERT( pxStreamBuffer );
+		configASSERT( xBytesWritten <= xStreamBufferSpacesAvailable( pxStreamBuffer ) );
+
+		if( xBytesWritten > ( size_t ) 0 )
+		{
+			prvAdvanceIndex( pxStreamBuffer, &( pxStreamBuffer->xHead ), xBytesWritten );
+
+			/* Was a task waiting for the data? */
+			if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+			{
+				sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+			}
+			else
+			{
+				sbSTART_HOLD_OFF_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xBytesWritten );
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	size_t xStreamBufferAcquireRead( StreamBufferHandle_t xStreamBuffer,
+									 StreamBufferSpan_t pxSpans[ 2 ],
+									 TickType_t xTicksToWait )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+	size_t xBytesAvailable;
+
+		configASSERT( pxSpans );
+		configASSERT( pxStreamBuffer );
+		configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+		#if ( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+		{
+			configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) == ( uint8_t ) 0 );
+		}
+		#endif
+
+		if( xTicksToWait != ( TickType_t ) 0 )
+		{
+			/* Checking if there is data and clearing the notification state
+			must be performed atomically. */
+			taskENTER_CRITICAL();
+			{
+				xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+				if( xBytesAvailable == ( size_t ) 0 )
+				{
+					/* Clear notification state as going to wait for data. */
+					( void ) xTaskNotifyStateClear( NULL );
+
+					/* Should only be one reader. */
+					configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+					pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+					sbARM_HOLD_OFF( pxStreamBuffer );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( xBytesAvailable == ( size_t ) 0 )
+			{
+				/* Wait for data to be available.  As with xStreamBufferReceive()
+				the writer only notifies this task once the trigger level has
+				been reached. */
+				traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+				( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+				pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+				/* Recheck the data available after blocking. */
+				xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+		}
+
+		return prvGetSpans( pxStreamBuffer, pxStreamBuffer->xTail, xBytesAvailable, pxSpans );
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	size_t xStreamBufferAcquireReadFromISR( StreamBufferHandle_t xStreamBuffer,
+											StreamBufferSpan_t pxSpans[ 2 ] )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+		configASSERT( pxSpans );
+		configASSERT( pxStreamBuffer );
+		configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+		#if ( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+		{
+			configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) == ( uint8_t ) 0 );
+		}
+		#endif
+
+		return prvGetSpans( pxStreamBuffer, pxStreamBuffer->xTail, prvBytesInBuffer( pxStreamBuffer ), pxSpans );
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	void vStreamBufferReleaseRead( StreamBufferHandle_t xStreamBuffer, size_t xBytesRead )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+		configASSERT( pxStreamBuffer );
+		configASSERT( xBytesRead <= prvBytesInBuffer( pxStreamBuffer ) );
+
+		if( xBytesRead > ( size_t ) 0 )
+		{
+			prvAdvanceIndex( pxStreamBuffer, &( pxStreamBuffer->xTail ), xBytesRead );
+			traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xBytesRead );
+
+			/* Was a task waiting for space in the buffer? */
+			sbRECEIVE_COMPLETED( pxStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	void vStreamBufferReleaseReadFromISR( StreamBufferHandle_t xStreamBuffer,
+										  size_t xBytesRead,
+										  BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+		configASSERT( pxStreamBuffer );
+		configASSERT( xBytesRead <= prvBytesInBuffer( pxStreamBuffer ) );
+
+		if( xBytesRead > ( size_t ) 0 )
+		{
+			prvAdvanceIndex( pxStreamBuffer, &( pxStreamBuffer->xTail ), xBytesRead );
+
+			/* Was a task waiting for space in the buffer? */
+			sbRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xBytesRead );
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_TRIGGER_HOLD_OFF == 1 )
+
+	static void prvStartHoldOff( StreamBuffer_t * const pxStreamBuffer )
+	{
+	BaseType_t xLimited = pdPASS;
+
+		/* Only the first write after the reader blocked has anything to do, so
+		check before suspending the scheduler. */
+		if( pxStreamBuffer->xHoldOffPending != pdFALSE )
+		{
+			vTaskSuspendAll();
+			{
+				pxStreamBuffer->xHoldOffPending = pdFALSE;
+
+				if( pxStreamBuffer->xTaskWaitingToReceive != NULL )
+				{
+					xLimited = xTaskLimitBlockTime( pxStreamBuffer->xTaskWaitingToReceive, pxStreamBuffer->xHoldOffTicks );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			( void ) xTaskResumeAll();
+
+			if( xLimited == pdFAIL )
+			{
+				/* The reader was preempted between deciding to wait and
+				actually entering the Blocked state, so cannot be given a
+				timeout.  Unblock it now instead, exactly as if the trigger
+				level had been reached. */
+				sbSEND_COMPLETED( pxStreamBuffer );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_STREAM_BUFFER_TRIGGER_HOLD_OFF */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_TRIGGER_HOLD_OFF == 1 )
+
+	static void prvStartHoldOffFromISR( StreamBuffer_t * const pxStreamBuffer, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	UBaseType_t uxSavedInterruptStatus;
+	BaseType_t xLimited = pdPASS;
+
+		if( pxStreamBuffer->xHoldOffPending != pdFALSE )
+		{
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				pxStreamBuffer->xHoldOffPending = pdFALSE;
+
+				if( pxStreamBuffer->xTaskWaitingToReceive != NULL )
+				{
+					xLimited = xTaskLimitBlockTimeFromISR( pxStreamBuffer->xTaskWaitingToReceive, pxStreamBuffer->xHoldOffTicks );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+			if( xLimited == pdFAIL )
+			{
+				/* Either the reader is not yet blocked, or the interrupt
+				occurred while the scheduler was suspended so the reader's
+				timeout cannot be changed.  Unblock it now instead. */
+				sbSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_STREAM_BUFFER_TRIGGER_HOLD_OFF */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	static size_t prvGetSpans( const StreamBuffer_t * const pxStreamBuffer,
+							   size_t xIndex,
+							   size_t xCount,
+							   StreamBufferSpan_t pxSpans[ 2 ] )
+	{
+	size_t xFirstLength;
+
+		/* The first span runs from xIndex to either the end of the bytes or
+		the end of the storage area, whichever comes first. */
+		xFirstLength = configMIN( pxStreamBuffer->xLength - xIndex, xCount );
+
+		if( xFirstLength > ( size_t ) 0 )
+		{
+			pxSpans[ 0 ].pucData = &( pxStreamBuffer->pucBuffer[ xIndex ] );
+		}
+		else
+		{
+			pxSpans[ 0 ].pucData = NULL;
+		}
+		pxSpans[ 0 ].xLength = xFirstLength;
+
+		/* Any remaining bytes wrapped to the start of the storage area. */
+		if( xCount > xFirstLength )
+		{
+			pxSpans[ 1 ].pucData = pxStreamBuffer->pucBuffer;
+		}
+		else
+		{
+			pxSpans[ 1 ].pucData = NULL;
+		}
+		pxSpans[ 1 ].xLength = xCount - xFirstLength;
+
+		return xCount;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_STREAM_BUFFER_ZERO_COPY == 1 )
+
+	static void prvAdvanceIndex( const StreamBuffer_t * const pxStreamBuffer,
+								 volatile size_t * const pxIndex,
+								 size_t xCount )
+	{
+	size_t xNextIndex;
+
+		xNextIndex = *pxIndex + xCount;
+
+		if( xNextIndex >= pxStreamBuffer->xLength )
+		{
+			xNextIndex -= pxStreamBuffer->xLength;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* The index is updated with a single write so the other end of the
+		buffer never sees an intermediate value. */
+		*pxIndex = xNextIndex;
+	}
+
+#endif /* configUSE_STREAM_BUFFER_ZERO_COPY */
+/*-----------------------------------------------------------*/
+
+static size_t prvReadMessageFromBuffer( StreamBuffer_t *pxStreamBuffer,
+										void *pvRxData,
+										size_t xBufferLengthBytes,
+										size_t xBytesAvailable,
+										size_t xBytesToStoreMessageLength )
+{
+size_t xOriginalTail, xReceivedLength, xNextMessageLength;
+configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
+
+	if( xBytesToStoreMessageLength != ( size_t ) 0 )
+	{
+		/* A discrete message is being received.  First receive the length
+		of the message.  A copy of the tail is stored so the buffer can be
+		returned to its prior state if the length of the message is too
+		large for the provided buffer. */
+		xOriginalTail = pxStreamBuffer->xTail;
+		( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, xBytesToStoreMessageLength, xBytesAvailable );
+		xNextMessageLength = ( size_t ) xTempNextMessageLength;
+
+		/* Reduce the number of bytes available by the number of bytes just
+		read out. */
+		xBytesAvailable -= xBytesToStoreMessageLength;
+
+		/* Check there is enough space in the buffer provided by the
+		user. */
+		if( xNextMessageLength > xBufferLengthBytes )
+		{
+			/* The user has provided insufficient space to read the message
+			so return the buffer to its previous state (so the length of
+			the message is in the buffer again). */
+			pxStreamBuffer->xTail = xOriginalTail;
+			xNextMessageLength = 0;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		/* A stream of bytes is being received (as opposed to a discrete
+		message), so read as many bytes as possible. */
+		xNextMessageLength = xBufferLengthBytes;
+	}
+
+	/* Read the actual data. */
+	xReceivedLength = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pvRxData, xNextMessageLength, xBytesAvailable ); /*lint !e9079 Data storage area is implemented as uint8_t array for ease of sizing, indexing and alignment. */
+
+	return xReceivedLength;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer )
+{
+const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+BaseType_t xReturn;
+size_t xTail;
+
+	configASSERT( pxStreamBuffer );
 
 	/* True if no bytes are available. */
 	xTail = pxStreamBuffer->xTail;
@@ -1085,14 +1966,12 @@ UBaseType_t uxSavedInterruptStatus;
 }
 /*-----------------------------------------------------------*/
 
-static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount )
+static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer, const uint8_t *pucData, size_t xCount, size_t xHead )
 {
-size_t xNextHead, xFirstLength;
+size_t xNextHead = xHead, xFirstLength;
 
 	configASSERT( xCount > ( size_t ) 0 );
 
-	xNextHead = pxStreamBuffer->xHead;
-
 	/* Calculate the number of bytes that can be added in the first write -
 	which may be less than the total number of bytes that need to be added if
 	the buffer will wrap back to the beginning. */
@@ -1125,9 +2004,54 @@ size_t xNextHead, xFirstLength;
 		mtCOVERAGE_TEST_MARKER();
 	}
 
-	pxStreamBuffer->xHead = xNextHead;
+	return xNextHead;
+}
+/*-----------------------------------------------------------*/
 
-	return xCount;
+static size_t prvWriteFragmentsToBuffer( StreamBuffer_t * const pxStreamBuffer, const StreamBufferFragment_t *pxFragments, size_t xCount, size_t xHead )
+{
+size_t xNextHead = xHead, xFragmentLength;
+
+	/* Copy each fragment in turn until xCount bytes have been written.  When
+	writing to a stream buffer xCount can be less than the total length of the
+	fragments, in which case the last fragment written is truncated. */
+	while( xCount > ( size_t ) 0 )
+	{
+		xFragmentLength = configMIN( pxFragments->xLength, xCount );
+
+		if( xFragmentLength > ( size_t ) 0 )
+		{
+			xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pxFragments->pvData, xFragmentLength, xNextHead ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alighment and access. */
+			xCount -= xFragmentLength;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxFragments++;
+	}
+
+	return xNextHead;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvGetFragmentsLength( const StreamBufferFragment_t *pxFragments, UBaseType_t uxFragments )
+{
+size_t xLength = 0;
+UBaseType_t ux;
+
+	for( ux = 0; ux < uxFragments; ux++ )
+	{
+		configASSERT( ( pxFragments[ ux ].pvData != NULL ) || ( pxFragments[ ux ].xLength == ( size_t ) 0 ) );
+
+		xLength += pxFragments[ ux ].xLength;
+
+		/* Overflow? */
+		configASSERT( xLength >= pxFragments[ ux ].xLength );
+	}
+
+	return xLength;
 }
 /*-----------------------------------------------------------*/
 
@@ -1230,7 +2154,243 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 	pxStreamBuffer->xLength = xBufferSizeBytes;
 	pxStreamBuffer->xTriggerLevelBytes = xTriggerLevelBytes;
 	pxStreamBuffer->ucFlags = ucFlags;
+
+	#if ( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+	{
+		vListInitialise( &( pxStreamBuffer->xTasksWaitingToSend ) );
+	}
+	#endif /* configUSE_MULTI_PRODUCER_STREAM_BUFFERS */
 }
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+
+	static size_t prvSendToMultiProducerBuffer( StreamBuffer_t * const pxStreamBuffer,
+												const StreamBufferFragment_t *pxFragments,
+												size_t xDataLengthBytes,
+												size_t xRequiredSpace,
+												TickType_t xTicksToWait )
+	{
+	size_t xReturn, xWriteIndex = 0;
+	TimeOut_t xTimeOut;
+
+		vTaskSetTimeOutState( &xTimeOut );
+
+		for( ;; )
+		{
+			/* Reserving the space must be atomic with respect to other writers,
+			and to the reader unblocking this task. */
+			taskENTER_CRITICAL();
+			{
+				xReturn = prvReserveSpace( pxStreamBuffer, xDataLengthBytes, xRequiredSpace, ( xTicksToWait != ( TickType_t ) 0 ) ? pdTRUE : pdFALSE, &xWriteIndex );
+
+				if( ( xReturn == ( size_t ) 0 ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+				{
+					/* Unlike a single writer buffer, any number of writers can
+					be waiting for space, so they wait on an event list. */
+					traceBLOCKING_ON_STREAM_BUFFER_SEND( pxStreamBuffer );
+					vTaskPlaceOnEventList( &( pxStreamBuffer->xTasksWaitingToSend ), xTicksToWait );
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+
+			if( ( xReturn != ( size_t ) 0 ) || ( xTicksToWait == ( TickType_t ) 0 ) )
+			{
+				break;
+			}
+
+			/* Try again, but without blocking if the block time has expired. */
+			if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+			{
+				xTicksToWait = 0;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		if( xReturn > ( size_t ) 0 )
+		{
+			/* The copy is performed outside of the critical section, so other
+			writers can reserve and write their own space in the meantime. */
+			prvWriteToReservedSpace( pxStreamBuffer, pxFragments, xReturn, xWriteIndex );
+
+			taskENTER_CRITICAL();
+			{
+				if( prvCommitReservedSpace( pxStreamBuffer ) != pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			taskEXIT_CRITICAL();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MULTI_PRODUCER_STREAM_BUFFERS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+
+	static size_t prvReserveSpace( StreamBuffer_t * const pxStreamBuffer,
+								   size_t xDataLengthBytes,
+								   size_t xRequiredSpace,
+								   BaseType_t xWriterCanBlock,
+								   size_t * const pxWriteIndex )
+	{
+	size_t xSpace, xReserved, xReturn;
+
+		xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+		if( xSpace == ( size_t ) 0 )
+		{
+			xReserved = 0;
+			xReturn = 0;
+		}
+		else if( ( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 ) && ( ( xSpace >= xRequiredSpace ) || ( xWriterCanBlock == pdFALSE ) ) )
+		{
+			/* A stream buffer, so write as many bytes as possible - which is
+			all of them unless the writer cannot wait for more space. */
+			xReturn = configMIN( xDataLengthBytes, xSpace );
+			xReserved = xReturn;
+		}
+		else if( ( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 ) && ( xSpace >= xRequiredSpace ) )
+		{
+			/* A message buffer with space for both the message length and the
+			message itself. */
+			xReturn = xDataLengthBytes;
+			xReserved = xRequiredSpace;
+		}
+		else
+		{
+			/* There is space available, but not enough space. */
+			xReserved = 0;
+			xReturn = 0;
+		}
+
+		if( xReserved > ( size_t ) 0 )
+		{
+			*pxWriteIndex = pxStreamBuffer->xReserveHead;
+
+			xReserved += pxStreamBuffer->xReserveHead;
+			if( xReserved >= pxStreamBuffer->xLength )
+			{
+				xReserved -= pxStreamBuffer->xLength;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxStreamBuffer->xReserveHead = xReserved;
+			( pxStreamBuffer->uxWritersInProgress )++;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MULTI_PRODUCER_STREAM_BUFFERS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+
+	static void prvWriteToReservedSpace( StreamBuffer_t * const pxStreamBuffer,
+										 const StreamBufferFragment_t *pxFragments,
+										 size_t xDataLengthBytes,
+										 size_t xWriteIndex )
+	{
+		if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+		{
+			/* The length is written into the same reserved space as the message
+			so messages from different writers cannot be interleaved. */
+			xWriteIndex = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xDataLengthBytes ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xWriteIndex );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		( void ) prvWriteFragmentsToBuffer( pxStreamBuffer, pxFragments, xDataLengthBytes, xWriteIndex );
+	}
+
+#endif /* configUSE_MULTI_PRODUCER_STREAM_BUFFERS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+
+	static BaseType_t prvCommitReservedSpace( StreamBuffer_t * const pxStreamBuffer )
+	{
+	BaseType_t xReturn = pdFALSE;
+
+		configASSERT( pxStreamBuffer->uxWritersInProgress > ( UBaseType_t ) 0 );
+		( pxStreamBuffer->uxWritersInProgress )--;
+
+		if( pxStreamBuffer->uxWritersInProgress == ( UBaseType_t ) 0 )
+		{
+			/* Every reserved byte has now been written, so make it all
+			available to the reader. */
+			pxStreamBuffer->xHead = pxStreamBuffer->xReserveHead;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* A reader only unblocks one waiting writer, so pass on any space that
+		remains to the next writer waiting for space. */
+		if( xStreamBufferSpacesAvailable( pxStreamBuffer ) > ( size_t ) 0 )
+		{
+			xReturn = prvUnblockTaskWaitingToSend( pxStreamBuffer );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MULTI_PRODUCER_STREAM_BUFFERS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MULTI_PRODUCER_STREAM_BUFFERS == 1 )
+
+	static BaseType_t prvUnblockTaskWaitingToSend( StreamBuffer_t * const pxStreamBuffer )
+	{
+	BaseType_t xReturn;
+
+		if( listLIST_IS_EMPTY( &( pxStreamBuffer->xTasksWaitingToSend ) ) == pdFALSE )
+		{
+			xReturn = xTaskRemoveFromEventList( &( pxStreamBuffer->xTasksWaitingToSend ) );
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+
+#endif /* configUSE_MULTI_PRODUCER_STREAM_BUFFERS */
 
 #if ( configUSE_TRACE_FACILITY == 1 )
 